@@ -10,6 +10,7 @@ include_guard(GLOBAL)
 include(${CMAKE_CURRENT_LIST_DIR}/vars.cmake)
 
 option(ZOO_BUILD_EXAMPLES "Build the examples." "${ZOO_IS_TOP_LEVEL}")
+option(ZOO_BUILD_BENCHMARKS "Build the benchmarks." OFF)
 option(ZOO_TEST "Build the tests." "${ZOO_IS_TOP_LEVEL}")
 option(ZOO_RUN_UNIT_TESTS_ON_BUILD "Run the unit tests during build." "${ZOO_IS_TOP_LEVEL}")
 option(ZOO_INSTALL "Include install rules for zoo." "${ZOO_IS_TOP_LEVEL}")
@@ -17,11 +17,9 @@
 #include <boost/uuid/uuid_io.hpp>
 #include <boost/uuid/string_generator.hpp>
 
-#include <fmt/format.h>
-
+#include <algorithm>
 #include <optional>
-#include <regex>
-#include <cmath>
+#include <cstdint>
 #include <cassert>
 
 #if defined(_MSC_VER)
@@ -33,53 +31,188 @@ namespace conversion {
 
 namespace {
 
-struct parsed_time_point final
+// The parsers below accept exactly the grammars that were once matched with regular expressions:
+//   time point:  ^(\d{4})-(\d{2})-(\d{2})[T ](\d{2}):(\d{2}):(\d{2})(\.\d*)?( ?([+-]\d{2})(:?(\d{2}))?|Z)?$
+//   date:        ^(-?\d{1,4})-(\d{2})-(\d{2})$ or ^(-?\d{4})(\d{2})(\d{2})$
+//   time of day: ^(\d{2}):(\d{2}):(\d{2})(\.\d*)?( ?([+-]\d{2})(:?(\d{2}))?)?$
+// std::regex took about a microsecond per value, which dominated the decoding of temporal columns.
+
+// Scans a string from left to right, every accept function only advances on success
+class scanner final
 {
-	int                   year;
-	unsigned              month;
-	unsigned              day;
-	unsigned              hours;
-	unsigned              minutes;
-	unsigned              seconds;
-	std::optional<double> fracseconds;
-	std::optional<int>    utc_offset_minutes;
+	const char* pos_;
+	const char* end_;
+
+	static bool is_digit(char c)
+	{
+		return static_cast<unsigned>(c) - '0' < 10u;
+	}
+
+public:
+	explicit scanner(std::string_view in)
+	    : pos_{ in.data() }
+	    , end_{ in.data() + in.length() }
+	{
+	}
+
+	bool at_end() const
+	{
+		return this->pos_ == this->end_;
+	}
+
+	const char* position() const
+	{
+		return this->pos_;
+	}
+
+	bool accept(char c)
+	{
+		if (this->pos_ != this->end_ && *this->pos_ == c)
+		{
+			++this->pos_;
+			return true;
+		}
+		return false;
+	}
+
+	// Accept exactly @a count digits
+	template<typename T>
+	bool accept_digits(std::size_t count, T& out)
+	{
+		if (static_cast<std::size_t>(this->end_ - this->pos_) < count)
+		{
+			return false;
+		}
+		auto value = T{};
+		for (auto p = this->pos_, last = this->pos_ + count; p != last; ++p)
+		{
+			if (!is_digit(*p))
+			{
+				return false;
+			}
+			value = static_cast<T>(value * 10 + (*p - '0'));
+		}
+		this->pos_ += count;
+		out = value;
+		return true;
+	}
+
+	// Accept the longest sequence of digits, which may be empty, and return its length
+	std::size_t skip_digits()
+	{
+		const auto first = this->pos_;
+		while (this->pos_ != this->end_ && is_digit(*this->pos_))
+		{
+			++this->pos_;
+		}
+		return static_cast<std::size_t>(this->pos_ - first);
+	}
 };
 
-parsed_time_point parse_time_point(std::string_view in)
+// (\.\d*)? -> the fraction in microseconds, if there is at least one digit
+std::optional<std::uint32_t> scan_fraction(scanner& sc)
 {
-	parsed_time_point out{};
+	const auto first = sc.position();
+	if (!sc.accept('.'))
+	{
+		return std::nullopt;
+	}
 
-	static const std::regex re{ R"(^(\d{4})-(\d{2})-(\d{2})[T ](\d{2}):(\d{2}):(\d{2})(\.\d*)?( ?([+-]\d{2})(:?(\d{2}))?|Z)?$)" };
-	//                              1       2       3          4       5       6      7       8  9          10 11
+	const auto count = sc.skip_digits();
+	if (count == 0u)
+	{
+		return std::nullopt;
+	}
 
-	std::match_results<std::string_view::const_iterator> matches;
-	if (!std::regex_match(in.begin(), in.end(), matches, re) || matches.size() != 1 + 11)
+	if (count <= 6u)
 	{
-		ZOO_THROW_EXCEPTION(std::invalid_argument{ "invalid time point format" });
+		// Exact, and equal to the rounding of the double below
+		auto micro = std::uint32_t{};
+		for (auto p = first + 1; p != sc.position(); ++p)
+		{
+			micro = micro * 10u + static_cast<std::uint32_t>(*p - '0');
+		}
+		for (auto i = count; i != 6u; ++i)
+		{
+			micro *= 10u;
+		}
+		return micro;
 	}
 
-	out.year    = string_to_number<int>(matches[1].str());
-	out.month   = string_to_number<unsigned>(matches[2].str());
-	out.day     = string_to_number<unsigned>(matches[3].str());
-	out.hours   = string_to_number<unsigned>(matches[4].str());
-	out.minutes = string_to_number<unsigned>(matches[5].str());
-	out.seconds = string_to_number<unsigned>(matches[6].str());
+	// Beyond microsecond precision, round like it always was
+	const auto fracseconds = string_to_number<double>(std::string_view{ first, static_cast<std::size_t>(sc.position() - first) });
+	return static_cast<std::uint32_t>(fracseconds * 1e6 + .5);
+}
 
-	if (matches.length(7) > 1)
+// ( ?([+-]\d{2})(:?(\d{2}))?)? followed by the end of the input -> the UTC offset in minutes
+bool scan_utc_offset(scanner& sc, std::optional<int>& utc_offset_minutes)
+{
+	if (sc.at_end())
 	{
-		out.fracseconds = string_to_number<double>(matches[7].str());
+		return true;
 	}
 
-	if (matches.length(9))
+	sc.accept(' ');
+
+	const auto negative = sc.accept('-');
+	if (!negative && !sc.accept('+'))
 	{
-		const auto hours            = matches[9].str();
-		const auto utc_offset_hours = string_to_number<int>((hours.front() == '+') ? &hours[1] : hours);
-		out.utc_offset_minutes      = utc_offset_hours * 60;
+		return false;
+	}
 
-		if (matches.length(11))
+	auto hours = int{};
+	if (!sc.accept_digits(2u, hours))
+	{
+		return false;
+	}
+
+	const auto utc_offset_hours = negative ? -hours : hours;
+	utc_offset_minutes          = utc_offset_hours * 60;
+
+	if (!sc.at_end())
+	{
+		sc.accept(':');
+		auto minutes = int{};
+		if (!sc.accept_digits(2u, minutes))
 		{
-			out.utc_offset_minutes.value() += string_to_number<int>(matches[11].str()) * (utc_offset_hours < 0 ? -1 : 1);
+			return false;
 		}
+		// The sign of the hours applies, so "-00:30" is +30 minutes
+		utc_offset_minutes.value() += minutes * (utc_offset_hours < 0 ? -1 : 1);
+	}
+
+	return sc.at_end();
+}
+
+struct parsed_time_point final
+{
+	int                          year;
+	unsigned                     month;
+	unsigned                     day;
+	unsigned                     hours;
+	unsigned                     minutes;
+	unsigned                     seconds;
+	std::optional<std::uint32_t> microseconds;
+	std::optional<int>           utc_offset_minutes;
+};
+
+parsed_time_point parse_time_point(std::string_view in)
+{
+	parsed_time_point out{};
+
+	scanner sc{ in };
+	if (!(sc.accept_digits(4u, out.year) && sc.accept('-') && sc.accept_digits(2u, out.month) && sc.accept('-') &&
+	      sc.accept_digits(2u, out.day) && (sc.accept('T') || sc.accept(' ')) && sc.accept_digits(2u, out.hours) && sc.accept(':') &&
+	      sc.accept_digits(2u, out.minutes) && sc.accept(':') && sc.accept_digits(2u, out.seconds)))
+	{
+		ZOO_THROW_EXCEPTION(std::invalid_argument{ "invalid time point format" });
+	}
+
+	out.microseconds = scan_fraction(sc);
+
+	if (!(sc.accept('Z') ? sc.at_end() : scan_utc_offset(sc, out.utc_offset_minutes)))
+	{
+		ZOO_THROW_EXCEPTION(std::invalid_argument{ "invalid time point format" });
 	}
 
 	return out;
@@ -96,73 +229,135 @@ parsed_date parse_date(std::string_view in)
 {
 	auto out = parsed_date{};
 
-	static const std::regex re1{ R"(^(-?\d{1,4})-(\d{2})-(\d{2})$)" };
-	//                              1            2        3
-	static const std::regex re2{ R"(^(-?\d{4})(\d{2})(\d{2})$)" };
-	//                               1        2      3
+	scanner    sc{ in };
+	const auto negative = sc.accept('-');
+	const auto first    = sc.position();
+	const auto count    = sc.skip_digits();
 
-	auto matches = std::match_results<std::string_view::const_iterator>{};
-	if (!std::regex_match(in.begin(), in.end(), matches, re1) || matches.size() != 1 + 3)
+	auto valid = false;
+	if (count >= 1u && count <= 4u)
 	{
-		if (!std::regex_match(in.begin(), in.end(), matches, re2) || matches.size() != 1 + 3)
-		{
-			ZOO_THROW_EXCEPTION(std::invalid_argument{ "invalid date format" });
-		}
+		// -?\d{1,4}-\d{2}-\d{2}
+		valid = sc.accept('-') && sc.accept_digits(2u, out.month) && sc.accept('-') && sc.accept_digits(2u, out.day) && sc.at_end();
+		scanner{ std::string_view{ first, count } }.accept_digits(count, out.year);
+	}
+	else if (count == 8u && sc.at_end())
+	{
+		// -?\d{4}\d{2}\d{2}
+		scanner digits{ std::string_view{ first, count } };
+		valid = digits.accept_digits(4u, out.year) && digits.accept_digits(2u, out.month) && digits.accept_digits(2u, out.day);
 	}
 
-	out.year  = string_to_number<int>(matches[1].str());
-	out.month = string_to_number<unsigned>(matches[2].str());
-	out.day   = string_to_number<unsigned>(matches[3].str());
+	if (!valid)
+	{
+		ZOO_THROW_EXCEPTION(std::invalid_argument{ "invalid date format" });
+	}
+
+	if (negative)
+	{
+		out.year = -out.year;
+	}
 
 	return out;
 }
 
 struct parsed_time_of_day final
 {
-	unsigned              hours;
-	unsigned              minutes;
-	unsigned              seconds;
-	std::optional<double> fracseconds;
-	std::optional<int>    utc_offset_minutes;
+	unsigned                     hours;
+	unsigned                     minutes;
+	unsigned                     seconds;
+	std::optional<std::uint32_t> microseconds;
+	std::optional<int>           utc_offset_minutes;
 };
 
 parsed_time_of_day parse_time_of_day(std::string_view in)
 {
 	auto out = parsed_time_of_day{};
 
-	static const std::regex re{ R"(^(\d{2}):(\d{2}):(\d{2})(\.\d*)?( ?([+-]\d{2})(:?(\d{2}))?)?$)" };
-	//                              1       2       3      4       5  6          7  8
+	scanner sc{ in };
+	if (!(sc.accept_digits(2u, out.hours) && sc.accept(':') && sc.accept_digits(2u, out.minutes) && sc.accept(':') &&
+	      sc.accept_digits(2u, out.seconds)))
+	{
+		ZOO_THROW_EXCEPTION(std::invalid_argument{ "invalid time of day format" });
+	}
+
+	out.microseconds = scan_fraction(sc);
 
-	std::match_results<std::string_view::const_iterator> matches;
-	if (!std::regex_match(in.begin(), in.end(), matches, re) || matches.size() != 1 + 8)
+	if (!scan_utc_offset(sc, out.utc_offset_minutes))
 	{
 		ZOO_THROW_EXCEPTION(std::invalid_argument{ "invalid time of day format" });
 	}
 
-	out.hours   = string_to_number<unsigned>(matches[1].str());
-	out.minutes = string_to_number<unsigned>(matches[2].str());
-	out.seconds = string_to_number<unsigned>(matches[3].str());
+	return out;
+}
 
-	if (matches.length(4) > 1)
+// Like fmt's {:0<width>d}, a minus sign counts towards the width
+char* write_padded(char* out, long long value, int width)
+{
+	auto magnitude = static_cast<unsigned long long>(value);
+	if (value < 0)
 	{
-		out.fracseconds = string_to_number<double>(matches[4].str());
+		*out++    = '-';
+		magnitude = 0u - magnitude;
+		--width;
 	}
 
-	if (matches.length(6))
+	char digits[20];
+	auto count = 0;
+	do
 	{
-		const auto hours            = matches[6].str();
-		const auto utc_offset_hours = string_to_number<int>((hours.front() == '+') ? &hours[1] : hours);
-		out.utc_offset_minutes      = utc_offset_hours * 60;
+		digits[count++] = static_cast<char>('0' + magnitude % 10u);
+		magnitude /= 10u;
+	} while (magnitude != 0u);
 
-		if (matches.length(8))
-		{
-			out.utc_offset_minutes.value() += string_to_number<int>(matches[8].str()) * (utc_offset_hours < 0 ? -1 : 1);
-		}
+	for (; width > count; --width)
+	{
+		*out++ = '0';
 	}
+	while (count != 0)
+	{
+		*out++ = digits[--count];
+	}
+	return out;
+}
+
+// YYYY-MM-DD
+char* write_date(char* out, const date& in)
+{
+	out    = write_padded(out, static_cast<int>(in.year()), 4);
+	*out++ = '-';
+	out    = write_padded(out, static_cast<unsigned>(in.month()), 2);
+	*out++ = '-';
+	return write_padded(out, static_cast<unsigned>(in.day()), 2);
+}
 
+// HH:MM:SS[.ffffff], the fraction only if it is not zero
+char* write_time_of_day(char* out, const time_of_day& in)
+{
+	out    = write_padded(out, in.hours().count(), 2);
+	*out++ = ':';
+	out    = write_padded(out, in.minutes().count(), 2);
+	*out++ = ':';
+	out    = write_padded(out, in.seconds().count(), 2);
+	if (in.subseconds().count())
+	{
+		*out++ = '.';
+		out    = write_padded(out, in.subseconds().count(), 6);
+	}
 	return out;
 }
 
+// Copy the formatted [buf, end) to [first, last), with the result of std::to_chars
+std::to_chars_result copy_chars(const char* buf, const char* end, char* first, char* last)
+{
+	const auto length = static_cast<std::size_t>(end - buf);
+	if (static_cast<std::size_t>(last - first) < length)
+	{
+		return std::to_chars_result{ last, std::errc::value_too_large };
+	}
+	return std::to_chars_result{ std::copy(buf, end, first), std::errc{} };
+}
+
 } // namespace
 
 void string_to_time_point(std::string_view in, time_point& out)
@@ -177,9 +372,9 @@ void string_to_time_point(std::string_view in, time_point& out)
 	out = std::chrono::sys_days{ std::chrono::year{ parsed.year } / std::chrono::month{ parsed.month } / parsed.day } +
 	      std::chrono::hours{ parsed.hours } + std::chrono::minutes{ parsed.minutes } + std::chrono::seconds{ parsed.seconds };
 
-	if (parsed.fracseconds)
+	if (parsed.microseconds)
 	{
-		out += std::chrono::microseconds{ static_cast<uint32_t>(parsed.fracseconds.value() * 1e6 + .5) };
+		out += std::chrono::microseconds{ parsed.microseconds.value() };
 	}
 
 	if (parsed.utc_offset_minutes)
@@ -225,9 +420,9 @@ void string_to_time_of_day(std::string_view in, time_of_day& out)
 
 	auto tmp = std::chrono::microseconds{ (3600LL * parsed.hours + 60 * parsed.minutes + parsed.seconds) * 1000000LL };
 
-	if (parsed.fracseconds)
+	if (parsed.microseconds)
 	{
-		tmp += std::chrono::microseconds{ static_cast<uint32_t>(parsed.fracseconds.value() * 1e6 + .5) };
+		tmp += std::chrono::microseconds{ parsed.microseconds.value() };
 	}
 
 	if (parsed.utc_offset_minutes)
@@ -245,41 +440,27 @@ time_of_day string_to_time_of_day(std::string_view in)
 	return result;
 }
 
-void time_point_to_string(const time_point& in, std::string& out, const char date_time_separator, bool zulu)
+std::to_chars_result time_point_to_chars(char* first, char* last, const time_point& in, const char date_time_separator, bool zulu)
 {
-	// TODO: use std::format when it becomes available in libstdc++
 	using namespace std::chrono;
-	auto dp   = floor<days>(in);
-	auto date = year_month_day{ dp };
-	auto time = hh_mm_ss{ floor<microseconds>(in - dp) };
-
-	if (time.subseconds().count())
-	{
-		out = fmt::format("{:04d}-{:02d}-{:02d}{}{:02d}:{:02d}:{:02d}.{:06d}",
-		                  static_cast<int>(date.year()),
-		                  static_cast<unsigned>(date.month()),
-		                  static_cast<unsigned>(date.day()),
-		                  date_time_separator,
-		                  static_cast<long>(time.hours().count()),
-		                  static_cast<long>(time.minutes().count()),
-		                  static_cast<long>(time.seconds().count()),
-		                  static_cast<long>(time.subseconds().count()));
-	}
-	else
-	{
-		out = fmt::format("{:04d}-{:02d}-{:02d}{}{:02d}:{:02d}:{:02d}",
-		                  static_cast<int>(date.year()),
-		                  static_cast<unsigned>(date.month()),
-		                  static_cast<unsigned>(date.day()),
-		                  date_time_separator,
-		                  static_cast<long>(time.hours().count()),
-		                  static_cast<long>(time.minutes().count()),
-		                  static_cast<long>(time.seconds().count()));
-	}
+	const auto dp = floor<days>(in);
+
+	char buf[time_point_chars_max];
+	auto end = write_date(buf, year_month_day{ dp });
+	*end++   = date_time_separator;
+	end      = write_time_of_day(end, time_of_day{ floor<microseconds>(in - dp) });
 	if (zulu)
 	{
-		out.append("Z");
+		*end++ = 'Z';
 	}
+	return copy_chars(buf, end, first, last);
+}
+
+void time_point_to_string(const time_point& in, std::string& out, const char date_time_separator, bool zulu)
+{
+	char       buf[time_point_chars_max];
+	const auto res = time_point_to_chars(buf, buf + sizeof(buf), in, date_time_separator, zulu);
+	out.assign(buf, res.ptr);
 }
 
 std::string time_point_to_string(const time_point& in, const char date_time_separator, bool zulu)
@@ -327,10 +508,18 @@ boost::posix_time::ptime time_point_to_boost_ptime(const time_point& in)
 	return out;
 }
 
+std::to_chars_result date_to_chars(char* first, char* last, const date& in)
+{
+	char       buf[date_chars_max];
+	const auto end = write_date(buf, in);
+	return copy_chars(buf, end, first, last);
+}
+
 void date_to_string(const date& in, std::string& out)
 {
-	out = fmt::format(
-	    "{:04d}-{:02d}-{:02d}", static_cast<int>(in.year()), static_cast<unsigned>(in.month()), static_cast<unsigned>(in.day()));
+	char       buf[date_chars_max];
+	const auto res = date_to_chars(buf, buf + sizeof(buf), in);
+	out.assign(buf, res.ptr);
 }
 
 std::string date_to_string(const date& in)
@@ -340,24 +529,18 @@ std::string date_to_string(const date& in)
 	return result;
 }
 
+std::to_chars_result time_of_day_to_chars(char* first, char* last, const time_of_day& in)
+{
+	char       buf[time_of_day_chars_max];
+	const auto end = write_time_of_day(buf, in);
+	return copy_chars(buf, end, first, last);
+}
+
 void time_of_day_to_string(const time_of_day& in, std::string& out)
 {
-	// TODO: use std::format when it becomes available in libstdc++
-	if (in.subseconds().count())
-	{
-		out = fmt::format("{:02d}:{:02d}:{:02d}.{:06d}",
-		                  static_cast<long>(in.hours().count()),
-		                  static_cast<long>(in.minutes().count()),
-		                  static_cast<long>(in.seconds().count()),
-		                  static_cast<long>(in.subseconds().count()));
-	}
-	else
-	{
-		out = fmt::format("{:02d}:{:02d}:{:02d}",
-		                  static_cast<long>(in.hours().count()),
-		                  static_cast<long>(in.minutes().count()),
-		                  static_cast<long>(in.seconds().count()));
-	}
+	char       buf[time_of_day_chars_max];
+	const auto res = time_of_day_to_chars(buf, buf + sizeof(buf), in);
+	out.assign(buf, res.ptr);
 }
 
 std::string time_of_day_to_string(const time_of_day& in)
@@ -453,9 +636,9 @@ void string_to_boost_ptime(std::string_view in, boost::posix_time::ptime& out)
 		                                                    static_cast<short unsigned int>(parsed.day) },
 		                            boost::posix_time::time_duration{ parsed.hours, parsed.minutes, parsed.seconds } };
 
-	if (parsed.fracseconds)
+	if (parsed.microseconds)
 	{
-		out += boost::posix_time::microseconds{ static_cast<uint32_t>(parsed.fracseconds.value() * 1e6 + .5) };
+		out += boost::posix_time::microseconds{ parsed.microseconds.value() };
 	}
 
 	if (parsed.utc_offset_minutes)
@@ -498,9 +681,9 @@ void string_to_boost_time_duration(std::string_view in, boost::posix_time::time_
 
 	out = boost::posix_time::time_duration{ parsed.hours, parsed.minutes, parsed.seconds };
 
-	if (parsed.fracseconds)
+	if (parsed.microseconds)
 	{
-		out += boost::posix_time::microseconds{ static_cast<uint32_t>(parsed.fracseconds.value() * 1e6 + .5) };
+		out += boost::posix_time::microseconds{ parsed.microseconds.value() };
 	}
 
 	if (parsed.utc_offset_minutes)
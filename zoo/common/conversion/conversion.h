@@ -19,6 +19,7 @@
 
 #include <type_traits>
 #include <charconv>
+#include <cstddef>
 #include <stdexcept>
 #include <system_error>
 #include <sstream>
@@ -75,6 +76,22 @@ date ZOO_ZOOCOMMON_API string_to_date(std::string_view in);
 void ZOO_ZOOCOMMON_API        string_to_time_of_day(std::string_view in, time_of_day& out);
 time_of_day ZOO_ZOOCOMMON_API string_to_time_of_day(std::string_view in);
 
+// The *_to_chars functions format into a caller supplied buffer [first, last), like std::to_chars.
+// On success, ptr is one past the last character written and ec is value-initialized.
+// If the buffer is too small, ptr is last, ec is std::errc::value_too_large and the contents of the buffer are unspecified.
+// A buffer of the *_chars_max size below is always large enough.
+
+constexpr std::size_t time_point_chars_max  = 40;
+constexpr std::size_t date_chars_max        = 16;
+constexpr std::size_t time_of_day_chars_max = 24;
+
+std::to_chars_result ZOO_ZOOCOMMON_API
+time_point_to_chars(char* first, char* last, const time_point& in, const char date_time_separator, bool zulu);
+
+std::to_chars_result ZOO_ZOOCOMMON_API date_to_chars(char* first, char* last, const date& in);
+
+std::to_chars_result ZOO_ZOOCOMMON_API time_of_day_to_chars(char* first, char* last, const time_of_day& in);
+
 void ZOO_ZOOCOMMON_API        time_point_to_string(const time_point& in, std::string& out, const char date_time_separator, bool zulu);
 std::string ZOO_ZOOCOMMON_API time_point_to_string(const time_point& in, const char date_time_separator, bool zulu);
 
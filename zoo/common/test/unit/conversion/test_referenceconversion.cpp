@@ -0,0 +1,539 @@
+//
+// Copyright (C) 2024 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Differential tests of the date and time conversions against the former implementation,
+// which matched the input with regular expressions and formatted with fmt.
+// Both must accept the same strings and produce the same values.
+
+#include <gtest/gtest.h>
+#include <zoo/common/conversion/conversion.h>
+
+#include <fmt/format.h>
+
+#include <functional>
+#include <optional>
+#include <random>
+#include <regex>
+#include <string>
+#include <vector>
+
+namespace zoo {
+namespace conversion {
+
+namespace {
+
+namespace reference {
+
+struct parsed_time final
+{
+	std::optional<double> fracseconds;
+	std::optional<int>    utc_offset_minutes;
+};
+
+void parse_fraction_and_offset(const std::match_results<std::string_view::const_iterator>& matches,
+                               std::size_t                                                  fraction,
+                               std::size_t                                                  hours,
+                               std::size_t                                                  minutes,
+                               parsed_time&                                                 out)
+{
+	if (matches.length(fraction) > 1)
+	{
+		out.fracseconds = string_to_number<double>(matches[fraction].str());
+	}
+
+	if (matches.length(hours))
+	{
+		const auto h                = matches[hours].str();
+		const auto utc_offset_hours = string_to_number<int>((h.front() == '+') ? &h[1] : h);
+		out.utc_offset_minutes      = utc_offset_hours * 60;
+
+		if (matches.length(minutes))
+		{
+			out.utc_offset_minutes.value() += string_to_number<int>(matches[minutes].str()) * (utc_offset_hours < 0 ? -1 : 1);
+		}
+	}
+}
+
+template<typename Out>
+void apply_fraction_and_offset(const parsed_time& parsed, Out& out)
+{
+	if (parsed.fracseconds)
+	{
+		out += std::chrono::microseconds{ static_cast<uint32_t>(parsed.fracseconds.value() * 1e6 + .5) };
+	}
+
+	if (parsed.utc_offset_minutes)
+	{
+		out -= std::chrono::minutes{ parsed.utc_offset_minutes.value() };
+	}
+}
+
+time_point string_to_time_point(std::string_view in)
+{
+	static const std::regex re{ R"(^(\d{4})-(\d{2})-(\d{2})[T ](\d{2}):(\d{2}):(\d{2})(\.\d*)?( ?([+-]\d{2})(:?(\d{2}))?|Z)?$)" };
+
+	std::match_results<std::string_view::const_iterator> matches;
+	if (!std::regex_match(in.begin(), in.end(), matches, re) || matches.size() != 1 + 11)
+	{
+		throw std::invalid_argument{ "invalid time point format" };
+	}
+
+	auto out = time_point{ std::chrono::sys_days{ std::chrono::year{ string_to_number<int>(matches[1].str()) } /
+		                                          std::chrono::month{ string_to_number<unsigned>(matches[2].str()) } /
+		                                          string_to_number<unsigned>(matches[3].str()) } +
+		                   std::chrono::hours{ string_to_number<unsigned>(matches[4].str()) } +
+		                   std::chrono::minutes{ string_to_number<unsigned>(matches[5].str()) } +
+		                   std::chrono::seconds{ string_to_number<unsigned>(matches[6].str()) } };
+
+	auto parsed = parsed_time{};
+	parse_fraction_and_offset(matches, 7, 9, 11, parsed);
+	apply_fraction_and_offset(parsed, out);
+	return out;
+}
+
+date string_to_date(std::string_view in)
+{
+	static const std::regex re1{ R"(^(-?\d{1,4})-(\d{2})-(\d{2})$)" };
+	static const std::regex re2{ R"(^(-?\d{4})(\d{2})(\d{2})$)" };
+
+	auto matches = std::match_results<std::string_view::const_iterator>{};
+	if (!std::regex_match(in.begin(), in.end(), matches, re1) || matches.size() != 1 + 3)
+	{
+		if (!std::regex_match(in.begin(), in.end(), matches, re2) || matches.size() != 1 + 3)
+		{
+			throw std::invalid_argument{ "invalid date format" };
+		}
+	}
+
+	return std::chrono::sys_days{ std::chrono::year{ string_to_number<int>(matches[1].str()) } /
+		                          std::chrono::month{ string_to_number<unsigned>(matches[2].str()) } /
+		                          string_to_number<unsigned>(matches[3].str()) };
+}
+
+time_of_day string_to_time_of_day(std::string_view in)
+{
+	static const std::regex re{ R"(^(\d{2}):(\d{2}):(\d{2})(\.\d*)?( ?([+-]\d{2})(:?(\d{2}))?)?$)" };
+
+	std::match_results<std::string_view::const_iterator> matches;
+	if (!std::regex_match(in.begin(), in.end(), matches, re) || matches.size() != 1 + 8)
+	{
+		throw std::invalid_argument{ "invalid time of day format" };
+	}
+
+	auto tmp = std::chrono::microseconds{ (3600LL * string_to_number<unsigned>(matches[1].str()) +
+		                                   60 * string_to_number<unsigned>(matches[2].str()) + string_to_number<unsigned>(matches[3].str())) *
+		                                  1000000LL };
+
+	auto parsed = parsed_time{};
+	parse_fraction_and_offset(matches, 4, 6, 8, parsed);
+	apply_fraction_and_offset(parsed, tmp);
+	return time_of_day{ tmp };
+}
+
+std::string time_point_to_string(const time_point& in, const char date_time_separator, bool zulu)
+{
+	using namespace std::chrono;
+	auto dp   = floor<days>(in);
+	auto date = year_month_day{ dp };
+	auto time = hh_mm_ss{ floor<microseconds>(in - dp) };
+
+	auto out = fmt::format("{:04d}-{:02d}-{:02d}{}{:02d}:{:02d}:{:02d}",
+	                       static_cast<int>(date.year()),
+	                       static_cast<unsigned>(date.month()),
+	                       static_cast<unsigned>(date.day()),
+	                       date_time_separator,
+	                       static_cast<long>(time.hours().count()),
+	                       static_cast<long>(time.minutes().count()),
+	                       static_cast<long>(time.seconds().count()));
+	if (time.subseconds().count())
+	{
+		out += fmt::format(".{:06d}", static_cast<long>(time.subseconds().count()));
+	}
+	if (zulu)
+	{
+		out.append("Z");
+	}
+	return out;
+}
+
+std::string date_to_string(const date& in)
+{
+	return fmt::format(
+	    "{:04d}-{:02d}-{:02d}", static_cast<int>(in.year()), static_cast<unsigned>(in.month()), static_cast<unsigned>(in.day()));
+}
+
+std::string time_of_day_to_string(const time_of_day& in)
+{
+	auto out = fmt::format("{:02d}:{:02d}:{:02d}",
+	                       static_cast<long>(in.hours().count()),
+	                       static_cast<long>(in.minutes().count()),
+	                       static_cast<long>(in.seconds().count()));
+	if (in.subseconds().count())
+	{
+		out += fmt::format(".{:06d}", static_cast<long>(in.subseconds().count()));
+	}
+	return out;
+}
+
+} // namespace reference
+
+// Either the error message, or the value formatted by the reference formatter
+template<typename Parse, typename Format>
+std::string outcome(Parse parse, Format format, std::string_view in)
+{
+	try
+	{
+		return format(parse(in));
+	}
+	catch (const std::exception& e)
+	{
+		return std::string{ "error: " } + e.what();
+	}
+}
+
+std::string time_point_outcome(std::function<time_point(std::string_view)> parse, std::string_view in)
+{
+	return outcome(
+	    parse,
+	    [](const time_point& tp) {
+		    return reference::time_point_to_string(tp, 'T', false) + fmt::format(" ({})", tp.time_since_epoch().count());
+	    },
+	    in);
+}
+
+std::string date_outcome(std::function<date(std::string_view)> parse, std::string_view in)
+{
+	return outcome(
+	    parse,
+	    [](const date& d) {
+		    return fmt::format("{}/{}/{}", static_cast<int>(d.year()), static_cast<unsigned>(d.month()), static_cast<unsigned>(d.day()));
+	    },
+	    in);
+}
+
+std::string time_of_day_outcome(std::function<time_of_day(std::string_view)> parse, std::string_view in)
+{
+	return outcome(parse, [](const time_of_day& t) { return std::to_string(t.to_duration().count()); }, in);
+}
+
+// Valid inputs with random field values, of which a character is randomly replaced, inserted or removed half of the time
+class input_generator final
+{
+	std::mt19937_64 engine_;
+
+	std::string digits(std::size_t count)
+	{
+		auto out = std::string{};
+		for (auto i = std::size_t{}; i < count; ++i)
+		{
+			out += static_cast<char>('0' + this->pick(10u));
+		}
+		return out;
+	}
+
+	std::string fraction()
+	{
+		switch (this->pick(4u))
+		{
+		case 0u:
+			return {};
+		case 1u:
+			return ".";
+		default:
+			return "." + this->digits(this->pick(12u) + 1u);
+		}
+	}
+
+	std::string utc_offset(bool zulu)
+	{
+		switch (this->pick(zulu ? 6u : 5u))
+		{
+		case 0u:
+			return {};
+		case 1u:
+			return (this->pick(2u) ? " " : "") + std::string{ this->pick(2u) ? '+' : '-' } + this->digits(2u);
+		case 2u:
+			return (this->pick(2u) ? " " : "") + std::string{ this->pick(2u) ? '+' : '-' } + this->digits(2u) + this->digits(2u);
+		case 3u:
+		case 4u:
+			return (this->pick(2u) ? " " : "") + std::string{ this->pick(2u) ? '+' : '-' } + this->digits(2u) + ":" + this->digits(2u);
+		default:
+			return "Z";
+		}
+	}
+
+	std::string mutate(std::string in)
+	{
+		static constexpr std::string_view alphabet{ "0123456789-+:. TZx" };
+
+		if (this->pick(2u) == 0u)
+		{
+			return in;
+		}
+		const auto c   = alphabet[this->pick(alphabet.length())];
+		const auto pos = this->pick(in.length() + 1u);
+		switch (this->pick(4u))
+		{
+		case 0u:
+			in.insert(pos, 1u, c);
+			break;
+		case 1u:
+			if (pos < in.length())
+			{
+				in[pos] = c;
+			}
+			break;
+		case 2u:
+			if (pos < in.length())
+			{
+				in.erase(pos, 1u);
+			}
+			break;
+		default:
+			in.resize(pos);
+			break;
+		}
+		return in;
+	}
+
+public:
+	input_generator()
+	    : engine_{ 20240506u }
+	{
+	}
+
+	std::size_t pick(std::size_t n)
+	{
+		return std::uniform_int_distribution<std::size_t>{ 0u, n - 1u }(this->engine_);
+	}
+
+	std::string time_point()
+	{
+		return this->mutate(this->digits(4u) + "-" + this->digits(2u) + "-" + this->digits(2u) + (this->pick(2u) ? "T" : " ") + this->time());
+	}
+
+	std::string date()
+	{
+		const auto sign = this->pick(4u) ? "" : "-";
+		return this->mutate(this->pick(2u) ? sign + this->digits(this->pick(4u) + 1u) + "-" + this->digits(2u) + "-" + this->digits(2u)
+		                                    : sign + this->digits(8u));
+	}
+
+	std::string time_of_day()
+	{
+		return this->mutate(this->digits(2u) + ":" + this->digits(2u) + ":" + this->digits(2u) + this->fraction() + this->utc_offset(false));
+	}
+
+private:
+	std::string time()
+	{
+		return this->digits(2u) + ":" + this->digits(2u) + ":" + this->digits(2u) + this->fraction() + this->utc_offset(true);
+	}
+};
+
+constexpr auto generated_inputs = 20000;
+
+const std::vector<std::string> time_point_inputs{ "",
+	                                              "2022-03-18 23:59:45",
+	                                              "2022-03-18T23:59:45",
+	                                              "2022-03-18T23:59:45Z",
+	                                              "2022-03-18T23:59:45 Z",
+	                                              "2022-03-18T23:59:45Z+01",
+	                                              "2022-03-18T23:59:45ZZ",
+	                                              "2022-03-18T23:59:45.Z",
+	                                              "2022-03-18T23:59:45.",
+	                                              "2022-03-18T23:59:45.0",
+	                                              "2022-03-18T23:59:45.000000",
+	                                              "2022-03-18T23:59:45.0000004",
+	                                              "2022-03-18T23:59:45.0000005",
+	                                              "2022-03-18T23:59:45.0000015",
+	                                              "2022-03-18T23:59:45.9999994",
+	                                              "2022-03-18T23:59:45.9999995",
+	                                              "2022-03-18T23:59:45.999999999999999999999999",
+	                                              "2022-03-18T23:59:45.123456789",
+	                                              "2022-03-18T23:59:45..1",
+	                                              "2022-03-18T23:59:45 ",
+	                                              "2022-03-18T23:59:45  +01",
+	                                              "2022-03-18T23:59:45+01:",
+	                                              "2022-03-18T23:59:45+01:3",
+	                                              "2022-03-18T23:59:45+013",
+	                                              "2022-03-18T23:59:45+01300",
+	                                              "2022-03-18T23:59:45-00:30",
+	                                              "2022-03-18T23:59:45+00:30",
+	                                              "2022-03-18T23:59:45-99:99",
+	                                              "2022-03-18T23:59:45+1",
+	                                              "2022-03-18t23:59:45",
+	                                              "2022-13-32T25:61:61",
+	                                              "0000-00-00T00:00:00",
+	                                              "9999-99-99T99:99:99.999999+99:99",
+	                                              "-022-03-18T23:59:45",
+	                                              "+022-03-18T23:59:45",
+	                                              "2022-03-18T23:59:45\n",
+	                                              std::string{ "2022-03-18T23:59:45\0", 20 } };
+
+const std::vector<std::string> date_inputs{ "",
+	                                        "-",
+	                                        "--03-18",
+	                                        "2022-03-18",
+	                                        "20220318",
+	                                        "-20220318",
+	                                        "-2022-03-18",
+	                                        "-0-03-18",
+	                                        "0-00-00",
+	                                        "12345-03-18",
+	                                        "202203180",
+	                                        "2022031",
+	                                        "2022-0318",
+	                                        "202203-18",
+	                                        "2022-03-18 ",
+	                                        " 2022-03-18",
+	                                        "+2022-03-18",
+	                                        "9999-99-99",
+	                                        "2022/03/18" };
+
+const std::vector<std::string> time_of_day_inputs{ "",
+	                                               "23:59:45",
+	                                               "23:59:45Z",
+	                                               "23:59:45.",
+	                                               "23:59:45.0000005",
+	                                               "23:59:45.9999995",
+	                                               "23:59:45.123456789012",
+	                                               "23:59:45 ",
+	                                               "23:59:45 +01",
+	                                               "23:59:45+01:",
+	                                               "23:59:45-00:30",
+	                                               "99:99:99.999999-99:99",
+	                                               "00:00:00+23:59",
+	                                               "23:59:45+0130",
+	                                               "23:59:45 +01:30",
+	                                               "23:59:45+1" };
+
+} // namespace
+
+TEST(ReferenceConversionsTest, StringToTimePoint)
+{
+	auto gen    = input_generator{};
+	auto inputs = time_point_inputs;
+	for (auto i = 0; i < generated_inputs; ++i)
+	{
+		inputs.push_back(gen.time_point());
+	}
+
+	for (const auto& in : inputs)
+	{
+		EXPECT_EQ(time_point_outcome([](std::string_view s) { return string_to_time_point(s); }, in),
+		          time_point_outcome(reference::string_to_time_point, in))
+		    << "input: \"" << in << "\"";
+	}
+}
+
+TEST(ReferenceConversionsTest, StringToDate)
+{
+	auto gen    = input_generator{};
+	auto inputs = date_inputs;
+	for (auto i = 0; i < generated_inputs; ++i)
+	{
+		inputs.push_back(gen.date());
+	}
+
+	for (const auto& in : inputs)
+	{
+		EXPECT_EQ(date_outcome([](std::string_view s) { return string_to_date(s); }, in), date_outcome(reference::string_to_date, in))
+		    << "input: \"" << in << "\"";
+	}
+}
+
+TEST(ReferenceConversionsTest, StringToTimeOfDay)
+{
+	auto gen    = input_generator{};
+	auto inputs = time_of_day_inputs;
+	for (auto i = 0; i < generated_inputs; ++i)
+	{
+		inputs.push_back(gen.time_of_day());
+	}
+
+	for (const auto& in : inputs)
+	{
+		EXPECT_EQ(time_of_day_outcome([](std::string_view s) { return string_to_time_of_day(s); }, in),
+		          time_of_day_outcome(reference::string_to_time_of_day, in))
+		    << "input: \"" << in << "\"";
+	}
+}
+
+TEST(ReferenceConversionsTest, TimePointToString)
+{
+	auto gen = input_generator{};
+	for (auto i = 0; i < generated_inputs; ++i)
+	{
+		// Within the range of a nanosecond system clock, half of them on a whole second
+		const auto seconds = static_cast<long long>(gen.pick(18'000'000'000u)) - 9'000'000'000LL;
+		const auto micro   = gen.pick(2u) ? static_cast<long long>(gen.pick(1'000'000u)) : 0LL;
+		const auto tp      = time_point{ std::chrono::seconds{ seconds } + std::chrono::microseconds{ micro } };
+
+		EXPECT_EQ(time_point_to_iso8601(tp), reference::time_point_to_string(tp, 'T', true));
+		EXPECT_EQ(time_point_to_sql(tp), reference::time_point_to_string(tp, ' ', false));
+	}
+}
+
+TEST(ReferenceConversionsTest, DateToString)
+{
+	auto gen = input_generator{};
+	for (auto i = 0; i < generated_inputs; ++i)
+	{
+		// Including negative and five digit years, and months and days that are out of range
+		const auto d = date{ std::chrono::year{ static_cast<int>(gen.pick(65535u)) - 32767 },
+			                 std::chrono::month{ static_cast<unsigned>(gen.pick(256u)) },
+			                 std::chrono::day{ static_cast<unsigned>(gen.pick(256u)) } };
+
+		EXPECT_EQ(date_to_string(d), reference::date_to_string(d));
+	}
+}
+
+TEST(ReferenceConversionsTest, TimeOfDayToString)
+{
+	auto gen = input_generator{};
+	for (auto i = 0; i < generated_inputs; ++i)
+	{
+		// Including negative durations and durations of more than a day
+		const auto micro = static_cast<long long>(gen.pick(1'000'000'000'000u)) - 500'000'000'000LL;
+		const auto t     = time_of_day{ std::chrono::microseconds{ gen.pick(2u) ? micro : micro / 1'000'000 * 1'000'000 } };
+
+		EXPECT_EQ(time_of_day_to_string(t), reference::time_of_day_to_string(t));
+	}
+
+	const auto longest = time_of_day{ std::chrono::microseconds::max() };
+	EXPECT_EQ(time_of_day_to_string(longest), reference::time_of_day_to_string(longest));
+}
+
+TEST(ReferenceConversionsTest, ToCharsBufferTooSmall)
+{
+	const auto tp = time_point{ std::chrono::sys_days{ std::chrono::year{ 2022 } / 3 / 18 } + std::chrono::microseconds{ 1 } };
+
+	char buf[time_point_chars_max];
+	auto res = time_point_to_chars(buf, buf + sizeof(buf), tp, 'T', true);
+	ASSERT_EQ(res.ec, std::errc{});
+	EXPECT_EQ(std::string(buf, res.ptr), "2022-03-18T00:00:00.000001Z");
+
+	res = time_point_to_chars(buf, buf + 27, tp, 'T', true);
+	EXPECT_EQ(res.ec, std::errc{});
+	EXPECT_EQ(res.ptr, buf + 27);
+
+	res = time_point_to_chars(buf, buf + 26, tp, 'T', true);
+	EXPECT_EQ(res.ec, std::errc::value_too_large);
+	EXPECT_EQ(res.ptr, buf + 26);
+
+	const auto d = date{ std::chrono::year{ 2022 } / 3 / 18 };
+	res          = date_to_chars(buf, buf + 9, d);
+	EXPECT_EQ(res.ec, std::errc::value_too_large);
+
+	const auto t = time_of_day{ std::chrono::seconds{ 1 } };
+	res          = time_of_day_to_chars(buf, buf + 7, t);
+	EXPECT_EQ(res.ec, std::errc::value_too_large);
+}
+
+} // namespace conversion
+} // namespace zoo
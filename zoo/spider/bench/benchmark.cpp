@@ -0,0 +1,56 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "benchmark.h"
+
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+
+namespace zoo {
+namespace spider {
+namespace bench {
+
+bool selected(const options& options, std::string_view name)
+{
+	return name.find(options.filter) != std::string_view::npos;
+}
+
+void run(const options& options, std::string_view name, const std::function<void()>& function)
+{
+	if (!selected(options, name))
+	{
+		return;
+	}
+
+	using clock = std::chrono::steady_clock;
+
+	auto iterations = std::uint64_t{ 1 };
+	auto elapsed    = clock::duration{};
+	for (;;)
+	{
+		const auto start = clock::now();
+		for (auto i = iterations; i != 0u; --i)
+		{
+			function();
+		}
+		elapsed = clock::now() - start;
+		if (elapsed >= options.min_time)
+		{
+			break;
+		}
+		iterations *= 2u;
+	}
+
+	const auto ns = std::chrono::duration<double, std::nano>{ elapsed }.count() / static_cast<double>(iterations);
+	std::cout << std::left << std::setw(40) << name << std::right << std::setw(12) << iterations << std::setw(14) << std::fixed
+	          << std::setprecision(1) << ns << "\n";
+}
+
+} // namespace bench
+} // namespace spider
+} // namespace zoo
@@ -0,0 +1,61 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace zoo {
+namespace spider {
+namespace bench {
+
+struct options final
+{
+	std::string               filter{};         //!< Only run the benchmarks whose name contains this string
+	std::size_t               resources{ 100 }; //!< Number of resources of the API
+	std::chrono::milliseconds min_time{ 200 };  //!< Minimum duration of a routing run
+	std::size_t               threads{};        //!< Number of server threads, 0 means half the hardware threads
+	std::size_t               connections{};    //!< Number of client connections, 0 means 4 per server thread
+	std::chrono::milliseconds duration{ 2000 }; //!< Duration of a server run
+};          //!< Only run the benchmarks whose name contains this string
+	std::size_t               resources{ 100 };  //!< Number of resources of the API
+	std::chrono::milliseconds min_time{ 200 };   //!< Minimum duration of a run
+	std::size_t               threads{};         //!< Number of server threads, 0 means half the hardware threads
+	std::size_t               connections{};     //!< Number of client connections, 0 means 4 per server thread
+	std::chrono::milliseconds duration{ 2000 };  //!< Duration of a server run
+};
+
+/// Keep the compiler from optimizing away the computation of @a value.
+template<typename T>
+void do_not_optimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static volatile const void* sink{};
+	sink = &value;
+	std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+/// Whether the benchmark @a name is selected by the filter of @a options
+bool selected(const options& options, std::string_view name);
+
+/// Run @a function until the run takes at least the minimum time of @a options, and report the time per call.
+void run(const options& options, std::string_view name, const std::function<void()>& function);
+
+void run_route_benchmarks(const options& options);
+void run_server_benchmarks(const options& options);
+
+} // namespace bench
+} // namespace spider
+} // namespace zoo
@@ -0,0 +1,97 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Benchmarks of spider: the routing of REST requests, and serving HTTP on loopback with the single acceptor of the
+// listener versus the SO_REUSEPORT acceptors of the server.
+
+#include "benchmark.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace {
+
+constexpr auto usage = R"(Usage: zoo_spider_bench [options]
+Options:
+  --filter=<text>       Only run the benchmarks whose name contains <text>
+  --resources=<n>       Number of resources of the API, each has 6 routes (default 100)
+  --min-time=<ms>       Minimum duration of a routing run in milliseconds (default 200)
+  --threads=<n>         Number of server threads (default half the hardware threads)
+  --connections=<n>     Number of client connections (default 4 per server thread)
+  --duration=<ms>       Duration of a server run in milliseconds (default 2000)
+  --help                Show this help
+)";
+
+zoo::spider::bench::options parse_options(int argc, char* argv[])
+{
+	zoo::spider::bench::options options{};
+	for (auto i = 1; i < argc; ++i)
+	{
+		const auto arg   = std::string_view{ argv[i] };
+		const auto eq    = arg.find('=');
+		const auto name  = arg.substr(0, eq);
+		const auto value = eq == std::string_view::npos ? std::string{} : std::string{ arg.substr(eq + 1) };
+
+		if (name == "--filter")
+		{
+			options.filter = value;
+		}
+		else if (name == "--resources")
+		{
+			options.resources = std::stoul(value);
+		}
+		else if (name == "--min-time")
+		{
+			options.min_time = std::chrono::milliseconds{ std::stol(value) };
+		}
+		else if (name == "--threads")
+		{
+			options.threads = std::stoul(value);
+		}
+		else if (name == "--connections")
+		{
+			options.connections = std::stoul(value);
+		}
+		else if (name == "--duration")
+		{
+			options.duration = std::chrono::milliseconds{ std::stol(value) };
+		}
+		else if (name == "--help")
+		{
+			std::cout << usage;
+			std::exit(0);
+		}
+		else
+		{
+			throw std::invalid_argument{ "unknown option " + std::string{ arg } + "\n" + usage };
+		}
+	}
+	return options;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	try
+	{
+		const auto options = parse_options(argc, argv);
+
+		zoo::spider::bench::run_route_benchmarks(options);
+		zoo::spider::bench::run_server_benchmarks(options);
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << "\n";
+		return 1;
+	}
+	return 0;
+}
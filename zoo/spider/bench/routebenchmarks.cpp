@@ -0,0 +1,143 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Benchmarks of the routing of REST requests, comparing the route tree with the linear scan over the path specs
+// that the rest router did before, on an API of several hundred routes.
+
+#include "benchmark.h"
+
+#include "zoo/spider/rest/path.h"
+#include "zoo/spider/rest/pathspec.h"
+#include "zoo/spider/rest/routetree.h"
+
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace zoo {
+namespace spider {
+namespace bench {
+
+namespace {
+
+/// The routes of a REST API with @a resources resources, like a controller would add them
+struct api final
+{
+	std::vector<std::string>                texts; // the path specs refer to these
+	std::vector<std::pair<verb, path_spec>> routes;
+	route_tree                              tree;
+
+	explicit api(std::size_t resources)
+	    : texts{}
+	    , routes{}
+	    , tree{}
+	{
+		for (auto i = std::size_t{}; i < resources; ++i)
+		{
+			const auto resource = "api/v1/resource" + std::to_string(i);
+			this->texts.push_back(resource);
+			this->texts.push_back(resource + "/{id}");
+			this->texts.push_back(resource + "/{id}/items/{item}");
+		}
+		// Only now that texts no longer grows, the views into it stay valid
+		for (auto i = std::size_t{}; i < this->texts.size(); i += 3u)
+		{
+			this->add(verb::get, this->texts[i]);
+			this->add(verb::post, this->texts[i]);
+			this->add(verb::get, this->texts[i + 1u]);
+			this->add(verb::put, this->texts[i + 1u]);
+			this->add(verb::delete_, this->texts[i + 1u]);
+			this->add(verb::get, this->texts[i + 2u]);
+		}
+	}
+
+	void add(verb method, std::string_view spec)
+	{
+		this->routes.emplace_back(method, path_spec{ spec });
+		this->tree.add(method, this->routes.back().second);
+	}
+
+	// What rest_router::route_request did before the route tree: 0 = found, 1 = method not allowed, 2 = not found
+	int linear(verb method, const path& p) const
+	{
+		auto found = false;
+		for (const auto& [m, spec] : this->routes)
+		{
+			if (m == method)
+			{
+				const auto params = spec.match(p);
+				if (params.has_value())
+				{
+					do_not_optimize(params);
+					return 0;
+				}
+			}
+			else if (spec.match(p).has_value())
+			{
+				found = true;
+			}
+		}
+		return found ? 1 : 2;
+	}
+
+	int radix(verb method, const path& p) const
+	{
+		const auto match = this->tree.match(method, p);
+		if (match.route)
+		{
+			do_not_optimize(match.params);
+			return 0;
+		}
+		return match.path_found ? 1 : 2;
+	}
+};
+
+} // namespace
+
+void run_route_benchmarks(const options& options)
+{
+	const auto a    = api{ options.resources };
+	const auto last = std::to_string(options.resources - 1u);
+
+	struct scenario final
+	{
+		std::string name;
+		verb        method;
+		std::string target;
+		int         expected;
+	};
+
+	const auto scenarios = std::vector<scenario>{
+		{ "first", verb::get, "/api/v1/resource0", 0 },
+		{ "middle_param", verb::put, "/api/v1/resource" + std::to_string(options.resources / 2u) + "/42", 0 },
+		{ "last_nested", verb::get, "/api/v1/resource" + last + "/42/items/7", 0 },
+		{ "method_not_allowed", verb::patch, "/api/v1/resource" + last + "/42", 1 },
+		{ "not_found", verb::get, "/api/v1/unknown/42", 2 },
+	};
+
+	std::cout << a.routes.size() << " routes\n";
+	std::cout << std::left << std::setw(40) << "benchmark" << std::right << std::setw(12) << "iterations" << std::setw(14) << "ns/op"
+	          << "\n";
+
+	for (const auto& s : scenarios)
+	{
+		const auto p = path{ s.target };
+		if (a.linear(s.method, p) != s.expected || a.radix(s.method, p) != s.expected)
+		{
+			throw std::runtime_error{ "unexpected routing result for " + s.name };
+		}
+		run(options, "route/linear/" + s.name, [&] { do_not_optimize(a.linear(s.method, p)); });
+		run(options, "route/tree/" + s.name, [&] { do_not_optimize(a.radix(s.method, p)); });
+	}
+}
+
+} // namespace bench
+} // namespace spider
+} // namespace zoo
@@ -0,0 +1,241 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Benchmarks of serving HTTP on loopback. The listener model runs a single acceptor on one io_context that all threads
+// run, every session on a strand. The server model runs an io_context and an SO_REUSEPORT acceptor per thread.
+// Clients send GET requests on keep-alive connections, one request at a time per connection, each connection on its
+// own thread.
+
+#include "benchmark.h"
+
+#include "zoo/spider/listener.h"
+#include "zoo/spider/server.h"
+#include "zoo/spider/irequest_handler.h"
+#include "zoo/spider/messages/string_response.h"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/http.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace zoo {
+namespace spider {
+namespace bench {
+
+namespace {
+
+constexpr auto loopback = std::string_view{ "127.0.0.1" };
+
+class hello_handler final : public irequest_handler
+{
+	response_wrapper handle_request(request&& req) override
+	{
+		return string_response::create(req, status::ok, "text/plain", std::string_view{ "Hello, world!" });
+	}
+};
+
+struct load_result final
+{
+	std::uint64_t            requests;
+	std::chrono::nanoseconds elapsed;
+};
+
+// Send requests to @a endpoint on @a connections connections for @a duration
+load_result load(const tcp::endpoint& endpoint, std::size_t connections, std::chrono::milliseconds duration)
+{
+	using clock = std::chrono::steady_clock;
+
+	auto connected = std::atomic<std::size_t>{};
+	auto go        = std::atomic<bool>{};
+	auto stop      = std::atomic<bool>{};
+	auto requests  = std::atomic<std::uint64_t>{};
+	auto failed    = std::atomic<bool>{};
+
+	auto clients = std::vector<std::thread>{};
+	clients.reserve(connections);
+	for (auto i = std::size_t{}; i < connections; ++i)
+	{
+		clients.emplace_back([&] {
+			try
+			{
+				auto ioc    = net::io_context{ 1 };
+				auto socket = tcp::socket{ ioc };
+				socket.connect(endpoint);
+				++connected;
+
+				auto req = http::request<http::empty_body>{ verb::get, "/", 11 };
+				req.set(http::field::host, loopback);
+				req.keep_alive(true);
+
+				auto buffer = beast::flat_buffer{};
+				auto count  = std::uint64_t{};
+				while (!go)
+				{
+					std::this_thread::yield();
+				}
+				while (!stop)
+				{
+					http::write(socket, req);
+					auto res = http::response<http::string_body>{};
+					http::read(socket, buffer, res);
+					if (stop)
+					{
+						break; // answered after the measured interval
+					}
+					++count;
+				}
+				requests += count;
+			}
+			catch (const std::exception& e)
+			{
+				std::cerr << "client: " << e.what() << "\n";
+				failed = true;
+				++connected;
+			}
+		});
+	}
+
+	while (connected < connections)
+	{
+		std::this_thread::yield();
+	}
+
+	const auto start = clock::now();
+	go               = true;
+	std::this_thread::sleep_for(duration);
+	stop               = true;
+	const auto elapsed = clock::now() - start;
+
+	for (auto& client : clients)
+	{
+		client.join();
+	}
+
+	if (failed)
+	{
+		throw std::runtime_error{ "a client failed" };
+	}
+
+	return load_result{ .requests = requests, .elapsed = elapsed };
+}
+
+void report(std::string_view name, std::size_t connections, const load_result& result)
+{
+	const auto seconds = std::chrono::duration<double>{ result.elapsed }.count();
+	const auto rate    = static_cast<double>(result.requests) / seconds;
+	// Every connection has one request in flight, so this is the mean round trip time
+	const auto latency = seconds * 1e6 * static_cast<double>(connections) / static_cast<double>(result.requests);
+	std::cout << std::left << std::setw(40) << name << std::right << std::setw(12) << result.requests << std::setw(14) << std::fixed
+	          << std::setprecision(0) << rate << std::setw(14) << std::setprecision(1) << latency << "\n";
+}
+
+// A port that is free right now, for the listener, which does not tell the port it binds
+std::uint16_t free_port()
+{
+	auto ioc      = net::io_context{ 1 };
+	auto acceptor = tcp::acceptor{ ioc, tcp::endpoint{ net::ip::make_address(loopback), 0 } };
+	return acceptor.local_endpoint().port();
+}
+
+load_result run_listener(const options& options, std::size_t threads, std::size_t connections)
+{
+	const auto handler = std::make_shared<hello_handler>();
+	const auto port    = free_port();
+
+	auto ioc = net::io_context{ static_cast<int>(threads) };
+	auto ec  = error_code{};
+	listener::run(ioc, loopback, port, handler, ec);
+	if (ec)
+	{
+		throw std::runtime_error{ "listener: " + ec.message() };
+	}
+
+	auto workers = std::vector<std::thread>{};
+	for (auto i = std::size_t{}; i < threads; ++i)
+	{
+		workers.emplace_back([&ioc] { ioc.run(); });
+	}
+
+	const auto result = load(tcp::endpoint{ net::ip::make_address(loopback), port }, connections, options.duration);
+
+	ioc.stop();
+	for (auto& worker : workers)
+	{
+		worker.join();
+	}
+	return result;
+}
+
+load_result run_server(const options& options, std::size_t threads, std::size_t connections, bool pin_threads)
+{
+	auto s  = server{ std::make_shared<hello_handler>(), server_settings{ .threads = threads, .pin_threads = pin_threads } };
+	auto ec = error_code{};
+	s.start(loopback, 0u, ec);
+	if (ec)
+	{
+		throw std::runtime_error{ "server: " + ec.message() };
+	}
+
+	const auto result = load(s.endpoint(), connections, options.duration);
+
+	s.stop();
+	s.join();
+	return result;
+}
+
+} // namespace
+
+void run_server_benchmarks(const options& options)
+{
+	const auto threads     = options.threads != 0u ? options.threads : std::max(1u, std::thread::hardware_concurrency() / 2u);
+	const auto connections = options.connections != 0u ? options.connections : 4u * threads;
+	const auto suffix      = "/t" + std::to_string(threads) + "/c" + std::to_string(connections);
+
+	struct model final
+	{
+		std::string                  name;
+		std::function<load_result()> run;
+	};
+
+	const auto models = std::vector<model>{
+		{ "serve/listener" + suffix, [&] { return run_listener(options, threads, connections); } },
+		{ "serve/server" + suffix, [&] { return run_server(options, threads, connections, false); } },
+		{ "serve/server_pinned" + suffix, [&] { return run_server(options, threads, connections, true); } },
+	};
+
+	auto header = false;
+	for (const auto& m : models)
+	{
+		if (!selected(options, m.name))
+		{
+			continue;
+		}
+		if (!header)
+		{
+			std::cout << std::left << std::setw(40) << "benchmark" << std::right << std::setw(12) << "requests" << std::setw(14)
+			          << "requests/s" << std::setw(14) << "latency us" << "\n";
+			header = true;
+		}
+		report(m.name, connections, m.run());
+	}
+}
+
+} // namespace bench
+} // namespace spider
+} // namespace zoo
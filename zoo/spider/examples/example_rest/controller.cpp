@@ -114,6 +114,13 @@ Controller::Controller()
 	        .method = verb::get, .path = path_spec{ "api" } / "v1" / "login", .operation_id = "login", .summary = "Get a bearer token" },
 	    &Operations::login,
 	    p::query{ "userName" });
+
+	add_operation(rest_operation{ .method       = verb::get,
+	                              .path         = path_spec{ "api" } / "v1" / "delay",
+	                              .operation_id = "delay",
+	                              .summary      = "Respond after a delay, without blocking the server" },
+	              &Operations::delay,
+	              p::query{ "ms", "The delay in milliseconds" });
 }
 
 std::string Controller::openApiSpec() const
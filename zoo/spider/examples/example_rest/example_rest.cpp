@@ -40,7 +40,27 @@ class LoggingHandler : public irequest_handler
 		// Get the response
 		auto res = handler_->handle_request(std::move(req));
 
-		// Log the response
+		log_response(reqNum, res);
+
+		return res;
+	}
+
+	net::awaitable<response_wrapper> async_handle_request(request req) override
+	{
+		// Log the request
+		const auto reqNum = ++reqNum_;
+		ZOO_LOG(trace, "[{}]>>>\n{}", reqNum, fmt::streamed(req));
+
+		// Get the response, the handler may suspend
+		auto res = co_await handler_->async_handle_request(std::move(req));
+
+		log_response(reqNum, res);
+
+		co_return res;
+	}
+
+	static void log_response(unsigned reqNum, const response_wrapper& res)
+	{
 		std::visit(
 		    [&](const auto& arg) {
 			    using P = std::decay_t<decltype(arg)>;
@@ -50,8 +70,6 @@ class LoggingHandler : public irequest_handler
 			    }
 		    },
 		    res.value());
-
-		return res;
 	}
 
 public:
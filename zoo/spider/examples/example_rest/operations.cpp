@@ -10,6 +10,11 @@
 
 #include <fmt/format.h>
 #include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include <chrono>
 
 namespace demo {
 
@@ -119,4 +124,11 @@ std::string Operations::login(const std::string& user)
 	return data.asToken();
 }
 
+net::awaitable<std::string> Operations::delay(std::uint64_t milliseconds)
+{
+	auto timer = net::steady_timer{ co_await net::this_coro::executor, std::chrono::milliseconds{ milliseconds } };
+	co_await timer.async_wait(net::use_awaitable);
+	co_return fmt::format("Waited {} ms", milliseconds);
+}
+
 } // namespace demo
@@ -16,6 +16,7 @@
 #include "zoo/spider/messages/content_container.hpp"
 
 #include <boost/optional/optional.hpp>
+#include <boost/asio/awaitable.hpp>
 
 #include <string>
 #include <vector>
@@ -55,6 +56,9 @@ public:
 
 	std::string login(const std::string& user);
 
+	// A coroutine, the session serves other requests while it waits
+	net::awaitable<std::string> delay(std::uint64_t milliseconds);
+
 private:
 	Customer createCustomer(const Customer& c);
 };
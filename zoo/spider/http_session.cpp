@@ -7,6 +7,7 @@
 
 #include "zoo/spider/http_session.h"
 #include "zoo/spider/irequest_handler.h"
+#include "zoo/spider/messages/error_response.h"
 #include "zoo/common/logging/logging.h"
 #include "zoo/common/misc/formatters.hpp"
 
@@ -14,9 +15,15 @@
 #include <boost/beast/http.hpp>
 #include <boost/beast/http/message_generator.hpp>
 #include <boost/asio/dispatch.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/exception/diagnostic_information.hpp>
 #include <boost/optional/optional.hpp>
 
-#include <vector>
+#include <cstdint>
+#include <deque>
+#include <optional>
 
 namespace zoo {
 namespace spider {
@@ -35,13 +42,19 @@ void fail(beast::error_code ec, char const* what)
 // Handles an HTTP server connection
 class http_session_impl final : public std::enable_shared_from_this<http_session_impl>
 {
-	static constexpr std::size_t queue_limit = 8; // max responses
-
-	tcp::socket::endpoint_type        endpoint_;
-	beast::tcp_stream                 stream_;
-	std::shared_ptr<irequest_handler> request_handler_;
-	beast::flat_buffer                buffer_;
-	std::vector<message_generator>    response_queue_;
+	static constexpr std::size_t queue_limit = 8;   // max responses
+	static constexpr auto        timeout     = 30s; // max time the client may keep us waiting
+
+	tcp::socket::endpoint_type                   endpoint_;
+	beast::tcp_stream                            stream_;
+	std::shared_ptr<irequest_handler>            request_handler_;
+	beast::flat_buffer                           buffer_;
+	std::deque<std::optional<message_generator>> response_queue_; // a slot per request, in the order of the requests
+	std::uint64_t                                front_sequence_; // sequence number of the request of the front slot
+	bool                                         writing_;
+	bool                                         read_closed_; // no more requests are read, e.g. the client sent EOF
+	bool                                         closed_;
+	net::steady_timer                            timer_; // times out the client, not the request handlers
 
 	// The parser is stored in an optional container so we can
 	// construct it from scratch it at the beginning of each new message.
@@ -55,10 +68,14 @@ public:
 	    , request_handler_{ request_handler }
 	    , buffer_{}
 	    , response_queue_{}
+	    , front_sequence_{}
+	    , writing_{}
+	    , read_closed_{}
+	    , closed_{}
+	    , timer_{ this->stream_.get_executor() }
 	    , parser_{}
 	{
 		static_assert(queue_limit > 0, "queue limit must be positive");
-		this->response_queue_.reserve(queue_limit);
 	}
 
 	~http_session_impl()
@@ -79,6 +96,11 @@ public:
 private:
 	void do_read()
 	{
+		if (this->read_closed_)
+		{
+			return;
+		}
+
 		// Construct a new parser for each message
 		this->parser_.emplace();
 
@@ -86,28 +108,74 @@ private:
 		// of the body in bytes to prevent abuse.
 		this->parser_->body_limit(10000);
 
-		// Set the timeout.
-		this->stream_.expires_after(30s);
-
-		// Read a request using the parser-oriented interface
+		// Read a request using the parser-oriented interface.
+		// The stream has no timeout of its own, it would close the socket while request handlers are still running.
 		http::async_read(
 		    this->stream_, this->buffer_, *this->parser_, beast::bind_front_handler(&http_session_impl::on_read, this->shared_from_this()));
+
+		this->update_timer();
 	}
 
-	void on_read(beast::error_code ec, std::size_t bytes_transferred)
+	// Time out the client while we wait for its next request or for it to take a response, but not while we wait
+	// for the request handlers
+	void update_timer()
 	{
-		boost::ignore_unused(bytes_transferred);
+		if (this->closed_)
+		{
+			return;
+		}
 
-		// Client closed the connection or read timed out
-		if (ec == http::error::end_of_stream || ec == beast::error::timeout)
+		if (this->writing_ || this->response_queue_.empty())
 		{
-			ZOO_LOG(debug, "read: {}", ec.message());
-			return this->do_close();
+			this->timer_.expires_after(timeout);
+			this->timer_.async_wait(beast::bind_front_handler(&http_session_impl::on_timer, this->shared_from_this()));
+		}
+		else
+		{
+			this->timer_.cancel();
+		}
+	}
+
+	void on_timer(beast::error_code ec)
+	{
+		// The expiry is checked because the timer may have been set again after it expired
+		if (ec || this->closed_ || this->timer_.expiry() > net::steady_timer::clock_type::now())
+		{
+			return;
 		}
 
+		ZOO_LOG(debug, "Timeout of session with {}", this->endpoint_);
+		this->closed_ = true;
+		this->stream_.close();
+	}
+
+	void on_read(beast::error_code ec, std::size_t bytes_transferred)
+	{
+		boost::ignore_unused(bytes_transferred);
+
 		if (ec)
 		{
-			return fail(ec, "read");
+			this->read_closed_ = true;
+
+			// Closed by the timer
+			if (this->closed_)
+			{
+				return;
+			}
+
+			// The client closed the connection
+			if (ec == http::error::end_of_stream)
+			{
+				ZOO_LOG(debug, "read: {}", ec.message());
+			}
+			else
+			{
+				fail(ec, "read");
+			}
+
+			// The responses to the requests that were already read are still sent, the connection is closed
+			// once they are written
+			return this->continue_writing();
 		}
 
 #if 0
@@ -121,28 +189,78 @@ private:
 		}
 #endif
 
-		// Send the response
-		this->queue_write(this->request_handler_->handle_request(parser_->release()));
+		// Reserve the slot of the response, so that it is sent in order even if the handlers of later requests
+		// finish first
+		const auto sequence = this->front_sequence_ + this->response_queue_.size();
+		this->response_queue_.emplace_back();
+
+		// The handler runs on the strand of the stream, so it can only suspend, never run in parallel with the session
+		net::co_spawn(this->stream_.get_executor(),
+		              handle_request(this->shared_from_this(), sequence, this->parser_->release()),
+		              net::detached);
 
 		// If we aren't at the queue limit, try to pipeline another request
 		if (this->response_queue_.size() < queue_limit)
 		{
 			this->do_read();
 		}
+		else
+		{
+			this->update_timer();
+		}
+	}
+
+	// Note: a static member, the shared pointer keeps the session alive while the handler is suspended
+	static net::awaitable<void> handle_request(std::shared_ptr<http_session_impl> self, std::uint64_t sequence, request req)
+	{
+		const auto version    = req.version();
+		const auto keep_alive = req.keep_alive();
+
+		auto response = std::optional<message_generator>{};
+		try
+		{
+			response.emplace(co_await self->request_handler_->async_handle_request(std::move(req)));
+		}
+		catch (...)
+		{
+			// Without a response the slot would block the responses to all later requests
+			ZOO_LOG(err, "request handler failed: {}", boost::current_exception_diagnostic_information());
+			auto rsp = internal_server_error::create();
+			rsp.version(version);
+			rsp.keep_alive(keep_alive);
+			response.emplace(std::move(rsp));
+		}
+
+		self->queue_write(sequence, std::move(response.value()));
 	}
 
-	void queue_write(message_generator&& response)
+	void queue_write(std::uint64_t sequence, message_generator&& response)
 	{
-		// Allocate and store the work
-		this->response_queue_.push_back(std::move(response));
+		// Store the response in its slot
+		this->response_queue_[sequence - this->front_sequence_].emplace(std::move(response));
 
-		// If there was no previous work, start the write loop
-		if (this->response_queue_.size() == 1u)
+		// If the write loop is idle, this may be the response it waits for
+		if (!this->writing_)
 		{
-			this->do_write();
+			this->continue_writing();
 		}
 	}
 
+	// Write the next response if it is ready and read another request if that made room in the queue.
+	// When all responses are written and no more requests are read, close the connection.
+	void continue_writing()
+	{
+		if (this->do_write() && !this->read_closed_)
+		{
+			return this->do_read();
+		}
+		else if (!this->writing_ && this->response_queue_.empty() && this->read_closed_)
+		{
+			return this->do_close();
+		}
+		this->update_timer();
+	}
+
 	// Called to start/continue the write-loop. Should not be called when
 	// write_loop is already active.
 	//
@@ -151,28 +269,41 @@ private:
 	{
 		const auto was_full = this->response_queue_.size() == queue_limit;
 
-		if (!this->response_queue_.empty())
+		if (!this->response_queue_.empty() && this->response_queue_.front().has_value())
 		{
-			auto msg = std::move(this->response_queue_.front());
-			this->response_queue_.erase(this->response_queue_.begin());
+			auto msg = std::move(this->response_queue_.front().value());
+			this->response_queue_.pop_front();
+			++this->front_sequence_;
+			this->writing_ = true;
 
 			const auto keep_alive = msg.keep_alive();
 
 			beast::async_write(this->stream_,
 			                   std::move(msg),
 			                   beast::bind_front_handler(&http_session_impl::on_write, this->shared_from_this(), keep_alive));
+
+			return was_full;
 		}
 
-		return was_full;
+		return false;
 	}
 
 	void on_write(bool keep_alive, beast::error_code ec, std::size_t bytes_transferred)
 	{
 		boost::ignore_unused(bytes_transferred);
 
+		// Note: writing_ remains set when the connection is done, so that the responses of the handlers that are still
+		// running are not written
+
 		if (ec)
 		{
-			return fail(ec, "write");
+			if (!this->closed_)
+			{
+				fail(ec, "write");
+				this->closed_ = true;
+				this->timer_.cancel();
+			}
+			return;
 		}
 
 		if (!keep_alive)
@@ -183,19 +314,23 @@ private:
 		}
 
 		// Inform the queue that a write completed
-		if (this->do_write())
-		{
-			// Read another request
-			this->do_read();
-		}
+		this->writing_ = false;
+		this->continue_writing();
 	}
 
 	void do_close()
 	{
+		this->read_closed_ = true;
+		this->closed_      = true;
+		this->timer_.cancel();
+
 		// Send a TCP shutdown
 		auto ec = beast::error_code{};
 		this->stream_.socket().shutdown(tcp::socket::shutdown_send, ec);
 
+		// A pipelined read may still be pending, nothing times it out and its handler keeps the session alive
+		this->stream_.cancel();
+
 		// At this point the connection is closed gracefully
 	}
 };
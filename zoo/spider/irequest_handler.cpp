@@ -18,5 +18,10 @@ irequest_handler::~irequest_handler() noexcept
 {
 }
 
+net::awaitable<response_wrapper> irequest_handler::async_handle_request(request req)
+{
+	co_return this->handle_request(std::move(req));
+}
+
 } // namespace spider
 } // namespace zoo
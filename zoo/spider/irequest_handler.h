@@ -12,6 +12,8 @@
 #include "zoo/spider/messages/message.h"
 #include "zoo/spider/messages/response_wrapper.hpp"
 
+#include <boost/asio/awaitable.hpp>
+
 namespace zoo {
 namespace spider {
 
@@ -27,6 +29,12 @@ public:
 	irequest_handler& operator=(irequest_handler&&)      = default;
 
 	virtual response_wrapper handle_request(request&& req) = 0;
+
+	/// Handle @a req asynchronously. The HTTP session awaits this, so a handler can wait for I/O, e.g. a database query,
+	/// without blocking the thread that serves the other sessions. The request is taken by value because a reference
+	/// would dangle once the coroutine is suspended.
+	/// The default implementation returns the response of handle_request.
+	virtual net::awaitable<response_wrapper> async_handle_request(request req);
 };
 
 } // namespace spider
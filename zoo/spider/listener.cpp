@@ -14,6 +14,10 @@
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/beast/core.hpp>
 
+#ifndef _WIN32
+#include <sys/socket.h>
+#endif
+
 namespace zoo {
 namespace spider {
 
@@ -24,23 +28,34 @@ void fail(beast::error_code ec, char const* what)
 	ZOO_LOG(err, "{}: {} ({})", what, ec.message(), ec);
 }
 
+#ifdef SO_REUSEPORT
+using reuse_port = net::detail::socket_option::boolean<SOL_SOCKET, SO_REUSEPORT>;
+#endif
+
 } // namespace
 
 // Accepts incoming connections and launches the sessions
 class listener_impl final : public std::enable_shared_from_this<listener_impl>
 {
 	boost::asio::io_context&          ioc_;
+	bool                              single_threaded_; // the io_context is run by one thread, no strands needed
 	tcp::acceptor                     acceptor_;
 	std::shared_ptr<irequest_handler> request_handler_;
 
 public:
-	listener_impl(boost::asio::io_context& ioc, const std::shared_ptr<irequest_handler>& request_handler)
+	listener_impl(boost::asio::io_context& ioc, bool single_threaded, const std::shared_ptr<irequest_handler>& request_handler)
 	    : ioc_{ ioc }
-	    , acceptor_{ boost::asio::make_strand(ioc) }
+	    , single_threaded_{ single_threaded }
+	    , acceptor_{ single_threaded ? net::any_io_executor{ ioc.get_executor() } : net::any_io_executor{ net::make_strand(ioc) } }
 	    , request_handler_{ request_handler }
 	{
 	}
 
+	const tcp::acceptor& acceptor() const
+	{
+		return this->acceptor_;
+	}
+
 	// Start accepting incoming connections
 	void run(const tcp::endpoint& endpoint, beast::error_code& ec)
 	{
@@ -58,6 +73,20 @@ public:
 			return fail(ec, "set_option");
 		}
 
+		// Let the listeners of the other threads bind the same address
+		if (this->single_threaded_)
+		{
+#ifdef SO_REUSEPORT
+			this->acceptor_.set_option(reuse_port(true), ec);
+#else
+			ec = net::error::operation_not_supported;
+#endif
+			if (ec)
+			{
+				return fail(ec, "set_option SO_REUSEPORT");
+			}
+		}
+
 		// Bind to the server address
 		this->acceptor_.bind(endpoint, ec);
 		if (ec)
@@ -83,9 +112,10 @@ public:
 private:
 	void do_accept()
 	{
-		// The new connection gets its own strand
-		this->acceptor_.async_accept(net::make_strand(ioc_),
-		                             beast::bind_front_handler(&listener_impl::on_accept, this->shared_from_this()));
+		// The new connection gets its own strand, unless the io_context has only one thread
+		this->acceptor_.async_accept(
+		    this->single_threaded_ ? net::any_io_executor{ this->ioc_.get_executor() } : net::any_io_executor{ net::make_strand(this->ioc_) },
+		    beast::bind_front_handler(&listener_impl::on_accept, this->shared_from_this()));
 	}
 
 	void on_accept(beast::error_code ec, tcp::socket socket)
@@ -118,7 +148,27 @@ void listener::run(net::io_context&                         ioc,
 		return fail(ec, "make_address");
 	}
 
-	return std::make_shared<listener_impl>(ioc, request_handler)->run(tcp::endpoint{ addr, port }, ec);
+	return std::make_shared<listener_impl>(ioc, false, request_handler)->run(tcp::endpoint{ addr, port }, ec);
+}
+
+tcp::endpoint listener::run_reuse_port(net::io_context&                         ioc,
+                                       const tcp::endpoint&                     endpoint,
+                                       const std::shared_ptr<irequest_handler>& request_handler,
+                                       beast::error_code&                       ec)
+{
+	const auto impl = std::make_shared<listener_impl>(ioc, true, request_handler);
+	impl->run(endpoint, ec);
+	if (ec)
+	{
+		return endpoint;
+	}
+
+	const auto bound = impl->acceptor().local_endpoint(ec);
+	if (ec)
+	{
+		fail(ec, "local_endpoint");
+	}
+	return bound;
 }
 
 } // namespace spider
@@ -11,6 +11,8 @@
 #include "zoo/spider/irequest_handler.h"
 #include "zoo/spider/aliases.h"
 
+#include <boost/asio/ip/tcp.hpp>
+
 #include <string_view>
 #include <cstdint>
 #include <memory>
@@ -28,6 +30,15 @@ public:
 	                std::uint16_t                            port,
 	                const std::shared_ptr<irequest_handler>& request_handler,
 	                beast::error_code&                       ec);
+
+	// Start accepting incoming connections on an io_context that is run by a single thread.
+	// The acceptor is opened with SO_REUSEPORT, so that the listeners of other threads can bind the same endpoint and the
+	// kernel balances the connections over them. The sessions do not need a strand, they stay on the thread of ioc.
+	// Returns the endpoint the acceptor is bound to, which has the port chosen by the system if the port of endpoint is 0.
+	static tcp::endpoint run_reuse_port(net::io_context&                         ioc,
+	                                    const tcp::endpoint&                     endpoint,
+	                                    const std::shared_ptr<irequest_handler>& request_handler,
+	                                    beast::error_code&                       ec);
 };
 
 } // namespace spider
@@ -16,6 +16,7 @@
 #include <fmt/ostream.h>
 
 #include <iostream>
+#include <variant>
 
 namespace zoo {
 namespace spider {
@@ -24,22 +25,25 @@ class request_router::impl final
 {
 	struct route final
 	{
-		std::set<verb>                  methods;
-		boost::regex                    pattern;
-		request_router::request_handler handler;
+		using target_type = std::variant<request_router::request_handler,
+		                                 request_router::async_request_handler,
+		                                 std::shared_ptr<request_router>>; // a router routes the remainder of the path
 
-		route(std::set<verb>&& methods, boost::regex&& pattern, request_router::request_handler&& handler)
+		std::set<verb> methods;
+		boost::regex   pattern;
+		target_type    target;
+
+		route(std::set<verb>&& methods, boost::regex&& pattern, target_type&& target)
 		    : methods{ std::move(methods) }
 		    , pattern{ std::move(pattern) }
-		    , handler{ std::move(handler) }
+		    , target{ std::move(target) }
 		{
 		}
 	};
 
 	std::vector<route> routes_;
 
-public:
-	response_wrapper route_request(request&& req, url_view&& url, string_view path)
+	const route* find_route(verb method, string_view& path, svmatch& match) const
 	{
 		const auto pos = path.find_first_not_of('/');
 		if (pos != string_view::npos && pos > 0u)
@@ -49,17 +53,72 @@ public:
 
 		for (const auto& route : this->routes_)
 		{
-			if (route.methods.empty() || route.methods.count(req.method()) > 0u)
+			if (route.methods.empty() || route.methods.count(method) > 0u)
 			{
-				auto match = svmatch{};
 				if (boost::regex_search(path.begin(), path.end(), match, route.pattern))
 				{
-					return route.handler(std::move(req), std::move(url), path, match);
+					return &route;
 				}
 			}
 		}
 
-		return not_found::create(req);
+		return nullptr;
+	}
+
+	static string_view remainder(string_view path, const svmatch& match)
+	{
+		assert(!match.empty());
+		return path.substr(match[0].second - path.begin());
+	}
+
+public:
+	response_wrapper route_request(request&& req, url_view&& url, string_view path)
+	{
+		auto       match = svmatch{};
+		const auto route = this->find_route(req.method(), path, match);
+		if (route == nullptr)
+		{
+			return not_found::create(req);
+		}
+
+		if (const auto handler = std::get_if<request_handler>(&route->target))
+		{
+			return (*handler)(std::move(req), std::move(url), path, match);
+		}
+		else if (const auto router = std::get_if<std::shared_ptr<request_router>>(&route->target))
+		{
+			// Let the router route the remainder of the path
+			return (*router)->route_request(std::move(req), std::move(url), remainder(path, match));
+		}
+		else
+		{
+			ZOO_LOG(err, "The route for '{}' has an asynchronous handler, it cannot handle the request synchronously", path);
+			return internal_server_error::create(req);
+		}
+	}
+
+	net::awaitable<response_wrapper> async_route_request(request req, url_view url, string_view path)
+	{
+		auto       match = svmatch{};
+		const auto route = this->find_route(req.method(), path, match);
+		if (route == nullptr)
+		{
+			co_return not_found::create(req);
+		}
+
+		if (const auto handler = std::get_if<async_request_handler>(&route->target))
+		{
+			co_return co_await (*handler)(std::move(req), std::move(url), path, std::move(match));
+		}
+		else if (const auto router = std::get_if<std::shared_ptr<request_router>>(&route->target))
+		{
+			// Let the router route the remainder of the path
+			co_return co_await (*router)->async_route_request(std::move(req), std::move(url), remainder(path, match));
+		}
+		else
+		{
+			co_return std::get<request_handler>(route->target)(std::move(req), std::move(url), path, match);
+		}
 	}
 
 	response_wrapper route_request(request&& req)
@@ -79,20 +138,27 @@ public:
 		}
 	}
 
-	void add_route(std::set<verb>&& methods, boost::regex&& pattern, request_handler&& handler)
+	net::awaitable<response_wrapper> async_route_request(request req)
 	{
-		this->routes_.emplace_back(std::move(methods), std::move(pattern), std::move(handler));
+		ZOO_LOG(trace, "request:\n{}", fmt::streamed(req));
+
+		auto url = boost::urls::parse_origin_form(req.target());
+		if (url.has_error())
+		{
+			ZOO_LOG(err, "Failed to parse the target '{}': {}", req.target(), url.error().message());
+			co_return bad_request::create(req);
+		}
+		else
+		{
+			// Note: the path is a local of this coroutine, so it outlives the awaited handler that refers to it
+			const auto path = url.value().path();
+			co_return co_await this->async_route_request(std::move(req), std::move(url.value()), path);
+		}
 	}
 
-	void add_route(std::set<verb>&& methods, boost::regex&& pattern, const std::shared_ptr<request_router>& router)
+	void add_route(std::set<verb>&& methods, boost::regex&& pattern, route::target_type&& target)
 	{
-		this->routes_.emplace_back(
-		    std::move(methods), std::move(pattern), [r = router](request&& req, url_view&& url, string_view path, const svmatch& match) {
-			    assert(!match.empty());
-			    // Let the router route the remainder of the path
-			    const auto remainder = path.substr(match[0].second - path.begin());
-			    return r->route_request(std::move(req), std::move(url), remainder);
-		    });
+		this->routes_.emplace_back(std::move(methods), std::move(pattern), std::move(target));
 	}
 };
 
@@ -112,11 +178,21 @@ response_wrapper request_router::route_request(request&& req, url_view&& url, st
 	return this->pimpl_->route_request(std::move(req), std::move(url), path);
 }
 
+net::awaitable<response_wrapper> request_router::async_route_request(request req, url_view url, string_view path)
+{
+	co_return co_await this->pimpl_->async_route_request(std::move(req), std::move(url), path);
+}
+
 response_wrapper request_router::handle_request(request&& req)
 {
 	return this->pimpl_->route_request(std::move(req));
 }
 
+net::awaitable<response_wrapper> request_router::async_handle_request(request req)
+{
+	co_return co_await this->pimpl_->async_route_request(std::move(req));
+}
+
 void request_router::add_route(std::set<verb>&& methods, boost::regex&& pattern, request_handler&& handler)
 {
 	return this->pimpl_->add_route(std::move(methods), std::move(pattern), std::move(handler));
@@ -147,5 +223,20 @@ void request_router::add_route(boost::regex&& pattern, const std::shared_ptr<req
 	return this->pimpl_->add_route({}, std::move(pattern), router);
 }
 
+void request_router::add_async_route(std::set<verb>&& methods, boost::regex&& pattern, async_request_handler&& handler)
+{
+	return this->pimpl_->add_route(std::move(methods), std::move(pattern), std::move(handler));
+}
+
+void request_router::add_async_route(verb method, boost::regex&& pattern, async_request_handler&& handler)
+{
+	return this->pimpl_->add_route({ method }, std::move(pattern), std::move(handler));
+}
+
+void request_router::add_async_route(boost::regex&& pattern, async_request_handler&& handler)
+{
+	return this->pimpl_->add_route({}, std::move(pattern), std::move(handler));
+}
+
 } // namespace spider
 } // namespace zoo
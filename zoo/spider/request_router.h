@@ -30,16 +30,21 @@ class ZOO_SPIDER_API request_router final : public irequest_handler
 {
 	class impl;
 	std::unique_ptr<impl> pimpl_;
-	friend impl; // allow impl to call private method route_request
+	friend impl; // allow impl to call private methods route_request and async_route_request
 
 	using svmatch         = boost::match_results<string_view::const_iterator>;
 	using request_handler = std::function<response_wrapper(request&& req, url_view&& url, string_view path, const svmatch& match)>;
+	// Note: the arguments are passed by value, a coroutine must not refer to the arguments of its caller
+	using async_request_handler =
+	    std::function<net::awaitable<response_wrapper>(request req, url_view url, string_view path, svmatch match)>;
 	template<ConvertibleFromBoostJson T>
 	using json_request_handler = std::function<
 	    response_wrapper(request&& req, url_view&& url, string_view path, const svmatch& match, boost::system::result<T>&& data)>;
 
-	response_wrapper handle_request(request&& req) override;
-	response_wrapper route_request(request&& req, url_view&& url, string_view path);
+	response_wrapper                 handle_request(request&& req) override;
+	net::awaitable<response_wrapper> async_handle_request(request req) override;
+	response_wrapper                 route_request(request&& req, url_view&& url, string_view path);
+	net::awaitable<response_wrapper> async_route_request(request req, url_view url, string_view path);
 
 public:
 	request_router();
@@ -60,6 +65,13 @@ public:
 	void add_route(boost::regex&& pattern, request_handler&& handler);
 	void add_route(boost::regex&& pattern, const std::shared_ptr<request_router>& router);
 
+	/// Add a route of which the handler is a coroutine.
+	/// The route is only served when the request is handled asynchronously, which is how the HTTP session does it.
+	/// When handle_request is called instead, it responds with an internal server error.
+	void add_async_route(std::set<verb>&& methods, boost::regex&& pattern, async_request_handler&& handler);
+	void add_async_route(verb method, boost::regex&& pattern, async_request_handler&& handler);
+	void add_async_route(boost::regex&& pattern, async_request_handler&& handler);
+
 	template<ConvertibleFromBoostJson T>
 	void add_json_route(std::set<verb>&& methods, boost::regex&& pattern, json_request_handler<T>&& handler)
 	{
@@ -82,49 +82,99 @@ protected:
 
 		using ResultType = typename handler<Callback>::ResultType;
 
+		static_assert(!is_awaitable_v<ResultType> || handler<Callback>::args_by_value,
+		              "The arguments of a coroutine callback must be passed by value, references would dangle");
+
 		// Note: the closure passed to add_route must be copyable.
 		// This is why the handler is created as a shared_ptr, rather than a unique_ptr.
 		// I would have preferred to use a unique_ptr, but then the handler would need to be
 		// move-captured, thus making the lambda non-copyable and std::function would fail to create.
-		auto   h       = std::make_shared<handler<Callback>>(this, callback, descriptors...);
-		auto&& handler = [sec = op.sec, method = op.method, handler = h, this](
-		                     request&& req, url_view&& url, path_spec::param_map&& param) -> response_wrapper {
-			try
-			{
-				auth_map auth{};
-				if (auto verified = verify_security(sec.value_or(global_security_), req, url); verified)
+		auto h = std::make_shared<handler<Callback>>(this, callback, descriptors...);
+
+		if constexpr (is_awaitable_v<ResultType>)
+		{
+			// The callback is a coroutine, e.g. one that awaits a database query. The closure is a coroutine too, it
+			// lives in the router, so its captures outlive the coroutine.
+			auto&& handler = [sec = op.sec, method = op.method, handler = h, this](
+			                     request req, url_view url, path_params param) -> net::awaitable<response_wrapper> {
+				try
 				{
-					auth = std::move(verified.value());
+					auth_map auth{};
+					if (auto verified = verify_security(sec.value_or(global_security_), req, url); verified)
+					{
+						auth = std::move(verified.value());
+					}
+					else
+					{
+						co_return std::move(verified.error());
+					}
+					if constexpr (std::is_void_v<awaited_t<ResultType>>)
+					{
+						co_await handler->call(parameter_sources{ req, url, param, auth });
+						auto res = empty_response::create(status::no_content);
+						res.version(req.version());
+						res.keep_alive(req.keep_alive());
+						co_return res;
+					}
+					else
+					{
+						auto res = make_response(co_await handler->call(parameter_sources{ req, url, param, auth }),
+						                         status_utility::success_status_for_method(method));
+						res.version(req.version());
+						res.keep_alive(req.keep_alive());
+						co_return res;
+					}
 				}
-				else
+				catch (const std::exception& e)
 				{
-					return std::move(verified.error());
+					ZOO_LOG(err, "{}", boost::diagnostic_information(e));
+					co_return make_error_response(e, req);
 				}
-				if constexpr (std::is_void_v<ResultType>)
+			};
+
+			router_->add_async_route(op, handler);
+		}
+		else
+		{
+			auto&& handler = [sec = op.sec, method = op.method, handler = h, this](
+			                     request&& req, url_view&& url, path_params&& param) -> response_wrapper {
+				try
 				{
-					handler->call(parameter_sources{ req, url, param, auth });
-					auto res = empty_response::create(status::no_content);
-					res.version(req.version());
-					res.keep_alive(req.keep_alive());
-					return res;
+					auth_map auth{};
+					if (auto verified = verify_security(sec.value_or(global_security_), req, url); verified)
+					{
+						auth = std::move(verified.value());
+					}
+					else
+					{
+						return std::move(verified.error());
+					}
+					if constexpr (std::is_void_v<ResultType>)
+					{
+						handler->call(parameter_sources{ req, url, param, auth });
+						auto res = empty_response::create(status::no_content);
+						res.version(req.version());
+						res.keep_alive(req.keep_alive());
+						return res;
+					}
+					else
+					{
+						auto res = make_response(handler->call(parameter_sources{ req, url, param, auth }),
+						                         status_utility::success_status_for_method(method));
+						res.version(req.version());
+						res.keep_alive(req.keep_alive());
+						return res;
+					}
 				}
-				else
+				catch (const std::exception& e)
 				{
-					auto res = make_response(handler->call(parameter_sources{ req, url, param, auth }),
-					                         status_utility::success_status_for_method(method));
-					res.version(req.version());
-					res.keep_alive(req.keep_alive());
-					return res;
+					ZOO_LOG(err, "{}", boost::diagnostic_information(e));
+					return make_error_response(e, req);
 				}
-			}
-			catch (const std::exception& e)
-			{
-				ZOO_LOG(err, "{}", boost::diagnostic_information(e));
-				return make_error_response(e, req);
-			}
-		};
+			};
 
-		router_->add_route(op, handler);
+			router_->add_route(op, handler);
+		}
 	}
 
 	void set_global_security(security sec)
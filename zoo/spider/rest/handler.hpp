@@ -49,6 +49,9 @@ public:
 
 	static constexpr size_t N = sizeof...(Args);
 
+	// Whether the callback takes all its arguments by value
+	static constexpr bool args_by_value = (!std::is_reference_v<Args> && ...);
+
 	template<typename Owner, typename... Descriptors>
 	handler(Owner* owner, Method method, Descriptors... descriptors)
 	    : callback_{}
@@ -13,6 +13,7 @@
 #include "zoo/spider/rest/status_utility.hpp"
 #include "zoo/spider/rest/annotation.hpp"
 #include "zoo/spider/rest/security.h"
+#include "zoo/spider/type_traits.h"
 #include "zoo/common/misc/is_optional.hpp"
 #include "zoo/common/misc/is_shared_ptr.hpp"
 #include "zoo/common/misc/is_vector.hpp"
@@ -206,7 +207,8 @@ public:
 		{
 			object responses;
 
-			add_response<ResultType>(responses, status_utility::success_status_for_method(op.method));
+			// The response of a coroutine callback is the result that it returns
+			add_response<awaited_t<ResultType>>(responses, status_utility::success_status_for_method(op.method));
 
 			if ((op.sec && !is_empty_security(op.sec.value())) || (!op.sec && have_global_security_))
 			{
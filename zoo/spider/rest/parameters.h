@@ -8,6 +8,7 @@
 #pragma once
 
 #include "zoo/spider/rest/pathspec.h"
+#include "zoo/spider/rest/pathparams.h"
 #include "zoo/spider/rest/auth.h"
 #include "zoo/spider/messages/message.h"
 
@@ -121,10 +122,10 @@ struct parameters final
 
 struct parameter_sources final
 {
-	const request&              req;
-	const url_view&             url;
-	const path_spec::param_map& param;
-	const auth_map&             auth;
+	const request&     req;
+	const url_view&    url;
+	const path_params& param;
+	const auth_map&    auth;
 };
 
 } // namespace spider
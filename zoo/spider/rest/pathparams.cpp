@@ -0,0 +1,78 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/spider/rest/pathparams.h"
+#include "zoo/common/misc/throw_exception.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace zoo {
+namespace spider {
+
+path_params::path_params()
+    : params_{}
+    , size_{}
+{
+}
+
+void path_params::emplace(string_view name, string_view value)
+{
+	const auto it = std::find_if(this->params_.begin(), this->params_.begin() + this->size_, [name](const value_type& param) {
+		return param.first == name;
+	});
+	if (it != this->params_.begin() + this->size_)
+	{
+		it->second = value;
+	}
+	else if (this->size_ == capacity)
+	{
+		ZOO_THROW_EXCEPTION(std::length_error{ "too many path parameters" });
+	}
+	else
+	{
+		this->params_[this->size_++] = value_type{ name, value };
+	}
+}
+
+path_params::const_iterator path_params::find(string_view name) const
+{
+	return std::find_if(this->begin(), this->end(), [name](const value_type& param) { return param.first == name; });
+}
+
+const string_view& path_params::at(string_view name) const
+{
+	const auto it = this->find(name);
+	if (it == this->end())
+	{
+		ZOO_THROW_EXCEPTION(std::out_of_range{ "path parameter not found" });
+	}
+	return it->second;
+}
+
+path_params::const_iterator path_params::begin() const
+{
+	return this->params_.data();
+}
+
+path_params::const_iterator path_params::end() const
+{
+	return this->params_.data() + this->size_;
+}
+
+std::size_t path_params::size() const
+{
+	return this->size_;
+}
+
+bool path_params::empty() const
+{
+	return this->size_ == 0u;
+}
+
+} // namespace spider
+} // namespace zoo
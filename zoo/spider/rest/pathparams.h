@@ -0,0 +1,55 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/spider/config.h"
+#include "zoo/spider/aliases.h"
+
+#include <array>
+#include <cstddef>
+#include <utility>
+
+namespace zoo {
+namespace spider {
+
+/// The parameters captured from a path, as name/value pairs in the order of the path spec.
+/// The pairs are kept in a fixed array, so that matching a path does not allocate.
+class ZOO_SPIDER_API path_params final
+{
+public:
+	/// Maximum number of parameters of a path spec
+	static constexpr std::size_t capacity = 16u;
+
+	using value_type     = std::pair<string_view, string_view>;
+	using const_iterator = const value_type*;
+
+	path_params();
+
+	/// Set parameter @a name to @a value, replacing the value if @a name is already present.
+	/// Throws std::length_error if that would exceed the capacity.
+	void emplace(string_view name, string_view value);
+
+	/// The parameter @a name, or end() if there is no such parameter
+	const_iterator find(string_view name) const;
+
+	/// The value of parameter @a name, throws std::out_of_range if there is no such parameter
+	const string_view& at(string_view name) const;
+
+	const_iterator begin() const;
+	const_iterator end() const;
+
+	std::size_t size() const;
+	bool        empty() const;
+
+private:
+	std::array<value_type, capacity> params_;
+	std::size_t                      size_;
+};
+
+} // namespace spider
+} // namespace zoo
@@ -16,6 +16,7 @@
 #include "zoo/spider/rest/operation.h"
 #include "zoo/spider/rest/path.h"
 #include "zoo/spider/rest/pathspec.h"
+#include "zoo/spider/rest/routetree.h"
 #include "zoo/common/misc/formatters.hpp"
 #include "zoo/common/misc/throw_exception.h"
 
@@ -26,6 +27,7 @@
 #include <fmt/format.h>
 
 #include <functional>
+#include <variant>
 
 namespace zoo {
 namespace spider {
@@ -33,12 +35,14 @@ namespace spider {
 template<IsValidErrorType DefaultErrorType>
 class rest_router final : public irequest_handler
 {
-	using request_handler = std::function<response_wrapper(request&& req, url_view&& url, path_spec::param_map&& param)>;
+	using request_handler = std::function<response_wrapper(request&& req, url_view&& url, path_params&& param)>;
+	// Note: the arguments are passed by value, a coroutine must not refer to the arguments of its caller
+	using async_request_handler = std::function<net::awaitable<response_wrapper>(request req, url_view url, path_params param)>;
 
 	struct route final
 	{
-		rest_operation  op;
-		request_handler handler;
+		rest_operation                                       op;
+		std::variant<request_handler, async_request_handler> handler;
 	};
 
 public:
@@ -53,6 +57,16 @@ public:
 
 	void add_route(rest_operation op, request_handler handler)
 	{
+		tree_.add(op.method, op.path);
+		routes_.emplace_back(std::move(op), std::move(handler));
+	}
+
+	/// Add a route of which the handler is a coroutine.
+	/// The route is only served when the request is handled asynchronously, which is how the HTTP session does it.
+	/// When handle_request is called instead, it responds with an internal server error.
+	void add_async_route(rest_operation op, async_request_handler handler)
+	{
+		tree_.add(op.method, op.path);
 		routes_.emplace_back(std::move(op), std::move(handler));
 	}
 
@@ -62,37 +76,78 @@ private:
 		auto url = boost::urls::parse_origin_form(req.target());
 		if (url.has_error())
 		{
-			return json_response::create(
-			    req,
-			    status::bad_request,
-			    DefaultErrorType::create(static_cast<int>(status::bad_request),
-			                             fmt::format("Failed to parse the target '{}': {}", req.target(), url.error().message())));
+			return bad_target_response(req, url.error());
 		}
 
 		return route_request(std::move(req), std::move(url.value()), path{ url.value().path() });
 	}
 
+	net::awaitable<response_wrapper> async_handle_request(request req) override
+	{
+		auto url = boost::urls::parse_origin_form(req.target());
+		if (url.has_error())
+		{
+			co_return bad_target_response(req, url.error());
+		}
+
+		// Note: the path parameters refer to target, a local of this coroutine, so they outlive the awaited handler
+		const auto target = url.value().path();
+		const auto p      = path{ target };
+
+		auto match = tree_.match(req.method(), p);
+		if (!match.route)
+		{
+			co_return unrouted_response(req, p, match.path_found);
+		}
+
+		const auto& handler = routes_[match.route.value()].handler;
+		if (const auto async_handler = std::get_if<async_request_handler>(&handler))
+		{
+			co_return co_await (*async_handler)(std::move(req), std::move(url.value()), std::move(match.params));
+		}
+		else
+		{
+			co_return std::get<request_handler>(handler)(std::move(req), std::move(url.value()), std::move(match.params));
+		}
+	}
+
 	response_wrapper route_request(request&& req, url_view&& url, path&& p)
 	{
-		auto found = false;
+		auto match = tree_.match(req.method(), p);
+		if (!match.route)
+		{
+			return unrouted_response(req, p, match.path_found);
+		}
 
-		for (const auto& route : routes_)
+		const auto& handler = routes_[match.route.value()].handler;
+		if (const auto sync_handler = std::get_if<request_handler>(&handler))
 		{
-			if (route.op.method == req.method())
-			{
-				auto param_map = route.op.path.match(p);
-				if (param_map.has_value())
-				{
-					return route.handler(std::move(req), std::move(url), std::move(param_map.value()));
-				}
-			}
-			else if (route.op.path.match(p).has_value())
-			{
-				found = true;
-			}
+			return (*sync_handler)(std::move(req), std::move(url), std::move(match.params));
 		}
+		else
+		{
+			return json_response::create(
+			    req,
+			    status::internal_server_error,
+			    DefaultErrorType::create(static_cast<int>(status::internal_server_error),
+			                             fmt::format("The handler of target '{}' is asynchronous, it cannot handle the request synchronously",
+			                                         p.to_string())));
+		}
+	}
 
-		if (found)
+	static response_wrapper bad_target_response(const request& req, const error_code& ec)
+	{
+		return json_response::create(
+		    req,
+		    status::bad_request,
+		    DefaultErrorType::create(static_cast<int>(status::bad_request),
+		                             fmt::format("Failed to parse the target '{}': {}", req.target(), ec.message())));
+	}
+
+	// The response when no route matches both the method and the path
+	static response_wrapper unrouted_response(const request& req, const path& p, bool path_found)
+	{
+		if (path_found)
 		{
 			return json_response::create(
 			    req,
@@ -110,6 +165,7 @@ private:
 	}
 
 	std::vector<route> routes_{};
+	route_tree         tree_{};
 };
 
 } // namespace spider
@@ -0,0 +1,180 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/spider/rest/routetree.h"
+#include "zoo/spider/rest/path.h"
+#include "zoo/spider/rest/pathspec.h"
+#include "zoo/common/misc/throw_exception.h"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+namespace zoo {
+namespace spider {
+
+namespace {
+
+bool segment_less(const std::pair<string_view, std::size_t>& child, string_view segment)
+{
+	return child.first < segment;
+}
+
+} // namespace
+
+struct route_tree::search final
+{
+	verb                                           method;
+	const std::vector<string_view>&                segments;
+	std::array<string_view, path_params::capacity> values; // parameter values along the current branch
+	std::optional<std::size_t>                     route;
+	std::array<string_view, path_params::capacity> route_values;
+	bool                                           path_found;
+};
+
+route_tree::route_tree()
+    : nodes_{ node{} }
+    , names_{}
+{
+}
+
+route_tree::route_tree(route_tree&&) noexcept            = default;
+route_tree& route_tree::operator=(route_tree&&) noexcept = default;
+
+route_tree::route_tree(const route_tree&)            = default;
+route_tree& route_tree::operator=(const route_tree&) = default;
+
+std::size_t route_tree::add(verb method, const path_spec& spec)
+{
+	auto names   = std::vector<string_view>{};
+	auto index   = std::size_t{};
+	auto visited = std::vector<std::size_t>{ index };
+	for (const auto& segment : spec.segments())
+	{
+		if (segment.is_parameter)
+		{
+			if (names.size() == path_params::capacity)
+			{
+				ZOO_THROW_EXCEPTION(std::length_error{ "too many path parameters in " + spec.to_string() });
+			}
+			names.push_back(segment.s);
+
+			if (!this->nodes_[index].parameter)
+			{
+				this->nodes_[index].parameter = this->nodes_.size();
+				this->nodes_.emplace_back();
+			}
+			index = this->nodes_[index].parameter.value();
+		}
+		else
+		{
+			auto&      children = this->nodes_[index].children;
+			const auto it       = std::lower_bound(children.begin(), children.end(), segment.s, segment_less);
+			if (it != children.end() && it->first == segment.s)
+			{
+				index = it->second;
+			}
+			else
+			{
+				const auto child = this->nodes_.size();
+				children.emplace(it, segment.s, child);
+				this->nodes_.emplace_back(); // invalidates children
+				index = child;
+			}
+		}
+		visited.push_back(index);
+	}
+
+	const auto route   = this->names_.size();
+	auto&      methods = this->nodes_[index].methods;
+	if (std::none_of(methods.begin(), methods.end(), [method](const auto& m) { return m.first == method; }))
+	{
+		// A duplicate route can never be chosen, the one that was added first wins
+		methods.emplace_back(method, route);
+
+		// Routes are numbered in increasing order, so the first one to reach a node is the lowest below it
+		for (const auto i : visited)
+		{
+			if (!this->nodes_[i].first)
+			{
+				this->nodes_[i].first = route;
+			}
+		}
+	}
+	this->names_.push_back(std::move(names));
+	return route;
+}
+
+route_tree::match_result route_tree::match(verb method, const path& p) const
+{
+	auto s = search{
+		.method = method, .segments = p.segments(), .values = {}, .route = std::nullopt, .route_values = {}, .path_found = false
+	};
+	this->match(0u, 0u, 0u, s);
+
+	auto result = match_result{ .route = s.route, .params = path_params{}, .path_found = s.path_found };
+	if (s.route)
+	{
+		const auto& names = this->names_[s.route.value()];
+		for (auto i = std::size_t{}; i < names.size(); ++i)
+		{
+			result.params.emplace(names[i], s.route_values[i]);
+		}
+	}
+	return result;
+}
+
+void route_tree::match(std::size_t index, std::size_t depth, std::size_t count, search& s) const
+{
+	const auto& n = this->nodes_[index];
+
+	// A branch without a lower route than the one found cannot change the result. Nor can it change path_found,
+	// which is already set when a route was found.
+	if (s.route && (!n.first || n.first.value() >= s.route.value()))
+	{
+		return;
+	}
+
+	if (depth == s.segments.size())
+	{
+		if (!n.methods.empty())
+		{
+			s.path_found = true;
+		}
+		for (const auto& [method, route] : n.methods)
+		{
+			if (method == s.method && (!s.route || route < s.route.value()))
+			{
+				s.route        = route;
+				s.route_values = s.values;
+			}
+		}
+		return;
+	}
+
+	const auto segment = s.segments[depth];
+
+	const auto it = std::lower_bound(n.children.begin(), n.children.end(), segment, segment_less);
+	if (it != n.children.end() && it->first == segment)
+	{
+		this->match(it->second, depth + 1u, count, s);
+	}
+
+	if (n.parameter)
+	{
+		s.values[count] = segment;
+		this->match(n.parameter.value(), depth + 1u, count + 1u, s);
+	}
+}
+
+std::size_t route_tree::size() const
+{
+	return this->names_.size();
+}
+
+} // namespace spider
+} // namespace zoo
@@ -0,0 +1,77 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/spider/config.h"
+#include "zoo/spider/rest/pathfwd.h"
+#include "zoo/spider/rest/pathparams.h"
+#include "zoo/spider/rest/pathspecfwd.h"
+#include "zoo/spider/aliases.h"
+
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace zoo {
+namespace spider {
+
+/// Routes a method and a path to a route in a single pass over the path.
+/// The path specs of the routes are compiled into a tree with a node per segment. Every node has its static segments
+/// as sorted children, at most one parameter child, and a method table of the routes of which the path ends there.
+/// The segments of the path specs are not copied, they must outlive the tree.
+class ZOO_SPIDER_API route_tree final
+{
+public:
+	struct match_result final
+	{
+		std::optional<std::size_t> route;      //!< The first added route that matches both the method and the path
+		path_params                params;     //!< The parameters of the path, named according to the path spec of route
+		bool                       path_found; //!< Whether any route matches the path, regardless of its method
+	};
+
+	route_tree();
+
+	route_tree(route_tree&&) noexcept;
+	route_tree& operator=(route_tree&&) noexcept;
+
+	route_tree(const route_tree&);
+	route_tree& operator=(const route_tree&);
+
+	/// Add a route for @a method and @a spec. Routes are numbered in the order in which they are added, starting at 0.
+	/// Returns the number of the route.
+	/// Throws std::length_error if the path spec has more parameters than path_params can hold.
+	std::size_t add(verb method, const path_spec& spec);
+
+	/// Find the route for @a method and @a p.
+	/// When several routes match, e.g. a path spec with a parameter and one with a static segment in the same place,
+	/// the route that was added first wins, like a linear scan over the routes would choose.
+	match_result match(verb method, const path& p) const;
+
+	/// Number of routes added
+	std::size_t size() const;
+
+private:
+	struct node final
+	{
+		std::vector<std::pair<string_view, std::size_t>> children;  //!< Static segments, sorted, with their node
+		std::optional<std::size_t>                       parameter; //!< The node of a parameter segment
+		std::vector<std::pair<verb, std::size_t>>        methods;   //!< The route per method of the paths that end here
+		std::optional<std::size_t>                       first;     //!< The lowest route in this node or below it
+	};
+
+	struct search;
+
+	void match(std::size_t index, std::size_t depth, std::size_t count, search& s) const;
+
+	std::vector<node>                     nodes_; // the root is at index 0
+	std::vector<std::vector<string_view>> names_; // parameter names per route
+};
+
+} // namespace spider
+} // namespace zoo
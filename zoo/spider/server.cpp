@@ -0,0 +1,232 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/spider/server.h"
+#include "zoo/spider/listener.h"
+#include "zoo/common/misc/formatters.hpp"
+#include "zoo/common/logging/logging.h"
+#include "zoo/common/misc/throw_exception.h"
+
+#include <boost/asio/io_context.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace zoo {
+namespace spider {
+
+namespace {
+
+// The CPUs that the process may run on, in ascending order
+std::vector<std::size_t> allowed_cpus()
+{
+	auto cpus = std::vector<std::size_t>{};
+#ifdef __linux__
+	auto set = cpu_set_t{};
+	CPU_ZERO(&set);
+	if (sched_getaffinity(0, sizeof(set), &set) == 0)
+	{
+		for (auto cpu = std::size_t{}; cpu < CPU_SETSIZE; ++cpu)
+		{
+			if (CPU_ISSET(cpu, &set))
+			{
+				cpus.push_back(cpu);
+			}
+		}
+	}
+	else
+	{
+		ZOO_LOG(warn, "Failed to get the CPU affinity of the process: error {}", errno);
+	}
+#endif
+	return cpus;
+}
+
+// Pin the calling thread to @a cpu
+void pin_to_cpu(std::size_t cpu)
+{
+#ifdef __linux__
+	auto set = cpu_set_t{};
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+	if (const auto rc = pthread_setaffinity_np(pthread_self(), sizeof(set), &set); rc != 0)
+	{
+		ZOO_LOG(warn, "Failed to pin thread to CPU {}: error {}", cpu, rc);
+	}
+#else
+	ZOO_LOG(warn, "Pinning threads to CPU {} is not supported on this platform", cpu);
+#endif
+}
+
+} // namespace
+
+class server::impl final
+{
+	struct worker final
+	{
+		// A hint of 1 tells asio that one thread runs the io_context, which saves it some work, e.g. it does not wake other
+		// threads. It still locks; only BOOST_ASIO_CONCURRENCY_HINT_UNSAFE would remove the locking, which is not safe
+		// here because stop() is called from other threads.
+		net::io_context ioc{ 1 };
+		std::thread     thread{};
+	};
+
+	std::shared_ptr<irequest_handler>    request_handler_;
+	server_settings                      settings_;
+	std::vector<std::unique_ptr<worker>> workers_; // the io_contexts must not move
+	tcp::endpoint                        endpoint_;
+
+public:
+	impl(const std::shared_ptr<irequest_handler>& request_handler, server_settings settings)
+	    : request_handler_{ request_handler }
+	    , settings_{ settings }
+	    , workers_{}
+	    , endpoint_{}
+	{
+	}
+
+	~impl() noexcept
+	{
+		this->stop();
+		this->join();
+	}
+
+	void start(std::string_view address, std::uint16_t port, beast::error_code& ec)
+	{
+		if (!this->workers_.empty())
+		{
+			ZOO_THROW_EXCEPTION(std::logic_error{ "the server is already started" });
+		}
+
+		const auto addr = net::ip::make_address(address, ec);
+		if (ec)
+		{
+			ZOO_LOG(err, "make_address: {} ({})", ec.message(), ec);
+			return;
+		}
+
+		// The CPUs that the process may run on need not be 0 to n-1, e.g. in a container or under taskset. The threads are
+		// pinned to them round robin.
+		const auto allowed = allowed_cpus();
+		if (this->settings_.pin_threads && allowed.empty())
+		{
+			ZOO_LOG(warn, "The CPU affinity of the process is unknown, the threads are not pinned");
+		}
+		const auto cpus    = allowed.empty() ? std::size_t{ std::max(1u, std::thread::hardware_concurrency()) } : allowed.size();
+		const auto threads = this->settings_.threads == 0u ? cpus : this->settings_.threads;
+
+		auto workers  = std::vector<std::unique_ptr<worker>>{};
+		auto endpoint = tcp::endpoint{ addr, port };
+		for (auto i = std::size_t{}; i < threads; ++i)
+		{
+			auto w = std::make_unique<worker>();
+			// After the first acceptor, the endpoint has the port chosen by the system, so that all acceptors share it
+			endpoint = listener::run_reuse_port(w->ioc, endpoint, this->request_handler_, ec);
+			if (ec)
+			{
+				// errors are already logged by listener
+				return;
+			}
+			workers.push_back(std::move(w));
+		}
+
+		this->workers_  = std::move(workers);
+		this->endpoint_ = endpoint;
+
+		for (auto i = std::size_t{}; i < this->workers_.size(); ++i)
+		{
+			auto& w   = *this->workers_[i];
+			auto  cpu = std::optional<std::size_t>{};
+			if (this->settings_.pin_threads && !allowed.empty())
+			{
+				cpu = allowed[i % allowed.size()];
+			}
+			w.thread = std::thread{ [&ioc = w.ioc, cpu] {
+				if (cpu)
+				{
+					pin_to_cpu(cpu.value());
+				}
+				ioc.run();
+			} };
+		}
+
+		ZOO_LOG(info, "Serving {} on {} threads", this->endpoint_, this->workers_.size());
+	}
+
+	void stop()
+	{
+		for (auto& w : this->workers_)
+		{
+			w->ioc.stop();
+		}
+	}
+
+	void join()
+	{
+		for (auto& w : this->workers_)
+		{
+			if (w->thread.joinable())
+			{
+				w->thread.join();
+			}
+		}
+	}
+
+	tcp::endpoint endpoint() const
+	{
+		return this->endpoint_;
+	}
+
+	std::size_t size() const
+	{
+		return this->workers_.size();
+	}
+};
+
+server::server(const std::shared_ptr<irequest_handler>& request_handler, server_settings settings)
+    : pimpl_{ std::make_unique<impl>(request_handler, settings) }
+{
+}
+
+server::~server() noexcept = default;
+
+void server::start(std::string_view address, std::uint16_t port, beast::error_code& ec)
+{
+	return this->pimpl_->start(address, port, ec);
+}
+
+void server::stop()
+{
+	return this->pimpl_->stop();
+}
+
+void server::join()
+{
+	return this->pimpl_->join();
+}
+
+tcp::endpoint server::endpoint() const
+{
+	return this->pimpl_->endpoint();
+}
+
+std::size_t server::size() const
+{
+	return this->pimpl_->size();
+}
+
+} // namespace spider
+} // namespace zoo
@@ -0,0 +1,72 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/spider/config.h"
+#include "zoo/spider/irequest_handler.h"
+#include "zoo/spider/aliases.h"
+
+#include <boost/asio/ip/tcp.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+
+namespace zoo {
+namespace spider {
+
+struct server_settings
+{
+	std::size_t threads;     //!< Number of threads, 0 means one per CPU that the process may run on
+	bool        pin_threads; //!< Pin every thread to its own CPU of the process affinity mask (Linux only)
+};
+
+/// Serves HTTP on several threads that share nothing.
+/// Every thread runs its own io_context with its own acceptor. The acceptors are bound to the same endpoint with
+/// SO_REUSEPORT, so the kernel balances the incoming connections over the threads. A session stays on the thread that
+/// accepted it, so it needs no strand and its handlers never move to another core.
+/// The request handler is shared by all threads, it must be thread safe.
+class ZOO_SPIDER_API server final
+{
+	class impl;
+	std::unique_ptr<impl> pimpl_;
+
+public:
+	server(const std::shared_ptr<irequest_handler>& request_handler, server_settings settings);
+
+	/// Stops the threads and waits for them
+	~server() noexcept;
+
+	server(const server&)            = delete;
+	server(server&&)                 = delete;
+	server& operator=(const server&) = delete;
+	server& operator=(server&&)      = delete;
+
+	/// Open the acceptors and start the threads.
+	/// When the port is 0, the system chooses a port, which endpoint() returns.
+	/// On failure, @a ec is set, the error is logged and no thread is started.
+	void start(std::string_view address, std::uint16_t port, beast::error_code& ec);
+
+	/// Stop the io_contexts of all threads. Does not wait for the threads, see join().
+	/// This can be called from any thread, but not from a signal handler: io_context::stop is not async-signal-safe.
+	/// To stop on a signal, wait for it with a boost::asio::signal_set and call stop() from its completion handler.
+	void stop();
+
+	/// Wait for all threads to exit
+	void join();
+
+	/// The endpoint that the acceptors are bound to
+	tcp::endpoint endpoint() const;
+
+	/// Number of threads
+	std::size_t size() const;
+};
+
+} // namespace spider
+} // namespace zoo
@@ -0,0 +1,207 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <zoo/spider/rest/routetree.h>
+#include <zoo/spider/rest/pathspec.h>
+#include <zoo/spider/rest/path.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace zoo {
+namespace spider {
+
+namespace {
+
+// The parameters sorted by name, to compare path_params with a path_spec::param_map
+template<typename Params>
+std::vector<std::pair<std::string, std::string>> to_vector(const Params& params)
+{
+	std::vector<std::pair<std::string, std::string>> out{};
+	for (const auto& [name, value] : params)
+	{
+		out.emplace_back(std::string{ name }, std::string{ value });
+	}
+	std::ranges::sort(out);
+	return out;
+}
+
+} // namespace
+
+TEST(RouteTreeTest, TestEmpty)
+{
+	route_tree tree{};
+	const auto m = tree.match(verb::get, path{ "a" });
+	EXPECT_FALSE(m.route.has_value());
+	EXPECT_FALSE(m.path_found);
+	EXPECT_EQ(tree.size(), 0u);
+}
+
+TEST(RouteTreeTest, TestStaticRoutes)
+{
+	route_tree tree{};
+	EXPECT_EQ(tree.add(verb::get, path_spec{ "a/b" }), 0u);
+	EXPECT_EQ(tree.add(verb::post, path_spec{ "a/b" }), 1u);
+	EXPECT_EQ(tree.add(verb::get, path_spec{ "a/c" }), 2u);
+	EXPECT_EQ(tree.add(verb::get, path_spec{ "" }), 3u);
+
+	EXPECT_EQ(tree.match(verb::get, path{ "a/b" }).route, 0u);
+	EXPECT_EQ(tree.match(verb::post, path{ "/a/b/" }).route, 1u);
+	EXPECT_EQ(tree.match(verb::get, path{ "a/c" }).route, 2u);
+	EXPECT_EQ(tree.match(verb::get, path{ "/" }).route, 3u);
+}
+
+TEST(RouteTreeTest, TestNotFoundAndMethodNotAllowed)
+{
+	route_tree tree{};
+	tree.add(verb::get, path_spec{ "a/b" });
+
+	// 404
+	auto m = tree.match(verb::get, path{ "a" });
+	EXPECT_FALSE(m.route.has_value());
+	EXPECT_FALSE(m.path_found);
+
+	m = tree.match(verb::get, path{ "a/b/c" });
+	EXPECT_FALSE(m.route.has_value());
+	EXPECT_FALSE(m.path_found);
+
+	// 405
+	m = tree.match(verb::delete_, path{ "a/b" });
+	EXPECT_FALSE(m.route.has_value());
+	EXPECT_TRUE(m.path_found);
+}
+
+TEST(RouteTreeTest, TestParameters)
+{
+	route_tree tree{};
+	tree.add(verb::get, path_spec{ "customer/{id}/order/{order}" });
+	tree.add(verb::put, path_spec{ "customer/{key}/order/{number}" });
+
+	auto m = tree.match(verb::get, path{ "customer/42/order/7" });
+	EXPECT_EQ(m.route, 0u);
+	EXPECT_THAT(to_vector(m.params), testing::ElementsAre(testing::Pair("id", "42"), testing::Pair("order", "7")));
+	EXPECT_EQ(m.params.at("order"), "7");
+
+	// Same path, parameters named according to the route that matched
+	m = tree.match(verb::put, path{ "customer/42/order/7" });
+	EXPECT_EQ(m.route, 1u);
+	EXPECT_THAT(to_vector(m.params), testing::ElementsAre(testing::Pair("key", "42"), testing::Pair("number", "7")));
+}
+
+TEST(RouteTreeTest, TestFirstAddedRouteWins)
+{
+	route_tree tree{};
+	tree.add(verb::get, path_spec{ "a/{x}" });
+	tree.add(verb::get, path_spec{ "a/b" });
+	tree.add(verb::post, path_spec{ "a/b" });
+	tree.add(verb::post, path_spec{ "a/{y}" });
+	tree.add(verb::get, path_spec{ "a/b" });
+
+	auto m = tree.match(verb::get, path{ "a/b" });
+	EXPECT_EQ(m.route, 0u);
+	EXPECT_EQ(m.params.at("x"), "b");
+
+	m = tree.match(verb::post, path{ "a/b" });
+	EXPECT_EQ(m.route, 2u);
+	EXPECT_TRUE(m.params.empty());
+
+	m = tree.match(verb::post, path{ "a/c" });
+	EXPECT_EQ(m.route, 3u);
+	EXPECT_EQ(m.params.at("y"), "c");
+}
+
+TEST(RouteTreeTest, TestBacktracking)
+{
+	route_tree tree{};
+	tree.add(verb::get, path_spec{ "a/b/c" });
+	tree.add(verb::get, path_spec{ "a/{x}/d" });
+
+	// The static branch a/b is a dead end for a/b/d
+	const auto m = tree.match(verb::get, path{ "a/b/d" });
+	EXPECT_EQ(m.route, 1u);
+	EXPECT_EQ(m.params.at("x"), "b");
+}
+
+TEST(RouteTreeTest, TestTooManyParameters)
+{
+	std::string spec{};
+	for (auto i = std::size_t{}; i <= path_params::capacity; ++i)
+	{
+		spec += "/{p" + std::to_string(i) + "}";
+	}
+
+	route_tree tree{};
+	EXPECT_THROW(tree.add(verb::get, path_spec{ spec }), std::length_error);
+	EXPECT_EQ(tree.size(), 0u);
+}
+
+// The tree must choose the same route as a linear scan with path_spec::match, which is what the rest router used to do
+TEST(RouteTreeTest, TestSameAsLinearScan)
+{
+	const auto words   = std::vector<std::string>{ "a", "b", "c", "{x}", "{y}" };
+	const auto methods = std::vector<verb>{ verb::get, verb::post, verb::put };
+
+	auto engine = std::mt19937{ 42u };
+	auto pick   = [&engine](std::size_t n) { return std::uniform_int_distribution<std::size_t>{ 0u, n - 1u }(engine); };
+
+	// The path specs refer to these strings, which must outlive the tree
+	auto specs = std::vector<std::string>{};
+	for (auto i = 0; i < 200; ++i)
+	{
+		auto spec = std::string{};
+		for (auto n = pick(4u); n != 0u; --n)
+		{
+			spec += "/" + words[pick(words.size())];
+		}
+		specs.push_back(spec);
+	}
+
+	route_tree                              tree{};
+	std::vector<std::pair<verb, path_spec>> routes{};
+	for (const auto& spec : specs)
+	{
+		routes.emplace_back(methods[pick(methods.size())], path_spec{ spec });
+		tree.add(routes.back().first, routes.back().second);
+	}
+
+	for (auto i = 0; i < 2000; ++i)
+	{
+		auto text = std::string{};
+		for (auto n = pick(5u); n != 0u; --n)
+		{
+			text += "/" + std::string{ "abcd" }.substr(pick(4u), 1u);
+		}
+		const auto p      = path{ text };
+		const auto method = methods[pick(methods.size())];
+
+		auto expected_route  = std::optional<std::size_t>{};
+		auto expected_params = std::vector<std::pair<std::string, std::string>>{};
+		auto expected_found  = false;
+		for (auto r = std::size_t{}; r < routes.size(); ++r)
+		{
+			const auto params = routes[r].second.match(p);
+			if (params && routes[r].first == method && !expected_route)
+			{
+				expected_route  = r;
+				expected_params = to_vector(params.value());
+			}
+			expected_found = expected_found || params.has_value();
+		}
+
+		const auto m = tree.match(method, p);
+		EXPECT_EQ(m.route, expected_route) << text;
+		EXPECT_EQ(to_vector(m.params), expected_params) << text;
+		EXPECT_EQ(m.path_found, expected_found) << text;
+	}
+}
+
+} // namespace spider
+} // namespace zoo
@@ -0,0 +1,151 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include <zoo/spider/http_session.h>
+#include <zoo/spider/irequest_handler.h>
+#include <zoo/spider/messages/string_response.h>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/http.hpp>
+
+#include <array>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace zoo {
+namespace spider {
+
+namespace {
+
+using namespace std::chrono_literals;
+
+// Echoes the target, the response to /slow is delayed so that later requests finish first
+class delaying_handler final : public irequest_handler
+{
+public:
+	std::vector<std::string> finished{}; // targets in the order their handlers finished
+
+	response_wrapper handle_request(request&& req) override
+	{
+		const auto target = std::string{ req.target().data(), req.target().size() };
+		this->finished.push_back(target);
+		return string_response::create(req, http::status::ok, "text/plain", target);
+	}
+
+	net::awaitable<response_wrapper> async_handle_request(request req) override
+	{
+		if (req.target() == "/slow")
+		{
+			auto timer = net::steady_timer{ co_await net::this_coro::executor, 100ms };
+			co_await timer.async_wait(net::use_awaitable);
+		}
+		co_return this->handle_request(std::move(req));
+	}
+};
+
+class HttpSessionTests : public testing::Test
+{
+protected:
+	net::io_context                   server_ioc{ 1 };
+	net::io_context                   client_ioc{ 1 };
+	std::shared_ptr<delaying_handler> handler = std::make_shared<delaying_handler>();
+	tcp::socket                       client{ this->client_ioc };
+
+	// Connect the client to a session
+	void SetUp() override
+	{
+		auto acceptor = tcp::acceptor{ this->server_ioc, tcp::endpoint{ net::ip::make_address("127.0.0.1"), 0 } };
+		this->client.connect(acceptor.local_endpoint());
+		http_session::run(acceptor.accept(), this->handler);
+	}
+
+	void send(const char* target, bool keep_alive = true)
+	{
+		auto req = http::request<http::empty_body>{ http::verb::get, target, 11 };
+		req.set(http::field::host, "localhost");
+		req.keep_alive(keep_alive);
+		http::write(this->client, req);
+	}
+
+	std::vector<std::string> receive(std::size_t count)
+	{
+		auto bodies = std::vector<std::string>{};
+		auto buffer = beast::flat_buffer{};
+		for (auto i = std::size_t{}; i < count; ++i)
+		{
+			auto res = http::response<http::string_body>{};
+			http::read(this->client, buffer, res);
+			bodies.push_back(res.body());
+		}
+		return bodies;
+	}
+};
+
+} // namespace
+
+TEST_F(HttpSessionTests, ResponsesAreSentInTheOrderOfTheRequests)
+{
+	this->send("/slow");
+	this->send("/fast");
+
+	auto server = std::thread{ [this] { this->server_ioc.run(); } };
+
+	EXPECT_EQ(this->receive(2), (std::vector<std::string>{ "/slow", "/fast" }));
+
+	this->client.shutdown(tcp::socket::shutdown_send);
+	server.join();
+
+	EXPECT_EQ(this->handler->finished, (std::vector<std::string>{ "/fast", "/slow" }));
+}
+
+TEST_F(HttpSessionTests, PendingResponsesAreSentAfterTheClientClosed)
+{
+	this->send("/slow");
+	this->send("/fast");
+	this->client.shutdown(tcp::socket::shutdown_send);
+
+	auto server = std::thread{ [this] { this->server_ioc.run(); } };
+
+	EXPECT_EQ(this->receive(2), (std::vector<std::string>{ "/slow", "/fast" }));
+
+	// Then the session closes the connection
+	auto ec     = beast::error_code{};
+	auto buffer = std::array<char, 1>{};
+	this->client.read_some(net::buffer(buffer), ec);
+	EXPECT_EQ(ec, net::error::eof);
+
+	server.join();
+}
+
+TEST_F(HttpSessionTests, SessionEndsAfterAResponseWithoutKeepAlive)
+{
+	// The client keeps its side open, the session reads the next request while it responds
+	this->send("/fast", false);
+
+	auto server = std::thread{ [this] { this->server_ioc.run(); } };
+
+	EXPECT_EQ(this->receive(1), (std::vector<std::string>{ "/fast" }));
+
+	auto ec     = beast::error_code{};
+	auto buffer = std::array<char, 1>{};
+	this->client.read_some(net::buffer(buffer), ec);
+	EXPECT_EQ(ec, net::error::eof);
+
+	// The pending read is cancelled, so the session ends and the server runs out of work
+	server.join();
+}
+
+} // namespace spider
+} // namespace zoo
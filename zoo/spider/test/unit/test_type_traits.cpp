@@ -0,0 +1,65 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include <zoo/spider/type_traits.h>
+#include <zoo/spider/rest/handler.hpp>
+
+#include <boost/asio/awaitable.hpp>
+
+#include <string>
+#include <type_traits>
+
+namespace zoo {
+namespace spider {
+
+namespace {
+
+class test_controller
+{
+public:
+	int                  by_value(int a, std::string b);
+	int                  by_const_value(const int a, const std::string b);
+	int                  by_reference(int a, const std::string& b);
+	net::awaitable<int>  async_by_value(int a, std::string b);
+	net::awaitable<void> async_no_args();
+	net::awaitable<int>  async_by_reference(const std::string& b);
+};
+
+} // namespace
+
+TEST(TypeTraitsTest, IsAwaitable)
+{
+	EXPECT_TRUE(is_awaitable_v<net::awaitable<int>>);
+	EXPECT_TRUE(is_awaitable_v<net::awaitable<void>>);
+	EXPECT_TRUE((is_awaitable_v<net::awaitable<std::string, net::any_io_executor>>));
+	EXPECT_FALSE(is_awaitable_v<int>);
+	EXPECT_FALSE(is_awaitable_v<void>);
+	EXPECT_FALSE(is_awaitable_v<net::awaitable<int>&>);
+}
+
+TEST(TypeTraitsTest, AwaitedType)
+{
+	EXPECT_TRUE((std::is_same_v<awaited_t<net::awaitable<int>>, int>));
+	EXPECT_TRUE((std::is_same_v<awaited_t<net::awaitable<void>>, void>));
+	EXPECT_TRUE((std::is_same_v<awaited_t<int>, int>));
+	EXPECT_TRUE((std::is_same_v<awaited_t<std::string>, std::string>));
+}
+
+TEST(TypeTraitsTest, HandlerArgsByValue)
+{
+	// Coroutine handlers must take their arguments by value, a reference would dangle once the coroutine is suspended
+	EXPECT_TRUE(handler<decltype(&test_controller::by_value)>::args_by_value);
+	EXPECT_TRUE(handler<decltype(&test_controller::by_const_value)>::args_by_value);
+	EXPECT_FALSE(handler<decltype(&test_controller::by_reference)>::args_by_value);
+	EXPECT_TRUE(handler<decltype(&test_controller::async_by_value)>::args_by_value);
+	EXPECT_TRUE(handler<decltype(&test_controller::async_no_args)>::args_by_value);
+	EXPECT_FALSE(handler<decltype(&test_controller::async_by_reference)>::args_by_value);
+}
+
+} // namespace spider
+} // namespace zoo
@@ -10,6 +10,7 @@
 #include "zoo/spider/aliases.h"
 
 #include <boost/beast/http/message.hpp>
+#include <boost/asio/awaitable.hpp>
 
 #include <type_traits>
 
@@ -29,5 +30,34 @@ struct is_http_response<http::response<U>> : std::true_type
 template<typename T>
 inline constexpr bool is_http_response_v = is_http_response<T>::value;
 
+template<typename T>
+struct is_awaitable : std::false_type
+{
+};
+
+template<typename T, typename Executor>
+struct is_awaitable<net::awaitable<T, Executor>> : std::true_type
+{
+};
+
+template<typename T>
+inline constexpr bool is_awaitable_v = is_awaitable<T>::value;
+
+/// The type that co_await yields for an awaitable T, or T itself for any other type
+template<typename T>
+struct awaited
+{
+	using type = T;
+};
+
+template<typename T, typename Executor>
+struct awaited<net::awaitable<T, Executor>>
+{
+	using type = T;
+};
+
+template<typename T>
+using awaited_t = typename awaited<T>::type;
+
 } // namespace spider
 } // namespace zoo
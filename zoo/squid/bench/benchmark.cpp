@@ -0,0 +1,143 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "benchmark.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <ostream>
+
+namespace zoo {
+namespace squid {
+namespace bench {
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+// Upper bound of the iteration count, so that the calibration terminates for operations that take no measurable time
+constexpr auto max_iterations = std::uint64_t{ 1000000000 };
+
+double run_once(const operation& op, std::uint64_t iterations)
+{
+	const auto start = clock_type::now();
+	op(iterations);
+	return std::chrono::duration<double, std::nano>{ clock_type::now() - start }.count();
+}
+
+// Grow the iteration count until a run takes at least the minimum time.
+// This doubles as the warm up of caches, allocators and prepared statements.
+std::uint64_t calibrate(const operation& op, std::chrono::milliseconds min_time)
+{
+	const auto min_ns     = std::chrono::duration<double, std::nano>{ min_time }.count();
+	auto       iterations = std::uint64_t{ 1 };
+	for (;;)
+	{
+		const auto ns = run_once(op, iterations);
+		if (ns >= min_ns || iterations >= max_iterations)
+		{
+			return iterations;
+		}
+
+		// Aim slightly past the minimum time, but grow by at most a factor of 10 per step because the first runs are noisy
+		const auto factor = ns > 0.0 ? std::clamp(1.4 * min_ns / ns, 2.0, 10.0) : 10.0;
+		iterations        = std::min(max_iterations, static_cast<std::uint64_t>(std::ceil(static_cast<double>(iterations) * factor)));
+	}
+}
+
+struct measurement final
+{
+	std::uint64_t iterations;
+	double        median_ns; // per operation
+	double        min_ns;    // per operation
+};
+
+measurement measure(const operation& op, const options& options)
+{
+	const auto iterations = options.iterations.value_or(0u) != 0u ? options.iterations.value() : calibrate(op, options.min_time);
+
+	std::vector<double> samples{};
+	samples.reserve(std::max<std::size_t>(options.repetitions, 1u));
+	for (auto i = std::size_t{}; i < std::max<std::size_t>(options.repetitions, 1u); ++i)
+	{
+		samples.push_back(run_once(op, iterations) / static_cast<double>(iterations));
+	}
+
+	std::ranges::sort(samples);
+	const auto middle = samples.size() / 2u;
+	const auto median = samples.size() % 2u ? samples[middle] : (samples[middle - 1u] + samples[middle]) / 2.0;
+
+	return measurement{ .iterations = iterations, .median_ns = median, .min_ns = samples.front() };
+}
+
+void print_header(const options& options, std::ostream& os)
+{
+	if (options.csv)
+	{
+		os << "benchmark,iterations,median_ns,min_ns,items_per_second\n";
+	}
+	else
+	{
+		os << std::left << std::setw(56) << "benchmark" << std::right << std::setw(12) << "iterations" << std::setw(14) << "median ns/op"
+		   << std::setw(14) << "min ns/op" << std::setw(14) << "items/s"
+		   << "\n";
+	}
+}
+
+void print_measurement(std::string_view name, std::uint64_t items, const measurement& m, const options& options, std::ostream& os)
+{
+	const auto items_per_second = m.median_ns > 0.0 ? static_cast<double>(items) * 1e9 / m.median_ns : 0.0;
+	if (options.csv)
+	{
+		os << name << "," << m.iterations << "," << std::fixed << std::setprecision(1) << m.median_ns << "," << m.min_ns << ","
+		   << std::setprecision(0) << items_per_second << "\n";
+	}
+	else
+	{
+		os << std::left << std::setw(56) << name << std::right << std::setw(12) << m.iterations << std::fixed << std::setprecision(1)
+		   << std::setw(14) << m.median_ns << std::setw(14) << m.min_ns << std::setprecision(0) << std::setw(14) << items_per_second << "\n";
+	}
+	os.flush();
+}
+
+} // namespace
+
+suite::suite()
+    : entries_{}
+{
+}
+
+void suite::add(std::string name, std::uint64_t items, bench::setup setup)
+{
+	this->entries_.push_back(entry{ .name = std::move(name), .items = items, .setup = std::move(setup) });
+}
+
+std::size_t suite::run(const options& options, std::ostream& os) const
+{
+	auto count = std::size_t{};
+	for (const auto& entry : this->entries_)
+	{
+		if (!options.filter.empty() && entry.name.find(options.filter) == std::string::npos)
+		{
+			continue;
+		}
+
+		if (count++ == 0u)
+		{
+			print_header(options, os);
+		}
+
+		const auto op = entry.setup();
+		print_measurement(entry.name, entry.items, measure(op, options), options, os);
+	}
+	return count;
+}
+
+} // namespace bench
+} // namespace squid
+} // namespace zoo
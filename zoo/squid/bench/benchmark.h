@@ -0,0 +1,94 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+namespace bench {
+
+struct options final
+{
+	std::string                  filter{};         //!< Only run the benchmarks whose name contains this string
+	std::size_t                  repetitions{ 5 }; //!< Number of measured runs per benchmark
+	std::chrono::milliseconds    min_time{ 200 };  //!< Minimum duration of a run, used to choose the iteration count
+	std::optional<std::uint64_t> iterations{};     //!< Fixed iteration count, skips the calibration
+	std::optional<std::string>   postgresql{};     //!< Connection info of a PostgreSQL server for the live scenarios
+	bool                         csv{};            //!< Report comma separated values instead of a table
+};
+
+/// The measured operation of a benchmark, which must perform its work @a iterations times.
+using operation = std::function<void(std::uint64_t iterations)>;
+
+/// Creates the fixture of a benchmark and returns the operation to measure.
+/// The fixture is created once, before the calibration and the measured runs.
+using setup = std::function<operation()>;
+
+/// Wrap the single iteration @a function into an operation.
+template<typename Function>
+operation repeat(Function&& function)
+{
+	return [function = std::forward<Function>(function)](std::uint64_t iterations) mutable {
+		for (; iterations != 0u; --iterations)
+		{
+			function();
+		}
+	};
+}
+
+/// Keep the compiler from optimizing away the computation of @a value.
+template<typename T>
+void do_not_optimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static volatile const void* sink{};
+	sink = &value;
+	std::atomic_signal_fence(std::memory_order_seq_cst);
+#endif
+}
+
+class suite final
+{
+	struct entry final
+	{
+		std::string   name;
+		std::uint64_t items;
+		bench::setup  setup;
+	};
+
+	std::vector<entry> entries_;
+
+public:
+	suite();
+
+	/// Add the benchmark @a name, which processes @a items items per operation, e.g. the number of rows fetched.
+	void add(std::string name, std::uint64_t items, bench::setup setup);
+
+	/// Run the benchmarks selected by @a options and report the results to @a os.
+	/// Returns the number of benchmarks that ran.
+	std::size_t run(const options& options, std::ostream& os) const;
+};
+
+void add_core_benchmarks(suite& suite);
+void add_conversion_benchmarks(suite& suite);
+void add_sqlite_benchmarks(suite& suite);
+void add_postgresql_benchmarks(suite& suite, const options& options);
+
+} // namespace bench
+} // namespace squid
+} // namespace zoo
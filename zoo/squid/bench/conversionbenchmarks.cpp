@@ -0,0 +1,135 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Cost of the date and time text conversions of zoo::conversion, which every backend that
+// exchanges temporal values as text pays once per value.
+
+#include "benchmark.h"
+#include "dataset.h"
+
+#include "zoo/common/conversion/conversion.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+namespace bench {
+
+namespace {
+
+// The timestamps of the dataset as text, formatted by @a format
+template<typename Format>
+std::vector<std::string> make_texts(Format format)
+{
+	std::vector<std::string> out{};
+	for (const auto& it : make_dataset())
+	{
+		out.push_back(format(it.at));
+	}
+	return out;
+}
+
+template<typename Parse>
+void add_parse_benchmark(suite& suite, std::string name, std::vector<std::string> (*make)(), Parse parse)
+{
+	suite.add("conversion/parse/" + std::move(name), dataset_size, [make, parse] {
+		auto texts = std::make_shared<std::vector<std::string>>(make());
+		return repeat([texts, parse] {
+			for (const auto& text : *texts)
+			{
+				do_not_optimize(parse(text));
+			}
+		});
+	});
+}
+
+template<typename Value, typename Format>
+void add_format_benchmark(suite& suite, std::string name, Value (*convert)(const time_point&), Format format)
+{
+	suite.add("conversion/format/" + std::move(name), dataset_size, [convert, format] {
+		auto values = std::make_shared<std::vector<Value>>();
+		for (const auto& it : make_dataset())
+		{
+			values->push_back(convert(it.at));
+		}
+		auto out = std::make_shared<std::string>();
+		return repeat([values, out, format] {
+			for (const auto& value : *values)
+			{
+				format(value, *out);
+				do_not_optimize(out->data());
+			}
+		});
+	});
+}
+
+std::vector<std::string> sql_texts()
+{
+	return make_texts([](const time_point& tp) { return conversion::time_point_to_sql(tp); });
+}
+
+std::vector<std::string> iso8601_texts()
+{
+	return make_texts([](const time_point& tp) { return conversion::time_point_to_iso8601(tp); });
+}
+
+std::vector<std::string> offset_texts()
+{
+	return make_texts([](const time_point& tp) { return conversion::time_point_to_sql(tp) + "+02:00"; });
+}
+
+std::vector<std::string> date_texts()
+{
+	return make_texts([](const time_point& tp) { return conversion::time_point_to_sql(tp).substr(0u, 10u); });
+}
+
+std::vector<std::string> time_of_day_texts()
+{
+	return make_texts([](const time_point& tp) { return conversion::time_point_to_sql(tp).substr(11u); });
+}
+
+conversion::date to_date(const time_point& tp)
+{
+	return conversion::date{ std::chrono::floor<std::chrono::days>(tp) };
+}
+
+conversion::time_of_day to_time_of_day(const time_point& tp)
+{
+	return conversion::time_of_day{ std::chrono::floor<std::chrono::microseconds>(tp - std::chrono::floor<std::chrono::days>(tp)) };
+}
+
+time_point to_time_point(const time_point& tp)
+{
+	return tp;
+}
+
+} // namespace
+
+void add_conversion_benchmarks(suite& suite)
+{
+	add_parse_benchmark(suite, "time_point_sql", sql_texts, [](const std::string& s) { return conversion::string_to_time_point(s); });
+	add_parse_benchmark(suite, "time_point_iso8601", iso8601_texts, [](const std::string& s) { return conversion::string_to_time_point(s); });
+	add_parse_benchmark(suite, "time_point_offset", offset_texts, [](const std::string& s) { return conversion::string_to_time_point(s); });
+	add_parse_benchmark(suite, "date", date_texts, [](const std::string& s) { return conversion::string_to_date(s); });
+	add_parse_benchmark(suite, "time_of_day", time_of_day_texts, [](const std::string& s) { return conversion::string_to_time_of_day(s); });
+
+	add_format_benchmark(
+	    suite, "time_point_sql", to_time_point, [](const time_point& in, std::string& out) { conversion::time_point_to_sql(in, out); });
+	add_format_benchmark(suite, "time_point_iso8601", to_time_point, [](const time_point& in, std::string& out) {
+		conversion::time_point_to_iso8601(in, out);
+	});
+	add_format_benchmark(suite, "date", to_date, [](const conversion::date& in, std::string& out) { conversion::date_to_string(in, out); });
+	add_format_benchmark(suite, "time_of_day", to_time_of_day, [](const conversion::time_of_day& in, std::string& out) {
+		conversion::time_of_day_to_string(in, out);
+	});
+}
+
+} // namespace bench
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,220 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Client side cost of the core library, measured against backends that do no work at all
+
+#include "benchmark.h"
+
+#include "zoo/squid/core/bindingplan.h"
+#include "zoo/squid/core/connection.h"
+#include "zoo/squid/core/connectionpool.h"
+#include "zoo/squid/core/ibackendconnection.h"
+#include "zoo/squid/core/ibackendconnectionfactory.h"
+#include "zoo/squid/core/ibackendstatement.h"
+#include "zoo/squid/core/preparedstatement.h"
+#include "zoo/squid/core/statement.h"
+
+#include <memory>
+
+namespace zoo {
+namespace squid {
+namespace bench {
+
+namespace {
+
+constexpr auto pool_size = std::size_t{ 4 };
+
+class null_statement final : public ibackend_statement
+{
+	std::optional<binding_plan> plan_;
+
+public:
+	explicit null_statement(std::optional<binding_plan> plan)
+	    : plan_{ std::move(plan) }
+	{
+	}
+
+	void execute(const std::map<std::string, parameter>& parameters, const std::vector<result>&) override
+	{
+		do_not_optimize(parameters);
+	}
+
+	void execute(const std::map<std::string, parameter>& parameters, const std::map<std::string, result>&) override
+	{
+		do_not_optimize(parameters);
+	}
+
+	void execute_positional(const positional_parameters& parameters, const std::vector<result>&) override
+	{
+		do_not_optimize(parameters);
+	}
+
+	void execute_positional(const positional_parameters& parameters, const std::map<std::string, result>&) override
+	{
+		do_not_optimize(parameters);
+	}
+
+	bool fetch() override
+	{
+		return false;
+	}
+
+	std::size_t field_count() override
+	{
+		return 0u;
+	}
+
+	std::string field_name(std::size_t) override
+	{
+		return std::string{};
+	}
+
+	std::uint64_t affected_rows() override
+	{
+		return 0u;
+	}
+
+	void set_fetch_mode(fetch_mode) override
+	{
+	}
+
+	const binding_plan* parameter_binding_plan() const override
+	{
+		return this->plan_ ? &this->plan_.value() : nullptr;
+	}
+};
+
+// Creates statements without a binding plan for create_statement and with one for create_prepared_statement,
+// like the backends that translate their queries
+class null_connection final : public ibackend_connection
+{
+public:
+	std::unique_ptr<ibackend_statement> create_statement(std::string_view) override
+	{
+		return std::make_unique<null_statement>(std::nullopt);
+	}
+
+	std::unique_ptr<ibackend_statement> create_prepared_statement(std::string_view) override
+	{
+		return std::make_unique<null_statement>(binding_plan{ { "id", "name", "value", "at" } });
+	}
+
+	void execute(const std::string&) override
+	{
+	}
+
+	statement_cache_stats prepared_statement_cache_stats() const override
+	{
+		return statement_cache_stats{};
+	}
+
+	void set_prepared_statement_cache_capacity(std::size_t) override
+	{
+	}
+
+	bool is_valid() override
+	{
+		return true;
+	}
+};
+
+class null_connection_factory final : public ibackend_connection_factory
+{
+public:
+	std::shared_ptr<ibackend_connection> create_backend_connection(std::string_view) const override
+	{
+		return std::make_shared<null_connection>();
+	}
+};
+
+void add_pool_benchmarks(suite& suite)
+{
+	suite.add("core/pool/acquire_release", 1u, [] {
+		auto pool = std::make_shared<connection_pool>(null_connection_factory{}, "", pool_size);
+		return repeat([pool] { do_not_optimize(pool->acquire()); });
+	});
+
+	suite.add("core/pool/try_acquire_release", 1u, [] {
+		auto pool = std::make_shared<connection_pool>(null_connection_factory{}, "", pool_size);
+		return repeat([pool] { do_not_optimize(pool->try_acquire()); });
+	});
+
+	suite.add("core/pool/connection_from_pool", 1u, [] {
+		auto pool = std::make_shared<connection_pool>(null_connection_factory{}, "", pool_size);
+		return repeat([pool] {
+			connection connection{ *pool };
+			do_not_optimize(connection);
+		});
+	});
+}
+
+// A statement of four parameters of common types, executed against a null backend.
+// Prepared statements bind positionally, following the binding plan of the backend statement, other statements bind by name.
+struct binding_fixture final
+{
+	squid::connection                connection;
+	std::unique_ptr<basic_statement> st;
+	std::int64_t                     id;
+	std::string                      name;
+	double                           value;
+	time_point                       at;
+
+	explicit binding_fixture(bool prepared)
+	    : connection{ null_connection_factory{}, "" }
+	    , st{ prepared ? std::unique_ptr<basic_statement>{ std::make_unique<prepared_statement>(this->connection, query) }
+	                   : std::unique_ptr<basic_statement>{ std::make_unique<statement>(this->connection, query) } }
+	    , id{ 42 }
+	    , name{ "a name that is too long for the small string buffer" }
+	    , value{ 3.14 }
+	    , at{ std::chrono::sys_days{ std::chrono::year{ 2024 } / 5 / 6 } + std::chrono::hours{ 7 } }
+	{
+	}
+
+	static constexpr auto query = "INSERT INTO item (id, name, value, at) VALUES (:id, :name, :value, :at)";
+};
+
+void add_binding_benchmarks(suite& suite)
+{
+	for (const auto prepared : { true, false })
+	{
+		const std::string prefix = prepared ? "core/bind/positional/" : "core/bind/named/";
+
+		suite.add(prefix + "by_value", 4u, [prepared] {
+			auto f = std::make_shared<binding_fixture>(prepared);
+			return repeat([f] {
+				f->st->bind("id", f->id).bind("name", f->name).bind("value", f->value).bind("at", f->at);
+				f->st->execute();
+			});
+		});
+
+		suite.add(prefix + "bind_execute", 4u, [prepared] {
+			auto f = std::make_shared<binding_fixture>(prepared);
+			return repeat([f] { f->st->bind_execute({ { "id", f->id }, { "name", f->name }, { "value", f->value }, { "at", f->at } }); });
+		});
+
+		suite.add(prefix + "by_reference", 4u, [prepared] {
+			auto f = std::make_shared<binding_fixture>(prepared);
+			f->st->bind_ref("id", f->id).bind_ref("name", f->name).bind_ref("value", f->value).bind_ref("at", f->at);
+			return repeat([f] {
+				++f->id;
+				f->st->execute();
+			});
+		});
+	}
+}
+
+} // namespace
+
+void add_core_benchmarks(suite& suite)
+{
+	add_pool_benchmarks(suite);
+	add_binding_benchmarks(suite);
+}
+
+} // namespace bench
+} // namespace squid
+} // namespace zoo
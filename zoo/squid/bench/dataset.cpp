@@ -0,0 +1,52 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "dataset.h"
+
+#include <random>
+
+namespace zoo {
+namespace squid {
+namespace bench {
+
+std::vector<item> make_dataset(std::size_t size)
+{
+	// std::mt19937_64 produces the same sequence on every platform, unlike the standard distributions,
+	// so the values are derived from the raw engine output
+	std::mt19937_64 engine{ 20240506u };
+
+	const auto epoch = time_point{ std::chrono::sys_days{ std::chrono::year{ 2024 } / 1 / 1 } };
+
+	std::vector<item> items{};
+	items.reserve(size);
+	for (auto i = std::size_t{}; i < size; ++i)
+	{
+		const auto r = engine();
+
+		item it{};
+		it.id     = static_cast<std::int64_t>(i) + 1;
+		it.count  = static_cast<std::int64_t>(r % 1000000u);
+		it.amount = static_cast<double>(r % 100000000u) / 100.0;
+		if (i % 5u != 4u)
+		{
+			it.label = "label " + std::to_string(r % 100000u);
+		}
+		it.payload.resize(16u + r % 48u);
+		for (auto& byte : it.payload)
+		{
+			byte = static_cast<std::uint8_t>(engine());
+		}
+		it.at = epoch + std::chrono::microseconds{ static_cast<std::int64_t>(engine() % (366ull * 24 * 3600 * 1000000)) };
+
+		items.push_back(std::move(it));
+	}
+	return items;
+}
+
+} // namespace bench
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,45 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/core/types.h"
+
+#include <boost/describe.hpp>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+namespace bench {
+
+/// Number of rows of the tables that are scanned
+constexpr auto dataset_size = std::size_t{ 1000 };
+
+/// A row of the synthetic item table, which has a column per type that is decoded.
+/// Every fifth label is null, to include the null handling in the measurements.
+struct item final
+{
+	std::int64_t               id;
+	std::int64_t               count;
+	double                     amount;
+	std::optional<std::string> label;
+	byte_string                payload;
+	time_point                 at;
+};
+
+BOOST_DESCRIBE_STRUCT(item, (), (id, count, amount, label, payload, at))
+
+/// Generate @a size items from a fixed seed, so that every run measures the same data
+std::vector<item> make_dataset(std::size_t size = dataset_size);
+
+} // namespace bench
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,109 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Benchmarks of the hot paths of squid, to have a baseline to compare changes against.
+// The data is generated from fixed seeds, so that runs on the same machine are comparable.
+
+#include "benchmark.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace {
+
+constexpr auto usage = R"(Usage: zoo_squid_bench [options]
+Options:
+  --filter=<text>       Only run the benchmarks whose name contains <text>
+  --repetitions=<n>     Number of measured runs per benchmark (default 5)
+  --min-time=<ms>       Minimum duration of a run in milliseconds, used to choose the iteration count (default 200)
+  --iterations=<n>      Run every benchmark <n> times per run instead of choosing the iteration count
+  --postgresql=<info>   Also run the live scenarios against the PostgreSQL server at connection info <info>
+  --csv                 Report comma separated values
+  --help                Show this help
+)";
+
+zoo::squid::bench::options parse_options(int argc, char* argv[])
+{
+	zoo::squid::bench::options options{};
+	for (auto i = 1; i < argc; ++i)
+	{
+		const auto arg   = std::string_view{ argv[i] };
+		const auto eq    = arg.find('=');
+		const auto name  = arg.substr(0, eq);
+		const auto value = eq == std::string_view::npos ? std::string{} : std::string{ arg.substr(eq + 1) };
+
+		if (name == "--filter")
+		{
+			options.filter = value;
+		}
+		else if (name == "--repetitions")
+		{
+			options.repetitions = std::stoul(value);
+		}
+		else if (name == "--min-time")
+		{
+			options.min_time = std::chrono::milliseconds{ std::stol(value) };
+		}
+		else if (name == "--iterations")
+		{
+			options.iterations = std::stoull(value);
+		}
+		else if (name == "--postgresql")
+		{
+			options.postgresql = value;
+		}
+		else if (name == "--csv")
+		{
+			options.csv = true;
+		}
+		else if (name == "--help")
+		{
+			std::cout << usage;
+			std::exit(0);
+		}
+		else
+		{
+			throw std::invalid_argument{ "unknown option " + std::string{ arg } + "\n" + usage };
+		}
+	}
+	return options;
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	try
+	{
+		const auto options = parse_options(argc, argv);
+
+		zoo::squid::bench::suite suite{};
+		zoo::squid::bench::add_core_benchmarks(suite);
+		zoo::squid::bench::add_conversion_benchmarks(suite);
+#ifdef ZOO_SQUID_BENCH_WITH_SQLITE3
+		zoo::squid::bench::add_sqlite_benchmarks(suite);
+#endif
+#ifdef ZOO_SQUID_BENCH_WITH_POSTGRESQL
+		zoo::squid::bench::add_postgresql_benchmarks(suite, options);
+#endif
+
+		if (suite.run(options, std::cout) == 0u)
+		{
+			std::cerr << "no benchmark matches " << options.filter << "\n";
+			return 1;
+		}
+	}
+	catch (const std::exception& e)
+	{
+		std::cerr << e.what() << "\n";
+		return 1;
+	}
+}
@@ -0,0 +1,357 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Client side cost of the PostgreSQL backend, fed with synthetic results in the text format of libpq,
+// and optionally the same scenarios against a live server.
+
+#include "benchmark.h"
+#include "dataset.h"
+#include "syntheticpqapi.h"
+
+#include "zoo/squid/postgresql/connection.h"
+#include "zoo/squid/postgresql/resultset.h"
+#include "zoo/squid/postgresql/tuple.h"
+#include "zoo/squid/postgresql/detail/query.h"
+#include "zoo/squid/core/columnbatch.h"
+#include "zoo/squid/core/preparedstatement.h"
+#include "zoo/squid/core/statement.h"
+#include "zoo/squid/core/transaction.h"
+
+#include "zoo/common/conversion/conversion.h"
+
+#include <charconv>
+#include <memory>
+#include <stdexcept>
+#include <tuple>
+
+namespace zoo {
+namespace squid {
+namespace bench {
+
+namespace {
+
+constexpr auto translate_query = "SELECT id, count, amount, label, payload, at FROM item "
+                                 "WHERE id > :id AND count < :count AND amount <> :amount AND label LIKE :label "
+                                 "AND payload <> :payload AND at < :at AND ':quoted' <> 'x' ORDER BY id";
+
+constexpr auto upsert_query = "INSERT INTO item (id, count, amount, label, payload, at) VALUES (:id, :count, :amount, :label, :payload, :at) "
+                              "ON CONFLICT (id) DO UPDATE SET count = excluded.count";
+
+std::string double_to_text(double value)
+{
+	char buf[32];
+	const auto [end, ec] = std::to_chars(buf, buf + sizeof(buf), value);
+	return std::string{ buf, end };
+}
+
+std::string bytea_to_text(const byte_string& value)
+{
+	constexpr auto hex = "0123456789abcdef";
+
+	std::string out{ "\\x" };
+	for (const auto byte : value)
+	{
+		out += hex[byte >> 4];
+		out += hex[byte & 0xf];
+	}
+	return out;
+}
+
+// The dataset as libpq would return it in text format
+synthetic_pq_api::table make_table()
+{
+	synthetic_pq_api::table table{ .columns = { "id", "count", "amount", "label", "payload", "at" }, .rows = {} };
+	for (const auto& it : make_dataset())
+	{
+		table.rows.push_back({ std::to_string(it.id),
+		                       std::to_string(it.count),
+		                       double_to_text(it.amount),
+		                       it.label,
+		                       bytea_to_text(it.payload),
+		                       conversion::time_point_to_sql(it.at) });
+	}
+	return table;
+}
+
+// Only column @a index of the dataset
+synthetic_pq_api::table make_table(std::size_t index)
+{
+	auto table    = make_table();
+	table.columns = { table.columns[index] };
+	for (auto& row : table.rows)
+	{
+		row = { std::move(row[index]) };
+	}
+	return table;
+}
+
+// A connection of which every execution returns @a table
+struct synthetic_connection final
+{
+	synthetic_pq_api       api;
+	postgresql::connection connection;
+
+	explicit synthetic_connection(synthetic_pq_api::table table)
+	    : api{ std::move(table) }
+	    , connection{ this->api, "" }
+	{
+	}
+};
+
+// Executes a query and fetches all of its rows into the bound results
+template<typename... Results>
+struct scan final
+{
+	std::shared_ptr<void>  owner; // keeps the connection alive
+	prepared_statement     select;
+	std::tuple<Results...> values;
+
+	explicit scan(std::shared_ptr<void> owner, squid::connection& connection, std::string_view query)
+	    : owner{ std::move(owner) }
+	    , select{ connection, query }
+	    , values{}
+	{
+		std::apply([this](auto&... value) { this->select.bind_results(value...); }, this->values);
+	}
+
+	void operator()()
+	{
+		this->select.execute();
+		auto rows = std::size_t{};
+		while (this->select.fetch())
+		{
+			do_not_optimize(this->values);
+			++rows;
+		}
+		if (rows != dataset_size)
+		{
+			throw std::runtime_error{ "unexpected number of rows" };
+		}
+	}
+};
+
+template<typename... Results>
+void add_synthetic_scan(suite& suite, std::string name, std::optional<std::size_t> column)
+{
+	suite.add("postgresql/scan/" + std::move(name), dataset_size, [column] {
+		auto c = std::make_shared<synthetic_connection>(column ? make_table(column.value()) : make_table());
+		auto s = std::make_shared<scan<Results...>>(c, c->connection, "SELECT * FROM item");
+		return repeat([s] { (*s)(); });
+	});
+}
+
+void add_translation_benchmarks(suite& suite)
+{
+	suite.add("postgresql/translate/uncached", 1u, [] {
+		return repeat([] {
+			postgresql::postgresql_query query{ translate_query };
+			do_not_optimize(query);
+		});
+	});
+
+	suite.add("postgresql/translate/cached", 1u, [] {
+		return repeat([] { do_not_optimize(postgresql::postgresql_query::cached(translate_query)); });
+	});
+}
+
+void add_binding_benchmarks(suite& suite)
+{
+	// Converts the parameters to text for every execution
+	suite.add("postgresql/bind/text_conversion", 1u, [] {
+		struct fixture final
+		{
+			synthetic_connection conn;
+			std::vector<item>    items;
+			prepared_statement   upsert;
+			std::size_t          index;
+
+			fixture()
+			    : conn{ synthetic_pq_api::table{} }
+			    , items{ make_dataset() }
+			    , upsert{ conn.connection, upsert_query }
+			    , index{}
+			{
+			}
+		};
+
+		auto f = std::make_shared<fixture>();
+		return repeat([f] {
+			const auto& it = f->items[f->index++ % f->items.size()];
+			f->upsert.bind_execute(
+			    { { "id", it.id }, { "count", it.count }, { "amount", it.amount }, { "label", it.label }, { "payload", it.payload }, { "at", it.at } });
+		});
+	});
+}
+
+void add_decoding_benchmarks(suite& suite)
+{
+	add_synthetic_scan<std::int64_t>(suite, "int64", 1u);
+	add_synthetic_scan<double>(suite, "double", 2u);
+	add_synthetic_scan<std::optional<std::string>>(suite, "text", 3u);
+	add_synthetic_scan<byte_string>(suite, "bytea", 4u);
+	add_synthetic_scan<time_point>(suite, "timestamp", 5u);
+	add_synthetic_scan<std::int64_t, std::int64_t, double, std::optional<std::string>, byte_string, time_point>(suite, "all_columns", std::nullopt);
+
+	suite.add("postgresql/scan/fetch_columns", dataset_size, [] {
+		auto c      = std::make_shared<synthetic_connection>(make_table());
+		auto select = std::make_shared<prepared_statement>(c->connection, "SELECT id, amount, label FROM item");
+		auto batch  = std::make_shared<column_batch>(column_batch{ column_type::int64, column_type::float64, column_type::text });
+		return repeat([c, select, batch] {
+			select->execute();
+			auto rows = std::size_t{};
+			while (const auto n = select->fetch_columns(*batch, 256u))
+			{
+				do_not_optimize(batch->column(0).int64_values().data());
+				rows += n;
+			}
+			if (rows != dataset_size)
+			{
+				throw std::runtime_error{ "unexpected number of rows" };
+			}
+		});
+	});
+}
+
+void add_resultset_benchmarks(suite& suite)
+{
+	struct fixture final
+	{
+		synthetic_pq_api      api;
+		postgresql::resultset result;
+
+		fixture()
+		    : api{ make_table() }
+		    , result{ &this->api,
+			          std::shared_ptr<PGresult>{ this->api.execParams(nullptr, "", 0, nullptr, nullptr, nullptr, nullptr, 0), [](PGresult*) {} } }
+		{
+		}
+	};
+
+	suite.add("postgresql/resultset/rows_by_index", dataset_size, [] {
+		auto f = std::make_shared<fixture>();
+		return repeat([f] {
+			const auto amount = f->result.field_index("amount");
+			const auto at     = f->result.field_index("at");
+			for (const auto row : f->result.rows())
+			{
+				do_not_optimize(row[amount].to_double());
+				do_not_optimize(row[at].to_time_point());
+			}
+		});
+	});
+
+	suite.add("postgresql/resultset/rows_by_name", dataset_size, [] {
+		auto f = std::make_shared<fixture>();
+		return repeat([f] {
+			for (const auto row : f->result.rows())
+			{
+				do_not_optimize(row["amount"].to_double());
+				do_not_optimize(row["at"].to_time_point());
+			}
+		});
+	});
+
+	suite.add("postgresql/resultset/tuples", dataset_size, [] {
+		auto f = std::make_shared<fixture>();
+		return repeat([f] {
+			for (const auto& tuple : f->result)
+			{
+				do_not_optimize(tuple.get_field("amount").to_double());
+				do_not_optimize(tuple.get_field("at").to_time_point());
+			}
+		});
+	});
+}
+
+// A live connection with the dataset in a temporary table
+struct live_database final
+{
+	postgresql::connection connection;
+
+	explicit live_database(const std::string& connection_info)
+	    : connection{ connection_info }
+	{
+		this->connection.execute("CREATE TEMPORARY TABLE item (id bigint PRIMARY KEY, count bigint NOT NULL, amount double precision NOT NULL, "
+		                         "label text, payload bytea NOT NULL, at timestamp NOT NULL)");
+
+		const auto         items = make_dataset();
+		transaction        tr{ this->connection };
+		prepared_statement insert{ this->connection, upsert_query };
+		insert.execute_batch(items);
+		tr.commit();
+	}
+};
+
+void add_live_benchmarks(suite& suite, const std::string& connection_info)
+{
+	suite.add("postgresql/live/scan/all_columns", dataset_size, [connection_info] {
+		auto db = std::make_shared<live_database>(connection_info);
+		auto s  = std::make_shared<scan<std::int64_t, std::int64_t, double, std::optional<std::string>, byte_string, time_point>>(
+		    db, db->connection, "SELECT id, count, amount, label, payload, at FROM item ORDER BY id");
+		return repeat([s] { (*s)(); });
+	});
+
+	suite.add("postgresql/live/select/point_prepared", 1u, [connection_info] {
+		struct fixture final
+		{
+			live_database      db;
+			prepared_statement select;
+			std::int64_t       id;
+			double             amount;
+
+			explicit fixture(const std::string& connection_info)
+			    : db{ connection_info }
+			    , select{ db.connection, "SELECT amount FROM item WHERE id = :id" }
+			    , id{}
+			    , amount{}
+			{
+				this->select.bind_ref("id", this->id).bind_results(this->amount);
+			}
+		};
+
+		auto f = std::make_shared<fixture>(connection_info);
+		return repeat([f] {
+			f->id = f->id % static_cast<std::int64_t>(dataset_size) + 1;
+			f->select.execute();
+			if (!f->select.fetch())
+			{
+				throw std::runtime_error{ "row not found" };
+			}
+			do_not_optimize(f->amount);
+		});
+	});
+
+	suite.add("postgresql/live/upsert/batch_in_transaction", dataset_size, [connection_info] {
+		auto db     = std::make_shared<live_database>(connection_info);
+		auto items  = std::make_shared<std::vector<item>>(make_dataset());
+		auto upsert = std::make_shared<prepared_statement>(db->connection, upsert_query);
+		return repeat([db, items, upsert] {
+			transaction tr{ db->connection };
+			upsert->execute_batch(*items);
+			tr.commit();
+		});
+	});
+}
+
+} // namespace
+
+void add_postgresql_benchmarks(suite& suite, const options& options)
+{
+	add_translation_benchmarks(suite);
+	add_binding_benchmarks(suite);
+	add_decoding_benchmarks(suite);
+	add_resultset_benchmarks(suite);
+
+	if (options.postgresql)
+	{
+		add_live_benchmarks(suite, options.postgresql.value());
+	}
+}
+
+} // namespace bench
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,365 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// End to end runs against an in-memory SQLite database, including the work done by SQLite itself, and reads that
+// scale over threads against a database file
+
+#include "benchmark.h"
+#include "dataset.h"
+
+#include "zoo/squid/sqlite3/backendconnectionfactory.h"
+#include "zoo/squid/sqlite3/connection.h"
+#include "zoo/squid/core/columnbatch.h"
+#include "zoo/squid/core/connectionpool.h"
+#include "zoo/squid/core/preparedstatement.h"
+#include "zoo/squid/core/statement.h"
+#include "zoo/squid/core/transaction.h"
+
+#include <atomic>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+namespace bench {
+
+namespace {
+
+// An in-memory database with the item table filled from the dataset
+struct database final
+{
+	sqlite::connection connection;
+
+	database()
+	    : connection{ ":memory:" }
+	{
+		this->connection.execute(
+		    "CREATE TABLE item (id INTEGER PRIMARY KEY, count INTEGER NOT NULL, amount REAL NOT NULL, label TEXT, payload BLOB NOT NULL, "
+		    "at TEXT NOT NULL)");
+
+		transaction        tr{ this->connection };
+		prepared_statement insert{ this->connection,
+			                       "INSERT INTO item (id, count, amount, label, payload, at) VALUES (:id, :count, :amount, :label, :payload, :at)" };
+		for (const auto& it : make_dataset())
+		{
+			insert.bind_execute(
+			    { { "id", it.id }, { "count", it.count }, { "amount", it.amount }, { "label", it.label }, { "payload", it.payload }, { "at", it.at } });
+		}
+		tr.commit();
+	}
+};
+
+// Executes a query and fetches all of its rows into the bound results
+template<typename... Results>
+struct scan final
+{
+	bench::database        db;
+	prepared_statement     select;
+	std::tuple<Results...> values;
+
+	explicit scan(std::string_view query)
+	    : db{}
+	    , select{ this->db.connection, query }
+	    , values{}
+	{
+		std::apply([this](auto&... value) { this->select.bind_results(value...); }, this->values);
+	}
+
+	void operator()()
+	{
+		this->select.execute();
+		auto rows = std::size_t{};
+		while (this->select.fetch())
+		{
+			do_not_optimize(this->values);
+			++rows;
+		}
+		if (rows != dataset_size)
+		{
+			throw std::runtime_error{ "unexpected number of rows" };
+		}
+	}
+};
+
+template<typename... Results>
+void add_scan(suite& suite, std::string name, std::string query)
+{
+	suite.add("sqlite/scan/" + std::move(name), dataset_size, [query = std::move(query)] {
+		auto s = std::make_shared<scan<Results...>>(query);
+		return repeat([s] { (*s)(); });
+	});
+}
+
+void add_scan_benchmarks(suite& suite)
+{
+	add_scan<std::int64_t>(suite, "int64", "SELECT count FROM item");
+	add_scan<double>(suite, "double", "SELECT amount FROM item");
+	add_scan<std::optional<std::string>>(suite, "text", "SELECT label FROM item");
+	add_scan<byte_string>(suite, "blob", "SELECT payload FROM item");
+	add_scan<time_point>(suite, "timestamp", "SELECT at FROM item");
+	add_scan<std::int64_t, std::int64_t, double, std::optional<std::string>, byte_string, time_point>(
+	    suite, "all_columns", "SELECT id, count, amount, label, payload, at FROM item");
+
+	suite.add("sqlite/scan/fetch_columns", dataset_size, [] {
+		auto db     = std::make_shared<database>();
+		auto select = std::make_shared<prepared_statement>(db->connection, "SELECT id, amount, label FROM item");
+		auto batch  = std::make_shared<column_batch>(column_batch{ column_type::int64, column_type::float64, column_type::text });
+		return repeat([db, select, batch] {
+			select->execute();
+			auto rows = std::size_t{};
+			while (const auto n = select->fetch_columns(*batch, 256u))
+			{
+				do_not_optimize(batch->column(0).int64_values().data());
+				rows += n;
+			}
+			if (rows != dataset_size)
+			{
+				throw std::runtime_error{ "unexpected number of rows" };
+			}
+		});
+	});
+}
+
+void add_statement_benchmarks(suite& suite)
+{
+	suite.add("sqlite/select/point_prepared", 1u, [] {
+		struct fixture final
+		{
+			bench::database    db;
+			prepared_statement select;
+			std::int64_t       id;
+			std::int64_t       count;
+			double             amount;
+
+			fixture()
+			    : db{}
+			    , select{ db.connection, "SELECT count, amount FROM item WHERE id = :id" }
+			    , id{}
+			    , count{}
+			    , amount{}
+			{
+				this->select.bind_ref("id", this->id).bind_results(this->count, this->amount);
+			}
+		};
+
+		auto f = std::make_shared<fixture>();
+		return repeat([f] {
+			f->id = f->id % static_cast<std::int64_t>(dataset_size) + 1;
+			f->select.execute();
+			if (!f->select.fetch())
+			{
+				throw std::runtime_error{ "row not found" };
+			}
+			do_not_optimize(f->amount);
+		});
+	});
+
+	suite.add("sqlite/select/point_one_off", 1u, [] {
+		auto db = std::make_shared<database>();
+		auto id = std::make_shared<std::int64_t>();
+		return repeat([db, id] {
+			*id = *id % static_cast<std::int64_t>(dataset_size) + 1;
+
+			double    amount{};
+			statement select{ db->connection, "SELECT amount FROM item WHERE id = :id" };
+			select.bind("id", *id).bind_results(amount);
+			select.execute();
+			select.fetch();
+			do_not_optimize(amount);
+		});
+	});
+
+	// Replaces the rows of the dataset over and over, so that the table does not grow with the iteration count
+	suite.add("sqlite/upsert/prepared", 1u, [] {
+		auto db     = std::make_shared<database>();
+		auto items  = std::make_shared<std::vector<item>>(make_dataset());
+		auto upsert = std::make_shared<prepared_statement>(
+		    db->connection,
+		    "INSERT OR REPLACE INTO item (id, count, amount, label, payload, at) VALUES (:id, :count, :amount, :label, :payload, :at)");
+		auto index = std::make_shared<std::size_t>();
+		return repeat([upsert, items, index, db] {
+			const auto& it = (*items)[(*index)++ % items->size()];
+			upsert->bind_execute(
+			    { { "id", it.id }, { "count", it.count }, { "amount", it.amount }, { "label", it.label }, { "payload", it.payload }, { "at", it.at } });
+		});
+	});
+
+	suite.add("sqlite/upsert/batch_in_transaction", dataset_size, [] {
+		auto db     = std::make_shared<database>();
+		auto items  = std::make_shared<std::vector<item>>(make_dataset());
+		auto upsert = std::make_shared<prepared_statement>(
+		    db->connection,
+		    "INSERT OR REPLACE INTO item (id, count, amount, label, payload, at) VALUES (:id, :count, :amount, :label, :payload, :at)");
+		return repeat([upsert, items, db] {
+			transaction tr{ db->connection };
+			upsert->execute_batch(*items);
+			tr.commit();
+		});
+	});
+}
+
+// Point reads from a pool of read-only connections to a WAL database file, spread over a number of reader threads,
+// while a writer thread keeps inserting rows through a connection of its own
+class read_scaling final
+{
+	static constexpr auto row_count = std::int64_t{ 100000 };
+
+	std::string       path_;
+	std::size_t       readers_;
+	connection_pool   pool_;
+	std::atomic<bool> stop_;
+	std::thread       writer_;
+
+	static void remove_database(const std::string& path)
+	{
+		for (const auto suffix : { "", "-wal", "-shm" })
+		{
+			std::filesystem::remove(path + suffix);
+		}
+	}
+
+	static std::string create_database()
+	{
+		const auto path = (std::filesystem::temp_directory_path() / "zoo_squid_bench_read_scaling.db").string();
+		remove_database(path);
+
+		sqlite::connection connection{ path, sqlite::connection_options::tuned() };
+		connection.execute("CREATE TABLE item (id INTEGER PRIMARY KEY, name TEXT NOT NULL, value REAL NOT NULL)");
+
+		transaction        tr{ connection };
+		prepared_statement insert{ connection, "INSERT INTO item (id, name, value) VALUES (:id, :name, :value)" };
+		for (auto id = std::int64_t{ 1 }; id <= row_count; ++id)
+		{
+			insert.bind("id", id).bind("name", "item " + std::to_string(id)).bind("value", static_cast<double>(id) / 3);
+			insert.execute();
+		}
+		tr.commit();
+
+		return path;
+	}
+
+	static sqlite::connection_options read_only()
+	{
+		auto options      = sqlite::connection_options::tuned();
+		options.read_only = true;
+		return options;
+	}
+
+	void write()
+	{
+		sqlite::connection connection{ this->path_, sqlite::connection_options::tuned() };
+		prepared_statement insert{ connection, "INSERT INTO item (name, value) VALUES (:name, :value)" };
+		while (!this->stop_.load(std::memory_order_relaxed))
+		{
+			insert.bind("name", "new item").bind("value", 1.0);
+			insert.execute();
+		}
+	}
+
+	void read(std::uint64_t reads, std::uint64_t seed)
+	{
+		connection         connection{ this->pool_ };
+		prepared_statement select{ connection, "SELECT name, value FROM item WHERE id = :id" };
+
+		auto        id = std::int64_t{};
+		std::string name{};
+		double      value{};
+		select.bind_ref("id", id).bind_results(name, value);
+
+		auto state = seed * 6364136223846793005u + 1u;
+		for (; reads != 0u; --reads)
+		{
+			state = state * 6364136223846793005u + 1442695040888963407u;
+			id    = static_cast<std::int64_t>((state >> 33) % row_count) + 1;
+			select.execute();
+			if (!select.fetch())
+			{
+				throw std::runtime_error{ "row " + std::to_string(id) + " not found" };
+			}
+			do_not_optimize(value);
+		}
+	}
+
+public:
+	explicit read_scaling(std::size_t readers)
+	    : path_{ create_database() }
+	    , readers_{ readers }
+	    , pool_{ sqlite::backend_connection_factory{ read_only() }, this->path_, readers }
+	    , stop_{ false }
+	    , writer_{ [this] { this->write(); } }
+	{
+	}
+
+	~read_scaling() noexcept
+	{
+		this->stop_ = true;
+		this->writer_.join();
+	}
+
+	read_scaling(const read_scaling&)            = delete;
+	read_scaling& operator=(const read_scaling&) = delete;
+
+	// Perform @a iterations reads, divided over the reader threads
+	void operator()(std::uint64_t iterations)
+	{
+		std::vector<std::exception_ptr> errors(this->readers_);
+		{
+			std::vector<std::jthread> threads{};
+			for (auto i = std::size_t{}; i < this->readers_; ++i)
+			{
+				const auto reads = iterations / this->readers_ + (i < iterations % this->readers_ ? 1u : 0u);
+				threads.emplace_back([this, reads, i, &errors] {
+					try
+					{
+						this->read(reads, i);
+					}
+					catch (...)
+					{
+						errors[i] = std::current_exception();
+					}
+				});
+			}
+		}
+		for (const auto& e : errors)
+		{
+			if (e)
+			{
+				std::rethrow_exception(e);
+			}
+		}
+	}
+};
+
+void add_read_scaling_benchmarks(suite& suite)
+{
+	for (const auto readers : { 1u, 2u, 4u, 8u })
+	{
+		suite.add("sqlite/read_scaling/readers_" + std::to_string(readers), 1u, [readers]() -> operation {
+			auto r = std::make_shared<read_scaling>(readers);
+			return [r](std::uint64_t iterations) { (*r)(iterations); };
+		});
+	}
+}
+
+} // namespace
+
+void add_sqlite_benchmarks(suite& suite)
+{
+	add_scan_benchmarks(suite);
+	add_statement_benchmarks(suite);
+	add_read_scaling_benchmarks(suite);
+}
+
+} // namespace bench
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,305 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "syntheticpqapi.h"
+
+namespace zoo {
+namespace squid {
+namespace bench {
+
+synthetic_pq_api::synthetic_pq_api(table result)
+    : table_{ std::move(result) }
+    , affected_rows_{ std::to_string(this->table_.rows.size()) }
+    , connection_{}
+    , tuples_result_{}
+    , command_result_{}
+{
+}
+
+synthetic_pq_api::~synthetic_pq_api()
+{
+}
+
+PGconn* synthetic_pq_api::connection()
+{
+	return reinterpret_cast<PGconn*>(&this->connection_);
+}
+
+PGresult* synthetic_pq_api::tuples_result()
+{
+	return reinterpret_cast<PGresult*>(&this->tuples_result_);
+}
+
+PGresult* synthetic_pq_api::command_result()
+{
+	return reinterpret_cast<PGresult*>(&this->command_result_);
+}
+
+const synthetic_pq_api::table& synthetic_pq_api::table_of(const PGresult* res) const
+{
+	static const table empty{};
+	return res == reinterpret_cast<const PGresult*>(&this->tuples_result_) ? this->table_ : empty;
+}
+
+void synthetic_pq_api::clear(PGresult*)
+{
+}
+
+const char* synthetic_pq_api::cmdTuples(PGresult* res)
+{
+	return res == this->tuples_result() ? this->affected_rows_.c_str() : "";
+}
+
+PGconn* synthetic_pq_api::connectdb(const char*)
+{
+	return this->connection();
+}
+
+int synthetic_pq_api::isBusy(PGconn*)
+{
+	return 0;
+}
+
+int synthetic_pq_api::consumeInput(PGconn*)
+{
+	return 1;
+}
+
+const char* synthetic_pq_api::errorMessage(const PGconn*)
+{
+	return "";
+}
+
+PGresult* synthetic_pq_api::exec(PGconn*, const char*)
+{
+	return this->command_result();
+}
+
+PGresult* synthetic_pq_api::execParams(PGconn*, const char*, int, const Oid*, const char* const*, const int*, const int*, int)
+{
+	return this->tuples_result();
+}
+
+PGresult* synthetic_pq_api::execPrepared(PGconn*, const char*, int, const char* const*, const int*, const int*, int)
+{
+	return this->tuples_result();
+}
+
+void synthetic_pq_api::finish(PGconn*)
+{
+}
+
+const char* synthetic_pq_api::fname(const PGresult* res, int field_num)
+{
+	return this->table_of(res).columns[static_cast<std::size_t>(field_num)].c_str();
+}
+
+void synthetic_pq_api::freemem(void*)
+{
+}
+
+int synthetic_pq_api::getisnull(const PGresult* res, int tup_num, int field_num)
+{
+	return this->table_of(res).rows[static_cast<std::size_t>(tup_num)][static_cast<std::size_t>(field_num)] ? 0 : 1;
+}
+
+const char* synthetic_pq_api::getvalue(const PGresult* res, int tup_num, int field_num)
+{
+	const auto& value = this->table_of(res).rows[static_cast<std::size_t>(tup_num)][static_cast<std::size_t>(field_num)];
+	return value ? value->c_str() : "";
+}
+
+int synthetic_pq_api::nfields(const PGresult* res)
+{
+	return static_cast<int>(this->table_of(res).columns.size());
+}
+
+PGnotify* synthetic_pq_api::notifies(PGconn*)
+{
+	return nullptr;
+}
+
+int synthetic_pq_api::ntuples(const PGresult* res)
+{
+	return static_cast<int>(this->table_of(res).rows.size());
+}
+
+PGresult* synthetic_pq_api::prepare(PGconn*, const char*, const char*, int, const Oid*)
+{
+	return this->command_result();
+}
+
+void synthetic_pq_api::reset(PGconn*)
+{
+}
+
+const char* synthetic_pq_api::resStatus(ExecStatusType)
+{
+	return "";
+}
+
+const char* synthetic_pq_api::resultErrorField(const PGresult*, int)
+{
+	return nullptr;
+}
+
+const char* synthetic_pq_api::resultErrorMessage(const PGresult*)
+{
+	return "";
+}
+
+ExecStatusType synthetic_pq_api::resultStatus(const PGresult* res)
+{
+	return res == this->tuples_result() ? PGRES_TUPLES_OK : PGRES_COMMAND_OK;
+}
+
+int synthetic_pq_api::socket(const PGconn*)
+{
+	return -1;
+}
+
+ConnStatusType synthetic_pq_api::status(const PGconn*)
+{
+	return CONNECTION_OK;
+}
+
+int synthetic_pq_api::setnonblocking(PGconn*, int)
+{
+	return 0;
+}
+
+int synthetic_pq_api::flush(PGconn*)
+{
+	return 0;
+}
+
+PGresult* synthetic_pq_api::getResult(PGconn*)
+{
+	return nullptr;
+}
+
+int synthetic_pq_api::sendQueryParams(PGconn*, const char*, int, const Oid*, const char* const*, const int*, const int*, int)
+{
+	return 0;
+}
+
+int synthetic_pq_api::sendPrepare(PGconn*, const char*, const char*, int, const Oid*)
+{
+	return 0;
+}
+
+int synthetic_pq_api::sendQueryPrepared(PGconn*, const char*, int, const char* const*, const int*, const int*, int)
+{
+	return 0;
+}
+
+int synthetic_pq_api::putCopyData(PGconn*, const char*, int)
+{
+	return -1;
+}
+
+int synthetic_pq_api::putCopyEnd(PGconn*, const char*)
+{
+	return -1;
+}
+
+int synthetic_pq_api::getCopyData(PGconn*, char**, int)
+{
+	return -2;
+}
+
+int synthetic_pq_api::setSingleRowMode(PGconn*)
+{
+	return 0;
+}
+
+Oid synthetic_pq_api::lo_create(PGconn*, Oid)
+{
+	return InvalidOid;
+}
+
+int synthetic_pq_api::lo_open(PGconn*, Oid, int)
+{
+	return -1;
+}
+
+int synthetic_pq_api::lo_close(PGconn*, int)
+{
+	return -1;
+}
+
+int synthetic_pq_api::lo_read(PGconn*, int, char*, size_t)
+{
+	return -1;
+}
+
+int synthetic_pq_api::lo_write(PGconn*, int, const char*, size_t)
+{
+	return -1;
+}
+
+pg_int64 synthetic_pq_api::lo_lseek64(PGconn*, int, pg_int64, int)
+{
+	return -1;
+}
+
+int synthetic_pq_api::lo_truncate64(PGconn*, int, pg_int64)
+{
+	return -1;
+}
+
+int synthetic_pq_api::lo_unlink(PGconn*, Oid)
+{
+	return -1;
+}
+
+PGcancel* synthetic_pq_api::getCancel(PGconn*)
+{
+	return nullptr;
+}
+
+int synthetic_pq_api::cancel(PGcancel*, char*, int)
+{
+	return 0;
+}
+
+void synthetic_pq_api::freeCancel(PGcancel*)
+{
+}
+
+#ifdef LIBPQ_HAS_CHUNK_MODE
+int synthetic_pq_api::setChunkedRowsMode(PGconn*, int)
+{
+	return 0;
+}
+#endif
+
+#ifdef LIBPQ_HAS_PIPELINING
+int synthetic_pq_api::enterPipelineMode(PGconn*)
+{
+	return 0;
+}
+
+int synthetic_pq_api::exitPipelineMode(PGconn*)
+{
+	return 0;
+}
+
+int synthetic_pq_api::pipelineSync(PGconn*)
+{
+	return 0;
+}
+#endif
+
+PGTransactionStatusType synthetic_pq_api::transactionStatus(const PGconn*)
+{
+	return PQTRANS_IDLE;
+}
+
+} // namespace bench
+} // namespace squid
+} // namespace zoo
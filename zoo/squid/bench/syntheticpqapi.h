@@ -0,0 +1,145 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/postgresql/detail/ipqapi.h"
+
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+namespace bench {
+
+/// A libpq API that answers every query with the same synthetic result set, without a server.
+/// The gmock based pq_api_mock matches expectations on every call, which would cost more than the code that is measured,
+/// so this API does nothing but plain lookups. That isolates the client side CPU cost of the PostgreSQL backend.
+class synthetic_pq_api final : public postgresql::ipq_api
+{
+public:
+	/// A result set in the text format of libpq, a null value is std::nullopt
+	struct table final
+	{
+		std::vector<std::string>                             columns;
+		std::vector<std::vector<std::optional<std::string>>> rows;
+	};
+
+private:
+	table       table_;
+	std::string affected_rows_;
+
+	// Only the addresses are used, as the handles that are given to the backend
+	char connection_;
+	char tuples_result_;
+	char command_result_;
+
+	PGconn*   connection();
+	PGresult* tuples_result();
+	PGresult* command_result();
+
+	const table& table_of(const PGresult* res) const;
+
+public:
+	/// Every execution of a statement returns @a result, other commands return an empty command result
+	explicit synthetic_pq_api(table result);
+	~synthetic_pq_api() override;
+
+	synthetic_pq_api(synthetic_pq_api&&)      = delete;
+	synthetic_pq_api(const synthetic_pq_api&) = delete;
+
+	synthetic_pq_api& operator=(synthetic_pq_api&&)      = delete;
+	synthetic_pq_api& operator=(const synthetic_pq_api&) = delete;
+
+	void           clear(PGresult* res) override;
+	const char*    cmdTuples(PGresult* res) override;
+	PGconn*        connectdb(const char* conninfo) override;
+	int            isBusy(PGconn* conn) override;
+	int            consumeInput(PGconn* conn) override;
+	const char*    errorMessage(const PGconn* conn) override;
+	PGresult*      exec(PGconn* conn, const char* query) override;
+	PGresult*      execParams(PGconn*            conn,
+	                          const char*        command,
+	                          int                nParams,
+	                          const Oid*         paramTypes,
+	                          const char* const* paramValues,
+	                          const int*         paramLengths,
+	                          const int*         paramFormats,
+	                          int                resultFormat) override;
+	PGresult*      execPrepared(PGconn*            conn,
+	                            const char*        stmtName,
+	                            int                nParams,
+	                            const char* const* paramValues,
+	                            const int*         paramLengths,
+	                            const int*         paramFormats,
+	                            int                resultFormat) override;
+	void           finish(PGconn* conn) override;
+	const char*    fname(const PGresult* res, int field_num) override;
+	void           freemem(void* ptr) override;
+	int            getisnull(const PGresult* res, int tup_num, int field_num) override;
+	const char*    getvalue(const PGresult* res, int tup_num, int field_num) override;
+	int            nfields(const PGresult* res) override;
+	PGnotify*      notifies(PGconn* conn) override;
+	int            ntuples(const PGresult* res) override;
+	PGresult*      prepare(PGconn* conn, const char* stmtName, const char* query, int nParams, const Oid* paramTypes) override;
+	void           reset(PGconn* conn) override;
+	const char*    resStatus(ExecStatusType status) override;
+	const char*    resultErrorField(const PGresult* res, int fieldcode) override;
+	const char*    resultErrorMessage(const PGresult* res) override;
+	ExecStatusType resultStatus(const PGresult* res) override;
+	int            socket(const PGconn* conn) override;
+	ConnStatusType status(const PGconn* conn) override;
+	int            setnonblocking(PGconn* conn, int arg) override;
+	int            flush(PGconn* conn) override;
+	PGresult*      getResult(PGconn* conn) override;
+	int            sendQueryParams(PGconn*            conn,
+	                               const char*        command,
+	                               int                nParams,
+	                               const Oid*         paramTypes,
+	                               const char* const* paramValues,
+	                               const int*         paramLengths,
+	                               const int*         paramFormats,
+	                               int                resultFormat) override;
+	int            sendPrepare(PGconn* conn, const char* stmtName, const char* query, int nParams, const Oid* paramTypes) override;
+	int            sendQueryPrepared(PGconn*            conn,
+	                                 const char*        stmtName,
+	                                 int                nParams,
+	                                 const char* const* paramValues,
+	                                 const int*         paramLengths,
+	                                 const int*         paramFormats,
+	                                 int                resultFormat) override;
+	int            putCopyData(PGconn* conn, const char* buffer, int nbytes) override;
+	int            putCopyEnd(PGconn* conn, const char* errormsg) override;
+	int            getCopyData(PGconn* conn, char** buffer, int async) override;
+	int            setSingleRowMode(PGconn* conn) override;
+	Oid            lo_create(PGconn* conn, Oid lobjId) override;
+	int            lo_open(PGconn* conn, Oid lobjId, int mode) override;
+	int            lo_close(PGconn* conn, int fd) override;
+	int            lo_read(PGconn* conn, int fd, char* buf, size_t len) override;
+	int            lo_write(PGconn* conn, int fd, const char* buf, size_t len) override;
+	pg_int64       lo_lseek64(PGconn* conn, int fd, pg_int64 offset, int whence) override;
+	int            lo_truncate64(PGconn* conn, int fd, pg_int64 len) override;
+	int            lo_unlink(PGconn* conn, Oid lobjId) override;
+	PGcancel*      getCancel(PGconn* conn) override;
+	int            cancel(PGcancel* cancel, char* errbuf, int errbufsize) override;
+	void           freeCancel(PGcancel* cancel) override;
+#ifdef LIBPQ_HAS_CHUNK_MODE
+	int            setChunkedRowsMode(PGconn* conn, int chunkSize) override;
+#endif
+#ifdef LIBPQ_HAS_PIPELINING
+	int            enterPipelineMode(PGconn* conn) override;
+	int            exitPipelineMode(PGconn* conn) override;
+	int            pipelineSync(PGconn* conn) override;
+#endif
+
+	PGTransactionStatusType transactionStatus(const PGconn* conn) override;
+};
+
+} // namespace bench
+} // namespace squid
+} // namespace zoo
@@ -7,34 +7,172 @@
 
 #include "zoo/squid/core/basicstatement.h"
 #include "zoo/squid/core/ibackendstatement.h"
+#include "zoo/squid/core/ibackendconnection.h"
 
 #include "zoo/common/misc/throw_exception.h"
 
+#include <algorithm>
 #include <cassert>
+#include <iterator>
+#include <ranges>
 
 namespace zoo {
 namespace squid {
 
+namespace {
+
+// Run @a call, a call of the backend statement on @a connection, within @a deadline and the deadline of
+// a transaction on @a connection
+template<typename Call>
+auto run_within_deadline(const std::shared_ptr<ibackend_connection>& connection, const std::optional<deadline>& deadline, Call&& call)
+{
+	if ((deadline && deadline->expired()) || deadline_guard::expired(*connection))
+	{
+		ZOO_THROW_EXCEPTION(deadline_exceeded{});
+	}
+
+	std::optional<deadline_guard> guard{};
+	if (deadline)
+	{
+		guard.emplace(connection, deadline.value());
+	}
+
+	try
+	{
+		return call();
+	}
+	catch (const std::exception&)
+	{
+		if ((guard && guard->expired()) || deadline_guard::expired(*connection))
+		{
+			ZOO_THROW_EXCEPTION(deadline_exceeded{});
+		}
+		throw;
+	}
+}
+
+} // namespace
+
 basic_statement::basic_statement(std::shared_ptr<ibackend_connection> connection, std::unique_ptr<ibackend_statement>&& statement)
     : parameters_{}
+    , positional_parameters_{}
+    , plan_{}
     , results_{}
     , named_results_{}
     , connection_{ connection }
     , statement_{ std::move(statement) }
+    , query_{}
+    , fetch_mode_{ fetch_mode::buffered }
+    , positional_batch_{}
+    , batch_plan_{}
+    , batch_size_{}
+    , described_type_{}
+    , described_slots_{}
+    , deadline_{}
+    , timeout_{}
 {
+	this->adopt_binding_plan();
 }
 
 basic_statement::basic_statement(std::shared_ptr<ibackend_connection> connection)
     : parameters_{}
+    , positional_parameters_{}
+    , plan_{}
     , results_{}
     , named_results_{}
     , connection_{ connection }
     , statement_{}
+    , query_{}
+    , fetch_mode_{ fetch_mode::buffered }
+    , positional_batch_{}
+    , batch_plan_{}
+    , batch_size_{}
+    , described_type_{}
+    , described_slots_{}
+    , deadline_{}
+    , timeout_{}
 {
 }
 
+void basic_statement::store_parameter(std::string_view name, parameter&& value)
+{
+	if (this->plan_)
+	{
+		// Parameters that do not occur in the query are ignored, as they would be when bound by name.
+		if (const auto index = this->plan_->index_of(name))
+		{
+			this->positional_parameters_[index.value()] = std::move(value);
+		}
+	}
+	else
+	{
+		this->parameters_.insert_or_assign(std::string{ name }, std::move(value));
+	}
+}
+
+const std::vector<std::optional<std::size_t>>* basic_statement::described_slots(const void* type_key, std::span<const std::string_view> names)
+{
+	if (!this->plan_)
+	{
+		return nullptr;
+	}
+
+	if (this->described_type_ != type_key)
+	{
+		this->described_slots_.clear();
+		for (const auto name : names)
+		{
+			this->described_slots_.push_back(this->plan_->index_of(name));
+		}
+		this->described_type_ = type_key;
+	}
+
+	return &this->described_slots_;
+}
+
+void basic_statement::clear_parameters()
+{
+	this->parameters_.clear();
+	std::fill(this->positional_parameters_.begin(), this->positional_parameters_.end(), std::nullopt);
+}
+
+void basic_statement::adopt_binding_plan()
+{
+	this->described_type_ = nullptr; // the positions were resolved against the previous plan
+	this->plan_ = this->statement_ ? this->statement_->parameter_binding_plan() : nullptr;
+	if (this->plan_)
+	{
+		this->positional_parameters_.assign(this->plan_->size(), std::nullopt);
+		for (auto& pair : this->parameters_)
+		{
+			if (const auto index = this->plan_->index_of(pair.first))
+			{
+				this->positional_parameters_[index.value()] = std::move(pair.second);
+			}
+		}
+		this->parameters_.clear();
+	}
+}
+
+void basic_statement::drop_binding_plan()
+{
+	if (this->plan_)
+	{
+		for (std::size_t index = 0; index < this->positional_parameters_.size(); ++index)
+		{
+			if (auto& value = this->positional_parameters_[index])
+			{
+				this->parameters_.insert_or_assign(this->plan_->name(index), std::move(value.value()));
+			}
+		}
+		this->positional_parameters_.clear();
+		this->plan_ = nullptr;
+	}
+}
+
 std::ostream& basic_statement::query()
 {
+	this->drop_binding_plan();
 	this->statement_.reset();
 	if (this->query_)
 	{
@@ -56,7 +194,7 @@ basic_statement& basic_statement::bind(std::string_view name, const unsigned cha
 	return *this;
 }
 
-void basic_statement::execute()
+void basic_statement::create_statement_if_needed()
 {
 	if (!this->statement_)
 	{
@@ -67,48 +205,174 @@ void basic_statement::execute()
 		else
 		{
 			this->statement_ = this->create_statement(this->connection_, this->query_.value().str());
+			if (this->fetch_mode_ != fetch_mode::buffered)
+			{
+				this->statement_->set_fetch_mode(this->fetch_mode_);
+			}
+			this->adopt_binding_plan();
 		}
 	}
+}
+
+void basic_statement::execute()
+{
+	this->create_statement_if_needed();
 
 	if (!this->results_.empty() && !this->named_results_.empty())
 	{
 		ZOO_THROW_EXCEPTION(error{ "Named result binding cannot be combined with sequential result binding" });
 	}
-	if (!this->named_results_.empty())
-	{
-		this->statement_->execute(this->parameters_, this->named_results_);
-	}
-	else
-	{
-		this->statement_->execute(this->parameters_, this->results_);
-	}
+	run_within_deadline(this->connection_, this->call_deadline(), [this] {
+		if (this->plan_)
+		{
+			if (!this->named_results_.empty())
+			{
+				this->statement_->execute_positional(this->positional_parameters_, this->named_results_);
+			}
+			else
+			{
+				this->statement_->execute_positional(this->positional_parameters_, this->results_);
+			}
+		}
+		else if (!this->named_results_.empty())
+		{
+			this->statement_->execute(this->parameters_, this->named_results_);
+		}
+		else
+		{
+			this->statement_->execute(this->parameters_, this->results_);
+		}
+	});
 }
 
 void basic_statement::bind_execute(std::initializer_list<std::pair<std::string_view, parameter_by_value>> params)
 {
-	this->parameters_.clear();
+	this->clear_parameters();
 	for (auto&& pair : params)
 	{
-		this->parameters_.insert_or_assign(std::string{ pair.first }, std::move(pair.second));
+		this->store_parameter(pair.first, parameter{ pair.second });
 	}
 	this->execute();
 }
 
 void basic_statement::bind_ref_execute(std::initializer_list<std::pair<std::string_view, parameter_by_reference>> params)
 {
-	this->parameters_.clear();
+	this->clear_parameters();
 	for (auto&& pair : params)
 	{
-		this->parameters_.insert_or_assign(std::string{ pair.first }, std::move(pair.second));
+		this->store_parameter(pair.first, parameter{ pair.second });
 	}
 	this->execute();
 }
 
+void basic_statement::begin_batch()
+{
+	this->create_statement_if_needed();
+	this->batch_size_ = 0;
+}
+
+void basic_statement::add_batch_row()
+{
+	// Assign to the existing entries to reuse their storage from a previous batch
+	if (this->batch_size_ == this->positional_batch_.size())
+	{
+		this->positional_batch_.emplace_back();
+	}
+	auto& row = this->positional_batch_[this->batch_size_];
+
+	if (this->plan_)
+	{
+		row = this->positional_parameters_;
+	}
+	else
+	{
+		// Without a plan of the backend, the rows are stored by position in a plan of the bound names, which every row
+		// of a batch normally shares with the previous batch. A row that binds fewer names leaves the others empty.
+		if (this->batch_size_ == 0u && !std::ranges::equal(this->batch_plan_.names(), this->parameters_ | std::views::keys))
+		{
+			auto names = std::vector<std::string>{};
+			names.reserve(this->parameters_.size());
+			std::ranges::copy(this->parameters_ | std::views::keys, std::back_inserter(names));
+			this->batch_plan_ = binding_plan{ std::move(names) };
+		}
+
+		row.assign(this->batch_plan_.size(), std::nullopt);
+		for (const auto& pair : this->parameters_)
+		{
+			auto index = this->batch_plan_.index_of(pair.first);
+			if (!index)
+			{
+				auto names = this->batch_plan_.names();
+				names.push_back(pair.first);
+				this->batch_plan_ = binding_plan{ std::move(names) };
+				index             = this->batch_plan_.size() - 1u;
+				row.resize(this->batch_plan_.size());
+			}
+			row[index.value()] = pair.second;
+		}
+	}
+	++this->batch_size_;
+}
+
+std::uint64_t basic_statement::run_batch()
+{
+	const auto size   = this->batch_size_;
+	this->batch_size_ = 0;
+
+	return run_within_deadline(this->connection_, this->call_deadline(), [this, size] {
+		if (this->plan_)
+		{
+			return this->statement_->execute_batch_positional({ this->positional_batch_.data(), size });
+		}
+		else
+		{
+			return this->statement_->execute_batch_named(this->batch_plan_, { this->positional_batch_.data(), size });
+		}
+	});
+}
+
+basic_statement& basic_statement::set_fetch_mode(fetch_mode mode)
+{
+	this->fetch_mode_ = mode;
+	if (this->statement_)
+	{
+		this->statement_->set_fetch_mode(mode);
+	}
+	return *this;
+}
+
+basic_statement& basic_statement::set_deadline(const std::optional<deadline>& deadline)
+{
+	this->deadline_ = deadline;
+	return *this;
+}
+
+basic_statement& basic_statement::set_timeout(const std::optional<std::chrono::milliseconds>& timeout)
+{
+	this->timeout_ = timeout;
+	return *this;
+}
+
+std::optional<deadline> basic_statement::call_deadline() const
+{
+	if (this->timeout_)
+	{
+		const auto timeout_deadline = deadline::after(this->timeout_.value());
+		return this->deadline_ ? std::min(this->deadline_.value(), timeout_deadline) : timeout_deadline;
+	}
+	return this->deadline_;
+}
+
 bool basic_statement::fetch()
 {
 	if (this->statement_)
 	{
-		return this->statement_->fetch();
+		// Buffered rows are fetched without a round trip
+		if (this->fetch_mode_ == fetch_mode::buffered)
+		{
+			return this->statement_->fetch();
+		}
+		return run_within_deadline(this->connection_, this->call_deadline(), [this] { return this->statement_->fetch(); });
 	}
 	else
 	{
@@ -116,6 +380,25 @@ bool basic_statement::fetch()
 	}
 }
 
+std::size_t basic_statement::fetch_columns(column_batch& batch, std::size_t batch_size)
+{
+	if (!this->statement_)
+	{
+		ZOO_THROW_EXCEPTION(error{ "No statement has been created" });
+	}
+	if (batch_size == 0u)
+	{
+		ZOO_THROW_EXCEPTION(error{ "Batch size must be greater than 0" });
+	}
+	batch.clear();
+	batch.reserve(batch_size);
+	const auto rows = this->fetch_mode_ == fetch_mode::buffered
+	                      ? this->statement_->fetch_columns(batch, batch_size)
+	                      : run_within_deadline(this->connection_, this->call_deadline(), [&] { return this->statement_->fetch_columns(batch, batch_size); });
+	batch.set_rows(rows);
+	return rows;
+}
+
 std::size_t basic_statement::field_count()
 {
 	if (!this->statement_)
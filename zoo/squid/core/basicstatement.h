@@ -11,7 +11,12 @@
 #include "zoo/squid/core/parameter.h"
 #include "zoo/squid/core/result.h"
 #include "zoo/squid/core/error.h"
+#include "zoo/squid/core/fetchmode.h"
+#include "zoo/squid/core/bindingplan.h"
+#include "zoo/squid/core/columnbatch.h"
+#include "zoo/squid/core/deadline.h"
 
+#include "zoo/squid/core/detail/describedbinding.h"
 #include "zoo/squid/core/detail/parameterbinder.h"
 #include "zoo/squid/core/detail/resultbinder.h"
 #include "zoo/squid/core/detail/type_traits.h"
@@ -27,7 +32,10 @@
 #include <string_view>
 #include <string>
 #include <optional>
+#include <ranges>
 #include <sstream>
+#include <span>
+#include <type_traits>
 
 #if defined(_MSC_VER)
 #pragma warning(push)
@@ -44,19 +52,70 @@ class ibackend_statement;
 /// Not intended to be instantiated directly.
 class ZOO_SQUID_CORE_API basic_statement
 {
-	std::map<std::string, parameter>     parameters_;    /// bound query parameters
-	std::vector<result>                  results_;       /// bound row results, by sequence
-	std::map<std::string, result>        named_results_; /// bound row results, by name
-	std::shared_ptr<ibackend_connection> connection_;    /// backend connection
-	std::unique_ptr<ibackend_statement>  statement_;     /// backend statement
-	std::optional<std::ostringstream>    query_;         /// query stream
+	std::map<std::string, parameter>     parameters_;            /// bound query parameters, by name
+	positional_parameters                positional_parameters_; /// bound query parameters, by position in plan_
+	const binding_plan*                  plan_;                  /// binding plan of the backend statement, if any
+	std::vector<result>                  results_;               /// bound row results, by sequence
+	std::map<std::string, result>        named_results_;         /// bound row results, by name
+	std::shared_ptr<ibackend_connection> connection_;            /// backend connection
+	std::unique_ptr<ibackend_statement>  statement_;             /// backend statement
+	std::optional<std::ostringstream>    query_;                 /// query stream
+	fetch_mode                           fetch_mode_;            /// fetch mode of the backend statement
+
+	std::vector<positional_parameters> positional_batch_; /// parameter sets of execute_batch, by position in the plan
+	binding_plan                       batch_plan_;       /// names of the parameters bound by execute_batch without plan_
+	std::size_t                        batch_size_;       /// number of parameter sets in the batch
+
+	const void*                             described_type_;  /// type key of the described struct last bound with plan_
+	std::vector<std::optional<std::size_t>> described_slots_; /// position in plan_ of each member of described_type_
+
+	std::optional<deadline>                  deadline_; /// deadline of all executions and fetches
+	std::optional<std::chrono::milliseconds> timeout_;  /// timeout of each execution and fetch
 
 	template<typename... Args>
 	void upsert_parameter(std::string_view name, Args&&... args)
 	{
-		this->parameters_.insert_or_assign(std::string{ name }, parameter{ std::forward<Args>(args)... });
+		this->store_parameter(name, parameter{ std::forward<Args>(args)... });
 	}
 
+	void store_parameter(std::string_view name, parameter&& value);
+	void clear_parameters();
+
+	// Get the position in the binding plan of each of the @a names of the members of a described struct,
+	// or nullptr if there is no binding plan. The positions are resolved once, until another type is bound.
+	const std::vector<std::optional<std::size_t>>* described_slots(const void* type_key, std::span<const std::string_view> names);
+
+	template<typename T, typename Tag>
+	void bind_described(const T& value, const Tag& tag)
+	{
+		constexpr auto& names = described_member_names<T>;
+		const auto      slots = this->described_slots(&described::type_key<T>, names);
+		std::size_t     index = 0;
+		for_each_described_member(value, [&](const auto& member) {
+			if (!slots)
+			{
+				this->upsert_parameter(names[index], member, tag);
+			}
+			else if (const auto& slot = (*slots)[index])
+			{
+				this->positional_parameters_[slot.value()].emplace(member, tag);
+			}
+			++index;
+		});
+	}
+
+	// Switch to positional parameters if the backend statement has a binding plan, or back to named parameters.
+	void adopt_binding_plan();
+	void drop_binding_plan();
+
+	// Get the deadline of an execution or fetch that starts now, if any
+	std::optional<deadline> call_deadline() const;
+
+	void          create_statement_if_needed();
+	void          begin_batch();
+	void          add_batch_row();
+	std::uint64_t run_batch();
+
 	virtual std::unique_ptr<ibackend_statement> create_statement(std::shared_ptr<ibackend_connection> connection,
 	                                                             std::string_view                     query) = 0;
 
@@ -112,7 +171,11 @@ public:
 	/// T must be Boost serializable or T must have a public method template<class Binder> void bind(Binder& b):
 	///   assuming T has 2 members foo and bar, then this method should call b.bind("foo", foo); and
 	///   b.bind("bar", bar); to have those 2 members bound with their respective names.
-	/// If T has a bind method (see concept has_bind_method) then that implementation takes precedence.
+	/// Alternatively, T can be described with BOOST_DESCRIBE_STRUCT. Its public members are then bound with their
+	///   respective names, which are resolved to parameter positions only once per statement, so binding the same
+	///   type over and over again does not look up any names.
+	/// If T has a bind method (see concept has_bind_method) then that implementation takes precedence,
+	/// then Boost serialization, then Boost.Describe.
 	/// The values are copied, but note that for view types (std::string_view and byte_string_view)
 	/// the values are not deep copied. For these types the data pointed to by the view must outlive
 	/// the statement.
@@ -129,6 +192,10 @@ public:
 			bind_oarchive<parameter_binder<basic_statement>> ar{ *this };
 			ar << value;
 		}
+		else if constexpr (is_described_struct<T>)
+		{
+			this->bind_described(value, parameter::by_value{});
+		}
 		else
 		{
 			static_assert(always_false_v<T>, "Only serializable types allowed");
@@ -148,8 +215,8 @@ public:
 
 	/// Bind the query parameter(s) from the members of a struct or class T @a value by reference.
 	/// The reference must outlive the statement.
-	/// T must be Boost serializable or T must have a public method template<class Binder> void bind(Binder& b).
-	/// If T has a bind method (see concept has_bind_method) then that implementation takes precedence.
+	/// T must be Boost serializable, described with BOOST_DESCRIBE_STRUCT, or T must have a public method
+	/// template<class Binder> void bind(Binder& b). See bind(const T&) for the precedence.
 	template<typename T>
 	basic_statement& bind_ref(const T& value)
 	{
@@ -164,6 +231,10 @@ public:
 			ar << value;
 			return *this;
 		}
+		else if constexpr (is_described_struct<T>)
+		{
+			this->bind_described(value, parameter::by_reference{});
+		}
 		else
 		{
 			static_assert(always_false_v<T>, "Only serializable types allowed");
@@ -202,6 +273,9 @@ public:
 	///   b.bind("bar", bar); to have those 2 members bound with their respective names.
 	///   If the struct has a bind method (see concept has_bind_method) then that implementation takes precedence over
 	///   Boost serialize.
+	/// Structs described with BOOST_DESCRIBE_STRUCT (and not bindable otherwise) are bound sequentially instead:
+	///   their public members are appended like unnamed references, in declaration order, so the query must
+	///   select the columns in that order. No names are looked up when the rows are fetched.
 	/// For unnamed references, the order of the arguments must match the order of the query result columns.
 	/// Unnamed references are appended to previously bound references.
 	/// Named references will override previous references with the samed name.
@@ -220,6 +294,10 @@ public:
 			ar >> first;
 			return *this;
 		}
+		else if constexpr (is_described_struct<T>)
+		{
+			for_each_described_member(first, [this](auto& member) { this->results_.emplace_back(member); });
+		}
 		else
 		{
 			this->results_.emplace_back(first);
@@ -238,6 +316,19 @@ public:
 	///
 	/// statement execution methods
 
+	/// Set the fetch mode for the next executions. The default is fetch_mode::buffered.
+	/// See fetchmode.h.
+	basic_statement& set_fetch_mode(fetch_mode mode);
+
+	/// Set a deadline for the executions of this statement, and for its fetches unless the fetch mode is buffered.
+	/// When the deadline passes during a call, the backend statement is cancelled and the call throws
+	/// deadline_exceeded. A call that starts after the deadline throws without executing anything.
+	/// The same applies to the deadline of a transaction on the connection, see transaction.
+	basic_statement& set_deadline(const std::optional<deadline>& deadline);
+
+	/// Set a timeout for each execution and fetch of this statement, see also set_deadline().
+	basic_statement& set_timeout(const std::optional<std::chrono::milliseconds>& timeout);
+
 	/// Execute the statement [ with previously bound parameters ].
 	void execute();
 
@@ -251,12 +342,46 @@ public:
 	/// Parameters are bound by reference.
 	void bind_ref_execute(std::initializer_list<std::pair<std::string_view, parameter_by_reference>> params);
 
+	/// Execute the statement once for each element of @a range, as a batch.
+	/// The members of each element are bound by reference, like bind_ref(const T&) does. Parameters that were bound
+	/// before and that are not bound by the elements are used for every execution.
+	/// Result rows are discarded. Returns the total number of affected rows.
+	/// Backends execute the batch in the fastest way they support, e.g. PostgreSQL pipelines the executions.
+	/// Unless it runs in a transaction, a batch is not atomic: a failing execution does not undo the previous ones.
+	/// The elements are only executed after the whole range has been iterated, so @a range must be an lvalue whose
+	/// elements are lvalues that outlive the call, e.g. a container. A view that yields its elements by value, such as
+	/// std::views::transform, cannot be passed, nor can a temporary.
+	template<std::ranges::input_range Range>
+	    requires std::is_lvalue_reference_v<std::ranges::range_reference_t<Range>>
+	std::uint64_t execute_batch(Range& range)
+	{
+		this->begin_batch();
+		for (const auto& value : range)
+		{
+			this->bind_ref(value);
+			this->add_batch_row();
+		}
+		return this->run_batch();
+	}
+
+	/// The elements of a temporary range would not outlive their binding, nor would elements yielded by value
+	template<typename Range>
+	std::uint64_t execute_batch(Range&& range) = delete;
+
 	/// Fetch the next row.
 	/// Returns false when the last row was already fetched or when the statement
 	/// did not return any rows.
 	/// Throws if the statement has not been executed.
 	bool fetch();
 
+	/// Fetch up to @a batch_size rows at once into the typed columns of @a batch.
+	/// The batch is cleared first, its columns receive the first batch.column_count() fields of the result set.
+	/// Bound results are not assigned. Do not mix with fetch() on the same result set.
+	/// Returns the number of rows fetched, 0 when the last row was already fetched.
+	/// Throws if the statement has not been executed, if @a batch_size is 0 or if the backend cannot
+	/// convert a value to the type of its column.
+	std::size_t fetch_columns(column_batch& batch, std::size_t batch_size);
+
 	/// Get the number of fields in the result set.
 	/// Throws if the statement has not been executed.
 	std::size_t field_count();
@@ -0,0 +1,52 @@
+//
+// Copyright (C) 2022-2024 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/core/bindingplan.h"
+
+#include <algorithm>
+
+namespace zoo {
+namespace squid {
+
+binding_plan::binding_plan()
+    : names_{}
+{
+}
+
+binding_plan::binding_plan(std::vector<std::string> names)
+    : names_{ std::move(names) }
+{
+}
+
+std::size_t binding_plan::size() const
+{
+	return this->names_.size();
+}
+
+const std::string& binding_plan::name(std::size_t index) const
+{
+	return this->names_.at(index);
+}
+
+const std::vector<std::string>& binding_plan::names() const
+{
+	return this->names_;
+}
+
+std::optional<std::size_t> binding_plan::index_of(std::string_view name) const
+{
+	// Queries have few parameters, a linear search beats hashing here.
+	const auto it = std::find(this->names_.begin(), this->names_.end(), name);
+	if (it == this->names_.end())
+	{
+		return std::nullopt;
+	}
+	return static_cast<std::size_t>(it - this->names_.begin());
+}
+
+} // namespace squid
+} // namespace zoo
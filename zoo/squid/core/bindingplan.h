@@ -0,0 +1,49 @@
+//
+// Copyright (C) 2022-2024 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/core/config.h"
+#include "zoo/squid/core/parameter.h"
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+
+/// Query parameters in the positional order of a binding_plan, unbound parameters are empty
+using positional_parameters = std::vector<std::optional<parameter>>;
+
+/// Positional parameter binding plan of a query.
+/// Holds the distinct names of the query parameters in the order of their positions, so that the parameters of an
+/// execution can be passed as a flat, position-indexed array instead of being looked up by name every time.
+class ZOO_SQUID_CORE_API binding_plan final
+{
+	std::vector<std::string> names_;
+
+public:
+	binding_plan();
+	explicit binding_plan(std::vector<std::string> names);
+
+	/// Get the number of distinct parameters
+	std::size_t size() const;
+
+	/// Get the name of the parameter at @a index
+	const std::string& name(std::size_t index) const;
+
+	/// Get the names of all parameters, in positional order
+	const std::vector<std::string>& names() const;
+
+	/// Get the index of the parameter @a name, or std::nullopt if the query has no such parameter
+	std::optional<std::size_t> index_of(std::string_view name) const;
+};
+
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,485 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/core/cachingbackendconnection.h"
+#include "zoo/squid/core/ibackendstatement.h"
+#include "zoo/squid/core/error.h"
+
+#include "zoo/common/misc/throw_exception.h"
+
+#include <charconv>
+#include <cstring>
+#include <iterator>
+#include <map>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+
+namespace {
+
+template<typename T>
+constexpr bool is_string_v = std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> || std::is_same_v<T, byte_string> ||
+                             std::is_same_v<T, byte_string_view>;
+
+template<typename T>
+void append_value(std::string& out, const T& value)
+{
+	if constexpr (is_string_v<T>)
+	{
+		const auto size = value.size();
+		out.append(reinterpret_cast<const char*>(&size), sizeof(size));
+		out.append(reinterpret_cast<const char*>(value.data()), size);
+	}
+	else if constexpr (!std::is_same_v<T, std::nullopt_t>)
+	{
+		static_assert(std::is_trivially_copyable_v<T>);
+		out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+}
+
+template<typename T>
+void read_value(std::string_view& in, T& value)
+{
+	if constexpr (is_string_v<T>)
+	{
+		auto size = std::size_t{};
+		std::memcpy(&size, in.data(), sizeof(size));
+		value.assign(reinterpret_cast<const typename T::value_type*>(in.data() + sizeof(size)), size);
+		in.remove_prefix(sizeof(size) + size);
+	}
+	else
+	{
+		std::memcpy(&value, in.data(), sizeof(T));
+		in.remove_prefix(sizeof(T));
+	}
+}
+
+// The index of the alternative T of the variant V
+template<typename V, typename T, std::size_t I = 0>
+constexpr std::size_t alternative_index()
+{
+	if constexpr (std::is_same_v<std::variant_alternative_t<I, V>, T>)
+	{
+		return I;
+	}
+	else
+	{
+		return alternative_index<V, T, I + 1>();
+	}
+}
+
+// The type by which a parameter value of type T is keyed.
+// A view is keyed like the string it views, so that equal values share cache entries.
+template<typename T>
+struct key_type
+{
+	using type = T;
+};
+
+template<>
+struct key_type<std::string_view>
+{
+	using type = std::string;
+};
+
+template<>
+struct key_type<byte_string_view>
+{
+	using type = byte_string;
+};
+
+// Append the type and the value of a parameter to a cache key.
+// Only the value is encoded, never padding bytes of the object, which are indeterminate.
+template<typename T>
+void append_key_value(std::string& out, const T& value)
+{
+	out.push_back(static_cast<char>(alternative_index<parameter::pointer_type, const typename key_type<T>::type*>()));
+	if constexpr (std::is_same_v<T, long double>)
+	{
+		// Padding bytes follow the value bits on some platforms, the hexadecimal form represents the value exactly
+		char buffer[64];
+		const auto result = std::to_chars(std::begin(buffer), std::end(buffer), value, std::chars_format::hex);
+		append_value(out, std::string_view{ buffer, result.ptr });
+	}
+	else if constexpr (std::is_same_v<T, time_of_day>)
+	{
+		append_value(out, value.to_duration().count());
+	}
+	else
+	{
+		append_value(out, value);
+	}
+}
+
+void append_parameter(std::string& out, const parameter& param)
+{
+	std::visit([&out](auto&& arg) { append_key_value(out, *arg); }, param.pointer());
+}
+
+void append_parameters(std::string& out, const std::map<std::string, parameter>& parameters)
+{
+	for (const auto& [name, param] : parameters)
+	{
+		out.append(name);
+		out.push_back('\0');
+		append_parameter(out, param);
+	}
+}
+
+void append_parameters(std::string& out, const positional_parameters& parameters)
+{
+	for (const auto& param : parameters)
+	{
+		if (param)
+		{
+			append_parameter(out, param.value());
+		}
+		else
+		{
+			out.push_back('\xff');
+		}
+	}
+}
+
+// The type of a bound result, which determines how its values are encoded
+void append_result_type(std::string& out, const result& res)
+{
+	const auto& value = res.value();
+	out.push_back(static_cast<char>(value.index()));
+	out.push_back(static_cast<char>(std::visit([](auto&& arg) { return arg.index(); }, value)));
+}
+
+void append_result(std::string& out, const result& res)
+{
+	std::visit(
+	    [&out](auto&& arg) {
+		    std::visit(
+		        [&out](auto&& ptr) {
+			        using T = std::decay_t<decltype(*ptr)>;
+			        if constexpr (is_optional_v<T>)
+			        {
+				        out.push_back(ptr->has_value() ? '\1' : '\0');
+				        if (ptr->has_value())
+				        {
+					        append_value(out, ptr->value());
+				        }
+			        }
+			        else
+			        {
+				        append_value(out, *ptr);
+			        }
+		        },
+		        arg);
+	    },
+	    res.value());
+}
+
+void read_result(std::string_view& in, const result& res)
+{
+	std::visit(
+	    [&in](auto&& arg) {
+		    std::visit(
+		        [&in](auto&& ptr) {
+			        using T = std::decay_t<decltype(*ptr)>;
+			        if constexpr (is_optional_v<T>)
+			        {
+				        const auto has_value = in.front() != '\0';
+				        in.remove_prefix(1);
+				        if (has_value)
+				        {
+					        typename T::value_type value{};
+					        read_value(in, value);
+					        *ptr = std::move(value);
+				        }
+				        else
+				        {
+					        ptr->reset();
+				        }
+			        }
+			        else
+			        {
+				        read_value(in, *ptr);
+			        }
+		        },
+		        arg);
+	    },
+	    res.value());
+}
+
+class caching_statement final : public ibackend_statement
+{
+	std::unique_ptr<ibackend_statement>      statement_;
+	std::shared_ptr<result_cache>            cache_;
+	std::shared_ptr<const result_cache_rule> rule_;
+	std::string                              query_;
+	std::vector<result>                      results_;   // the bound results, in the order their values are encoded
+	std::shared_ptr<const cached_result>     cached_;    // the result that is served, null if the statement is
+	std::string_view                         cursor_;    // the encoded rows of cached_ that were not fetched yet
+	std::size_t                              remaining_; // number of rows of cached_ that were not fetched yet
+
+	template<typename Parameters, typename ResultsContainer>
+	void execute_statement(const Parameters& parameters, const ResultsContainer& results)
+	{
+		if constexpr (std::is_same_v<Parameters, positional_parameters>)
+		{
+			this->statement_->execute_positional(parameters, results);
+		}
+		else
+		{
+			this->statement_->execute(parameters, results);
+		}
+	}
+
+	// Execute the statement and read the whole result
+	std::shared_ptr<const cached_result> read_all()
+	{
+		auto fresh           = std::make_shared<cached_result>();
+		fresh->affected_rows = this->statement_->affected_rows();
+		for (std::size_t i = 0, end = this->statement_->field_count(); i < end; ++i)
+		{
+			fresh->field_names.push_back(this->statement_->field_name(i));
+		}
+		while (this->statement_->fetch())
+		{
+			for (const auto& res : this->results_)
+			{
+				append_result(fresh->data, res);
+			}
+			++fresh->rows;
+		}
+		return fresh;
+	}
+
+	template<typename Parameters, typename ResultsContainer>
+	void execute_results(const Parameters& parameters, const ResultsContainer& results)
+	{
+		this->cached_.reset();
+		this->cursor_    = {};
+		this->remaining_ = 0;
+
+		if (results.empty())
+		{
+			this->execute_statement(parameters, results);
+			return;
+		}
+
+		auto key = this->query_;
+		key.push_back('\0');
+		append_parameters(key, parameters);
+		key.push_back('\0');
+
+		this->results_.clear();
+		for (const auto& res : results)
+		{
+			if constexpr (std::is_same_v<ResultsContainer, std::vector<result>>)
+			{
+				this->results_.push_back(res);
+			}
+			else
+			{
+				key.append(res.first);
+				key.push_back('\0');
+				this->results_.push_back(res.second);
+			}
+			append_result_type(key, this->results_.back());
+		}
+
+		auto [cached, generation] = this->cache_->lookup(key);
+		if (!cached)
+		{
+			this->execute_statement(parameters, results);
+			cached = this->read_all();
+			this->cache_->store(std::move(key), this->rule_, cached, generation);
+		}
+
+		this->cached_    = std::move(cached);
+		this->cursor_    = this->cached_->data;
+		this->remaining_ = this->cached_->rows;
+	}
+
+public:
+	caching_statement(std::unique_ptr<ibackend_statement>      statement,
+	                  std::shared_ptr<result_cache>            cache,
+	                  std::shared_ptr<const result_cache_rule> rule,
+	                  std::string_view                         query)
+	    : statement_{ std::move(statement) }
+	    , cache_{ std::move(cache) }
+	    , rule_{ std::move(rule) }
+	    , query_{ query }
+	    , results_{}
+	    , cached_{}
+	    , cursor_{}
+	    , remaining_{}
+	{
+	}
+
+	void execute(const std::map<std::string, parameter>& parameters, const std::vector<result>& results) override
+	{
+		this->execute_results(parameters, results);
+	}
+
+	void execute(const std::map<std::string, parameter>& parameters, const std::map<std::string, result>& results) override
+	{
+		this->execute_results(parameters, results);
+	}
+
+	bool fetch() override
+	{
+		if (!this->cached_)
+		{
+			return this->statement_->fetch();
+		}
+		if (this->remaining_ == 0)
+		{
+			return false;
+		}
+
+		for (const auto& res : this->results_)
+		{
+			read_result(this->cursor_, res);
+		}
+		--this->remaining_;
+		return true;
+	}
+
+	std::size_t field_count() override
+	{
+		return this->cached_ ? this->cached_->field_names.size() : this->statement_->field_count();
+	}
+
+	std::string field_name(std::size_t index) override
+	{
+		return this->cached_ ? this->cached_->field_names.at(index) : this->statement_->field_name(index);
+	}
+
+	std::uint64_t affected_rows() override
+	{
+		return this->cached_ ? this->cached_->affected_rows : this->statement_->affected_rows();
+	}
+
+	void set_fetch_mode(fetch_mode mode) override
+	{
+		this->statement_->set_fetch_mode(mode);
+	}
+
+	const binding_plan* parameter_binding_plan() const override
+	{
+		return this->statement_->parameter_binding_plan();
+	}
+
+	void execute_positional(const positional_parameters& parameters, const std::vector<result>& results) override
+	{
+		this->execute_results(parameters, results);
+	}
+
+	void execute_positional(const positional_parameters& parameters, const std::map<std::string, result>& results) override
+	{
+		this->execute_results(parameters, results);
+	}
+
+	std::uint64_t execute_batch(std::span<const std::map<std::string, parameter>> batch) override
+	{
+		this->cached_.reset();
+		return this->statement_->execute_batch(batch);
+	}
+
+	std::uint64_t execute_batch_positional(std::span<const positional_parameters> batch) override
+	{
+		this->cached_.reset();
+		return this->statement_->execute_batch_positional(batch);
+	}
+
+	std::uint64_t execute_batch_named(const binding_plan& names, std::span<const positional_parameters> batch) override
+	{
+		this->cached_.reset();
+		return this->statement_->execute_batch_named(names, batch);
+	}
+
+	std::size_t fetch_columns(column_batch& batch, std::size_t batch_size) override
+	{
+		if (this->cached_)
+		{
+			ZOO_THROW_EXCEPTION(error{ "Cannot fetch columns of a cached result" });
+		}
+		return this->statement_->fetch_columns(batch, batch_size);
+	}
+};
+
+} // namespace
+
+caching_backend_connection::caching_backend_connection(std::shared_ptr<ibackend_connection> connection, std::shared_ptr<result_cache> cache)
+    : ibackend_connection{}
+    , connection_{ std::move(connection) }
+    , cache_{ std::move(cache) }
+{
+	if (!this->connection_)
+	{
+		ZOO_THROW_EXCEPTION(std::invalid_argument{ "connection must not be null" });
+	}
+	if (!this->cache_)
+	{
+		ZOO_THROW_EXCEPTION(std::invalid_argument{ "cache must not be null" });
+	}
+}
+
+std::unique_ptr<ibackend_statement> caching_backend_connection::create_statement(std::string_view query)
+{
+	auto statement = this->connection_->create_statement(query);
+	if (auto rule = this->cache_->find_rule(query))
+	{
+		return std::make_unique<caching_statement>(std::move(statement), this->cache_, std::move(rule), query);
+	}
+	return statement;
+}
+
+std::unique_ptr<ibackend_statement> caching_backend_connection::create_prepared_statement(std::string_view query)
+{
+	auto statement = this->connection_->create_prepared_statement(query);
+	if (auto rule = this->cache_->find_rule(query))
+	{
+		return std::make_unique<caching_statement>(std::move(statement), this->cache_, std::move(rule), query);
+	}
+	return statement;
+}
+
+void caching_backend_connection::execute(const std::string& query)
+{
+	this->connection_->execute(query);
+}
+
+statement_cache_stats caching_backend_connection::prepared_statement_cache_stats() const
+{
+	return this->connection_->prepared_statement_cache_stats();
+}
+
+void caching_backend_connection::set_prepared_statement_cache_capacity(std::size_t capacity)
+{
+	this->connection_->set_prepared_statement_cache_capacity(capacity);
+}
+
+bool caching_backend_connection::is_valid()
+{
+	return this->connection_->is_valid();
+}
+
+void caching_backend_connection::cancel()
+{
+	this->connection_->cancel();
+}
+
+const std::shared_ptr<ibackend_connection>& caching_backend_connection::backend() const noexcept
+{
+	return this->connection_;
+}
+
+} // namespace squid
+} // namespace zoo
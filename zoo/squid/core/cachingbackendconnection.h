@@ -0,0 +1,48 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/core/config.h"
+#include "zoo/squid/core/ibackendconnection.h"
+#include "zoo/squid/core/resultcache.h"
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace zoo {
+namespace squid {
+
+/// Decorator of a backend connection of any backend, that serves the results of cacheable queries from a result_cache.
+/// The statements of queries that are not cacheable are those of the decorated connection, so they cost nothing extra.
+/// An execution is only cached when results are bound. On a miss, all rows are fetched and stored before the first
+/// one is returned. Fetching columns and batch execution bypass the cache.
+class ZOO_SQUID_CORE_API caching_backend_connection final : public ibackend_connection
+{
+	std::shared_ptr<ibackend_connection> connection_;
+	std::shared_ptr<result_cache>        cache_;
+
+public:
+	caching_backend_connection(std::shared_ptr<ibackend_connection> connection, std::shared_ptr<result_cache> cache);
+
+	std::unique_ptr<ibackend_statement> create_statement(std::string_view query) override;
+	std::unique_ptr<ibackend_statement> create_prepared_statement(std::string_view query) override;
+	void                                execute(const std::string& query) override;
+
+	statement_cache_stats prepared_statement_cache_stats() const override;
+	void                  set_prepared_statement_cache_capacity(std::size_t capacity) override;
+
+	bool is_valid() override;
+	void cancel() override;
+
+	/// Get the decorated backend connection
+	const std::shared_ptr<ibackend_connection>& backend() const noexcept;
+};
+
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,40 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/core/cachingbackendconnectionfactory.h"
+#include "zoo/squid/core/cachingbackendconnection.h"
+
+#include "zoo/common/misc/throw_exception.h"
+
+#include <stdexcept>
+
+namespace zoo {
+namespace squid {
+
+caching_backend_connection_factory::caching_backend_connection_factory(std::shared_ptr<const ibackend_connection_factory> factory,
+                                                                       std::shared_ptr<result_cache>                      cache)
+    : ibackend_connection_factory{}
+    , factory_{ std::move(factory) }
+    , cache_{ std::move(cache) }
+{
+	if (!this->factory_)
+	{
+		ZOO_THROW_EXCEPTION(std::invalid_argument{ "factory must not be null" });
+	}
+	if (!this->cache_)
+	{
+		ZOO_THROW_EXCEPTION(std::invalid_argument{ "cache must not be null" });
+	}
+}
+
+std::shared_ptr<ibackend_connection> caching_backend_connection_factory::create_backend_connection(std::string_view connection_info) const
+{
+	return std::make_shared<caching_backend_connection>(this->factory_->create_backend_connection(connection_info), this->cache_);
+}
+
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,259 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/core/columnbatch.h"
+#include "zoo/squid/core/error.h"
+
+#include "zoo/common/misc/throw_exception.h"
+
+#include <bit>
+#include <numeric>
+
+namespace zoo {
+namespace squid {
+
+namespace {
+
+template<typename T, typename Variant>
+auto& get_values(Variant& values)
+{
+	if (auto result = std::get_if<T>(&values))
+	{
+		return *result;
+	}
+	ZOO_THROW_EXCEPTION(error{ "Column type mismatch" });
+}
+
+} // namespace
+
+//=============//
+// null_bitmap //
+//=============//
+
+null_bitmap::null_bitmap()
+    : words_{}
+    , size_{}
+{
+}
+
+std::size_t null_bitmap::size() const noexcept
+{
+	return this->size_;
+}
+
+std::size_t null_bitmap::null_count() const noexcept
+{
+	return std::accumulate(
+	    this->words_.begin(), this->words_.end(), std::size_t{}, [](std::size_t count, std::uint64_t word) { return count + std::popcount(word); });
+}
+
+const std::vector<std::uint64_t>& null_bitmap::words() const noexcept
+{
+	return this->words_;
+}
+
+void null_bitmap::reserve(std::size_t rows)
+{
+	this->words_.reserve((rows + 63u) / 64u);
+}
+
+void null_bitmap::clear() noexcept
+{
+	this->words_.clear();
+	this->size_ = 0u;
+}
+
+//=============//
+// text_column //
+//=============//
+
+text_column::text_column()
+    : data_{}
+    , offsets_{ 0u }
+{
+}
+
+std::size_t text_column::size() const noexcept
+{
+	return this->offsets_.size() - 1u;
+}
+
+const std::string& text_column::data() const noexcept
+{
+	return this->data_;
+}
+
+const std::vector<std::size_t>& text_column::offsets() const noexcept
+{
+	return this->offsets_;
+}
+
+void text_column::reserve(std::size_t rows)
+{
+	this->offsets_.reserve(rows + 1u);
+}
+
+void text_column::clear() noexcept
+{
+	this->data_.clear();
+	this->offsets_.resize(1u);
+}
+
+//===============//
+// column_buffer //
+//===============//
+
+column_buffer::column_buffer(column_type type)
+    : type_{ type }
+    , values_{}
+    , nulls_{}
+{
+	switch (type)
+	{
+	case column_type::int64:
+		this->values_.emplace<std::vector<std::int64_t>>();
+		break;
+	case column_type::float64:
+		this->values_.emplace<std::vector<double>>();
+		break;
+	case column_type::text:
+		this->values_.emplace<text_column>();
+		break;
+	}
+}
+
+column_type column_buffer::type() const noexcept
+{
+	return this->type_;
+}
+
+std::size_t column_buffer::size() const noexcept
+{
+	return this->nulls_.size();
+}
+
+const std::vector<std::int64_t>& column_buffer::int64_values() const
+{
+	return get_values<std::vector<std::int64_t>>(this->values_);
+}
+
+const std::vector<double>& column_buffer::float64_values() const
+{
+	return get_values<std::vector<double>>(this->values_);
+}
+
+const text_column& column_buffer::text_values() const
+{
+	return get_values<text_column>(this->values_);
+}
+
+const null_bitmap& column_buffer::nulls() const noexcept
+{
+	return this->nulls_;
+}
+
+std::vector<std::int64_t>& column_buffer::int64_values()
+{
+	return get_values<std::vector<std::int64_t>>(this->values_);
+}
+
+std::vector<double>& column_buffer::float64_values()
+{
+	return get_values<std::vector<double>>(this->values_);
+}
+
+text_column& column_buffer::text_values()
+{
+	return get_values<text_column>(this->values_);
+}
+
+null_bitmap& column_buffer::nulls() noexcept
+{
+	return this->nulls_;
+}
+
+void column_buffer::reserve(std::size_t rows)
+{
+	std::visit([rows](auto& values) { values.reserve(rows); }, this->values_);
+	this->nulls_.reserve(rows);
+}
+
+void column_buffer::clear() noexcept
+{
+	std::visit([](auto& values) { values.clear(); }, this->values_);
+	this->nulls_.clear();
+}
+
+//==============//
+// column_batch //
+//==============//
+
+column_batch::column_batch(std::initializer_list<column_type> types)
+    : column_batch{ std::vector<column_type>{ types } }
+{
+}
+
+column_batch::column_batch(const std::vector<column_type>& types)
+    : columns_{}
+    , rows_{}
+{
+	this->columns_.reserve(types.size());
+	for (const auto type : types)
+	{
+		this->columns_.emplace_back(type);
+	}
+}
+
+std::size_t column_batch::column_count() const noexcept
+{
+	return this->columns_.size();
+}
+
+std::size_t column_batch::rows() const noexcept
+{
+	return this->rows_;
+}
+
+bool column_batch::empty() const noexcept
+{
+	return this->rows_ == 0u;
+}
+
+const column_buffer& column_batch::column(std::size_t index) const
+{
+	return this->columns_.at(index);
+}
+
+column_buffer& column_batch::column(std::size_t index)
+{
+	return this->columns_.at(index);
+}
+
+void column_batch::set_rows(std::size_t rows) noexcept
+{
+	this->rows_ = rows;
+}
+
+void column_batch::reserve(std::size_t rows)
+{
+	for (auto& column : this->columns_)
+	{
+		column.reserve(rows);
+	}
+}
+
+void column_batch::clear() noexcept
+{
+	for (auto& column : this->columns_)
+	{
+		column.clear();
+	}
+	this->rows_ = 0u;
+}
+
+} // namespace squid
+} // namespace zoo
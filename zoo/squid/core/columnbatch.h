@@ -0,0 +1,161 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/core/config.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+
+/// Type of the values of a column_buffer
+enum class column_type
+{
+	int64,   //!< std::int64_t
+	float64, //!< double
+	text     //!< strings in a text_column
+};
+
+/// Null flags of the values of a column, one bit per row
+class ZOO_SQUID_CORE_API null_bitmap final
+{
+	std::vector<std::uint64_t> words_;
+	std::size_t                size_;
+
+public:
+	null_bitmap();
+
+	std::size_t size() const noexcept;
+
+	bool is_null(std::size_t row) const noexcept
+	{
+		return (this->words_[row / 64u] >> (row % 64u)) & 1u;
+	}
+
+	/// Append the flag of the next row
+	void push_back(bool is_null)
+	{
+		if (this->size_ % 64u == 0u)
+		{
+			this->words_.push_back(0u);
+		}
+		if (is_null)
+		{
+			this->words_.back() |= std::uint64_t{ 1 } << (this->size_ % 64u);
+		}
+		++this->size_;
+	}
+
+	/// Get the number of null values
+	std::size_t null_count() const noexcept;
+
+	/// The bits, row i is bit i % 64 of word i / 64
+	const std::vector<std::uint64_t>& words() const noexcept;
+
+	void reserve(std::size_t rows);
+	void clear() noexcept;
+};
+
+/// The strings of a column, stored back to back in one buffer.
+/// String i spans the bytes [offsets()[i], offsets()[i + 1]) of data().
+class ZOO_SQUID_CORE_API text_column final
+{
+	std::string              data_;
+	std::vector<std::size_t> offsets_;
+
+public:
+	text_column();
+
+	std::size_t size() const noexcept;
+
+	std::string_view operator[](std::size_t row) const noexcept
+	{
+		return std::string_view{ this->data_.data() + this->offsets_[row], this->offsets_[row + 1u] - this->offsets_[row] };
+	}
+
+	void push_back(std::string_view value)
+	{
+		this->data_.append(value);
+		this->offsets_.push_back(this->data_.size());
+	}
+
+	const std::string&              data() const noexcept;
+	const std::vector<std::size_t>& offsets() const noexcept;
+
+	void reserve(std::size_t rows);
+	void clear() noexcept;
+};
+
+/// Contiguous values of one column of a column_batch, plus their null flags.
+/// A null value is stored as 0 or as an empty string, so that the values stay aligned with the rows.
+class ZOO_SQUID_CORE_API column_buffer final
+{
+	column_type                                                               type_;
+	std::variant<std::vector<std::int64_t>, std::vector<double>, text_column> values_;
+	null_bitmap                                                               nulls_;
+
+public:
+	explicit column_buffer(column_type type);
+
+	column_type type() const noexcept;
+	std::size_t size() const noexcept;
+
+	/// Get the values, these methods throw if the column is of another type
+	const std::vector<std::int64_t>& int64_values() const;
+	const std::vector<double>&       float64_values() const;
+	const text_column&               text_values() const;
+	const null_bitmap&               nulls() const noexcept;
+
+	/// Mutable access for the backends, which must append a value and a null flag for every row
+	std::vector<std::int64_t>& int64_values();
+	std::vector<double>&       float64_values();
+	text_column&               text_values();
+	null_bitmap&               nulls() noexcept;
+
+	void reserve(std::size_t rows);
+	void clear() noexcept;
+};
+
+/// A batch of rows in columnar form, filled by basic_statement::fetch_columns.
+/// The column types are chosen up front, the backend converts the values of the result columns to them.
+/// Every backend throws when a value cannot be converted, e.g. text that is not a number in an int64 column, rather than
+/// storing a coerced value. Any value converts to text.
+/// Reusing a batch for the next call reuses its memory.
+class ZOO_SQUID_CORE_API column_batch final
+{
+	std::vector<column_buffer> columns_;
+	std::size_t                rows_;
+
+public:
+	/// Create a batch for the first @a types.size() columns of a result
+	explicit column_batch(std::initializer_list<column_type> types);
+	explicit column_batch(const std::vector<column_type>& types);
+
+	std::size_t column_count() const noexcept;
+	std::size_t rows() const noexcept;
+	bool        empty() const noexcept;
+
+	const column_buffer& column(std::size_t index) const;
+	column_buffer&       column(std::size_t index);
+
+	/// Used by the backends to record the number of rows they appended to every column
+	void set_rows(std::size_t rows) noexcept;
+
+	void reserve(std::size_t rows);
+	void clear() noexcept;
+};
+
+} // namespace squid
+} // namespace zoo
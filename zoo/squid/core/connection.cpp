@@ -7,6 +7,7 @@
 
 #include "zoo/squid/core/connection.h"
 #include "zoo/squid/core/connectionpool.h"
+#include "zoo/squid/core/routingpool.h"
 #include "zoo/squid/core/ibackendconnectionfactory.h"
 #include "zoo/squid/core/ibackendconnection.h"
 #include "zoo/squid/core/preparedstatement.h"
@@ -60,6 +61,15 @@ connection::connection(connection_pool& pool, const std::chrono::milliseconds& t
 	}
 }
 
+connection::connection(connection_pool& pool, const deadline& deadline)
+    : backend_{ deadline.expired() ? nullptr : pool.acquire(deadline.remaining()) }
+{
+	if (!this->backend_)
+	{
+		ZOO_THROW_EXCEPTION(deadline_exceeded{});
+	}
+}
+
 std::optional<connection> connection::create(connection_pool& pool)
 {
 	auto backend = pool.try_acquire();
@@ -86,6 +96,37 @@ std::optional<connection> connection::create(connection_pool& pool, const std::c
 	}
 }
 
+connection::connection(routing_pool& pool, access_mode mode)
+    : backend_{ pool.acquire(mode) }
+{
+	if (!this->backend_)
+	{
+		ZOO_THROW_EXCEPTION(no_connection_available{});
+	}
+}
+
+connection::connection(routing_pool& pool, access_mode mode, const std::chrono::milliseconds& timeout)
+    : backend_{ pool.acquire(mode, timeout) }
+{
+	if (!this->backend_)
+	{
+		ZOO_THROW_EXCEPTION(no_connection_available{});
+	}
+}
+
+std::optional<connection> connection::create(routing_pool& pool, access_mode mode)
+{
+	auto backend = pool.try_acquire(mode);
+	if (backend)
+	{
+		return connection{ std::move(backend) };
+	}
+	else
+	{
+		return std::nullopt;
+	}
+}
+
 const std::shared_ptr<ibackend_connection>& connection::backend() const
 {
 	return this->backend_;
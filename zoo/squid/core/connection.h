@@ -12,7 +12,9 @@
 #include "zoo/squid/core/ibackendconnectionfwd.h"
 #include "zoo/squid/core/ibackendconnectionfactoryfwd.h"
 #include "zoo/squid/core/connectionpoolfwd.h"
+#include "zoo/squid/core/routingpoolfwd.h"
 #include "zoo/squid/core/preparedstatementfwd.h"
+#include "zoo/squid/core/deadline.h"
 
 #include <memory>
 #include <string_view>
@@ -48,6 +50,10 @@ public:
 	/// Throws @c no_connection_available if no connection is available within the specified timeout.
 	explicit connection(connection_pool& pool, const std::chrono::milliseconds& timeout);
 
+	/// Create a connection that acquires a backend connection from the @a pool by @a deadline.
+	/// Throws @c deadline_exceeded if no connection is available before the deadline.
+	explicit connection(connection_pool& pool, const deadline& deadline);
+
 	/// Create a connection that acquires a backend connection from the @a pool.
 	/// Returns std::nullopt immediately if no connection is available.
 	static std::optional<connection> create(connection_pool& pool);
@@ -56,6 +62,19 @@ public:
 	/// Returns std::nullopt if no connection is available within the specified timeout.
 	static std::optional<connection> create(connection_pool& pool, const std::chrono::milliseconds& timeout);
 
+	/// Create a connection that acquires a backend connection for @a mode from the routing @a pool.
+	/// Waits indefinitely until the chosen pool has a connection available.
+	/// Throws @c no_connection_available if the work cannot be routed.
+	explicit connection(routing_pool& pool, access_mode mode);
+
+	/// Create a connection that acquires a backend connection for @a mode from the routing @a pool with a given @a timeout.
+	/// Throws @c no_connection_available if no connection is available within the specified timeout.
+	explicit connection(routing_pool& pool, access_mode mode, const std::chrono::milliseconds& timeout);
+
+	/// Create a connection that acquires a backend connection for @a mode from the routing @a pool.
+	/// Returns std::nullopt immediately if no connection is available.
+	static std::optional<connection> create(routing_pool& pool, access_mode mode);
+
 	virtual ~connection() noexcept;
 
 	connection(const connection&)            = delete;
@@ -6,147 +6,714 @@
 //
 
 #include "zoo/squid/core/connectionpool.h"
+#include "zoo/squid/core/connection.h"
 #include "zoo/squid/core/ibackendconnection.h"
 #include "zoo/squid/core/ibackendconnectionfactory.h"
 #include "zoo/squid/core/ibackendstatement.h"
 #include "zoo/squid/core/error.h"
 
+#include "zoo/common/logging/logging.h"
 #include "zoo/common/misc/throw_exception.h"
 
-#include <functional>
-#include <queue>
-#include <mutex>
+#include <boost/asio/error.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/prefer.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/system/system_error.hpp>
+
+#include <algorithm>
 #include <condition_variable>
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <cassert>
 
 namespace zoo {
 namespace squid {
 
 namespace {
 
+using clock_type = std::chrono::steady_clock;
+
 class backend_connection_wrapper final : public ibackend_connection
 {
-	using release_function_type = std::function<void(std::shared_ptr<ibackend_connection>&&)>;
-
-	std::shared_ptr<ibackend_connection> connection_;
-	release_function_type                release_function_;
+	ibackend_connection& connection_;
 
 	std::unique_ptr<ibackend_statement> create_statement(std::string_view query) override
 	{
-		return this->connection_->create_statement(query);
+		return this->connection_.create_statement(query);
 	}
 
 	std::unique_ptr<ibackend_statement> create_prepared_statement(std::string_view query) override
 	{
-		return this->connection_->create_prepared_statement(query);
+		return this->connection_.create_prepared_statement(query);
 	}
 
 	void execute(const std::string& query) override
 	{
-		this->connection_->execute(query);
+		this->connection_.execute(query);
+	}
+
+	statement_cache_stats prepared_statement_cache_stats() const override
+	{
+		return this->connection_.prepared_statement_cache_stats();
+	}
+
+	void set_prepared_statement_cache_capacity(std::size_t capacity) override
+	{
+		this->connection_.set_prepared_statement_cache_capacity(capacity);
+	}
+
+	bool is_valid() override
+	{
+		return this->connection_.is_valid();
+	}
+
+	void cancel() override
+	{
+		this->connection_.cancel();
 	}
 
 public:
-	explicit backend_connection_wrapper(std::shared_ptr<ibackend_connection>&& connection, release_function_type&& release_function)
-	    : connection_{ std::move(connection) }
-	    , release_function_{ std::move(release_function) }
+	explicit backend_connection_wrapper(ibackend_connection& connection)
+	    : connection_{ connection }
 	{
 	}
+};
+
+/// An open connection of the pool, together with the wrapper that is handed out for it.
+/// Both are created once, so handing out a connection does not allocate.
+struct pooled_connection final
+{
+	static constexpr std::size_t lease_storage_size = 128;
 
-	~backend_connection_wrapper()
+	std::shared_ptr<ibackend_connection> backend;
+	backend_connection_wrapper           wrapper;
+	clock_type::time_point               idle_since;
+
+	/// Storage for the control block of the std::shared_ptr that is handed out
+	alignas(std::max_align_t) std::byte lease_storage[lease_storage_size];
+
+	explicit pooled_connection(std::shared_ptr<ibackend_connection>&& backend)
+	    : backend{ std::move(backend) }
+	    , wrapper{ *this->backend }
+	    , idle_since{}
+	    , lease_storage{}
 	{
-		this->release_function_(std::move(this->connection_));
 	}
+
+	pooled_connection(const pooled_connection&)            = delete;
+	pooled_connection& operator=(const pooled_connection&) = delete;
 };
 
+std::shared_ptr<ibackend_connection> open_connection(const ibackend_connection_factory& factory, std::string_view connection_info)
+{
+	auto connection = factory.create_backend_connection(connection_info);
+	if (!connection)
+	{
+		ZOO_THROW_EXCEPTION(error{ "The connection factory did not create a connection" });
+	}
+	return connection;
+}
+
 } // namespace
 
-class connection_pool::impl final
+class connection_pool::impl final : public std::enable_shared_from_this<connection_pool::impl>
 {
-	std::queue<std::shared_ptr<ibackend_connection>> queue_;
-	std::mutex                                       mutex_;
-	std::condition_variable                          cv_;
+	/// Allocator for the control block of a handed out connection.
+	/// It places the control block in the storage of the pooled connection, and it returns the connection to the
+	/// pool when the control block is deallocated, which is the last thing a std::shared_ptr does with it.
+	template<typename T>
+	class lease_allocator final
+	{
+		template<typename U>
+		friend class lease_allocator;
 
-	using lock_type = std::unique_lock<std::mutex>;
+		std::shared_ptr<impl> pool_;
+		pooled_connection*    connection_;
 
-public:
-	impl(const ibackend_connection_factory& factory, std::string_view connection_info, std::size_t count)
+	public:
+		using value_type = T;
+
+		lease_allocator(std::shared_ptr<impl> pool, pooled_connection* connection)
+		    : pool_{ std::move(pool) }
+		    , connection_{ connection }
+		{
+		}
+
+		template<typename U>
+		lease_allocator(const lease_allocator<U>& other)
+		    : pool_{ other.pool_ }
+		    , connection_{ other.connection_ }
+		{
+		}
+
+		T* allocate(std::size_t n)
+		{
+			if (n == 1 && sizeof(T) <= pooled_connection::lease_storage_size && alignof(T) <= alignof(std::max_align_t))
+			{
+				return reinterpret_cast<T*>(this->connection_->lease_storage);
+			}
+			return std::allocator<T>{}.allocate(n);
+		}
+
+		void deallocate(T* p, std::size_t n) noexcept
+		{
+			if (static_cast<void*>(p) != static_cast<void*>(this->connection_->lease_storage))
+			{
+				std::allocator<T>{}.deallocate(p, n);
+			}
+			this->pool_->release(*this->connection_);
+		}
+
+		template<typename U>
+		bool operator==(const lease_allocator<U>& other) const noexcept
+		{
+			return this->connection_ == other.connection_;
+		}
+	};
+
+	/// A thread or an asynchronous operation that waits for a connection
+	struct waiter : public std::enable_shared_from_this<waiter>
 	{
-		if (count == 0)
+		using list_type = std::list<std::shared_ptr<waiter>>;
+
+		list_type::iterator position{};
+		bool                queued{};
+		bool                woken{};      // handed a connection, or told that there is room to open one
+		pooled_connection*  connection{}; // the connection that was handed over
+
+		virtual ~waiter() = default;
+
+		/// Called after being woken, without holding the lock
+		virtual void notify() noexcept = 0;
+	};
+
+	struct blocking_waiter final : public waiter
+	{
+		std::condition_variable cv{};
+
+		void notify() noexcept override
 		{
-			ZOO_THROW_EXCEPTION(std::invalid_argument{ "count must be greater than zero" });
+			this->cv.notify_one();
 		}
+	};
 
+	struct async_waiter final : public waiter
+	{
+		std::shared_ptr<impl>                    pool;
+		boost::asio::any_io_executor             executor; // keeps the execution context busy while waiting
+		acquire_handler                          handler;
+		boost::asio::cancellation_slot           slot;
+		std::optional<boost::asio::steady_timer> timer;
+		std::optional<std::chrono::milliseconds> timeout;
+		clock_type::time_point                   started; // only set when the pool is instrumented
+
+		async_waiter(std::shared_ptr<impl>                           pool,
+		             const boost::asio::any_io_executor&             executor,
+		             acquire_handler&&                               handler,
+		             boost::asio::cancellation_slot&&                slot,
+		             const std::optional<std::chrono::milliseconds>& timeout)
+		    : pool{ std::move(pool) }
+		    , executor{ boost::asio::prefer(executor, boost::asio::execution::outstanding_work.tracked) }
+		    , handler{ std::move(handler) }
+		    , slot{ std::move(slot) }
+		    , timer{}
+		    , timeout{ timeout }
+		    , started{}
+		{
+		}
+
+		void notify() noexcept override
+		{
+			try
+			{
+				boost::asio::post(this->executor,
+				                  [self = std::static_pointer_cast<async_waiter>(this->shared_from_this())] { self->pool->resume(self); });
+			}
+			catch (const std::exception& e)
+			{
+				ZOO_LOG(err, "cannot resume an asynchronous connection acquisition: {}", e.what());
+			}
+		}
+	};
+
+	using lock_type         = std::unique_lock<std::mutex>;
+	using connection_ptr    = std::unique_ptr<pooled_connection>;
+	using optional_deadline = std::optional<clock_type::time_point>;
+
+	std::shared_ptr<const ibackend_connection_factory> factory_;
+	std::string                                        connection_info_;
+	connection_pool_options                            options_;
+	mutable std::mutex                                 mutex_;
+	std::vector<connection_ptr>                        connections_; // all open connections
+	std::vector<pooled_connection*>                    idle_;        // least recently released first
+	waiter::list_type                                  waiters_;     // first come, first served
+	std::size_t                                        opening_;     // number of connections being opened
+	connection_pool_stats                              stats_;
+
+	void open(const ibackend_connection_factory& factory, std::string_view connection_info, std::size_t count)
+	{
+		this->connections_.reserve(count);
+		this->idle_.reserve(count);
 		while (count--)
 		{
-			this->queue_.push(factory.create_backend_connection(connection_info));
+			this->connections_.push_back(std::make_unique<pooled_connection>(open_connection(factory, connection_info)));
+			this->idle_.push_back(this->connections_.back().get());
+			++this->stats_.created;
 		}
 	}
 
-	/// Waits indefinitely until the pool has a connection available.
-	std::shared_ptr<ibackend_connection> acquire()
+	connection_ptr remove(const lock_type&, pooled_connection* connection)
 	{
-		lock_type lock(mutex_);
+		const auto it = std::find_if(
+		    this->connections_.begin(), this->connections_.end(), [connection](const connection_ptr& c) { return c.get() == connection; });
+		assert(it != this->connections_.end());
+		auto result = std::move(*it);
+		*it         = std::move(this->connections_.back());
+		this->connections_.pop_back();
+		++this->stats_.closed;
+		return result;
+	}
 
-		while (this->queue_.empty())
+	// Move the connections above the minimum that were idle for too long to @a expired, to be closed outside the lock
+	void collect_expired(const lock_type& lock, std::vector<connection_ptr>& expired)
+	{
+		if (this->options_.idle_timeout.count() <= 0)
 		{
-			this->cv_.wait(lock);
+			return;
 		}
 
-		return this->acquire_from_front_of_queue(lock);
+		const auto limit = clock_type::now() - this->options_.idle_timeout;
+		while (!this->idle_.empty() && this->connections_.size() > this->options_.min_size && this->idle_.front()->idle_since < limit)
+		{
+			expired.push_back(this->remove(lock, this->idle_.front()));
+			this->idle_.erase(this->idle_.begin());
+		}
 	}
 
-	/// Returns nullptr if no connection is available within the specified timeout.
-	std::shared_ptr<ibackend_connection> acquire(const std::chrono::milliseconds& timeout)
+	// Take the most recently released idle connection, without waiting.
+	// If there is none, set @a open if there is room to open a new connection, which the caller must then do with
+	// open_reserved(). Waiters come first, unless the caller has @a priority because it was woken or it discarded a
+	// connection itself.
+	pooled_connection* try_take(const lock_type& lock, std::vector<connection_ptr>& expired, bool priority, bool& open)
 	{
-		lock_type lock(mutex_);
+		this->collect_expired(lock, expired);
+
+		// There are no idle connections while there are waiters, release() hands them over
+		if (!this->idle_.empty())
+		{
+			const auto connection = this->idle_.back();
+			this->idle_.pop_back();
+			return connection;
+		}
+
+		if (this->factory_ && this->connections_.size() + this->opening_ < this->options_.max_size && (priority || this->waiters_.empty()))
+		{
+			++this->opening_;
+			open = true;
+		}
+
+		return nullptr;
+	}
 
-		while (this->queue_.empty())
+	pooled_connection* open_reserved()
+	{
+		connection_ptr connection{};
+		try
+		{
+			connection = std::make_unique<pooled_connection>(open_connection(*this->factory_, this->connection_info_));
+		}
+		catch (...)
 		{
-			if (this->cv_.wait_for(lock, timeout) == std::cv_status::timeout)
+			std::shared_ptr<waiter> woken{};
 			{
-				return nullptr;
+				lock_type lock{ this->mutex_ };
+				--this->opening_;
+				woken = this->wake_first(lock, nullptr); // someone else may succeed
 			}
+			if (woken)
+			{
+				woken->notify();
+			}
+			throw;
 		}
 
-		return this->acquire_from_front_of_queue(lock);
+		lock_type lock{ this->mutex_ };
+		--this->opening_;
+		++this->stats_.created;
+		const auto result = connection.get();
+		this->connections_.push_back(std::move(connection));
+		this->idle_.reserve(this->connections_.size()); // so that release() does not allocate
+		return result;
+	}
+
+	void enqueue(const lock_type&, std::shared_ptr<waiter> w, bool front)
+	{
+		w->position = this->waiters_.insert(front ? this->waiters_.begin() : this->waiters_.end(), w);
+		w->queued   = true;
 	}
 
-	std::shared_ptr<ibackend_connection> try_acquire()
+	void dequeue(const lock_type&, waiter& w)
 	{
-		lock_type lock(mutex_);
+		assert(w.queued);
+		this->waiters_.erase(w.position);
+		w.queued = false;
+	}
 
-		if (this->queue_.empty())
+	// Remove the first waiter from the queue and hand it @a connection, or tell it that there is room for a new connection.
+	// The caller must notify the returned waiter, if any, after releasing the lock.
+	std::shared_ptr<waiter> wake_first(const lock_type& lock, pooled_connection* connection)
+	{
+		if (this->waiters_.empty())
 		{
 			return nullptr;
 		}
+
+		auto w = this->waiters_.front();
+		this->dequeue(lock, *w);
+		w->woken      = true;
+		w->connection = connection;
+		return w;
+	}
+
+	void discard(pooled_connection* connection)
+	{
+		ZOO_LOG(warn, "discarding a pooled connection that is not valid");
+
+		connection_ptr removed{}; // destroyed after the lock is released
+		{
+			lock_type lock{ this->mutex_ };
+			removed = this->remove(lock, connection);
+		}
+	}
+
+	// Validate an idle connection that was taken, discarding it if it is not valid.
+	bool validate(pooled_connection* connection)
+	{
+		if (!this->options_.validate_on_borrow || connection->backend->is_valid())
+		{
+			return true;
+		}
+		this->discard(connection);
+		return false;
+	}
+
+	std::shared_ptr<ibackend_connection> lease(pooled_connection& connection)
+	{
+		// The deleter does nothing, the allocator returns the connection to the pool
+		return std::shared_ptr<ibackend_connection>{ &connection.wrapper,
+			                                         [](ibackend_connection*) {},
+			                                         lease_allocator<ibackend_connection>{ this->shared_from_this(), &connection } };
+	}
+
+	void release(pooled_connection& connection) noexcept
+	{
+		std::shared_ptr<waiter> woken{};
+		{
+			lock_type lock{ this->mutex_ };
+			woken = this->wake_first(lock, &connection);
+			if (!woken)
+			{
+				connection.idle_since = clock_type::now();
+				this->idle_.push_back(&connection);
+			}
+		}
+		if (woken)
+		{
+			woken->notify();
+		}
+	}
+
+	// Invoke the handler of @a op through its executor
+	void complete(const std::shared_ptr<async_waiter>& op, std::exception_ptr e, std::shared_ptr<ibackend_connection> connection)
+	{
+		{
+			lock_type lock{ this->mutex_ };
+			if (op->timer)
+			{
+				op->timer->cancel();
+			}
+		}
+
+		if (connection && this->options_.instrumentation)
+		{
+			this->options_.instrumentation->on_pool_wait(clock_type::now() - op->started);
+		}
+
+		boost::asio::post(op->executor, [op, e = std::move(e), connection = std::move(connection)]() mutable {
+			// Not in the cancellation handler itself, which may be what completed the operation
+			if (op->slot.is_connected())
+			{
+				op->slot.clear();
+			}
+			auto handler = std::move(op->handler);
+			handler(std::move(e), std::move(connection));
+		});
+	}
+
+	// Stop waiting because of a timeout or cancellation, unless @a op was woken already
+	void abandon(const std::shared_ptr<async_waiter>& op, std::exception_ptr e)
+	{
+		{
+			lock_type lock{ this->mutex_ };
+			if (!op->queued)
+			{
+				return;
+			}
+			this->dequeue(lock, *op);
+		}
+
+		this->complete(op, std::move(e), nullptr);
+	}
+
+	// Take or open a connection for @a op, or make it wait
+	void try_complete(const std::shared_ptr<async_waiter>& op, bool priority)
+	{
+		for (;;)
+		{
+			pooled_connection* connection{};
+			auto               open = false;
+			{
+				std::vector<connection_ptr> expired{}; // destroyed after the lock is released
+				lock_type                   lock{ this->mutex_ };
+
+				connection = this->try_take(lock, expired, priority, open);
+				if (!connection && !open)
+				{
+					this->enqueue(lock, op, priority);
+
+					if (op->timeout && !op->timer)
+					{
+						const auto weak_op = std::weak_ptr<async_waiter>{ op };
+						op->timer.emplace(op->executor, op->timeout.value());
+						op->timer->async_wait([weak_op](const boost::system::error_code& ec) {
+							if (ec != boost::asio::error::operation_aborted)
+							{
+								if (const auto op = weak_op.lock())
+								{
+									op->pool->abandon(op, std::make_exception_ptr(no_connection_available{}));
+								}
+							}
+						});
+					}
+
+					if (op->slot.is_connected() && !op->slot.has_handler())
+					{
+						const auto weak_op = std::weak_ptr<async_waiter>{ op };
+						op->slot.assign([weak_op](boost::asio::cancellation_type) {
+							if (const auto op = weak_op.lock())
+							{
+								op->pool->abandon(op,
+								                  std::make_exception_ptr(boost::system::system_error{ boost::asio::error::operation_aborted }));
+							}
+						});
+					}
+
+					return;
+				}
+			}
+
+			try
+			{
+				if (open)
+				{
+					this->complete(op, nullptr, this->lease(*this->open_reserved()));
+					return;
+				}
+				else if (this->validate(connection))
+				{
+					this->complete(op, nullptr, this->lease(*connection));
+					return;
+				}
+			}
+			catch (...)
+			{
+				this->complete(op, std::current_exception(), nullptr);
+				return;
+			}
+
+			priority = true;
+		}
+	}
+
+	// Continue @a op after it was woken, on its executor
+	void resume(const std::shared_ptr<async_waiter>& op)
+	{
+		if (op->connection)
+		{
+			// Handed over by release(), it was in use until now, so it does not need to be validated
+			this->complete(op, nullptr, this->lease(*std::exchange(op->connection, nullptr)));
+		}
 		else
 		{
-			return this->acquire_from_front_of_queue(lock);
+			this->try_complete(op, true);
+		}
+	}
+
+public:
+	impl(std::shared_ptr<const ibackend_connection_factory> factory, std::string_view connection_info, const connection_pool_options& options)
+	    : factory_{ std::move(factory) }
+	    , connection_info_{ connection_info }
+	    , options_{ options }
+	    , mutex_{}
+	    , connections_{}
+	    , idle_{}
+	    , waiters_{}
+	    , opening_{}
+	    , stats_{}
+	{
+		if (!this->factory_)
+		{
+			ZOO_THROW_EXCEPTION(std::invalid_argument{ "factory must not be null" });
+		}
+		if (options.max_size == 0)
+		{
+			ZOO_THROW_EXCEPTION(std::invalid_argument{ "max_size must be greater than zero" });
+		}
+		if (options.min_size > options.max_size)
+		{
+			ZOO_THROW_EXCEPTION(std::invalid_argument{ "min_size must not be greater than max_size" });
+		}
+
+		this->open(*this->factory_, this->connection_info_, options.min_size);
+	}
+
+	impl(const ibackend_connection_factory& factory, std::string_view connection_info, std::size_t count)
+	    : factory_{}
+	    , connection_info_{}
+	    , options_{ .min_size = count, .max_size = count, .validate_on_borrow = false }
+	    , mutex_{}
+	    , connections_{}
+	    , idle_{}
+	    , waiters_{}
+	    , opening_{}
+	    , stats_{}
+	{
+		if (count == 0)
+		{
+			ZOO_THROW_EXCEPTION(std::invalid_argument{ "count must be greater than zero" });
+		}
+
+		// The factory is not kept, so the pool cannot replace connections and it does not validate them.
+		this->open(factory, connection_info, count);
+	}
+
+	impl(const impl&)            = delete;
+	impl& operator=(const impl&) = delete;
+
+	/// Waits until @a deadline (or indefinitely) until the pool has a connection available.
+	std::shared_ptr<ibackend_connection> acquire(const optional_deadline& deadline)
+	{
+		if (!this->options_.instrumentation)
+		{
+			return this->take_or_wait(deadline);
+		}
+
+		const auto start      = clock_type::now();
+		auto       connection = this->take_or_wait(deadline);
+		if (connection)
+		{
+			this->options_.instrumentation->on_pool_wait(clock_type::now() - start);
 		}
+		return connection;
 	}
 
-private:
-	std::shared_ptr<ibackend_connection> acquire_from_front_of_queue(const lock_type&)
+	std::shared_ptr<ibackend_connection> take_or_wait(const optional_deadline& deadline)
 	{
-		auto connection = this->queue_.front();
-		this->queue_.pop();
+		auto priority = false;
+		for (;;)
+		{
+			pooled_connection*               connection{};
+			auto                             open = false;
+			std::shared_ptr<blocking_waiter> w{};
+			{
+				std::vector<connection_ptr> expired{}; // destroyed after the lock is released
+				lock_type                   lock{ this->mutex_ };
+
+				connection = this->try_take(lock, expired, priority, open);
+				if (!connection && !open)
+				{
+					if (deadline && deadline.value() <= clock_type::now())
+					{
+						return nullptr;
+					}
+
+					w = std::make_shared<blocking_waiter>();
+					this->enqueue(lock, w, priority);
+
+					const auto woken = [&w] { return w->woken; };
+					if (!deadline)
+					{
+						w->cv.wait(lock, woken);
+					}
+					else if (!w->cv.wait_until(lock, deadline.value(), woken))
+					{
+						this->dequeue(lock, *w);
+						return nullptr;
+					}
+
+					connection = w->connection;
+				}
+			}
 
-		return std::make_shared<backend_connection_wrapper>(
-		    std::move(connection), [this](std::shared_ptr<ibackend_connection>&& connection) { this->release(std::move(connection)); });
+			if (open)
+			{
+				return this->lease(*this->open_reserved());
+			}
+			else if (w && connection)
+			{
+				// Handed over by release(), it was in use until now, so it does not need to be validated
+				return this->lease(*connection);
+			}
+			else if (connection && this->validate(connection))
+			{
+				return this->lease(*connection);
+			}
+
+			// Woken because there is room for a new connection, or the connection was discarded
+			priority = true;
+		}
 	}
 
-	void release(std::shared_ptr<ibackend_connection>&& connection)
+	void async_acquire(const boost::asio::any_io_executor&             executor,
+	                   const std::optional<std::chrono::milliseconds>& timeout,
+	                   boost::asio::cancellation_slot                  slot,
+	                   acquire_handler                                 handler)
 	{
+		const auto op = std::make_shared<async_waiter>(this->shared_from_this(), executor, std::move(handler), std::move(slot), timeout);
+		if (this->options_.instrumentation)
 		{
-			lock_type lock(mutex_);
-			this->queue_.push(connection);
+			op->started = clock_type::now();
 		}
-		this->cv_.notify_one();
+		this->try_complete(op, false);
+	}
+
+	connection_pool_stats stats() const
+	{
+		std::lock_guard<std::mutex> lock{ this->mutex_ };
+
+		auto result    = this->stats_;
+		result.size    = this->connections_.size();
+		result.idle    = this->idle_.size();
+		result.waiting = this->waiters_.size();
+		return result;
 	}
 };
 
 connection_pool::connection_pool(const ibackend_connection_factory& factory, std::string_view connection_info, std::size_t count)
-    : pimpl_{ std::make_unique<impl>(factory, connection_info, count) }
+    : pimpl_{ std::make_shared<impl>(factory, connection_info, count) }
+{
+}
+
+connection_pool::connection_pool(std::shared_ptr<const ibackend_connection_factory> factory,
+                                 std::string_view                                   connection_info,
+                                 const connection_pool_options&                     options)
+    : pimpl_{ std::make_shared<impl>(std::move(factory), connection_info, options) }
 {
 }
 
@@ -158,17 +725,30 @@ connection_pool& connection_pool::operator=(connection_pool&&) = default;
 
 std::shared_ptr<ibackend_connection> connection_pool::acquire()
 {
-	return this->pimpl_->acquire();
+	return this->pimpl_->acquire(std::nullopt);
 }
 
 std::shared_ptr<ibackend_connection> connection_pool::acquire(const std::chrono::milliseconds& timeout)
 {
-	return this->pimpl_->acquire(timeout);
+	return this->pimpl_->acquire(clock_type::now() + timeout);
 }
 
 std::shared_ptr<ibackend_connection> connection_pool::try_acquire()
 {
-	return this->pimpl_->try_acquire();
+	return this->pimpl_->acquire(clock_type::now());
+}
+
+void connection_pool::start_async_acquire(const boost::asio::any_io_executor&             executor,
+                                          const std::optional<std::chrono::milliseconds>& timeout,
+                                          boost::asio::cancellation_slot                  slot,
+                                          acquire_handler                                 handler)
+{
+	this->pimpl_->async_acquire(executor, timeout, std::move(slot), std::move(handler));
+}
+
+connection_pool_stats connection_pool::stats() const
+{
+	return this->pimpl_->stats();
 }
 
 } // namespace squid
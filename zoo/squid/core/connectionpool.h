@@ -10,23 +10,79 @@
 #include "zoo/squid/core/config.h"
 #include "zoo/squid/core/ibackendconnectionfwd.h"
 #include "zoo/squid/core/ibackendconnectionfactoryfwd.h"
+#include "zoo/squid/core/iqueryinstrumentation.h"
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/associated_cancellation_slot.hpp>
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/cancellation_signal.hpp>
 
 #include <memory>
 #include <string_view>
 #include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <optional>
+#include <utility>
 
 namespace zoo {
 namespace squid {
 
+/// Sizing and health check options of a connection_pool
+struct connection_pool_options final
+{
+	std::size_t                             min_size{ 0 };              //!< Number of connections opened up front and kept open when idle
+	std::size_t                             max_size{ 8 };              //!< Maximum number of open connections
+	std::chrono::milliseconds               idle_timeout{ 0 };          //!< Close connections above min_size that are idle for longer, zero disables
+	bool                                    validate_on_borrow{ true }; //!< Check an idle connection with ibackend_connection::is_valid() before handing it out
+	std::shared_ptr<iquery_instrumentation> instrumentation{};          //!< Receives the time each successful acquisition took, null disables
+};
+
+/// Statistics of a connection_pool
+struct connection_pool_stats final
+{
+	std::size_t   size{};    //!< Number of open connections
+	std::size_t   idle{};    //!< Number of open connections that are not in use
+	std::uint64_t created{}; //!< Number of connections that were opened
+	std::uint64_t closed{};  //!< Number of connections that were closed because they were idle too long or not valid
+	std::size_t   waiting{}; //!< Number of threads and asynchronous operations waiting for a connection
+};
+
+/// Thread safe pool of backend connections.
+/// Connections are opened when they are needed, up to a maximum, and the most recently released connection
+/// is handed out first, so that a few connections stay warm while the others can time out.
+/// When no connection is available, waiting threads and asynchronous operations are served in FIFO order.
 class ZOO_SQUID_CORE_API connection_pool final
 {
 	class impl;
-	std::unique_ptr<impl> pimpl_;
+	std::shared_ptr<impl> pimpl_;
+
+	using acquire_handler = std::function<void(std::exception_ptr, std::shared_ptr<ibackend_connection>)>;
+
+	void start_async_acquire(const boost::asio::any_io_executor&             executor,
+	                         const std::optional<std::chrono::milliseconds>& timeout,
+	                         boost::asio::cancellation_slot                  slot,
+	                         acquire_handler                                 handler);
+
+	template<typename CompletionToken>
+	auto initiate_async_acquire(const boost::asio::any_io_executor& executor, const std::optional<std::chrono::milliseconds>& timeout, CompletionToken&& token);
 
 public:
+	/// Signature of the completion handler of async_acquire
+	using acquire_signature = void(std::exception_ptr, std::shared_ptr<ibackend_connection>);
 	/// Create a pool of @a count connections using the connection factory @a factory and a connection
 	/// string @a connection_info passed to the backend.
+	/// All connections are opened up front.
 	connection_pool(const ibackend_connection_factory& factory, std::string_view connection_info, std::size_t count);
+
+	/// Create a pool that opens connections with the connection factory @a factory and a connection
+	/// string @a connection_info passed to the backend, sized according to @a options.
+	/// Only @a options.min_size connections are opened up front, the others when they are needed.
+	connection_pool(std::shared_ptr<const ibackend_connection_factory> factory,
+	                std::string_view                                   connection_info,
+	                const connection_pool_options&                     options);
 	~connection_pool() noexcept;
 
 	connection_pool(connection_pool&&);
@@ -46,7 +102,54 @@ public:
 	/// Acquire a backend connection
 	/// Immediately returns nullptr if no connection is available.
 	std::shared_ptr<ibackend_connection> try_acquire();
+
+	/// Acquire a backend connection asynchronously
+	/// Completes when the pool has a connection available, without blocking a thread while waiting.
+	/// The completion handler is invoked through @a executor, unless it has an associated executor.
+	/// Per-operation cancellation is supported, the operation then completes with a
+	/// boost::system::system_error (boost::asio::error::operation_aborted).
+	/// Opening a new connection is done synchronously when the operation starts, by the calling thread.
+	template<typename CompletionToken>
+	auto async_acquire(const boost::asio::any_io_executor& executor, CompletionToken&& token)
+	{
+		return this->initiate_async_acquire(executor, std::nullopt, std::forward<CompletionToken>(token));
+	}
+
+	/// Acquire a backend connection asynchronously with timeout
+	/// Completes with a @c no_connection_available exception if no connection is available within the specified timeout.
+	template<typename CompletionToken>
+	auto async_acquire(const boost::asio::any_io_executor& executor, const std::chrono::milliseconds& timeout, CompletionToken&& token)
+	{
+		return this->initiate_async_acquire(executor, timeout, std::forward<CompletionToken>(token));
+	}
+
+	/// Get the current statistics of the pool
+	connection_pool_stats stats() const;
 };
 
+template<typename CompletionToken>
+auto connection_pool::initiate_async_acquire(const boost::asio::any_io_executor&             executor,
+                                             const std::optional<std::chrono::milliseconds>& timeout,
+                                             CompletionToken&&                               token)
+{
+	return boost::asio::async_initiate<CompletionToken, acquire_signature>(
+	    [this](auto handler, const boost::asio::any_io_executor& executor, const std::optional<std::chrono::milliseconds>& timeout) {
+		    auto slot             = boost::asio::get_associated_cancellation_slot(handler);
+		    auto handler_executor = boost::asio::get_associated_executor(handler, executor);
+
+		    // The handler may be move-only, std::function needs a copyable target
+		    auto shared_handler = std::make_shared<decltype(handler)>(std::move(handler));
+		    this->start_async_acquire(handler_executor,
+		                              timeout,
+		                              std::move(slot),
+		                              [shared_handler](std::exception_ptr e, std::shared_ptr<ibackend_connection> connection) {
+			                              std::move(*shared_handler)(std::move(e), std::move(connection));
+		                              });
+	    },
+	    token,
+	    executor,
+	    timeout);
+}
+
 } // namespace squid
 } // namespace zoo
@@ -0,0 +1,219 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/core/deadline.h"
+#include "zoo/squid/core/ibackendconnection.h"
+
+#include "zoo/common/logging/logging.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace zoo {
+namespace squid {
+
+deadline_exceeded::deadline_exceeded()
+    : error{ "Deadline exceeded" }
+{
+}
+
+deadline::deadline(const clock_type::time_point& at)
+    : at_{ at }
+{
+}
+
+deadline deadline::after(const std::chrono::milliseconds& timeout)
+{
+	return deadline{ clock_type::now() + timeout };
+}
+
+const deadline::clock_type::time_point& deadline::at() const noexcept
+{
+	return this->at_;
+}
+
+bool deadline::expired() const
+{
+	return clock_type::now() >= this->at_;
+}
+
+std::chrono::milliseconds deadline::remaining() const
+{
+	const auto left = std::chrono::ceil<std::chrono::milliseconds>(this->at_ - clock_type::now());
+	return std::max(left, std::chrono::milliseconds::zero());
+}
+
+struct deadline_guard::watch final
+{
+	std::weak_ptr<ibackend_connection> connection;
+	const ibackend_connection*         key; // identifies the connection, also when it is gone
+	deadline::clock_type::time_point   at;
+	bool                               fired;      // the watchdog has handled the deadline
+	bool                               cancelling; // the watchdog is cancelling the statement
+};
+
+/// Cancels the statements of the watches that have expired
+class deadline_guard::watchdog final
+{
+	using lock_type = std::unique_lock<std::mutex>;
+
+	std::mutex                        mutex_;
+	std::condition_variable           cv_;        // signals a new watch, or stopping
+	std::condition_variable           cancelled_; // signals the end of a cancellation
+	std::list<std::shared_ptr<watch>> watches_;
+	std::atomic<std::size_t>          size_; // number of watches, read without the lock
+	bool                              stopping_;
+	std::thread                       thread_; // started with the first watch
+
+	void run()
+	{
+		lock_type lock{ this->mutex_ };
+		while (!this->stopping_)
+		{
+			std::optional<deadline::clock_type::time_point> next{};
+			std::shared_ptr<watch>                          due{};
+
+			const auto now = deadline::clock_type::now();
+			for (const auto& w : this->watches_)
+			{
+				if (w->fired)
+				{
+					continue;
+				}
+				if (w->at <= now)
+				{
+					due = w;
+					break;
+				}
+				next = next ? std::min(next.value(), w->at) : w->at;
+			}
+
+			if (due)
+			{
+				due->fired      = true;
+				due->cancelling = true;
+				const auto connection = due->connection.lock();
+				lock.unlock();
+				if (connection)
+				{
+					try
+					{
+						connection->cancel();
+					}
+					catch (const std::exception& e)
+					{
+						ZOO_LOG(warn, "cannot cancel a statement that exceeded its deadline: {}", e.what());
+					}
+				}
+				lock.lock();
+				due->cancelling = false;
+				this->cancelled_.notify_all();
+			}
+			else if (next)
+			{
+				this->cv_.wait_until(lock, next.value());
+			}
+			else
+			{
+				this->cv_.wait(lock);
+			}
+		}
+	}
+
+public:
+	watchdog()
+	    : mutex_{}
+	    , cv_{}
+	    , cancelled_{}
+	    , watches_{}
+	    , size_{}
+	    , stopping_{}
+	    , thread_{}
+	{
+	}
+
+	~watchdog() noexcept
+	{
+		{
+			std::lock_guard<std::mutex> lock{ this->mutex_ };
+			this->stopping_ = true;
+		}
+		this->cv_.notify_all();
+		if (this->thread_.joinable())
+		{
+			this->thread_.join();
+		}
+	}
+
+	static watchdog& instance()
+	{
+		static watchdog _;
+		return _;
+	}
+
+	void add(const std::shared_ptr<watch>& w)
+	{
+		{
+			std::lock_guard<std::mutex> lock{ this->mutex_ };
+			if (!this->thread_.joinable())
+			{
+				this->thread_ = std::thread{ [this] { this->run(); } };
+			}
+			this->watches_.push_back(w);
+			++this->size_;
+		}
+		this->cv_.notify_all();
+	}
+
+	void remove(const std::shared_ptr<watch>& w)
+	{
+		lock_type lock{ this->mutex_ };
+		this->cancelled_.wait(lock, [&w] { return !w->cancelling; });
+		this->watches_.remove(w);
+		--this->size_;
+	}
+
+	bool expired(const ibackend_connection& connection)
+	{
+		if (this->size_ == 0u)
+		{
+			return false;
+		}
+		const auto                  now = deadline::clock_type::now();
+		std::lock_guard<std::mutex> lock{ this->mutex_ };
+		return std::any_of(this->watches_.begin(), this->watches_.end(), [&](const auto& w) { return w->key == &connection && w->at <= now; });
+	}
+};
+
+deadline_guard::deadline_guard(std::shared_ptr<ibackend_connection> connection, const deadline& deadline)
+    : watch_{ std::make_shared<watch>(watch{ connection, connection.get(), deadline.at(), false, false }) }
+{
+	watchdog::instance().add(this->watch_);
+}
+
+deadline_guard::~deadline_guard() noexcept
+{
+	watchdog::instance().remove(this->watch_);
+}
+
+bool deadline_guard::expired() const
+{
+	return deadline::clock_type::now() >= this->watch_->at;
+}
+
+bool deadline_guard::expired(const ibackend_connection& connection)
+{
+	return watchdog::instance().expired(connection);
+}
+
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,86 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/core/config.h"
+#include "zoo/squid/core/error.h"
+#include "zoo/squid/core/ibackendconnectionfwd.h"
+
+#include <chrono>
+#include <memory>
+
+namespace zoo {
+namespace squid {
+
+/// Thrown when work is not done by its deadline
+class ZOO_SQUID_CORE_API deadline_exceeded : public error
+{
+public:
+	deadline_exceeded();
+};
+
+/// The point in time by which work must be done.
+/// One deadline can be passed along from acquiring a connection to the statements of a transaction,
+/// so that the time that all of these may take together is bounded.
+class ZOO_SQUID_CORE_API deadline final
+{
+public:
+	using clock_type = std::chrono::steady_clock;
+
+	explicit deadline(const clock_type::time_point& at);
+
+	/// Create a deadline that is @a timeout from now
+	static deadline after(const std::chrono::milliseconds& timeout);
+
+	const clock_type::time_point& at() const noexcept;
+
+	/// Check whether the deadline has passed
+	bool expired() const;
+
+	/// Get the time left until the deadline, zero when it has passed
+	std::chrono::milliseconds remaining() const;
+
+	friend bool operator<(const deadline& lhs, const deadline& rhs) noexcept
+	{
+		return lhs.at_ < rhs.at_;
+	}
+
+private:
+	clock_type::time_point at_;
+};
+
+/// Watches a deadline of the work on a backend connection.
+/// When the deadline passes while the guard exists, the statement that is executing on the connection is
+/// cancelled with ibackend_connection::cancel(), so that it fails instead of holding the connection and the
+/// calling thread. Statements that are started on the connection after the deadline passed fail right away.
+/// All guards are watched by one thread, which is started when the first guard is created.
+/// The destructor waits for a cancellation that is in progress, so that it cannot hit a later statement.
+class ZOO_SQUID_CORE_API deadline_guard final
+{
+	struct watch;
+	class watchdog;
+	std::shared_ptr<watch> watch_;
+
+public:
+	explicit deadline_guard(std::shared_ptr<ibackend_connection> connection, const deadline& deadline);
+	~deadline_guard() noexcept;
+
+	deadline_guard(const deadline_guard&)            = delete;
+	deadline_guard(deadline_guard&&)                 = delete;
+	deadline_guard& operator=(const deadline_guard&) = delete;
+	deadline_guard& operator=(deadline_guard&&)      = delete;
+
+	/// Check whether the deadline has passed
+	bool expired() const;
+
+	/// Check whether the deadline of a guard of @a connection has passed
+	static bool expired(const ibackend_connection& connection);
+};
+
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,55 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <boost/describe.hpp>
+#include <boost/mp11.hpp>
+
+#include <array>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+
+namespace zoo {
+namespace squid {
+
+/// A struct or class that is described with BOOST_DESCRIBE_STRUCT or BOOST_DESCRIBE_CLASS
+template<class T>
+concept is_described_struct = std::is_class_v<T> && boost::describe::has_describe_members<T>::value;
+
+/// The public data members of a described struct, in declaration order
+template<class T>
+using described_members = boost::describe::describe_members<T, boost::describe::mod_public>;
+
+namespace described {
+
+template<class... D>
+constexpr std::array<std::string_view, sizeof...(D)> member_names(boost::mp11::mp_list<D...>)
+{
+	return { std::string_view{ D::name }... };
+}
+
+// Only the address matters, it identifies a type without RTTI
+template<class T>
+inline constexpr char type_key{};
+
+} // namespace described
+
+/// Names of the public data members of a described struct, in declaration order, computed at compile time
+template<class T>
+inline constexpr auto described_member_names = described::member_names(described_members<T>{});
+
+/// Call @a f(member) for each public data member of the described struct @a value, in declaration order
+template<class T, class F>
+void for_each_described_member(T& value, F&& f)
+{
+	boost::mp11::mp_for_each<described_members<std::remove_const_t<T>>>([&](auto D) { f(value.*D.pointer); });
+}
+
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,25 @@
+//
+// Copyright (C) 2022-2024 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+namespace zoo {
+namespace squid {
+
+/// Determines how the rows of a query result are transferred from the database server.
+enum class fetch_mode
+{
+	/// The complete result is received before the first row can be fetched.
+	buffered,
+	/// Rows are received while they are fetched, so the memory use does not depend on the size of the result.
+	/// While rows are pending, the connection cannot be used by another statement.
+	/// Backends that always stream (e.g. SQLite) or that cannot stream treat this as a hint.
+	streaming
+};
+
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,145 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/core/hdrhistogram.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <functional>
+#include <limits>
+
+namespace zoo {
+namespace squid {
+
+hdr_histogram::hdr_histogram()
+    : counts_{}
+    , count_{}
+    , min_{}
+    , max_{}
+    , sum_{}
+{
+}
+
+std::size_t hdr_histogram::bucket_index(std::uint64_t value) noexcept
+{
+	if (value < sub_bucket_count)
+	{
+		return static_cast<std::size_t>(value);
+	}
+	// The shift brings the value in [sub_bucket_count, 2 * sub_bucket_count)
+	const auto shift = static_cast<unsigned>(std::bit_width(value)) - sub_bucket_bits - 1u;
+	return static_cast<std::size_t>(shift + 1u) * sub_bucket_count + static_cast<std::size_t>((value >> shift) - sub_bucket_count);
+}
+
+std::uint64_t hdr_histogram::highest_equivalent_value(std::size_t index) noexcept
+{
+	if (index < sub_bucket_count)
+	{
+		return static_cast<std::uint64_t>(index);
+	}
+	const auto shift = static_cast<unsigned>(index / sub_bucket_count) - 1u;
+	const auto first = (static_cast<std::uint64_t>(sub_bucket_count) + index % sub_bucket_count) << shift;
+	return first + ((std::uint64_t{ 1 } << shift) - 1u);
+}
+
+void hdr_histogram::record(std::uint64_t value)
+{
+	const auto index = bucket_index(value);
+	if (index >= this->counts_.size())
+	{
+		this->counts_.resize(index + 1u);
+	}
+	++this->counts_[index];
+
+	this->min_ = this->count_ == 0u ? value : std::min(this->min_, value);
+	this->max_ = std::max(this->max_, value);
+	this->sum_ += static_cast<long double>(value);
+	++this->count_;
+}
+
+void hdr_histogram::merge(const hdr_histogram& other)
+{
+	if (other.count_ == 0u)
+	{
+		return;
+	}
+	if (other.counts_.size() > this->counts_.size())
+	{
+		this->counts_.resize(other.counts_.size());
+	}
+	std::transform(other.counts_.begin(), other.counts_.end(), this->counts_.begin(), this->counts_.begin(), std::plus<>{});
+
+	this->min_ = this->count_ == 0u ? other.min_ : std::min(this->min_, other.min_);
+	this->max_ = std::max(this->max_, other.max_);
+	this->sum_ += other.sum_;
+	this->count_ += other.count_;
+}
+
+std::uint64_t hdr_histogram::count() const noexcept
+{
+	return this->count_;
+}
+
+bool hdr_histogram::empty() const noexcept
+{
+	return this->count_ == 0u;
+}
+
+std::uint64_t hdr_histogram::min() const noexcept
+{
+	return this->min_;
+}
+
+std::uint64_t hdr_histogram::max() const noexcept
+{
+	return this->max_;
+}
+
+double hdr_histogram::sum() const noexcept
+{
+	return static_cast<double>(this->sum_);
+}
+
+double hdr_histogram::mean() const noexcept
+{
+	return this->count_ == 0u ? 0.0 : static_cast<double>(this->sum_ / static_cast<long double>(this->count_));
+}
+
+std::uint64_t hdr_histogram::value_at_percentile(double percentile) const noexcept
+{
+	if (this->count_ == 0u)
+	{
+		return 0u;
+	}
+
+	const auto fraction = std::clamp(percentile, 0.0, 100.0) / 100.0;
+	const auto target   = std::max(std::uint64_t{ 1 }, static_cast<std::uint64_t>(std::ceil(fraction * static_cast<double>(this->count_))));
+
+	auto total = std::uint64_t{};
+	for (auto index = std::size_t{}; index < this->counts_.size(); ++index)
+	{
+		total += this->counts_[index];
+		if (total >= target)
+		{
+			return std::min(highest_equivalent_value(index), this->max_);
+		}
+	}
+	return this->max_;
+}
+
+void hdr_histogram::reset() noexcept
+{
+	std::fill(this->counts_.begin(), this->counts_.end(), std::uint64_t{});
+	this->count_ = 0u;
+	this->min_   = 0u;
+	this->max_   = 0u;
+	this->sum_   = 0.0L;
+}
+
+} // namespace squid
+} // namespace zoo
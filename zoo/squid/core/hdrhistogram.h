@@ -0,0 +1,67 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/core/config.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+
+/// Histogram of non-negative integer values with a fixed relative precision, in the style of HdrHistogram.
+/// Values below 64 are counted exactly, larger values in buckets whose width is at most 1/64 of their lower bound,
+/// so recording is a few shifts and an increment, and the memory use grows with the logarithm of the largest value.
+/// Not thread safe.
+class ZOO_SQUID_CORE_API hdr_histogram final
+{
+	std::vector<std::uint64_t> counts_; // grown up to the bucket of the largest value
+	std::uint64_t              count_;
+	std::uint64_t              min_;
+	std::uint64_t              max_;
+	long double                sum_;
+
+public:
+	static constexpr unsigned    sub_bucket_bits  = 6u;
+	static constexpr std::size_t sub_bucket_count = std::size_t{ 1 } << sub_bucket_bits;
+
+	hdr_histogram();
+
+	/// Get the index of the bucket of @a value
+	static std::size_t bucket_index(std::uint64_t value) noexcept;
+
+	/// Get the largest value that is counted in bucket @a index
+	static std::uint64_t highest_equivalent_value(std::size_t index) noexcept;
+
+	void record(std::uint64_t value);
+
+	/// Add the counts of @a other to this histogram
+	void merge(const hdr_histogram& other);
+
+	std::uint64_t count() const noexcept;
+	bool          empty() const noexcept;
+
+	/// Get the exact minimum and maximum, 0 when empty
+	std::uint64_t min() const noexcept;
+	std::uint64_t max() const noexcept;
+
+	/// Get the exact sum and mean of the recorded values, 0 when empty
+	double sum() const noexcept;
+	double mean() const noexcept;
+
+	/// Get the value below or at which @a percentile percent of the recorded values are, 0 when empty.
+	/// Like HdrHistogram, this is the highest value that is equivalent to the recorded value, capped by max().
+	std::uint64_t value_at_percentile(double percentile) const noexcept;
+
+	void reset() noexcept;
+};
+
+} // namespace squid
+} // namespace zoo
@@ -6,11 +6,19 @@
 //
 
 #include "zoo/squid/core/ibackendconnection.h"
+#include "zoo/squid/core/error.h"
+
+#include "zoo/common/misc/throw_exception.h"
 
 namespace zoo {
 namespace squid {
 
 ibackend_connection::~ibackend_connection() noexcept = default;
 
+void ibackend_connection::cancel()
+{
+	ZOO_THROW_EXCEPTION(error{ "This backend does not support cancelling statements" });
+}
+
 } // namespace squid
 } // namespace zoo
@@ -9,6 +9,7 @@
 
 #include "zoo/squid/core/config.h"
 #include "zoo/squid/core/ibackendstatementfwd.h"
+#include "zoo/squid/core/statementcache.h"
 
 #include <memory>
 #include <string_view>
@@ -25,6 +26,22 @@ public:
 	virtual std::unique_ptr<ibackend_statement> create_statement(std::string_view query)          = 0;
 	virtual std::unique_ptr<ibackend_statement> create_prepared_statement(std::string_view query) = 0;
 	virtual void                                execute(const std::string& query)                 = 0;
+
+	/// Get the statistics of the cache of prepared statements
+	virtual statement_cache_stats prepared_statement_cache_stats() const = 0;
+
+	/// Set the maximum number of idle prepared statements that are kept for reuse.
+	/// A capacity of zero disables the cache.
+	virtual void set_prepared_statement_cache_capacity(std::size_t capacity) = 0;
+
+	/// Check whether the connection is still usable.
+	/// A backend may try to restore a broken connection before giving up.
+	virtual bool is_valid() = 0;
+
+	/// Cancel the statement that is executing on this connection, which then fails with an error.
+	/// Called by another thread than the one that executes the statement, implementations must be thread safe.
+	/// Does nothing when no statement is executing. The default implementation throws, cancellation is not supported.
+	virtual void cancel();
 };
 
 } // namespace squid
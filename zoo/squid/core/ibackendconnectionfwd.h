@@ -7,25 +7,10 @@
 
 #pragma once
 
-#include "zoo/squid/core/config.h"
-#include "zoo/squid/core/ibackendstatementfwd.h"
-
-#include <memory>
-#include <string_view>
-
 namespace zoo {
 namespace squid {
 
-/// Interface for a backend connection
-class ZOO_SQUID_CORE_API ibackend_connection
-{
-public:
-	virtual ~ibackend_connection() noexcept;
-
-	virtual std::unique_ptr<ibackend_statement> create_statement(std::string_view query)          = 0;
-	virtual std::unique_ptr<ibackend_statement> create_prepared_statement(std::string_view query) = 0;
-	virtual void                                execute(const std::string& query)                 = 0;
-};
+class ibackend_connection;
 
 } // namespace squid
 } // namespace zoo
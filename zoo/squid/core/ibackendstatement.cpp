@@ -6,11 +6,87 @@
 //
 
 #include "zoo/squid/core/ibackendstatement.h"
+#include "zoo/squid/core/error.h"
+
+#include "zoo/common/misc/throw_exception.h"
 
 namespace zoo {
 namespace squid {
 
 ibackend_statement::~ibackend_statement() noexcept = default;
 
+const binding_plan* ibackend_statement::parameter_binding_plan() const
+{
+	return nullptr;
+}
+
+void ibackend_statement::execute_positional(const positional_parameters&, const std::vector<result>&)
+{
+	ZOO_THROW_EXCEPTION(error{ "This backend statement does not support positional parameters" });
+}
+
+void ibackend_statement::execute_positional(const positional_parameters&, const std::map<std::string, result>&)
+{
+	ZOO_THROW_EXCEPTION(error{ "This backend statement does not support positional parameters" });
+}
+
+std::uint64_t ibackend_statement::execute_batch(std::span<const std::map<std::string, parameter>> batch)
+{
+	const std::vector<result> no_results{};
+
+	auto rows = std::uint64_t{};
+	for (const auto& parameters : batch)
+	{
+		this->execute(parameters, no_results);
+		rows += this->affected_rows();
+	}
+	return rows;
+}
+
+std::uint64_t ibackend_statement::execute_batch_positional(std::span<const positional_parameters> batch)
+{
+	const std::vector<result> no_results{};
+
+	auto rows = std::uint64_t{};
+	for (const auto& parameters : batch)
+	{
+		this->execute_positional(parameters, no_results);
+		rows += this->affected_rows();
+	}
+	return rows;
+}
+
+std::uint64_t ibackend_statement::execute_batch_named(const binding_plan& names, std::span<const positional_parameters> batch)
+{
+	const std::vector<result> no_results{};
+
+	// Assigning to the entries of the previous set does not allocate
+	std::map<std::string, parameter> parameters{};
+
+	auto rows = std::uint64_t{};
+	for (const auto& set : batch)
+	{
+		for (std::size_t index = 0; index < names.size(); ++index)
+		{
+			if (index < set.size() && set[index])
+			{
+				parameters.insert_or_assign(names.name(index), set[index].value());
+			}
+			else
+			{
+				parameters.erase(names.name(index));
+			}
+		}
+		this->execute(parameters, no_results);
+		rows += this->affected_rows();
+	}
+	return rows;
+}
+
+std::size_t ibackend_statement::fetch_columns(column_batch&, std::size_t)
+{
+	ZOO_THROW_EXCEPTION(error{ "Columnar fetching is not supported by this backend" });
+}
+
 } // namespace squid
 } // namespace zoo
@@ -10,9 +10,13 @@
 #include "zoo/squid/core/config.h"
 #include "zoo/squid/core/parameter.h"
 #include "zoo/squid/core/result.h"
+#include "zoo/squid/core/fetchmode.h"
+#include "zoo/squid/core/bindingplan.h"
+#include "zoo/squid/core/columnbatch.h"
 
 #include <map>
 #include <vector>
+#include <span>
 #include <string>
 
 namespace zoo {
@@ -32,6 +36,36 @@ public:
 	virtual std::string field_name(std::size_t index) = 0;
 
 	virtual std::uint64_t affected_rows() = 0;
+
+	/// Set the fetch mode for the next executions
+	virtual void set_fetch_mode(fetch_mode mode) = 0;
+
+	/// Get the positional parameter binding plan of the query,
+	/// or nullptr if this statement binds parameters by name only (the default).
+	virtual const binding_plan* parameter_binding_plan() const;
+
+	/// Execute with @a parameters in the order of parameter_binding_plan().
+	/// Only called when parameter_binding_plan() does not return nullptr.
+	virtual void execute_positional(const positional_parameters& parameters, const std::vector<result>& results);
+	virtual void execute_positional(const positional_parameters& parameters, const std::map<std::string, result>& results);
+
+	/// Execute once for each parameter set in @a batch, discarding any result rows.
+	/// Returns the total number of affected rows.
+	/// The default implementations execute the parameter sets one at a time.
+	virtual std::uint64_t execute_batch(std::span<const std::map<std::string, parameter>> batch);
+	virtual std::uint64_t execute_batch_positional(std::span<const positional_parameters> batch);
+
+	/// Execute once for each parameter set in @a batch, like execute_batch(), but with the parameters by position in
+	/// @a names instead of in a map per set. An empty position is not bound.
+	/// Used for statements without a parameter_binding_plan(), @a names is not the plan of the query but the names that
+	/// were bound. The default implementation binds the sets one at a time by name, reusing one map.
+	virtual std::uint64_t execute_batch_named(const binding_plan& names, std::span<const positional_parameters> batch);
+
+	/// Append up to @a batch_size rows of the current result to the columns of @a batch,
+	/// starting at the current row. Returns the number of rows appended, 0 when the result is exhausted.
+	/// The results bound at execute() are not assigned.
+	/// The default implementation throws.
+	virtual std::size_t fetch_columns(column_batch& batch, std::size_t batch_size);
 };
 
 } // namespace squid
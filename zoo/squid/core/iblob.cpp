@@ -0,0 +1,16 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/core/iblob.h"
+
+namespace zoo {
+namespace squid {
+
+iblob::~iblob() noexcept = default;
+
+} // namespace squid
+} // namespace zoo
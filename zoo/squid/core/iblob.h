@@ -0,0 +1,71 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/core/config.h"
+#include "zoo/squid/core/error.h"
+
+#include "zoo/common/misc/throw_exception.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+
+/// Interface for incremental access to a binary value that is stored in the database, without holding it in memory.
+/// It has the same read and write methods as zoo::fs::ifile, so data can be copied between both with copy_stream().
+class ZOO_SQUID_CORE_API iblob
+{
+public:
+	virtual ~iblob() noexcept;
+
+	/// Read up to @a count bytes at the current position into @a buf and advance the position.
+	/// Returns the number of bytes read, 0 at the end.
+	virtual std::size_t read(void* buf, std::size_t count) = 0;
+
+	/// Write @a count bytes from @a buf at the current position and advance the position.
+	/// Returns the number of bytes written.
+	virtual std::size_t write(const void* buf, std::size_t count) = 0;
+
+	/// Get the size in bytes
+	virtual std::uint64_t size() = 0;
+
+	/// Set the current position to @a offset bytes from the start
+	virtual void seek(std::uint64_t offset) = 0;
+};
+
+/// Copy everything that can be read from @a source to @a destination, in chunks of @a chunk_size bytes,
+/// so that only one chunk is held in memory.
+/// Works with any type with the read and write methods of iblob, e.g. zoo::fs::ifile.
+/// Returns the number of bytes copied.
+template<typename Source, typename Destination>
+std::uint64_t copy_stream(Source& source, Destination& destination, std::size_t chunk_size = 64 * 1024)
+{
+	std::vector<unsigned char> buffer(chunk_size);
+
+	auto total = std::uint64_t{};
+	while (const auto count = source.read(buffer.data(), buffer.size()))
+	{
+		for (std::size_t written = 0; written < count;)
+		{
+			const auto n = destination.write(buffer.data() + written, count - written);
+			if (n == 0)
+			{
+				ZOO_THROW_EXCEPTION(error{ "The destination did not accept any data" });
+			}
+			written += n;
+		}
+		total += count;
+	}
+	return total;
+}
+
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,423 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/core/instrumentedbackendconnection.h"
+#include "zoo/squid/core/ibackendstatement.h"
+#include "zoo/squid/core/error.h"
+
+#include "zoo/common/misc/throw_exception.h"
+
+#include <chrono>
+#include <map>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+/// Adds the time between its construction and its destruction to @a total, also when an exception is thrown
+class stopwatch final
+{
+	std::chrono::nanoseconds& total_;
+	clock_type::time_point    start_;
+
+public:
+	explicit stopwatch(std::chrono::nanoseconds& total)
+	    : total_{ total }
+	    , start_{ clock_type::now() }
+	{
+	}
+
+	~stopwatch() noexcept
+	{
+		this->total_ += clock_type::now() - this->start_;
+	}
+
+	stopwatch(const stopwatch&)            = delete;
+	stopwatch& operator=(const stopwatch&) = delete;
+};
+
+template<typename T>
+std::uint64_t value_size(const T& value)
+{
+	if constexpr (std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view> || std::is_same_v<T, byte_string> ||
+	              std::is_same_v<T, byte_string_view>)
+	{
+		return value.size();
+	}
+	else if constexpr (std::is_same_v<T, std::nullopt_t>)
+	{
+		return 0u;
+	}
+	else
+	{
+		return sizeof(T);
+	}
+}
+
+std::uint64_t value_size(const parameter& param)
+{
+	return std::visit([](auto&& arg) { return value_size(*arg); }, param.pointer());
+}
+
+std::uint64_t value_size(const result& res)
+{
+	return std::visit(
+	    [](auto&& arg) {
+		    return std::visit(
+		        [](auto&& ptr) -> std::uint64_t {
+			        using T = std::decay_t<decltype(*ptr)>;
+			        if constexpr (is_optional_v<T>)
+			        {
+				        return ptr->has_value() ? value_size(ptr->value()) : 0u;
+			        }
+			        else
+			        {
+				        return value_size(*ptr);
+			        }
+		        },
+		        arg);
+	    },
+	    res.value());
+}
+
+std::uint64_t parameters_size(const std::map<std::string, parameter>& parameters)
+{
+	auto size = std::uint64_t{};
+	for (const auto& [name, param] : parameters)
+	{
+		size += value_size(param);
+	}
+	return size;
+}
+
+std::uint64_t parameters_size(const positional_parameters& parameters)
+{
+	auto size = std::uint64_t{};
+	for (const auto& param : parameters)
+	{
+		if (param)
+		{
+			size += value_size(param.value());
+		}
+	}
+	return size;
+}
+
+std::uint64_t batch_size_of(const column_batch& batch)
+{
+	auto size = std::uint64_t{};
+	for (std::size_t i = 0, end = batch.column_count(); i < end; ++i)
+	{
+		const auto& column = batch.column(i);
+		switch (column.type())
+		{
+		case column_type::int64:
+			size += column.int64_values().size() * sizeof(std::int64_t);
+			break;
+		case column_type::float64:
+			size += column.float64_values().size() * sizeof(double);
+			break;
+		case column_type::text:
+			size += column.text_values().data().size();
+			break;
+		}
+	}
+	return size;
+}
+
+class instrumented_statement final : public ibackend_statement
+{
+	std::unique_ptr<ibackend_statement>     statement_;
+	std::shared_ptr<iquery_instrumentation> instrumentation_;
+	std::string                             query_;
+	query_sample                            sample_;
+	bool                                    pending_; // true if an execution was started that has not been reported
+	std::vector<result>                     results_; // the bound results, to measure the fetched values
+
+	// Report the pending execution, if any
+	void finish() noexcept
+	{
+		if (this->pending_)
+		{
+			this->pending_      = false;
+			this->sample_.query = this->query_;
+			this->instrumentation_->on_query(this->sample_);
+			this->sample_ = query_sample{};
+		}
+	}
+
+	void begin(std::uint64_t bytes)
+	{
+		this->finish();
+		this->sample_.bytes = bytes;
+		this->pending_      = true;
+	}
+
+	template<typename Parameters, typename ResultsContainer>
+	void execute_results(const Parameters& parameters, const ResultsContainer& results)
+	{
+		this->begin(parameters_size(parameters));
+
+		this->results_.clear();
+		for (const auto& res : results)
+		{
+			if constexpr (std::is_same_v<ResultsContainer, std::vector<result>>)
+			{
+				this->results_.push_back(res);
+			}
+			else
+			{
+				this->results_.push_back(res.second);
+			}
+		}
+
+		stopwatch sw{ this->sample_.execute };
+		if constexpr (std::is_same_v<Parameters, positional_parameters>)
+		{
+			this->statement_->execute_positional(parameters, results);
+		}
+		else
+		{
+			this->statement_->execute(parameters, results);
+		}
+	}
+
+	template<typename Batch, typename Execute>
+	std::uint64_t execute_all(std::span<const Batch> batch, Execute&& execute)
+	{
+		auto bytes = std::uint64_t{};
+		for (const auto& parameters : batch)
+		{
+			bytes += parameters_size(parameters);
+		}
+		this->begin(bytes);
+		this->results_.clear();
+
+		auto rows = std::uint64_t{};
+		{
+			stopwatch sw{ this->sample_.execute };
+			rows = execute();
+		}
+		this->finish();
+		return rows;
+	}
+
+public:
+	instrumented_statement(std::unique_ptr<ibackend_statement>     statement,
+	                       std::shared_ptr<iquery_instrumentation> instrumentation,
+	                       std::string_view                        query,
+	                       std::chrono::nanoseconds                prepare)
+	    : statement_{ std::move(statement) }
+	    , instrumentation_{ std::move(instrumentation) }
+	    , query_{ fingerprint_query(query) }
+	    , sample_{ .prepare = prepare }
+	    , pending_{}
+	    , results_{}
+	{
+	}
+
+	~instrumented_statement() noexcept override
+	{
+		this->finish();
+	}
+
+	void execute(const std::map<std::string, parameter>& parameters, const std::vector<result>& results) override
+	{
+		this->execute_results(parameters, results);
+	}
+
+	void execute(const std::map<std::string, parameter>& parameters, const std::map<std::string, result>& results) override
+	{
+		this->execute_results(parameters, results);
+	}
+
+	bool fetch() override
+	{
+		auto fetched = false;
+		{
+			stopwatch sw{ this->sample_.fetch };
+			fetched = this->statement_->fetch();
+		}
+		if (fetched)
+		{
+			++this->sample_.rows;
+			for (const auto& res : this->results_)
+			{
+				this->sample_.bytes += value_size(res);
+			}
+		}
+		else
+		{
+			this->finish();
+		}
+		return fetched;
+	}
+
+	std::size_t field_count() override
+	{
+		return this->statement_->field_count();
+	}
+
+	std::string field_name(std::size_t index) override
+	{
+		return this->statement_->field_name(index);
+	}
+
+	std::uint64_t affected_rows() override
+	{
+		return this->statement_->affected_rows();
+	}
+
+	void set_fetch_mode(fetch_mode mode) override
+	{
+		this->statement_->set_fetch_mode(mode);
+	}
+
+	const binding_plan* parameter_binding_plan() const override
+	{
+		return this->statement_->parameter_binding_plan();
+	}
+
+	void execute_positional(const positional_parameters& parameters, const std::vector<result>& results) override
+	{
+		this->execute_results(parameters, results);
+	}
+
+	void execute_positional(const positional_parameters& parameters, const std::map<std::string, result>& results) override
+	{
+		this->execute_results(parameters, results);
+	}
+
+	std::uint64_t execute_batch(std::span<const std::map<std::string, parameter>> batch) override
+	{
+		return this->execute_all(batch, [&] { return this->statement_->execute_batch(batch); });
+	}
+
+	std::uint64_t execute_batch_positional(std::span<const positional_parameters> batch) override
+	{
+		return this->execute_all(batch, [&] { return this->statement_->execute_batch_positional(batch); });
+	}
+
+	std::uint64_t execute_batch_named(const binding_plan& names, std::span<const positional_parameters> batch) override
+	{
+		return this->execute_all(batch, [&] { return this->statement_->execute_batch_named(names, batch); });
+	}
+
+	std::size_t fetch_columns(column_batch& batch, std::size_t batch_size) override
+	{
+		const auto before = batch_size_of(batch);
+		auto       rows   = std::size_t{};
+		{
+			stopwatch sw{ this->sample_.fetch };
+			rows = this->statement_->fetch_columns(batch, batch_size);
+		}
+		if (rows > 0u)
+		{
+			this->sample_.rows += rows;
+			this->sample_.bytes += batch_size_of(batch) - before;
+		}
+		else
+		{
+			this->finish();
+		}
+		return rows;
+	}
+};
+
+} // namespace
+
+instrumented_backend_connection::instrumented_backend_connection(std::shared_ptr<ibackend_connection>    connection,
+                                                                 std::shared_ptr<iquery_instrumentation> instrumentation)
+    : ibackend_connection{}
+    , connection_{ std::move(connection) }
+    , instrumentation_{ std::move(instrumentation) }
+{
+	if (!this->connection_)
+	{
+		ZOO_THROW_EXCEPTION(std::invalid_argument{ "connection must not be null" });
+	}
+	if (!this->instrumentation_)
+	{
+		ZOO_THROW_EXCEPTION(std::invalid_argument{ "instrumentation must not be null" });
+	}
+}
+
+std::unique_ptr<ibackend_statement> instrumented_backend_connection::create_statement(std::string_view query)
+{
+	auto prepare   = std::chrono::nanoseconds{};
+	auto statement = std::unique_ptr<ibackend_statement>{};
+	{
+		stopwatch sw{ prepare };
+		statement = this->connection_->create_statement(query);
+	}
+	return std::make_unique<instrumented_statement>(std::move(statement), this->instrumentation_, query, prepare);
+}
+
+std::unique_ptr<ibackend_statement> instrumented_backend_connection::create_prepared_statement(std::string_view query)
+{
+	auto prepare   = std::chrono::nanoseconds{};
+	auto statement = std::unique_ptr<ibackend_statement>{};
+	{
+		stopwatch sw{ prepare };
+		statement = this->connection_->create_prepared_statement(query);
+	}
+	return std::make_unique<instrumented_statement>(std::move(statement), this->instrumentation_, query, prepare);
+}
+
+void instrumented_backend_connection::execute(const std::string& query)
+{
+	const auto fingerprint = fingerprint_query(query);
+
+	auto sample = query_sample{ .query = fingerprint };
+	try
+	{
+		stopwatch sw{ sample.execute };
+		this->connection_->execute(query);
+	}
+	catch (...)
+	{
+		this->instrumentation_->on_query(sample);
+		throw;
+	}
+	this->instrumentation_->on_query(sample);
+}
+
+statement_cache_stats instrumented_backend_connection::prepared_statement_cache_stats() const
+{
+	return this->connection_->prepared_statement_cache_stats();
+}
+
+void instrumented_backend_connection::set_prepared_statement_cache_capacity(std::size_t capacity)
+{
+	this->connection_->set_prepared_statement_cache_capacity(capacity);
+}
+
+bool instrumented_backend_connection::is_valid()
+{
+	return this->connection_->is_valid();
+}
+
+void instrumented_backend_connection::cancel()
+{
+	this->connection_->cancel();
+}
+
+const std::shared_ptr<ibackend_connection>& instrumented_backend_connection::backend() const noexcept
+{
+	return this->connection_;
+}
+
+} // namespace squid
+} // namespace zoo
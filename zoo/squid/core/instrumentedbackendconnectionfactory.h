@@ -0,0 +1,34 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/core/config.h"
+#include "zoo/squid/core/ibackendconnectionfactory.h"
+#include "zoo/squid/core/iqueryinstrumentation.h"
+
+#include <memory>
+
+namespace zoo {
+namespace squid {
+
+/// Decorator of a backend connection factory that creates instrumented_backend_connection objects,
+/// e.g. to instrument all connections of a connection_pool.
+class ZOO_SQUID_CORE_API instrumented_backend_connection_factory final : public ibackend_connection_factory
+{
+	std::shared_ptr<const ibackend_connection_factory> factory_;
+	std::shared_ptr<iquery_instrumentation>            instrumentation_;
+
+public:
+	instrumented_backend_connection_factory(std::shared_ptr<const ibackend_connection_factory> factory,
+	                                        std::shared_ptr<iquery_instrumentation>            instrumentation);
+
+	std::shared_ptr<ibackend_connection> create_backend_connection(std::string_view connection_info) const override;
+};
+
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,111 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/core/iqueryinstrumentation.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace zoo {
+namespace squid {
+
+namespace {
+
+bool is_identifier_char(char c)
+{
+	return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$';
+}
+
+bool is_digit(char c)
+{
+	return std::isdigit(static_cast<unsigned char>(c));
+}
+
+} // namespace
+
+iquery_instrumentation::~iquery_instrumentation() noexcept = default;
+
+std::string fingerprint_query(std::string_view query)
+{
+	std::string result{};
+	result.reserve(query.length());
+
+	auto pending_space = false;
+
+	for (auto it = query.begin(), end = query.end(); it != end;)
+	{
+		const auto c = *it;
+		if (std::isspace(static_cast<unsigned char>(c)))
+		{
+			pending_space = !result.empty();
+			++it;
+			continue;
+		}
+
+		if (pending_space)
+		{
+			result.push_back(' ');
+			pending_space = false;
+		}
+
+		if (c == '\'')
+		{
+			// A string literal, a doubled quote is an escaped quote
+			++it;
+			while (it != end)
+			{
+				if (*it++ == '\'')
+				{
+					if (it == end || *it != '\'')
+					{
+						break;
+					}
+					++it;
+				}
+			}
+			result.push_back('?');
+		}
+		else if (c == '"' || c == '`')
+		{
+			// A quoted identifier, kept as is
+			const auto close = std::find(it + 1, end, c);
+			result.append(it, close == end ? end : close + 1);
+			it = close == end ? end : close + 1;
+		}
+		else if (is_digit(c) && (result.empty() || !is_identifier_char(result.back())))
+		{
+			// A numeric literal, e.g. 42, 1.5 or 1e-3
+			while (it != end && (is_digit(*it) || *it == '.'))
+			{
+				++it;
+			}
+			if (it != end && (*it == 'e' || *it == 'E'))
+			{
+				++it;
+				if (it != end && (*it == '+' || *it == '-'))
+				{
+					++it;
+				}
+				while (it != end && is_digit(*it))
+				{
+					++it;
+				}
+			}
+			result.push_back('?');
+		}
+		else
+		{
+			result.push_back(c);
+			++it;
+		}
+	}
+
+	return result;
+}
+
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,58 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/core/config.h"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace zoo {
+namespace squid {
+
+/// Measurements of one execution of a statement
+struct query_sample final
+{
+	std::string_view         query{};   //!< Normalized query, see fingerprint_query()
+	std::chrono::nanoseconds prepare{}; //!< Time spent creating the statement, only for its first execution
+	std::chrono::nanoseconds execute{}; //!< Time spent executing
+	std::chrono::nanoseconds fetch{};   //!< Total time spent fetching the rows
+	std::uint64_t            rows{};    //!< Number of rows fetched
+	std::uint64_t            bytes{};   //!< Size of the parameter values sent plus the size of the values fetched
+
+	/// Get the sum of the prepare, execute and fetch times
+	std::chrono::nanoseconds total() const noexcept
+	{
+		return this->prepare + this->execute + this->fetch;
+	}
+};
+
+/// Interface for a receiver of the measurements of instrumented connections and connection pools.
+/// The methods may be called concurrently by several connections, and they must not throw.
+class ZOO_SQUID_CORE_API iquery_instrumentation
+{
+public:
+	virtual ~iquery_instrumentation() noexcept;
+
+	/// Called when an execution is complete: when its result is exhausted, when the statement is executed again,
+	/// or when the statement is destroyed.
+	virtual void on_query(const query_sample& sample) noexcept = 0;
+
+	/// Called when a connection pool handed out a connection, with the time the acquisition took
+	virtual void on_pool_wait(std::chrono::nanoseconds duration) noexcept = 0;
+};
+
+/// Normalize @a query for use as an instrumentation key.
+/// Like normalize_query(), and in addition string and numeric literals are replaced by a question mark,
+/// so that statements that only differ in their literals are aggregated together.
+ZOO_SQUID_CORE_API std::string fingerprint_query(std::string_view query);
+
+} // namespace squid
+} // namespace zoo
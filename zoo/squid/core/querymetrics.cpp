@@ -0,0 +1,182 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/core/querymetrics.h"
+
+#include "zoo/common/logging/logging.h"
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+
+namespace zoo {
+namespace squid {
+
+namespace {
+
+// Transparent hash, so that looking up a std::string_view does not allocate
+struct string_hash final
+{
+	using is_transparent = void;
+
+	std::size_t operator()(std::string_view value) const noexcept
+	{
+		return std::hash<std::string_view>{}(value);
+	}
+};
+
+std::uint64_t to_count(std::chrono::nanoseconds duration)
+{
+	return static_cast<std::uint64_t>(std::max(duration.count(), std::chrono::nanoseconds::rep{}));
+}
+
+} // namespace
+
+class query_metrics::impl final
+{
+	std::chrono::nanoseconds                                                         slow_query_threshold_;
+	slow_query_callback                                                              callback_;
+	mutable std::mutex                                                               mutex_;
+	std::unordered_map<std::string, statement_metrics, string_hash, std::equal_to<>> statements_;
+	hdr_histogram                                                                    pool_wait_;
+
+public:
+	impl(std::chrono::nanoseconds slow_query_threshold, slow_query_callback callback)
+	    : slow_query_threshold_{ slow_query_threshold }
+	    , callback_{ std::move(callback) }
+	    , mutex_{}
+	    , statements_{}
+	    , pool_wait_{}
+	{
+	}
+
+	void on_query(const query_sample& sample)
+	{
+		const auto total = sample.total();
+		{
+			std::lock_guard<std::mutex> lock{ this->mutex_ };
+
+			auto it = this->statements_.find(sample.query);
+			if (it == this->statements_.end())
+			{
+				it               = this->statements_.emplace(std::string{ sample.query }, statement_metrics{}).first;
+				it->second.query = it->first;
+			}
+
+			auto& metrics = it->second;
+			++metrics.executions;
+			metrics.rows += sample.rows;
+			metrics.bytes += sample.bytes;
+			if (sample.prepare.count() > 0)
+			{
+				metrics.prepare.record(to_count(sample.prepare));
+			}
+			metrics.execute.record(to_count(sample.execute));
+			metrics.fetch.record(to_count(sample.fetch));
+			metrics.total.record(to_count(total));
+		}
+
+		if (this->callback_ && total >= this->slow_query_threshold_)
+		{
+			this->callback_(sample);
+		}
+	}
+
+	void on_pool_wait(std::chrono::nanoseconds duration)
+	{
+		std::lock_guard<std::mutex> lock{ this->mutex_ };
+		this->pool_wait_.record(to_count(duration));
+	}
+
+	std::vector<statement_metrics> statements() const
+	{
+		std::vector<statement_metrics> result{};
+		{
+			std::lock_guard<std::mutex> lock{ this->mutex_ };
+			result.reserve(this->statements_.size());
+			for (const auto& [query, metrics] : this->statements_)
+			{
+				result.push_back(metrics);
+			}
+		}
+
+		std::sort(result.begin(), result.end(), [](const statement_metrics& a, const statement_metrics& b) {
+			return a.total.sum() > b.total.sum();
+		});
+		return result;
+	}
+
+	hdr_histogram pool_wait() const
+	{
+		std::lock_guard<std::mutex> lock{ this->mutex_ };
+		return this->pool_wait_;
+	}
+
+	void reset()
+	{
+		std::lock_guard<std::mutex> lock{ this->mutex_ };
+		this->statements_.clear();
+		this->pool_wait_.reset();
+	}
+};
+
+query_metrics::query_metrics()
+    : query_metrics{ std::chrono::nanoseconds::max(), slow_query_callback{} }
+{
+}
+
+query_metrics::query_metrics(std::chrono::nanoseconds slow_query_threshold, slow_query_callback callback)
+    : iquery_instrumentation{}
+    , pimpl_{ std::make_unique<impl>(slow_query_threshold, std::move(callback)) }
+{
+}
+
+query_metrics::~query_metrics() noexcept = default;
+
+void query_metrics::on_query(const query_sample& sample) noexcept
+{
+	try
+	{
+		this->pimpl_->on_query(sample);
+	}
+	catch (const std::exception& e)
+	{
+		ZOO_LOG(err, "cannot record query metrics: {}", e.what());
+	}
+}
+
+void query_metrics::on_pool_wait(std::chrono::nanoseconds duration) noexcept
+{
+	try
+	{
+		this->pimpl_->on_pool_wait(duration);
+	}
+	catch (const std::exception& e)
+	{
+		ZOO_LOG(err, "cannot record pool wait metrics: {}", e.what());
+	}
+}
+
+std::vector<statement_metrics> query_metrics::statements() const
+{
+	return this->pimpl_->statements();
+}
+
+hdr_histogram query_metrics::pool_wait() const
+{
+	return this->pimpl_->pool_wait();
+}
+
+void query_metrics::reset()
+{
+	this->pimpl_->reset();
+}
+
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,75 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/core/config.h"
+#include "zoo/squid/core/iqueryinstrumentation.h"
+#include "zoo/squid/core/hdrhistogram.h"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+
+/// Aggregated measurements of one normalized query.
+/// The histograms are in nanoseconds.
+struct statement_metrics final
+{
+	std::string   query{};      //!< Normalized query
+	std::uint64_t executions{}; //!< Number of executions
+	std::uint64_t rows{};       //!< Total number of rows fetched
+	std::uint64_t bytes{};      //!< Total number of bytes sent and fetched
+	hdr_histogram prepare{};    //!< Prepare times, only of first executions
+	hdr_histogram execute{};    //!< Execute times
+	hdr_histogram fetch{};      //!< Fetch times
+	hdr_histogram total{};      //!< Sums of the prepare, execute and fetch times
+};
+
+/// Thread safe instrumentation that aggregates the query samples per normalized query,
+/// and that reports slow queries to a callback.
+class ZOO_SQUID_CORE_API query_metrics final : public iquery_instrumentation
+{
+public:
+	using slow_query_callback = std::function<void(const query_sample& sample)>;
+
+private:
+	class impl;
+	std::unique_ptr<impl> pimpl_;
+
+public:
+	query_metrics();
+
+	/// Call @a callback for each execution with a total time of at least @a slow_query_threshold.
+	/// The callback is called by the thread that executed the query, it must not throw.
+	query_metrics(std::chrono::nanoseconds slow_query_threshold, slow_query_callback callback);
+
+	~query_metrics() noexcept;
+
+	query_metrics(const query_metrics&)            = delete;
+	query_metrics& operator=(const query_metrics&) = delete;
+
+	void on_query(const query_sample& sample) noexcept override;
+	void on_pool_wait(std::chrono::nanoseconds duration) noexcept override;
+
+	/// Get a copy of the metrics of each normalized query, the query with the largest total time first
+	std::vector<statement_metrics> statements() const;
+
+	/// Get a copy of the histogram of the connection pool acquisition times, in nanoseconds
+	hdr_histogram pool_wait() const;
+
+	/// Forget all measurements
+	void reset();
+};
+
+} // namespace squid
+} // namespace zoo
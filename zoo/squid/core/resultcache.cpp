@@ -0,0 +1,265 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/core/resultcache.h"
+#include "zoo/squid/core/iqueryinstrumentation.h"
+
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <unordered_map>
+
+namespace zoo {
+namespace squid {
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+struct string_hash final
+{
+	using is_transparent = void;
+
+	std::size_t operator()(std::string_view s) const noexcept
+	{
+		return std::hash<std::string_view>{}(s);
+	}
+};
+
+std::size_t size_of(const std::string& key, const cached_result& result)
+{
+	auto size = key.size() + result.data.size() + sizeof(cached_result);
+	for (const auto& name : result.field_names)
+	{
+		size += name.size();
+	}
+	return size;
+}
+
+} // namespace
+
+class result_cache::impl final
+{
+	struct entry final
+	{
+		std::shared_ptr<const cached_result>     result;
+		std::shared_ptr<const result_cache_rule> rule;
+		clock_type::time_point                   expires;
+		std::size_t                              size;
+		std::list<const std::string*>::iterator  position; // in lru_
+	};
+
+	using lock_type = std::unique_lock<std::mutex>;
+	using entry_map = std::unordered_map<std::string, entry, string_hash, std::equal_to<>>;
+	using rule_map  = std::unordered_map<std::string, std::shared_ptr<const result_cache_rule>, string_hash, std::equal_to<>>;
+
+	result_cache_options          options_;
+	mutable std::mutex            mutex_;
+	rule_map                      rules_;      // by query fingerprint
+	entry_map                     entries_;    // by key
+	std::list<const std::string*> lru_;        // keys of entries_, most recently used first
+	std::uint64_t                 generation_; // incremented by every invalidation
+	result_cache_stats            stats_;
+
+	entry_map::iterator erase(const lock_type&, entry_map::iterator it)
+	{
+		this->stats_.bytes -= it->second.size;
+		this->lru_.erase(it->second.position);
+		return this->entries_.erase(it);
+	}
+
+	template<typename Predicate>
+	void invalidate_if(Predicate&& predicate)
+	{
+		lock_type lock{ this->mutex_ };
+		++this->generation_;
+		for (auto it = this->entries_.begin(); it != this->entries_.end();)
+		{
+			if (predicate(*it->second.rule))
+			{
+				it = this->erase(lock, it);
+				++this->stats_.invalidations;
+			}
+			else
+			{
+				++it;
+			}
+		}
+	}
+
+public:
+	explicit impl(const result_cache_options& options)
+	    : options_{ options }
+	    , mutex_{}
+	    , rules_{}
+	    , entries_{}
+	    , lru_{}
+	    , generation_{}
+	    , stats_{}
+	{
+	}
+
+	void add_query(std::string_view query, std::vector<std::string>&& tags, const std::optional<std::chrono::milliseconds>& ttl)
+	{
+		auto fingerprint = fingerprint_query(query);
+		auto rule        = std::make_shared<const result_cache_rule>(fingerprint, std::move(tags), ttl.value_or(this->options_.ttl));
+
+		lock_type lock{ this->mutex_ };
+		this->rules_.insert_or_assign(std::move(fingerprint), std::move(rule));
+	}
+
+	void invalidate(std::string_view tag)
+	{
+		this->invalidate_if(
+		    [tag](const result_cache_rule& rule) { return std::find(rule.tags.begin(), rule.tags.end(), tag) != rule.tags.end(); });
+	}
+
+	void invalidate_query(std::string_view query)
+	{
+		// Entries keep the rule they were stored under, which may have been replaced since, so they are matched by
+		// fingerprint rather than by the current rule
+		const auto fingerprint = fingerprint_query(query);
+		this->invalidate_if([&fingerprint](const result_cache_rule& rule) { return rule.fingerprint == fingerprint; });
+	}
+
+	void clear()
+	{
+		this->invalidate_if([](const result_cache_rule&) { return true; });
+	}
+
+	result_cache_stats stats() const
+	{
+		lock_type lock{ this->mutex_ };
+
+		auto result    = this->stats_;
+		result.entries = this->entries_.size();
+		return result;
+	}
+
+	std::shared_ptr<const result_cache_rule> find_rule(std::string_view query) const
+	{
+		const auto fingerprint = fingerprint_query(query);
+
+		lock_type  lock{ this->mutex_ };
+		const auto it = this->rules_.find(fingerprint);
+		return it == this->rules_.end() ? nullptr : it->second;
+	}
+
+	std::pair<std::shared_ptr<const cached_result>, std::uint64_t> lookup(std::string_view key)
+	{
+		lock_type lock{ this->mutex_ };
+
+		const auto it = this->entries_.find(key);
+		if (it != this->entries_.end())
+		{
+			if (it->second.expires > clock_type::now())
+			{
+				++this->stats_.hits;
+				this->lru_.splice(this->lru_.begin(), this->lru_, it->second.position);
+				return { it->second.result, this->generation_ };
+			}
+			this->erase(lock, it);
+		}
+
+		++this->stats_.misses;
+		return { nullptr, this->generation_ };
+	}
+
+	void store(std::string&&                                   key,
+	           const std::shared_ptr<const result_cache_rule>& rule,
+	           std::shared_ptr<const cached_result>&&          result,
+	           std::uint64_t                                   generation)
+	{
+		const auto size = size_of(key, *result);
+		if (size > this->options_.max_bytes)
+		{
+			return;
+		}
+
+		lock_type lock{ this->mutex_ };
+		if (generation != this->generation_)
+		{
+			return; // it may have been computed before an invalidation took effect
+		}
+
+		if (const auto it = this->entries_.find(key); it != this->entries_.end())
+		{
+			this->erase(lock, it);
+		}
+		while (this->stats_.bytes + size > this->options_.max_bytes)
+		{
+			this->erase(lock, this->entries_.find(*this->lru_.back()));
+			++this->stats_.evictions;
+		}
+
+		const auto it = this->entries_
+		                    .emplace(std::move(key),
+		                             entry{ .result   = std::move(result),
+		                                    .rule     = rule,
+		                                    .expires  = clock_type::now() + rule->ttl,
+		                                    .size     = size,
+		                                    .position = {} })
+		                    .first;
+		this->lru_.push_front(&it->first); // the address of a key does not change when the map rehashes
+		it->second.position = this->lru_.begin();
+		this->stats_.bytes += size;
+	}
+};
+
+result_cache::result_cache(const result_cache_options& options)
+    : pimpl_{ std::make_unique<impl>(options) }
+{
+}
+
+result_cache::~result_cache() noexcept = default;
+
+void result_cache::add_query(std::string_view query, std::vector<std::string> tags, std::optional<std::chrono::milliseconds> ttl)
+{
+	this->pimpl_->add_query(query, std::move(tags), ttl);
+}
+
+void result_cache::invalidate(std::string_view tag)
+{
+	this->pimpl_->invalidate(tag);
+}
+
+void result_cache::invalidate_query(std::string_view query)
+{
+	this->pimpl_->invalidate_query(query);
+}
+
+void result_cache::clear()
+{
+	this->pimpl_->clear();
+}
+
+result_cache_stats result_cache::stats() const
+{
+	return this->pimpl_->stats();
+}
+
+std::shared_ptr<const result_cache_rule> result_cache::find_rule(std::string_view query) const
+{
+	return this->pimpl_->find_rule(query);
+}
+
+std::pair<std::shared_ptr<const cached_result>, std::uint64_t> result_cache::lookup(std::string_view key)
+{
+	return this->pimpl_->lookup(key);
+}
+
+void result_cache::store(std::string                                     key,
+                         const std::shared_ptr<const result_cache_rule>& rule,
+                         std::shared_ptr<const cached_result>            result,
+                         std::uint64_t                                   generation)
+{
+	this->pimpl_->store(std::move(key), rule, std::move(result), generation);
+}
+
+} // namespace squid
+} // namespace zoo
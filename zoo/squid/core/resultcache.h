@@ -0,0 +1,109 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/core/config.h"
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+
+/// Options of a result_cache
+struct result_cache_options final
+{
+	std::chrono::milliseconds ttl{ 60000 };         //!< How long a cached result is used, unless the query has its own
+	std::size_t               max_bytes{ 64 << 20 }; //!< Memory budget, the least recently used results are evicted to stay within
+};
+
+/// Statistics of a result_cache
+struct result_cache_stats final
+{
+	std::uint64_t hits{};          //!< Number of executions that were served from the cache
+	std::uint64_t misses{};        //!< Number of executions of cacheable queries that went to the database
+	std::uint64_t evictions{};     //!< Number of results that were evicted to stay within the memory budget
+	std::uint64_t invalidations{}; //!< Number of results that were dropped by invalidate() or clear()
+	std::size_t   entries{};       //!< Number of cached results
+	std::size_t   bytes{};         //!< Memory used by the cached results
+};
+
+/// The rows of a cached result
+struct cached_result final
+{
+	std::string              data;          //!< The values of all rows, encoded back to back
+	std::size_t              rows{};        //!< Number of rows
+	std::vector<std::string> field_names{}; //!< Names of the fields of the result
+	std::uint64_t            affected_rows{};
+};
+
+/// How the results of a query are cached
+struct result_cache_rule final
+{
+	std::string               fingerprint; //!< Fingerprint of the queries that the rule applies to
+	std::vector<std::string>  tags;        //!< Tags to invalidate the results with, e.g. the tables that are read
+	std::chrono::milliseconds ttl;
+};
+
+/// Thread safe cache of query results, shared by the connections that are decorated with caching_backend_connection.
+/// Caching is opt-in per query: only the results of queries that were added with add_query() are cached.
+/// A result is keyed by the query text, the values of the bound parameters and the types of the bound results.
+/// It is used until its time to live expires, or until it is invalidated, explicitly or by one of its tags.
+class ZOO_SQUID_CORE_API result_cache final
+{
+	class impl;
+	std::unique_ptr<impl> pimpl_;
+
+public:
+	explicit result_cache(const result_cache_options& options = {});
+	~result_cache() noexcept;
+
+	result_cache(const result_cache&)            = delete;
+	result_cache& operator=(const result_cache&) = delete;
+
+	/// Cache the results of @a query, tagged with @a tags, for the time to live @a ttl or the default of the cache.
+	/// Queries that only differ in literal values or whitespace share the rule, see fingerprint_query().
+	/// Applies to statements that are created afterwards.
+	void add_query(std::string_view query, std::vector<std::string> tags = {}, std::optional<std::chrono::milliseconds> ttl = std::nullopt);
+
+	/// Drop all results of queries that are tagged with @a tag
+	void invalidate(std::string_view tag);
+
+	/// Drop all results of @a query, and of the queries that share its fingerprint.
+	/// This includes the results that were stored under a rule that add_query() replaced since.
+	void invalidate_query(std::string_view query);
+
+	/// Drop all results
+	void clear();
+
+	/// Get the current statistics of the cache
+	result_cache_stats stats() const;
+
+	/// Get the rule for @a query, or nullptr if its results are not cached
+	std::shared_ptr<const result_cache_rule> find_rule(std::string_view query) const;
+
+	/// Look up the result stored under @a key.
+	/// On a miss, the returned generation must be passed to store(), so that a result that was computed while an
+	/// invalidation happened is not stored.
+	std::pair<std::shared_ptr<const cached_result>, std::uint64_t> lookup(std::string_view key);
+
+	/// Store @a result under @a key according to @a rule
+	void store(std::string                                     key,
+	           const std::shared_ptr<const result_cache_rule>& rule,
+	           std::shared_ptr<const cached_result>            result,
+	           std::uint64_t                                   generation);
+};
+
+} // namespace squid
+} // namespace zoo
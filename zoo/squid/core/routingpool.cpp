@@ -0,0 +1,296 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/core/routingpool.h"
+#include "zoo/squid/core/connection.h"
+#include "zoo/squid/core/ibackendconnection.h"
+
+#include "zoo/common/logging/logging.h"
+#include "zoo/common/misc/throw_exception.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace zoo {
+namespace squid {
+
+namespace {
+
+using clock_type        = std::chrono::steady_clock;
+using optional_deadline = std::optional<clock_type::time_point>;
+
+/// A pool that connections can be routed to
+struct route final
+{
+	connection_pool            pool;
+	std::atomic<std::size_t>   outstanding; // number of connections handed out
+	std::atomic<std::uint64_t> routed;      // number of connections that were handed out
+
+	// Protected by the mutex of the routing pool
+	std::optional<std::chrono::milliseconds> lag;
+	bool                                     in_rotation;
+	bool                                     probing;    // a thread is measuring the lag
+	clock_type::time_point                   next_check; // when to measure the lag, or to retry after a failure
+
+	explicit route(connection_pool&& pool)
+	    : pool{ std::move(pool) }
+	    , outstanding{}
+	    , routed{}
+	    , lag{}
+	    , in_rotation{ true }
+	    , probing{}
+	    , next_check{}
+	{
+	}
+
+	route(const route&)            = delete;
+	route& operator=(const route&) = delete;
+
+	// Take a connection from the pool, waiting until @a deadline (or indefinitely)
+	std::shared_ptr<ibackend_connection> take(const optional_deadline& deadline)
+	{
+		if (!deadline)
+		{
+			return this->pool.acquire();
+		}
+
+		const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline.value() - clock_type::now());
+		return remaining.count() > 0 ? this->pool.acquire(remaining) : this->pool.try_acquire();
+	}
+
+	route_stats stats() const
+	{
+		return route_stats{ .outstanding = this->outstanding, .routed = this->routed, .lag = this->lag, .in_rotation = this->in_rotation };
+	}
+};
+
+} // namespace
+
+class routing_pool::impl final : public std::enable_shared_from_this<routing_pool::impl>
+{
+	using lock_type = std::unique_lock<std::mutex>;
+
+	routing_pool_options                options_;
+	route                               primary_;
+	std::vector<std::unique_ptr<route>> replicas_;
+	mutable std::mutex                  mutex_;
+	std::size_t                         next_; // first replica to consider, so that equally loaded replicas take turns
+
+	bool lag_checks() const
+	{
+		return this->options_.max_replica_lag.count() > 0;
+	}
+
+	// The replicas that may take read-only work, least loaded first
+	std::vector<route*> candidates()
+	{
+		// Sort a snapshot of the loads: the counters change while sorting, which would break the ordering of the sort
+		std::vector<std::pair<std::size_t, route*>> loaded{};
+		loaded.reserve(this->replicas_.size());
+
+		const auto now = clock_type::now();
+		{
+			lock_type lock{ this->mutex_ };
+
+			const auto count = this->replicas_.size();
+			const auto first = this->next_++;
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				auto& r = *this->replicas_[(first + i) % count];
+				// A replica out of rotation is given another chance once it is due for a check
+				if (r.in_rotation || (r.next_check <= now && !r.probing))
+				{
+					loaded.emplace_back(r.outstanding.load(), &r);
+				}
+			}
+		}
+
+		std::stable_sort(loaded.begin(), loaded.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+		std::vector<route*> result{};
+		result.reserve(loaded.size());
+		for (const auto& pair : loaded)
+		{
+			result.push_back(pair.second);
+		}
+		return result;
+	}
+
+	void fail(route& r)
+	{
+		lock_type lock{ this->mutex_ };
+		r.in_rotation = false;
+		r.probing     = false;
+		r.next_check  = clock_type::now() + this->options_.retry_interval;
+	}
+
+	// Check that @a backend, which was just taken from replica @a r, may be handed out
+	bool admit(route& r, const std::shared_ptr<ibackend_connection>& backend)
+	{
+		{
+			lock_type lock{ this->mutex_ };
+			if (!this->lag_checks())
+			{
+				r.in_rotation = true; // it works again, if it had failed
+				return true;
+			}
+			if (r.probing || r.next_check > clock_type::now())
+			{
+				return r.in_rotation;
+			}
+			r.probing = true;
+		}
+
+		std::chrono::milliseconds lag{};
+		try
+		{
+			connection connection{ std::shared_ptr<ibackend_connection>{ backend } };
+			lag = this->options_.lag_probe(connection);
+		}
+		catch (const std::exception& e)
+		{
+			ZOO_LOG(warn, "measuring the replication lag failed: {}", e.what());
+			this->fail(r);
+			return false;
+		}
+
+		lock_type lock{ this->mutex_ };
+		r.probing     = false;
+		r.lag         = lag;
+		r.in_rotation = lag <= this->options_.max_replica_lag;
+		r.next_check  = clock_type::now() + this->options_.lag_check_interval;
+		if (!r.in_rotation)
+		{
+			ZOO_LOG(warn, "replica taken out of rotation, its replication lag is {} ms", lag.count());
+		}
+		return r.in_rotation;
+	}
+
+	std::shared_ptr<ibackend_connection> lease(route& r, std::shared_ptr<ibackend_connection>&& backend)
+	{
+		++r.outstanding;
+		++r.routed;
+
+		// The deleter holds the lease of the underlying pool, and it keeps the route alive until it is returned
+		const auto connection = backend.get();
+		auto       release    = [self = this->shared_from_this(), &r, backend = std::move(backend)](ibackend_connection*) mutable {
+			backend.reset();
+			--r.outstanding;
+		};
+		return std::shared_ptr<ibackend_connection>{ connection, std::move(release) };
+	}
+
+	std::shared_ptr<ibackend_connection> acquire_primary(const optional_deadline& deadline)
+	{
+		auto backend = this->primary_.take(deadline);
+		return backend ? this->lease(this->primary_, std::move(backend)) : nullptr;
+	}
+
+	std::shared_ptr<ibackend_connection> acquire_replica(const optional_deadline& deadline)
+	{
+		// The first candidate may use up the time to wait, the others are only tried for an idle connection
+		for (const auto r : this->candidates())
+		{
+			std::shared_ptr<ibackend_connection> backend{};
+			try
+			{
+				backend = r->take(deadline);
+			}
+			catch (const std::exception& e)
+			{
+				ZOO_LOG(warn, "replica taken out of rotation, acquiring a connection failed: {}", e.what());
+				this->fail(*r);
+				continue;
+			}
+
+			if (backend && this->admit(*r, backend))
+			{
+				return this->lease(*r, std::move(backend));
+			}
+		}
+
+		return this->options_.fallback_to_primary ? this->acquire_primary(deadline) : nullptr;
+	}
+
+public:
+	impl(connection_pool&& primary, std::vector<connection_pool>&& replicas, const routing_pool_options& options)
+	    : options_{ options }
+	    , primary_{ std::move(primary) }
+	    , replicas_{}
+	    , mutex_{}
+	    , next_{}
+	{
+		if (this->lag_checks() && !this->options_.lag_probe)
+		{
+			ZOO_THROW_EXCEPTION(std::invalid_argument{ "a lag probe is required when max_replica_lag is set" });
+		}
+
+		this->replicas_.reserve(replicas.size());
+		for (auto& pool : replicas)
+		{
+			this->replicas_.push_back(std::make_unique<route>(std::move(pool)));
+		}
+	}
+
+	impl(const impl&)            = delete;
+	impl& operator=(const impl&) = delete;
+
+	std::shared_ptr<ibackend_connection> acquire(access_mode mode, const optional_deadline& deadline)
+	{
+		return mode == access_mode::read_only ? this->acquire_replica(deadline) : this->acquire_primary(deadline);
+	}
+
+	routing_pool_stats stats() const
+	{
+		lock_type lock{ this->mutex_ };
+
+		routing_pool_stats result{ .primary = this->primary_.stats(), .replicas = {} };
+		result.replicas.reserve(this->replicas_.size());
+		for (const auto& r : this->replicas_)
+		{
+			result.replicas.push_back(r->stats());
+		}
+		return result;
+	}
+};
+
+routing_pool::routing_pool(connection_pool&& primary, std::vector<connection_pool>&& replicas, const routing_pool_options& options)
+    : pimpl_{ std::make_shared<impl>(std::move(primary), std::move(replicas), options) }
+{
+}
+
+routing_pool::~routing_pool() noexcept = default;
+
+routing_pool::routing_pool(routing_pool&&) = default;
+
+routing_pool& routing_pool::operator=(routing_pool&&) = default;
+
+std::shared_ptr<ibackend_connection> routing_pool::acquire(access_mode mode)
+{
+	return this->pimpl_->acquire(mode, std::nullopt);
+}
+
+std::shared_ptr<ibackend_connection> routing_pool::acquire(access_mode mode, const std::chrono::milliseconds& timeout)
+{
+	return this->pimpl_->acquire(mode, clock_type::now() + timeout);
+}
+
+std::shared_ptr<ibackend_connection> routing_pool::try_acquire(access_mode mode)
+{
+	return this->pimpl_->acquire(mode, clock_type::now());
+}
+
+routing_pool_stats routing_pool::stats() const
+{
+	return this->pimpl_->stats();
+}
+
+} // namespace squid
+} // namespace zoo
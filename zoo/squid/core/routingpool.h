@@ -0,0 +1,102 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/core/config.h"
+#include "zoo/squid/core/connectionfwd.h"
+#include "zoo/squid/core/connectionpool.h"
+#include "zoo/squid/core/ibackendconnectionfwd.h"
+
+#include <memory>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+
+/// What the work that is done on a connection needs
+enum class access_mode
+{
+	read_only,  //!< Only reads, may be routed to a replica
+	read_write, //!< May write, always routed to the primary
+};
+
+/// Options of a routing_pool
+struct routing_pool_options final
+{
+	/// Measures the replication lag of a replica, on a connection to that replica
+	using lag_probe_type = std::function<std::chrono::milliseconds(connection&)>;
+
+	std::chrono::milliseconds max_replica_lag{ 0 };        //!< Take a replica out of rotation while its lag is larger, zero disables lag checks
+	std::chrono::milliseconds lag_check_interval{ 1000 };  //!< Minimum time between two lag measurements of a replica
+	std::chrono::milliseconds retry_interval{ 5000 };      //!< How long a replica that failed stays out of rotation
+	lag_probe_type            lag_probe{};                 //!< Required when max_replica_lag is set
+	bool                      fallback_to_primary{ true }; //!< Route read-only work to the primary when no replica can take it
+};
+
+/// Statistics of one route of a routing_pool
+struct route_stats final
+{
+	std::size_t                              outstanding{}; //!< Number of connections that are handed out
+	std::uint64_t                            routed{};      //!< Number of connections that were handed out
+	std::optional<std::chrono::milliseconds> lag{};         //!< Last measured replication lag, if any
+	bool                                     in_rotation{}; //!< Whether read-only work is routed to it
+};
+
+/// Statistics of a routing_pool
+struct routing_pool_stats final
+{
+	route_stats              primary{};
+	std::vector<route_stats> replicas{}; //!< In the order the replica pools were given
+};
+
+/// Thread safe pool that splits reads from writes over a primary database and its replicas.
+/// Read-write work always gets a connection of the primary pool. Read-only work gets a connection of the replica with
+/// the fewest connections handed out, replicas with an equal number take turns.
+/// A replica leaves the rotation for a while when acquiring a connection fails, and, when lag checks are enabled,
+/// while its replication lag exceeds the maximum. The lag is measured with the lag probe on a connection that is about
+/// to be handed out, when the previous measurement is older than the check interval, so no background thread is needed.
+class ZOO_SQUID_CORE_API routing_pool final
+{
+	class impl;
+	std::shared_ptr<impl> pimpl_;
+
+public:
+	/// Create a pool that routes to the @a primary pool and the @a replicas pools
+	routing_pool(connection_pool&& primary, std::vector<connection_pool>&& replicas, const routing_pool_options& options = {});
+	~routing_pool() noexcept;
+
+	routing_pool(routing_pool&&);
+	routing_pool& operator=(routing_pool&&);
+
+	routing_pool(const routing_pool&)            = delete;
+	routing_pool& operator=(const routing_pool&) = delete;
+
+	/// Acquire a backend connection for @a mode
+	/// Waits indefinitely until the chosen pool has a connection available.
+	/// Returns nullptr if read-only work cannot be routed, because no replica is in rotation and fallback to the
+	/// primary is disabled.
+	std::shared_ptr<ibackend_connection> acquire(access_mode mode);
+
+	/// Acquire a backend connection for @a mode with timeout
+	/// Returns nullptr if no connection is available within the specified timeout.
+	std::shared_ptr<ibackend_connection> acquire(access_mode mode, const std::chrono::milliseconds& timeout);
+
+	/// Acquire a backend connection for @a mode
+	/// Immediately returns nullptr if no connection is available.
+	std::shared_ptr<ibackend_connection> try_acquire(access_mode mode);
+
+	/// Get the current statistics of the pool
+	routing_pool_stats stats() const;
+};
+
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,17 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+namespace zoo {
+namespace squid {
+
+enum class access_mode;
+class routing_pool;
+
+} // namespace squid
+} // namespace zoo
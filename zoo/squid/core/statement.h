@@ -43,8 +43,10 @@ public:
 	using basic_statement::bind_results;
 	using basic_statement::execute;
 	using basic_statement::fetch;
+	using basic_statement::fetch_columns;
 	using basic_statement::field_count;
 	using basic_statement::field_name;
+	using basic_statement::set_fetch_mode;
 };
 
 } // namespace squid
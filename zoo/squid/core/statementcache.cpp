@@ -0,0 +1,148 @@
+//
+// Copyright (C) 2022-2024 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/core/statementcache.h"
+
+#include <cassert>
+#include <cctype>
+
+namespace zoo {
+namespace squid {
+
+namespace {
+
+bool is_identifier_char(char c)
+{
+	return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$';
+}
+
+// The length of the dollar quote tag ($$ or $tag$) that starts @a query, or 0 if it does not start with one
+std::size_t dollar_tag_length(std::string_view query)
+{
+	assert(!query.empty() && query.front() == '$');
+	auto i = std::size_t{ 1 };
+	if (i < query.length() && !std::isdigit(static_cast<unsigned char>(query[i])))
+	{
+		while (i < query.length() && query[i] != '$' && is_identifier_char(query[i]))
+		{
+			++i;
+		}
+	}
+	return i < query.length() && query[i] == '$' ? i + 1 : 0;
+}
+
+} // namespace
+
+std::string normalize_query(std::string_view query)
+{
+	std::string result{};
+	result.reserve(query.length());
+
+	auto pending_space = false;
+
+	for (auto i = std::size_t{}; i < query.length();)
+	{
+		const auto c = query[i];
+		if (std::isspace(static_cast<unsigned char>(c)))
+		{
+			// The newline that ends a line comment already separates it from what follows
+			pending_space = !result.empty() && result.back() != '\n';
+			++i;
+			continue;
+		}
+
+		if (pending_space)
+		{
+			result.push_back(' ');
+			pending_space = false;
+		}
+
+		const auto rest = query.substr(i);
+
+		// Everything up to @a end is copied as is. When the dialects disagree on what a token is, e.g. backslash escapes
+		// in string literals or # comments, the rest of the query is copied as is, so that different queries never get
+		// the same key.
+		auto end    = std::string_view::npos;
+		auto quoted = std::string_view{};
+		if (c == '\'' || c == '"' || c == '`')
+		{
+			// A doubled quote closes and reopens the literal, which works out the same
+			if (const auto close = rest.find(c, 1); close != std::string_view::npos)
+			{
+				end    = close + 1;
+				quoted = rest.substr(1, close - 1);
+			}
+			if (quoted.find('\\') != std::string_view::npos)
+			{
+				end = std::string_view::npos;
+			}
+		}
+		else if (rest.starts_with("--"))
+		{
+			if (const auto eol = rest.find('\n'); eol != std::string_view::npos)
+			{
+				end    = eol + 1;
+				quoted = rest.substr(2, eol - 2);
+			}
+		}
+		else if (rest.starts_with("/*"))
+		{
+			if (const auto close = rest.find("*/", 2); close != std::string_view::npos)
+			{
+				end    = close + 2;
+				quoted = rest.substr(2, close - 2);
+			}
+			if (quoted.find("/*") != std::string_view::npos)
+			{
+				// Nested comment
+				end = std::string_view::npos;
+			}
+		}
+		else if (c == '#')
+		{
+			// A comment in MySQL, an operator in PostgreSQL
+		}
+		else if (c == '$' && (result.empty() || !is_identifier_char(result.back())))
+		{
+			if (const auto tag_length = dollar_tag_length(rest); tag_length != 0)
+			{
+				if (const auto close = rest.find(rest.substr(0, tag_length), tag_length); close != std::string_view::npos)
+				{
+					end = close + tag_length;
+				}
+			}
+			else
+			{
+				end = 1; // a parameter, e.g. $1
+			}
+		}
+		else
+		{
+			end = 1;
+		}
+
+		// A quote in a comment means that we may have to disagree with the server on where the comment ends
+		if (c != '\'' && c != '"' && c != '`' && quoted.find_first_of("'\"`$") != std::string_view::npos)
+		{
+			end = std::string_view::npos;
+		}
+
+		if (end == std::string_view::npos)
+		{
+			result.append(rest);
+			break;
+		}
+
+		result.append(rest.substr(0, end));
+		i += end;
+	}
+
+	return result;
+}
+
+} // namespace squid
+} // namespace zoo
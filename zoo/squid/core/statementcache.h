@@ -0,0 +1,178 @@
+//
+// Copyright (C) 2022-2024 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/core/config.h"
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+namespace zoo {
+namespace squid {
+
+/// Statistics of a prepared statement cache
+struct statement_cache_stats
+{
+	std::uint64_t hits{};      //!< Number of times a cached prepared statement was reused
+	std::uint64_t misses{};    //!< Number of times a statement had to be prepared
+	std::uint64_t evictions{}; //!< Number of cached prepared statements that were discarded
+	std::size_t   size{};      //!< Number of idle prepared statements currently in the cache
+	std::size_t   capacity{};  //!< Maximum number of idle prepared statements in the cache
+};
+
+/// Normalize @a query for use as a statement cache key.
+/// Runs of whitespace outside of quoted strings and identifiers, comments and dollar quoted strings are collapsed to a
+/// single space, and leading and trailing whitespace is removed.
+/// Where the SQL dialects disagree, e.g. on backslash escapes or # comments, the rest of the query is kept as is,
+/// so that two different queries never normalize to the same key.
+ZOO_SQUID_CORE_API std::string normalize_query(std::string_view query);
+
+/// Bounded LRU cache of idle prepared backend statements, keyed by (normalized) query text.
+/// A cached statement is checked out with acquire() while it is in use and checked in again with release()
+/// when it is no longer used, so that a prepared statement is never used by two statements at the same time.
+/// When there are more idle statements than the capacity, the least recently used one is evicted and
+/// handed to the eviction function, which should release the server side resources.
+/// Statements that are still in the cache when the cache is destroyed are destroyed without calling the
+/// eviction function, they go away with the connection.
+/// Not thread safe, a backend connection is used by one thread at a time.
+template<typename Value>
+class statement_cache final
+{
+public:
+	using evict_function_type = std::function<void(Value&)>;
+
+	static constexpr std::size_t default_capacity = 64;
+
+private:
+	struct entry
+	{
+		std::string key;
+		Value       value;
+	};
+
+	using list_type  = std::list<entry>;
+	using index_type = std::unordered_multimap<std::string_view, typename list_type::iterator>;
+
+	list_type             lru_; // most recently used first
+	index_type            index_;
+	std::size_t           capacity_;
+	evict_function_type   evict_;
+	statement_cache_stats stats_;
+
+	void erase_index(typename list_type::iterator it)
+	{
+		auto [first, last] = this->index_.equal_range(it->key);
+		for (; first != last; ++first)
+		{
+			if (first->second == it)
+			{
+				this->index_.erase(first);
+				return;
+			}
+		}
+	}
+
+	void trim(std::size_t size)
+	{
+		while (this->lru_.size() > size)
+		{
+			auto it = std::prev(this->lru_.end());
+			this->erase_index(it);
+			auto value = std::move(it->value);
+			this->lru_.erase(it);
+			++this->stats_.evictions;
+			if (this->evict_)
+			{
+				this->evict_(value);
+			}
+		}
+	}
+
+public:
+	explicit statement_cache(std::size_t capacity = default_capacity, evict_function_type evict = {})
+	    : lru_{}
+	    , index_{}
+	    , capacity_{ capacity }
+	    , evict_{ std::move(evict) }
+	    , stats_{}
+	{
+	}
+
+	statement_cache(const statement_cache&)            = delete;
+	statement_cache& operator=(const statement_cache&) = delete;
+
+	/// Check out an idle statement for @a key.
+	/// Returns std::nullopt (and counts a miss) if there is none, in which case the caller must prepare
+	/// a new statement and release() it when it is done.
+	std::optional<Value> acquire(std::string_view key)
+	{
+		const auto found = this->index_.find(key);
+		if (found == this->index_.end())
+		{
+			++this->stats_.misses;
+			return std::nullopt;
+		}
+
+		++this->stats_.hits;
+		const auto it    = found->second;
+		auto       value = std::move(it->value);
+		this->index_.erase(found);
+		this->lru_.erase(it);
+		return value;
+	}
+
+	/// Check in the statement @a value for @a key.
+	/// This may evict the least recently used statement, or @a value itself if the cache is disabled.
+	void release(std::string key, Value value)
+	{
+		this->lru_.push_front(entry{ std::move(key), std::move(value) });
+		this->index_.emplace(this->lru_.front().key, this->lru_.begin());
+		this->trim(this->capacity_);
+	}
+
+	/// Evict all idle statements
+	void clear()
+	{
+		this->trim(0);
+	}
+
+	/// Set the maximum number of idle statements, evicting the excess ones.
+	/// A capacity of zero disables the cache.
+	void set_capacity(std::size_t capacity)
+	{
+		this->capacity_ = capacity;
+		this->trim(this->capacity_);
+	}
+
+	std::size_t capacity() const
+	{
+		return this->capacity_;
+	}
+
+	std::size_t size() const
+	{
+		return this->lru_.size();
+	}
+
+	statement_cache_stats stats() const
+	{
+		auto result     = this->stats_;
+		result.size     = this->lru_.size();
+		result.capacity = this->capacity_;
+		return result;
+	}
+};
+
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,63 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "mock_backend_connection.h"
+
+namespace zoo {
+namespace squid {
+
+using testing::_;
+using testing::An;
+
+mock_backend_statement::mock_backend_statement()
+{
+	ON_CALL(*this, parameter_binding_plan).WillByDefault([this] { return this->ibackend_statement::parameter_binding_plan(); });
+	ON_CALL(*this, execute_positional(_, An<const std::vector<result>&>()))
+	    .WillByDefault([this](const positional_parameters& parameters, const std::vector<result>& results) {
+		    this->ibackend_statement::execute_positional(parameters, results);
+	    });
+	ON_CALL(*this, execute_positional(_, An<const result_map&>()))
+	    .WillByDefault([this](const positional_parameters& parameters, const result_map& results) {
+		    this->ibackend_statement::execute_positional(parameters, results);
+	    });
+	ON_CALL(*this, execute_batch).WillByDefault([this](std::span<const parameter_map> batch) {
+		return this->ibackend_statement::execute_batch(batch);
+	});
+	ON_CALL(*this, execute_batch_positional).WillByDefault([this](std::span<const positional_parameters> batch) {
+		return this->ibackend_statement::execute_batch_positional(batch);
+	});
+	ON_CALL(*this, execute_batch_named).WillByDefault([this](const binding_plan& names, std::span<const positional_parameters> batch) {
+		return this->ibackend_statement::execute_batch_named(names, batch);
+	});
+	ON_CALL(*this, fetch_columns).WillByDefault([this](column_batch& batch, std::size_t batch_size) {
+		return this->ibackend_statement::fetch_columns(batch, batch_size);
+	});
+}
+
+mock_backend_statement::~mock_backend_statement()
+{
+}
+
+mock_backend_connection::mock_backend_connection()
+{
+	ON_CALL(*this, cancel).WillByDefault([this] { this->ibackend_connection::cancel(); });
+}
+
+mock_backend_connection::~mock_backend_connection()
+{
+}
+
+mock_backend_connection_factory::mock_backend_connection_factory()
+{
+}
+
+mock_backend_connection_factory::~mock_backend_connection_factory()
+{
+}
+
+} // namespace squid
+} // namespace zoo
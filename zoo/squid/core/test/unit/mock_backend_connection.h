@@ -0,0 +1,87 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/core/ibackendconnection.h"
+#include "zoo/squid/core/ibackendconnectionfactory.h"
+#include "zoo/squid/core/ibackendstatement.h"
+#include <gmock/gmock.h>
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+
+class ZOO_SQUID_CORE_API mock_backend_statement : public ibackend_statement
+{
+public:
+	using parameter_map = std::map<std::string, parameter>;
+	using result_map    = std::map<std::string, result>;
+
+	// The methods that have a default implementation in ibackend_statement call it, unless a test overrides them
+	explicit mock_backend_statement();
+	~mock_backend_statement() override;
+
+	MOCK_METHOD(void, execute, (const parameter_map& parameters, const std::vector<result>& results), (override));
+	MOCK_METHOD(void, execute, (const parameter_map& parameters, const result_map& results), (override));
+	MOCK_METHOD(bool, fetch, (), (override));
+	MOCK_METHOD(std::size_t, field_count, (), (override));
+	MOCK_METHOD(std::string, field_name, (std::size_t index), (override));
+	MOCK_METHOD(std::uint64_t, affected_rows, (), (override));
+	MOCK_METHOD(void, set_fetch_mode, (fetch_mode mode), (override));
+	MOCK_METHOD(const binding_plan*, parameter_binding_plan, (), (const, override));
+	MOCK_METHOD(void, execute_positional, (const positional_parameters& parameters, const std::vector<result>& results), (override));
+	MOCK_METHOD(void, execute_positional, (const positional_parameters& parameters, const result_map& results), (override));
+	MOCK_METHOD(std::uint64_t, execute_batch, (std::span<const parameter_map> batch), (override));
+	MOCK_METHOD(std::uint64_t, execute_batch_positional, (std::span<const positional_parameters> batch), (override));
+	MOCK_METHOD(std::uint64_t, execute_batch_named, (const binding_plan& names, std::span<const positional_parameters> batch), (override));
+	MOCK_METHOD(std::size_t, fetch_columns, (column_batch & batch, std::size_t batch_size), (override));
+};
+
+class ZOO_SQUID_CORE_API mock_backend_connection : public ibackend_connection
+{
+public:
+	// cancel() calls the default implementation of ibackend_connection, unless a test overrides it
+	explicit mock_backend_connection();
+	~mock_backend_connection() override;
+
+	MOCK_METHOD(std::unique_ptr<ibackend_statement>, create_statement, (std::string_view query), (override));
+	MOCK_METHOD(std::unique_ptr<ibackend_statement>, create_prepared_statement, (std::string_view query), (override));
+	MOCK_METHOD(void, execute, (const std::string& query), (override));
+	MOCK_METHOD(statement_cache_stats, prepared_statement_cache_stats, (), (const, override));
+	MOCK_METHOD(void, set_prepared_statement_cache_capacity, (std::size_t capacity), (override));
+	MOCK_METHOD(bool, is_valid, (), (override));
+	MOCK_METHOD(void, cancel, (), (override));
+};
+
+class ZOO_SQUID_CORE_API mock_backend_connection_factory : public ibackend_connection_factory
+{
+public:
+	explicit mock_backend_connection_factory();
+	~mock_backend_connection_factory() override;
+
+	MOCK_METHOD(std::shared_ptr<ibackend_connection>, create_backend_connection, (std::string_view connection_info), (const, override));
+};
+
+using nice_mock_backend_statement   = testing::NiceMock<mock_backend_statement>;
+using naggy_mock_backend_statement  = testing::NaggyMock<mock_backend_statement>;
+using strict_mock_backend_statement = testing::StrictMock<mock_backend_statement>;
+
+using nice_mock_backend_connection   = testing::NiceMock<mock_backend_connection>;
+using naggy_mock_backend_connection  = testing::NaggyMock<mock_backend_connection>;
+using strict_mock_backend_connection = testing::StrictMock<mock_backend_connection>;
+
+using nice_mock_backend_connection_factory   = testing::NiceMock<mock_backend_connection_factory>;
+using naggy_mock_backend_connection_factory  = testing::NaggyMock<mock_backend_connection_factory>;
+using strict_mock_backend_connection_factory = testing::StrictMock<mock_backend_connection_factory>;
+
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,64 @@
+//
+// Copyright (C) 2022-2024 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include <zoo/squid/core/bindingplan.h>
+#include <zoo/squid/core/translatedquerycache.h>
+
+namespace zoo {
+namespace squid {
+
+namespace {
+
+struct counting_query
+{
+	static inline int translations = 0;
+
+	std::string text;
+
+	explicit counting_query(std::string_view query)
+	    : text{ query }
+	{
+		++translations;
+	}
+};
+
+} // namespace
+
+TEST(BindingPlanTest, IndexOf)
+{
+	binding_plan plan{ { "first", "second" } };
+	EXPECT_EQ(plan.size(), 2u);
+	EXPECT_EQ(plan.index_of("first"), 0u);
+	EXPECT_EQ(plan.index_of("second"), 1u);
+	EXPECT_FALSE(plan.index_of("third").has_value());
+	EXPECT_EQ(plan.name(1), "second");
+	EXPECT_EQ(binding_plan{}.size(), 0u);
+}
+
+TEST(TranslatedQueryCacheTest, TranslatesOnce)
+{
+	translated_query_cache<counting_query> cache{ 2 };
+	counting_query::translations = 0;
+
+	const auto a = cache.get("a");
+	EXPECT_EQ(cache.get("a").get(), a.get());
+	EXPECT_EQ(counting_query::translations, 1);
+	EXPECT_EQ(a->text, "a");
+
+	cache.get("b");
+	EXPECT_EQ(cache.size(), 2u);
+
+	// Full, so it is emptied, but translations in use stay valid
+	cache.get("c");
+	EXPECT_EQ(cache.size(), 1u);
+	EXPECT_EQ(a->text, "a");
+	EXPECT_EQ(counting_query::translations, 3);
+}
+
+} // namespace squid
+} // namespace zoo
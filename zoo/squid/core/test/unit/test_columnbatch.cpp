@@ -0,0 +1,85 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include <zoo/squid/core/columnbatch.h>
+#include <zoo/squid/core/error.h>
+
+namespace zoo {
+namespace squid {
+
+TEST(NullBitmapTest, SpansWords)
+{
+	null_bitmap nulls{};
+	for (auto i = 0; i < 130; ++i)
+	{
+		nulls.push_back(i % 3 == 0);
+	}
+	EXPECT_EQ(nulls.size(), 130u);
+	EXPECT_EQ(nulls.words().size(), 3u);
+	EXPECT_TRUE(nulls.is_null(0));
+	EXPECT_FALSE(nulls.is_null(64));
+	EXPECT_TRUE(nulls.is_null(129));
+	EXPECT_EQ(nulls.null_count(), 44u);
+
+	nulls.clear();
+	EXPECT_EQ(nulls.size(), 0u);
+	EXPECT_EQ(nulls.null_count(), 0u);
+}
+
+TEST(TextColumnTest, StoresStringsBackToBack)
+{
+	text_column texts{};
+	texts.push_back("foo");
+	texts.push_back("");
+	texts.push_back("barbaz");
+	EXPECT_EQ(texts.size(), 3u);
+	EXPECT_EQ(texts[0], "foo");
+	EXPECT_EQ(texts[1], "");
+	EXPECT_EQ(texts[2], "barbaz");
+	EXPECT_EQ(texts.data(), "foobarbaz");
+	EXPECT_EQ(texts.offsets(), (std::vector<std::size_t>{ 0u, 3u, 3u, 9u }));
+
+	texts.clear();
+	EXPECT_EQ(texts.size(), 0u);
+	EXPECT_EQ(texts.offsets(), (std::vector<std::size_t>{ 0u }));
+}
+
+TEST(ColumnBatchTest, ColumnTypes)
+{
+	column_batch batch{ column_type::int64, column_type::float64, column_type::text };
+	ASSERT_EQ(batch.column_count(), 3u);
+	EXPECT_TRUE(batch.empty());
+
+	batch.column(0).int64_values().push_back(42);
+	batch.column(0).nulls().push_back(false);
+	batch.column(1).float64_values().push_back(0.0);
+	batch.column(1).nulls().push_back(true);
+	batch.column(2).text_values().push_back("x");
+	batch.column(2).nulls().push_back(false);
+	batch.set_rows(1u);
+
+	const auto& cbatch = batch;
+	EXPECT_EQ(cbatch.rows(), 1u);
+	EXPECT_EQ(cbatch.column(0).int64_values().at(0), 42);
+	EXPECT_TRUE(cbatch.column(1).nulls().is_null(0));
+	EXPECT_EQ(cbatch.column(2).text_values()[0], "x");
+	EXPECT_EQ(cbatch.column(2).size(), 1u);
+
+	EXPECT_THROW(cbatch.column(0).text_values(), error);
+	EXPECT_THROW(cbatch.column(2).float64_values(), error);
+	EXPECT_THROW(cbatch.column(3), std::out_of_range);
+
+	batch.clear();
+	EXPECT_TRUE(batch.empty());
+	EXPECT_EQ(batch.column(0).size(), 0u);
+	EXPECT_TRUE(batch.column(0).int64_values().empty());
+	EXPECT_EQ(batch.column(2).text_values().size(), 0u);
+}
+
+} // namespace squid
+} // namespace zoo
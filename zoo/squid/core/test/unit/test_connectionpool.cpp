@@ -0,0 +1,281 @@
+//
+// Copyright (C) 2022-2024 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include <zoo/squid/core/connectionpool.h>
+#include <zoo/squid/core/connection.h>
+
+#include "mock_backend_connection.h"
+
+#include <boost/asio/bind_cancellation_slot.hpp>
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/system/system_error.hpp>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+
+namespace {
+
+using namespace std::chrono_literals;
+
+/// Creates connections that are numbered in order of creation and that are valid as long as valid is set
+class ConnectionPoolTests : public testing::Test
+{
+protected:
+	int  created{};
+	int  last_executed{};
+	bool valid{ true };
+
+	std::shared_ptr<nice_mock_backend_connection_factory> factory = std::make_shared<nice_mock_backend_connection_factory>();
+
+	void SetUp() override
+	{
+		ON_CALL(*this->factory, create_backend_connection).WillByDefault([this](std::string_view) -> std::shared_ptr<ibackend_connection> {
+			const auto id         = ++this->created;
+			auto       connection = std::make_shared<nice_mock_backend_connection>();
+			ON_CALL(*connection, execute).WillByDefault([this, id](const std::string&) { this->last_executed = id; });
+			ON_CALL(*connection, is_valid).WillByDefault([this] { return this->valid; });
+			return connection;
+		});
+	}
+
+	// Find out which backend connection @a connection is
+	int id_of(ibackend_connection& connection)
+	{
+		connection.execute("");
+		return this->last_executed;
+	}
+};
+
+} // namespace
+
+TEST_F(ConnectionPoolTests, FixedSizeOpensAllUpFront)
+{
+	auto pool = connection_pool{ *this->factory, "", 3 };
+
+	EXPECT_EQ(this->created, 3);
+	EXPECT_EQ(pool.stats().size, 3u);
+	EXPECT_EQ(pool.stats().idle, 3u);
+	EXPECT_THROW((connection_pool{ *this->factory, "", 0 }), std::invalid_argument);
+}
+
+TEST_F(ConnectionPoolTests, GrowsLazilyUpToTheMaximum)
+{
+	auto pool = connection_pool{ this->factory, "", connection_pool_options{ .min_size = 1, .max_size = 2 } };
+
+	EXPECT_EQ(this->created, 1);
+
+	auto c1 = pool.acquire();
+	EXPECT_EQ(this->created, 1);
+	auto c2 = pool.acquire();
+	EXPECT_EQ(this->created, 2);
+
+	EXPECT_EQ(pool.try_acquire(), nullptr);
+	EXPECT_EQ(pool.acquire(5ms), nullptr);
+
+	c1.reset();
+	EXPECT_NE(pool.try_acquire(), nullptr);
+
+	const auto stats = pool.stats();
+	EXPECT_EQ(stats.size, 2u);
+	EXPECT_EQ(stats.idle, 1u);
+	EXPECT_EQ(stats.created, 2u);
+}
+
+TEST_F(ConnectionPoolTests, MostRecentlyReleasedIsReusedFirst)
+{
+	auto pool = connection_pool{ this->factory, "", connection_pool_options{ .min_size = 0, .max_size = 3 } };
+
+	auto c1 = pool.acquire();
+	auto c2 = pool.acquire();
+	auto c3 = pool.acquire();
+
+	const auto id2 = this->id_of(*c2);
+	c1.reset();
+	c3.reset();
+	c2.reset();
+
+	EXPECT_EQ(this->id_of(*pool.acquire()), id2);
+}
+
+TEST_F(ConnectionPoolTests, WaiterGetsReleasedConnection)
+{
+	auto pool = connection_pool{ this->factory, "", connection_pool_options{ .min_size = 1, .max_size = 1 } };
+
+	auto        c = pool.acquire();
+	std::thread t{ [&c] {
+		std::this_thread::sleep_for(10ms);
+		c.reset();
+	} };
+
+	EXPECT_NE(pool.acquire(5s), nullptr);
+	t.join();
+}
+
+TEST_F(ConnectionPoolTests, InvalidConnectionIsReplacedOnBorrow)
+{
+	auto pool = connection_pool{ this->factory, "", connection_pool_options{ .min_size = 1, .max_size = 1 } };
+
+	this->valid = false;
+	auto c      = pool.acquire();
+	ASSERT_NE(c, nullptr);
+	EXPECT_EQ(this->id_of(*c), 2);
+
+	const auto stats = pool.stats();
+	EXPECT_EQ(stats.size, 1u);
+	EXPECT_EQ(stats.created, 2u);
+	EXPECT_EQ(stats.closed, 1u);
+}
+
+TEST_F(ConnectionPoolTests, IdleConnectionsAboveTheMinimumAreClosed)
+{
+	auto pool = connection_pool{ this->factory, "", connection_pool_options{ .min_size = 1, .max_size = 3, .idle_timeout = 1ms } };
+
+	{
+		auto c1 = pool.acquire();
+		auto c2 = pool.acquire();
+		auto c3 = pool.acquire();
+	}
+	EXPECT_EQ(pool.stats().idle, 3u);
+
+	std::this_thread::sleep_for(10ms);
+
+	auto c = pool.acquire();
+	EXPECT_EQ(this->id_of(*c), 1); // the most recently released one (c1) is kept
+
+	const auto stats = pool.stats();
+	EXPECT_EQ(stats.size, 1u);
+	EXPECT_EQ(stats.closed, 2u);
+}
+
+TEST_F(ConnectionPoolTests, ConnectionMayOutliveThePool)
+{
+	std::shared_ptr<ibackend_connection> c{};
+	{
+		auto pool = connection_pool{ this->factory, "", connection_pool_options{} };
+		c         = pool.acquire();
+	}
+	EXPECT_EQ(this->id_of(*c), 1);
+	c.reset();
+}
+
+TEST_F(ConnectionPoolTests, AsyncAcquire)
+{
+	auto pool = connection_pool{ this->factory, "", connection_pool_options{ .min_size = 1, .max_size = 1 } };
+	auto io   = boost::asio::io_context{};
+
+	std::shared_ptr<ibackend_connection> connection{};
+	pool.async_acquire(io.get_executor(), [&connection](std::exception_ptr e, std::shared_ptr<ibackend_connection> c) {
+		EXPECT_FALSE(e);
+		connection = std::move(c);
+	});
+	EXPECT_EQ(connection, nullptr); // the handler is not invoked from within async_acquire
+
+	io.run();
+	EXPECT_NE(connection, nullptr);
+}
+
+TEST_F(ConnectionPoolTests, AsyncWaitersAreServedInOrder)
+{
+	auto pool = connection_pool{ this->factory, "", connection_pool_options{ .min_size = 1, .max_size = 1 } };
+	auto io   = boost::asio::io_context{};
+	auto held = pool.acquire();
+
+	std::vector<int> order{};
+	for (int i = 0; i < 3; ++i)
+	{
+		pool.async_acquire(io.get_executor(), [i, &order](std::exception_ptr e, std::shared_ptr<ibackend_connection> c) {
+			EXPECT_FALSE(e);
+			EXPECT_NE(c, nullptr);
+			order.push_back(i);
+			// c is released here, which hands it to the next waiter
+		});
+	}
+	EXPECT_EQ(pool.stats().waiting, 3u);
+
+	// A thread that tries now must not jump the queue
+	EXPECT_EQ(pool.try_acquire(), nullptr);
+
+	held.reset();
+	io.run();
+
+	EXPECT_EQ(order, (std::vector<int>{ 0, 1, 2 }));
+	EXPECT_EQ(pool.stats().waiting, 0u);
+	EXPECT_EQ(pool.stats().idle, 1u);
+}
+
+TEST_F(ConnectionPoolTests, AsyncAcquireTimesOut)
+{
+	auto pool = connection_pool{ this->factory, "", connection_pool_options{ .min_size = 1, .max_size = 1 } };
+	auto io   = boost::asio::io_context{};
+	auto held = pool.acquire();
+
+	std::exception_ptr error{};
+	pool.async_acquire(io.get_executor(), 5ms, [&error](std::exception_ptr e, std::shared_ptr<ibackend_connection> c) {
+		EXPECT_EQ(c, nullptr);
+		error = e;
+	});
+
+	io.run();
+	ASSERT_TRUE(error);
+	EXPECT_THROW(std::rethrow_exception(error), no_connection_available);
+	EXPECT_EQ(pool.stats().waiting, 0u);
+}
+
+TEST_F(ConnectionPoolTests, AsyncAcquireCanBeCancelled)
+{
+	auto pool = connection_pool{ this->factory, "", connection_pool_options{ .min_size = 1, .max_size = 1 } };
+	auto io   = boost::asio::io_context{};
+	auto held = pool.acquire();
+
+	boost::asio::cancellation_signal signal{};
+	std::exception_ptr               error{};
+	pool.async_acquire(io.get_executor(),
+	                   boost::asio::bind_cancellation_slot(signal.slot(), [&error](std::exception_ptr e, std::shared_ptr<ibackend_connection>) {
+		                   error = e;
+	                   }));
+
+	signal.emit(boost::asio::cancellation_type::terminal);
+	io.run();
+
+	ASSERT_TRUE(error);
+	EXPECT_THROW(std::rethrow_exception(error), boost::system::system_error);
+
+	// The connection that is released now is not handed to the cancelled operation
+	held.reset();
+	EXPECT_EQ(pool.stats().idle, 1u);
+}
+
+TEST_F(ConnectionPoolTests, AsyncAcquireInCoroutine)
+{
+	auto pool = connection_pool{ this->factory, "", connection_pool_options{ .min_size = 0, .max_size = 1 } };
+	auto io   = boost::asio::io_context{};
+
+	auto acquired = false;
+	boost::asio::co_spawn(
+	    io,
+	    [&]() -> boost::asio::awaitable<void> {
+		    auto connection = co_await pool.async_acquire(io.get_executor(), boost::asio::use_awaitable);
+		    acquired        = connection != nullptr;
+	    },
+	    boost::asio::detached);
+
+	io.run();
+	EXPECT_TRUE(acquired);
+	EXPECT_EQ(pool.stats().idle, 1u);
+}
+
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,196 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include <zoo/squid/core/deadline.h>
+#include <zoo/squid/core/connection.h>
+#include <zoo/squid/core/connectionpool.h>
+#include <zoo/squid/core/statement.h>
+#include <zoo/squid/core/transaction.h>
+
+#include "mock_backend_connection.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+
+namespace {
+
+using namespace std::chrono_literals;
+using testing::_;
+using testing::An;
+using testing::InvokeWithoutArgs;
+using testing::Return;
+
+/// A database whose "SLOW" statements run until they are cancelled
+class fake_database final
+{
+public:
+	std::mutex               mutex{};
+	std::condition_variable  cv{};
+	bool                     cancelled{};
+	int                      cancels{};
+	int                      executions{};
+	std::vector<std::string> executed{};
+
+	void run(std::string_view query)
+	{
+		std::unique_lock<std::mutex> lock{ this->mutex };
+		++this->executions;
+		if (query == "SLOW")
+		{
+			// Give up after a while, so that a failing test does not hang
+			this->cv.wait_for(lock, 10s, [this] { return this->cancelled; });
+			if (this->cancelled)
+			{
+				this->cancelled = false;
+				throw std::runtime_error{ "canceling statement due to user request" };
+			}
+		}
+	}
+
+	void cancel()
+	{
+		{
+			std::lock_guard<std::mutex> lock{ this->mutex };
+			this->cancelled = true;
+			++this->cancels;
+		}
+		this->cv.notify_all();
+	}
+
+	std::shared_ptr<ibackend_connection> connect()
+	{
+		const auto create_statement = [this](std::string_view query) -> std::unique_ptr<ibackend_statement> {
+			auto st  = std::make_unique<nice_mock_backend_statement>();
+			auto run = InvokeWithoutArgs([this, query = std::string{ query }] { this->run(query); });
+			ON_CALL(*st, execute(_, An<const std::vector<result>&>())).WillByDefault(run);
+			ON_CALL(*st, execute(_, An<const mock_backend_statement::result_map&>())).WillByDefault(run);
+			return st;
+		};
+
+		auto connection = std::make_shared<nice_mock_backend_connection>();
+		ON_CALL(*connection, create_statement).WillByDefault(create_statement);
+		ON_CALL(*connection, create_prepared_statement).WillByDefault(create_statement);
+		ON_CALL(*connection, execute).WillByDefault([this](const std::string& query) {
+			std::lock_guard<std::mutex> lock{ this->mutex };
+			this->executed.push_back(query);
+		});
+		ON_CALL(*connection, is_valid).WillByDefault(Return(true));
+		ON_CALL(*connection, cancel).WillByDefault([this] { this->cancel(); });
+		return connection;
+	}
+};
+
+class DeadlineTests : public testing::Test
+{
+protected:
+	fake_database database{};
+	connection    conn{ this->database.connect() };
+};
+
+} // namespace
+
+TEST(DeadlineTest, Remaining)
+{
+	EXPECT_FALSE(deadline::after(1h).expired());
+	EXPECT_GT(deadline::after(1h).remaining(), 59min);
+	EXPECT_TRUE(deadline::after(-1ms).expired());
+	EXPECT_EQ(deadline::after(-1ms).remaining(), 0ms);
+	EXPECT_TRUE(deadline::after(1ms) < deadline::after(1h));
+}
+
+TEST_F(DeadlineTests, TimeoutCancelsTheStatement)
+{
+	statement st{ this->conn, "SLOW" };
+	st.set_timeout(20ms);
+	EXPECT_THROW(st.execute(), deadline_exceeded);
+	EXPECT_EQ(this->database.cancels, 1);
+}
+
+TEST_F(DeadlineTests, StatementWithinTheDeadlineIsNotCancelled)
+{
+	statement st{ this->conn, "FAST" };
+	st.set_deadline(deadline::after(1h));
+	st.execute();
+	st.execute();
+	EXPECT_EQ(this->database.executions, 2);
+	EXPECT_EQ(this->database.cancels, 0);
+}
+
+TEST_F(DeadlineTests, ExpiredDeadlineDoesNotExecute)
+{
+	statement st{ this->conn, "FAST" };
+	st.set_deadline(deadline::after(-1ms));
+	EXPECT_THROW(st.execute(), deadline_exceeded);
+	EXPECT_EQ(this->database.executions, 0);
+}
+
+TEST_F(DeadlineTests, TransactionDeadline)
+{
+	// The margin must cover BEGIN and the fast statement on a loaded machine, the slow one waits for it to pass
+	transaction tr{ this->conn, deadline::after(300ms) };
+
+	statement fast{ this->conn, "FAST" };
+	fast.execute();
+
+	statement slow{ this->conn, "SLOW" };
+	EXPECT_THROW(slow.execute(), deadline_exceeded);
+	EXPECT_EQ(this->database.cancels, 1);
+
+	EXPECT_THROW(fast.execute(), deadline_exceeded);
+	EXPECT_EQ(this->database.executions, 2);
+
+	EXPECT_THROW(tr.commit(), deadline_exceeded);
+	EXPECT_EQ(this->database.executed, (std::vector<std::string>{ "BEGIN", "ROLLBACK" }));
+}
+
+TEST_F(DeadlineTests, TransactionDeadlineDoesNotOutliveTheTransaction)
+{
+	{
+		transaction tr{ this->conn, deadline::after(1ms) };
+		std::this_thread::sleep_for(5ms);
+	}
+
+	statement st{ this->conn, "FAST" };
+	st.execute();
+	EXPECT_EQ(this->database.executions, 1);
+}
+
+TEST(DeadlinePoolTest, AcquireByDeadline)
+{
+	fake_database database{};
+	const auto    factory = std::make_shared<nice_mock_backend_connection_factory>();
+	ON_CALL(*factory, create_backend_connection).WillByDefault(InvokeWithoutArgs([&database] { return database.connect(); }));
+	connection_pool pool{ factory, "", connection_pool_options{ .min_size = 0, .max_size = 1 } };
+
+	connection first{ pool, deadline::after(1s) };
+	EXPECT_THROW((connection{ pool, deadline::after(10ms) }), deadline_exceeded);
+}
+
+TEST(DeadlinePoolTest, TimeoutCancelsThePooledStatement)
+{
+	fake_database database{};
+	const auto    factory = std::make_shared<nice_mock_backend_connection_factory>();
+	ON_CALL(*factory, create_backend_connection).WillByDefault(InvokeWithoutArgs([&database] { return database.connect(); }));
+	connection_pool pool{ factory, "", connection_pool_options{ .min_size = 0, .max_size = 1 } };
+
+	connection conn{ pool, deadline::after(1h) };
+	statement  st{ conn, "SLOW" };
+	st.set_timeout(20ms);
+	EXPECT_THROW(st.execute(), deadline_exceeded);
+	EXPECT_EQ(database.cancels, 1);
+}
+
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,211 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include <zoo/squid/core/bindingplan.h>
+#include <zoo/squid/core/connection.h>
+#include <zoo/squid/core/statement.h>
+
+#include "mock_backend_connection.h"
+
+#include <boost/describe.hpp>
+
+#include <map>
+#include <optional>
+#include <ranges>
+#include <string>
+#include <variant>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+namespace test {
+
+struct person
+{
+	std::int32_t               id;
+	std::string                name;
+	std::optional<std::string> email;
+};
+
+BOOST_DESCRIBE_STRUCT(person, (), (id, name, email))
+
+} // namespace test
+
+namespace {
+
+using testing::_;
+using testing::An;
+using testing::Return;
+
+/// Records what basic_statement hands to the backend
+class fake_backend final
+{
+	void record(const std::vector<result>& results)
+	{
+		this->results.clear();
+		for (const auto& r : results)
+		{
+			this->results.push_back(r.value());
+		}
+	}
+
+public:
+	std::optional<binding_plan>      plan{};
+	std::map<std::string, parameter> named{};
+	positional_parameters            positional{};
+	std::vector<result::type>        results{};
+
+	std::vector<std::map<std::string, parameter>> executions{}; // parameters of every execution by name
+
+	std::shared_ptr<ibackend_connection> connect()
+	{
+		const auto create_statement = [this](std::string_view) -> std::unique_ptr<ibackend_statement> {
+			auto st = std::make_unique<nice_mock_backend_statement>();
+			ON_CALL(*st, parameter_binding_plan).WillByDefault(Return(this->plan ? &this->plan.value() : nullptr));
+			ON_CALL(*st, execute(_, An<const std::vector<result>&>()))
+			    .WillByDefault([this](const std::map<std::string, parameter>& parameters, const std::vector<result>& results) {
+				    this->named = parameters;
+				    this->executions.push_back(parameters);
+				    this->record(results);
+			    });
+			ON_CALL(*st, execute_positional(_, An<const std::vector<result>&>()))
+			    .WillByDefault([this](const positional_parameters& parameters, const std::vector<result>& results) {
+				    this->positional = parameters;
+				    this->record(results);
+			    });
+			EXPECT_CALL(*st, execute(_, An<const mock_backend_statement::result_map&>())).Times(0);
+			return st;
+		};
+
+		auto connection = std::make_shared<nice_mock_backend_connection>();
+		ON_CALL(*connection, create_statement).WillByDefault(create_statement);
+		ON_CALL(*connection, create_prepared_statement).WillByDefault(create_statement);
+		ON_CALL(*connection, is_valid).WillByDefault(Return(true));
+		return connection;
+	}
+};
+
+template<typename T>
+const T& referenced(const std::optional<parameter>& p)
+{
+	return *std::get<const T*>(p.value().pointer());
+}
+
+template<typename Range>
+concept batchable = requires(statement& st, Range&& range) { st.execute_batch(std::forward<Range>(range)); };
+
+using people = std::vector<test::person>;
+
+// A view that yields copies of the elements
+using copied_people = decltype(std::declval<people&>() | std::views::transform([](const test::person& p) { return p; }));
+
+} // namespace
+
+TEST(DescribedBindingTests, MemberNamesAreKnownAtCompileTime)
+{
+	static_assert(described_member_names<test::person>.size() == 3u);
+	static_assert(described_member_names<test::person>[1] == "name");
+}
+
+TEST(DescribedBindingTests, ParametersAreBoundByPosition)
+{
+	fake_backend backend{};
+	backend.plan = binding_plan{ { "email", "id", "unused" } };
+	connection conn{ backend.connect() };
+
+	statement st{ conn, "query" };
+	st.execute(); // creates the backend statement with its plan
+
+	auto p = test::person{ 1, "foo", "foo@example.com" };
+	st.bind_ref(p);
+	st.execute();
+	ASSERT_EQ(backend.positional.size(), 3u);
+	EXPECT_EQ(referenced<std::string>(backend.positional[0]), "foo@example.com");
+	EXPECT_EQ(referenced<std::int32_t>(backend.positional[1]), 1);
+	EXPECT_FALSE(backend.positional[2].has_value());
+	EXPECT_TRUE(backend.named.empty());
+
+	// Re-binding another value of the same type
+	auto q = test::person{ 2, "bar", std::nullopt };
+	st.bind_ref(q);
+	st.execute();
+	EXPECT_EQ(referenced<std::int32_t>(backend.positional[1]), 2);
+	EXPECT_TRUE(std::holds_alternative<const std::nullopt_t*>(backend.positional[0].value().pointer()));
+}
+
+TEST(DescribedBindingTests, ParametersAreBoundByNameWithoutPlan)
+{
+	fake_backend backend{};
+	connection   conn{ backend.connect() };
+
+	statement st{ conn, "query" };
+	st.bind(test::person{ 1, "foo", std::nullopt });
+	st.execute();
+
+	ASSERT_EQ(backend.named.size(), 3u);
+	EXPECT_EQ(std::get<std::string>(std::get<parameter::value_type>(backend.named.at("name").value())), "foo");
+	EXPECT_EQ(std::get<std::int32_t>(std::get<parameter::value_type>(backend.named.at("id").value())), 1);
+	EXPECT_TRUE(backend.positional.empty());
+}
+
+TEST(DescribedBindingTests, BatchBindsElementsThatOutliveTheCall)
+{
+	static_assert(batchable<people&>);
+	static_assert(batchable<const people&>);
+	static_assert(!batchable<people>);
+	static_assert(!batchable<copied_people&>);
+}
+
+TEST(DescribedBindingTests, BatchWithoutPlanIsBoundByName)
+{
+	fake_backend backend{};
+	connection   conn{ backend.connect() };
+
+	const auto batch = people{ { 1, "foo", std::nullopt }, { 2, "bar", "bar@example.com" } };
+
+	statement st{ conn, "query" };
+	st.bind("extra", 42);
+	st.execute_batch(batch);
+
+	ASSERT_EQ(backend.executions.size(), 2u);
+	for (std::size_t i = 0; i < batch.size(); ++i)
+	{
+		const auto& executed = backend.executions[i];
+		ASSERT_EQ(executed.size(), 4u);
+		EXPECT_EQ(*std::get<const std::int32_t*>(executed.at("id").pointer()), batch[i].id);
+		EXPECT_EQ(std::get<const std::string*>(executed.at("name").pointer()), &batch[i].name);
+		EXPECT_EQ(std::get<std::int32_t>(std::get<parameter::value_type>(executed.at("extra").value())), 42);
+	}
+
+	// A second batch with the same names, and the statement still binds by name afterwards
+	backend.executions.clear();
+	st.execute_batch(batch);
+	EXPECT_EQ(backend.executions.size(), 2u);
+
+	st.execute();
+	EXPECT_EQ(backend.named.size(), 4u);
+}
+
+TEST(DescribedBindingTests, ResultsAreBoundInDeclarationOrder)
+{
+	fake_backend backend{};
+	connection   conn{ backend.connect() };
+
+	auto      p = test::person{};
+	statement st{ conn, "query" };
+	st.bind_results(p);
+	st.execute();
+
+	ASSERT_EQ(backend.results.size(), 3u);
+	EXPECT_EQ(std::get<std::int32_t*>(std::get<result::non_nullable_type>(backend.results[0])), &p.id);
+	EXPECT_EQ(std::get<std::string*>(std::get<result::non_nullable_type>(backend.results[1])), &p.name);
+	EXPECT_EQ(std::get<std::optional<std::string>*>(std::get<result::nullable_type>(backend.results[2])), &p.email);
+}
+
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,203 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include <zoo/squid/core/hdrhistogram.h>
+#include <zoo/squid/core/querymetrics.h>
+#include <zoo/squid/core/instrumentedbackendconnection.h>
+#include <zoo/squid/core/instrumentedbackendconnectionfactory.h>
+#include <zoo/squid/core/connection.h>
+#include <zoo/squid/core/connectionpool.h>
+#include <zoo/squid/core/statement.h>
+
+#include "mock_backend_connection.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+
+namespace {
+
+using namespace std::chrono_literals;
+
+using testing::_;
+using testing::An;
+using testing::Return;
+
+/// A connection whose statements return two rows, they sleep in execute() when the query contains "slow"
+std::shared_ptr<ibackend_connection> make_backend_connection()
+{
+	const auto create_statement = [](std::string_view query) -> std::unique_ptr<ibackend_statement> {
+		auto st   = std::make_unique<nice_mock_backend_statement>();
+		auto rows = std::make_shared<int>();
+		ON_CALL(*st, execute(_, An<const std::vector<result>&>()))
+		    .WillByDefault([rows, slow = query.find("slow") != std::string_view::npos](const auto&, const auto&) {
+			    if (slow)
+			    {
+				    std::this_thread::sleep_for(2ms);
+			    }
+			    *rows = 2;
+		    });
+		ON_CALL(*st, execute(_, An<const mock_backend_statement::result_map&>())).WillByDefault([rows](const auto&, const auto&) {
+			*rows = 2;
+		});
+		ON_CALL(*st, fetch).WillByDefault([rows] { return (*rows)-- > 0; });
+		ON_CALL(*st, field_count).WillByDefault(Return(1));
+		ON_CALL(*st, field_name).WillByDefault(Return("name"));
+		return st;
+	};
+
+	auto connection = std::make_shared<nice_mock_backend_connection>();
+	ON_CALL(*connection, create_statement).WillByDefault(create_statement);
+	ON_CALL(*connection, create_prepared_statement).WillByDefault(create_statement);
+	ON_CALL(*connection, is_valid).WillByDefault(Return(true));
+	return connection;
+}
+
+std::shared_ptr<ibackend_connection_factory> make_backend_connection_factory()
+{
+	auto factory = std::make_shared<nice_mock_backend_connection_factory>();
+	ON_CALL(*factory, create_backend_connection).WillByDefault(testing::InvokeWithoutArgs(make_backend_connection));
+	return factory;
+}
+
+connection instrumented_connection(std::shared_ptr<iquery_instrumentation> instrumentation)
+{
+	return connection{ std::make_shared<instrumented_backend_connection>(make_backend_connection(), std::move(instrumentation)) };
+}
+
+} // namespace
+
+TEST(HdrHistogramTest, RelativePrecision)
+{
+	for (auto value = std::uint64_t{}; value < 100000u; value += 7u)
+	{
+		const auto highest = hdr_histogram::highest_equivalent_value(hdr_histogram::bucket_index(value));
+		ASSERT_GE(highest, value);
+		ASSERT_LE(highest - value, value / hdr_histogram::sub_bucket_count);
+	}
+	const auto largest = std::numeric_limits<std::uint64_t>::max();
+	EXPECT_EQ(hdr_histogram::highest_equivalent_value(hdr_histogram::bucket_index(largest)), largest);
+}
+
+TEST(HdrHistogramTest, Percentiles)
+{
+	hdr_histogram h{};
+	EXPECT_TRUE(h.empty());
+	EXPECT_EQ(h.value_at_percentile(50.0), 0u);
+
+	for (auto value = std::uint64_t{ 1 }; value <= 1000u; ++value)
+	{
+		h.record(value);
+	}
+	EXPECT_EQ(h.count(), 1000u);
+	EXPECT_EQ(h.min(), 1u);
+	EXPECT_EQ(h.max(), 1000u);
+	EXPECT_DOUBLE_EQ(h.mean(), 500.5);
+	EXPECT_NEAR(static_cast<double>(h.value_at_percentile(50.0)), 500.0, 500.0 / 64.0);
+	EXPECT_NEAR(static_cast<double>(h.value_at_percentile(99.0)), 990.0, 990.0 / 64.0);
+	EXPECT_EQ(h.value_at_percentile(100.0), 1000u);
+	EXPECT_EQ(h.value_at_percentile(0.0), 1u);
+
+	hdr_histogram other{};
+	other.record(5000u);
+	h.merge(other);
+	EXPECT_EQ(h.count(), 1001u);
+	EXPECT_EQ(h.max(), 5000u);
+
+	h.reset();
+	EXPECT_TRUE(h.empty());
+	EXPECT_EQ(h.max(), 0u);
+}
+
+TEST(FingerprintQueryTest, ReplacesLiterals)
+{
+	EXPECT_EQ(fingerprint_query("  SELECT *\n FROM t WHERE a = 42 AND b = 'it''s' AND c = E'x'"), "SELECT * FROM t WHERE a = ? AND b = ? AND c = E?");
+	EXPECT_EQ(fingerprint_query("select x1, \"col 2\" from t where y = $1 and z > -1.5e-3"), "select x1, \"col 2\" from t where y = $1 and z > -?");
+	EXPECT_EQ(fingerprint_query("insert into t values (:a, :b_2)"), "insert into t values (:a, :b_2)");
+}
+
+TEST(InstrumentationTest, AggregatesPerNormalizedQuery)
+{
+	const auto metrics = std::make_shared<query_metrics>();
+	auto       conn    = instrumented_connection(metrics);
+
+	for (const auto id : { 1, 2 })
+	{
+		std::string name = "abcd";
+		statement   st{ conn, "SELECT name FROM person WHERE id = " + std::to_string(id) + " AND age > :age" };
+		st.bind("age", std::int32_t{ 18 });
+		st.bind_result(name);
+		st.execute();
+		while (st.fetch())
+		{
+		}
+	}
+	conn.execute("VACUUM");
+
+	const auto statements = metrics->statements();
+	ASSERT_EQ(statements.size(), 2u);
+
+	const auto it = std::find_if(statements.begin(), statements.end(), [](const statement_metrics& m) { return m.query != "VACUUM"; });
+	ASSERT_NE(it, statements.end());
+	EXPECT_EQ(it->query, "SELECT name FROM person WHERE id = ? AND age > :age");
+	EXPECT_EQ(it->executions, 2u);
+	EXPECT_EQ(it->rows, 4u);
+	EXPECT_EQ(it->bytes, 2u * sizeof(std::int32_t) + 4u * 4u);
+	EXPECT_EQ(it->execute.count(), 2u);
+	EXPECT_EQ(it->fetch.count(), 2u);
+	EXPECT_EQ(it->total.count(), 2u);
+
+	metrics->reset();
+	EXPECT_TRUE(metrics->statements().empty());
+}
+
+TEST(InstrumentationTest, SlowQueryCallback)
+{
+	std::vector<std::string> slow{};
+
+	const auto metrics = std::make_shared<query_metrics>(1ms, [&slow](const query_sample& sample) {
+		EXPECT_GE(sample.total(), 1ms);
+		slow.emplace_back(sample.query);
+	});
+	auto conn = instrumented_connection(metrics);
+
+	{
+		statement st{ conn, "SELECT 1 AS fast" };
+		st.execute();
+		statement slow_st{ conn, "SELECT 1 AS slow" };
+		slow_st.execute();
+	}
+
+	ASSERT_EQ(slow.size(), 1u);
+	EXPECT_EQ(slow.front(), "SELECT ? AS slow");
+}
+
+TEST(InstrumentationTest, PoolWait)
+{
+	const auto metrics = std::make_shared<query_metrics>();
+	const auto factory = std::make_shared<instrumented_backend_connection_factory>(make_backend_connection_factory(), metrics);
+
+	connection_pool pool{ factory, "", connection_pool_options{ .max_size = 1, .instrumentation = metrics } };
+	{
+		connection conn{ pool };
+		EXPECT_NE(std::dynamic_pointer_cast<instrumented_backend_connection>(factory->create_backend_connection("")), nullptr);
+		statement st{ conn, "SELECT 1" };
+		st.execute();
+	}
+	EXPECT_TRUE(connection::create(pool).has_value());
+
+	EXPECT_EQ(metrics->pool_wait().count(), 2u);
+	ASSERT_EQ(metrics->statements().size(), 1u);
+	EXPECT_EQ(metrics->statements().front().executions, 1u);
+}
+
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,289 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include <zoo/squid/core/resultcache.h>
+#include <zoo/squid/core/cachingbackendconnection.h>
+#include <zoo/squid/core/connection.h>
+#include <zoo/squid/core/statement.h>
+#include <zoo/squid/core/preparedstatement.h>
+
+#include "mock_backend_connection.h"
+
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+
+namespace {
+
+using namespace std::chrono_literals;
+
+constexpr auto g_query = "SELECT id, name FROM person WHERE id >= :id";
+
+using testing::_;
+using testing::An;
+using testing::Return;
+
+/// Returns the persons with an id of at least the bound id, person 2 has no name
+std::unique_ptr<ibackend_statement> make_statement(int& executions)
+{
+	struct cursor final
+	{
+		std::int32_t        next{};
+		std::vector<result> results{};
+	};
+
+	auto st      = std::make_unique<nice_mock_backend_statement>();
+	auto current = std::make_shared<cursor>();
+	ON_CALL(*st, execute(_, An<const std::vector<result>&>()))
+	    .WillByDefault([&executions, current](const std::map<std::string, parameter>& parameters, const std::vector<result>& results) {
+		    ++executions;
+		    current->next = *std::get<const int*>(parameters.at("id").pointer());
+		    current->results.clear();
+		    for (const auto& res : results)
+		    {
+			    current->results.push_back(res);
+		    }
+	    });
+	ON_CALL(*st, execute(_, An<const mock_backend_statement::result_map&>()))
+	    .WillByDefault([self = st.get()](const std::map<std::string, parameter>& parameters, const std::map<std::string, result>& results) {
+		    self->execute(parameters, std::vector<result>{ results.at("id"), results.at("name") });
+	    });
+	ON_CALL(*st, fetch).WillByDefault([current] {
+		if (current->next > 3)
+		{
+			return false;
+		}
+
+		const auto id = current->next++;
+		*std::get<std::int64_t*>(std::get<result::non_nullable_type>(current->results.at(0).value())) = id;
+
+		auto& name = *std::get<std::optional<std::string>*>(std::get<result::nullable_type>(current->results.at(1).value()));
+		name       = id == 2 ? std::nullopt : std::optional<std::string>{ "person " + std::to_string(id) };
+		return true;
+	});
+	ON_CALL(*st, field_count).WillByDefault(Return(2));
+	ON_CALL(*st, field_name).WillByDefault([](std::size_t index) { return index == 0 ? "id" : "name"; });
+	return st;
+}
+
+using row = std::pair<std::int64_t, std::optional<std::string>>;
+
+std::vector<row> select(connection& conn, int from, std::string_view query = g_query)
+{
+	std::int64_t               id{};
+	std::optional<std::string> name{};
+
+	statement st{ conn, query };
+	st.bind("id", from);
+	st.bind_result(id);
+	st.bind_result(name);
+	st.execute();
+
+	std::vector<row> rows{};
+	while (st.fetch())
+	{
+		rows.emplace_back(id, name);
+	}
+	return rows;
+}
+
+class ResultCacheTests : public testing::Test
+{
+protected:
+	int                                           executions{};
+	std::shared_ptr<nice_mock_backend_connection> backend = std::make_shared<nice_mock_backend_connection>();
+
+	void SetUp() override
+	{
+		const auto create_statement = [this](std::string_view) { return make_statement(this->executions); };
+		ON_CALL(*this->backend, create_statement).WillByDefault(create_statement);
+		ON_CALL(*this->backend, create_prepared_statement).WillByDefault(create_statement);
+		ON_CALL(*this->backend, is_valid).WillByDefault(Return(true));
+	}
+
+	connection make_connection(std::shared_ptr<result_cache> cache)
+	{
+		return connection{ std::make_shared<caching_backend_connection>(this->backend, std::move(cache)) };
+	}
+};
+
+} // namespace
+
+TEST_F(ResultCacheTests, RepeatedExecutionIsServedFromTheCache)
+{
+	auto cache = std::make_shared<result_cache>();
+	cache->add_query(g_query, { "person" });
+	auto conn = this->make_connection(cache);
+
+	const auto expected = std::vector<row>{ { 1, "person 1" }, { 2, std::nullopt }, { 3, "person 3" } };
+	EXPECT_EQ(select(conn, 1), expected);
+	EXPECT_EQ(select(conn, 1), expected);
+	EXPECT_EQ(this->executions, 1);
+
+	EXPECT_EQ(select(conn, 3), (std::vector<row>{ { 3, "person 3" } }));
+	EXPECT_EQ(this->executions, 2);
+
+	const auto stats = cache->stats();
+	EXPECT_EQ(stats.hits, 1u);
+	EXPECT_EQ(stats.misses, 2u);
+	EXPECT_EQ(stats.entries, 2u);
+	EXPECT_GT(stats.bytes, 0u);
+}
+
+TEST_F(ResultCacheTests, PreparedStatementAndResultsBoundByName)
+{
+	auto cache = std::make_shared<result_cache>();
+	cache->add_query(g_query);
+	auto conn = this->make_connection(cache);
+
+	std::int64_t               id{};
+	std::optional<std::string> name{};
+
+	prepared_statement st{ conn, g_query };
+	st.bind_result("id", id);
+	st.bind_result("name", name);
+	for (auto i = 0; i < 2; ++i)
+	{
+		st.bind("id", 2);
+		st.execute();
+		ASSERT_TRUE(st.fetch());
+		EXPECT_EQ(id, 2);
+		EXPECT_EQ(name, std::nullopt);
+		ASSERT_TRUE(st.fetch());
+		EXPECT_EQ(name, "person 3");
+		EXPECT_FALSE(st.fetch());
+	}
+	EXPECT_EQ(this->executions, 1);
+	EXPECT_EQ(cache->stats().hits, 1u);
+}
+
+TEST_F(ResultCacheTests, OtherQueriesAreNotCached)
+{
+	auto cache = std::make_shared<result_cache>();
+	cache->add_query("SELECT 1");
+	auto conn = this->make_connection(cache);
+
+	select(conn, 1);
+	select(conn, 1);
+	EXPECT_EQ(this->executions, 2);
+	EXPECT_EQ(cache->stats().misses, 0u);
+}
+
+TEST_F(ResultCacheTests, Invalidation)
+{
+	auto cache = std::make_shared<result_cache>();
+	cache->add_query(g_query, { "person", "team" });
+	auto conn = this->make_connection(cache);
+
+	select(conn, 1);
+	cache->invalidate("other");
+	select(conn, 1);
+	EXPECT_EQ(this->executions, 1);
+
+	cache->invalidate("team");
+	select(conn, 1);
+	EXPECT_EQ(this->executions, 2);
+
+	// Queries that only differ in literals share the rule
+	cache->invalidate_query("SELECT id, name FROM person WHERE id >= :id");
+	select(conn, 1);
+	EXPECT_EQ(this->executions, 3);
+
+	cache->clear();
+	EXPECT_EQ(cache->stats().entries, 0u);
+	EXPECT_EQ(cache->stats().bytes, 0u);
+	EXPECT_EQ(cache->stats().invalidations, 3u);
+}
+
+TEST_F(ResultCacheTests, InvalidationAfterTheRuleIsReplaced)
+{
+	auto cache = std::make_shared<result_cache>();
+	cache->add_query(g_query);
+	auto conn = this->make_connection(cache);
+
+	select(conn, 1);
+	cache->add_query(g_query, { "person" });
+	cache->invalidate_query(g_query);
+	select(conn, 1);
+	EXPECT_EQ(this->executions, 2);
+}
+
+TEST_F(ResultCacheTests, StringViewParameterSharesTheEntryOfAString)
+{
+	constexpr auto query = "SELECT id, name FROM person WHERE id >= :id AND name <> :name";
+
+	auto cache = std::make_shared<result_cache>();
+	cache->add_query(query);
+	auto conn = this->make_connection(cache);
+
+	const auto name    = std::string{ "person 2" };
+	const auto execute = [&conn, query](const auto& value) {
+		std::int64_t               id{};
+		std::optional<std::string> result{};
+
+		statement st{ conn, query };
+		st.bind("id", 1);
+		st.bind("name", value);
+		st.bind_result(id);
+		st.bind_result(result);
+		st.execute();
+	};
+
+	execute(name);
+	execute(std::string_view{ name });
+	EXPECT_EQ(this->executions, 1);
+	EXPECT_EQ(cache->stats().hits, 1u);
+}
+
+TEST_F(ResultCacheTests, ResultsExpire)
+{
+	auto cache = std::make_shared<result_cache>(result_cache_options{ .ttl = 1h });
+	cache->add_query(g_query, {}, 1ms);
+	auto conn = this->make_connection(cache);
+
+	select(conn, 1);
+	std::this_thread::sleep_for(5ms);
+	select(conn, 1);
+	EXPECT_EQ(this->executions, 2);
+}
+
+TEST_F(ResultCacheTests, LeastRecentlyUsedIsEvicted)
+{
+	auto probe = std::make_shared<result_cache>();
+	probe->add_query(g_query);
+	{
+		auto conn = this->make_connection(probe);
+		select(conn, 1);
+	}
+	const auto size  = probe->stats().bytes;
+	this->executions = 0;
+
+	// Results for 2 and 3 are smaller than the one for 1
+	auto cache = std::make_shared<result_cache>(result_cache_options{ .max_bytes = 2 * size });
+	cache->add_query(g_query);
+	auto conn = this->make_connection(cache);
+
+	select(conn, 1);
+	select(conn, 2);
+	select(conn, 1); // now 2 is the least recently used
+	select(conn, 3);
+	EXPECT_EQ(cache->stats().evictions, 1u);
+	EXPECT_EQ(this->executions, 3);
+
+	select(conn, 1);
+	EXPECT_EQ(this->executions, 3);
+	select(conn, 2);
+	EXPECT_EQ(this->executions, 4);
+}
+
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,193 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include <zoo/squid/core/routingpool.h>
+#include <zoo/squid/core/connection.h>
+
+#include "mock_backend_connection.h"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+
+namespace {
+
+using namespace std::chrono_literals;
+
+// The database that the last executed statement ran on, and its lag
+std::string               g_executed_on{};
+std::chrono::milliseconds g_lag{};
+
+/// A database whose connections report it as the one they executed on
+class fake_database final
+{
+public:
+	std::string               name;
+	std::chrono::milliseconds lag{};
+	bool                      down{};
+
+	std::shared_ptr<nice_mock_backend_connection_factory> factory = std::make_shared<nice_mock_backend_connection_factory>();
+
+	explicit fake_database(std::string name)
+	    : name{ std::move(name) }
+	{
+		ON_CALL(*this->factory, create_backend_connection).WillByDefault([this](std::string_view) -> std::shared_ptr<ibackend_connection> {
+			if (this->down)
+			{
+				throw std::runtime_error{ this->name + " is down" };
+			}
+			auto connection = std::make_shared<nice_mock_backend_connection>();
+			ON_CALL(*connection, execute).WillByDefault([this](const std::string&) {
+				g_executed_on = this->name;
+				g_lag         = this->lag;
+			});
+			ON_CALL(*connection, is_valid).WillByDefault(testing::Return(true));
+			return connection;
+		});
+	}
+};
+
+// Find out which database @a connection is connected to
+std::string database_of(const std::shared_ptr<ibackend_connection>& connection)
+{
+	connection->execute("");
+	return g_executed_on;
+}
+
+std::chrono::milliseconds probe(connection& connection)
+{
+	connection.execute("SELECT lag");
+	return g_lag;
+}
+
+class RoutingPoolTests : public testing::Test
+{
+protected:
+	fake_database primary{ "primary" };
+	fake_database replica1{ "replica1" };
+	fake_database replica2{ "replica2" };
+
+	routing_pool make_pool(const routing_pool_options& options = {})
+	{
+		const auto pool_options = connection_pool_options{ .min_size = 0, .max_size = 4 };
+
+		std::vector<connection_pool> replicas{};
+		replicas.emplace_back(this->replica1.factory, "", pool_options);
+		replicas.emplace_back(this->replica2.factory, "", pool_options);
+		return routing_pool{ connection_pool{ this->primary.factory, "", pool_options }, std::move(replicas), options };
+	}
+};
+
+} // namespace
+
+TEST_F(RoutingPoolTests, ReadsAreSplitFromWrites)
+{
+	auto pool = this->make_pool();
+
+	auto writer = pool.acquire(access_mode::read_write);
+	auto reader = pool.acquire(access_mode::read_only);
+	EXPECT_EQ(database_of(writer), "primary");
+	EXPECT_NE(database_of(reader), "primary");
+
+	auto stats = pool.stats();
+	EXPECT_EQ(stats.primary.outstanding, 1u);
+	EXPECT_EQ(stats.replicas[0].outstanding + stats.replicas[1].outstanding, 1u);
+
+	writer.reset();
+	reader.reset();
+	stats = pool.stats();
+	EXPECT_EQ(stats.primary.outstanding, 0u);
+	EXPECT_EQ(stats.primary.routed, 1u);
+	EXPECT_EQ(stats.replicas[0].outstanding + stats.replicas[1].outstanding, 0u);
+}
+
+TEST_F(RoutingPoolTests, LeastOutstandingReplicaIsChosen)
+{
+	auto pool = this->make_pool();
+
+	auto a = pool.acquire(access_mode::read_only);
+	auto b = pool.acquire(access_mode::read_only);
+	EXPECT_NE(database_of(a), database_of(b));
+
+	auto c = pool.acquire(access_mode::read_only); // a tie, the replicas take turns
+	EXPECT_EQ(database_of(c), database_of(a));
+
+	b.reset();
+	auto d = pool.acquire(access_mode::read_only); // the replica of b has no connection out now
+	EXPECT_NE(database_of(d), database_of(c));
+
+	const auto stats = pool.stats();
+	EXPECT_EQ(stats.replicas[0].outstanding, 2u);
+	EXPECT_EQ(stats.replicas[1].outstanding, 1u);
+	EXPECT_EQ(stats.primary.routed, 0u);
+}
+
+TEST_F(RoutingPoolTests, LaggingReplicaLeavesTheRotation)
+{
+	this->replica1.lag = 500ms;
+	auto pool          = this->make_pool(routing_pool_options{ .max_replica_lag = 100ms, .lag_check_interval = 0ms, .lag_probe = probe });
+
+	for (auto i = 0; i < 4; ++i)
+	{
+		EXPECT_EQ(database_of(pool.acquire(access_mode::read_only)), "replica2");
+	}
+
+	auto stats = pool.stats();
+	EXPECT_FALSE(stats.replicas[0].in_rotation);
+	EXPECT_EQ(stats.replicas[0].lag, 500ms);
+	EXPECT_TRUE(stats.replicas[1].in_rotation);
+	EXPECT_EQ(stats.replicas[1].lag, 0ms);
+
+	// It is measured again when it is due, and it returns when it caught up
+	this->replica1.lag = 10ms;
+	auto a             = pool.acquire(access_mode::read_only);
+	auto b             = pool.acquire(access_mode::read_only);
+	EXPECT_NE(database_of(a), database_of(b));
+	EXPECT_TRUE(pool.stats().replicas[0].in_rotation);
+}
+
+TEST_F(RoutingPoolTests, ReadsFallBackToThePrimary)
+{
+	this->replica1.down = true;
+	this->replica2.down = true;
+	auto pool           = this->make_pool(routing_pool_options{ .retry_interval = 1h });
+
+	EXPECT_EQ(database_of(pool.acquire(access_mode::read_only)), "primary");
+
+	const auto stats = pool.stats();
+	EXPECT_FALSE(stats.replicas[0].in_rotation);
+	EXPECT_FALSE(stats.replicas[1].in_rotation);
+	EXPECT_EQ(stats.primary.routed, 1u);
+
+	// Failed replicas are not tried again before the retry interval passed
+	this->replica1.down = false;
+	EXPECT_EQ(database_of(pool.acquire(access_mode::read_only)), "primary");
+}
+
+TEST_F(RoutingPoolTests, NoRouteWithoutFallback)
+{
+	this->replica1.down = true;
+	this->replica2.down = true;
+	auto pool           = this->make_pool(routing_pool_options{ .fallback_to_primary = false });
+
+	EXPECT_EQ(pool.acquire(access_mode::read_only), nullptr);
+	EXPECT_THROW((connection{ pool, access_mode::read_only }), no_connection_available);
+	EXPECT_FALSE(connection::create(pool, access_mode::read_only).has_value());
+	EXPECT_NO_THROW((connection{ pool, access_mode::read_write }));
+}
+
+TEST_F(RoutingPoolTests, LagProbeIsRequired)
+{
+	EXPECT_THROW(this->make_pool(routing_pool_options{ .max_replica_lag = 1s }), std::invalid_argument);
+}
+
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,140 @@
+//
+// Copyright (C) 2022-2024 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include <zoo/squid/core/statementcache.h>
+
+#include <vector>
+
+namespace zoo {
+namespace squid {
+
+TEST(NormalizeQueryTest, CollapsesWhitespace)
+{
+	EXPECT_EQ(normalize_query("  SELECT *\n\tFROM  foo\r\nWHERE x = :x  "), "SELECT * FROM foo WHERE x = :x");
+	EXPECT_EQ(normalize_query(""), "");
+	EXPECT_EQ(normalize_query(" \n "), "");
+}
+
+TEST(NormalizeQueryTest, KeepsQuotedText)
+{
+	EXPECT_EQ(normalize_query("SELECT  'a  b',\n\"c  d\"  FROM `e  f`"), "SELECT 'a  b', \"c  d\" FROM `e  f`");
+	EXPECT_EQ(normalize_query("SELECT 'it''s  here'  ,  1"), "SELECT 'it''s  here' , 1");
+}
+
+TEST(NormalizeQueryTest, KeepsComments)
+{
+	// The newline ends the comment, collapsing it would comment out the rest of the query
+	EXPECT_EQ(normalize_query("SELECT 1 -- one\n  , 2"), "SELECT 1 -- one\n, 2");
+	EXPECT_NE(normalize_query("SELECT 1 -- one\n, 2"), normalize_query("SELECT 1 -- one , 2"));
+	EXPECT_EQ(normalize_query("SELECT  /* a  b */  1"), "SELECT /* a  b */ 1");
+}
+
+TEST(NormalizeQueryTest, KeepsDollarQuotedText)
+{
+	EXPECT_EQ(normalize_query("SELECT  $$a  b$$,  $tag$c  $$  d$tag$,  $1"), "SELECT $$a  b$$, $tag$c  $$  d$tag$, $1");
+	EXPECT_EQ(normalize_query("SELECT a$b  FROM  t"), "SELECT a$b FROM t");
+}
+
+TEST(NormalizeQueryTest, KeepsTheRestWhenTheDialectsDisagree)
+{
+	// A backslash escapes the quote in MySQL, not in PostgreSQL
+	EXPECT_EQ(normalize_query("SELECT  'a\\',  'b  c'"), "SELECT 'a\\',  'b  c'");
+	// A comment in MySQL, an operator in PostgreSQL
+	EXPECT_EQ(normalize_query("SELECT  1 # 2,\n  'a  b'"), "SELECT 1 # 2,\n  'a  b'");
+	// A quote in a comment
+	EXPECT_EQ(normalize_query("SELECT  1 -- it's\n  2"), "SELECT 1 -- it's\n  2");
+	EXPECT_EQ(normalize_query("SELECT  /* /* */  1 */  2"), "SELECT /* /* */  1 */  2");
+}
+
+TEST(StatementCacheTest, MissThenHit)
+{
+	statement_cache<int> cache{ 4 };
+
+	EXPECT_FALSE(cache.acquire("q1").has_value());
+	cache.release("q1", 1);
+	EXPECT_EQ(cache.size(), 1u);
+
+	const auto value = cache.acquire("q1");
+	ASSERT_TRUE(value.has_value());
+	EXPECT_EQ(value.value(), 1);
+	EXPECT_EQ(cache.size(), 0u);
+
+	// Checked out, so the next one misses
+	EXPECT_FALSE(cache.acquire("q1").has_value());
+
+	const auto stats = cache.stats();
+	EXPECT_EQ(stats.hits, 1u);
+	EXPECT_EQ(stats.misses, 2u);
+	EXPECT_EQ(stats.evictions, 0u);
+	EXPECT_EQ(stats.size, 0u);
+	EXPECT_EQ(stats.capacity, 4u);
+}
+
+TEST(StatementCacheTest, SameKeyMultipleEntries)
+{
+	statement_cache<int> cache{ 4 };
+
+	cache.release("q", 1);
+	cache.release("q", 2);
+	EXPECT_EQ(cache.size(), 2u);
+
+	EXPECT_TRUE(cache.acquire("q").has_value());
+	EXPECT_TRUE(cache.acquire("q").has_value());
+	EXPECT_FALSE(cache.acquire("q").has_value());
+}
+
+TEST(StatementCacheTest, EvictsLeastRecentlyUsed)
+{
+	std::vector<int>     evicted{};
+	statement_cache<int> cache{ 2, [&evicted](int& value) { evicted.push_back(value); } };
+
+	cache.release("q1", 1);
+	cache.release("q2", 2);
+	cache.release("q1", cache.acquire("q1").value()); // q1 becomes the most recently used
+	cache.release("q3", 3);
+
+	ASSERT_EQ(evicted.size(), 1u);
+	EXPECT_EQ(evicted.front(), 2);
+	EXPECT_FALSE(cache.acquire("q2").has_value());
+	EXPECT_TRUE(cache.acquire("q1").has_value());
+	EXPECT_TRUE(cache.acquire("q3").has_value());
+	EXPECT_EQ(cache.stats().evictions, 1u);
+}
+
+TEST(StatementCacheTest, SetCapacity)
+{
+	std::vector<int>     evicted{};
+	statement_cache<int> cache{ 3, [&evicted](int& value) { evicted.push_back(value); } };
+
+	cache.release("q1", 1);
+	cache.release("q2", 2);
+	cache.release("q3", 3);
+
+	cache.set_capacity(1);
+	EXPECT_EQ(evicted, (std::vector<int>{ 1, 2 }));
+	EXPECT_EQ(cache.size(), 1u);
+
+	// Disabled: released statements are evicted immediately
+	cache.set_capacity(0);
+	cache.release("q4", 4);
+	EXPECT_EQ(evicted, (std::vector<int>{ 1, 2, 3, 4 }));
+	EXPECT_EQ(cache.size(), 0u);
+}
+
+TEST(StatementCacheTest, DestructorDoesNotEvict)
+{
+	std::vector<int> evicted{};
+	{
+		statement_cache<int> cache{ 3, [&evicted](int& value) { evicted.push_back(value); } };
+		cache.release("q1", 1);
+	}
+	EXPECT_TRUE(evicted.empty());
+}
+
+} // namespace squid
+} // namespace zoo
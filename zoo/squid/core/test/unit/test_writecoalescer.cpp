@@ -0,0 +1,273 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include <zoo/squid/core/writecoalescer.h>
+#include <zoo/squid/core/connectionpool.h>
+
+#include "mock_backend_connection.h"
+
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+
+namespace {
+
+using namespace std::chrono_literals;
+
+using testing::_;
+using testing::An;
+using testing::Return;
+
+/// Logs the statements that were executed, in order.
+/// Inserting the bound "name" fails when it is "bad", and breaks the connection when it is "break".
+/// COMMIT fails when fail_commit is set.
+class fake_database final
+{
+	mutable std::mutex       mutex_{};
+	std::vector<std::string> entries_{};
+
+	void insert(const std::map<std::string, parameter>& parameters, bool& broken)
+	{
+		const auto& name = *std::get<const std::string*>(parameters.at("name").pointer());
+		if (broken)
+		{
+			throw std::runtime_error{ "connection is broken" };
+		}
+		if (name == "bad")
+		{
+			throw std::runtime_error{ "constraint violation" };
+		}
+		if (name == "break")
+		{
+			broken = true;
+			throw std::runtime_error{ "connection lost" };
+		}
+		this->add("INSERT " + name);
+	}
+
+	std::shared_ptr<ibackend_connection> connect()
+	{
+		const auto broken = std::make_shared<bool>();
+
+		const auto create_statement = [this, broken](std::string_view) -> std::unique_ptr<ibackend_statement> {
+			auto st = std::make_unique<nice_mock_backend_statement>();
+			ON_CALL(*st, execute(_, An<const std::vector<result>&>()))
+			    .WillByDefault([this, broken](const std::map<std::string, parameter>& parameters, const std::vector<result>&) {
+				    this->insert(parameters, *broken);
+			    });
+			ON_CALL(*st, execute(_, An<const mock_backend_statement::result_map&>()))
+			    .WillByDefault([this, broken](const std::map<std::string, parameter>& parameters, const mock_backend_statement::result_map&) {
+				    this->insert(parameters, *broken);
+			    });
+			ON_CALL(*st, affected_rows).WillByDefault(Return(1));
+			return st;
+		};
+
+		auto connection = std::make_shared<nice_mock_backend_connection>();
+		ON_CALL(*connection, create_statement).WillByDefault(create_statement);
+		ON_CALL(*connection, create_prepared_statement).WillByDefault(create_statement);
+		ON_CALL(*connection, execute).WillByDefault([this](const std::string& query) {
+			this->add(query);
+			if (query == "COMMIT" && this->fail_commit)
+			{
+				throw std::runtime_error{ "connection lost during COMMIT" };
+			}
+		});
+		ON_CALL(*connection, is_valid).WillByDefault([broken] { return !*broken; });
+		return connection;
+	}
+
+public:
+	std::shared_ptr<nice_mock_backend_connection_factory> factory = std::make_shared<nice_mock_backend_connection_factory>();
+	bool                                                  fail_commit{};
+
+	fake_database()
+	{
+		ON_CALL(*this->factory, create_backend_connection).WillByDefault(testing::InvokeWithoutArgs([this] { return this->connect(); }));
+	}
+
+	void add(std::string entry)
+	{
+		std::lock_guard<std::mutex> lock{ this->mutex_ };
+		this->entries_.push_back(std::move(entry));
+	}
+
+	std::vector<std::string> entries() const
+	{
+		std::lock_guard<std::mutex> lock{ this->mutex_ };
+		return this->entries_;
+	}
+};
+
+constexpr auto g_query = "INSERT INTO event (name) VALUES (:name)";
+
+class WriteCoalescerTests : public testing::Test
+{
+protected:
+	fake_database   database{};
+	connection_pool pool{ this->database.factory, "", connection_pool_options{ .min_size = 0, .max_size = 2 } };
+};
+
+} // namespace
+
+TEST_F(WriteCoalescerTests, FullGroupIsWrittenInOneTransaction)
+{
+	write_coalescer coalescer{ this->pool, write_coalescer_options{ .max_batch_size = 3, .max_delay = 1h } };
+
+	std::vector<std::future<std::uint64_t>> results{};
+	for (const auto name : { "a", "b", "c" })
+	{
+		results.push_back(coalescer.submit(g_query, { { "name", std::string{ name } } }));
+	}
+	for (auto& result : results)
+	{
+		EXPECT_EQ(result.get(), 1u);
+	}
+
+	EXPECT_EQ(this->database.entries(), (std::vector<std::string>{ "BEGIN", "INSERT a", "INSERT b", "INSERT c", "COMMIT" }));
+
+	const auto stats = coalescer.stats();
+	EXPECT_EQ(stats.pending, 0u);
+	EXPECT_EQ(stats.submitted, 3u);
+	EXPECT_EQ(stats.groups, 1u);
+	EXPECT_EQ(stats.failed, 0u);
+}
+
+TEST_F(WriteCoalescerTests, GroupIsWrittenWhenTheWindowCloses)
+{
+	write_coalescer coalescer{ this->pool, write_coalescer_options{ .max_batch_size = 100, .max_delay = 10ms } };
+
+	auto result = coalescer.submit(g_query, { { "name", std::string{ "a" } } });
+	EXPECT_EQ(result.wait_for(10s), std::future_status::ready);
+	EXPECT_EQ(this->database.entries(), (std::vector<std::string>{ "BEGIN", "INSERT a", "COMMIT" }));
+}
+
+TEST_F(WriteCoalescerTests, FailingWriteDoesNotFailTheOthers)
+{
+	write_coalescer coalescer{ this->pool, write_coalescer_options{ .max_batch_size = 100, .max_delay = 1h } };
+
+	auto a   = coalescer.submit(g_query, { { "name", std::string{ "a" } } });
+	auto bad = coalescer.submit(g_query, { { "name", std::string{ "bad" } } });
+	auto c   = coalescer.submit(g_query, { { "name", std::string{ "c" } } });
+	coalescer.flush();
+
+	EXPECT_EQ(a.get(), 1u);
+	EXPECT_THROW(bad.get(), std::runtime_error);
+	EXPECT_EQ(c.get(), 1u);
+
+	EXPECT_EQ(this->database.entries(), (std::vector<std::string>{ "BEGIN", "INSERT a", "ROLLBACK", "INSERT a", "INSERT c" }));
+
+	const auto stats = coalescer.stats();
+	EXPECT_EQ(stats.groups, 1u);
+	EXPECT_EQ(stats.retried, 1u);
+	EXPECT_EQ(stats.failed, 1u);
+}
+
+TEST_F(WriteCoalescerTests, RetriesTakeAnotherConnection)
+{
+	write_coalescer coalescer{ this->pool, write_coalescer_options{ .max_batch_size = 100, .max_delay = 1h } };
+
+	auto a      = coalescer.submit(g_query, { { "name", std::string{ "a" } } });
+	auto broken = coalescer.submit(g_query, { { "name", std::string{ "break" } } });
+	auto c      = coalescer.submit(g_query, { { "name", std::string{ "c" } } });
+	coalescer.flush();
+
+	EXPECT_EQ(a.get(), 1u);
+	EXPECT_THROW(broken.get(), std::runtime_error);
+	EXPECT_EQ(c.get(), 1u);
+
+	EXPECT_EQ(this->database.entries(), (std::vector<std::string>{ "BEGIN", "INSERT a", "ROLLBACK", "INSERT a", "INSERT c" }));
+	EXPECT_EQ(coalescer.stats().failed, 1u);
+}
+
+TEST_F(WriteCoalescerTests, FailedCommitIsNotRetried)
+{
+	this->database.fail_commit = true;
+	write_coalescer coalescer{ this->pool, write_coalescer_options{ .max_batch_size = 2, .max_delay = 1h } };
+
+	auto a = coalescer.submit(g_query, { { "name", std::string{ "a" } } });
+	auto b = coalescer.submit(g_query, { { "name", std::string{ "b" } } });
+
+	// The COMMIT may have been applied, a retry could write a and b twice
+	EXPECT_THROW(a.get(), std::runtime_error);
+	EXPECT_THROW(b.get(), std::runtime_error);
+	EXPECT_EQ(this->database.entries(), (std::vector<std::string>{ "BEGIN", "INSERT a", "INSERT b", "COMMIT" }));
+
+	const auto stats = coalescer.stats();
+	EXPECT_EQ(stats.retried, 0u);
+	EXPECT_EQ(stats.failed, 2u);
+}
+
+TEST_F(WriteCoalescerTests, DestructorWritesPendingWrites)
+{
+	std::future<std::uint64_t> result{};
+	{
+		write_coalescer coalescer{ this->pool, write_coalescer_options{ .max_batch_size = 100, .max_delay = 1h } };
+		result = coalescer.submit(g_query, { { "name", std::string{ "a" } } });
+	}
+	EXPECT_EQ(result.wait_for(0s), std::future_status::ready);
+	EXPECT_EQ(result.get(), 1u);
+}
+
+TEST_F(WriteCoalescerTests, ViewsAreCopied)
+{
+	write_coalescer coalescer{ this->pool, write_coalescer_options{ .max_batch_size = 100, .max_delay = 1h } };
+
+	auto name   = std::string{ "a" };
+	auto result = coalescer.submit(g_query, { { "name", std::string_view{ name } } });
+	name        = "z";
+	coalescer.flush();
+
+	EXPECT_EQ(result.get(), 1u);
+	EXPECT_EQ(this->database.entries(), (std::vector<std::string>{ "BEGIN", "INSERT a", "COMMIT" }));
+}
+
+TEST_F(WriteCoalescerTests, ReferencesAreRejected)
+{
+	write_coalescer coalescer{ this->pool };
+
+	const auto name   = std::string{ "a" };
+	auto       params = write_coalescer::parameters{};
+	params.emplace_back("name", parameter{ name, parameter::by_reference{} });
+	EXPECT_THROW(coalescer.submit(g_query, std::move(params)), error);
+}
+
+TEST_F(WriteCoalescerTests, ConcurrentWritersShareGroups)
+{
+	write_coalescer coalescer{ this->pool, write_coalescer_options{ .max_batch_size = 16, .max_delay = 5ms, .workers = 2 } };
+
+	constexpr auto           writers = 8;
+	constexpr auto           writes  = 50;
+	std::vector<std::thread> threads{};
+	for (auto i = 0; i < writers; ++i)
+	{
+		threads.emplace_back([&coalescer, i] {
+			for (auto j = 0; j < writes; ++j)
+			{
+				EXPECT_EQ(coalescer.submit(g_query, { { "name", std::to_string(i) } }).get(), 1u);
+			}
+		});
+	}
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	const auto stats = coalescer.stats();
+	EXPECT_EQ(stats.submitted, static_cast<std::uint64_t>(writers * writes));
+	EXPECT_LE(stats.groups, stats.submitted);
+	EXPECT_EQ(stats.failed, 0u);
+}
+
+} // namespace squid
+} // namespace zoo
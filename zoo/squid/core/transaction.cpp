@@ -8,12 +8,23 @@
 #include "transaction.h"
 #include "connection.h"
 
+#include "zoo/common/misc/throw_exception.h"
+
 namespace zoo {
 namespace squid {
 
 transaction::transaction(connection& connection)
     : connection_{ connection }
     , finished_{}
+    , guard_{}
+{
+	connection.execute("BEGIN");
+}
+
+transaction::transaction(connection& connection, const deadline& deadline)
+    : connection_{ connection }
+    , finished_{}
+    , guard_{ std::make_unique<deadline_guard>(connection.backend(), deadline) }
 {
 	connection.execute("BEGIN");
 }
@@ -37,6 +48,12 @@ void transaction::commit()
 {
 	if (!this->finished_)
 	{
+		if (this->guard_ && this->guard_->expired())
+		{
+			this->rollback();
+			ZOO_THROW_EXCEPTION(deadline_exceeded{});
+		}
+
 		// If the commit fails, the destructor must not do a ROLLBACK,
 		// so this->finished_ is set before doing the COMMIT.
 		this->finished_ = true;
@@ -9,19 +9,28 @@
 
 #include "zoo/squid/core/config.h"
 #include "zoo/squid/core/connectionfwd.h"
+#include "zoo/squid/core/deadline.h"
+
+#include <memory>
 
 namespace zoo {
 namespace squid {
 
 class ZOO_SQUID_CORE_API transaction final
 {
-	connection& connection_;
-	bool        finished_;
+	connection&                     connection_;
+	bool                            finished_;
+	std::unique_ptr<deadline_guard> guard_;
 
 public:
 	/// Start a database transaction
 	explicit transaction(connection& connection);
 
+	/// Start a database transaction that must be committed by @a deadline.
+	/// When the deadline passes, the statement that is executing on the connection is cancelled, the statements
+	/// that follow throw deadline_exceeded and so does commit(), after rolling back.
+	explicit transaction(connection& connection, const deadline& deadline);
+
 	/// The destructor will rollback the transaction if neither commit() nor rollback() was called
 	~transaction() noexcept;
 
@@ -0,0 +1,87 @@
+//
+// Copyright (C) 2022-2024 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace zoo {
+namespace squid {
+
+/// Thread safe cache of translated queries, keyed by the original query text.
+/// @a Query is a backend query translation class that is constructible from a std::string_view, e.g. postgresql_query.
+/// Translations are immutable and shared, so statements for the same query text do not translate it again.
+/// The cache is bounded: when it is full it is emptied, which is cheap and good enough for an application's
+/// (usually fixed) set of queries. Translations that are still in use stay alive through their shared_ptr.
+template<typename Query>
+class translated_query_cache final
+{
+	struct string_hash
+	{
+		using is_transparent = void;
+
+		std::size_t operator()(std::string_view s) const
+		{
+			return std::hash<std::string_view>{}(s);
+		}
+	};
+
+	using map_type = std::unordered_map<std::string, std::shared_ptr<const Query>, string_hash, std::equal_to<>>;
+
+	std::mutex  mutex_;
+	map_type    map_;
+	std::size_t capacity_;
+
+public:
+	static constexpr std::size_t default_capacity = 1024;
+
+	explicit translated_query_cache(std::size_t capacity = default_capacity)
+	    : mutex_{}
+	    , map_{}
+	    , capacity_{ capacity }
+	{
+	}
+
+	translated_query_cache(const translated_query_cache&)            = delete;
+	translated_query_cache& operator=(const translated_query_cache&) = delete;
+
+	/// Get the translation of @a query, translating it if it is not cached yet
+	std::shared_ptr<const Query> get(std::string_view query)
+	{
+		{
+			std::lock_guard<std::mutex> lock{ this->mutex_ };
+			if (const auto it = this->map_.find(query); it != this->map_.end())
+			{
+				return it->second;
+			}
+		}
+
+		// Translate outside the lock, a concurrent translation of the same query is harmless.
+		auto translated = std::make_shared<const Query>(query);
+
+		std::lock_guard<std::mutex> lock{ this->mutex_ };
+		if (this->map_.size() >= this->capacity_)
+		{
+			this->map_.clear();
+		}
+		return this->map_.try_emplace(std::string{ query }, std::move(translated)).first->second;
+	}
+
+	std::size_t size()
+	{
+		std::lock_guard<std::mutex> lock{ this->mutex_ };
+		return this->map_.size();
+	}
+};
+
+} // namespace squid
+} // namespace zoo
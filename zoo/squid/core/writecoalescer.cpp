@@ -0,0 +1,389 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/core/writecoalescer.h"
+#include "zoo/squid/core/connection.h"
+#include "zoo/squid/core/preparedstatement.h"
+#include "zoo/squid/core/transaction.h"
+#include "zoo/squid/core/error.h"
+
+#include "zoo/common/logging/logging.h"
+#include "zoo/common/misc/throw_exception.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <variant>
+
+namespace zoo {
+namespace squid {
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+/// A submitted write
+struct pending_write final
+{
+	std::string                 query;
+	write_coalescer::parameters params;
+	std::promise<std::uint64_t> promise;
+	clock_type::time_point      submitted;
+};
+
+/// The result of a write, set once its group has been flushed
+struct write_outcome final
+{
+	std::uint64_t      affected_rows{};
+	std::exception_ptr error{};
+};
+
+// Copy a parameter value, including the data that a view type refers to
+parameter owning_copy(const parameter& value)
+{
+	const auto* v = std::get_if<parameter::value_type>(&value.value());
+	if (!v)
+	{
+		ZOO_THROW_EXCEPTION(error{ "Parameters of a coalesced write must be bound by value" });
+	}
+	return std::visit(
+	    [](const auto& x) {
+		    using T = std::decay_t<decltype(x)>;
+		    if constexpr (std::is_same_v<T, std::string_view>)
+		    {
+			    return parameter{ std::string{ x }, parameter::by_value{} };
+		    }
+		    else if constexpr (std::is_same_v<T, byte_string_view>)
+		    {
+			    return parameter{ byte_string{ x }, parameter::by_value{} };
+		    }
+		    else
+		    {
+			    return parameter{ x, parameter::by_value{} };
+		    }
+	    },
+	    *v);
+}
+
+std::uint64_t execute(connection& connection, const pending_write& write)
+{
+	// Prepared statements are cached by the backend connection, so a group of the same write is prepared only once
+	auto st = connection.prepare(write.query);
+	for (const auto& [name, value] : write.params)
+	{
+		std::visit([&st, &name](const auto& x) { st.bind(name, x); }, std::get<parameter::value_type>(value.value()));
+	}
+	st.execute();
+	return st.affected_rows();
+}
+
+} // namespace
+
+class write_coalescer::impl final
+{
+	connection_pool&        pool_;
+	write_coalescer_options options_;
+
+	mutable std::mutex        mutex_;
+	std::condition_variable   cv_;
+	std::deque<pending_write> queue_;
+	bool                      flush_requested_; // flush the pending writes without waiting for the window to close
+	bool                      stopping_;
+	write_coalescer_stats     stats_;           // without pending, which is the size of queue_
+
+	std::vector<std::thread> workers_;
+
+	// Wait for a group to be due and take it from the queue. Returns an empty group when stopping.
+	std::vector<pending_write> take_group(std::unique_lock<std::mutex>& lock)
+	{
+		for (;;)
+		{
+			if (this->queue_.empty())
+			{
+				this->flush_requested_ = false;
+				if (this->stopping_)
+				{
+					return {};
+				}
+				this->cv_.wait(lock);
+				continue;
+			}
+			if (this->stopping_ || this->flush_requested_ || this->queue_.size() >= this->options_.max_batch_size)
+			{
+				break;
+			}
+			const auto due = this->queue_.front().submitted + this->options_.max_delay;
+			if (clock_type::now() >= due)
+			{
+				break;
+			}
+			this->cv_.wait_until(lock, due);
+		}
+
+		const auto                 count = std::min(this->queue_.size(), this->options_.max_batch_size);
+		std::vector<pending_write> group{};
+		group.reserve(count);
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			group.push_back(std::move(this->queue_.front()));
+			this->queue_.pop_front();
+		}
+		++this->stats_.groups;
+		return group;
+	}
+
+	// Execute a group of writes into @a outcomes, which has an element for each write. Returns whether a write of the
+	// group failed and the writes were retried one at a time. When the COMMIT fails, the writes fail without a retry.
+	bool flush_group(const std::vector<pending_write>& group, std::vector<write_outcome>& outcomes)
+	{
+		std::optional<connection> conn{};
+		try
+		{
+			conn.emplace(this->pool_);
+		}
+		catch (...)
+		{
+			const auto e = std::current_exception();
+			for (auto& outcome : outcomes)
+			{
+				outcome.error = e;
+			}
+			return false;
+		}
+
+		std::exception_ptr         group_error{};
+		std::optional<transaction> tr{};
+		try
+		{
+			tr.emplace(conn.value());
+			for (std::size_t i = 0; i < group.size(); ++i)
+			{
+				outcomes[i].affected_rows = execute(conn.value(), group[i]);
+			}
+		}
+		catch (...)
+		{
+			group_error = std::current_exception();
+		}
+
+		if (!group_error)
+		{
+			try
+			{
+				tr->commit();
+			}
+			catch (...)
+			{
+				// A COMMIT that failed, for example because the connection dropped, may have been applied by the server.
+				// Retrying the writes could then apply them twice, so they all fail.
+				const auto e = std::current_exception();
+				for (auto& outcome : outcomes)
+				{
+					outcome.error = e;
+				}
+			}
+			return false;
+		}
+
+		// Roll back before the connection is given up
+		tr.reset();
+
+		if (group.size() == 1)
+		{
+			outcomes.front().error = group_error;
+			return false;
+		}
+
+		ZOO_LOG(warn, "a group of {} coalesced writes failed, retrying them one at a time", group.size());
+
+		// The failure may have broken the connection, so the retries take another one, as does a retry after a failed one
+		conn.reset();
+		for (std::size_t i = 0; i < group.size(); ++i)
+		{
+			try
+			{
+				if (!conn)
+				{
+					conn.emplace(this->pool_);
+				}
+				outcomes[i].affected_rows = execute(conn.value(), group[i]);
+			}
+			catch (...)
+			{
+				outcomes[i].error = std::current_exception();
+				conn.reset();
+			}
+		}
+		return true;
+	}
+
+	void run()
+	{
+		std::unique_lock<std::mutex> lock{ this->mutex_ };
+		for (;;)
+		{
+			auto group = this->take_group(lock);
+			if (group.empty())
+			{
+				return;
+			}
+
+			lock.unlock();
+			std::vector<write_outcome> outcomes(group.size());
+			const auto                 retried = this->flush_group(group, outcomes);
+			lock.lock();
+
+			// The statistics are updated before the futures are ready, so that a caller that waited for its write sees them
+			if (retried)
+			{
+				++this->stats_.retried;
+			}
+			this->stats_.failed += static_cast<std::uint64_t>(
+			    std::ranges::count_if(outcomes, [](const write_outcome& outcome) { return outcome.error != nullptr; }));
+
+			lock.unlock();
+			for (std::size_t i = 0; i < group.size(); ++i)
+			{
+				if (outcomes[i].error)
+				{
+					group[i].promise.set_exception(outcomes[i].error);
+				}
+				else
+				{
+					group[i].promise.set_value(outcomes[i].affected_rows);
+				}
+			}
+			lock.lock();
+		}
+	}
+
+public:
+	explicit impl(connection_pool& pool, const write_coalescer_options& options)
+	    : pool_{ pool }
+	    , options_{ options }
+	    , mutex_{}
+	    , cv_{}
+	    , queue_{}
+	    , flush_requested_{}
+	    , stopping_{}
+	    , stats_{}
+	    , workers_{}
+	{
+		if (this->options_.max_batch_size == 0 || this->options_.workers == 0)
+		{
+			ZOO_THROW_EXCEPTION(error{ "The batch size and the number of workers of a write coalescer must not be zero" });
+		}
+
+		this->workers_.reserve(this->options_.workers);
+		for (std::size_t i = 0; i < this->options_.workers; ++i)
+		{
+			this->workers_.emplace_back([this] { this->run(); });
+		}
+	}
+
+	~impl() noexcept
+	{
+		{
+			std::lock_guard<std::mutex> lock{ this->mutex_ };
+			this->stopping_ = true;
+		}
+		this->cv_.notify_all();
+		for (auto& worker : this->workers_)
+		{
+			worker.join();
+		}
+	}
+
+	std::future<std::uint64_t> submit(std::string_view query, parameters&& params)
+	{
+		auto write = pending_write{ std::string{ query }, parameters{}, std::promise<std::uint64_t>{}, clock_type::now() };
+		write.params.reserve(params.size());
+		for (auto& [name, value] : params)
+		{
+			write.params.emplace_back(std::move(name), owning_copy(value));
+		}
+		auto result = write.promise.get_future();
+
+		std::size_t pending{};
+		{
+			std::lock_guard<std::mutex> lock{ this->mutex_ };
+			this->queue_.push_back(std::move(write));
+			++this->stats_.submitted;
+			pending = this->queue_.size();
+		}
+
+		// A worker must start timing the window, or flush a full group
+		if (pending == 1 || pending >= this->options_.max_batch_size)
+		{
+			this->cv_.notify_one();
+		}
+
+		return result;
+	}
+
+	void flush()
+	{
+		{
+			std::lock_guard<std::mutex> lock{ this->mutex_ };
+			this->flush_requested_ = true;
+		}
+		this->cv_.notify_all();
+	}
+
+	write_coalescer_stats stats() const
+	{
+		std::lock_guard<std::mutex> lock{ this->mutex_ };
+		auto                        stats = this->stats_;
+		stats.pending                     = this->queue_.size();
+		return stats;
+	}
+};
+
+write_coalescer::write_coalescer(connection_pool& pool, const write_coalescer_options& options)
+    : pimpl_{ std::make_unique<impl>(pool, options) }
+{
+}
+
+write_coalescer::~write_coalescer() noexcept
+{
+}
+
+std::future<std::uint64_t> write_coalescer::submit(std::string_view                                                        query,
+                                                   std::initializer_list<std::pair<std::string_view, parameter_by_value>> params)
+{
+	auto converted = parameters{};
+	converted.reserve(params.size());
+	for (const auto& [name, value] : params)
+	{
+		converted.emplace_back(std::string{ name }, value);
+	}
+	return this->pimpl_->submit(query, std::move(converted));
+}
+
+std::future<std::uint64_t> write_coalescer::submit(std::string_view query, parameters&& params)
+{
+	return this->pimpl_->submit(query, std::move(params));
+}
+
+void write_coalescer::flush()
+{
+	this->pimpl_->flush();
+}
+
+write_coalescer_stats write_coalescer::stats() const
+{
+	return this->pimpl_->stats();
+}
+
+} // namespace squid
+} // namespace zoo
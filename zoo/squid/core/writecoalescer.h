@@ -0,0 +1,92 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/core/config.h"
+#include "zoo/squid/core/connectionpoolfwd.h"
+#include "zoo/squid/core/parameter.h"
+
+#include <chrono>
+#include <cstdint>
+#include <future>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+
+/// Grouping options of a write_coalescer
+struct write_coalescer_options final
+{
+	std::size_t               max_batch_size{ 64 };                        //!< Flush a group when this many writes are pending
+	std::chrono::milliseconds max_delay{ std::chrono::milliseconds{ 5 } }; //!< Flush a group when its oldest write has waited this long
+	std::size_t               workers{ 1 };                                //!< Number of groups that can be flushed concurrently, each on its own connection
+};
+
+/// Statistics of a write_coalescer
+struct write_coalescer_stats final
+{
+	std::size_t   pending{};   //!< Number of writes waiting to be flushed
+	std::uint64_t submitted{}; //!< Number of writes that were submitted
+	std::uint64_t groups{};    //!< Number of groups that were flushed
+	std::uint64_t retried{};   //!< Number of groups that failed and were retried one write at a time
+	std::uint64_t failed{};    //!< Number of writes that completed with an exception
+};
+
+/// Merges small writes, submitted concurrently by many threads, into shared transactions.
+/// Instead of every write paying for its own commit, the pending writes are executed as a group in one transaction
+/// on a connection from the pool, as soon as @c max_batch_size writes are pending or the oldest one has waited
+/// @c max_delay. With one worker, writes are executed in the order they were submitted. With more workers, groups are
+/// flushed concurrently on different connections, so writes of different groups may execute in any order.
+/// Every write has its own result: a future that holds the number of affected rows, or the exception of the write.
+/// If a group fails, it is rolled back and its writes are retried one at a time, on another connection from the pool,
+/// so that a failing write does not fail the others. Note that the writes of a group are then no longer atomic together, which they
+/// never were to the callers anyway.
+/// The destructor flushes the writes that are still pending.
+class ZOO_SQUID_CORE_API write_coalescer final
+{
+	class impl;
+	std::unique_ptr<impl> pimpl_;
+
+public:
+	/// Named query parameters, bound by value
+	using parameters = std::vector<std::pair<std::string, parameter>>;
+
+	/// Create a coalescer that executes the writes on connections acquired from @a pool.
+	/// The pool must outlive the coalescer.
+	explicit write_coalescer(connection_pool& pool, const write_coalescer_options& options = {});
+	~write_coalescer() noexcept;
+
+	write_coalescer(const write_coalescer&)            = delete;
+	write_coalescer(write_coalescer&&)                 = delete;
+	write_coalescer& operator=(const write_coalescer&) = delete;
+	write_coalescer& operator=(write_coalescer&&)      = delete;
+
+	/// Submit the statement @a query with the given @a params.
+	/// The parameter values are copied, including the data of view types (std::string_view and byte_string_view).
+	/// Returns a future that completes with the number of affected rows when the group of the write is flushed.
+	std::future<std::uint64_t> submit(std::string_view query, std::initializer_list<std::pair<std::string_view, parameter_by_value>> params);
+
+	/// Submit the statement @a query with the given @a params.
+	/// Throws if a parameter is bound by reference.
+	std::future<std::uint64_t> submit(std::string_view query, parameters&& params);
+
+	/// Flush the pending writes now, without waiting for the time window to close.
+	/// Does not wait for the flush to complete, the futures do.
+	void flush();
+
+	/// Get the current statistics
+	write_coalescer_stats stats() const;
+};
+
+} // namespace squid
+} // namespace zoo
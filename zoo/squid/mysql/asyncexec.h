@@ -0,0 +1,31 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/mysql/resultset.h"
+
+#include <boost/asio/any_completion_handler.hpp>
+
+#include <exception>
+
+namespace zoo {
+namespace squid {
+namespace mysql {
+
+/// Completion signature of an asynchronous execution.
+/// When the execution fails, the exception is a mysql::error (or a boost::system::system_error when the connection's
+/// socket could not be waited for) and the resultset is empty.
+using async_exec_signature = void(std::exception_ptr, resultset);
+
+/// Type-erased completion handler of an asynchronous execution.
+/// It keeps the associated executor and cancellation slot of the handler it was made from.
+using async_exec_completion_handler = boost::asio::any_completion_handler<async_exec_signature>;
+
+} // namespace mysql
+} // namespace squid
+} // namespace zoo
@@ -8,11 +8,13 @@
 #include "zoo/squid/mysql/backendconnection.h"
 #include "zoo/squid/mysql/statement.h"
 #include "zoo/squid/mysql/error.h"
+#include "zoo/squid/mysql/detail/asyncbackend.h"
 
 #include "zoo/common/misc/throw_exception.h"
 
 #include <mysql/mysql.h>
 
+#include <initializer_list>
 #include <mutex>
 #include <optional>
 #include <string>
@@ -247,7 +249,12 @@ connection_parameters parse_connection_string(std::string_view in)
 	return params;
 }
 
-std::shared_ptr<MYSQL> connect_database(std::string_view connection_info)
+// Seconds that the side connection of backend_connection::cancel() may take to connect, send and receive.
+// It runs on the deadline watchdog, which must not be held up by an unreachable server.
+constexpr unsigned int cancel_timeout = 2u;
+
+// When @a timeout is set, it bounds connecting, reading and writing, in seconds
+std::shared_ptr<MYSQL> connect_database(std::string_view connection_info, std::optional<unsigned int> timeout = std::nullopt)
 {
 	std::unique_lock<std::mutex> lock{ mutex_singleton::instance().mutex };
 	std::shared_ptr<MYSQL>       handle{ mysql_init(nullptr), mysql_close };
@@ -292,6 +299,17 @@ std::shared_ptr<MYSQL> connect_database(std::string_view connection_info)
 		}
 	}
 
+	if (timeout)
+	{
+		for (const auto option : { MYSQL_OPT_CONNECT_TIMEOUT, MYSQL_OPT_READ_TIMEOUT, MYSQL_OPT_WRITE_TIMEOUT })
+		{
+			if (mysql_options(handle.get(), option, &*timeout))
+			{
+				ZOO_THROW_EXCEPTION(error("mysql_options(timeout) failed", *handle));
+			}
+		}
+	}
+
 	if (mysql_real_connect(handle.get(),
 	                       params.host ? params.host->c_str() : nullptr,
 	                       params.user ? params.user->c_str() : nullptr,
@@ -307,6 +325,15 @@ std::shared_ptr<MYSQL> connect_database(std::string_view connection_info)
 	return handle;
 }
 
+// Cancel the statement that executes on the connection with server id @a thread_id.
+// The connection is busy executing the statement, so KILL QUERY is sent on a connection of its own.
+// This runs on the deadline watchdog or a cancellation handler, so the side connection is bounded by a short timeout.
+void kill_query(std::string_view connection_info, unsigned long thread_id)
+{
+	const auto side_connection = connect_database(connection_info, cancel_timeout);
+	statement::execute(*side_connection, "KILL QUERY " + std::to_string(thread_id));
+}
+
 } // namespace
 
 // All statements are prepared statements.
@@ -318,7 +345,7 @@ std::unique_ptr<ibackend_statement> backend_connection::create_statement(std::st
 
 std::unique_ptr<ibackend_statement> backend_connection::create_prepared_statement(std::string_view query)
 {
-	return std::make_unique<statement>(this->connection_, query, true);
+	return std::make_unique<statement>(this->connection_, query, true, this->statement_cache_);
 }
 
 void backend_connection::execute(const std::string& query)
@@ -326,8 +353,31 @@ void backend_connection::execute(const std::string& query)
 	statement::execute(*this->connection_, query);
 }
 
+statement_cache_stats backend_connection::prepared_statement_cache_stats() const
+{
+	return this->statement_cache_->stats();
+}
+
+void backend_connection::set_prepared_statement_cache_capacity(std::size_t capacity)
+{
+	this->statement_cache_->set_capacity(capacity);
+}
+
+bool backend_connection::is_valid()
+{
+	return mysql_ping(this->connection_.get()) == 0;
+}
+
+void backend_connection::cancel()
+{
+	kill_query(this->connection_info_, this->thread_id_);
+}
+
 backend_connection::backend_connection(const std::string_view connection_info)
     : connection_{ connect_database(connection_info) }
+    , statement_cache_{ std::make_shared<statement_handle_cache>() }
+    , connection_info_{ connection_info }
+    , thread_id_{ mysql_thread_id(this->connection_.get()) }
 {
 }
 
@@ -336,6 +386,14 @@ MYSQL& backend_connection::handle() const
 	return *this->connection_;
 }
 
+void backend_connection::run_async_exec(boost::asio::io_context& io, std::string_view query, async_exec_completion_handler handler)
+{
+	// The operation may outlive this object, so the query is cancelled with copies of what identifies it
+	async_backend::exec(this->connection_, io, query, std::move(handler), [connection_info = this->connection_info_, thread_id = this->thread_id_] {
+		kill_query(connection_info, thread_id);
+	});
+}
+
 } // namespace mysql
 } // namespace squid
 } // namespace zoo
@@ -8,8 +8,15 @@
 #pragma once
 
 #include "zoo/squid/mysql/config.h"
+#include "zoo/squid/mysql/asyncexec.h"
 #include "zoo/squid/mysql/detail/mysqlfwd.h"
 #include "zoo/squid/core/ibackendconnection.h"
+#include "zoo/squid/core/statementcache.h"
+
+#include <boost/asio/io_context.hpp>
+
+#include <string>
+#include <string_view>
 
 namespace zoo {
 namespace squid {
@@ -17,11 +24,18 @@ namespace mysql {
 
 class ZOO_SQUID_MYSQL_API backend_connection final : public ibackend_connection
 {
-	std::shared_ptr<MYSQL> connection_;
+	std::shared_ptr<MYSQL>                                        connection_;
+	std::shared_ptr<statement_cache<std::shared_ptr<MYSQL_STMT>>> statement_cache_; // idle prepared statements
+	std::string                                                   connection_info_; // to open a side connection for cancel()
+	unsigned long                                                 thread_id_;       // id of the connection on the server
 
 	std::unique_ptr<ibackend_statement> create_statement(std::string_view query) override;
 	std::unique_ptr<ibackend_statement> create_prepared_statement(std::string_view query) override;
 	void                                execute(const std::string& query) override;
+	statement_cache_stats               prepared_statement_cache_stats() const override;
+	void                                set_prepared_statement_cache_capacity(std::size_t capacity) override;
+	bool                                is_valid() override;
+	void                                cancel() override;
 
 public:
 	/// @a connection_info must contain a path to a file
@@ -35,6 +49,10 @@ public:
 	backend_connection& operator=(backend_connection&&)      = default;
 
 	MYSQL& handle() const;
+
+	/// Execute @a query asynchronously, see async_backend::exec.
+	/// Emitting the cancellation slot of @a handler kills the query, like cancel().
+	void run_async_exec(boost::asio::io_context& io, std::string_view query, async_exec_completion_handler handler);
 };
 
 } // namespace mysql
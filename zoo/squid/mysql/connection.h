@@ -8,9 +8,18 @@
 #pragma once
 
 #include "zoo/squid/mysql/config.h"
-#include "zoo/squid/mysql/backendconnectionfwd.h"
+#include "zoo/squid/mysql/asyncexec.h"
+#include "zoo/squid/mysql/backendconnection.h"
 #include "zoo/squid/core/connection.h"
 
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/io_context.hpp>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
 namespace zoo {
 namespace squid {
 namespace mysql {
@@ -32,6 +41,28 @@ public:
 	/// Get the backend
 	/// The backend provides a getter for the native connection handle (MYSQL)
 	const backend_connection& backend() const;
+
+	/// Execute @a query asynchronously with the non-blocking API of the MySQL client library.
+	/// @a token is an Asio completion token for the signature async_exec_signature, e.g. boost::asio::use_awaitable:
+	/// @code
+	/// auto result = co_await connection.async_exec(io, "SELECT id, name FROM person", boost::asio::use_awaitable);
+	/// @endcode
+	/// The query is sent as text, so it cannot have parameters. The complete result is stored on the client side.
+	/// When @a query consists of multiple statements, the operation completes with the result of the last one.
+	/// Per-operation cancellation is supported, the query is then killed on the server with KILL QUERY, which is sent
+	/// from a separate thread because it connects to the server, and the operation fails with the resulting error.
+	template<typename CompletionToken>
+	auto async_exec(boost::asio::io_context& io, std::string_view query, CompletionToken&& token)
+	{
+		// The query is copied, a deferred initiation may outlive the caller's buffer
+		return boost::asio::async_initiate<CompletionToken, async_exec_signature>(
+		    [backend = this->backend_](auto handler, boost::asio::io_context* io, const std::string& query) {
+			    backend->run_async_exec(*io, query, async_exec_completion_handler{ std::move(handler) });
+		    },
+		    token,
+		    &io,
+		    std::string{ query });
+	}
 };
 
 } // namespace mysql
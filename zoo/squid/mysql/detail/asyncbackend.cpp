@@ -0,0 +1,342 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/mysql/detail/asyncbackend.h"
+#include "zoo/squid/mysql/error.h"
+
+#include "zoo/common/logging/logging.h"
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/associated_cancellation_slot.hpp>
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/bind_executor.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
+#include <boost/asio/prefer.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <boost/system/error_code.hpp>
+#include <boost/system/system_error.hpp>
+
+#include <atomic>
+#include <optional>
+#include <string>
+
+#include <mysql/mysql.h>
+
+// The non-blocking API (mysql_send_query_nonblocking etc.) exists since MySQL 8.0.16.
+// MariaDB Connector/C has a different asynchronous API, which is not supported.
+#if defined(ZOO_SQUID_MYSQL_HAS_SEND_QUERY_NONBLOCKING) && !defined(MARIADB_BASE_VERSION) && !defined(MARIADB_PACKAGE_VERSION_ID)
+#define ZOO_SQUID_MYSQL_HAS_NONBLOCKING_API
+#endif
+
+namespace zoo {
+namespace squid {
+namespace mysql {
+namespace {
+
+#ifdef ZOO_SQUID_MYSQL_HAS_NONBLOCKING_API
+
+// The socket of @a connection, or std::nullopt if it is not connected
+std::optional<int> native_socket(MYSQL& connection)
+{
+#ifdef ZOO_SQUID_MYSQL_HAS_GET_SOCKET
+	const auto sock = static_cast<int>(mysql_get_socket(&connection));
+	if (sock < 0)
+	{
+		return std::nullopt;
+	}
+	return sock;
+#else
+	// The client library has no accessor, the descriptor is only meaningful while the connection has a transport
+	if (!connection.net.vio)
+	{
+		return std::nullopt;
+	}
+	return connection.net.fd;
+#endif
+}
+
+// KILL QUERY blocks while it connects to the server, so it runs on this thread instead of the one that emits the
+// cancellation slot, which is usually an io_context thread.
+boost::asio::thread_pool& cancel_pool()
+{
+	static boost::asio::thread_pool pool{ 1 };
+	return pool;
+}
+
+class async_exec_operation final : public std::enable_shared_from_this<async_exec_operation>
+{
+	enum class step
+	{
+		send,         //!< sending the query, waits for the socket to become writable
+		read_result,  //!< the query was sent, waits for the socket to become readable
+		store_result, //!< reading the rows of a statement
+		next_result   //!< reading the reply of the next statement
+	};
+
+	std::shared_ptr<MYSQL>                                      connection_;
+	std::string                                                 query_;
+	async_exec_completion_handler                               handler_;
+	boost::asio::io_context&                                    io_;
+	boost::asio::any_io_executor                                executor_; // of handler_
+	boost::asio::cancellation_slot                              slot_;     // of handler_
+	std::function<void()>                                       cancel_;
+	boost::asio::strand<boost::asio::io_context::executor_type> strand_; // of the socket waits
+	boost::asio::posix::stream_descriptor                       stream_;
+	step                                                        step_;
+	std::optional<resultset>                                    result_; // of the last statement
+	std::atomic<bool>                                           completed_;
+
+	void release_stream()
+	{
+		// stream_ takes ownership of the descriptor.
+		// We need to prevent it being closed, because the MYSQL object in fact owns it.
+		if (this->stream_.is_open())
+		{
+			ZOO_LOG(trace, "release fd={}", this->stream_.native_handle());
+			this->stream_.release();
+		}
+	}
+
+	void complete(std::exception_ptr e, resultset result)
+	{
+		this->completed_ = true;
+		this->release_stream();
+		if (this->slot_.is_connected())
+		{
+			this->slot_.clear();
+		}
+		boost::asio::post(this->executor_, [handler = std::move(this->handler_), e = std::move(e), result = std::move(result)]() mutable {
+			std::move(handler)(std::move(e), std::move(result));
+		});
+	}
+
+	void fail(std::string_view func)
+	{
+		this->complete(std::make_exception_ptr(error{ std::string{ func } + " failed", *this->connection_ }), resultset{});
+	}
+
+	void fail(const boost::system::error_code& ec, const char* what)
+	{
+		this->complete(std::make_exception_ptr(boost::system::system_error{ ec, what }), resultset{});
+	}
+
+	void cancel_on_slot()
+	{
+		if (this->slot_.is_connected() && this->cancel_)
+		{
+			this->slot_.assign([operation = this->weak_from_this()](boost::asio::cancellation_type) {
+				auto self = operation.lock();
+				if (!self || self->completed_)
+				{
+					return;
+				}
+
+				// The io_context has work until the query is killed, so that it does not run out while it is
+				auto work = boost::asio::make_work_guard(self->io_);
+				boost::asio::post(cancel_pool(), [self = std::move(self), work = std::move(work)]() mutable {
+					try
+					{
+						// KILL QUERY would hit the next query of the connection when this one has completed meanwhile
+						if (!self->completed_)
+						{
+							self->cancel_();
+						}
+					}
+					catch (const std::exception& e)
+					{
+						ZOO_LOG(warn, "cannot cancel an asynchronous execution: {}", e.what());
+					}
+					self.reset();
+					work.reset();
+				});
+			});
+		}
+	}
+
+	void wait()
+	{
+		// Only sending waits for the socket to become writable. Waiting for both directions while the reply of the
+		// server is awaited would complete right away, because the socket stays writable.
+		using stream_type = boost::asio::posix::stream_descriptor;
+		const auto type   = this->step_ == step::send ? stream_type::wait_write : stream_type::wait_read;
+		this->stream_.async_wait(type, boost::asio::bind_executor(this->strand_, [self = this->shared_from_this()](const boost::system::error_code& ec) {
+			self->on_wait_complete(ec);
+		}));
+	}
+
+	void on_wait_complete(const boost::system::error_code& ec)
+	{
+		if (ec)
+		{
+			return this->fail(ec, "async_wait");
+		}
+		this->resume();
+	}
+
+	void resume()
+	{
+		auto conn = this->connection_.get();
+
+		for (;;)
+		{
+			switch (this->step_)
+			{
+			case step::send:
+				switch (mysql_send_query_nonblocking(conn, this->query_.data(), static_cast<unsigned long>(this->query_.length())))
+				{
+				case NET_ASYNC_NOT_READY:
+					return this->wait();
+				case NET_ASYNC_ERROR:
+					return this->fail("mysql_send_query_nonblocking");
+				default:
+					// The reply is only read when it arrives
+					this->step_ = step::read_result;
+					return this->wait();
+				}
+
+			case step::read_result:
+				// The client library has no non-blocking counterpart of mysql_read_query_result.
+				// mysql_next_result_nonblocking reads the reply of the next statement in the same way, it does so when the
+				// server announced more results. The query was sent, so its reply is the next result.
+				conn->server_status |= SERVER_MORE_RESULTS_EXISTS;
+				this->step_ = step::next_result;
+				break;
+
+			case step::store_result:
+			{
+				MYSQL_RES* res = nullptr;
+				switch (mysql_store_result_nonblocking(conn, &res))
+				{
+				case NET_ASYNC_NOT_READY:
+					return this->wait();
+				case NET_ASYNC_ERROR:
+					return this->fail("mysql_store_result_nonblocking");
+				default:
+					break;
+				}
+
+				if (!res && mysql_field_count(conn) != 0)
+				{
+					return this->fail("mysql_store_result_nonblocking");
+				}
+
+				this->result_.emplace(res ? std::shared_ptr<MYSQL_RES>{ res, mysql_free_result } : nullptr, mysql_affected_rows(conn));
+
+				if (!mysql_more_results(conn))
+				{
+					return this->complete(nullptr, std::move(this->result_).value());
+				}
+				this->step_ = step::next_result;
+				break;
+			}
+
+			case step::next_result:
+				switch (mysql_next_result_nonblocking(conn))
+				{
+				case NET_ASYNC_NOT_READY:
+					return this->wait();
+				case NET_ASYNC_ERROR:
+					return this->fail("mysql_next_result_nonblocking");
+				case NET_ASYNC_COMPLETE_NO_MORE_RESULTS:
+					if (!this->result_)
+					{
+						return this->fail("mysql_next_result_nonblocking");
+					}
+					return this->complete(nullptr, std::move(this->result_).value());
+				default:
+					this->step_ = step::store_result;
+					break;
+				}
+				break;
+			}
+		}
+	}
+
+public:
+	explicit async_exec_operation(std::shared_ptr<MYSQL>        connection,
+	                              boost::asio::io_context&      io,
+	                              std::string_view              query,
+	                              async_exec_completion_handler handler,
+	                              std::function<void()>         cancel)
+	    : connection_{ std::move(connection) }
+	    , query_{ query }
+	    , handler_{ std::move(handler) }
+	    , io_{ io }
+	    , executor_{ boost::asio::prefer(boost::asio::get_associated_executor(this->handler_, io.get_executor()),
+	                                     boost::asio::execution::outstanding_work.tracked) }
+	    , slot_{ boost::asio::get_associated_cancellation_slot(this->handler_) }
+	    , cancel_{ std::move(cancel) }
+	    , strand_{ boost::asio::make_strand(io) }
+	    , stream_{ io }
+	    , step_{ step::send }
+	    , result_{}
+	    , completed_{}
+	{
+	}
+
+	~async_exec_operation()
+	{
+		try
+		{
+			this->release_stream();
+		}
+		catch (const std::exception& e)
+		{
+			ZOO_LOG(warn, "{}", e.what());
+		}
+	}
+
+	void run()
+	{
+		const auto sock = native_socket(*this->connection_);
+		if (!sock)
+		{
+			return this->complete(std::make_exception_ptr(error{ "Cannot execute asynchronously, the connection is not open" }), resultset{});
+		}
+
+		ZOO_LOG(trace, "assign fd={}", sock.value());
+		auto ec = boost::system::error_code{};
+		this->stream_.assign(sock.value(), ec);
+		if (ec)
+		{
+			return this->fail(ec, "assign");
+		}
+		ZOO_LOG(trace, "async exec: {}", this->query_);
+		this->cancel_on_slot();
+		this->resume();
+	}
+};
+
+#endif
+
+} // namespace
+
+void async_backend::exec(std::shared_ptr<MYSQL>        connection,
+                         boost::asio::io_context&      io,
+                         std::string_view              query,
+                         async_exec_completion_handler handler,
+                         std::function<void()>         cancel)
+{
+#ifdef ZOO_SQUID_MYSQL_HAS_NONBLOCKING_API
+	std::make_shared<async_exec_operation>(std::move(connection), io, query, std::move(handler), std::move(cancel))->run();
+#else
+	const auto executor = boost::asio::get_associated_executor(handler, io.get_executor());
+	boost::asio::post(executor, [handler = std::move(handler)]() mutable {
+		std::move(handler)(
+		    std::make_exception_ptr(error{ "Asynchronous execution needs the non-blocking API of the MySQL 8.0.16 client library or later" }),
+		    resultset{});
+	});
+#endif
+}
+
+} // namespace mysql
+} // namespace squid
+} // namespace zoo
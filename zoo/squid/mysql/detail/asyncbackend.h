@@ -0,0 +1,42 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/mysql/config.h"
+#include "zoo/squid/mysql/asyncexec.h"
+#include "zoo/squid/mysql/detail/mysqlfwd.h"
+
+#include <boost/asio/io_context.hpp>
+
+#include <functional>
+#include <memory>
+#include <string_view>
+
+namespace zoo {
+namespace squid {
+namespace mysql {
+
+class ZOO_SQUID_MYSQL_API async_backend final
+{
+public:
+	/// Execute @a query with the non-blocking API of the client library.
+	/// @a handler is posted once to its associated executor, or to @a io if it has none, with the result of the last
+	/// statement or the first error.
+	/// When the cancellation slot of @a handler is emitted, @a cancel is called on a separate thread to cancel the query on
+	/// the server, unless the operation has completed by then. The operation then fails with the resulting error.
+	/// Without @a cancel, cancellation is not supported.
+	static void exec(std::shared_ptr<MYSQL>        connection,
+	                 boost::asio::io_context&      io,
+	                 std::string_view              query,
+	                 async_exec_completion_handler handler,
+	                 std::function<void()>         cancel = {});
+};
+
+} // namespace mysql
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,70 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/mysql/detail/columnarrow.h"
+#include "zoo/squid/mysql/error.h"
+
+#include "zoo/common/misc/throw_exception.h"
+
+#include <iomanip>
+#include <sstream>
+#include <cassert>
+
+#include <mysql/mysql.h>
+
+namespace zoo {
+namespace squid {
+namespace mysql {
+
+void append_columnar_row(column_batch&                                       batch,
+                         const std::vector<MYSQL_BIND>&                      binds,
+                         const std::vector<columnar_value>&                  values,
+                         const std::function<std::string_view(std::size_t)>& field_name)
+{
+	assert(binds.size() >= batch.column_count() && values.size() >= batch.column_count());
+
+	for (std::size_t i = 0, end = batch.column_count(); i < end; ++i)
+	{
+		const auto& bind = binds[i];
+		if (!bind.is_null_value && bind.error_value && batch.column(i).type() != column_type::text)
+		{
+			std::ostringstream msg;
+			msg << "The value of column " << std::quoted(field_name(i)) << " does not fit in the type of the column batch";
+			ZOO_THROW_EXCEPTION(error{ msg.str() });
+		}
+	}
+
+	for (std::size_t i = 0, end = batch.column_count(); i < end; ++i)
+	{
+		auto&       column  = batch.column(i);
+		const auto& bind    = binds[i];
+		const auto& value   = values[i];
+		const auto  is_null = bind.is_null_value;
+
+		column.nulls().push_back(is_null);
+
+		switch (column.type())
+		{
+		case column_type::int64:
+			column.int64_values().push_back(is_null ? 0 : value.int64);
+			break;
+		case column_type::float64:
+			column.float64_values().push_back(is_null ? 0.0 : value.float64);
+			break;
+		case column_type::text:
+			assert(is_null || bind.length_value <= value.text.size());
+			column.text_values().push_back(is_null ? std::string_view{} : std::string_view{ value.text.data(), bind.length_value });
+			break;
+		}
+	}
+
+	batch.set_rows(batch.rows() + 1u);
+}
+
+} // namespace mysql
+} // namespace squid
+} // namespace zoo
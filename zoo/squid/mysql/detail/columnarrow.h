@@ -0,0 +1,42 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/mysql/detail/mysqlfwd.h"
+#include "zoo/squid/core/columnbatch.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+namespace mysql {
+
+/// Fetch buffers of one field for query_results::fetch_columns
+struct columnar_value final
+{
+	std::int64_t int64;
+	double       float64;
+	std::string  text;
+};
+
+/// Append the row that was fetched into @a values, which are bound by @a binds, to the columns of @a batch.
+/// All values are checked before the first one is appended, so that a value that does not fit in the type of its
+/// column throws and leaves the batch as it was. @a field_name names the field of that value in the error.
+/// Text values must have been fetched completely, their length must not exceed the size of their buffer.
+void append_columnar_row(column_batch&                                       batch,
+                         const std::vector<MYSQL_BIND>&                      binds,
+                         const std::vector<columnar_value>&                  values,
+                         const std::function<std::string_view(std::size_t)>& field_name);
+
+} // namespace mysql
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,27 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/mysql/detail/cursor.h"
+
+#include <mysql/mysql.h>
+
+namespace zoo {
+namespace squid {
+namespace mysql {
+
+cursor_attributes cursor_attributes_for(fetch_mode mode)
+{
+	if (fetch_mode::streaming == mode)
+	{
+		return cursor_attributes{ .cursor_type = CURSOR_TYPE_READ_ONLY, .prefetch_rows = cursor_prefetch_rows };
+	}
+	return cursor_attributes{ .cursor_type = CURSOR_TYPE_NO_CURSOR, .prefetch_rows = std::nullopt };
+}
+
+} // namespace mysql
+} // namespace squid
+} // namespace zoo
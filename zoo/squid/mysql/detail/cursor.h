@@ -0,0 +1,34 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/core/fetchmode.h"
+
+#include <optional>
+
+namespace zoo {
+namespace squid {
+namespace mysql {
+
+/// Number of rows that are fetched from the server at once when a cursor is used
+constexpr unsigned long cursor_prefetch_rows = 256;
+
+/// Statement attributes that select how the rows of a fetch mode are transferred
+struct cursor_attributes final
+{
+	unsigned long                cursor_type;   //!< Value of STMT_ATTR_CURSOR_TYPE
+	std::optional<unsigned long> prefetch_rows; //!< Value of STMT_ATTR_PREFETCH_ROWS, if it must be set
+};
+
+/// Streaming uses a read-only server side cursor that prefetches cursor_prefetch_rows rows at a time, the other modes
+/// use no cursor, so that the complete result can be stored on the client.
+cursor_attributes cursor_attributes_for(fetch_mode mode);
+
+} // namespace mysql
+} // namespace squid
+} // namespace zoo
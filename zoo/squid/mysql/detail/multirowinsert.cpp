@@ -0,0 +1,221 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/mysql/detail/multirowinsert.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+
+namespace zoo {
+namespace squid {
+namespace mysql {
+
+namespace {
+
+constexpr auto npos = std::string_view::npos;
+
+bool is_word_char(char c)
+{
+	return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$';
+}
+
+bool is_space(char c)
+{
+	return std::isspace(static_cast<unsigned char>(c));
+}
+
+bool iequals(std::string_view a, std::string_view b)
+{
+	return std::ranges::equal(a, b, [](char x, char y) {
+		return std::toupper(static_cast<unsigned char>(x)) == std::toupper(static_cast<unsigned char>(y));
+	});
+}
+
+bool is_comment(std::string_view query, std::size_t pos)
+{
+	const auto rest = query.substr(pos);
+	return rest.starts_with('#') || rest.starts_with("--") || rest.starts_with("/*");
+}
+
+// Returns the position after the quoted text that starts at @a pos, or npos when it does not end
+std::size_t skip_quoted(std::string_view query, std::size_t pos)
+{
+	const auto quote = query[pos];
+	for (auto i = pos + 1u; i < query.size(); ++i)
+	{
+		if (query[i] == '\\' && quote != '`')
+		{
+			++i; // an escaped character
+		}
+		else if (query[i] == quote)
+		{
+			if (i + 1u < query.size() && query[i + 1u] == quote)
+			{
+				++i; // a doubled quote
+			}
+			else
+			{
+				return i + 1u;
+			}
+		}
+	}
+	return npos;
+}
+
+} // namespace
+
+std::optional<multi_row_insert> multi_row_insert::parse(std::string_view query)
+{
+	auto first_word = true;
+	auto depth      = std::size_t{};
+	auto values     = false; // the VALUES keyword was found
+	auto row_begin  = npos;
+	auto parameters = std::size_t{};
+
+	for (auto i = std::size_t{}; i < query.size();)
+	{
+		const auto c = query[i];
+
+		if (first_word && !is_space(c) && !is_word_char(c))
+		{
+			return std::nullopt;
+		}
+
+		if (c == '\'' || c == '"' || c == '`')
+		{
+			i = skip_quoted(query, i);
+			if (i == npos)
+			{
+				return std::nullopt;
+			}
+		}
+		else if (is_comment(query, i))
+		{
+			return std::nullopt;
+		}
+		else if (c == '?')
+		{
+			if (row_begin == npos)
+			{
+				return std::nullopt; // a parameter outside the row
+			}
+			++parameters;
+			++i;
+		}
+		else if (c == '(')
+		{
+			if (depth == 0u && values && row_begin == npos)
+			{
+				row_begin = i;
+			}
+			++depth;
+			++i;
+		}
+		else if (c == ')')
+		{
+			if (depth == 0u)
+			{
+				return std::nullopt;
+			}
+			--depth;
+			++i;
+
+			if (depth == 0u && row_begin != npos)
+			{
+				// Nothing may follow the row, e.g. another row or ON DUPLICATE KEY UPDATE
+				if (parameters == 0u || std::any_of(query.begin() + i, query.end(), [](char x) { return !is_space(x); }))
+				{
+					return std::nullopt;
+				}
+				auto result        = multi_row_insert{};
+				result.head_       = query.substr(0u, row_begin);
+				result.row_        = query.substr(row_begin, i - row_begin);
+				result.parameters_ = parameters;
+				return result;
+			}
+		}
+		else if (is_word_char(c))
+		{
+			auto last = i;
+			while (last < query.size() && is_word_char(query[last]))
+			{
+				++last;
+			}
+			const auto word = query.substr(i, last - i);
+
+			if (first_word)
+			{
+				if (!iequals(word, "INSERT") && !iequals(word, "REPLACE"))
+				{
+					return std::nullopt;
+				}
+				first_word = false;
+			}
+			else if (depth == 0u && values)
+			{
+				return std::nullopt; // e.g. VALUES ROW(...)
+			}
+			else if (depth == 0u && (iequals(word, "VALUES") || iequals(word, "VALUE")))
+			{
+				values = true;
+			}
+			i = last;
+		}
+		else
+		{
+			if (depth == 0u && values && !is_space(c))
+			{
+				return std::nullopt;
+			}
+			++i;
+		}
+	}
+
+	return std::nullopt;
+}
+
+std::string multi_row_insert::query(std::size_t rows) const
+{
+	assert(rows > 0u);
+
+	auto query = std::string{};
+	query.reserve(this->head_.size() + rows * (this->row_.size() + 2u));
+	query += this->head_;
+	query += this->row_;
+	for (auto i = std::size_t{ 1 }; i < rows; ++i)
+	{
+		query += ", ";
+		query += this->row_;
+	}
+	return query;
+}
+
+std::size_t multi_row_insert::parameters() const
+{
+	return this->parameters_;
+}
+
+std::size_t multi_row_insert::rows_per_execution(std::size_t max_row_bytes, std::size_t max_packet) const
+{
+	// Room for the headers of the packets and the null bitmap
+	constexpr auto overhead = std::size_t{ 1024 } + max_parameters / 8u;
+	if (max_packet <= overhead + this->head_.size())
+	{
+		return 1u;
+	}
+	const auto room = max_packet - overhead;
+
+	auto rows = max_parameters / this->parameters_;
+	rows      = std::min(rows, (room - this->head_.size()) / (this->row_.size() + 2u));
+	rows      = std::min(rows, room / std::max(max_row_bytes, std::size_t{ 1 }));
+	return std::max(rows, std::size_t{ 1 });
+}
+
+} // namespace mysql
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,50 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace zoo {
+namespace squid {
+namespace mysql {
+
+/// A plain INSERT or REPLACE of a single VALUES row, which can be rewritten to insert several rows per execution.
+/// E.g. "INSERT INTO t(a, b) VALUES (?, ?)" becomes "INSERT INTO t(a, b) VALUES (?, ?), (?, ?), (?, ?)".
+class multi_row_insert final
+{
+	std::string head_;       // the query up to the row
+	std::string row_;        // the row, including its parentheses
+	std::size_t parameters_; // number of ? in the row
+
+public:
+	/// Most placeholders that a prepared statement can have
+	static constexpr std::size_t max_parameters = 65535u;
+
+	/// Parse @a query, with its parameters translated to ?.
+	/// Returns nothing unless the query is an INSERT or REPLACE with a VALUES clause of one row, with all its parameters
+	/// in that row and nothing after it, e.g. no ON DUPLICATE KEY UPDATE. Queries with comments are not rewritten either.
+	static std::optional<multi_row_insert> parse(std::string_view query);
+
+	/// The query that inserts @a rows rows
+	std::string query(std::size_t rows) const;
+
+	/// Number of parameters per row
+	std::size_t parameters() const;
+
+	/// Number of rows per execution, so that neither the query nor the execute packet of a full execution exceeds
+	/// @a max_packet bytes, and the placeholders do not exceed max_parameters.
+	/// @a max_row_bytes is an upper bound of the size of the parameters of one row in the execute packet.
+	std::size_t rows_per_execution(std::size_t max_row_bytes, std::size_t max_packet) const;
+};
+
+} // namespace mysql
+} // namespace squid
+} // namespace zoo
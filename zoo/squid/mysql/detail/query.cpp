@@ -7,6 +7,9 @@
 
 #include "zoo/squid/mysql/detail/query.h"
 
+#include "zoo/squid/core/translatedquerycache.h"
+
+#include <algorithm>
 #include <cctype>
 #include <cassert>
 
@@ -26,6 +29,8 @@ mysql_query::mysql_query(std::string_view query)
     : query_{}
     , name_pos_map_{}
     , parameter_count_{}
+    , plan_{}
+    , plan_positions_{}
 {
 	// Implementation based on https://github.com/SOCI/soci/blob/master/src/backends/mysql/statement.cpp,
 	// simplified and improved.
@@ -37,14 +42,25 @@ mysql_query::mysql_query(std::string_view query)
 		in_name
 	} state = normal;
 
-	auto name_begin = query.end();
+	auto                     name_begin = query.end();
+	std::vector<std::string> names{};
+
+	this->query_.reserve(query.length());
 
-	auto&& at_end_of_name = [this, &name_begin](auto it) {
+	auto&& at_end_of_name = [this, &name_begin, &names](auto it) {
 		assert(name_begin < it);
 		std::string name{ name_begin, it };
 
-		this->name_pos_map_[name].push_back(this->parameter_count_++);
-		this->query_.append("?");
+		auto& positions = this->name_pos_map_[name];
+		if (positions.empty())
+		{
+			this->plan_positions_.emplace_back();
+			names.push_back(name);
+		}
+		const auto plan_index = static_cast<std::size_t>(std::find(names.begin(), names.end(), name) - names.begin());
+		this->plan_positions_[plan_index].push_back(this->parameter_count_);
+		positions.push_back(this->parameter_count_++);
+		this->query_.push_back('?');
 	};
 
 	for (auto it = query.begin(), end = query.end(); it != end; ++it)
@@ -159,6 +175,8 @@ mysql_query::mysql_query(std::string_view query)
 	{
 		at_end_of_name(query.end());
 	}
+
+	this->plan_ = binding_plan{ std::move(names) };
 }
 
 const std::string& mysql_query::query() const
@@ -176,6 +194,22 @@ const std::map<std::string, std::vector<size_t>>& mysql_query::parameter_name_po
 	return this->name_pos_map_;
 }
 
+const binding_plan& mysql_query::plan() const
+{
+	return this->plan_;
+}
+
+const std::vector<size_t>& mysql_query::plan_positions(std::size_t index) const
+{
+	return this->plan_positions_.at(index);
+}
+
+std::shared_ptr<const mysql_query> mysql_query::cached(std::string_view query)
+{
+	static translated_query_cache<mysql_query> cache{};
+	return cache.get(query);
+}
+
 } // namespace mysql
 } // namespace squid
 } // namespace zoo
@@ -7,6 +7,9 @@
 
 #pragma once
 
+#include "zoo/squid/core/bindingplan.h"
+
+#include <memory>
 #include <string>
 #include <string_view>
 #include <map>
@@ -23,6 +26,8 @@ class mysql_query final
 	std::string                                query_;
 	std::map<std::string, std::vector<size_t>> name_pos_map_;
 	size_t                                     parameter_count_;
+	binding_plan                               plan_;           // distinct parameter names, in order of appearance
+	std::vector<std::vector<size_t>>           plan_positions_; // the ? positions of each plan_ entry
 
 public:
 	explicit mysql_query(std::string_view query);
@@ -37,6 +42,14 @@ public:
 	size_t parameter_count() const;
 
 	const std::map<std::string, std::vector<size_t>>& parameter_name_pos_map() const;
+
+	const binding_plan& plan() const;
+
+	/// Get the ? positions of the parameter at @a index in plan()
+	const std::vector<size_t>& plan_positions(std::size_t index) const;
+
+	/// Get the shared translation of @a query from a process wide cache
+	static std::shared_ptr<const mysql_query> cached(std::string_view query);
 };
 
 } // namespace mysql
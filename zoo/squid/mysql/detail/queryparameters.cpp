@@ -174,24 +174,44 @@ query_parameters::query_parameters(const mysql_query& query, const std::map<std:
 		{
 			ZOO_THROW_EXCEPTION(error{ "The query parameter '" + pair.first + "' is not bound" });
 		}
-		const auto& parameter = it->second;
+		this->bind_positions(pair.second, it->second);
+	}
+}
+
+query_parameters::query_parameters(const mysql_query& query, const positional_parameters& parameters)
+    : binds_{ query.parameter_count() }
+    , buffers_{ binds_.size() }
+{
+	const auto& plan = query.plan();
+	assert(parameters.size() == plan.size());
+
+	for (std::size_t index = 0; index < plan.size(); ++index)
+	{
+		const auto& parameter = parameters[index];
+		if (!parameter)
+		{
+			ZOO_THROW_EXCEPTION(error{ "The query parameter '" + plan.name(index) + "' is not bound" });
+		}
+		this->bind_positions(query.plan_positions(index), parameter.value());
+	}
+}
 
-		const auto& positions = pair.second;
-		assert(!positions.empty());
+void query_parameters::bind_positions(const std::vector<size_t>& positions, const parameter& parameter)
+{
+	assert(!positions.empty());
 
-		auto first = true;
-		for (const auto position : positions)
+	auto first = true;
+	for (const auto position : positions)
+	{
+		assert(position < this->binds_.size());
+		if (first)
+		{
+			bind_parameter(this->binds_[position], this->buffers_[position], parameter);
+			first = false;
+		}
+		else
 		{
-			assert(position < this->binds_.size());
-			if (first)
-			{
-				bind_parameter(this->binds_[position], this->buffers_[position], parameter);
-				first = false;
-			}
-			else
-			{
-				this->binds_[position] = this->binds_[positions.front()];
-			}
+			this->binds_[position] = this->binds_[positions.front()];
 		}
 	}
 }
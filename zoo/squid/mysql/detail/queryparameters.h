@@ -9,6 +9,7 @@
 
 #include "zoo/squid/mysql/detail/mysqlfwd.h"
 #include "zoo/squid/core/parameter.h"
+#include "zoo/squid/core/bindingplan.h"
 
 #include <string>
 #include <vector>
@@ -25,8 +26,11 @@ class query_parameters final
 	std::vector<MYSQL_BIND>  binds_;
 	std::vector<std::string> buffers_;
 
+	void bind_positions(const std::vector<size_t>& positions, const parameter& parameter);
+
 public:
 	explicit query_parameters(const mysql_query& query, const std::map<std::string, parameter>& parameters);
+	explicit query_parameters(const mysql_query& query, const positional_parameters& parameters);
 
 	query_parameters(const query_parameters&)            = delete;
 	query_parameters(query_parameters&& src)             = default;
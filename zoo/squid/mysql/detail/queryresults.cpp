@@ -16,6 +16,7 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <sstream>
 #include <iomanip>
 #include <cstring>
@@ -357,6 +358,10 @@ query_results::query_results(std::shared_ptr<MYSQL_STMT> statement)
     , field_count_{}
     , binds_{}
     , columns_{}
+    , columnar_binds_{}
+    , columnar_values_{}
+    , columnar_types_{}
+    , columnar_rebind_{}
 {
 	assert(statement);
 
@@ -493,6 +498,11 @@ std::string_view query_results::field_name(std::size_t index) const
 
 bool query_results::fetch()
 {
+	if (!this->columnar_binds_.empty())
+	{
+		ZOO_THROW_EXCEPTION(error{ "Cannot fetch a row after fetching columns from the same result" });
+	}
+
 	switch (mysql_stmt_fetch(this->statement_.get()))
 	{
 	case 0:
@@ -512,6 +522,135 @@ bool query_results::fetch()
 	return true;
 }
 
+void query_results::bind_columns(const column_batch& batch)
+{
+	static constexpr std::size_t initial_text_buffer_size = 64u;
+
+	std::vector<column_type> types{};
+	types.reserve(batch.column_count());
+	for (std::size_t i = 0, end = batch.column_count(); i < end; ++i)
+	{
+		types.push_back(batch.column(i).type());
+	}
+
+	if (!this->columnar_binds_.empty() && types == this->columnar_types_)
+	{
+		return;
+	}
+
+	this->columnar_types_ = std::move(types);
+	this->columnar_values_.resize(this->field_count_);
+	this->columnar_binds_.resize(this->field_count_);
+
+	for (std::size_t i = 0, end = this->field_count_; i < end; ++i)
+	{
+		auto& bind  = this->columnar_binds_[i];
+		auto& value = this->columnar_values_[i];
+
+		std::memset(&bind, 0, sizeof(bind));
+		bind.buffer_type = MYSQL_TYPE_NULL;
+
+		if (i >= this->columnar_types_.size())
+		{
+			continue;
+		}
+
+		bind.is_null = &bind.is_null_value;
+		bind.length  = &bind.length_value;
+		bind.error   = &bind.error_value;
+
+		switch (this->columnar_types_[i])
+		{
+		case column_type::int64:
+			bind.buffer_type = MYSQL_TYPE_LONGLONG;
+			bind.buffer      = &value.int64;
+			break;
+		case column_type::float64:
+			bind.buffer_type = MYSQL_TYPE_DOUBLE;
+			bind.buffer      = &value.float64;
+			break;
+		case column_type::text:
+			value.text.resize(std::max(value.text.size(), initial_text_buffer_size));
+			bind.buffer_type   = MYSQL_TYPE_STRING;
+			bind.buffer        = value.text.data();
+			bind.buffer_length = value.text.size();
+			break;
+		}
+	}
+
+	this->columnar_rebind_ = true;
+}
+
+std::size_t query_results::fetch_columns(column_batch& batch, std::size_t batch_size)
+{
+	if (batch.column_count() > this->field_count_)
+	{
+		ZOO_THROW_EXCEPTION(error{ fmt::format("Cannot fetch {column_count} columns from a result set with {field_count} column{ord}",
+		                                       "column_count"_a = batch.column_count(),
+		                                       "field_count"_a  = this->field_count_,
+		                                       "ord"_a          = (this->field_count_ == 1 ? "" : "s")) });
+	}
+
+	if (0u == this->field_count_)
+	{
+		return 0u;
+	}
+
+	this->bind_columns(batch);
+
+	auto rows = std::size_t{};
+	while (rows < batch_size)
+	{
+		if (this->columnar_rebind_)
+		{
+			if (0 != mysql_stmt_bind_result(this->statement_.get(), &this->columnar_binds_.front()))
+			{
+				ZOO_THROW_EXCEPTION(error{ "mysql_stmt_bind_result failed", *this->statement_ });
+			}
+			this->columnar_rebind_ = false;
+		}
+
+		switch (mysql_stmt_fetch(this->statement_.get()))
+		{
+		case 0:
+		case MYSQL_DATA_TRUNCATED:
+			break;
+		case MYSQL_NO_DATA:
+			return rows;
+		default:
+			ZOO_THROW_EXCEPTION(error{ "mysql_stmt_fetch failed", *this->statement_ });
+		}
+
+		// Text values that were truncated are fetched completely before the row is appended
+		for (std::size_t i = 0, end = batch.column_count(); i < end; ++i)
+		{
+			auto& bind  = this->columnar_binds_[i];
+			auto& value = this->columnar_values_[i];
+			if (batch.column(i).type() == column_type::text && !bind.is_null_value && bind.length_value > value.text.size())
+			{
+				// Grow the buffer for the next rows and fetch the complete value again
+				value.text.resize(bind.length_value);
+				bind.buffer            = value.text.data();
+				bind.buffer_length     = value.text.size();
+				this->columnar_rebind_ = true;
+				if (0 != mysql_stmt_fetch_column(this->statement_.get(), &bind, static_cast<unsigned int>(i), 0ul))
+				{
+					ZOO_THROW_EXCEPTION(error{ "mysql_stmt_fetch_column failed", *this->statement_ });
+				}
+			}
+		}
+
+		// The row is fetched from the server already, when it cannot be appended it is skipped by the next call
+		append_columnar_row(batch, this->columnar_binds_, this->columnar_values_, [this](std::size_t index) {
+			return this->field_name(index);
+		});
+
+		++rows;
+	}
+
+	return rows;
+}
+
 } // namespace mysql
 } // namespace squid
 } // namespace zoo
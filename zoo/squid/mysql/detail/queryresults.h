@@ -8,11 +8,14 @@
 #pragma once
 
 #include "zoo/squid/mysql/detail/mysqlfwd.h"
+#include "zoo/squid/mysql/detail/columnarrow.h"
 #include "zoo/squid/core/result.h"
+#include "zoo/squid/core/columnbatch.h"
 
 #include <vector>
 #include <map>
 #include <memory>
+#include <string>
 
 namespace zoo {
 namespace squid {
@@ -29,8 +32,15 @@ class query_results final
 	std::vector<MYSQL_BIND>              binds_;
 	std::vector<std::unique_ptr<column>> columns_;
 
+	std::vector<MYSQL_BIND>     columnar_binds_; // bindings of fetch_columns, empty until it is called
+	std::vector<columnar_value> columnar_values_;
+	std::vector<column_type>    columnar_types_; // column types that columnar_binds_ are set up for
+	bool                        columnar_rebind_; // true if columnar_binds_ must be passed to mysql_stmt_bind_result
+
 	explicit query_results(std::shared_ptr<MYSQL_STMT> statement);
 
+	void bind_columns(const column_batch& batch);
+
 public:
 	explicit query_results(std::shared_ptr<MYSQL_STMT> statement, const std::vector<result>& results);
 	explicit query_results(std::shared_ptr<MYSQL_STMT> statement, const std::map<std::string, result>& results);
@@ -41,6 +51,9 @@ public:
 	std::string_view field_name(std::size_t index) const;
 
 	bool fetch();
+
+	/// Rebinds the result buffers to fixed size per-column buffers, after which fetch() can no longer be used
+	std::size_t fetch_columns(column_batch& batch, std::size_t batch_size);
 };
 
 } // namespace mysql
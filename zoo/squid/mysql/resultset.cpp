@@ -0,0 +1,102 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/mysql/resultset.h"
+
+#include <fmt/format.h>
+
+#include <stdexcept>
+
+#include <mysql/mysql.h>
+
+namespace zoo {
+namespace squid {
+namespace mysql {
+
+resultset::resultset()
+    : result_{}
+    , affected_rows_{}
+    , field_count_{}
+    , values_{}
+{
+}
+
+resultset::resultset(std::shared_ptr<MYSQL_RES> result, std::uint64_t affected_rows)
+    : result_{ std::move(result) }
+    , affected_rows_{ affected_rows }
+    , field_count_{ this->result_ ? mysql_num_fields(this->result_.get()) : 0u }
+    , values_{}
+{
+	if (this->result_)
+	{
+		auto res = this->result_.get();
+		this->values_.reserve(static_cast<std::size_t>(mysql_num_rows(res)) * this->field_count_);
+
+		// The result is stored on the client side, fetching rows does not block
+		while (const auto row = mysql_fetch_row(res))
+		{
+			const auto lengths = mysql_fetch_lengths(res);
+			for (std::size_t field_index = 0; field_index < this->field_count_; ++field_index)
+			{
+				if (row[field_index])
+				{
+					this->values_.emplace_back(std::string_view{ row[field_index], lengths[field_index] });
+				}
+				else
+				{
+					this->values_.emplace_back(std::nullopt);
+				}
+			}
+		}
+	}
+}
+
+std::uint64_t resultset::affected_rows() const
+{
+	return this->affected_rows_;
+}
+
+std::size_t resultset::size() const
+{
+	return this->field_count_ ? this->values_.size() / this->field_count_ : 0u;
+}
+
+bool resultset::empty() const
+{
+	return this->size() == 0u;
+}
+
+std::size_t resultset::field_count() const
+{
+	return this->field_count_;
+}
+
+std::string_view resultset::field_name(std::size_t field_index) const
+{
+	if (field_index >= this->field_count_)
+	{
+		throw std::out_of_range{ fmt::format("Field index {} is out of range [0, {})", field_index, this->field_count_) };
+	}
+	return mysql_fetch_field_direct(this->result_.get(), static_cast<unsigned int>(field_index))->name;
+}
+
+std::optional<std::string_view> resultset::value(std::size_t row_index, std::size_t field_index) const
+{
+	if (row_index >= this->size())
+	{
+		throw std::out_of_range{ fmt::format("Row index {} is out of range [0, {})", row_index, this->size()) };
+	}
+	if (field_index >= this->field_count_)
+	{
+		throw std::out_of_range{ fmt::format("Field index {} is out of range [0, {})", field_index, this->field_count_) };
+	}
+	return this->values_[row_index * this->field_count_ + field_index];
+}
+
+} // namespace mysql
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,54 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/mysql/config.h"
+#include "zoo/squid/mysql/detail/mysqlfwd.h"
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+namespace mysql {
+
+/// Result of an asynchronous execution.
+/// The complete result is stored on the client side, values are in the text format of the server.
+class ZOO_SQUID_MYSQL_API resultset final
+{
+	std::shared_ptr<MYSQL_RES>                   result_;
+	std::uint64_t                                affected_rows_;
+	std::size_t                                  field_count_;
+	std::vector<std::optional<std::string_view>> values_; // row major, pointing into result_
+
+public:
+	/// Create an empty resultset
+	resultset();
+
+	/// @a result may be nullptr for a statement that does not return rows
+	explicit resultset(std::shared_ptr<MYSQL_RES> result, std::uint64_t affected_rows);
+
+	std::uint64_t affected_rows() const;
+
+	/// Get the number of rows
+	std::size_t size() const;
+	bool        empty() const;
+
+	std::size_t      field_count() const;
+	std::string_view field_name(std::size_t field_index) const;
+
+	/// Get the value of field @a field_index in row @a row_index, or std::nullopt if it is NULL
+	std::optional<std::string_view> value(std::size_t row_index, std::size_t field_index) const;
+};
+
+} // namespace mysql
+} // namespace squid
+} // namespace zoo
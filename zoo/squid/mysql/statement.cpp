@@ -8,6 +8,8 @@
 #include "zoo/squid/mysql/statement.h"
 #include "zoo/squid/mysql/error.h"
 
+#include "zoo/squid/mysql/detail/cursor.h"
+#include "zoo/squid/mysql/detail/multirowinsert.h"
 #include "zoo/squid/mysql/detail/query.h"
 #include "zoo/squid/mysql/detail/queryparameters.h"
 #include "zoo/squid/mysql/detail/queryresults.h"
@@ -17,8 +19,12 @@
 
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
 #include <cassert>
+#include <cstdlib>
 #include <cstring>
+#include <map>
+#include <optional>
 #include <vector>
 
 #include <mysql/mysql.h>
@@ -48,31 +54,117 @@ std::shared_ptr<MYSQL_STMT> prepare_statement(MYSQL& connection, const std::stri
 	return stmt;
 }
 
+// The largest packet that the server accepts
+std::size_t max_allowed_packet(MYSQL& connection)
+{
+	const auto query = std::string_view{ "SELECT @@max_allowed_packet" };
+	if (0 != mysql_real_query(&connection, query.data(), static_cast<unsigned long>(query.length())))
+	{
+		ZOO_THROW_EXCEPTION(error{ "mysql_real_query failed", connection });
+	}
+
+	std::unique_ptr<MYSQL_RES, decltype(&mysql_free_result)> result{ mysql_store_result(&connection), mysql_free_result };
+	if (!result)
+	{
+		ZOO_THROW_EXCEPTION(error{ "mysql_store_result failed", connection });
+	}
+
+	const auto row = mysql_fetch_row(result.get());
+	if (!row || !row[0])
+	{
+		ZOO_THROW_EXCEPTION(error{ "Cannot get the max_allowed_packet of the server" });
+	}
+	return static_cast<std::size_t>(std::strtoull(row[0], nullptr, 10));
+}
+
+// An upper bound of the size of @a binds in an execute packet: the value, its length, its type and its null bit
+std::size_t row_bytes(const std::vector<MYSQL_BIND>& binds)
+{
+	auto bytes = std::size_t{};
+	for (const auto& bind : binds)
+	{
+		bytes += bind.buffer_length + 16u;
+	}
+	return bytes;
+}
+
 } // namespace
 
 class statement::impl final
 {
-	std::shared_ptr<MYSQL>            connection_;
-	std::unique_ptr<mysql_query>      query_;
-	bool                              reuse_statement_;
-	std::unique_ptr<query_parameters> parameters_;
-	std::unique_ptr<query_results>    query_results_;
-	std::shared_ptr<MYSQL_STMT>       statement_;
+	std::shared_ptr<MYSQL>                  connection_;
+	std::shared_ptr<const mysql_query>      query_;
+	bool                                    reuse_statement_;
+	std::shared_ptr<statement_handle_cache> cache_;
+	std::string                             cache_key_;
+	std::unique_ptr<query_parameters>       parameters_;
+	std::unique_ptr<query_results>          query_results_;
+	std::shared_ptr<MYSQL_STMT>             statement_;
+	fetch_mode                              fetch_mode_;
+	std::optional<multi_row_insert>         multi_row_;          // the query rewritten for execute_batch
+	bool                                    multi_row_parsed_;   // multi_row_ is set if the query can be rewritten
+	std::size_t                             max_allowed_packet_; // of the server, 0 until it is needed
+
+	// A read-only cursor keeps the result on the server, the rows are fetched in batches of cursor_prefetch_rows.
+	// The attributes are set before every execution, because a cached statement handle may have been used with
+	// another fetch mode.
+	void set_cursor_type()
+	{
+		const auto attributes = cursor_attributes_for(this->fetch_mode_);
+		if (mysql_stmt_attr_set(this->statement_.get(), STMT_ATTR_CURSOR_TYPE, &attributes.cursor_type))
+		{
+			ZOO_THROW_EXCEPTION(error{ "mysql_stmt_attr_set failed", *this->statement_ });
+		}
+		if (attributes.prefetch_rows)
+		{
+			if (mysql_stmt_attr_set(this->statement_.get(), STMT_ATTR_PREFETCH_ROWS, &attributes.prefetch_rows.value()))
+			{
+				ZOO_THROW_EXCEPTION(error{ "mysql_stmt_attr_set failed", *this->statement_ });
+			}
+		}
+	}
 
 public:
-	impl(std::shared_ptr<MYSQL> connection, std::string_view query, bool reuse_statement)
+	impl(std::shared_ptr<MYSQL> connection, std::string_view query, bool reuse_statement, std::shared_ptr<statement_handle_cache> cache)
 	    : connection_{ connection }
-	    , query_{ std::make_unique<mysql_query>(query) }
+	    , query_{ mysql_query::cached(query) }
 	    , reuse_statement_{ reuse_statement }
+	    , cache_{ reuse_statement ? std::move(cache) : nullptr }
+	    , cache_key_{ this->cache_ ? normalize_query(query) : std::string{} }
 	    , parameters_{}
 	    , query_results_{}
 	    , statement_{}
+	    , fetch_mode_{ fetch_mode::buffered }
+	    , multi_row_{}
+	    , multi_row_parsed_{}
+	    , max_allowed_packet_{}
 	{
 		assert(this->connection_);
 	}
 
-	template<typename ResultsContainer>
-	void execute(const std::map<std::string, parameter>& parameters, const ResultsContainer& results)
+	~impl() noexcept
+	{
+		if (this->cache_ && this->statement_)
+		{
+			try
+			{
+				// Discard the pending result before handing the statement to the cache
+				this->query_results_.reset();
+				mysql_stmt_free_result(this->statement_.get());
+				if (0 == mysql_stmt_reset(this->statement_.get()))
+				{
+					this->cache_->release(std::move(this->cache_key_), std::move(this->statement_));
+				}
+			}
+			catch (...)
+			{
+				;
+			}
+		}
+	}
+
+	template<typename ParametersContainer, typename ResultsContainer>
+	void execute(const ParametersContainer& parameters, const ResultsContainer& results)
 	{
 		assert(this->connection_);
 
@@ -83,6 +175,14 @@ public:
 			this->statement_.reset();
 		}
 
+		if (!this->statement_ && this->cache_)
+		{
+			if (auto cached = this->cache_->acquire(this->cache_key_))
+			{
+				this->statement_ = std::move(cached.value());
+			}
+		}
+
 		if (!this->statement_)
 		{
 			this->statement_ = prepare_statement(*this->connection_, this->query_->query());
@@ -92,6 +192,8 @@ public:
 
 		this->parameters_->bind(*this->statement_);
 
+		this->set_cursor_type();
+
 		if (0 != mysql_stmt_execute(this->statement_.get()))
 		{
 			ZOO_THROW_EXCEPTION(error{ "mysql_stmt_execute failed", *this->statement_ });
@@ -99,6 +201,13 @@ public:
 
 		this->query_results_ = std::make_unique<query_results>(this->statement_, results);
 
+		if (fetch_mode::streaming == this->fetch_mode_)
+		{
+			// The rows are fetched through the cursor. Unlike an unbuffered result, an open cursor does not
+			// prevent other statements on the same connection from being executed.
+			return;
+		}
+
 		// This call fetches the complete result on the client side, which can be suboptimal.
 		// This should not be necessary, but without this it is not possible
 		// to execute this statement again while another statement exists that has a
@@ -112,6 +221,81 @@ public:
 		}
 	}
 
+	// Execute a batch of a plain INSERT of one row as INSERTs of as many rows as fit in a packet, see multi_row_insert.
+	// Returns nothing when the query cannot be rewritten, then the batch must be executed once per parameter set.
+	template<typename ParametersContainer>
+	std::optional<std::uint64_t> execute_multi_row(std::span<const ParametersContainer> batch)
+	{
+		assert(this->connection_);
+
+		if (!this->multi_row_parsed_)
+		{
+			this->multi_row_        = multi_row_insert::parse(this->query_->query());
+			this->multi_row_parsed_ = true;
+		}
+		if (!this->multi_row_ || batch.size() < 2u)
+		{
+			return std::nullopt;
+		}
+		assert(this->multi_row_->parameters() == this->query_->parameter_count());
+
+		this->query_results_.reset();
+
+		if (this->max_allowed_packet_ == 0u)
+		{
+			this->max_allowed_packet_ = max_allowed_packet(*this->connection_);
+		}
+
+		auto max_row_bytes = std::size_t{};
+		for (const auto& set : batch)
+		{
+			max_row_bytes = std::max(max_row_bytes, row_bytes(query_parameters{ *this->query_, set }.binds()));
+		}
+		const auto rows = this->multi_row_->rows_per_execution(max_row_bytes, this->max_allowed_packet_);
+		if (rows < 2u)
+		{
+			return std::nullopt;
+		}
+
+		// Every execution but the last has the same number of rows, so at most two statements are prepared
+		auto statements = std::map<std::size_t, std::shared_ptr<MYSQL_STMT>>{};
+		auto parameters = std::vector<query_parameters>{};
+		auto binds      = std::vector<MYSQL_BIND>{};
+		auto affected   = std::uint64_t{};
+		for (auto first = std::size_t{}; first < batch.size(); first += rows)
+		{
+			const auto count = std::min(rows, batch.size() - first);
+
+			// The binds point into the parameters, which are kept until the execution
+			parameters.clear();
+			parameters.reserve(count);
+			binds.clear();
+			for (const auto& set : batch.subspan(first, count))
+			{
+				const auto& row = parameters.emplace_back(*this->query_, set).binds();
+				binds.insert(binds.end(), row.begin(), row.end());
+			}
+
+			auto& stmt = statements[count];
+			if (!stmt)
+			{
+				stmt = prepare_statement(*this->connection_, this->multi_row_->query(count));
+			}
+			assert(mysql_stmt_param_count(stmt.get()) == binds.size());
+
+			if (mysql_stmt_bind_param(stmt.get(), binds.data()))
+			{
+				ZOO_THROW_EXCEPTION(error{ "mysql_stmt_bind_param failed", *stmt });
+			}
+			if (0 != mysql_stmt_execute(stmt.get()))
+			{
+				ZOO_THROW_EXCEPTION(error{ "mysql_stmt_execute failed", *stmt });
+			}
+			affected += mysql_stmt_affected_rows(stmt.get());
+		}
+		return affected;
+	}
+
 	bool fetch()
 	{
 		if (this->query_results_)
@@ -124,6 +308,18 @@ public:
 		}
 	}
 
+	std::size_t fetch_columns(column_batch& batch, std::size_t batch_size)
+	{
+		if (this->query_results_)
+		{
+			return this->query_results_->fetch_columns(batch, batch_size);
+		}
+		else
+		{
+			ZOO_THROW_EXCEPTION(error{ "Cannot fetch rows from a statement that has not been executed" });
+		}
+	}
+
 	std::size_t field_count()
 	{
 		if (this->query_results_)
@@ -153,6 +349,16 @@ public:
 		return mysql_affected_rows(this->connection_.get());
 	}
 
+	void set_fetch_mode(fetch_mode mode)
+	{
+		this->fetch_mode_ = mode;
+	}
+
+	const binding_plan* parameter_binding_plan() const
+	{
+		return &this->query_->plan();
+	}
+
 	MYSQL_STMT& handle() const
 	{
 		if (!this->statement_)
@@ -166,9 +372,12 @@ public:
 	}
 };
 
-statement::statement(std::shared_ptr<MYSQL> connection, std::string_view query, bool reuse_statement)
+statement::statement(std::shared_ptr<MYSQL>                  connection,
+                     std::string_view                        query,
+                     bool                                    reuse_statement,
+                     std::shared_ptr<statement_handle_cache> cache)
     : ibackend_statement{}
-    , pimpl_{ std::make_unique<impl>(connection, query, reuse_statement) }
+    , pimpl_{ std::make_unique<impl>(connection, query, reuse_statement, std::move(cache)) }
 {
 }
 
@@ -186,11 +395,49 @@ void statement::execute(const std::map<std::string, parameter>& parameters, cons
 	this->pimpl_->execute(parameters, results);
 }
 
+void statement::execute_positional(const positional_parameters& parameters, const std::vector<result>& results)
+{
+	this->pimpl_->execute(parameters, results);
+}
+
+void statement::execute_positional(const positional_parameters& parameters, const std::map<std::string, result>& results)
+{
+	this->pimpl_->execute(parameters, results);
+}
+
+std::uint64_t statement::execute_batch(std::span<const std::map<std::string, parameter>> batch)
+{
+	if (const auto rows = this->pimpl_->execute_multi_row(batch))
+	{
+		return rows.value();
+	}
+	return ibackend_statement::execute_batch(batch);
+}
+
+std::uint64_t statement::execute_batch_positional(std::span<const positional_parameters> batch)
+{
+	if (const auto rows = this->pimpl_->execute_multi_row(batch))
+	{
+		return rows.value();
+	}
+	return ibackend_statement::execute_batch_positional(batch);
+}
+
+const binding_plan* statement::parameter_binding_plan() const
+{
+	return this->pimpl_->parameter_binding_plan();
+}
+
 bool statement::fetch()
 {
 	return this->pimpl_->fetch();
 }
 
+std::size_t statement::fetch_columns(column_batch& batch, std::size_t batch_size)
+{
+	return this->pimpl_->fetch_columns(batch, batch_size);
+}
+
 std::size_t statement::field_count()
 {
 	return this->pimpl_->field_count();
@@ -206,6 +453,11 @@ std::uint64_t statement::affected_rows()
 	return this->pimpl_->affected_rows();
 }
 
+void statement::set_fetch_mode(fetch_mode mode)
+{
+	this->pimpl_->set_fetch_mode(mode);
+}
+
 /*static*/ void statement::execute(MYSQL& connection, std::string_view query)
 {
 	if (0 != mysql_real_query(&connection, query.data(), static_cast<unsigned long>(query.length())))
@@ -10,6 +10,7 @@
 #include "zoo/squid/mysql/detail/mysqlfwd.h"
 #include "zoo/squid/mysql/detail/queryfwd.h"
 #include "zoo/squid/core/ibackendstatement.h"
+#include "zoo/squid/core/statementcache.h"
 
 #include <memory>
 #include <string>
@@ -18,13 +19,21 @@ namespace zoo {
 namespace squid {
 namespace mysql {
 
+/// Cache of idle prepared statement handles
+using statement_handle_cache = statement_cache<std::shared_ptr<MYSQL_STMT>>;
+
 class statement final : public ibackend_statement
 {
 	class impl;
 	std::unique_ptr<impl> pimpl_;
 
 public:
-	statement(std::shared_ptr<MYSQL> connection, std::string_view query, bool reuse_statement);
+	/// When @a reuse_statement is true and @a cache is given, a cached statement handle for the same query is reused
+	/// and the handle is returned to @a cache when this object is destroyed, instead of being closed.
+	statement(std::shared_ptr<MYSQL>                  connection,
+	          std::string_view                        query,
+	          bool                                    reuse_statement,
+	          std::shared_ptr<statement_handle_cache> cache = {});
 	~statement() noexcept;
 
 	statement(statement&&)            = default;
@@ -35,13 +44,25 @@ public:
 
 	void execute(const std::map<std::string, parameter>& parameters, const std::vector<result>& results) override;
 	void execute(const std::map<std::string, parameter>& parameters, const std::map<std::string, result>& results) override;
+	void execute_positional(const positional_parameters& parameters, const std::vector<result>& results) override;
+	void execute_positional(const positional_parameters& parameters, const std::map<std::string, result>& results) override;
+	/// A plain INSERT of one row is executed as INSERTs of many rows, in executions that fit in max_allowed_packet.
+	/// Other statements are executed once per parameter set.
+	std::uint64_t execute_batch(std::span<const std::map<std::string, parameter>> batch) override;
+	std::uint64_t execute_batch_positional(std::span<const positional_parameters> batch) override;
 	bool fetch() override;
+	/// Fetches into per-column MYSQL_BIND buffers, MySQL converts the values to the column types
+	std::size_t fetch_columns(column_batch& batch, std::size_t batch_size) override;
 
 	std::size_t field_count() override;
 	std::string field_name(std::size_t index) override;
 
 	std::uint64_t affected_rows() override;
 
+	void set_fetch_mode(fetch_mode mode) override;
+
+	const binding_plan* parameter_binding_plan() const override;
+
 	static void execute(MYSQL& connection, std::string_view query);
 
 	MYSQL_STMT& handle() const;
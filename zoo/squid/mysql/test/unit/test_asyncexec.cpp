@@ -0,0 +1,81 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include <zoo/squid/mysql/detail/asyncbackend.h>
+#include <zoo/squid/mysql/error.h>
+#include <zoo/squid/mysql/resultset.h>
+
+#include <boost/asio/bind_executor.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/strand.hpp>
+
+#include <memory>
+#include <stdexcept>
+
+#include <mysql/mysql.h>
+
+namespace zoo {
+namespace squid {
+namespace mysql {
+
+TEST(MysqlResultsetTest, EmptyResultset)
+{
+	const auto r = resultset{ nullptr, 3u };
+	EXPECT_EQ(r.affected_rows(), 3u);
+	EXPECT_EQ(r.size(), 0u);
+	EXPECT_TRUE(r.empty());
+	EXPECT_EQ(r.field_count(), 0u);
+	EXPECT_THROW(r.value(0, 0), std::out_of_range);
+	EXPECT_THROW(r.field_name(0), std::out_of_range);
+}
+
+TEST(MysqlAsyncExecTest, ClosedConnectionCompletesWithAnError)
+{
+	const auto connection = std::shared_ptr<MYSQL>{ mysql_init(nullptr), mysql_close };
+	ASSERT_NE(connection, nullptr);
+
+	auto io     = boost::asio::io_context{};
+	auto called = false;
+	auto e      = std::exception_ptr{};
+	async_backend::exec(connection, io, "SELECT 1", [&](std::exception_ptr ep, resultset result) {
+		called = true;
+		e      = ep;
+		EXPECT_TRUE(result.empty());
+	});
+
+	// The handler is posted, never called from within exec
+	EXPECT_FALSE(called);
+	io.run();
+	ASSERT_TRUE(called);
+	EXPECT_THROW(std::rethrow_exception(e), error);
+}
+
+TEST(MysqlAsyncExecTest, HandlerIsInvokedThroughItsExecutor)
+{
+	const auto connection = std::shared_ptr<MYSQL>{ mysql_init(nullptr), mysql_close };
+	ASSERT_NE(connection, nullptr);
+
+	auto io     = boost::asio::io_context{};
+	auto strand = boost::asio::make_strand(io);
+	auto called = false;
+
+	// The unique_ptr makes the handler move-only
+	auto handler = [&, move_only = std::make_unique<int>()](std::exception_ptr ep, resultset) {
+		called = true;
+		EXPECT_TRUE(ep);
+		EXPECT_TRUE(strand.running_in_this_thread());
+	};
+	async_backend::exec(connection, io, "SELECT 1", boost::asio::bind_executor(strand, std::move(handler)));
+
+	io.run();
+	EXPECT_TRUE(called);
+}
+
+} // namespace mysql
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,101 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include <zoo/squid/mysql/detail/columnarrow.h>
+#include <zoo/squid/core/error.h>
+
+#include <mysql/mysql.h>
+
+#include <cstring>
+
+namespace zoo {
+namespace squid {
+namespace mysql {
+
+namespace {
+
+std::vector<MYSQL_BIND> make_binds(std::size_t count)
+{
+	std::vector<MYSQL_BIND> binds(count);
+	for (auto& bind : binds)
+	{
+		std::memset(&bind, 0, sizeof(bind));
+	}
+	return binds;
+}
+
+std::string_view name_of(std::size_t index)
+{
+	return index == 0u ? "a" : "b";
+}
+
+} // namespace
+
+TEST(MysqlColumnarRowTest, AppendsARow)
+{
+	column_batch batch{ column_type::int64, column_type::text };
+	auto         binds  = make_binds(2u);
+	auto         values = std::vector<columnar_value>(2u);
+
+	values[0].int64       = 1;
+	values[1].text        = "abc?";
+	binds[1].length_value = 3u;
+	append_columnar_row(batch, binds, values, name_of);
+
+	binds[1].is_null_value = true;
+	values[0].int64        = 2;
+	append_columnar_row(batch, binds, values, name_of);
+
+	ASSERT_EQ(batch.rows(), 2u);
+	EXPECT_EQ(batch.column(0).int64_values(), (std::vector<std::int64_t>{ 1, 2 }));
+	ASSERT_EQ(batch.column(1).text_values().size(), 2u);
+	EXPECT_EQ(batch.column(1).text_values()[0], "abc");
+	EXPECT_FALSE(batch.column(1).nulls().is_null(0));
+	EXPECT_TRUE(batch.column(1).nulls().is_null(1));
+}
+
+TEST(MysqlColumnarRowTest, KeepsCompleteRowsOnConversionError)
+{
+	column_batch batch{ column_type::int64, column_type::int64 };
+	auto         binds  = make_binds(2u);
+	auto         values = std::vector<columnar_value>(2u);
+
+	values[0].int64 = 1;
+	values[1].int64 = 10;
+	append_columnar_row(batch, binds, values, name_of);
+
+	// The second column of the next row does not fit in an int64
+	values[0].int64      = 2;
+	binds[1].error_value = true;
+	EXPECT_THROW(append_columnar_row(batch, binds, values, name_of), error);
+
+	EXPECT_EQ(batch.rows(), 1u);
+	EXPECT_EQ(batch.column(0).int64_values(), (std::vector<std::int64_t>{ 1 }));
+	EXPECT_EQ(batch.column(1).int64_values(), (std::vector<std::int64_t>{ 10 }));
+	EXPECT_EQ(batch.column(0).nulls().size(), 1u);
+	EXPECT_EQ(batch.column(1).nulls().size(), 1u);
+}
+
+TEST(MysqlColumnarRowTest, TruncatedTextIsNotAnError)
+{
+	column_batch batch{ column_type::text };
+	auto         binds  = make_binds(1u);
+	auto         values = std::vector<columnar_value>(1u);
+
+	values[0].text        = "abc";
+	binds[0].length_value = 3u;
+	binds[0].error_value  = true;
+	append_columnar_row(batch, binds, values, name_of);
+
+	ASSERT_EQ(batch.rows(), 1u);
+	EXPECT_EQ(batch.column(0).text_values()[0], "abc");
+}
+
+} // namespace mysql
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,35 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include <zoo/squid/mysql/detail/cursor.h>
+
+#include <mysql/mysql.h>
+
+namespace zoo {
+namespace squid {
+namespace mysql {
+
+TEST(MysqlCursorTest, StreamingUsesAReadOnlyCursor)
+{
+	const auto attributes = cursor_attributes_for(fetch_mode::streaming);
+	EXPECT_EQ(attributes.cursor_type, static_cast<unsigned long>(CURSOR_TYPE_READ_ONLY));
+	ASSERT_TRUE(attributes.prefetch_rows.has_value());
+	EXPECT_EQ(attributes.prefetch_rows.value(), cursor_prefetch_rows);
+}
+
+TEST(MysqlCursorTest, BufferedUsesNoCursor)
+{
+	// A cached statement handle that streamed before must have its cursor reset
+	const auto attributes = cursor_attributes_for(fetch_mode::buffered);
+	EXPECT_EQ(attributes.cursor_type, static_cast<unsigned long>(CURSOR_TYPE_NO_CURSOR));
+	EXPECT_FALSE(attributes.prefetch_rows.has_value());
+}
+
+} // namespace mysql
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,84 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include <zoo/squid/mysql/detail/multirowinsert.h>
+
+namespace zoo {
+namespace squid {
+namespace mysql {
+
+TEST(MysqlMultiRowInsertTest, RepeatsTheRow)
+{
+	const auto insert = multi_row_insert::parse("INSERT INTO person(first_name, last_name) VALUES (?, ?)");
+	ASSERT_TRUE(insert.has_value());
+	EXPECT_EQ(insert->parameters(), 2u);
+	EXPECT_EQ(insert->query(1u), "INSERT INTO person(first_name, last_name) VALUES (?, ?)");
+	EXPECT_EQ(insert->query(3u), "INSERT INTO person(first_name, last_name) VALUES (?, ?), (?, ?), (?, ?)");
+}
+
+TEST(MysqlMultiRowInsertTest, AcceptsPlainInserts)
+{
+	EXPECT_TRUE(multi_row_insert::parse("\n\t\tinsert into t values(?)\n\t").has_value());
+	EXPECT_TRUE(multi_row_insert::parse("REPLACE INTO t VALUE (?)").has_value());
+	EXPECT_TRUE(multi_row_insert::parse("INSERT IGNORE INTO `values` (`a)`, b) VALUES (?, 'x?)', NOW(), ?)").has_value());
+	EXPECT_TRUE(multi_row_insert::parse("INSERT INTO t VALUES (CONCAT(?, 'it''s'), \"a\\\"b\")").has_value());
+}
+
+TEST(MysqlMultiRowInsertTest, RejectsOtherStatements)
+{
+	EXPECT_FALSE(multi_row_insert::parse("").has_value());
+	EXPECT_FALSE(multi_row_insert::parse("UPDATE t SET a = ?").has_value());
+	EXPECT_FALSE(multi_row_insert::parse("SELECT 'INSERT INTO t VALUES (?)'").has_value());
+	EXPECT_FALSE(multi_row_insert::parse("INSERT INTO t SET a = ?").has_value());
+	EXPECT_FALSE(multi_row_insert::parse("INSERT INTO t SELECT ? FROM dual").has_value());
+	EXPECT_FALSE(multi_row_insert::parse("(INSERT INTO t VALUES (?))").has_value());
+}
+
+TEST(MysqlMultiRowInsertTest, RejectsInsertsThatCannotBeRepeated)
+{
+	// Already several rows
+	EXPECT_FALSE(multi_row_insert::parse("INSERT INTO t VALUES (?), (?)").has_value());
+	// Parameters after the row
+	EXPECT_FALSE(multi_row_insert::parse("INSERT INTO t VALUES (?) ON DUPLICATE KEY UPDATE a = ?").has_value());
+	EXPECT_FALSE(multi_row_insert::parse("INSERT INTO t VALUES (?) ON DUPLICATE KEY UPDATE a = VALUES(a)").has_value());
+	// Parameters before the row
+	EXPECT_FALSE(multi_row_insert::parse("INSERT INTO t PARTITION (?) VALUES (?)").has_value());
+	// No parameters, every row would be the same
+	EXPECT_FALSE(multi_row_insert::parse("INSERT INTO t VALUES (1)").has_value());
+	EXPECT_FALSE(multi_row_insert::parse("INSERT INTO t VALUES ROW(?)").has_value());
+	EXPECT_FALSE(multi_row_insert::parse("INSERT INTO t VALUES (? /* comment */)").has_value());
+	EXPECT_FALSE(multi_row_insert::parse("INSERT INTO t VALUES (?) -- comment").has_value());
+	EXPECT_FALSE(multi_row_insert::parse("INSERT INTO t VALUES ('?)").has_value());
+	EXPECT_FALSE(multi_row_insert::parse("INSERT INTO t VALUES (?").has_value());
+}
+
+TEST(MysqlMultiRowInsertTest, RowsPerExecution)
+{
+	const auto insert = multi_row_insert::parse("INSERT INTO t(a, b, c, d, e) VALUES (?, ?, ?, ?, ?)");
+	ASSERT_TRUE(insert.has_value());
+
+	// Bounded by the number of placeholders
+	EXPECT_EQ(insert->rows_per_execution(100u, 1024u * 1024u * 1024u), multi_row_insert::max_parameters / 5u);
+
+	// Bounded by the size of the parameters
+	const auto packet = std::size_t{ 64 } * 1024u * 1024u;
+	const auto rows   = insert->rows_per_execution(10000u, packet);
+	EXPECT_LT(rows, packet / 10000u);
+	EXPECT_GT(rows, packet / 10000u - 10u);
+
+	// Bounded by the size of the query
+	EXPECT_LE(insert->query(insert->rows_per_execution(1u, 100000u)).size(), 100000u);
+
+	// At least one row, even when that does not fit
+	EXPECT_EQ(insert->rows_per_execution(packet, packet), 1u);
+	EXPECT_EQ(insert->rows_per_execution(1u, 10u), 1u);
+}
+
+} // namespace mysql
+} // namespace squid
+} // namespace zoo
@@ -118,6 +118,17 @@ TEST(PostgresqlQueryTest, CastingOperator)
 	}
 }
 
+TEST(PostgresqlQueryTest, BindingPlan)
+{
+	mysql_query q{ "SELECT :second, :first, :second" };
+	EXPECT_EQ(q.query(), "SELECT ?, ?, ?");
+	ASSERT_EQ(q.plan().size(), 2u);
+	EXPECT_EQ(q.plan().name(0), "second");
+	EXPECT_EQ(q.plan().name(1), "first");
+	EXPECT_EQ(q.plan_positions(0), (std::vector<size_t>{ 0u, 2u }));
+	EXPECT_EQ(q.plan_positions(1), std::vector<size_t>{ 1u });
+}
+
 } // namespace mysql
 } // namespace squid
 } // namespace zoo
@@ -24,6 +24,17 @@ std::string async_error::format() const
 	return "Unspecified error";
 }
 
+async_exception::async_exception(async_error error)
+    : squid::error{ error.format() }
+    , error_{ std::move(error) }
+{
+}
+
+const async_error& async_exception::details() const noexcept
+{
+	return this->error_;
+}
+
 } // namespace postgresql
 } // namespace squid
 } // namespace zoo
@@ -7,6 +7,9 @@
 
 #pragma once
 
+#include "zoo/squid/postgresql/config.h"
+#include "zoo/squid/core/error.h"
+
 #include <system_error>
 #include <string>
 #include <optional>
@@ -24,6 +27,18 @@ struct async_error
 	std::string format() const;
 };
 
+/// Exception that is passed to the completion token of a failed asynchronous operation
+class ZOO_SQUID_POSTGRESQL_API async_exception : public squid::error
+{
+	async_error error_;
+
+public:
+	explicit async_exception(async_error error);
+
+	/// Get the details of the error
+	const async_error& details() const noexcept;
+};
+
 } // namespace postgresql
 } // namespace squid
 } // namespace zoo
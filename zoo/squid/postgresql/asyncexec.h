@@ -7,10 +7,20 @@
 
 #pragma once
 
+#include "zoo/squid/postgresql/config.h"
 #include "zoo/squid/postgresql/asyncerror.h"
 #include "zoo/squid/postgresql/resultset.h"
+#include "zoo/squid/core/parameter.h"
 
+#include <boost/asio/any_completion_handler.hpp>
+
+#include <exception>
 #include <functional>
+#include <initializer_list>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <variant>
 
 namespace zoo {
@@ -20,6 +30,22 @@ namespace postgresql {
 using async_exec_result             = std::variant<resultset, async_error>;
 using async_exec_completion_handler = std::function<void(async_exec_result)>;
 
+/// Handler for the rows of a streaming execution.
+/// Called for every batch of rows as it is received. The resultset is only valid during the call.
+using async_rows_handler = std::function<void(const resultset&)>;
+
+/// Completion signature of the asynchronous executions that take a completion token.
+/// When the execution fails, the exception is an async_exception and the resultset is empty.
+using async_exec_signature = void(std::exception_ptr, resultset);
+
+/// Type-erased completion handler of the asynchronous executions that take a completion token.
+/// It keeps the associated executor and cancellation slot of the handler it was made from.
+using any_async_exec_handler = boost::asio::any_completion_handler<async_exec_signature>;
+
+/// Copy the named @a params of an asynchronous execution, so that they need not outlive the call that starts it
+ZOO_SQUID_POSTGRESQL_API std::map<std::string, parameter>
+make_async_parameters(std::initializer_list<std::pair<std::string_view, parameter_by_value>> params);
+
 } // namespace postgresql
 } // namespace squid
 } // namespace zoo
@@ -10,6 +10,9 @@
 #include "zoo/squid/postgresql/asyncerror.h"
 #include "zoo/squid/postgresql/asyncpreparedstatement.h"
 
+#include <boost/asio/any_completion_handler.hpp>
+
+#include <exception>
 #include <functional>
 #include <variant>
 #include <memory>
@@ -21,6 +24,14 @@ namespace postgresql {
 using async_prepare_result             = std::variant<std::shared_ptr<async_prepared_statement>, async_error>;
 using async_prepare_completion_handler = std::function<void(async_prepare_result)>;
 
+/// Completion signature of the asynchronous prepare operations that take a completion token.
+/// When the preparation fails, the exception is an async_exception and the statement is nullptr.
+using async_prepare_signature = void(std::exception_ptr, std::shared_ptr<async_prepared_statement>);
+
+/// Type-erased completion handler of the asynchronous prepare operations that take a completion token.
+/// It keeps the associated executor and cancellation slot of the handler it was made from.
+using any_async_prepare_handler = boost::asio::any_completion_handler<async_prepare_signature>;
+
 } // namespace postgresql
 } // namespace squid
 } // namespace zoo
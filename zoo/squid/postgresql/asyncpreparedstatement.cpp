@@ -1,5 +1,6 @@
 #include "zoo/squid/postgresql/asyncpreparedstatement.h"
 #include "zoo/squid/postgresql/backendconnection.h"
+#include "zoo/squid/postgresql/detail/asyncexechandler.h"
 #include "zoo/squid/postgresql/detail/query.h"
 #include "zoo/common/logging/logging.h"
 
@@ -51,6 +52,12 @@ void async_prepared_statement::async_exec(std::initializer_list<std::pair<std::s
 	this->connection_->run_async_exec_prepared(*this->io_, *this->query_, this->stmt_name_, std::move(params), std::move(handler));
 }
 
+void async_prepared_statement::initiate_exec(std::map<std::string, parameter> params, any_async_exec_handler handler)
+{
+	initiate_async_exec_prepared(
+	    this->api_, this->connection_, *this->io_, *this->query_, this->stmt_name_, std::move(params), std::move(handler));
+}
+
 } // namespace postgresql
 } // namespace squid
 } // namespace zoo
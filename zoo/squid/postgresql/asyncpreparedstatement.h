@@ -13,8 +13,10 @@
 #include "zoo/squid/postgresql/detail/queryfwd.h"
 #include "zoo/squid/core/parameter.h"
 
+#include <boost/asio/async_result.hpp>
 #include <boost/asio/io_context.hpp>
 
+#include <map>
 #include <string>
 #include <string_view>
 #include <initializer_list>
@@ -32,6 +34,8 @@ class async_prepared_statement final
 	std::unique_ptr<postgresql_query>   query_;
 	std::string                         stmt_name_;
 
+	void initiate_exec(std::map<std::string, parameter> params, any_async_exec_handler handler);
+
 public:
 	explicit async_prepared_statement(ipq_api*                            api,
 	                                  std::shared_ptr<backend_connection> connection,
@@ -46,6 +50,23 @@ public:
 	async_prepared_statement& operator=(async_prepared_statement&&);
 
 	void async_exec(std::initializer_list<std::pair<std::string_view, parameter_by_value>> params, async_exec_completion_handler handler);
+
+	/// Execute the statement asynchronously.
+	/// @a token is an Asio completion token for the signature async_exec_signature, e.g. boost::asio::use_awaitable:
+	/// @code
+	/// auto result = co_await statement->exec({ { "id", 1 } }, boost::asio::use_awaitable);
+	/// @endcode
+	/// The statement must outlive the operation.
+	template<typename CompletionToken>
+	auto exec(std::initializer_list<std::pair<std::string_view, parameter_by_value>> params, CompletionToken&& token)
+	{
+		return boost::asio::async_initiate<CompletionToken, async_exec_signature>(
+		    [this](auto handler, std::map<std::string, parameter> params) {
+			    this->initiate_exec(std::move(params), any_async_exec_handler{ std::move(handler) });
+		    },
+		    token,
+		    make_async_parameters(std::move(params)));
+	}
 };
 
 } // namespace postgresql
@@ -0,0 +1,47 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/postgresql/asynctransaction.h"
+#include "zoo/common/logging/logging.h"
+
+#include <variant>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+async_transaction::async_transaction(connection& connection, boost::asio::io_context& io)
+    : connection_{ connection }
+    , io_{ io }
+    , started_{}
+    , finished_{}
+{
+}
+
+async_transaction::~async_transaction() noexcept
+{
+	try
+	{
+		if (this->started_ && !this->finished_)
+		{
+			this->connection_.async_exec(this->io_, "ROLLBACK", {}, [](async_exec_result result) {
+				if (std::holds_alternative<async_error>(result))
+				{
+					ZOO_LOG(warn, "Rollback failed: {}", std::get<async_error>(result).format());
+				}
+			});
+		}
+	}
+	catch (const std::exception& e)
+	{
+		ZOO_LOG(warn, "{}", e.what());
+	}
+}
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,78 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/postgresql/config.h"
+#include "zoo/squid/postgresql/connection.h"
+
+#include <boost/asio/io_context.hpp>
+
+#include <utility>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+/// Asynchronous database transaction.
+/// The transaction scope can span multiple awaits in a coroutine:
+/// @code
+/// async_transaction transaction{ connection, io };
+/// co_await transaction.begin(boost::asio::use_awaitable);
+/// co_await connection.exec(io, "UPDATE account SET balance = balance - :amount WHERE id = :id", { ... }, boost::asio::use_awaitable);
+/// co_await transaction.commit(boost::asio::use_awaitable);
+/// @endcode
+/// The operations complete with the signature async_exec_signature.
+class ZOO_SQUID_POSTGRESQL_API async_transaction final
+{
+	connection&              connection_;
+	boost::asio::io_context& io_;
+	bool                     started_;
+	bool                     finished_;
+
+public:
+	explicit async_transaction(connection& connection, boost::asio::io_context& io);
+
+	/// The destructor will start an asynchronous rollback of the transaction if it was started and
+	/// neither commit() nor rollback() was called, e.g. when an exception left the coroutine.
+	/// The asynchronous operations of a connection run one at a time, so the operations that are started on the
+	/// connection after the destruction run after the rollback.
+	~async_transaction() noexcept;
+
+	async_transaction(const async_transaction&)            = delete;
+	async_transaction(async_transaction&& src)             = delete;
+	async_transaction& operator=(const async_transaction&) = delete;
+	async_transaction& operator=(async_transaction&&)      = delete;
+
+	/// Start the transaction
+	template<typename CompletionToken>
+	auto begin(CompletionToken&& token)
+	{
+		this->started_ = true;
+		return this->connection_.exec(this->io_, "BEGIN", {}, std::forward<CompletionToken>(token));
+	}
+
+	template<typename CompletionToken>
+	auto commit(CompletionToken&& token)
+	{
+		// If the commit fails, the destructor must not do a ROLLBACK,
+		// so this->finished_ is set before doing the COMMIT.
+		this->finished_ = true;
+		return this->connection_.exec(this->io_, "COMMIT", {}, std::forward<CompletionToken>(token));
+	}
+
+	template<typename CompletionToken>
+	auto rollback(CompletionToken&& token)
+	{
+		this->finished_ = true;
+		return this->connection_.exec(this->io_, "ROLLBACK", {}, std::forward<CompletionToken>(token));
+	}
+};
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
@@ -10,9 +10,12 @@
 #include "zoo/squid/postgresql/error.h"
 
 #include "zoo/squid/postgresql/detail/asyncbackend.h"
+#include "zoo/squid/postgresql/detail/asyncqueue.h"
 #include "zoo/squid/postgresql/detail/ipqapi.h"
 #include "zoo/squid/postgresql/detail/connectionchecker.h"
+#include "zoo/squid/postgresql/detail/cancelhandle.h"
 
+#include "zoo/common/logging/logging.h"
 #include "zoo/common/misc/throw_exception.h"
 
 #include <libpq-fe.h>
@@ -21,6 +24,26 @@ namespace zoo {
 namespace squid {
 namespace postgresql {
 
+namespace {
+
+std::shared_ptr<statement_name_cache> make_statement_cache(ipq_api* api, std::shared_ptr<PGconn> connection)
+{
+	// Evicted prepared statements are deallocated on the server
+	auto evict = [api, connection](std::string& stmt_name) {
+		try
+		{
+			statement::execute(api, *connection, "DEALLOCATE " + stmt_name);
+		}
+		catch (const std::exception& e)
+		{
+			ZOO_LOG(warn, "DEALLOCATE {} failed: {}", stmt_name, e.what());
+		}
+	};
+	return std::make_shared<statement_name_cache>(statement_name_cache::default_capacity, std::move(evict));
+}
+
+} // namespace
+
 std::unique_ptr<ibackend_statement> backend_connection::create_statement(std::string_view query)
 {
 	return std::make_unique<statement>(this->api_, this->connection_, query, false);
@@ -28,7 +51,7 @@ std::unique_ptr<ibackend_statement> backend_connection::create_statement(std::st
 
 std::unique_ptr<ibackend_statement> backend_connection::create_prepared_statement(std::string_view query)
 {
-	return std::make_unique<statement>(this->api_, this->connection_, query, true);
+	return std::make_unique<statement>(this->api_, this->connection_, query, true, this->statement_cache_);
 }
 
 void backend_connection::execute(const std::string& query)
@@ -36,9 +59,42 @@ void backend_connection::execute(const std::string& query)
 	statement::execute(this->api_, *connection_checker::check(this->api_, this->connection_), query);
 }
 
+statement_cache_stats backend_connection::prepared_statement_cache_stats() const
+{
+	return this->statement_cache_->stats();
+}
+
+void backend_connection::set_prepared_statement_cache_capacity(std::size_t capacity)
+{
+	this->statement_cache_->set_capacity(capacity);
+}
+
+bool backend_connection::is_valid()
+{
+	try
+	{
+		connection_checker::check(this->api_, this->connection_);
+		return true;
+	}
+	catch (const std::exception& e)
+	{
+		ZOO_LOG(warn, "connection is not valid: {}", e.what());
+		return false;
+	}
+}
+
+void backend_connection::cancel()
+{
+	// Only PQcancel here, this is called by another thread while the statement executes
+	this->cancel_->cancel();
+}
+
 backend_connection::backend_connection(ipq_api* api, std::string_view connection_info)
     : api_{ api }
-    , connection_{ api->connectdb(std::string{ connection_info }.c_str()), [api](PGconn* conn) { api->finish(conn); } }
+    , cancel_{ std::make_shared<cancel_handle>(api) }
+    , connection_{ api->connectdb(std::string{ connection_info }.c_str()), connection_deleter{ api, this->cancel_ } }
+    , statement_cache_{ make_statement_cache(api, this->connection_) }
+    , async_queue_{ std::make_shared<async_queue>() }
 {
 	if (this->connection_)
 	{
@@ -46,6 +102,7 @@ backend_connection::backend_connection(ipq_api* api, std::string_view connection
 		{
 			ZOO_THROW_EXCEPTION(error{ api, "PQconnectdb failed", *this->connection_.get() });
 		}
+		this->cancel_->refresh(*this->connection_);
 	}
 	else
 	{
@@ -61,6 +118,16 @@ void backend_connection::run_async_exec(boost::asio::io_context&
 	async_backend::exec(this->api_, shared_from_this(), io, std::move(query), std::move(params), std::move(handler));
 }
 
+void backend_connection::run_async_exec_streaming(boost::asio::io_context&                                               io,
+                                                  std::string_view                                                       query,
+                                                  std::initializer_list<std::pair<std::string_view, parameter_by_value>> params,
+                                                  async_rows_handler                                                     rows_handler,
+                                                  async_exec_completion_handler                                          handler)
+{
+	async_backend::exec_streaming(
+	    this->api_, shared_from_this(), io, std::move(query), std::move(params), std::move(rows_handler), std::move(handler));
+}
+
 void backend_connection::run_async_prepare(boost::asio::io_context& io, std::string_view query, async_prepare_completion_handler handler)
 {
 	async_backend::prepare(this->api_, shared_from_this(), io, std::move(query), std::move(handler));
@@ -80,6 +147,16 @@ std::shared_ptr<PGconn> backend_connection::native_connection() const
 	return this->connection_;
 }
 
+ipq_api* backend_connection::api() const
+{
+	return this->api_;
+}
+
+async_queue& backend_connection::async_operations() const
+{
+	return *this->async_queue_;
+}
+
 } // namespace postgresql
 } // namespace squid
 } // namespace zoo
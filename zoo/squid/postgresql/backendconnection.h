@@ -16,6 +16,7 @@
 #include "zoo/squid/postgresql/detail/queryfwd.h"
 #include "zoo/squid/postgresql/detail/asyncbackendfwd.h"
 #include "zoo/squid/core/ibackendconnection.h"
+#include "zoo/squid/core/statementcache.h"
 #include "zoo/squid/core/parameter.h"
 
 #include <boost/asio/io_context.hpp>
@@ -27,11 +28,17 @@ namespace zoo {
 namespace squid {
 namespace postgresql {
 
+class async_queue;
+class cancel_handle;
+
 class ZOO_SQUID_POSTGRESQL_API backend_connection final : public ibackend_connection,
                                                           public std::enable_shared_from_this<backend_connection>
 {
-	ipq_api*                api_;
-	std::shared_ptr<PGconn> connection_;
+	ipq_api*                                      api_;
+	std::shared_ptr<cancel_handle>                cancel_; // created on the thread that uses the connection
+	std::shared_ptr<PGconn>                       connection_;
+	std::shared_ptr<statement_cache<std::string>> statement_cache_; // names of idle prepared statements
+	std::shared_ptr<async_queue>                  async_queue_;     // the asynchronous operations, one at a time
 
 public:
 	/// @a connection_info must contain a valid PostgreSQL connection string
@@ -46,10 +53,22 @@ public:
 	std::unique_ptr<ibackend_statement> create_prepared_statement(std::string_view query) override;
 	void                                execute(const std::string& query) override;
 
+	statement_cache_stats prepared_statement_cache_stats() const override;
+	void                  set_prepared_statement_cache_capacity(std::size_t capacity) override;
+	bool                  is_valid() override;
+
+	/// Cancel the executing statement with PQcancel. This may be called from any thread.
+	void cancel() override;
+
 	void run_async_exec(boost::asio::io_context&                                               io,
 	                    std::string_view                                                       query,
 	                    std::initializer_list<std::pair<std::string_view, parameter_by_value>> params,
 	                    async_exec_completion_handler                                          handler);
+	void run_async_exec_streaming(boost::asio::io_context&                                               io,
+	                              std::string_view                                                       query,
+	                              std::initializer_list<std::pair<std::string_view, parameter_by_value>> params,
+	                              async_rows_handler                                                     rows_handler,
+	                              async_exec_completion_handler                                          handler);
 	void run_async_prepare(boost::asio::io_context& io, std::string_view query, async_prepare_completion_handler handler);
 	void run_async_exec_prepared(boost::asio::io_context&                                               io,
 	                             const postgresql_query&                                                query,
@@ -58,6 +77,10 @@ public:
 	                             async_exec_completion_handler                                          handler);
 
 	std::shared_ptr<PGconn> native_connection() const;
+	ipq_api*                api() const;
+
+	/// Get the queue of the asynchronous operations, which are run one at a time
+	async_queue& async_operations() const;
 };
 
 } // namespace postgresql
@@ -8,6 +8,8 @@
 #include "zoo/squid/postgresql/connection.h"
 #include "zoo/squid/postgresql/backendconnection.h"
 #include "zoo/squid/postgresql/backendconnectionfactory.h"
+#include "zoo/squid/postgresql/detail/asyncexechandler.h"
+#include "zoo/squid/postgresql/detail/asyncpreparehandler.h"
 
 namespace zoo {
 namespace squid {
@@ -30,6 +32,25 @@ const backend_connection& connection::backend() const
 	return *this->backend_;
 }
 
+void connection::initiate_exec(std::shared_ptr<backend_connection> backend,
+                               boost::asio::io_context&            io,
+                               std::string                         query,
+                               std::map<std::string, parameter>    params,
+                               any_async_exec_handler              handler)
+{
+	auto api = backend->api();
+	initiate_async_exec(api, std::move(backend), io, std::move(query), std::move(params), std::move(handler));
+}
+
+void connection::initiate_prepare(std::shared_ptr<backend_connection> backend,
+                                  boost::asio::io_context&            io,
+                                  std::string                         query,
+                                  any_async_prepare_handler           handler)
+{
+	auto api = backend->api();
+	initiate_async_prepare(api, std::move(backend), io, std::move(query), std::move(handler));
+}
+
 void connection::async_exec(boost::asio::io_context&                                               io,
                             std::string_view                                                       query,
                             std::initializer_list<std::pair<std::string_view, parameter_by_value>> params,
@@ -38,6 +59,15 @@ void connection::async_exec(boost::asio::io_context&
 	this->backend_->run_async_exec(io, std::move(query), std::move(params), std::move(handler));
 }
 
+void connection::async_exec_streaming(boost::asio::io_context&                                               io,
+                                      std::string_view                                                       query,
+                                      std::initializer_list<std::pair<std::string_view, parameter_by_value>> params,
+                                      async_rows_handler                                                     rows_handler,
+                                      async_exec_completion_handler                                          handler)
+{
+	this->backend_->run_async_exec_streaming(io, std::move(query), std::move(params), std::move(rows_handler), std::move(handler));
+}
+
 void connection::async_prepare(boost::asio::io_context& io, std::string_view query, async_prepare_completion_handler handler)
 {
 	this->backend_->run_async_prepare(io, std::move(query), std::move(handler));
@@ -11,12 +11,15 @@
 #include "zoo/squid/postgresql/asyncexec.h"
 #include "zoo/squid/postgresql/asyncprepare.h"
 #include "zoo/squid/postgresql/backendconnectionfwd.h"
-#include "zoo/squid/postgresql/detail/ipqapifwd.h"
 #include "zoo/squid/core/connection.h"
 #include "zoo/squid/core/parameter.h"
 
+#include <boost/asio/async_result.hpp>
 #include <boost/asio/io_context.hpp>
 
+#include <map>
+#include <memory>
+#include <string>
 #include <string_view>
 #include <initializer_list>
 #include <utility>
@@ -25,12 +28,24 @@ namespace zoo {
 namespace squid {
 namespace postgresql {
 
+class ipq_api;
+
 // Convenience class to create a connection to a PostgreSQL backend
 // This class should be used if access to the native connection handle (PGconn) is needed.
 class ZOO_SQUID_POSTGRESQL_API connection final : public squid::connection
 {
 	std::shared_ptr<backend_connection> backend_;
 
+	static void initiate_exec(std::shared_ptr<backend_connection> backend,
+	                          boost::asio::io_context&            io,
+	                          std::string                         query,
+	                          std::map<std::string, parameter>    params,
+	                          any_async_exec_handler              handler);
+	static void initiate_prepare(std::shared_ptr<backend_connection> backend,
+	                             boost::asio::io_context&            io,
+	                             std::string                         query,
+	                             any_async_prepare_handler           handler);
+
 public:
 	explicit connection(std::string_view connection_info);
 	explicit connection(ipq_api& api, std::string_view connection_info);
@@ -49,7 +64,60 @@ public:
 	                std::initializer_list<std::pair<std::string_view, parameter_by_value>> params,
 	                async_exec_completion_handler                                          handler);
 
+	/// Execute @a query asynchronously, receiving the rows in batches as they arrive.
+	/// @a rows_handler is called for every batch, @a handler is called once when the execution is complete.
+	void async_exec_streaming(boost::asio::io_context&                                               io,
+	                          std::string_view                                                       query,
+	                          std::initializer_list<std::pair<std::string_view, parameter_by_value>> params,
+	                          async_rows_handler                                                     rows_handler,
+	                          async_exec_completion_handler                                          handler);
+
 	void async_prepare(boost::asio::io_context& io, std::string_view query, async_prepare_completion_handler handler);
+
+	using squid::connection::prepare;
+
+	/// Execute @a query asynchronously.
+	/// @a token is an Asio completion token for the signature async_exec_signature, e.g. boost::asio::use_awaitable:
+	/// @code
+	/// auto result = co_await connection.exec(io, "SELECT name FROM person WHERE id = :id", { { "id", 1 } }, boost::asio::use_awaitable);
+	/// @endcode
+	/// When @a query consists of multiple statements, the operation completes with the result of the last one.
+	/// Per-operation cancellation is supported, the command is then cancelled on the server and the operation fails
+	/// with the resulting error.
+	/// The asynchronous operations of a connection run one at a time, in the order they were started.
+	template<typename CompletionToken>
+	auto exec(boost::asio::io_context&                                               io,
+	          std::string_view                                                       query,
+	          std::initializer_list<std::pair<std::string_view, parameter_by_value>> params,
+	          CompletionToken&&                                                      token)
+	{
+		return boost::asio::async_initiate<CompletionToken, async_exec_signature>(
+		    [backend = this->backend_](
+		        auto handler, boost::asio::io_context* io, std::string query, std::map<std::string, parameter> params) {
+			    initiate_exec(backend, *io, std::move(query), std::move(params), any_async_exec_handler{ std::move(handler) });
+		    },
+		    token,
+		    &io,
+		    std::string{ query },
+		    make_async_parameters(std::move(params)));
+	}
+
+	/// Prepare @a query asynchronously.
+	/// @a token is an Asio completion token for the signature async_prepare_signature, e.g. boost::asio::use_awaitable:
+	/// @code
+	/// auto statement = co_await connection.prepare(io, "SELECT name FROM person WHERE id = :id", boost::asio::use_awaitable);
+	/// @endcode
+	template<typename CompletionToken>
+	auto prepare(boost::asio::io_context& io, std::string_view query, CompletionToken&& token)
+	{
+		return boost::asio::async_initiate<CompletionToken, async_prepare_signature>(
+		    [backend = this->backend_](auto handler, boost::asio::io_context* io, std::string query) {
+			    initiate_prepare(backend, *io, std::move(query), any_async_prepare_handler{ std::move(handler) });
+		    },
+		    token,
+		    &io,
+		    std::string{ query });
+	}
 };
 
 } // namespace postgresql
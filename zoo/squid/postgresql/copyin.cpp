@@ -0,0 +1,281 @@
+//
+// Copyright (C) 2022-2024 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/postgresql/copyin.h"
+#include "zoo/squid/postgresql/connection.h"
+#include "zoo/squid/postgresql/backendconnection.h"
+#include "zoo/squid/postgresql/error.h"
+
+#include "zoo/squid/postgresql/detail/ipqapi.h"
+#include "zoo/squid/postgresql/detail/copyformat.h"
+#include "zoo/squid/postgresql/detail/queryparameters.h"
+#include "zoo/squid/postgresql/detail/connectionchecker.h"
+#include "zoo/squid/postgresql/detail/identifier.h"
+
+#include "zoo/common/conversion/conversion.h"
+#include "zoo/common/logging/logging.h"
+#include "zoo/common/misc/throw_exception.h"
+
+#include <algorithm>
+#include <optional>
+#include <string>
+#include <cassert>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+class copy_in::impl final
+{
+	ipq_api*                              api_;
+	std::shared_ptr<PGconn>               connection_;
+	std::vector<std::string>              columns_;
+	std::vector<std::optional<parameter>> values_;
+	std::size_t                           buffer_size_;
+	std::string                           buffer_;
+	std::string                           value_;
+	bool                                  active_;
+
+	void flush()
+	{
+		if (this->buffer_.empty())
+		{
+			return;
+		}
+
+		if (this->api_->putCopyData(this->connection_.get(), this->buffer_.data(), static_cast<int>(this->buffer_.length())) != 1)
+		{
+			ZOO_THROW_EXCEPTION(error{ this->api_, "PQputCopyData failed", *this->connection_ });
+		}
+
+		this->buffer_.clear();
+	}
+
+	std::uint64_t collect_result()
+	{
+		// All results are consumed before anything is thrown, so that the connection is ready for the next command
+		auto rows = std::string{};
+
+		std::optional<error> failure{};
+		while (auto res = this->api_->getResult(this->connection_.get()))
+		{
+			std::shared_ptr<PGresult> pgresult{ res, [this](PGresult* res) { this->api_->clear(res); } };
+			if (PGRES_COMMAND_OK == this->api_->resultStatus(pgresult.get()))
+			{
+				const auto num = this->api_->cmdTuples(pgresult.get());
+				if (num)
+				{
+					rows = num;
+				}
+			}
+			else if (!failure)
+			{
+				failure.emplace(this->api_, "COPY failed", *this->connection_, *pgresult);
+			}
+		}
+
+		if (failure)
+		{
+			ZOO_THROW_EXCEPTION(failure.value());
+		}
+
+		return rows.empty() ? std::uint64_t{} : conversion::string_to_number<std::uint64_t>(rows);
+	}
+
+public:
+	explicit impl(ipq_api* api, std::shared_ptr<PGconn> connection, std::string_view table, std::vector<std::string> columns, std::size_t buffer_size)
+	    : api_{ api }
+	    , connection_{ std::move(connection) }
+	    , columns_{ std::move(columns) }
+	    , values_{ this->columns_.size() }
+	    , buffer_size_{ buffer_size }
+	    , buffer_{}
+	    , value_{}
+	    , active_{}
+	{
+		assert(this->connection_);
+
+		if (this->columns_.empty())
+		{
+			ZOO_THROW_EXCEPTION(error{ "COPY requires at least one column" });
+		}
+
+		std::string query{ "COPY " };
+		query.append(quote_qualified_identifier(table)).append(" (");
+		for (const auto& column : this->columns_)
+		{
+			if (&column != &this->columns_.front())
+			{
+				query.append(", ");
+			}
+			query.append(quote_identifier(column));
+		}
+		query.append(") FROM STDIN");
+
+		ZOO_LOG(trace, "executing: {}", query);
+
+		std::shared_ptr<PGresult> pgresult{ this->api_->exec(connection_checker::check(this->api_, this->connection_), query.c_str()),
+			                                [this](PGresult* res) { this->api_->clear(res); } };
+		if (!pgresult)
+		{
+			ZOO_THROW_EXCEPTION(error{ this->api_, "PQexec failed", *this->connection_ });
+		}
+		else if (PGRES_COPY_IN != this->api_->resultStatus(pgresult.get()))
+		{
+			ZOO_THROW_EXCEPTION(error{ this->api_, "PQexec failed", *this->connection_, *pgresult });
+		}
+
+		this->buffer_.reserve(this->buffer_size_);
+		this->active_ = true;
+	}
+
+	~impl() noexcept
+	{
+		if (this->active_)
+		{
+			try
+			{
+				this->api_->putCopyEnd(this->connection_.get(), "COPY aborted by the client");
+				this->collect_result();
+			}
+			catch (...)
+			{
+				;
+			}
+		}
+	}
+
+	void upsert_parameter(std::string_view name, parameter&& value)
+	{
+		const auto it = std::find(this->columns_.begin(), this->columns_.end(), name);
+		if (it == this->columns_.end())
+		{
+			ZOO_THROW_EXCEPTION(error{ "The COPY has no column '" + std::string{ name } + "'" });
+		}
+		this->values_[static_cast<std::size_t>(it - this->columns_.begin())] = std::move(value);
+	}
+
+	void write_row()
+	{
+		if (!this->active_)
+		{
+			ZOO_THROW_EXCEPTION(error{ "Cannot write a row to a finished COPY operation" });
+		}
+
+		for (std::size_t index = 0; index < this->columns_.size(); ++index)
+		{
+			if (!this->values_[index])
+			{
+				ZOO_THROW_EXCEPTION(error{ "The COPY column '" + this->columns_[index] + "' is not bound" });
+			}
+		}
+
+		// A value that fails to convert must not leave a partial row in the buffer
+		const auto row_start = this->buffer_.length();
+		try
+		{
+			for (std::size_t index = 0; index < this->columns_.size(); ++index)
+			{
+				if (index > 0)
+				{
+					this->buffer_.push_back(copy_text_format::column_delimiter);
+				}
+
+				if (get_parameter_value(this->values_[index].value(), this->value_))
+				{
+					copy_text_format::append_value(this->buffer_, this->value_);
+				}
+				else
+				{
+					copy_text_format::append_null(this->buffer_);
+				}
+			}
+			this->buffer_.push_back(copy_text_format::row_delimiter);
+		}
+		catch (...)
+		{
+			this->buffer_.resize(row_start);
+			throw;
+		}
+
+		std::fill(this->values_.begin(), this->values_.end(), std::nullopt);
+
+		if (this->buffer_.length() >= this->buffer_size_)
+		{
+			this->flush();
+		}
+	}
+
+	std::uint64_t finish()
+	{
+		if (!this->active_)
+		{
+			ZOO_THROW_EXCEPTION(error{ "The COPY operation is already finished" });
+		}
+
+		// The operation stays active until it has ended, so that the destructor aborts it when flushing or ending it fails
+		this->flush();
+
+		if (this->api_->putCopyEnd(this->connection_.get(), nullptr) != 1)
+		{
+			ZOO_THROW_EXCEPTION(error{ this->api_, "PQputCopyEnd failed", *this->connection_ });
+		}
+
+		try
+		{
+			const auto rows = this->collect_result();
+			this->active_   = false;
+			return rows;
+		}
+		catch (...)
+		{
+			// collect_result() consumed all results, the operation has ended
+			this->active_ = false;
+			throw;
+		}
+	}
+};
+
+copy_in::copy_in(ipq_api* api, std::shared_ptr<PGconn> connection, std::string_view table, std::vector<std::string> columns, std::size_t buffer_size)
+    : pimpl_{ std::make_unique<impl>(api, std::move(connection), table, std::move(columns), buffer_size) }
+{
+}
+
+copy_in::copy_in(const connection& connection, std::string_view table, std::vector<std::string> columns, std::size_t buffer_size)
+    : copy_in{ connection.backend(), table, std::move(columns), buffer_size }
+{
+}
+
+copy_in::copy_in(const backend_connection& connection, std::string_view table, std::vector<std::string> columns, std::size_t buffer_size)
+    : copy_in{ connection.api(), connection.native_connection(), table, std::move(columns), buffer_size }
+{
+}
+
+copy_in::~copy_in() noexcept = default;
+
+copy_in::copy_in(copy_in&&) = default;
+
+copy_in& copy_in::operator=(copy_in&&) = default;
+
+void copy_in::upsert_parameter(std::string_view name, parameter&& value)
+{
+	this->pimpl_->upsert_parameter(name, std::move(value));
+}
+
+void copy_in::write_row()
+{
+	this->pimpl_->write_row();
+}
+
+std::uint64_t copy_in::finish()
+{
+	return this->pimpl_->finish();
+}
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,131 @@
+//
+// Copyright (C) 2022-2024 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/postgresql/config.h"
+#include "zoo/squid/postgresql/backendconnectionfwd.h"
+#include "zoo/squid/postgresql/detail/libpqfwd.h"
+#include "zoo/squid/postgresql/detail/ipqapifwd.h"
+#include "zoo/squid/core/parameter.h"
+#include "zoo/squid/core/detail/parameterbinder.h"
+#include "zoo/squid/core/detail/type_traits.h"
+#include "zoo/squid/core/detail/bind_oarchive.h"
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+class connection;
+
+/// Bulk loader using COPY ... FROM STDIN.
+/// Rows are encoded in the COPY text format and sent in chunks of (approximately) the configured buffer size.
+/// Values are bound by column name, with the same binding methods as a statement, and the row is
+/// encoded when write_row() is called.
+/// The connection cannot be used for anything else until finish() is called or this object is destroyed.
+/// Destroying the object without calling finish() aborts the COPY operation.
+class ZOO_SQUID_POSTGRESQL_API copy_in final
+{
+	class impl;
+	std::unique_ptr<impl> pimpl_;
+
+	void upsert_parameter(std::string_view name, parameter&& value);
+
+public:
+	static constexpr std::size_t default_buffer_size = 64 * 1024;
+
+	/// Starts COPY @a table (@a columns) FROM STDIN.
+	/// The table and column names are quoted identifiers, so they are case sensitive. The table name may be qualified
+	/// with a schema name, separated by a dot.
+	copy_in(ipq_api*                 api,
+	        std::shared_ptr<PGconn>  connection,
+	        std::string_view         table,
+	        std::vector<std::string> columns,
+	        std::size_t              buffer_size = default_buffer_size);
+	copy_in(const connection&        connection,
+	        std::string_view         table,
+	        std::vector<std::string> columns,
+	        std::size_t              buffer_size = default_buffer_size);
+	copy_in(const backend_connection& connection,
+	        std::string_view          table,
+	        std::vector<std::string>  columns,
+	        std::size_t               buffer_size = default_buffer_size);
+
+	~copy_in() noexcept;
+
+	copy_in(copy_in&&);
+	copy_in& operator=(copy_in&&);
+
+	copy_in(const copy_in&)            = delete;
+	copy_in& operator=(const copy_in&) = delete;
+
+	/// Bind the column @a name of the current row with @a value.
+	/// The value is copied. Throws an error if @a name is not one of the columns of the COPY.
+	template<typename T>
+	copy_in& bind(std::string_view name, const T& value)
+	{
+		this->upsert_parameter(name, parameter{ value, parameter::by_value{} });
+		return *this;
+	}
+
+	/// Bind the column @a name of the current row with @a value by reference.
+	/// The reference must remain valid until write_row() is called.
+	template<typename T>
+	copy_in& bind_ref(std::string_view name, const T& value)
+	{
+		this->upsert_parameter(name, parameter{ value, parameter::by_reference{} });
+		return *this;
+	}
+
+	/// Bind the columns of the current row from the members of a struct or class T @a value by reference.
+	/// The same requirements as for basic_statement::bind(const T&) apply. Every member must be a column of the COPY.
+	template<typename T>
+	copy_in& bind_ref(const T& value)
+	{
+		if constexpr (has_bind_method<T, parameter_ref_binder<copy_in>>)
+		{
+			parameter_ref_binder<copy_in> binder{ *this };
+			const_cast<T&>(value).bind(binder); // not to worry, value is not modified.
+		}
+		else if constexpr (is_boost_serializable_v<T, bind_oarchive<parameter_ref_binder<copy_in>>>)
+		{
+			bind_oarchive<parameter_ref_binder<copy_in>> ar{ *this };
+			ar << value;
+		}
+		else
+		{
+			static_assert(always_false_v<T>, "Only serializable types allowed");
+		}
+		return *this;
+	}
+
+	/// Encode the currently bound values as one row.
+	/// All columns must be bound. The bindings are cleared afterwards.
+	void write_row();
+
+	/// Bind the members of @a value and encode them as one row.
+	template<typename T>
+	void write(const T& value)
+	{
+		this->bind_ref(value);
+		this->write_row();
+	}
+
+	/// Send the remaining buffered data and complete the COPY operation.
+	/// Returns the number of rows copied.
+	std::uint64_t finish();
+};
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
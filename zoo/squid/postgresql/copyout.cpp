@@ -0,0 +1,214 @@
+//
+// Copyright (C) 2022-2024 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/postgresql/copyout.h"
+#include "zoo/squid/postgresql/connection.h"
+#include "zoo/squid/postgresql/backendconnection.h"
+#include "zoo/squid/postgresql/error.h"
+
+#include "zoo/squid/postgresql/detail/ipqapi.h"
+#include "zoo/squid/postgresql/detail/copyformat.h"
+#include "zoo/squid/postgresql/detail/queryresults.h"
+#include "zoo/squid/postgresql/detail/connectionchecker.h"
+
+#include "zoo/common/logging/logging.h"
+#include "zoo/common/misc/throw_exception.h"
+
+#include <fmt/format.h>
+
+#include <functional>
+#include <optional>
+#include <vector>
+#include <string>
+#include <cassert>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+class copy_out::impl final
+{
+	ipq_api*                 api_;
+	std::shared_ptr<PGconn>  connection_;
+	std::vector<result>      results_;
+	std::vector<std::string> result_names_;
+	copy_text_format::row    row_;
+	bool                     active_;
+
+	void collect_result()
+	{
+		std::optional<error> failure{};
+		while (auto res = this->api_->getResult(this->connection_.get()))
+		{
+			std::shared_ptr<PGresult> pgresult{ res, [this](PGresult* res) { this->api_->clear(res); } };
+			if (PGRES_COMMAND_OK != this->api_->resultStatus(pgresult.get()) && !failure)
+			{
+				failure.emplace(this->api_, "COPY failed", *this->connection_, *pgresult);
+			}
+		}
+
+		if (failure)
+		{
+			ZOO_THROW_EXCEPTION(failure.value());
+		}
+	}
+
+	// Returns false at the end of the data
+	bool receive_row()
+	{
+		char*      buffer = nullptr;
+		const auto length = this->api_->getCopyData(this->connection_.get(), &buffer, 0);
+		if (length > 0)
+		{
+			std::unique_ptr<char, std::function<void(char*)>> guard{ buffer, [this](char* p) { this->api_->freemem(p); } };
+			this->row_.parse(std::string_view{ buffer, static_cast<std::size_t>(length) });
+			return true;
+		}
+		else if (length == -1)
+		{
+			this->active_ = false;
+			this->collect_result();
+			return false;
+		}
+		else
+		{
+			this->active_ = false;
+			ZOO_THROW_EXCEPTION(error{ this->api_, "PQgetCopyData failed", *this->connection_ });
+		}
+	}
+
+public:
+	explicit impl(ipq_api* api, std::shared_ptr<PGconn> connection, std::string_view query)
+	    : api_{ api }
+	    , connection_{ std::move(connection) }
+	    , results_{}
+	    , result_names_{}
+	    , row_{}
+	    , active_{}
+	{
+		assert(this->connection_);
+
+		const auto copy_query = fmt::format("COPY ({}) TO STDOUT", query);
+
+		ZOO_LOG(trace, "executing: {}", copy_query);
+
+		std::shared_ptr<PGresult> pgresult{ this->api_->exec(connection_checker::check(this->api_, this->connection_), copy_query.c_str()),
+			                                [this](PGresult* res) { this->api_->clear(res); } };
+		if (!pgresult)
+		{
+			ZOO_THROW_EXCEPTION(error{ this->api_, "PQexec failed", *this->connection_ });
+		}
+		else if (PGRES_COPY_OUT != this->api_->resultStatus(pgresult.get()))
+		{
+			ZOO_THROW_EXCEPTION(error{ this->api_, "PQexec failed", *this->connection_, *pgresult });
+		}
+
+		this->active_ = true;
+	}
+
+	~impl() noexcept
+	{
+		try
+		{
+			while (this->active_ && this->receive_row())
+			{
+			}
+		}
+		catch (...)
+		{
+			;
+		}
+	}
+
+	void add_result(result&& result)
+	{
+		this->result_names_.push_back(std::to_string(this->results_.size() + 1));
+		this->results_.push_back(std::move(result));
+	}
+
+	bool fetch()
+	{
+		if (!this->active_ || !this->receive_row())
+		{
+			return false;
+		}
+
+		if (this->results_.size() > this->row_.size())
+		{
+			ZOO_THROW_EXCEPTION(error{ fmt::format("Cannot fetch {} columns from a row with only {} column{}",
+			                                       this->results_.size(),
+			                                       this->row_.size(),
+			                                       (this->row_.size() == 1 ? "" : "s")) });
+		}
+
+		for (std::size_t index = 0; index < this->results_.size(); ++index)
+		{
+			store_result(this->results_[index], this->result_names_[index], this->row_.value(index));
+		}
+
+		return true;
+	}
+
+	std::size_t field_count() const
+	{
+		return this->row_.size();
+	}
+
+	const char* value(std::size_t index) const
+	{
+		if (index >= this->row_.size())
+		{
+			ZOO_THROW_EXCEPTION(error{ fmt::format("Field index {} is out of range", index) });
+		}
+		return this->row_.value(index);
+	}
+};
+
+copy_out::copy_out(ipq_api* api, std::shared_ptr<PGconn> connection, std::string_view query)
+    : pimpl_{ std::make_unique<impl>(api, std::move(connection), query) }
+{
+}
+
+copy_out::copy_out(const connection& connection, std::string_view query)
+    : copy_out{ connection.backend(), query }
+{
+}
+
+copy_out::copy_out(const backend_connection& connection, std::string_view query)
+    : copy_out{ connection.api(), connection.native_connection(), query }
+{
+}
+
+copy_out::~copy_out() noexcept = default;
+
+copy_out::copy_out(copy_out&&) = default;
+
+copy_out& copy_out::operator=(copy_out&&) = default;
+
+void copy_out::add_result(result&& result)
+{
+	this->pimpl_->add_result(std::move(result));
+}
+
+bool copy_out::fetch()
+{
+	return this->pimpl_->fetch();
+}
+
+std::size_t copy_out::field_count() const
+{
+	return this->pimpl_->field_count();
+}
+
+const char* copy_out::value(std::size_t index) const
+{
+	return this->pimpl_->value(index);
+}
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,81 @@
+//
+// Copyright (C) 2022-2024 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/postgresql/config.h"
+#include "zoo/squid/postgresql/backendconnectionfwd.h"
+#include "zoo/squid/postgresql/detail/libpqfwd.h"
+#include "zoo/squid/postgresql/detail/ipqapifwd.h"
+#include "zoo/squid/core/result.h"
+
+#include <memory>
+#include <string_view>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+class connection;
+
+/// Bulk exporter using COPY (query) TO STDOUT.
+/// Rows are received one at a time in the COPY text format, so the memory use does not depend on the
+/// size of the result. Row results are bound by sequence, like basic_statement::bind_result(T&).
+/// The connection cannot be used for anything else until fetch() returns false.
+/// Destroying the object before that drains the remaining rows.
+class ZOO_SQUID_POSTGRESQL_API copy_out final
+{
+	class impl;
+	std::unique_ptr<impl> pimpl_;
+
+	void add_result(result&& result);
+
+public:
+	/// Starts COPY (@a query) TO STDOUT
+	copy_out(ipq_api* api, std::shared_ptr<PGconn> connection, std::string_view query);
+	copy_out(const connection& connection, std::string_view query);
+	copy_out(const backend_connection& connection, std::string_view query);
+
+	~copy_out() noexcept;
+
+	copy_out(copy_out&&);
+	copy_out& operator=(copy_out&&);
+
+	copy_out(const copy_out&)            = delete;
+	copy_out& operator=(const copy_out&) = delete;
+
+	/// Bind the next row result column to @a ref.
+	template<typename T>
+	copy_out& bind_result(T& ref)
+	{
+		this->add_result(result{ ref });
+		return *this;
+	}
+
+	/// Bind the next row result columns to @a refs...
+	template<class... Ts>
+	copy_out& bind_results(Ts&... refs)
+	{
+		(this->bind_result(refs), ...);
+		return *this;
+	}
+
+	/// Receive the next row and store it in the bound results.
+	/// Returns false when all rows were received.
+	bool fetch();
+
+	/// Get the number of fields in the last received row.
+	std::size_t field_count() const;
+
+	/// Get the text value of the index'th field in the last received row.
+	/// Returns a nullptr if the value is NULL.
+	const char* value(std::size_t index) const;
+};
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
@@ -6,322 +6,112 @@
 //
 
 #include "zoo/squid/postgresql/detail/asyncbackend.h"
+#include "zoo/squid/postgresql/detail/asyncoperation.h"
 #include "zoo/squid/postgresql/detail/query.h"
 #include "zoo/squid/postgresql/detail/queryparameters.h"
-#include "zoo/squid/postgresql/detail/statementname.h"
 #include "zoo/common/logging/logging.h"
 
-#include <boost/asio/bind_executor.hpp>
 #include <boost/asio/io_context.hpp>
-#include <boost/asio/io_context_strand.hpp>
-#include <boost/asio/posix/stream_descriptor.hpp>
-#include <boost/system/error_code.hpp>
 
+#include <cassert>
 #include <map>
-#include <iostream>
 
 namespace zoo {
 namespace squid {
 namespace postgresql {
 namespace {
 
-std::optional<std::string> pq_error_message(ipq_api& api, const PGconn& connection)
+class async_exec_operation final : public async_operation
 {
-	const auto msg = api.errorMessage(&connection);
-	if (msg)
-	{
-		return std::string{ msg };
-	}
-	else
-	{
-		return std::nullopt;
-	}
-}
-
-std::optional<std::string> pq_error_message(ipq_api& api, const PGresult& result, const PGconn& connection)
-{
-	const auto msg = api.resultErrorMessage(&result);
-	if (msg)
-	{
-		return std::string{ msg };
-	}
-	else
-	{
-		return pq_error_message(api, connection);
-	}
-}
-
-auto make_error_result(const std::error_code& ec)
-{
-	return async_error{ .ec = ec, .message = std::nullopt, .func = std::nullopt };
-}
-
-auto make_error_result(const boost::system::error_code& ec)
-{
-	return async_error{ .ec = std::make_error_code(static_cast<std::errc>(ec.value())), .message = std::nullopt, .func = "async_wait" };
-}
-
-auto make_error_result(ipq_api& api, std::string_view func, const PGconn& connection)
-{
-	return async_error{ .ec = std::nullopt, .message = pq_error_message(api, connection), .func = func };
-}
-
-async_exec_result make_exec_result(ipq_api& api, std::string_view func, std::shared_ptr<PGresult> result, const PGconn& connection)
-{
-	const auto status = api.resultStatus(result.get());
-
-	if (status != PGRES_COMMAND_OK && status != PGRES_TUPLES_OK)
-	{
-		return async_error{ .ec = std::nullopt, .message = pq_error_message(api, *result, connection), .func = func };
-	}
-
-	return resultset{ &api, std::move(result) };
-}
-
-template<class Derived, class CompletionHandler>
-class async_operation : public std::enable_shared_from_this<Derived>
-{
-	std::shared_ptr<async_operation> self()
-	{
-		return std::static_pointer_cast<Derived>(this->shared_from_this());
-	}
-
-	void release_stream()
-	{
-		// stream_ takes ownership of the descriptor.
-		// We need to prevent it being closed, because the PGconn object in fact owns it.
-		if (this->stream_.is_open())
-		{
-			ZOO_LOG(trace, "release fd={}", this->stream_.native_handle());
-			this->stream_.release();
-		}
-	}
+	async_exec_completion_handler handler_;
 
 public:
-	virtual ~async_operation()
-	{
-		try
-		{
-			this->release_stream();
-		}
-		catch (const std::exception& e)
-		{
-			ZOO_LOG(warn, "{}", e.what());
-		}
-	}
-
-protected:
-	ipq_api*                            api_;
-	std::shared_ptr<backend_connection> connection_;
-	boost::asio::io_context&            io_;
-	CompletionHandler                   handler_;
-	bool                                multi_result_possible_;
-
-	boost::asio::posix::stream_descriptor stream_;
-	boost::asio::io_context::strand       strand_;
-
-	bool flushed_      = false;
-	bool waiting_read  = false;
-	bool waiting_write = false;
-
-	explicit async_operation(ipq_api*                            api,
-	                         std::shared_ptr<backend_connection> connection,
-	                         boost::asio::io_context&            io,
-	                         CompletionHandler                   handler,
-	                         bool                                multi_result_possible)
-	    : api_{ api }
-	    , connection_{ std::move(connection) }
-	    , io_{ io }
+	explicit async_exec_operation(ipq_api*                            api,
+	                              std::shared_ptr<backend_connection> connection,
+	                              boost::asio::io_context&            io,
+	                              async_exec_completion_handler       handler)
+	    : async_operation{ api, std::move(connection), io, true }
 	    , handler_{ std::move(handler) }
-	    , multi_result_possible_{ multi_result_possible }
-	    , stream_{ io }
-	    , strand_{ io }
 	{
 	}
 
-	PGconn* setup_connection()
-	{
-		auto conn = this->connection_->native_connection().get();
-
-		if (this->api_->setnonblocking(conn, 1))
-		{
-			this->fail("PQsetnonblocking", *conn);
-			return nullptr;
-		}
-
-		const auto sock = this->api_->socket(conn);
-		if (sock < 0)
-		{
-			this->fail("PQsocket", *conn);
-			return nullptr;
-		}
-
-		ZOO_LOG(trace, "assign fd={}", sock);
-		this->stream_.assign(sock);
-
-		return conn;
-	}
-
-	virtual void handle_result(std::shared_ptr<PGresult> result) = 0;
-
-	void fail(std::string_view func, const PGconn& connection)
+	void handle_result(std::shared_ptr<PGresult> result) override
 	{
-		this->handler_(make_error_result(*this->api_, std::move(func), connection));
+		this->handler_(this->make_exec_result("PQsendQuery", std::move(result)));
 	}
 
-	void fail(const std::error_code& ec)
+	void handle_error(async_error error) override
 	{
-		this->handler_(make_error_result(ec));
+		this->handler_(std::move(error));
 	}
 
-	void fail(const boost::system::error_code& ec)
+	void run(std::string_view query, std::initializer_list<std::pair<std::string_view, parameter_by_value>> params)
 	{
-		this->handler_(make_error_result(ec));
+		this->start([this, query = std::string{ query }, params = make_async_parameters(std::move(params))] {
+			this->send_query(query, params);
+		});
 	}
+};
 
-	void on_read_ready(const boost::system::error_code& ec)
-	{
-		this->waiting_read = false;
-
-		if (ec)
-		{
-			return this->fail(ec);
-		}
-
-		auto conn = this->connection_->native_connection().get();
-
-		if (this->api_->consumeInput(conn) != 1)
-		{
-			return this->fail("PQconsumeInput", *conn);
-		}
-
-		if (!this->flushed_)
-		{
-			return this->flush();
-		}
-
-		for (;;)
-		{
-			if (this->api_->isBusy(conn))
-			{
-				return this->wait_read();
-			}
-
-			std::shared_ptr<PGresult> result{ this->api_->getResult(conn), [this](PGresult* res) { this->api_->clear(res); } };
-			if (result)
-			{
-				if (!this->multi_result_possible_)
-				{
-					this->release_stream();
-
-					[[maybe_unused]] const auto null = this->api_->getResult(conn);
-					assert(null == nullptr);
-				}
-
-				this->handle_result(std::move(result));
-
-				if (!this->multi_result_possible_)
-				{
-					break;
-				}
-			}
-			else
-			{
-				break;
-			}
-		}
-	}
-
-	void on_write_ready(const boost::system::error_code& ec)
-	{
-		this->waiting_write = false;
-
-		if (ec)
-		{
-			return this->fail(ec);
-		}
-
-		if (!this->flushed_)
-		{
-			return this->flush();
-		}
-	}
+class async_exec_streaming_operation final : public async_operation
+{
+	// Number of rows per PGresult in chunked rows mode
+	static constexpr int chunk_size = 256;
 
-	void wait_read()
-	{
-		if (!this->waiting_read)
-		{
-			this->stream_.async_wait(
-			    boost::asio::posix::stream_descriptor::wait_read,
-			    boost::asio::bind_executor(this->strand_, std::bind(&async_operation::on_read_ready, this->self(), std::placeholders::_1)));
-			this->waiting_read = true;
-		}
-	}
+	async_rows_handler            rows_handler_;
+	async_exec_completion_handler handler_;
 
-	void wait_write()
+public:
+	explicit async_exec_streaming_operation(ipq_api*                            api,
+	                                        std::shared_ptr<backend_connection> connection,
+	                                        boost::asio::io_context&            io,
+	                                        async_rows_handler                  rows_handler,
+	                                        async_exec_completion_handler       handler)
+	    : async_operation{ api, std::move(connection), io, true }
+	    , rows_handler_{ std::move(rows_handler) }
+	    , handler_{ std::move(handler) }
 	{
-		if (!this->waiting_write)
-		{
-			this->stream_.async_wait(
-			    boost::asio::posix::stream_descriptor::wait_write,
-			    boost::asio::bind_executor(this->strand_, std::bind(&async_operation::on_write_ready, this->self(), std::placeholders::_1)));
-			this->waiting_write = true;
-		}
 	}
 
-	void flush()
+	void handle_result(std::shared_ptr<PGresult> result) override
 	{
-		const auto rc = this->api_->flush(this->connection_->native_connection().get());
-
-		if (rc == 0)
-		{
-			this->flushed_ = true;
-			this->wait_read();
-		}
-		else if (rc == 1)
+		const auto status = this->api_->resultStatus(result.get());
+#ifdef LIBPQ_HAS_CHUNK_MODE
+		if (status == PGRES_SINGLE_TUPLE || status == PGRES_TUPLES_CHUNK)
+#else
+		if (status == PGRES_SINGLE_TUPLE)
+#endif
 		{
-			this->wait_read();
-			this->wait_write();
+			this->rows_handler_(resultset{ this->api_, std::move(result) });
 		}
 		else
 		{
-			return this->fail("PQflush", *this->connection_->native_connection());
+			this->handler_(this->make_exec_result("PQsendQuery", std::move(result)));
 		}
 	}
-};
 
-class async_exec_operation final : public async_operation<async_exec_operation, async_exec_completion_handler>
-{
-public:
-	explicit async_exec_operation(ipq_api*                            api,
-	                              std::shared_ptr<backend_connection> connection,
-	                              boost::asio::io_context&            io,
-	                              async_exec_completion_handler       handler)
-	    : async_operation{ api, std::move(connection), io, std::move(handler), true }
+	void handle_error(async_error error) override
 	{
+		this->handler_(std::move(error));
 	}
 
-	void handle_result(std::shared_ptr<PGresult> result) override
+	void run(std::string_view query, std::initializer_list<std::pair<std::string_view, parameter_by_value>> params)
 	{
-		this->handler_(make_exec_result(*this->api_, "PQsendQuery", std::move(result), *this->connection_->native_connection()));
+		this->start([this, query = std::string{ query }, params = make_async_parameters(std::move(params))] {
+			this->send(query, params);
+		});
 	}
 
-	void run(std::string_view query, std::initializer_list<std::pair<std::string_view, parameter_by_value>> params)
+	void send(std::string_view query, const std::map<std::string, parameter>& params)
 	{
-		postgresql_query query_{ std::move(query) };
-
-		std::map<std::string, parameter> params_{};
-		for (auto&& pair : params)
-		{
-			params_.insert_or_assign(std::string{ pair.first }, std::move(pair.second));
-		}
-		query_parameters query_params{ query_, params_ };
+		postgresql_query query_{ query };
+		query_parameters query_params{ query_, params };
 
 		assert(query_params.parameter_count() == query_.parameter_count());
 
 		if (auto conn = this->setup_connection())
 		{
-			ZOO_LOG(trace, "async exec: {}", query_.query());
+			ZOO_LOG(trace, "async exec streaming: {}", query_.query());
 			if (this->api_->sendQueryParams(conn,
 			                                query_.query().c_str(),
 			                                query_params.parameter_count(),
@@ -334,15 +124,26 @@ public:
 				return this->fail("PQsendQuery", *conn);
 			}
 
+#ifdef LIBPQ_HAS_CHUNK_MODE
+			if (this->api_->setChunkedRowsMode(conn, chunk_size) != 1)
+			{
+				return this->fail("PQsetChunkedRowsMode", *conn);
+			}
+#else
+			if (this->api_->setSingleRowMode(conn) != 1)
+			{
+				return this->fail("PQsetSingleRowMode", *conn);
+			}
+#endif
+
 			return this->flush();
 		}
 	}
 };
 
-class async_prepare_operation final : public async_operation<async_prepare_operation, async_prepare_completion_handler>
+class async_prepare_operation final : public async_prepare_operation_base
 {
-	std::unique_ptr<postgresql_query> query_;
-	std::string                       stmt_name_;
+	async_prepare_completion_handler handler_;
 
 public:
 	explicit async_prepare_operation(ipq_api*                            api,
@@ -350,89 +151,53 @@ public:
 	                                 boost::asio::io_context&            io,
 	                                 std::string_view                    query,
 	                                 async_prepare_completion_handler    handler)
-	    : async_operation{ api, std::move(connection), io, std::move(handler), false }
-	    , query_{ std::make_unique<postgresql_query>(std::move(query)) }
-	    , stmt_name_{ next_statement_name() }
+	    : async_prepare_operation_base{ api, std::move(connection), io, std::move(query) }
+	    , handler_{ std::move(handler) }
 	{
 	}
 
-	void handle_result(std::shared_ptr<PGresult> result) override
+	void handle_prepared(std::shared_ptr<async_prepared_statement> statement) override
 	{
-		const auto status = this->api_->resultStatus(result.get());
-
-		if (status == PGRES_COMMAND_OK)
-		{
-			return this->handler_(std::make_shared<async_prepared_statement>(
-			    this->api_, this->connection_, this->io_, std::move(this->query_), this->stmt_name_));
-		}
-		else
-		{
-			return this->handler_(async_error{ .ec      = std::nullopt,
-			                                   .message = pq_error_message(*this->api_, *result, *this->connection_->native_connection()),
-			                                   .func    = "PQsendPrepare" });
-		}
+		this->handler_(std::move(statement));
 	}
 
-	void run()
+	void handle_error(async_error error) override
 	{
-		if (auto conn = this->setup_connection())
-		{
-			ZOO_LOG(trace, "async prepare {}: {}", this->stmt_name_, query_->query());
-			if (this->api_->sendPrepare(conn, this->stmt_name_.c_str(), query_->query().c_str(), query_->parameter_count(), nullptr) != 1)
-			{
-				return this->fail("PQsendPrepare", *conn);
-			}
-
-			return this->flush();
-		}
+		this->handler_(std::move(error));
 	}
 };
 
-class async_exec_prepared_operation final : public async_operation<async_exec_prepared_operation, async_exec_completion_handler>
+class async_exec_prepared_operation final : public async_operation
 {
+	async_exec_completion_handler handler_;
+
 public:
 	explicit async_exec_prepared_operation(ipq_api*                            api,
 	                                       std::shared_ptr<backend_connection> connection,
 	                                       boost::asio::io_context&            io,
 	                                       async_exec_completion_handler       handler)
-	    : async_operation{ api, std::move(connection), io, std::move(handler), false }
+	    : async_operation{ api, std::move(connection), io, false }
+	    , handler_{ std::move(handler) }
 	{
 	}
 
 	void handle_result(std::shared_ptr<PGresult> result) override
 	{
-		this->handler_(make_exec_result(*this->api_, "sendQueryPrepared", std::move(result), *this->connection_->native_connection()));
+		this->handler_(this->make_exec_result("sendQueryPrepared", std::move(result)));
+	}
+
+	void handle_error(async_error error) override
+	{
+		this->handler_(std::move(error));
 	}
 
 	void run(const postgresql_query&                                                query,
 	         std::string_view                                                       stmt_name,
 	         std::initializer_list<std::pair<std::string_view, parameter_by_value>> params)
 	{
-		std::map<std::string, parameter> params_{};
-		for (auto&& pair : params)
-		{
-			params_.insert_or_assign(std::string{ pair.first }, std::move(pair.second));
-		}
-		query_parameters query_params{ query, params_ };
-
-		assert(query_params.parameter_count() == query.parameter_count());
-
-		if (auto conn = this->setup_connection())
-		{
-			ZOO_LOG(trace, "async exec prepared {}", stmt_name);
-			if (this->api_->sendQueryPrepared(conn,
-			                                  std::string{ stmt_name }.c_str(),
-			                                  query_params.parameter_count(),
-			                                  query_params.parameter_values(),
-			                                  nullptr,
-			                                  nullptr,
-			                                  0) != 1)
-			{
-				return this->fail("sendQueryPrepared", *conn);
-			}
-
-			return this->flush();
-		}
+		this->start([this, &query, stmt_name = std::string{ stmt_name }, params = make_async_parameters(std::move(params))] {
+			this->send_query_prepared(query, stmt_name, params);
+		});
 	}
 };
 
@@ -449,6 +214,18 @@ void async_backend::exec(ipq_api*
 	    ->run(std::move(query), std::move(params));
 }
 
+void async_backend::exec_streaming(ipq_api*                                                               api,
+                                   std::shared_ptr<backend_connection>                                    connection,
+                                   boost::asio::io_context&                                               io,
+                                   std::string_view                                                       query,
+                                   std::initializer_list<std::pair<std::string_view, parameter_by_value>> params,
+                                   async_rows_handler                                                     rows_handler,
+                                   async_exec_completion_handler                                          handler)
+{
+	return std::make_shared<async_exec_streaming_operation>(api, std::move(connection), io, std::move(rows_handler), std::move(handler))
+	    ->run(std::move(query), std::move(params));
+}
+
 void async_backend::prepare(ipq_api*                            api,
                             std::shared_ptr<backend_connection> connection,
                             boost::asio::io_context&            io,
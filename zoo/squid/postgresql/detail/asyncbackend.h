@@ -36,6 +36,16 @@ public:
 	                 std::initializer_list<std::pair<std::string_view, parameter_by_value>> params,
 	                 async_exec_completion_handler                                          handler);
 
+	/// Like exec(), but the rows are received in single row (or chunked) mode and passed to @a rows_handler
+	/// as they arrive. @a handler is called once, with the final (empty) resultset or an error.
+	static void exec_streaming(ipq_api*                                                               api,
+	                           std::shared_ptr<backend_connection>                                    connection,
+	                           boost::asio::io_context&                                               io,
+	                           std::string_view                                                       query,
+	                           std::initializer_list<std::pair<std::string_view, parameter_by_value>> params,
+	                           async_rows_handler                                                     rows_handler,
+	                           async_exec_completion_handler                                          handler);
+
 	static void prepare(ipq_api*                            api,
 	                    std::shared_ptr<backend_connection> connection,
 	                    boost::asio::io_context&            io,
@@ -0,0 +1,196 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/postgresql/asyncerror.h"
+#include "zoo/squid/postgresql/asyncexec.h"
+#include "zoo/squid/postgresql/resultset.h"
+#include "zoo/squid/postgresql/detail/asyncoperation.h"
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/associated_cancellation_slot.hpp>
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/prefer.hpp>
+
+#include <exception>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+/// Asynchronous execution of a query or a prepared statement that completes a handler with the signature
+/// async_exec_signature.
+/// The handler is stored as is, without type erasure, and is invoked exactly once through its associated executor.
+/// When a query consists of multiple statements, the handler receives the result of the last one, or the first error.
+/// Per-operation cancellation is supported, the command is then cancelled on the server and the operation fails
+/// with the resulting error.
+template<typename Handler>
+class async_exec_handler_operation final : public async_operation
+{
+	Handler                        handler_;
+	boost::asio::any_io_executor   executor_;
+	boost::asio::cancellation_slot slot_;
+	std::optional<resultset>       result_;
+	std::optional<async_error>     error_;
+	bool                           completed_;
+
+	void complete()
+	{
+		if (this->completed_)
+		{
+			return;
+		}
+		this->completed_ = true;
+		if (this->slot_.is_connected())
+		{
+			this->slot_.clear();
+		}
+
+		auto e      = this->error_ ? std::make_exception_ptr(async_exception{ std::move(this->error_).value() }) : std::exception_ptr{};
+		auto result = this->result_ && !e ? std::move(this->result_).value() : resultset{};
+
+		boost::asio::post(this->executor_, [handler = std::move(this->handler_), e = std::move(e), result = std::move(result)]() mutable {
+			std::move(handler)(std::move(e), std::move(result));
+		});
+	}
+
+	void handle_result(std::shared_ptr<PGresult> result) override
+	{
+		if (!this->error_)
+		{
+			auto exec_result = this->make_exec_result(this->multi_result_possible_ ? "PQsendQuery" : "sendQueryPrepared", std::move(result));
+			if (auto error = std::get_if<async_error>(&exec_result))
+			{
+				this->error_ = std::move(*error);
+			}
+			else
+			{
+				this->result_ = std::move(std::get<resultset>(exec_result));
+			}
+		}
+
+		if (!this->multi_result_possible_)
+		{
+			this->complete();
+		}
+	}
+
+	void handle_error(async_error error) override
+	{
+		if (!this->error_)
+		{
+			this->error_ = std::move(error);
+		}
+		this->complete();
+	}
+
+	void handle_end() override
+	{
+		this->complete();
+	}
+
+public:
+	/// @a multi_result_possible must be true for a query and false for a prepared statement
+	explicit async_exec_handler_operation(ipq_api*                            api,
+	                                      std::shared_ptr<backend_connection> connection,
+	                                      boost::asio::io_context&            io,
+	                                      Handler                             handler,
+	                                      bool                                multi_result_possible)
+	    : async_operation{ api, std::move(connection), io, multi_result_possible }
+	    , handler_{ std::move(handler) }
+	    , executor_{ boost::asio::prefer(boost::asio::get_associated_executor(this->handler_, io.get_executor()),
+	                                     boost::asio::execution::outstanding_work.tracked) }
+	    , slot_{ boost::asio::get_associated_cancellation_slot(this->handler_) }
+	    , result_{}
+	    , error_{}
+	    , completed_{}
+	{
+	}
+
+	void run(std::string query, std::map<std::string, parameter> params)
+	{
+		this->cancel_on(this->slot_);
+		this->start([this, query = std::move(query), params = std::move(params)] { this->send_query(query, params); });
+	}
+
+	void run(const postgresql_query& query, std::string_view stmt_name, std::map<std::string, parameter> params)
+	{
+		this->cancel_on(this->slot_);
+		this->start([this, &query, stmt_name = std::string{ stmt_name }, params = std::move(params)] {
+			this->send_query_prepared(query, stmt_name, params);
+		});
+	}
+};
+
+/// Start the execution of @a query with @a params on @a connection, completing @a token.
+/// The operation owns @a query, so that an initiation that is deferred by the completion token can outlive the caller's buffer.
+template<typename CompletionToken>
+auto initiate_async_exec(ipq_api*                            api,
+                         std::shared_ptr<backend_connection> connection,
+                         boost::asio::io_context&            io,
+                         std::string                         query,
+                         std::map<std::string, parameter>    params,
+                         CompletionToken&&                   token)
+{
+	return boost::asio::async_initiate<CompletionToken, async_exec_signature>(
+	    [api](auto                                handler,
+	          std::shared_ptr<backend_connection> connection,
+	          boost::asio::io_context*            io,
+	          std::string                         query,
+	          std::map<std::string, parameter>    params) {
+		    std::make_shared<async_exec_handler_operation<decltype(handler)>>(api, std::move(connection), *io, std::move(handler), true)
+		        ->run(std::move(query), std::move(params));
+	    },
+	    token,
+	    std::move(connection),
+	    &io,
+	    std::move(query),
+	    std::move(params));
+}
+
+/// Start the execution of the prepared statement @a stmt_name of @a query with @a params on @a connection,
+/// completing @a token.
+/// @a query must stay valid until the operation completes.
+template<typename CompletionToken>
+auto initiate_async_exec_prepared(ipq_api*                            api,
+                                  std::shared_ptr<backend_connection> connection,
+                                  boost::asio::io_context&            io,
+                                  const postgresql_query&             query,
+                                  std::string                         stmt_name,
+                                  std::map<std::string, parameter>    params,
+                                  CompletionToken&&                   token)
+{
+	return boost::asio::async_initiate<CompletionToken, async_exec_signature>(
+	    [api, &query](auto                                handler,
+	                  std::shared_ptr<backend_connection> connection,
+	                  boost::asio::io_context*            io,
+	                  const std::string&                  stmt_name,
+	                  std::map<std::string, parameter>    params) {
+		    std::make_shared<async_exec_handler_operation<decltype(handler)>>(api, std::move(connection), *io, std::move(handler), false)
+		        ->run(query, stmt_name, std::move(params));
+	    },
+	    token,
+	    std::move(connection),
+	    &io,
+	    std::move(stmt_name),
+	    std::move(params));
+}
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,436 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/postgresql/detail/asyncoperation.h"
+#include "zoo/squid/postgresql/detail/asyncqueue.h"
+#include "zoo/squid/postgresql/detail/ipqapi.h"
+#include "zoo/squid/postgresql/detail/query.h"
+#include "zoo/squid/postgresql/detail/queryparameters.h"
+#include "zoo/squid/postgresql/detail/statementname.h"
+#include "zoo/squid/postgresql/asyncpreparedstatement.h"
+#include "zoo/squid/postgresql/backendconnection.h"
+#include "zoo/squid/postgresql/resultset.h"
+#include "zoo/common/logging/logging.h"
+
+#include <boost/asio/bind_executor.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+
+#include <cassert>
+#include <functional>
+#include <map>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+namespace {
+
+std::optional<std::string> pq_error_message(ipq_api& api, const PGconn& connection)
+{
+	const auto msg = api.errorMessage(&connection);
+	if (msg)
+	{
+		return std::string{ msg };
+	}
+	else
+	{
+		return std::nullopt;
+	}
+}
+
+// PQcancel blocks while it connects to the server, so it runs on this thread instead of the one that emits the
+// cancellation slot, which is usually an io_context thread.
+boost::asio::thread_pool& cancel_pool()
+{
+	static boost::asio::thread_pool pool{ 1 };
+	return pool;
+}
+
+} // namespace
+
+async_operation::async_operation(ipq_api*                            api,
+                                 std::shared_ptr<backend_connection> connection,
+                                 boost::asio::io_context&            io,
+                                 bool                                multi_result_possible)
+    : api_{ api }
+    , connection_{ std::move(connection) }
+    , io_{ io }
+    , multi_result_possible_{ multi_result_possible }
+    , stream_{ io }
+    , strand_{ io }
+{
+}
+
+async_operation::~async_operation()
+{
+	try
+	{
+		this->release_stream();
+		if (this->queued_)
+		{
+			this->connection_->async_operations().pop();
+		}
+	}
+	catch (const std::exception& e)
+	{
+		ZOO_LOG(warn, "{}", e.what());
+	}
+}
+
+void async_operation::release_stream()
+{
+	// stream_ takes ownership of the descriptor.
+	// We need to prevent it being closed, because the PGconn object in fact owns it.
+	if (this->stream_.is_open())
+	{
+		ZOO_LOG(trace, "release fd={}", this->stream_.native_handle());
+		this->stream_.release();
+	}
+}
+
+void async_operation::start(std::function<void()> send)
+{
+	this->queued_ = true;
+	this->connection_->async_operations().push(this->io_, [self = this->shared_from_this(), send = std::move(send)] {
+		auto expected = send_state::queued;
+		if (self->send_state_.compare_exchange_strong(expected, send_state::sent))
+		{
+			send();
+		}
+		else
+		{
+			self->fail(std::make_error_code(std::errc::operation_canceled));
+		}
+	});
+}
+
+void async_operation::cancel_on(boost::asio::cancellation_slot slot)
+{
+	if (slot.is_connected())
+	{
+		// A command that is still queued is not sent, PQcancel would cancel the command of another operation
+		slot.assign([operation = this->weak_from_this()](boost::asio::cancellation_type) {
+			if (auto self = operation.lock())
+			{
+				auto expected = send_state::queued;
+				if (self->send_state_.compare_exchange_strong(expected, send_state::cancelled))
+				{
+					return;
+				}
+
+				// The operation is kept alive until PQcancel returns, so that the next operation of the connection,
+				// which starts when this one is destroyed, cannot be hit by it. The io_context has work until then.
+				auto work = boost::asio::make_work_guard(self->io_);
+				boost::asio::post(cancel_pool(), [self = std::move(self), work = std::move(work)]() mutable {
+					try
+					{
+						self->connection_->cancel();
+					}
+					catch (const std::exception& e)
+					{
+						ZOO_LOG(warn, "cannot cancel an asynchronous operation: {}", e.what());
+					}
+					self.reset();
+					work.reset();
+				});
+			}
+		});
+	}
+}
+
+void async_operation::handle_end()
+{
+}
+
+PGconn* async_operation::setup_connection()
+{
+	auto conn = this->connection_->native_connection().get();
+
+	if (this->api_->setnonblocking(conn, 1))
+	{
+		this->fail("PQsetnonblocking", *conn);
+		return nullptr;
+	}
+
+	const auto sock = this->api_->socket(conn);
+	if (sock < 0)
+	{
+		this->fail("PQsocket", *conn);
+		return nullptr;
+	}
+
+	ZOO_LOG(trace, "assign fd={}", sock);
+	this->stream_.assign(sock);
+
+	return conn;
+}
+
+void async_operation::fail(std::string_view func, const PGconn& connection)
+{
+	this->handle_error(async_error{ .ec = std::nullopt, .message = pq_error_message(*this->api_, connection), .func = func });
+}
+
+void async_operation::fail(const std::error_code& ec)
+{
+	this->handle_error(async_error{ .ec = ec, .message = std::nullopt, .func = std::nullopt });
+}
+
+void async_operation::fail(const boost::system::error_code& ec)
+{
+	this->handle_error(
+	    async_error{ .ec = std::make_error_code(static_cast<std::errc>(ec.value())), .message = std::nullopt, .func = "async_wait" });
+}
+
+void async_operation::on_read_ready(const boost::system::error_code& ec)
+{
+	this->waiting_read = false;
+
+	if (ec)
+	{
+		return this->fail(ec);
+	}
+
+	auto conn = this->connection_->native_connection().get();
+
+	if (this->api_->consumeInput(conn) != 1)
+	{
+		return this->fail("PQconsumeInput", *conn);
+	}
+
+	if (!this->flushed_)
+	{
+		return this->flush();
+	}
+
+	for (;;)
+	{
+		if (this->api_->isBusy(conn))
+		{
+			return this->wait_read();
+		}
+
+		std::shared_ptr<PGresult> result{ this->api_->getResult(conn), [this](PGresult* res) { this->api_->clear(res); } };
+		if (result)
+		{
+			if (!this->multi_result_possible_)
+			{
+				this->release_stream();
+
+				[[maybe_unused]] const auto null = this->api_->getResult(conn);
+				assert(null == nullptr);
+			}
+
+			this->handle_result(std::move(result));
+
+			if (!this->multi_result_possible_)
+			{
+				break;
+			}
+		}
+		else
+		{
+			this->handle_end();
+			break;
+		}
+	}
+}
+
+void async_operation::on_write_ready(const boost::system::error_code& ec)
+{
+	this->waiting_write = false;
+
+	if (ec)
+	{
+		return this->fail(ec);
+	}
+
+	if (!this->flushed_)
+	{
+		return this->flush();
+	}
+}
+
+void async_operation::wait_read()
+{
+	if (!this->waiting_read)
+	{
+		this->stream_.async_wait(
+		    boost::asio::posix::stream_descriptor::wait_read,
+		    boost::asio::bind_executor(this->strand_, std::bind(&async_operation::on_read_ready, this->shared_from_this(), std::placeholders::_1)));
+		this->waiting_read = true;
+	}
+}
+
+void async_operation::wait_write()
+{
+	if (!this->waiting_write)
+	{
+		this->stream_.async_wait(
+		    boost::asio::posix::stream_descriptor::wait_write,
+		    boost::asio::bind_executor(this->strand_, std::bind(&async_operation::on_write_ready, this->shared_from_this(), std::placeholders::_1)));
+		this->waiting_write = true;
+	}
+}
+
+void async_operation::flush()
+{
+	const auto rc = this->api_->flush(this->connection_->native_connection().get());
+
+	if (rc == 0)
+	{
+		this->flushed_ = true;
+		this->wait_read();
+	}
+	else if (rc == 1)
+	{
+		this->wait_read();
+		this->wait_write();
+	}
+	else
+	{
+		return this->fail("PQflush", *this->connection_->native_connection());
+	}
+}
+
+void async_operation::send_query(std::string_view query_text, const std::map<std::string, parameter>& params)
+{
+	const auto       translated = postgresql_query::cached(query_text);
+	const auto&      query      = *translated;
+	query_parameters query_params{ query, params };
+
+	assert(query_params.parameter_count() == query.parameter_count());
+
+	if (auto conn = this->setup_connection())
+	{
+		ZOO_LOG(trace, "async exec: {}", query.query());
+		if (this->api_->sendQueryParams(conn,
+		                                query.query().c_str(),
+		                                query_params.parameter_count(),
+		                                nullptr,
+		                                query_params.parameter_values(),
+		                                nullptr,
+		                                nullptr,
+		                                0) != 1)
+		{
+			return this->fail("PQsendQuery", *conn);
+		}
+
+		return this->flush();
+	}
+}
+
+void async_operation::send_prepare(const postgresql_query& query, const std::string& stmt_name)
+{
+	if (auto conn = this->setup_connection())
+	{
+		ZOO_LOG(trace, "async prepare {}: {}", stmt_name, query.query());
+		if (this->api_->sendPrepare(conn, stmt_name.c_str(), query.query().c_str(), query.parameter_count(), nullptr) != 1)
+		{
+			return this->fail("PQsendPrepare", *conn);
+		}
+
+		return this->flush();
+	}
+}
+
+void async_operation::send_query_prepared(const postgresql_query&                 query,
+                                          std::string_view                        stmt_name,
+                                          const std::map<std::string, parameter>& params)
+{
+	query_parameters query_params{ query, params };
+
+	assert(query_params.parameter_count() == query.parameter_count());
+
+	if (auto conn = this->setup_connection())
+	{
+		ZOO_LOG(trace, "async exec prepared {}", stmt_name);
+		if (this->api_->sendQueryPrepared(conn,
+		                                  std::string{ stmt_name }.c_str(),
+		                                  query_params.parameter_count(),
+		                                  query_params.parameter_values(),
+		                                  nullptr,
+		                                  nullptr,
+		                                  0) != 1)
+		{
+			return this->fail("sendQueryPrepared", *conn);
+		}
+
+		return this->flush();
+	}
+}
+
+async_exec_result async_operation::make_exec_result(std::string_view func, std::shared_ptr<PGresult> result) const
+{
+	const auto status = this->api_->resultStatus(result.get());
+
+	if (status != PGRES_COMMAND_OK && status != PGRES_TUPLES_OK)
+	{
+		return async_error{ .ec = std::nullopt, .message = this->error_message(*result), .func = func };
+	}
+
+	return resultset{ this->api_, std::move(result) };
+}
+
+std::optional<std::string> async_operation::error_message(const PGresult& result) const
+{
+	const auto msg = this->api_->resultErrorMessage(&result);
+	if (msg)
+	{
+		return std::string{ msg };
+	}
+	else
+	{
+		return pq_error_message(*this->api_, *this->connection_->native_connection());
+	}
+}
+
+std::map<std::string, parameter> make_async_parameters(std::initializer_list<std::pair<std::string_view, parameter_by_value>> params)
+{
+	std::map<std::string, parameter> result{};
+	for (auto&& pair : params)
+	{
+		result.insert_or_assign(std::string{ pair.first }, std::move(pair.second));
+	}
+	return result;
+}
+
+async_prepare_operation_base::async_prepare_operation_base(ipq_api*                            api,
+                                                           std::shared_ptr<backend_connection> connection,
+                                                           boost::asio::io_context&            io,
+                                                           std::string_view                    query)
+    : async_operation{ api, std::move(connection), io, false }
+    , query_{ std::make_unique<postgresql_query>(query) }
+    , stmt_name_{ next_statement_name() }
+{
+}
+
+async_prepare_operation_base::~async_prepare_operation_base() = default;
+
+void async_prepare_operation_base::handle_result(std::shared_ptr<PGresult> result)
+{
+	const auto status = this->api_->resultStatus(result.get());
+
+	if (status == PGRES_COMMAND_OK)
+	{
+		this->handle_prepared(
+		    std::make_shared<async_prepared_statement>(this->api_, this->connection_, this->io_, std::move(this->query_), this->stmt_name_));
+	}
+	else
+	{
+		this->handle_error(async_error{ .ec = std::nullopt, .message = this->error_message(*result), .func = "PQsendPrepare" });
+	}
+}
+
+void async_prepare_operation_base::run()
+{
+	this->start([this] { this->send_prepare(*this->query_, this->stmt_name_); });
+}
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,168 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/postgresql/config.h"
+#include "zoo/squid/postgresql/asyncerror.h"
+#include "zoo/squid/postgresql/asyncexec.h"
+#include "zoo/squid/postgresql/backendconnectionfwd.h"
+#include "zoo/squid/postgresql/detail/ipqapifwd.h"
+#include "zoo/squid/postgresql/detail/libpqfwd.h"
+#include "zoo/squid/postgresql/detail/queryfwd.h"
+#include "zoo/squid/core/parameter.h"
+
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/io_context_strand.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <atomic>
+#include <functional>
+#include <initializer_list>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+class async_prepared_statement;
+
+/// Base class of the asynchronous operations on a backend connection.
+/// A derived class sends a command with one of the send_ functions, after which the results are passed to
+/// handle_result() as they arrive. Exactly one of handle_error() and handle_end() is called last, unless
+/// the operation expects a single result, in which case handle_result() may be the last one.
+/// Operations must be created with std::make_shared, they keep themselves alive while they are waiting.
+/// The operations of a connection run one at a time, a derived class sends its command from the function that it
+/// passes to start().
+class ZOO_SQUID_POSTGRESQL_API async_operation : public std::enable_shared_from_this<async_operation>
+{
+	enum class send_state
+	{
+		queued,   //!< waiting for the operations that were started before on the connection
+		sent,     //!< the command was sent
+		cancelled //!< cancelled before the command was sent
+	};
+
+	bool                    queued_ = false;
+	std::atomic<send_state> send_state_{ send_state::queued };
+
+	void release_stream();
+	void on_read_ready(const boost::system::error_code& ec);
+	void on_write_ready(const boost::system::error_code& ec);
+	void wait_read();
+	void wait_write();
+
+public:
+	virtual ~async_operation();
+
+	async_operation(const async_operation&)            = delete;
+	async_operation(async_operation&&)                 = delete;
+	async_operation& operator=(const async_operation&) = delete;
+	async_operation& operator=(async_operation&&)      = delete;
+
+protected:
+	ipq_api*                            api_;
+	std::shared_ptr<backend_connection> connection_;
+	boost::asio::io_context&            io_;
+	bool                                multi_result_possible_;
+
+	boost::asio::posix::stream_descriptor stream_;
+	boost::asio::io_context::strand       strand_;
+
+	bool flushed_      = false;
+	bool waiting_read  = false;
+	bool waiting_write = false;
+
+	explicit async_operation(ipq_api*                            api,
+	                         std::shared_ptr<backend_connection> connection,
+	                         boost::asio::io_context&            io,
+	                         bool                                multi_result_possible);
+
+	/// Called for every result that is received
+	virtual void handle_result(std::shared_ptr<PGresult> result) = 0;
+
+	/// Called when the operation failed
+	virtual void handle_error(async_error error) = 0;
+
+	/// Called after the last result of an operation that may have multiple results
+	virtual void handle_end();
+
+	/// Call @a send, which sends the command, when the operations that were started before on the connection have
+	/// finished. The connection is then used by this operation until it is destroyed.
+	void start(std::function<void()> send);
+
+	/// Make the connection non-blocking and watch its socket.
+	/// Returns the native connection, or nullptr after calling handle_error().
+	PGconn* setup_connection();
+
+	/// Send the command and start waiting for the results
+	void flush();
+
+	/// Cancel the command on the server, with backend_connection::cancel(), when @a slot is emitted.
+	/// The cancel request blocks while it connects to the server, so it is sent from a separate thread, not from the
+	/// thread that emits @a slot. The next operation of the connection waits until it has been sent.
+	/// The operation then fails with the error of the cancelled command, or with std::errc::operation_canceled when
+	/// the command was not sent yet.
+	/// The slot must be cleared before the operation completes.
+	void cancel_on(boost::asio::cancellation_slot slot);
+
+	void fail(std::string_view func, const PGconn& connection);
+	void fail(const std::error_code& ec);
+	void fail(const boost::system::error_code& ec);
+
+	/// Send @a query with @a params.
+	/// The translation of @a query is taken from the translated query cache.
+	void send_query(std::string_view query, const std::map<std::string, parameter>& params);
+
+	/// Prepare @a query as @a stmt_name
+	void send_prepare(const postgresql_query& query, const std::string& stmt_name);
+
+	/// Execute the prepared statement @a stmt_name of @a query with @a params
+	void send_query_prepared(const postgresql_query& query, std::string_view stmt_name, const std::map<std::string, parameter>& params);
+
+	/// Convert the result of a command to a resultset, or to an error if the command failed
+	async_exec_result make_exec_result(std::string_view func, std::shared_ptr<PGresult> result) const;
+
+	/// Get the error message of the failed command that produced @a result
+	std::optional<std::string> error_message(const PGresult& result) const;
+};
+
+/// Base class of the operations that prepare a statement.
+/// The result is passed to handle_prepared(), or to handle_error() if the statement could not be prepared.
+class ZOO_SQUID_POSTGRESQL_API async_prepare_operation_base : public async_operation
+{
+	std::unique_ptr<postgresql_query> query_;
+	std::string                       stmt_name_;
+
+	void handle_result(std::shared_ptr<PGresult> result) final;
+
+protected:
+	explicit async_prepare_operation_base(ipq_api*                            api,
+	                                      std::shared_ptr<backend_connection> connection,
+	                                      boost::asio::io_context&            io,
+	                                      std::string_view                    query);
+
+	/// Called with the statement when it is prepared
+	virtual void handle_prepared(std::shared_ptr<async_prepared_statement> statement) = 0;
+
+public:
+	~async_prepare_operation_base() override;
+
+	void run();
+};
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
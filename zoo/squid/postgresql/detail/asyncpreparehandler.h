@@ -0,0 +1,92 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/postgresql/asyncerror.h"
+#include "zoo/squid/postgresql/asyncprepare.h"
+#include "zoo/squid/postgresql/detail/asyncoperation.h"
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/prefer.hpp>
+
+#include <exception>
+#include <memory>
+#include <string_view>
+#include <utility>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+/// Asynchronous preparation of a statement that completes a handler with the signature async_prepare_signature.
+/// The handler is stored as is, without type erasure, and is invoked exactly once through its associated executor.
+template<typename Handler>
+class async_prepare_handler_operation final : public async_prepare_operation_base
+{
+	Handler                      handler_;
+	boost::asio::any_io_executor executor_;
+
+	void complete(std::exception_ptr e, std::shared_ptr<async_prepared_statement> statement)
+	{
+		boost::asio::post(this->executor_,
+		                  [handler = std::move(this->handler_), e = std::move(e), statement = std::move(statement)]() mutable {
+			                  std::move(handler)(std::move(e), std::move(statement));
+		                  });
+	}
+
+	void handle_prepared(std::shared_ptr<async_prepared_statement> statement) override
+	{
+		this->complete(nullptr, std::move(statement));
+	}
+
+	void handle_error(async_error error) override
+	{
+		this->complete(std::make_exception_ptr(async_exception{ std::move(error) }), nullptr);
+	}
+
+public:
+	explicit async_prepare_handler_operation(ipq_api*                            api,
+	                                         std::shared_ptr<backend_connection> connection,
+	                                         boost::asio::io_context&            io,
+	                                         std::string_view                    query,
+	                                         Handler                             handler)
+	    : async_prepare_operation_base{ api, std::move(connection), io, query }
+	    , handler_{ std::move(handler) }
+	    , executor_{ boost::asio::prefer(boost::asio::get_associated_executor(this->handler_, io.get_executor()),
+	                                     boost::asio::execution::outstanding_work.tracked) }
+	{
+	}
+};
+
+/// Start the preparation of @a query on @a connection, completing @a token.
+/// The operation owns @a query, so that an initiation that is deferred by the completion token can outlive the caller's buffer.
+template<typename CompletionToken>
+auto initiate_async_prepare(ipq_api*                            api,
+                            std::shared_ptr<backend_connection> connection,
+                            boost::asio::io_context&            io,
+                            std::string                         query,
+                            CompletionToken&&                   token)
+{
+	return boost::asio::async_initiate<CompletionToken, async_prepare_signature>(
+	    [api](auto handler, std::shared_ptr<backend_connection> connection, boost::asio::io_context* io, const std::string& query) {
+		    std::make_shared<async_prepare_handler_operation<decltype(handler)>>(api, std::move(connection), *io, query, std::move(handler))
+		        ->run();
+	    },
+	    token,
+	    std::move(connection),
+	    &io,
+	    std::move(query));
+}
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,55 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/postgresql/detail/asyncqueue.h"
+
+#include <boost/asio/post.hpp>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+async_queue::async_queue()
+    : mutex_{}
+    , busy_{}
+    , pending_{}
+{
+}
+
+void async_queue::push(boost::asio::io_context& io, std::function<void()> start)
+{
+	{
+		std::lock_guard lock{ this->mutex_ };
+		if (this->busy_)
+		{
+			this->pending_.emplace_back(&io, std::move(start));
+			return;
+		}
+		this->busy_ = true;
+	}
+	start();
+}
+
+void async_queue::pop()
+{
+	std::lock_guard lock{ this->mutex_ };
+	if (this->pending_.empty())
+	{
+		this->busy_ = false;
+	}
+	else
+	{
+		// Posted rather than called, pop() is called when an operation is destroyed
+		auto [io, start] = std::move(this->pending_.front());
+		this->pending_.pop_front();
+		boost::asio::post(*io, std::move(start));
+	}
+}
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,48 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <boost/asio/io_context.hpp>
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <utility>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+/// The asynchronous operations of a connection, in the order they were started.
+/// libpq accepts one command at a time, so an operation that is started while another one is in progress, e.g. a
+/// query right after the ROLLBACK that an async_transaction sends from its destructor, waits until it has finished.
+class async_queue final
+{
+	std::mutex                                                             mutex_;
+	bool                                                                   busy_;
+	std::deque<std::pair<boost::asio::io_context*, std::function<void()>>> pending_;
+
+public:
+	async_queue();
+
+	async_queue(const async_queue&)            = delete;
+	async_queue(async_queue&&)                 = delete;
+	async_queue& operator=(const async_queue&) = delete;
+	async_queue& operator=(async_queue&&)      = delete;
+
+	/// Call @a start now if no operation is in progress, otherwise post it to @a io when the operations that were
+	/// pushed before have finished. Every push must be followed by a pop() when the operation has finished.
+	void push(boost::asio::io_context& io, std::function<void()> start);
+
+	/// Called when the operation in progress has finished, this starts the next one
+	void pop();
+};
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,71 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/postgresql/detail/cancelhandle.h"
+#include "zoo/squid/postgresql/detail/ipqapi.h"
+#include "zoo/squid/postgresql/error.h"
+
+#include "zoo/common/misc/throw_exception.h"
+
+#include <string>
+
+#include <libpq-fe.h>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+cancel_handle::cancel_handle(ipq_api* api)
+    : api_{ api }
+    , mutex_{}
+    , cancel_{}
+{
+}
+
+cancel_handle::~cancel_handle() noexcept
+{
+	if (this->cancel_)
+	{
+		this->api_->freeCancel(this->cancel_);
+	}
+}
+
+void cancel_handle::refresh(PGconn& connection)
+{
+	const auto cancel = this->api_->getCancel(&connection);
+
+	std::lock_guard<std::mutex> lock{ this->mutex_ };
+	if (this->cancel_)
+	{
+		this->api_->freeCancel(this->cancel_);
+	}
+	this->cancel_ = cancel;
+}
+
+void cancel_handle::cancel()
+{
+	std::lock_guard<std::mutex> lock{ this->mutex_ };
+	if (!this->cancel_)
+	{
+		ZOO_THROW_EXCEPTION(error{ "PQgetCancel failed" });
+	}
+
+	char errbuf[256] = {};
+	if (!this->api_->cancel(this->cancel_, errbuf, sizeof(errbuf)))
+	{
+		ZOO_THROW_EXCEPTION(error{ std::string{ "PQcancel failed: " } + errbuf });
+	}
+}
+
+void connection_deleter::operator()(PGconn* connection) const
+{
+	this->api->finish(connection);
+}
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,59 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/postgresql/detail/libpqfwd.h"
+
+#include <memory>
+#include <mutex>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+class ipq_api;
+
+/// The PGcancel of a connection.
+/// libpq only allows PQcancel to be called from another thread than the one using the connection, PQgetCancel is not
+/// thread safe. The handle is therefore refreshed by the thread that uses the connection, after connecting and after
+/// every reset, while cancel() may be called from any thread, e.g. the deadline watchdog.
+class cancel_handle final
+{
+	ipq_api*   api_;
+	std::mutex mutex_;
+	PGcancel*  cancel_;
+
+public:
+	explicit cancel_handle(ipq_api* api);
+	~cancel_handle() noexcept;
+
+	cancel_handle(const cancel_handle&)            = delete;
+	cancel_handle(cancel_handle&&)                 = delete;
+	cancel_handle& operator=(const cancel_handle&) = delete;
+	cancel_handle& operator=(cancel_handle&&)      = delete;
+
+	/// Create the PGcancel for the current session of @a connection. Must be called by the thread that uses it.
+	void refresh(PGconn& connection);
+
+	/// Ask the server to cancel the executing statement. Throws an error on failure.
+	void cancel();
+};
+
+/// Deleter of a PGconn that also carries its cancel handle, so that connection_checker can refresh the handle when it
+/// resets the connection.
+struct connection_deleter final
+{
+	ipq_api*                       api;
+	std::shared_ptr<cancel_handle> cancel;
+
+	void operator()(PGconn* connection) const;
+};
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
@@ -9,6 +9,7 @@
 #include "zoo/squid/postgresql/error.h"
 
 #include "zoo/squid/postgresql/detail/ipqapi.h"
+#include "zoo/squid/postgresql/detail/cancelhandle.h"
 
 #include "zoo/common/misc/throw_exception.h"
 
@@ -36,7 +37,22 @@ PGconn* connection_checker::check(ipq_api* api, PGconn* connection)
 
 PGconn* connection_checker::check(ipq_api* api, std::shared_ptr<PGconn> connection)
 {
-	return connection_checker::check(api, connection.get());
+	assert(connection);
+	if (CONNECTION_OK != api->status(connection.get()))
+	{
+		api->reset(connection.get());
+		if (CONNECTION_OK != api->status(connection.get()))
+		{
+			ZOO_THROW_EXCEPTION(error{ api, "PQreset failed", *connection });
+		}
+
+		// The cancel handle of the previous session does not cancel anything in the new one
+		if (const auto deleter = std::get_deleter<connection_deleter>(connection); deleter != nullptr && deleter->cancel)
+		{
+			deleter->cancel->refresh(*connection);
+		}
+	}
+	return connection.get();
 }
 
 } // namespace postgresql
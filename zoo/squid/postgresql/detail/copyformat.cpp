@@ -0,0 +1,224 @@
+//
+// Copyright (C) 2022-2024 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/postgresql/detail/copyformat.h"
+#include "zoo/squid/postgresql/error.h"
+
+#include "zoo/common/misc/throw_exception.h"
+
+#include <cassert>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+namespace {
+
+constexpr std::string_view null_marker = "\\N";
+
+bool is_octal_digit(char c)
+{
+	return c >= '0' && c <= '7';
+}
+
+int hex_digit_value(char c)
+{
+	if (c >= '0' && c <= '9')
+	{
+		return c - '0';
+	}
+	else if (c >= 'a' && c <= 'f')
+	{
+		return 0xa + c - 'a';
+	}
+	else if (c >= 'A' && c <= 'F')
+	{
+		return 0xa + c - 'A';
+	}
+	else
+	{
+		return -1;
+	}
+}
+
+void unescape(std::string_view in, std::string& out)
+{
+	out.clear();
+	out.reserve(in.length());
+
+	const auto end = in.end();
+	for (auto it = in.begin(); it != end; ++it)
+	{
+		if (*it != '\\')
+		{
+			out.push_back(*it);
+			continue;
+		}
+
+		if (++it == end)
+		{
+			ZOO_THROW_EXCEPTION(error{ "Invalid COPY data: trailing backslash" });
+		}
+
+		switch (*it)
+		{
+		case 'b':
+			out.push_back('\b');
+			break;
+		case 'f':
+			out.push_back('\f');
+			break;
+		case 'n':
+			out.push_back('\n');
+			break;
+		case 'r':
+			out.push_back('\r');
+			break;
+		case 't':
+			out.push_back('\t');
+			break;
+		case 'v':
+			out.push_back('\v');
+			break;
+		case 'x':
+			if (it + 1 != end && hex_digit_value(*(it + 1)) >= 0)
+			{
+				auto value = hex_digit_value(*++it);
+				if (it + 1 != end && hex_digit_value(*(it + 1)) >= 0)
+				{
+					value = value * 16 + hex_digit_value(*++it);
+				}
+				out.push_back(static_cast<char>(value));
+			}
+			else
+			{
+				out.push_back('x');
+			}
+			break;
+		default:
+			if (is_octal_digit(*it))
+			{
+				auto value = *it - '0';
+				for (auto n = 0; n < 2 && it + 1 != end && is_octal_digit(*(it + 1)); ++n)
+				{
+					value = value * 8 + (*++it - '0');
+				}
+				out.push_back(static_cast<char>(value));
+			}
+			else
+			{
+				out.push_back(*it);
+			}
+			break;
+		}
+	}
+}
+
+} // namespace
+
+void copy_text_format::append_value(std::string& out, std::string_view value)
+{
+	for (const auto c : value)
+	{
+		switch (c)
+		{
+		case '\\':
+			out.append("\\\\");
+			break;
+		case '\b':
+			out.append("\\b");
+			break;
+		case '\f':
+			out.append("\\f");
+			break;
+		case '\n':
+			out.append("\\n");
+			break;
+		case '\r':
+			out.append("\\r");
+			break;
+		case '\t':
+			out.append("\\t");
+			break;
+		case '\v':
+			out.append("\\v");
+			break;
+		default:
+			out.push_back(c);
+			break;
+		}
+	}
+}
+
+void copy_text_format::append_null(std::string& out)
+{
+	out.append(null_marker);
+}
+
+copy_text_format::row::row()
+    : values_{}
+    , nulls_{}
+    , size_{}
+{
+}
+
+std::size_t copy_text_format::row::size() const
+{
+	return this->size_;
+}
+
+const char* copy_text_format::row::value(std::size_t index) const
+{
+	assert(index < this->size_);
+	return this->nulls_[index] ? nullptr : this->values_[index].c_str();
+}
+
+void copy_text_format::row::parse(std::string_view line)
+{
+	if (!line.empty() && line.back() == row_delimiter)
+	{
+		line.remove_suffix(1);
+	}
+
+	this->size_ = 0;
+
+	for (;;)
+	{
+		const auto pos   = line.find(column_delimiter);
+		const auto field = line.substr(0, pos);
+
+		if (this->size_ == this->values_.size())
+		{
+			this->values_.emplace_back();
+			this->nulls_.push_back(false);
+		}
+
+		if (field == null_marker)
+		{
+			this->nulls_[this->size_] = true;
+			this->values_[this->size_].clear();
+		}
+		else
+		{
+			this->nulls_[this->size_] = false;
+			unescape(field, this->values_[this->size_]);
+		}
+
+		++this->size_;
+
+		if (pos == std::string_view::npos)
+		{
+			break;
+		}
+
+		line.remove_prefix(pos + 1);
+	}
+}
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,55 @@
+//
+// Copyright (C) 2022-2024 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+/// Encoding and decoding of rows in the COPY text format.
+/// See https://www.postgresql.org/docs/current/sql-copy.html#id-1.9.3.55.9.2
+class copy_text_format final
+{
+public:
+	static constexpr char column_delimiter = '\t';
+	static constexpr char row_delimiter    = '\n';
+
+	/// Append the escaped @a value to @a out
+	static void append_value(std::string& out, std::string_view value);
+
+	/// Append the NULL marker to @a out
+	static void append_null(std::string& out);
+
+	/// Decoded row, reused between rows to avoid allocations
+	class row final
+	{
+		std::vector<std::string> values_;
+		std::vector<bool>        nulls_;
+		std::size_t              size_;
+
+	public:
+		row();
+
+		std::size_t size() const;
+
+		/// Returns a nullptr if the value at @a index is NULL
+		const char* value(std::size_t index) const;
+
+		/// Parse one data row @a line, with or without the trailing newline.
+		/// Throws if the line contains an invalid escape sequence.
+		void parse(std::string_view line);
+	};
+};
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,59 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/postgresql/detail/identifier.h"
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+namespace {
+
+void append_quoted(std::string& result, std::string_view identifier)
+{
+	result.push_back('"');
+	for (const auto c : identifier)
+	{
+		if (c == '"')
+		{
+			result.push_back('"');
+		}
+		result.push_back(c);
+	}
+	result.push_back('"');
+}
+
+} // namespace
+
+std::string quote_identifier(std::string_view identifier)
+{
+	std::string result{};
+	result.reserve(identifier.length() + 2u);
+	append_quoted(result, identifier);
+	return result;
+}
+
+std::string quote_qualified_identifier(std::string_view identifier)
+{
+	std::string result{};
+	result.reserve(identifier.length() + 4u);
+	for (;;)
+	{
+		const auto dot = identifier.find('.');
+		append_quoted(result, identifier.substr(0, dot));
+		if (dot == std::string_view::npos)
+		{
+			return result;
+		}
+		result.push_back('.');
+		identifier.remove_prefix(dot + 1);
+	}
+}
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
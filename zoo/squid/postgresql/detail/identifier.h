@@ -0,0 +1,25 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+/// Quote @a identifier, so that it is used as is, e.g. a column name: my "col" -> "my ""col"""
+std::string quote_identifier(std::string_view identifier);
+
+/// Quote each part of the dot separated @a identifier, e.g. a schema qualified table name: my.table -> "my"."table"
+std::string quote_qualified_identifier(std::string_view identifier);
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
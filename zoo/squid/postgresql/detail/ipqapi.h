@@ -7,13 +7,15 @@
 
 #pragma once
 
+#include "zoo/squid/postgresql/config.h"
+
 #include <libpq-fe.h>
 
 namespace zoo {
 namespace squid {
 namespace postgresql {
 
-class ipq_api
+class ZOO_SQUID_POSTGRESQL_API ipq_api
 {
 public:
 	ipq_api();
@@ -82,6 +84,31 @@ public:
 	                                         const int*         paramLengths,
 	                                         const int*         paramFormats,
 	                                         int                resultFormat)                                                                    = 0;
+	virtual int            putCopyData(PGconn* conn, const char* buffer, int nbytes)                                              = 0;
+	virtual int            putCopyEnd(PGconn* conn, const char* errormsg)                                                         = 0;
+	virtual int            getCopyData(PGconn* conn, char** buffer, int async)                                                    = 0;
+	virtual int            setSingleRowMode(PGconn* conn)                                                                         = 0;
+	virtual Oid            lo_create(PGconn* conn, Oid lobjId)                                                                    = 0;
+	virtual int            lo_open(PGconn* conn, Oid lobjId, int mode)                                                            = 0;
+	virtual int            lo_close(PGconn* conn, int fd)                                                                         = 0;
+	virtual int            lo_read(PGconn* conn, int fd, char* buf, size_t len)                                                   = 0;
+	virtual int            lo_write(PGconn* conn, int fd, const char* buf, size_t len)                                            = 0;
+	virtual pg_int64       lo_lseek64(PGconn* conn, int fd, pg_int64 offset, int whence)                                          = 0;
+	virtual int            lo_truncate64(PGconn* conn, int fd, pg_int64 len)                                                      = 0;
+	virtual int            lo_unlink(PGconn* conn, Oid lobjId)                                                                    = 0;
+	virtual PGcancel*      getCancel(PGconn* conn)                                                                                = 0;
+	virtual int            cancel(PGcancel* cancel, char* errbuf, int errbufsize)                                                 = 0;
+	virtual void           freeCancel(PGcancel* cancel)                                                                           = 0;
+#ifdef LIBPQ_HAS_CHUNK_MODE
+	virtual int            setChunkedRowsMode(PGconn* conn, int chunkSize)                                                        = 0;
+#endif
+#ifdef LIBPQ_HAS_PIPELINING
+	virtual int            enterPipelineMode(PGconn* conn)                                                                        = 0;
+	virtual int            exitPipelineMode(PGconn* conn)                                                                         = 0;
+	virtual int            pipelineSync(PGconn* conn)                                                                             = 0;
+#endif
+
+	virtual PGTransactionStatusType transactionStatus(const PGconn* conn) = 0;
 };
 
 } // namespace postgresql
@@ -15,3 +15,6 @@ typedef struct pg_result PGresult;
 
 struct pgNotify;
 typedef struct pgNotify PGnotify;
+
+struct pg_cancel;
+typedef struct pg_cancel PGcancel;
@@ -202,6 +202,110 @@ int pq_api::sendQueryPrepared(PGconn*            conn,
 	return PQsendQueryPrepared(conn, stmtName, nParams, paramValues, paramLengths, paramFormats, resultFormat);
 }
 
+int pq_api::putCopyData(PGconn* conn, const char* buffer, int nbytes)
+{
+	return PQputCopyData(conn, buffer, nbytes);
+}
+
+int pq_api::putCopyEnd(PGconn* conn, const char* errormsg)
+{
+	return PQputCopyEnd(conn, errormsg);
+}
+
+int pq_api::getCopyData(PGconn* conn, char** buffer, int async)
+{
+	return PQgetCopyData(conn, buffer, async);
+}
+
+int pq_api::setSingleRowMode(PGconn* conn)
+{
+	return PQsetSingleRowMode(conn);
+}
+
+Oid pq_api::lo_create(PGconn* conn, Oid lobjId)
+{
+	return ::lo_create(conn, lobjId);
+}
+
+int pq_api::lo_open(PGconn* conn, Oid lobjId, int mode)
+{
+	return ::lo_open(conn, lobjId, mode);
+}
+
+int pq_api::lo_close(PGconn* conn, int fd)
+{
+	return ::lo_close(conn, fd);
+}
+
+int pq_api::lo_read(PGconn* conn, int fd, char* buf, size_t len)
+{
+	return ::lo_read(conn, fd, buf, len);
+}
+
+int pq_api::lo_write(PGconn* conn, int fd, const char* buf, size_t len)
+{
+	return ::lo_write(conn, fd, buf, len);
+}
+
+pg_int64 pq_api::lo_lseek64(PGconn* conn, int fd, pg_int64 offset, int whence)
+{
+	return ::lo_lseek64(conn, fd, offset, whence);
+}
+
+int pq_api::lo_truncate64(PGconn* conn, int fd, pg_int64 len)
+{
+	return ::lo_truncate64(conn, fd, len);
+}
+
+int pq_api::lo_unlink(PGconn* conn, Oid lobjId)
+{
+	return ::lo_unlink(conn, lobjId);
+}
+
+PGcancel* pq_api::getCancel(PGconn* conn)
+{
+	return PQgetCancel(conn);
+}
+
+int pq_api::cancel(PGcancel* cancel, char* errbuf, int errbufsize)
+{
+	return PQcancel(cancel, errbuf, errbufsize);
+}
+
+void pq_api::freeCancel(PGcancel* cancel)
+{
+	PQfreeCancel(cancel);
+}
+
+#ifdef LIBPQ_HAS_CHUNK_MODE
+int pq_api::setChunkedRowsMode(PGconn* conn, int chunkSize)
+{
+	return PQsetChunkedRowsMode(conn, chunkSize);
+}
+#endif
+
+#ifdef LIBPQ_HAS_PIPELINING
+int pq_api::enterPipelineMode(PGconn* conn)
+{
+	return PQenterPipelineMode(conn);
+}
+
+int pq_api::exitPipelineMode(PGconn* conn)
+{
+	return PQexitPipelineMode(conn);
+}
+
+int pq_api::pipelineSync(PGconn* conn)
+{
+	return PQpipelineSync(conn);
+}
+#endif
+
+PGTransactionStatusType pq_api::transactionStatus(const PGconn* conn)
+{
+	return PQtransactionStatus(conn);
+}
+
 } // namespace postgresql
 } // namespace squid
 } // namespace zoo
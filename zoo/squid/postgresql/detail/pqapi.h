@@ -84,6 +84,31 @@ public:
 	                                 const int*         paramLengths,
 	                                 const int*         paramFormats,
 	                                 int                resultFormat) override;
+	int            putCopyData(PGconn* conn, const char* buffer, int nbytes) override;
+	int            putCopyEnd(PGconn* conn, const char* errormsg) override;
+	int            getCopyData(PGconn* conn, char** buffer, int async) override;
+	int            setSingleRowMode(PGconn* conn) override;
+	Oid            lo_create(PGconn* conn, Oid lobjId) override;
+	int            lo_open(PGconn* conn, Oid lobjId, int mode) override;
+	int            lo_close(PGconn* conn, int fd) override;
+	int            lo_read(PGconn* conn, int fd, char* buf, size_t len) override;
+	int            lo_write(PGconn* conn, int fd, const char* buf, size_t len) override;
+	pg_int64       lo_lseek64(PGconn* conn, int fd, pg_int64 offset, int whence) override;
+	int            lo_truncate64(PGconn* conn, int fd, pg_int64 len) override;
+	int            lo_unlink(PGconn* conn, Oid lobjId) override;
+	PGcancel*      getCancel(PGconn* conn) override;
+	int            cancel(PGcancel* cancel, char* errbuf, int errbufsize) override;
+	void           freeCancel(PGcancel* cancel) override;
+#ifdef LIBPQ_HAS_CHUNK_MODE
+	int            setChunkedRowsMode(PGconn* conn, int chunkSize) override;
+#endif
+#ifdef LIBPQ_HAS_PIPELINING
+	int            enterPipelineMode(PGconn* conn) override;
+	int            exitPipelineMode(PGconn* conn) override;
+	int            pipelineSync(PGconn* conn) override;
+#endif
+
+	PGTransactionStatusType transactionStatus(const PGconn* conn) override;
 };
 
 } // namespace postgresql
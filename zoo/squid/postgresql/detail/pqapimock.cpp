@@ -15,11 +15,13 @@ namespace {
 
 PGconn   g_connection;
 PGresult g_result;
+PGcancel g_cancel;
 
 } // namespace
 
 PGconn*   pq_api_mock::test_connection = &g_connection;
 PGresult* pq_api_mock::test_result  = &g_result;
+PGcancel* pq_api_mock::test_cancel  = &g_cancel;
 
 std::shared_ptr<PGconn>   pq_api_mock::test_connection_shared = std::make_shared<PGconn>();
 std::shared_ptr<PGresult> pq_api_mock::test_result_shared  = std::make_shared<PGresult>();
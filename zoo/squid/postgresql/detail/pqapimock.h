@@ -20,6 +20,10 @@ struct pg_result
 {
 };
 
+struct pg_cancel
+{
+};
+
 namespace zoo {
 namespace squid {
 namespace postgresql {
@@ -29,6 +33,7 @@ class pq_api_mock : public ipq_api
 public:
 	static PGconn*   test_connection;
 	static PGresult* test_result;
+	static PGcancel* test_cancel;
 
 	static std::shared_ptr<PGconn>   test_connection_shared;
 	static std::shared_ptr<PGresult> test_result_shared;
@@ -89,6 +94,7 @@ public:
 	MOCK_METHOD(ExecStatusType, resultStatus, (const PGresult* res), (override));
 	MOCK_METHOD(int, socket, (const PGconn* conn), (override));
 	MOCK_METHOD(ConnStatusType, status, (const PGconn* conn), (override));
+	MOCK_METHOD(PGTransactionStatusType, transactionStatus, (const PGconn* conn), (override));
 	MOCK_METHOD(int, setnonblocking, (PGconn * conn, int arg), (override));
 	MOCK_METHOD(int, flush, (PGconn * conn), (override));
 	MOCK_METHOD(PGresult*, getResult, (PGconn * conn), (override));
@@ -114,6 +120,29 @@ public:
 	             const int*         paramFormats,
 	             int                resultFormat),
 	            (override));
+	MOCK_METHOD(int, putCopyData, (PGconn * conn, const char* buffer, int nbytes), (override));
+	MOCK_METHOD(int, putCopyEnd, (PGconn * conn, const char* errormsg), (override));
+	MOCK_METHOD(int, getCopyData, (PGconn * conn, char** buffer, int async), (override));
+	MOCK_METHOD(int, setSingleRowMode, (PGconn * conn), (override));
+	MOCK_METHOD(Oid, lo_create, (PGconn * conn, Oid lobjId), (override));
+	MOCK_METHOD(int, lo_open, (PGconn * conn, Oid lobjId, int mode), (override));
+	MOCK_METHOD(int, lo_close, (PGconn * conn, int fd), (override));
+	MOCK_METHOD(int, lo_read, (PGconn * conn, int fd, char* buf, size_t len), (override));
+	MOCK_METHOD(int, lo_write, (PGconn * conn, int fd, const char* buf, size_t len), (override));
+	MOCK_METHOD(pg_int64, lo_lseek64, (PGconn * conn, int fd, pg_int64 offset, int whence), (override));
+	MOCK_METHOD(int, lo_truncate64, (PGconn * conn, int fd, pg_int64 len), (override));
+	MOCK_METHOD(int, lo_unlink, (PGconn * conn, Oid lobjId), (override));
+	MOCK_METHOD(PGcancel*, getCancel, (PGconn * conn), (override));
+	MOCK_METHOD(int, cancel, (PGcancel * cancel, char* errbuf, int errbufsize), (override));
+	MOCK_METHOD(void, freeCancel, (PGcancel * cancel), (override));
+#ifdef LIBPQ_HAS_CHUNK_MODE
+	MOCK_METHOD(int, setChunkedRowsMode, (PGconn * conn, int chunkSize), (override));
+#endif
+#ifdef LIBPQ_HAS_PIPELINING
+	MOCK_METHOD(int, enterPipelineMode, (PGconn * conn), (override));
+	MOCK_METHOD(int, exitPipelineMode, (PGconn * conn), (override));
+	MOCK_METHOD(int, pipelineSync, (PGconn * conn), (override));
+#endif
 };
 
 using pq_api_mock_nice   = testing::NiceMock<pq_api_mock>;
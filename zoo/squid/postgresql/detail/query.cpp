@@ -7,6 +7,8 @@
 
 #include "zoo/squid/postgresql/detail/query.h"
 
+#include "zoo/squid/core/translatedquerycache.h"
+
 #include <cctype>
 #include <cassert>
 
@@ -25,6 +27,7 @@ inline bool is_name_char(char c)
 postgresql_query::postgresql_query(std::string_view query)
     : query_{}
     , name_pos_map_{}
+    , plan_{}
 {
 	// Implementation based on https://github.com/SOCI/soci/blob/master/src/backends/postgresql/statement.cpp,
 	// simplified and improved.
@@ -36,22 +39,28 @@ postgresql_query::postgresql_query(std::string_view query)
 		in_name
 	} state = normal;
 
-	auto name_begin       = query.end();
-	int  parameter_number = 0;
+	auto                     name_begin       = query.end();
+	int                      parameter_number = 0;
+	std::vector<std::string> names{};
+
+	this->query_.reserve(query.length());
 
-	auto&& at_end_of_name = [this, &name_begin, &parameter_number](auto it) {
+	auto&& at_end_of_name = [this, &name_begin, &parameter_number, &names](auto it) {
 		assert(name_begin < it);
 		std::string name{ name_begin, it };
 
+		this->query_.push_back('$');
+
 		auto pos_it = this->name_pos_map_.find(name);
 		if (pos_it == this->name_pos_map_.end())
 		{
-			this->name_pos_map_[name] = ++parameter_number;
-			this->query_ += std::string{ "$" } + std::to_string(parameter_number);
+			this->query_.append(std::to_string(++parameter_number));
+			this->name_pos_map_.emplace(name, parameter_number);
+			names.push_back(std::move(name));
 		}
 		else
 		{
-			this->query_ += std::string{ "$" } + std::to_string(pos_it->second);
+			this->query_.append(std::to_string(pos_it->second));
 		}
 	};
 
@@ -167,6 +176,8 @@ postgresql_query::postgresql_query(std::string_view query)
 	{
 		at_end_of_name(query.end());
 	}
+
+	this->plan_ = binding_plan{ std::move(names) };
 }
 
 const std::string& postgresql_query::query() const
@@ -184,6 +195,17 @@ const std::map<std::string, int>& postgresql_query::parameter_name_pos_map() con
 	return this->name_pos_map_;
 }
 
+const binding_plan& postgresql_query::plan() const
+{
+	return this->plan_;
+}
+
+std::shared_ptr<const postgresql_query> postgresql_query::cached(std::string_view query)
+{
+	static translated_query_cache<postgresql_query> cache{};
+	return cache.get(query);
+}
+
 } // namespace postgresql
 } // namespace squid
 } // namespace zoo
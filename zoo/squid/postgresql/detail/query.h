@@ -7,6 +7,10 @@
 
 #pragma once
 
+#include "zoo/squid/postgresql/config.h"
+#include "zoo/squid/core/bindingplan.h"
+
+#include <memory>
 #include <string>
 #include <string_view>
 #include <map>
@@ -17,10 +21,11 @@ namespace postgresql {
 
 // PostgreSQL does not support named parameters, only ? and $n
 // This class recreates the query string with all named parameters converted to $1, $2, $3, ...
-class postgresql_query final
+class ZOO_SQUID_POSTGRESQL_API postgresql_query final
 {
 	std::string                query_;
 	std::map<std::string, int> name_pos_map_;
+	binding_plan               plan_; // parameter names by position ($1 is at index 0)
 
 public:
 	explicit postgresql_query(std::string_view query);
@@ -35,6 +40,11 @@ public:
 	int parameter_count() const;
 
 	const std::map<std::string, int>& parameter_name_pos_map() const;
+
+	const binding_plan& plan() const;
+
+	/// Get the shared translation of @a query from a process wide cache
+	static std::shared_ptr<const postgresql_query> cached(std::string_view query);
 };
 
 } // namespace postgresql
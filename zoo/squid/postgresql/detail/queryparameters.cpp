@@ -23,8 +23,6 @@ namespace zoo {
 namespace squid {
 namespace postgresql {
 
-namespace {
-
 const char* get_parameter_value(const parameter& parameter, std::string& value)
 {
 	const auto pointer = parameter.pointer();
@@ -117,12 +115,25 @@ const char* get_parameter_value(const parameter& parameter, std::string& value)
 	return value.c_str();
 }
 
-} // namespace
-
 query_parameters::query_parameters(const postgresql_query& query, const std::map<std::string, parameter>& parameters)
-    : parameter_values_{ static_cast<size_t>(query.parameter_count()) }
-    , parameter_value_pointers_{ static_cast<size_t>(query.parameter_count()) }
+    : parameter_values_{}
+    , parameter_value_pointers_{}
+{
+	this->assign(query, parameters);
+}
+
+query_parameters::query_parameters(const postgresql_query& query, const positional_parameters& parameters)
+    : parameter_values_{}
+    , parameter_value_pointers_{}
 {
+	this->assign(query, parameters);
+}
+
+void query_parameters::assign(const postgresql_query& query, const std::map<std::string, parameter>& parameters)
+{
+	this->parameter_values_.resize(static_cast<size_t>(query.parameter_count()));
+	this->parameter_value_pointers_.resize(static_cast<size_t>(query.parameter_count()));
+
 	for (const auto& pair : query.parameter_name_pos_map())
 	{
 		auto it = parameters.find(pair.first);
@@ -140,6 +151,25 @@ query_parameters::query_parameters(const postgresql_query& query, const std::map
 	}
 }
 
+void query_parameters::assign(const postgresql_query& query, const positional_parameters& parameters)
+{
+	const auto& plan = query.plan();
+	assert(parameters.size() == plan.size());
+
+	this->parameter_values_.resize(plan.size());
+	this->parameter_value_pointers_.resize(plan.size());
+
+	for (std::size_t index = 0; index < plan.size(); ++index)
+	{
+		const auto& parameter = parameters[index];
+		if (!parameter)
+		{
+			ZOO_THROW_EXCEPTION(error{ "The query parameter '" + plan.name(index) + "' is not bound" });
+		}
+		this->parameter_value_pointers_[index] = get_parameter_value(parameter.value(), this->parameter_values_[index]);
+	}
+}
+
 const char* const* query_parameters::parameter_values() const
 {
 	if (this->parameter_value_pointers_.empty())
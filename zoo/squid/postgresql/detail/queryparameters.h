@@ -8,6 +8,7 @@
 #pragma once
 
 #include "zoo/squid/core/parameter.h"
+#include "zoo/squid/core/bindingplan.h"
 
 #include <string>
 #include <vector>
@@ -19,6 +20,10 @@ namespace postgresql {
 
 class postgresql_query;
 
+/// Convert @a parameter to the PostgreSQL text representation, using @a value as storage.
+/// Returns a pointer to the data of @a value, or a nullptr if the parameter is NULL.
+const char* get_parameter_value(const parameter& parameter, std::string& value);
+
 class query_parameters final
 {
 	std::vector<std::string> parameter_values_;
@@ -26,12 +31,17 @@ class query_parameters final
 
 public:
 	query_parameters(const postgresql_query& query, const std::map<std::string, parameter>& parameters);
+	query_parameters(const postgresql_query& query, const positional_parameters& parameters);
 
 	query_parameters(const query_parameters&)            = delete;
 	query_parameters(query_parameters&& src)             = default;
 	query_parameters& operator=(const query_parameters&) = delete;
 	query_parameters& operator=(query_parameters&&)      = default;
 
+	/// Replace the parameter values, reusing the value buffers of the previous values
+	void assign(const postgresql_query& query, const std::map<std::string, parameter>& parameters);
+	void assign(const postgresql_query& query, const positional_parameters& parameters);
+
 	const char* const* parameter_values() const;
 
 	int parameter_count() const;
@@ -123,20 +123,13 @@ void store_result(const result::non_nullable_type& result, std::string_view colu
 	    result);
 }
 
-void store_result(ipq_api*         api,
-                  const result&    result,
-                  const PGresult&  pgresult,
-                  int              row_index,
-                  std::string_view column_name,
-                  int              column_index)
-{
-	assert(row_index < api->ntuples(&pgresult));
-	assert(column_index < api->nfields(&pgresult));
-	assert(column_name.data());
+} // namespace
 
+void store_result(const result& result, std::string_view column_name, const char* value)
+{
 	const auto& destination = result.value();
 
-	if (api->getisnull(&pgresult, row_index, column_index))
+	if (value == nullptr)
 	{
 		std::visit(
 		    [&](auto&& arg) {
@@ -165,21 +158,12 @@ void store_result(ipq_api*         api,
 	}
 	else
 	{
-		const auto value = api->getvalue(&pgresult, row_index, column_index);
-
-		if (value == nullptr)
-		{
-			std::ostringstream msg;
-			msg << "PQgetvalue returned NULL for column " << std::quoted(column_name);
-			ZOO_THROW_EXCEPTION(error{ msg.str() });
-		}
-
 		std::visit(
 		    [&](auto&& arg) {
 			    using T = std::decay_t<decltype(arg)>;
 			    if constexpr (std::is_same_v<T, result::non_nullable_type>)
 			    {
-				    store_result(arg, column_name, value);
+				    store_result(arg, column_name, std::string_view{ value });
 			    }
 			    else if constexpr (std::is_same_v<T, result::nullable_type>)
 			    {
@@ -188,7 +172,7 @@ void store_result(ipq_api*         api,
 					        // arg is a (std::optional<X>*)
 					        using T = typename std::decay_t<decltype(*arg)>::value_type;
 					        T tmp{};
-					        store_result(result::non_nullable_type{ &tmp }, column_name, value);
+					        store_result(result::non_nullable_type{ &tmp }, column_name, std::string_view{ value });
 					        *arg = tmp;
 				        },
 				        arg);
@@ -202,17 +186,49 @@ void store_result(ipq_api*         api,
 	}
 }
 
+namespace {
+
+void store_result(ipq_api*         api,
+                  const result&    result,
+                  const PGresult&  pgresult,
+                  int              row_index,
+                  std::string_view column_name,
+                  int              column_index)
+{
+	assert(row_index < api->ntuples(&pgresult));
+	assert(column_index < api->nfields(&pgresult));
+	assert(column_name.data());
+
+	if (api->getisnull(&pgresult, row_index, column_index))
+	{
+		postgresql::store_result(result, column_name, nullptr);
+	}
+	else
+	{
+		const auto value = api->getvalue(&pgresult, row_index, column_index);
+
+		if (value == nullptr)
+		{
+			std::ostringstream msg;
+			msg << "PQgetvalue returned NULL for column " << std::quoted(column_name);
+			ZOO_THROW_EXCEPTION(error{ msg.str() });
+		}
+
+		postgresql::store_result(result, column_name, value);
+	}
+}
+
 } // namespace
 
 struct query_results::column final
 {
-	result           res;
-	std::string_view name;
-	int              index;
+	result      res;
+	std::string name; // owned, because the PGresult may be replaced, see set_pgresult()
+	int         index;
 
 	column(const result& res, std::string_view name, int index)
 	    : res{ res }
-	    , name{ std::move(name) }
+	    , name{ name }
 	    , index{ index }
 	{
 	}
@@ -320,6 +336,13 @@ std::string query_results::field_name(std::size_t index) const
 	return name;
 }
 
+void query_results::set_pgresult(std::shared_ptr<PGresult> pgresult)
+{
+	assert(pgresult);
+	assert(this->api_->nfields(pgresult.get()) == static_cast<int>(this->field_count_));
+	this->pgresult_ = std::move(pgresult);
+}
+
 void query_results::fetch(int row_index)
 {
 	for (const auto& column : this->columns_)
@@ -13,6 +13,7 @@
 #include <vector>
 #include <map>
 #include <memory>
+#include <string_view>
 
 namespace zoo {
 namespace squid {
@@ -20,6 +21,10 @@ namespace postgresql {
 
 class ipq_api;
 
+/// Convert the PostgreSQL text representation @a value of column @a column_name and store it in @a result.
+/// A nullptr @a value denotes a NULL value.
+void store_result(const result& result, std::string_view column_name, const char* value);
+
 class query_results final
 {
 	struct column;
@@ -40,6 +45,10 @@ public:
 	size_t      field_count() const;
 	std::string field_name(std::size_t index) const;
 
+	/// Replace the PGresult by the next result of the same query.
+	/// Used when the rows are received in single row or chunked mode.
+	void set_pgresult(std::shared_ptr<PGresult> pgresult);
+
 	void fetch(int row_index);
 };
 
@@ -0,0 +1,91 @@
+//
+// Copyright (C) 2022-2024 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include <zoo/squid/postgresql/detail/copyformat.h>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+TEST(CopyTextFormatTest, AppendPlainValue)
+{
+	std::string out{};
+	copy_text_format::append_value(out, "hello world");
+	EXPECT_EQ(out, "hello world");
+}
+
+TEST(CopyTextFormatTest, AppendValueWithSpecialCharacters)
+{
+	std::string out{};
+	copy_text_format::append_value(out, "a\tb\nc\\d\re");
+	EXPECT_EQ(out, "a\\tb\\nc\\\\d\\re");
+}
+
+TEST(CopyTextFormatTest, AppendNull)
+{
+	std::string out{};
+	copy_text_format::append_null(out);
+	EXPECT_EQ(out, "\\N");
+}
+
+TEST(CopyTextFormatTest, ParseRow)
+{
+	copy_text_format::row row{};
+	row.parse("1\tfoo\t\\N\t\n");
+	ASSERT_EQ(row.size(), 4u);
+	EXPECT_STREQ(row.value(0), "1");
+	EXPECT_STREQ(row.value(1), "foo");
+	EXPECT_EQ(row.value(2), nullptr);
+	EXPECT_STREQ(row.value(3), "");
+}
+
+TEST(CopyTextFormatTest, ParseRowWithEscapes)
+{
+	copy_text_format::row row{};
+	row.parse("a\\tb\\nc\\\\d\t\\101\\x42\\q\t\\\\N");
+	ASSERT_EQ(row.size(), 3u);
+	EXPECT_STREQ(row.value(0), "a\tb\nc\\d");
+	EXPECT_STREQ(row.value(1), "ABq");
+	EXPECT_STREQ(row.value(2), "\\N");
+}
+
+TEST(CopyTextFormatTest, ParseRowReusesStorage)
+{
+	copy_text_format::row row{};
+	row.parse("1\t2\t3");
+	ASSERT_EQ(row.size(), 3u);
+	row.parse("4");
+	ASSERT_EQ(row.size(), 1u);
+	EXPECT_STREQ(row.value(0), "4");
+}
+
+TEST(CopyTextFormatTest, RoundTrip)
+{
+	const auto  value = std::string{ "tab\there, newline\nthere, backslash\\ and \x01 control" };
+	std::string line{};
+	copy_text_format::append_value(line, value);
+	line.push_back(copy_text_format::column_delimiter);
+	copy_text_format::append_null(line);
+	line.push_back(copy_text_format::row_delimiter);
+
+	copy_text_format::row row{};
+	row.parse(line);
+	ASSERT_EQ(row.size(), 2u);
+	EXPECT_EQ(row.value(0), value);
+	EXPECT_EQ(row.value(1), nullptr);
+}
+
+TEST(CopyTextFormatTest, TrailingBackslashThrows)
+{
+	copy_text_format::row row{};
+	EXPECT_ANY_THROW(row.parse("abc\\"));
+}
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,32 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include <zoo/squid/postgresql/detail/identifier.h>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+TEST(PostgresqlIdentifierTest, TestQuoteIdentifier)
+{
+	EXPECT_EQ(quote_identifier("name"), "\"name\"");
+	EXPECT_EQ(quote_identifier("My \"Name\""), "\"My \"\"Name\"\"\"");
+	EXPECT_EQ(quote_identifier("a.b"), "\"a.b\"");
+	EXPECT_EQ(quote_identifier(""), "\"\"");
+}
+
+TEST(PostgresqlIdentifierTest, TestQuoteQualifiedIdentifier)
+{
+	EXPECT_EQ(quote_qualified_identifier("table"), "\"table\"");
+	EXPECT_EQ(quote_qualified_identifier("my schema.Table"), "\"my schema\".\"Table\"");
+	EXPECT_EQ(quote_qualified_identifier("db.s.\"t\""), "\"db\".\"s\".\"\"\"t\"\"\"");
+}
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
@@ -118,6 +118,27 @@ TEST(PostgresqlQueryTest, CastingOperator)
 	}
 }
 
+TEST(PostgresqlQueryTest, BindingPlan)
+{
+	postgresql_query q{ "SELECT :second, :first, :second" };
+	EXPECT_EQ(q.query(), "SELECT $1, $2, $1");
+	ASSERT_EQ(q.plan().size(), 2u);
+	EXPECT_EQ(q.plan().name(0), "second");
+	EXPECT_EQ(q.plan().name(1), "first");
+	EXPECT_EQ(q.plan().index_of("first"), 1u);
+	EXPECT_FALSE(q.plan().index_of("third").has_value());
+}
+
+TEST(PostgresqlQueryTest, CachedTranslation)
+{
+	const auto a = postgresql_query::cached("SELECT :first");
+	const auto b = postgresql_query::cached("SELECT :first");
+	const auto c = postgresql_query::cached("SELECT :first ");
+	EXPECT_EQ(a.get(), b.get());
+	EXPECT_NE(a.get(), c.get());
+	EXPECT_EQ(a->query(), "SELECT $1");
+}
+
 } // namespace postgresql
 } // namespace squid
 } // namespace zoo
@@ -145,6 +145,28 @@ TEST(PostgresqlQueryparametersTest, BoostTimedurationParameter)
 	EXPECT_EQ(get_one_query_parameter(conversion::string_to_boost_time_duration(tm)), tm);
 }
 
+TEST(PostgresqlQueryparametersTest, PositionalParameters)
+{
+	postgresql_query      q{ "SELECT :second, :first" };
+	positional_parameters p{ parameter{ 2, parameter::by_value{} }, parameter{ std::string{ "one" }, parameter::by_value{} } };
+	query_parameters      qp{ q, p };
+	ASSERT_EQ(qp.parameter_count(), 2);
+	EXPECT_STREQ(qp.parameter_values()[0], "2");
+	EXPECT_STREQ(qp.parameter_values()[1], "one");
+
+	p[0] = parameter{ std::nullopt, parameter::by_value{} };
+	qp.assign(q, p);
+	EXPECT_EQ(qp.parameter_values()[0], nullptr);
+	EXPECT_STREQ(qp.parameter_values()[1], "one");
+}
+
+TEST(PostgresqlQueryparametersTest, UnboundPositionalParameterMustNotBeAllowed)
+{
+	postgresql_query      q{ "SELECT :first, :second" };
+	positional_parameters p{ parameter{ 1, parameter::by_value{} }, std::nullopt };
+	EXPECT_ANY_THROW((query_parameters{ q, p }));
+}
+
 } // namespace postgresql
 } // namespace squid
 } // namespace zoo
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include "zoo/squid/postgresql/config.h"
 #include "zoo/squid/core/types.h"
 
 #include <boost/date_time/gregorian/greg_date.hpp>
@@ -21,7 +22,7 @@ namespace zoo {
 namespace squid {
 namespace postgresql {
 
-class field final
+class ZOO_SQUID_POSTGRESQL_API field final
 {
 	std::string_view                name_;
 	std::optional<std::string_view> value_;
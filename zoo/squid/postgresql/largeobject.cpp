@@ -0,0 +1,156 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/postgresql/largeobject.h"
+#include "zoo/squid/postgresql/connection.h"
+#include "zoo/squid/postgresql/backendconnection.h"
+#include "zoo/squid/postgresql/error.h"
+
+#include "zoo/squid/postgresql/detail/ipqapi.h"
+
+#include "zoo/common/logging/logging.h"
+#include "zoo/common/misc/throw_exception.h"
+
+#include <libpq/libpq-fs.h>
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <cstdio>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+static_assert(std::is_same_v<large_object::oid_type, Oid>);
+
+large_object::oid_type large_object::create(ipq_api* api, PGconn& connection)
+{
+	const auto oid = api->lo_create(&connection, InvalidOid);
+	if (oid == InvalidOid)
+	{
+		ZOO_THROW_EXCEPTION(error{ api, "lo_create failed", connection });
+	}
+	return oid;
+}
+
+large_object::oid_type large_object::create(const backend_connection& connection)
+{
+	return create(connection.api(), *connection.native_connection());
+}
+
+large_object::oid_type large_object::create(const connection& connection)
+{
+	return create(connection.backend());
+}
+
+void large_object::unlink(ipq_api* api, PGconn& connection, oid_type oid)
+{
+	if (api->lo_unlink(&connection, oid) < 0)
+	{
+		ZOO_THROW_EXCEPTION(error{ api, "lo_unlink failed", connection });
+	}
+}
+
+void large_object::unlink(const backend_connection& connection, oid_type oid)
+{
+	unlink(connection.api(), *connection.native_connection(), oid);
+}
+
+void large_object::unlink(const connection& connection, oid_type oid)
+{
+	unlink(connection.backend(), oid);
+}
+
+large_object::large_object(ipq_api* api, std::shared_ptr<PGconn> connection, oid_type oid, bool writable)
+    : api_{ api }
+    , connection_{ std::move(connection) }
+    , fd_{ -1 }
+{
+	this->fd_ = this->api_->lo_open(this->connection_.get(), oid, writable ? INV_READ | INV_WRITE : INV_READ);
+	if (this->fd_ < 0)
+	{
+		ZOO_THROW_EXCEPTION(error{ this->api_, "lo_open failed", *this->connection_ });
+	}
+}
+
+large_object::large_object(const backend_connection& connection, oid_type oid, bool writable)
+    : large_object{ connection.api(), connection.native_connection(), oid, writable }
+{
+}
+
+large_object::large_object(const connection& connection, oid_type oid, bool writable)
+    : large_object{ connection.backend(), oid, writable }
+{
+}
+
+large_object::~large_object() noexcept
+{
+	if (this->api_->lo_close(this->connection_.get(), this->fd_) < 0)
+	{
+		ZOO_LOG(err, "lo_close failed: {}", this->api_->errorMessage(this->connection_.get()));
+	}
+}
+
+std::size_t large_object::read(void* buf, std::size_t count)
+{
+	const auto len = std::min<std::size_t>(count, std::numeric_limits<int>::max());
+	const auto n   = this->api_->lo_read(this->connection_.get(), this->fd_, static_cast<char*>(buf), len);
+	if (n < 0)
+	{
+		ZOO_THROW_EXCEPTION(error{ this->api_, "lo_read failed", *this->connection_ });
+	}
+	return static_cast<std::size_t>(n);
+}
+
+std::size_t large_object::write(const void* buf, std::size_t count)
+{
+	const auto len = std::min<std::size_t>(count, std::numeric_limits<int>::max());
+	const auto n   = this->api_->lo_write(this->connection_.get(), this->fd_, static_cast<const char*>(buf), len);
+	if (n < 0)
+	{
+		ZOO_THROW_EXCEPTION(error{ this->api_, "lo_write failed", *this->connection_ });
+	}
+	return static_cast<std::size_t>(n);
+}
+
+std::uint64_t large_object::size()
+{
+	const auto seek = [this](pg_int64 offset, int whence) {
+		const auto result = this->api_->lo_lseek64(this->connection_.get(), this->fd_, offset, whence);
+		if (result < 0)
+		{
+			ZOO_THROW_EXCEPTION(error{ this->api_, "lo_lseek64 failed", *this->connection_ });
+		}
+		return result;
+	};
+
+	const auto position = seek(0, SEEK_CUR);
+	const auto end      = seek(0, SEEK_END);
+	seek(position, SEEK_SET);
+	return static_cast<std::uint64_t>(end);
+}
+
+void large_object::seek(std::uint64_t offset)
+{
+	if (this->api_->lo_lseek64(this->connection_.get(), this->fd_, static_cast<pg_int64>(offset), SEEK_SET) < 0)
+	{
+		ZOO_THROW_EXCEPTION(error{ this->api_, "lo_lseek64 failed", *this->connection_ });
+	}
+}
+
+void large_object::truncate(std::uint64_t size)
+{
+	if (this->api_->lo_truncate64(this->connection_.get(), this->fd_, static_cast<pg_int64>(size)) < 0)
+	{
+		ZOO_THROW_EXCEPTION(error{ this->api_, "lo_truncate64 failed", *this->connection_ });
+	}
+}
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,70 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/postgresql/config.h"
+#include "zoo/squid/postgresql/backendconnectionfwd.h"
+#include "zoo/squid/postgresql/detail/libpqfwd.h"
+#include "zoo/squid/postgresql/detail/ipqapifwd.h"
+#include "zoo/squid/core/iblob.h"
+
+#include <memory>
+#include <cstdint>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+class connection;
+
+/// Incremental access to a large object with the lo_* functions of libpq.
+/// Unlike a bytea value, a large object is transferred in chunks of the size passed to read() and write(),
+/// without encoding. Large objects can only be accessed within a transaction, the object is closed when the
+/// transaction ends, so the large_object must be destroyed before that.
+class ZOO_SQUID_POSTGRESQL_API large_object final : public iblob
+{
+	ipq_api*                api_;
+	std::shared_ptr<PGconn> connection_;
+	int                     fd_;
+
+public:
+	/// Type of the identifier of a large object (Oid)
+	using oid_type = unsigned int;
+
+	/// Create a new, empty large object and return its identifier
+	static oid_type create(ipq_api* api, PGconn& connection);
+	static oid_type create(const backend_connection& connection);
+	static oid_type create(const connection& connection);
+
+	/// Delete the large object @a oid
+	static void unlink(ipq_api* api, PGconn& connection, oid_type oid);
+	static void unlink(const backend_connection& connection, oid_type oid);
+	static void unlink(const connection& connection, oid_type oid);
+
+	/// Open the large object @a oid
+	large_object(ipq_api* api, std::shared_ptr<PGconn> connection, oid_type oid, bool writable);
+	large_object(const backend_connection& connection, oid_type oid, bool writable);
+	large_object(const connection& connection, oid_type oid, bool writable);
+
+	~large_object() noexcept override;
+
+	large_object(const large_object&)            = delete;
+	large_object& operator=(const large_object&) = delete;
+
+	std::size_t   read(void* buf, std::size_t count) override;
+	std::size_t   write(const void* buf, std::size_t count) override;
+	std::uint64_t size() override;
+	void          seek(std::uint64_t offset) override;
+
+	/// Truncate or extend the large object to @a size bytes
+	void truncate(std::uint64_t size);
+};
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
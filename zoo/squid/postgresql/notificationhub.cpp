@@ -0,0 +1,417 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/postgresql/notificationhub.h"
+#include "zoo/squid/postgresql/backendconnection.h"
+#include "zoo/squid/postgresql/error.h"
+
+#include "zoo/squid/postgresql/detail/ipqapi.h"
+#include "zoo/squid/postgresql/detail/identifier.h"
+
+#include "zoo/common/logging/logging.h"
+#include "zoo/common/misc/throw_exception.h"
+
+#include <boost/asio/bind_executor.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/posix/stream_descriptor.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/system/system_error.hpp>
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <libpq-fe.h>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+class notification_hub::impl final : public std::enable_shared_from_this<notification_hub::impl>
+{
+	struct subscriber final
+	{
+		std::string                         channel;
+		std::shared_ptr<const handler_type> handler;
+	};
+
+	using lock_type = std::unique_lock<std::mutex>;
+
+	connection                                                  connection_;
+	ipq_api*                                                    api_;
+	std::shared_ptr<PGconn>                                     native_conn_;
+	boost::asio::strand<boost::asio::io_context::executor_type> strand_;
+	boost::asio::posix::stream_descriptor                       stream_;
+	mutable std::mutex                                          mutex_; // guards the members below and the use of the connection
+	error_handler_type                                          on_error_;
+	std::map<std::uint64_t, subscriber>                         subscribers_;
+	std::map<std::string, std::size_t, std::less<>>             channels_; // number of subscribers per channel
+	std::uint64_t                                               next_id_;
+	bool                                                        stopped_;
+
+	// Take the notifications that libpq has received
+	std::vector<notification> drain(const lock_type&)
+	{
+		std::vector<notification> result{};
+		while (auto notify = this->api_->notifies(this->native_conn_.get()))
+		{
+			result.push_back(notification{ .channel = notify->relname ? notify->relname : "",
+			                               .payload = notify->extra ? notify->extra : "",
+			                               .pid     = notify->be_pid });
+			this->api_->freemem(notify);
+		}
+		return result;
+	}
+
+	void deliver(std::vector<notification>& notifications)
+	{
+		// Group by channel, keeping the order of each channel
+		std::stable_sort(notifications.begin(), notifications.end(), [](const notification& a, const notification& b) {
+			return a.channel < b.channel;
+		});
+
+		for (auto first = notifications.begin(); first != notifications.end();)
+		{
+			const auto last = std::find_if(first, notifications.end(), [&first](const notification& n) { return n.channel != first->channel; });
+
+			std::vector<std::pair<std::uint64_t, std::shared_ptr<const handler_type>>> handlers{};
+			{
+				lock_type lock{ this->mutex_ };
+				for (const auto& [id, s] : this->subscribers_)
+				{
+					if (s.channel == first->channel)
+					{
+						handlers.emplace_back(id, s.handler);
+					}
+				}
+			}
+
+			const auto batch = std::span<const notification>{ std::to_address(first), static_cast<std::size_t>(last - first) };
+			for (const auto& [id, handler] : handlers)
+			{
+				if (this->is_subscribed(id))
+				{
+					(*handler)(batch);
+				}
+			}
+
+			first = last;
+		}
+	}
+
+	bool is_subscribed(std::uint64_t id) const
+	{
+		lock_type lock{ this->mutex_ };
+		return this->subscribers_.contains(id);
+	}
+
+	// Deliver notifications that were drained outside of the wait handler
+	void post(std::vector<notification>&& notifications)
+	{
+		if (!notifications.empty())
+		{
+			boost::asio::post(this->strand_, [self = this->shared_from_this(), notifications = std::move(notifications)]() mutable {
+				self->deliver(notifications);
+			});
+		}
+	}
+
+	// Stop after waiting for notifications failed, and report @a error to the error handler
+	void fail(std::exception_ptr error)
+	{
+		{
+			lock_type lock{ this->mutex_ };
+			this->stopped_ = true;
+			this->subscribers_.clear();
+		}
+		if (this->on_error_)
+		{
+			this->on_error_(error);
+		}
+	}
+
+	void on_wait(const boost::system::error_code& ec)
+	{
+		if (ec)
+		{
+			if (ec != boost::asio::error::operation_aborted)
+			{
+				ZOO_LOG(err, "waiting for notifications failed: {}", ec.message());
+				this->fail(std::make_exception_ptr(boost::system::system_error{ ec, "waiting for notifications failed" }));
+			}
+			return;
+		}
+
+		std::vector<notification> notifications{};
+		{
+			lock_type lock{ this->mutex_ };
+			if (this->stopped_)
+			{
+				return;
+			}
+			if (!this->api_->consumeInput(this->native_conn_.get()))
+			{
+				auto failure = error{ this->api_, "PQconsumeInput failed", *this->native_conn_ };
+				ZOO_LOG(err, "no longer waiting for notifications: {}", failure.what());
+				lock.unlock();
+				this->fail(std::make_exception_ptr(std::move(failure)));
+				return;
+			}
+			notifications = this->drain(lock);
+		}
+
+		this->deliver(notifications);
+
+		// stop() may have been called by another thread in the meantime
+		lock_type lock{ this->mutex_ };
+		if (!this->stopped_)
+		{
+			this->async_wait();
+		}
+	}
+
+	void async_wait()
+	{
+		this->stream_.async_wait(boost::asio::posix::stream_descriptor::wait_read,
+		                         boost::asio::bind_executor(this->strand_, [self = this->shared_from_this()](const boost::system::error_code& ec) {
+			                         self->on_wait(ec);
+		                         }));
+	}
+
+public:
+	impl(boost::asio::io_context& ioc, connection&& connection, error_handler_type&& on_error)
+	    : connection_{ std::move(connection) }
+	    , api_{ this->connection_.backend().api() }
+	    , native_conn_{ this->connection_.backend().native_connection() }
+	    , strand_{ ioc.get_executor() }
+	    , stream_{ ioc }
+	    , mutex_{}
+	    , on_error_{ std::move(on_error) }
+	    , subscribers_{}
+	    , channels_{}
+	    , next_id_{}
+	    , stopped_{}
+	{
+		const auto sock = this->api_->socket(this->native_conn_.get());
+		if (sock < 0)
+		{
+			ZOO_THROW_EXCEPTION(error{ this->api_, "PQsocket failed", *this->native_conn_ });
+		}
+		this->stream_.assign(sock);
+	}
+
+	~impl() noexcept
+	{
+		// The descriptor is owned by the PGconn
+		if (this->stream_.is_open())
+		{
+			this->stream_.release();
+		}
+	}
+
+	impl(const impl&)            = delete;
+	impl& operator=(const impl&) = delete;
+
+	void start()
+	{
+		this->async_wait();
+	}
+
+	void stop() noexcept
+	{
+		{
+			lock_type lock{ this->mutex_ };
+			this->stopped_ = true;
+			this->subscribers_.clear();
+		}
+
+		// The stream is only used on the strand, a wait that is in progress is aborted there
+		boost::asio::post(this->strand_, [self = this->shared_from_this()] {
+			boost::system::error_code ec{};
+			self->stream_.cancel(ec);
+		});
+	}
+
+	bool stopped() const
+	{
+		lock_type lock{ this->mutex_ };
+		return this->stopped_;
+	}
+
+	std::uint64_t subscribe(std::string_view channel, handler_type&& handler)
+	{
+		std::vector<notification> notifications{};
+		std::uint64_t             id{};
+		{
+			lock_type lock{ this->mutex_ };
+			if (this->stopped_)
+			{
+				ZOO_THROW_EXCEPTION(error{ "The notification hub has been stopped" });
+			}
+
+			auto it = this->channels_.find(channel);
+			if (it == this->channels_.end())
+			{
+				this->connection_.execute("LISTEN " + quote_identifier(channel));
+				it = this->channels_.emplace(std::string{ channel }, 0u).first;
+			}
+			++it->second;
+
+			id = ++this->next_id_;
+			this->subscribers_.emplace(id, subscriber{ .channel = it->first, .handler = std::make_shared<const handler_type>(std::move(handler)) });
+
+			// Notifications that arrived while executing LISTEN are queued by libpq without making the socket readable
+			notifications = this->drain(lock);
+		}
+		this->post(std::move(notifications));
+		return id;
+	}
+
+	void unsubscribe(std::uint64_t id)
+	{
+		std::vector<notification> notifications{};
+		{
+			lock_type lock{ this->mutex_ };
+			auto      it = this->subscribers_.find(id);
+			if (it == this->subscribers_.end())
+			{
+				return;
+			}
+
+			const auto channel = this->channels_.find(it->second.channel);
+			this->subscribers_.erase(it);
+			if (channel != this->channels_.end() && --channel->second == 0u)
+			{
+				const auto name = channel->first;
+				this->channels_.erase(channel);
+				this->connection_.execute("UNLISTEN " + quote_identifier(name));
+				notifications = this->drain(lock);
+			}
+		}
+		this->post(std::move(notifications));
+	}
+
+	std::size_t channel_count() const
+	{
+		lock_type lock{ this->mutex_ };
+		return this->channels_.size();
+	}
+};
+
+notification_hub::subscription::subscription()
+    : hub_{}
+    , id_{}
+{
+}
+
+notification_hub::subscription::subscription(std::weak_ptr<impl> hub, std::uint64_t id)
+    : hub_{ std::move(hub) }
+    , id_{ id }
+{
+}
+
+notification_hub::subscription::~subscription() noexcept
+{
+	this->reset();
+}
+
+notification_hub::subscription::subscription(subscription&& src) noexcept
+    : hub_{ std::move(src.hub_) }
+    , id_{ std::exchange(src.id_, 0u) }
+{
+}
+
+notification_hub::subscription& notification_hub::subscription::operator=(subscription&& src) noexcept
+{
+	if (this != &src)
+	{
+		this->reset();
+		this->hub_ = std::move(src.hub_);
+		this->id_  = std::exchange(src.id_, 0u);
+	}
+	return *this;
+}
+
+notification_hub::subscription::operator bool() const noexcept
+{
+	return this->id_ != 0u;
+}
+
+void notification_hub::subscription::reset() noexcept
+{
+	if (const auto id = std::exchange(this->id_, 0u))
+	{
+		if (const auto hub = this->hub_.lock())
+		{
+			try
+			{
+				hub->unsubscribe(id);
+			}
+			catch (const std::exception& e)
+			{
+				ZOO_LOG(err, "cannot unsubscribe from notifications: {}", e.what());
+			}
+		}
+		this->hub_.reset();
+	}
+}
+
+notification_hub::notification_hub(boost::asio::io_context& ioc, connection&& connection, error_handler_type on_error)
+    : pimpl_{ std::make_shared<impl>(ioc, std::move(connection), std::move(on_error)) }
+{
+	this->pimpl_->start();
+}
+
+notification_hub::~notification_hub() noexcept
+{
+	if (this->pimpl_)
+	{
+		this->pimpl_->stop();
+	}
+}
+
+notification_hub::notification_hub(notification_hub&&) noexcept = default;
+
+notification_hub& notification_hub::operator=(notification_hub&& src) noexcept
+{
+	if (this != &src)
+	{
+		if (this->pimpl_)
+		{
+			this->pimpl_->stop();
+		}
+		this->pimpl_ = std::move(src.pimpl_);
+	}
+	return *this;
+}
+
+notification_hub::subscription notification_hub::subscribe(std::string_view channel, handler_type handler)
+{
+	if (!handler)
+	{
+		ZOO_THROW_EXCEPTION(std::invalid_argument{ "handler must not be empty" });
+	}
+	return subscription{ this->pimpl_, this->pimpl_->subscribe(channel, std::move(handler)) };
+}
+
+std::size_t notification_hub::channel_count() const
+{
+	return this->pimpl_->channel_count();
+}
+
+bool notification_hub::stopped() const
+{
+	return this->pimpl_->stopped();
+}
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,108 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/postgresql/config.h"
+#include "zoo/squid/postgresql/connection.h"
+
+#include <boost/asio/io_context.hpp>
+
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+/// A notification received by a notification_hub
+struct notification final
+{
+	std::string channel; //!< Channel the notification was sent on
+	std::string payload; //!< Payload, empty if none was given
+	int         pid{};   //!< Process ID of the notifying server process
+};
+
+/// Shares one connection among any number of LISTEN subscriptions.
+/// Channels can be subscribed to and unsubscribed from at any time, a channel is listened to as long as it has
+/// at least one subscriber.
+/// Each time the socket of the connection becomes readable, all pending notifications are drained, and every
+/// subscriber of a channel is called once with the notifications of that channel, in the order they were received.
+/// The subscribers are called on the io_context, one at a time.
+/// Subscribing and unsubscribing are thread safe, they execute LISTEN and UNLISTEN synchronously.
+/// The connection must not be used for anything else.
+/// When waiting for notifications fails, e.g. because the connection was lost, the hub stops: the error handler is
+/// called on the io_context, no more notifications are delivered and subscribing throws.
+class ZOO_SQUID_POSTGRESQL_API notification_hub final
+{
+	class impl;
+	std::shared_ptr<impl> pimpl_;
+
+public:
+	/// Subscriber of a channel, called with the notifications of that channel that were received together
+	using handler_type = std::function<void(std::span<const notification> notifications)>;
+
+	/// Called with the error when the hub stops because waiting for notifications failed
+	using error_handler_type = std::function<void(std::exception_ptr error)>;
+
+	/// A subscription to a channel, it unsubscribes when it is destroyed
+	class ZOO_SQUID_POSTGRESQL_API subscription final
+	{
+		std::weak_ptr<impl> hub_;
+		std::uint64_t       id_;
+
+	public:
+		subscription();
+		subscription(std::weak_ptr<impl> hub, std::uint64_t id);
+		~subscription() noexcept;
+
+		subscription(subscription&& src) noexcept;
+		subscription& operator=(subscription&& src) noexcept;
+
+		subscription(const subscription&)            = delete;
+		subscription& operator=(const subscription&) = delete;
+
+		/// Check whether this subscription has not been reset
+		explicit operator bool() const noexcept;
+
+		/// Unsubscribe.
+		/// Notifications that were already drained from the connection may still be delivered.
+		void reset() noexcept;
+	};
+
+	/// Create a hub that waits for notifications on @a connection, using @a ioc to call the subscribers
+	/// and @a on_error, if any.
+	notification_hub(boost::asio::io_context& ioc, connection&& connection, error_handler_type on_error = {});
+
+	/// Stops waiting for notifications. Subscriptions that outlive the hub have no effect.
+	~notification_hub() noexcept;
+
+	notification_hub(notification_hub&&) noexcept;
+	notification_hub& operator=(notification_hub&&) noexcept;
+
+	notification_hub(const notification_hub&)            = delete;
+	notification_hub& operator=(const notification_hub&) = delete;
+
+	/// Subscribe @a handler to @a channel, executing LISTEN if this is the first subscriber of the channel.
+	/// The channel name is an identifier, it is quoted, so it is case sensitive.
+	[[nodiscard]] subscription subscribe(std::string_view channel, handler_type handler);
+
+	/// Get the number of channels that are listened to
+	std::size_t channel_count() const;
+
+	/// Check whether the hub stopped waiting for notifications, because of an error
+	bool stopped() const;
+};
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
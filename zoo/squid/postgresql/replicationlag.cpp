@@ -0,0 +1,46 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/postgresql/replicationlag.h"
+#include "zoo/squid/postgresql/error.h"
+
+#include "zoo/squid/core/statement.h"
+
+#include "zoo/common/misc/throw_exception.h"
+
+#include <cmath>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+namespace {
+
+// pg_last_wal_receive_lsn() is null on a primary, which makes the whole expression null
+constexpr auto lag_query = "SELECT COALESCE(CASE WHEN pg_last_wal_receive_lsn() = pg_last_wal_replay_lsn() THEN 0"
+                           " ELSE EXTRACT(EPOCH FROM now() - pg_last_xact_replay_timestamp()) END, 0)";
+
+} // namespace
+
+std::chrono::milliseconds replication_lag(squid::connection& connection)
+{
+	double seconds{};
+
+	squid::statement st{ connection, lag_query };
+	st.bind_results(seconds);
+	st.execute();
+	if (!st.fetch())
+	{
+		ZOO_THROW_EXCEPTION(error{ "The replication lag query returned no row" });
+	}
+
+	return std::chrono::milliseconds{ std::llround(std::max(seconds, 0.0) * 1000.0) };
+}
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,27 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/postgresql/config.h"
+#include "zoo/squid/core/connectionfwd.h"
+
+#include <chrono>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+/// Measure the replication lag of the server that @a connection is connected to.
+/// This is the age of the last replayed transaction while the replica has WAL left to replay, and zero when it
+/// has replayed everything it received or when the server is not a replica.
+/// Suitable as the lag probe of a routing_pool.
+ZOO_SQUID_POSTGRESQL_API std::chrono::milliseconds replication_lag(squid::connection& connection);
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
@@ -6,11 +6,11 @@
 //
 
 #include "zoo/squid/postgresql/resultset.h"
+#include "zoo/squid/postgresql/row.h"
 #include "zoo/squid/postgresql/tuple.h"
 #include "zoo/squid/postgresql/detail/conversions.h"
 #include "zoo/squid/postgresql/detail/ipqapi.h"
 #include "zoo/common/conversion/conversion.h"
-#include "zoo/common/conversion/conversion.h"
 #include "zoo/common/misc/quoted_c.h"
 
 #include <fmt/format.h>
@@ -18,8 +18,8 @@
 #include <vector>
 #include <algorithm>
 #include <stdexcept>
-#include <map>
 #include <string_view>
+#include <unordered_map>
 
 namespace zoo {
 namespace squid {
@@ -60,6 +60,21 @@ bool string_to_bool(std::string_view value)
 	}
 }
 
+void ensure_field_index(std::size_t field_index, std::size_t field_count)
+{
+	if (field_index >= field_count)
+	{
+		if (field_count)
+		{
+			throw std::out_of_range{ fmt::format("Field index {} is out of range [0, {}]", field_index, field_count - 1u) };
+		}
+		else
+		{
+			throw std::out_of_range{ "Field set is empty" };
+		}
+	}
+}
+
 } // namespace
 
 //================//
@@ -68,14 +83,28 @@ bool string_to_bool(std::string_view value)
 
 struct resultset_data
 {
-	ipq_api*                                    api;
-	std::shared_ptr<PGresult>                   pgresult;
-	PGresult*                                   res;
-	std::uint64_t                               affected_rows;
-	std::size_t                                 tuple_count;
-	std::size_t                                 field_count;
-	std::map<std::string_view, std::size_t>     field_name_index_map;
-	mutable std::vector<std::unique_ptr<tuple>> cache_;
+	ipq_api*                                          api;
+	std::shared_ptr<PGresult>                         pgresult;
+	PGresult*                                         res;
+	std::uint64_t                                     affected_rows;
+	std::size_t                                       tuple_count;
+	std::size_t                                       field_count;
+	std::vector<std::string_view>                     field_names;
+	std::unordered_map<std::string_view, std::size_t> field_name_index_map;
+	mutable std::vector<std::unique_ptr<tuple>>       cache_;
+
+	resultset_data()
+	    : api{}
+	    , pgresult{}
+	    , res{}
+	    , affected_rows{}
+	    , tuple_count{}
+	    , field_count{}
+	    , field_names{}
+	    , field_name_index_map{}
+	    , cache_{}
+	{
+	}
 
 	explicit resultset_data(ipq_api* api, std::shared_ptr<PGresult> pgresult)
 	    : api{ api }
@@ -84,12 +113,53 @@ struct resultset_data
 	    , affected_rows{ get_affected_rows(api, res) }
 	    , tuple_count{ static_cast<std::size_t>(std::max(0, api->ntuples(res))) }
 	    , field_count{ static_cast<std::size_t>(std::max(0, api->nfields(res))) }
+	    , field_names{}
 	    , field_name_index_map{}
 	    , cache_{ tuple_count }
 	{
+		// Field names are resolved once, so that accessing fields by name does not call PQfname for every row
+		field_names.reserve(field_count);
+		field_name_index_map.reserve(field_count);
 		for (std::size_t field_index = 0; field_index < field_count; ++field_index)
 		{
-			field_name_index_map[api->fname(res, field_index)] = field_index;
+			field_names.emplace_back(api->fname(res, field_index));
+			// Of multiple fields with the same name, the last one wins
+			field_name_index_map.insert_or_assign(field_names.back(), field_index);
+		}
+	}
+
+	std::optional<std::size_t> find_field_index(std::string_view field_name) const
+	{
+		const auto it = field_name_index_map.find(field_name);
+		if (it == field_name_index_map.end())
+		{
+			return std::nullopt;
+		}
+		else
+		{
+			return it->second;
+		}
+	}
+
+	std::size_t get_field_index(std::string_view field_name) const
+	{
+		const auto index = find_field_index(field_name);
+		if (!index)
+		{
+			throw std::out_of_range{ fmt::format("Field {} not found", quoted_c(field_name)) };
+		}
+		return index.value();
+	}
+
+	field get_field(std::size_t tuple_index, std::size_t field_index) const
+	{
+		if (api->getisnull(res, tuple_index, field_index))
+		{
+			return field{ field_names[field_index] };
+		}
+		else
+		{
+			return field{ field_names[field_index], api->getvalue(res, tuple_index, field_index) };
 		}
 	}
 };
@@ -98,6 +168,11 @@ struct resultset_data
 // resultset //
 //===========//
 
+resultset::resultset()
+    : data_{ std::make_unique<resultset_data>() }
+{
+}
+
 resultset::resultset(ipq_api* api, std::shared_ptr<PGresult> pgresult)
     : data_{ std::make_unique<resultset_data>(api, std::move(pgresult)) }
 {
@@ -144,6 +219,37 @@ const tuple& resultset::get_tuple(std::size_t tuple_index) const
 	}
 }
 
+std::size_t resultset::field_count() const
+{
+	return data_->field_count;
+}
+
+std::size_t resultset::field_index(std::string_view field_name) const
+{
+	return data_->get_field_index(field_name);
+}
+
+row resultset::get_row(std::size_t row_index) const
+{
+	if (row_index < data_->tuple_count)
+	{
+		return row{ data_.get(), row_index };
+	}
+	else if (data_->tuple_count)
+	{
+		throw std::out_of_range{ fmt::format("Row index {} is out of range [0, {}]", row_index, data_->tuple_count - 1u) };
+	}
+	else
+	{
+		throw std::out_of_range{ "Resultset is empty" };
+	}
+}
+
+row_range resultset::rows() const
+{
+	return row_range{ data_.get(), data_->tuple_count };
+}
+
 resultset_iterator resultset::begin() const
 {
 	return resultset_iterator{ this, 0 };
@@ -165,14 +271,7 @@ tuple::tuple(const resultset_data* data, std::size_t tuple_index)
 	fields_.reserve(data->field_count);
 	for (std::size_t field_index = 0; field_index < data->field_count; ++field_index)
 	{
-		if (data->api->getisnull(data->res, tuple_index, field_index))
-		{
-			fields_.emplace_back(data->api->fname(data->res, field_index));
-		}
-		else
-		{
-			fields_.emplace_back(data->api->fname(data->res, field_index), data->api->getvalue(data->res, tuple_index, field_index));
-		}
+		fields_.push_back(data->get_field(tuple_index, field_index));
 	}
 }
 
@@ -211,44 +310,19 @@ bool tuple::empty() const noexcept
 
 const field& tuple::get_field(std::size_t field_index) const
 {
-	if (field_index < fields_.size())
-	{
-		return fields_.at(field_index);
-	}
-	else if (fields_.size())
-	{
-		throw std::out_of_range{ fmt::format("Field index {} is out of range [0, {}]", field_index, fields_.size() - 1u) };
-	}
-	else
-	{
-		throw std::out_of_range{ "Field set is empty" };
-	}
+	ensure_field_index(field_index, fields_.size());
+	return fields_[field_index];
 }
 
 const field& tuple::get_field(std::string_view field_name) const
 {
-	const auto it = data_->field_name_index_map.find(field_name);
-	if (it == data_->field_name_index_map.end())
-	{
-		throw std::out_of_range{ fmt::format("Field {} not found", quoted_c(field_name)) };
-	}
-	else
-	{
-		return get_field(it->second);
-	}
+	return get_field(data_->get_field_index(field_name));
 }
 
 const field* tuple::find_field(std::string_view field_name) const
 {
-	const auto it = data_->field_name_index_map.find(field_name);
-	if (it == data_->field_name_index_map.end())
-	{
-		return nullptr;
-	}
-	else
-	{
-		return &get_field(it->second);
-	}
+	const auto index = data_->find_field_index(field_name);
+	return index ? &get_field(index.value()) : nullptr;
 }
 
 const field& tuple::operator[](std::size_t field_index) const
@@ -261,6 +335,57 @@ const field& tuple::operator[](std::string_view field_name) const
 	return get_field(field_name);
 }
 
+//=====//
+// row //
+//=====//
+
+row::row(const resultset_data* data, std::size_t row_index) noexcept
+    : data_{ data }
+    , row_index_{ row_index }
+{
+}
+
+std::size_t row::index() const noexcept
+{
+	return row_index_;
+}
+
+std::size_t row::size() const noexcept
+{
+	return data_->field_count;
+}
+
+bool row::empty() const noexcept
+{
+	return data_->field_count == 0u;
+}
+
+field row::get_field(std::size_t field_index) const
+{
+	ensure_field_index(field_index, data_->field_count);
+	return data_->get_field(row_index_, field_index);
+}
+
+field row::get_field(std::string_view field_name) const
+{
+	return data_->get_field(row_index_, data_->get_field_index(field_name));
+}
+
+std::optional<field> row::find_field(std::string_view field_name) const
+{
+	return data_->find_field_index(field_name).transform([this](std::size_t field_index) { return data_->get_field(row_index_, field_index); });
+}
+
+field row::operator[](std::size_t field_index) const
+{
+	return get_field(field_index);
+}
+
+field row::operator[](std::string_view field_name) const
+{
+	return get_field(field_name);
+}
+
 //=======//
 // field //
 //=======//
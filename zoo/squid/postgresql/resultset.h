@@ -7,23 +7,28 @@
 
 #pragma once
 
+#include "zoo/squid/postgresql/config.h"
 #include "zoo/squid/postgresql/resultsetdatafwd.h"
 #include "zoo/squid/postgresql/resultsetiterator.h"
+#include "zoo/squid/postgresql/row.h"
 #include "zoo/squid/postgresql/tuplefwd.h"
 #include "zoo/squid/postgresql/detail/libpqfwd.h"
 #include "zoo/squid/postgresql/detail/ipqapifwd.h"
 
 #include <memory>
+#include <string_view>
 
 namespace zoo {
 namespace squid {
 namespace postgresql {
 
-class resultset final
+class ZOO_SQUID_POSTGRESQL_API resultset final
 {
 	std::unique_ptr<resultset_data> data_;
 
 public:
+	/// Create an empty resultset
+	resultset();
 	explicit resultset(ipq_api* api, std::shared_ptr<PGresult> pgresult);
 	~resultset() noexcept;
 
@@ -39,6 +44,20 @@ public:
 
 	const tuple& get_tuple(std::size_t tuple_index) const;
 
+	std::size_t field_count() const;
+
+	/// Get the index of the field named @a field_name, to access fields of many rows by index.
+	/// Throws std::out_of_range if there is no such field.
+	std::size_t field_index(std::string_view field_name) const;
+
+	/// Get a lightweight view of a row, see class row.
+	/// Throws std::out_of_range if @a row_index is not less than size().
+	row get_row(std::size_t row_index) const;
+
+	/// Iterate over the rows with lightweight views, without allocating.
+	/// Unlike begin() and end(), which create a tuple for every row, with all its fields.
+	row_range rows() const;
+
 	resultset_iterator begin() const;
 	resultset_iterator end() const;
 };
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include "zoo/squid/postgresql/config.h"
 #include "zoo/squid/postgresql/resultsetfwd.h"
 #include "zoo/squid/postgresql/tuplefwd.h"
 
@@ -16,7 +17,7 @@ namespace zoo {
 namespace squid {
 namespace postgresql {
 
-class resultset_iterator
+class ZOO_SQUID_POSTGRESQL_API resultset_iterator
 {
 public:
 	using iterator_category = std::random_access_iterator_tag;
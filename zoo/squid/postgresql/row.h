@@ -0,0 +1,193 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/postgresql/config.h"
+#include "zoo/squid/postgresql/field.h"
+#include "zoo/squid/postgresql/resultsetdatafwd.h"
+
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <string_view>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+/// Lightweight view of a row of a resultset.
+/// Unlike tuple, it does not copy anything: fields are read from the PGresult when they are requested,
+/// so it is cheap to create and to copy. It is only valid as long as the resultset exists.
+class ZOO_SQUID_POSTGRESQL_API row final
+{
+	const resultset_data* data_;
+	std::size_t           row_index_;
+
+public:
+	explicit row(const resultset_data* data, std::size_t row_index) noexcept;
+
+	std::size_t index() const noexcept;
+
+	std::size_t size() const noexcept;
+	bool        empty() const noexcept;
+
+	/// Throws std::out_of_range if @a field_index is not less than size()
+	field get_field(std::size_t field_index) const;
+
+	/// Lookup by name uses a hash table that is built once per resultset.
+	/// For the fastest access in a loop, resolve the index with resultset::field_index() up front.
+	/// Throws std::out_of_range if there is no field named @a field_name.
+	field get_field(std::string_view field_name) const;
+
+	std::optional<field> find_field(std::string_view field_name) const;
+
+	field operator[](std::size_t field_index) const;
+	field operator[](std::string_view field_name) const;
+};
+
+/// Random access iterator over the rows of a resultset, dereferencing to a row by value
+class ZOO_SQUID_POSTGRESQL_API row_iterator final
+{
+	const resultset_data* data_;
+	std::ptrdiff_t        index_;
+
+public:
+	using iterator_concept  = std::random_access_iterator_tag;
+	using iterator_category = std::input_iterator_tag;
+	using value_type        = row;
+	using difference_type   = std::ptrdiff_t;
+	using reference         = row;
+
+	row_iterator() noexcept
+	    : data_{}
+	    , index_{}
+	{
+	}
+
+	explicit row_iterator(const resultset_data* data, difference_type index) noexcept
+	    : data_{ data }
+	    , index_{ index }
+	{
+	}
+
+	row operator*() const noexcept
+	{
+		return row{ this->data_, static_cast<std::size_t>(this->index_) };
+	}
+
+	row operator[](difference_type n) const noexcept
+	{
+		return row{ this->data_, static_cast<std::size_t>(this->index_ + n) };
+	}
+
+	row_iterator& operator++() noexcept
+	{
+		++this->index_;
+		return *this;
+	}
+
+	row_iterator operator++(int) noexcept
+	{
+		auto tmp = *this;
+		++this->index_;
+		return tmp;
+	}
+
+	row_iterator& operator--() noexcept
+	{
+		--this->index_;
+		return *this;
+	}
+
+	row_iterator operator--(int) noexcept
+	{
+		auto tmp = *this;
+		--this->index_;
+		return tmp;
+	}
+
+	row_iterator& operator+=(difference_type n) noexcept
+	{
+		this->index_ += n;
+		return *this;
+	}
+
+	row_iterator& operator-=(difference_type n) noexcept
+	{
+		this->index_ -= n;
+		return *this;
+	}
+
+	row_iterator operator+(difference_type n) const noexcept
+	{
+		return row_iterator{ this->data_, this->index_ + n };
+	}
+
+	friend row_iterator operator+(difference_type n, const row_iterator& it) noexcept
+	{
+		return it + n;
+	}
+
+	row_iterator operator-(difference_type n) const noexcept
+	{
+		return row_iterator{ this->data_, this->index_ - n };
+	}
+
+	difference_type operator-(const row_iterator& other) const noexcept
+	{
+		return this->index_ - other.index_;
+	}
+
+	bool operator==(const row_iterator& other) const noexcept
+	{
+		return this->index_ == other.index_ && this->data_ == other.data_;
+	}
+
+	auto operator<=>(const row_iterator& other) const noexcept
+	{
+		return this->index_ <=> other.index_;
+	}
+};
+
+/// The rows of a resultset, see resultset::rows()
+class ZOO_SQUID_POSTGRESQL_API row_range final
+{
+	const resultset_data* data_;
+	std::size_t           size_;
+
+public:
+	explicit row_range(const resultset_data* data, std::size_t size) noexcept
+	    : data_{ data }
+	    , size_{ size }
+	{
+	}
+
+	row_iterator begin() const noexcept
+	{
+		return row_iterator{ this->data_, 0 };
+	}
+
+	row_iterator end() const noexcept
+	{
+		return row_iterator{ this->data_, static_cast<std::ptrdiff_t>(this->size_) };
+	}
+
+	std::size_t size() const noexcept
+	{
+		return this->size_;
+	}
+
+	bool empty() const noexcept
+	{
+		return this->size_ == 0u;
+	}
+};
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
@@ -20,34 +20,116 @@
 #include "zoo/common/logging/logging.h"
 #include "zoo/common/misc/throw_exception.h"
 
+#include <algorithm>
+#include <exception>
 #include <optional>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+#include <vector>
 #include <cassert>
+#include <cstring>
 
 namespace zoo {
 namespace squid {
 namespace postgresql {
 
+namespace {
+
+// SQLSTATE invalid_sql_statement_name, e.g. a cached prepared statement that no longer exists after a connection reset
+constexpr auto sqlstate_invalid_sql_statement_name = "26000";
+
+// A field of a tuple, converted to the type of its column_batch column
+struct column_field final
+{
+	std::variant<std::int64_t, double, std::string_view> value;
+	bool                                                 is_null;
+};
+
+// Convert field @a field of tuple @a row of @a res to @a type
+column_field convert_field(ipq_api& api, const PGresult* res, int row, int field, column_type type)
+{
+	const auto is_null = 0 != api.getisnull(res, row, field);
+	const auto text    = is_null ? std::string_view{} : std::string_view{ api.getvalue(res, row, field) };
+	switch (type)
+	{
+	case column_type::int64:
+		return column_field{ is_null ? std::int64_t{} : conversion::string_to_number<std::int64_t>(text), is_null };
+	case column_type::float64:
+		return column_field{ is_null ? 0.0 : conversion::string_to_number<double>(text), is_null };
+	case column_type::text:
+		break;
+	}
+	return column_field{ text, is_null };
+}
+
+// Append the converted fields of one tuple to the columns of @a batch
+void append_row(column_batch& batch, const std::vector<column_field>& row)
+{
+	for (auto index = std::size_t{}; index < row.size(); ++index)
+	{
+		auto& column = batch.column(index);
+		column.nulls().push_back(row[index].is_null);
+		std::visit(
+		    [&column](auto value) {
+			    if constexpr (std::is_same_v<decltype(value), std::int64_t>)
+			    {
+				    column.int64_values().push_back(value);
+			    }
+			    else if constexpr (std::is_same_v<decltype(value), double>)
+			    {
+				    column.float64_values().push_back(value);
+			    }
+			    else
+			    {
+				    column.text_values().push_back(value);
+			    }
+		    },
+		    row[index].value);
+	}
+	batch.set_rows(batch.rows() + 1u);
+}
+
+} // namespace
+
 class statement::impl final
 {
-	ipq_api*                          api_;
-	std::shared_ptr<PGconn>           connection_;
-	std::unique_ptr<postgresql_query> query_;
-	bool                              reuse_statement_;
-	bool                              prepared_;
-	std::optional<std::string>        stmt_name_;
-	std::optional<exec_result>        exec_result_;
-	std::unique_ptr<query_results>    query_results_;
+	ipq_api*                                api_;
+	std::shared_ptr<PGconn>                 connection_;
+	std::shared_ptr<const postgresql_query> query_;
+	bool                                    reuse_statement_;
+	bool                                    prepared_;
+	std::optional<std::string>              stmt_name_;
+	std::shared_ptr<statement_name_cache>   cache_;
+	std::string                             cache_key_;
+	bool                                    cached_; // true if the prepared statement was taken from the cache
+	std::optional<exec_result>              exec_result_;
+	std::unique_ptr<query_results>          query_results_;
+	std::optional<query_parameters>         query_params_; // kept to reuse the value buffers
+	fetch_mode                              fetch_mode_;
+	bool                                    streaming_; // true while results of a streaming execution are pending
 
 public:
-	explicit impl(ipq_api* api, std::shared_ptr<PGconn> connection, std::string_view query, bool reuse_statement)
+	explicit impl(ipq_api*                              api,
+	              std::shared_ptr<PGconn>               connection,
+	              std::string_view                      query,
+	              bool                                  reuse_statement,
+	              std::shared_ptr<statement_name_cache> cache)
 	    : api_{ api }
 	    , connection_{ std::move(connection) }
-	    , query_{ std::make_unique<postgresql_query>(query) }
+	    , query_{ postgresql_query::cached(query) }
 	    , reuse_statement_{ reuse_statement }
 	    , prepared_{}
 	    , stmt_name_{}
+	    , cache_{ reuse_statement ? std::move(cache) : nullptr }
+	    , cache_key_{ this->cache_ ? normalize_query(query) : std::string{} }
+	    , cached_{}
 	    , exec_result_{}
 	    , query_results_{}
+	    , query_params_{}
+	    , fetch_mode_{ fetch_mode::buffered }
+	    , streaming_{}
 	{
 		assert(this->connection_);
 	}
@@ -56,7 +138,14 @@ public:
 	{
 		try
 		{
-			if (this->prepared_)
+			this->finish_streaming();
+
+			if (this->prepared_ && this->cache_)
+			{
+				assert(this->stmt_name_);
+				this->cache_->release(std::move(this->cache_key_), std::move(this->stmt_name_.value()));
+			}
+			else if (this->prepared_)
 			{
 				assert(this->stmt_name_);
 				std::shared_ptr<PGresult>{ this->api_->exec(connection_checker::check(this->api_, this->connection_),
@@ -70,6 +159,79 @@ public:
 		}
 	}
 
+	// Number of rows per PGresult in chunked rows mode
+	static constexpr int streaming_chunk_size = 256;
+
+	std::shared_ptr<PGresult> make_pgresult(PGresult* res)
+	{
+		return std::shared_ptr<PGresult>{ res, [this](PGresult* res) { this->api_->clear(res); } };
+	}
+
+	// Discard the results that are still pending after a streaming execution,
+	// so that the connection can be used again.
+	void finish_streaming()
+	{
+		if (this->streaming_)
+		{
+			this->streaming_ = false;
+			while (auto res = this->api_->getResult(this->connection_.get()))
+			{
+				this->api_->clear(res);
+			}
+		}
+	}
+
+	void set_row_mode(PGconn* connection)
+	{
+#ifdef LIBPQ_HAS_CHUNK_MODE
+		if (!this->api_->setChunkedRowsMode(connection, streaming_chunk_size))
+		{
+			ZOO_THROW_EXCEPTION(error{ this->api_, "PQsetChunkedRowsMode failed", *connection });
+		}
+#else
+		if (!this->api_->setSingleRowMode(connection))
+		{
+			ZOO_THROW_EXCEPTION(error{ this->api_, "PQsetSingleRowMode failed", *connection });
+		}
+#endif
+	}
+
+	// Get the next result of a streaming execution
+	std::shared_ptr<PGresult> next_streaming_result()
+	{
+		assert(this->streaming_);
+
+		auto pgresult = this->make_pgresult(this->api_->getResult(this->connection_.get()));
+		if (!pgresult)
+		{
+			this->streaming_ = false;
+			ZOO_THROW_EXCEPTION(error{ this->api_, "PQgetResult failed", *this->connection_ });
+		}
+
+		const auto status = this->api_->resultStatus(pgresult.get());
+#ifdef LIBPQ_HAS_CHUNK_MODE
+		if (PGRES_SINGLE_TUPLE == status || PGRES_TUPLES_CHUNK == status)
+#else
+		if (PGRES_SINGLE_TUPLE == status)
+#endif
+		{
+			this->exec_result_ = exec_result{ .pgresult = pgresult, .rows = this->api_->ntuples(pgresult.get()), .current_row = 0 };
+		}
+		else if (PGRES_TUPLES_OK == status || PGRES_COMMAND_OK == status)
+		{
+			// This is the final result, the rows (if any) have already been received.
+			this->exec_result_ = exec_result{ .pgresult = pgresult, .rows = 0, .current_row = 0 };
+			this->finish_streaming();
+		}
+		else
+		{
+			this->finish_streaming();
+			ZOO_THROW_EXCEPTION(error{ this->api_, "PQgetResult failed", *this->connection_, *pgresult });
+		}
+
+		return pgresult;
+	}
+
 	template<typename ResultsContainer>
 	void set_exec_result(std::shared_ptr<PGresult> pgresult, std::string_view exec_function, const ResultsContainer& results)
 	{
@@ -97,61 +259,177 @@ public:
 		}
 	}
 
+	void prepare()
+	{
+		if (this->cache_)
+		{
+			if (auto stmt_name = this->cache_->acquire(this->cache_key_))
+			{
+				ZOO_LOG(trace, "reusing prepared statement {}: {}", stmt_name.value(), this->query_->query());
+				this->stmt_name_ = std::move(stmt_name);
+				this->prepared_  = true;
+				this->cached_    = true;
+				return;
+			}
+		}
+
+		this->prepare_on_server();
+	}
+
+	void prepare_on_server()
+	{
+		if (!this->stmt_name_)
+		{
+			this->stmt_name_ = next_statement_name();
+		}
+
+		ZOO_LOG(trace, "preparing: {}", this->query_->query());
+
+		std::shared_ptr<PGresult> pgresult{ this->api_->prepare(connection_checker::check(this->api_, this->connection_),
+			                                                    this->stmt_name_->c_str(),
+			                                                    this->query_->query().c_str(),
+			                                                    this->query_->parameter_count(),
+			                                                    nullptr),
+			                                [this](PGresult* res) { this->api_->clear(res); } };
+		if (pgresult)
+		{
+			auto status = this->api_->resultStatus(pgresult.get());
+			if (PGRES_COMMAND_OK != status)
+			{
+				ZOO_THROW_EXCEPTION(error{ this->api_, "PQprepare failed", *this->connection_, *pgresult });
+			}
+			this->prepared_ = true;
+		}
+		else
+		{
+			ZOO_THROW_EXCEPTION(error{ this->api_, "PQprepare failed", *this->connection_ });
+		}
+	}
+
+	std::shared_ptr<PGresult> exec_prepared(const query_parameters& query_params)
+	{
+		assert(this->stmt_name_);
+
+		return this->make_pgresult(this->api_->execPrepared(connection_checker::check(this->api_, this->connection_),
+		                                                    this->stmt_name_->c_str(),
+		                                                    query_params.parameter_count(),
+		                                                    query_params.parameter_values(),
+		                                                    nullptr,
+		                                                    nullptr,
+		                                                    0));
+	}
+
+	bool is_invalid_statement_name(const std::shared_ptr<PGresult>& pgresult)
+	{
+		if (!pgresult || PGRES_FATAL_ERROR != this->api_->resultStatus(pgresult.get()))
+		{
+			return false;
+		}
+		const auto sqlstate = this->api_->resultErrorField(pgresult.get(), PG_DIAG_SQLSTATE);
+		return sqlstate && std::strcmp(sqlstate, sqlstate_invalid_sql_statement_name) == 0;
+	}
+
+	// Send the execution without waiting for the result
+	void send(PGconn* connection, const query_parameters& query_params)
+	{
+		if (this->reuse_statement_)
+		{
+			assert(this->stmt_name_);
+			if (this->api_->sendQueryPrepared(connection,
+			                                  this->stmt_name_->c_str(),
+			                                  query_params.parameter_count(),
+			                                  query_params.parameter_values(),
+			                                  nullptr,
+			                                  nullptr,
+			                                  0) != 1)
+			{
+				ZOO_THROW_EXCEPTION(error{ this->api_, "PQsendQueryPrepared failed", *connection });
+			}
+		}
+		else
+		{
+			if (this->api_->sendQueryParams(connection,
+			                                this->query_->query().c_str(),
+			                                query_params.parameter_count(),
+			                                nullptr,
+			                                query_params.parameter_values(),
+			                                nullptr,
+			                                nullptr,
+			                                0) != 1)
+			{
+				ZOO_THROW_EXCEPTION(error{ this->api_, "PQsendQueryParams failed", *connection });
+			}
+		}
+	}
+
+	template<typename ParametersContainer>
+	const query_parameters& assign_parameters(const ParametersContainer& parameters)
+	{
+		if (this->query_params_)
+		{
+			this->query_params_->assign(*this->query_, parameters);
+		}
+		else
+		{
+			this->query_params_.emplace(*this->query_, parameters);
+		}
+		return this->query_params_.value();
+	}
+
 	template<typename ResultsContainer>
-	void execute(const std::map<std::string, parameter>& parameters, const ResultsContainer& results)
+	void execute_streaming(const query_parameters& query_params, const ResultsContainer& results)
+	{
+		const auto connection = connection_checker::check(this->api_, this->connection_);
+
+		this->send(connection, query_params);
+
+		this->streaming_ = true;
+
+		this->set_row_mode(connection);
+
+		auto pgresult        = this->next_streaming_result();
+		this->query_results_ = std::make_unique<query_results>(this->api_, pgresult, results);
+	}
+
+	template<typename ParametersContainer, typename ResultsContainer>
+	void execute(const ParametersContainer& parameters, const ResultsContainer& results)
 	{
+		this->finish_streaming();
+
 		this->exec_result_ = std::nullopt;
 		this->query_results_.reset();
 
-		query_parameters query_params{ *this->query_, parameters };
+		const auto& query_params = this->assign_parameters(parameters);
 
 		assert(query_params.parameter_count() == this->query_->parameter_count());
 
-		if (this->reuse_statement_)
+		if (this->reuse_statement_ && !this->prepared_)
 		{
-			if (!this->prepared_)
-			{
-				if (!this->stmt_name_)
-				{
-					this->stmt_name_ = next_statement_name();
-				}
-
-				ZOO_LOG(trace, "preparing: {}", this->query_->query());
+			this->prepare();
+		}
 
-				std::shared_ptr<PGresult> pgresult{ this->api_->prepare(connection_checker::check(this->api_, this->connection_),
-					                                                    this->stmt_name_->c_str(),
-					                                                    this->query_->query().c_str(),
-					                                                    this->query_->parameter_count(),
-					                                                    nullptr),
-					                                [this](PGresult* res) { this->api_->clear(res); } };
-				if (pgresult)
-				{
-					auto status = this->api_->resultStatus(pgresult.get());
-					if (PGRES_COMMAND_OK != status)
-					{
-						ZOO_THROW_EXCEPTION(error{ this->api_, "PQprepare failed", *this->connection_, *pgresult });
-					}
-					this->prepared_ = true;
-				}
-				else
-				{
-					ZOO_THROW_EXCEPTION(error{ this->api_, "PQprepare failed", *this->connection_ });
-				}
+		if (fetch_mode::streaming == this->fetch_mode_)
+		{
+			this->execute_streaming(query_params, results);
+		}
+		else if (this->reuse_statement_)
+		{
+			auto pgresult = this->exec_prepared(query_params);
+			// Inside a transaction block the error aborted the transaction, so preparing again would fail as well.
+			// The error is reported instead, the statement is prepared again once the transaction is rolled back.
+			if (this->cached_ && this->is_invalid_statement_name(pgresult) &&
+			    PQTRANS_INERROR != this->api_->transactionStatus(this->connection_.get()))
+			{
+				// The cached prepared statement is gone (e.g. because the connection was reset), prepare it again.
+				ZOO_LOG(debug, "cached prepared statement {} no longer exists, preparing again", this->stmt_name_.value());
+				this->cached_   = false;
+				this->prepared_ = false;
+				this->stmt_name_.reset();
+				this->prepare_on_server();
+				pgresult = this->exec_prepared(query_params);
 			}
 
-			assert(this->stmt_name_);
-
-			this->set_exec_result(
-			    std::shared_ptr<PGresult>{ this->api_->execPrepared(connection_checker::check(this->api_, this->connection_),
-			                                                        this->stmt_name_->c_str(),
-			                                                        query_params.parameter_count(),
-			                                                        query_params.parameter_values(),
-			                                                        nullptr,
-			                                                        nullptr,
-			                                                        0),
-			                               [this](PGresult* res) { this->api_->clear(res); } },
-			    "PQexecPrepared",
-			    results);
+			this->set_exec_result(pgresult, "PQexecPrepared", results);
 		}
 		else
 		{
@@ -170,6 +448,182 @@ public:
 		}
 	}
 
+#ifdef LIBPQ_HAS_PIPELINING
+	// Number of executions that are sent before their results are read back in a pipelined batch.
+	// Reading back regularly keeps the server from blocking on a full send buffer while we are still sending.
+	// Each chunk ends with a sync, which commits it when the batch does not run in a transaction.
+	static constexpr std::size_t pipeline_chunk_size = 256;
+
+	// Read and discard the results up to and including the result of the last pipeline sync, so that pipeline mode can be left.
+	// Two nullptr results in a row mean that nothing is pending anymore, e.g. because the connection was lost.
+	void drain_pipeline(PGconn* connection)
+	{
+		auto nulls = 0;
+		while (nulls < 2)
+		{
+			const auto pgresult = this->make_pgresult(this->api_->getResult(connection));
+			if (!pgresult)
+			{
+				++nulls;
+			}
+			else if (PGRES_PIPELINE_SYNC == this->api_->resultStatus(pgresult.get()))
+			{
+				return;
+			}
+			else
+			{
+				nulls = 0;
+			}
+		}
+	}
+
+	// Send the executions of @a chunk in one pipeline and read back their results.
+	// Returns the number of affected rows.
+	template<typename ParametersContainer>
+	std::uint64_t run_pipeline(PGconn* connection, std::span<const ParametersContainer> chunk)
+	{
+		std::exception_ptr   send_failure{};
+		std::optional<error> failure{};
+		std::size_t          sent{};
+
+		// All executions that were sent must be synced and read back before leaving pipeline mode,
+		// so an error while sending only stops sending.
+		for (const auto& parameters : chunk)
+		{
+			try
+			{
+				this->send(connection, this->assign_parameters(parameters));
+				++sent;
+			}
+			catch (...)
+			{
+				send_failure = std::current_exception();
+				break;
+			}
+		}
+
+		if (this->api_->pipelineSync(connection) != 1)
+		{
+			ZOO_THROW_EXCEPTION(error{ this->api_, "PQpipelineSync failed", *connection });
+		}
+
+		auto rows = std::uint64_t{};
+		try
+		{
+			for (std::size_t index = 0; index < sent; ++index)
+			{
+				const auto pgresult = this->make_pgresult(this->api_->getResult(connection));
+				if (!pgresult)
+				{
+					ZOO_THROW_EXCEPTION(error{ this->api_, "PQgetResult failed", *connection });
+				}
+
+				const auto status = this->api_->resultStatus(pgresult.get());
+				if (PGRES_COMMAND_OK == status || PGRES_TUPLES_OK == status)
+				{
+					const auto num = this->api_->cmdTuples(pgresult.get());
+					if (num && *num)
+					{
+						rows += conversion::string_to_number<std::uint64_t>(num);
+					}
+				}
+				else if (PGRES_PIPELINE_ABORTED != status && !failure)
+				{
+					// The executions after this one in the same pipeline are aborted
+					failure.emplace(this->api_, "Batch execution failed", *connection, *pgresult);
+				}
+
+				// The results of each execution are terminated by a nullptr
+				while (auto res = this->api_->getResult(connection))
+				{
+					this->api_->clear(res);
+				}
+			}
+
+			const auto sync = this->make_pgresult(this->api_->getResult(connection));
+			if (!sync || PGRES_PIPELINE_SYNC != this->api_->resultStatus(sync.get()))
+			{
+				ZOO_THROW_EXCEPTION(error{ this->api_, "PQgetResult did not return the pipeline sync result", *connection });
+			}
+		}
+		catch (...)
+		{
+			this->drain_pipeline(connection);
+			throw;
+		}
+
+		if (failure)
+		{
+			ZOO_THROW_EXCEPTION(failure.value());
+		}
+		if (send_failure)
+		{
+			std::rethrow_exception(send_failure);
+		}
+
+		return rows;
+	}
+#endif
+
+	template<typename ParametersContainer>
+	std::uint64_t execute_batch(std::span<const ParametersContainer> batch)
+	{
+		this->finish_streaming();
+
+		this->exec_result_ = std::nullopt;
+		this->query_results_.reset();
+
+		if (batch.empty())
+		{
+			return 0;
+		}
+
+		if (this->reuse_statement_ && !this->prepared_)
+		{
+			this->prepare();
+		}
+
+		auto rows = std::uint64_t{};
+
+#ifdef LIBPQ_HAS_PIPELINING
+		const auto connection = connection_checker::check(this->api_, this->connection_);
+
+		if (this->api_->enterPipelineMode(connection) != 1)
+		{
+			ZOO_THROW_EXCEPTION(error{ this->api_, "PQenterPipelineMode failed", *connection });
+		}
+
+		try
+		{
+			for (std::size_t first = 0; first < batch.size(); first += pipeline_chunk_size)
+			{
+				rows += this->run_pipeline(connection, batch.subspan(first, std::min(pipeline_chunk_size, batch.size() - first)));
+			}
+		}
+		catch (...)
+		{
+			// run_pipeline() has read back the results of the failed chunk, the chunks before it are not rolled back
+			this->api_->exitPipelineMode(connection);
+			throw;
+		}
+
+		if (this->api_->exitPipelineMode(connection) != 1)
+		{
+			ZOO_THROW_EXCEPTION(error{ this->api_, "PQexitPipelineMode failed", *connection });
+		}
+#else
+		// Without pipelining support in libpq, execute one at a time
+		const std::vector<result> no_results{};
+		for (const auto& parameters : batch)
+		{
+			this->execute(parameters, no_results);
+			rows += this->affected_rows();
+		}
+#endif
+
+		return rows;
+	}
+
 	bool fetch()
 	{
 		if (!this->exec_result_ || !this->query_results_)
@@ -177,18 +631,76 @@ public:
 			ZOO_THROW_EXCEPTION(error{ "Cannot fetch tuple from a statement that has not been executed" });
 		}
 
-		auto& exec_result = this->exec_result_.value();
-
-		if (exec_result.current_row == exec_result.rows)
+		while (this->exec_result_->current_row == this->exec_result_->rows)
 		{
-			return false;
+			if (!this->streaming_)
+			{
+				return false;
+			}
+			this->query_results_->set_pgresult(this->next_streaming_result());
 		}
 
-		this->query_results_->fetch(exec_result.current_row++);
+		this->query_results_->fetch(this->exec_result_->current_row++);
 
 		return true;
 	}
 
+	std::size_t fetch_columns(column_batch& batch, std::size_t batch_size)
+	{
+		if (!this->exec_result_ || !this->query_results_)
+		{
+			ZOO_THROW_EXCEPTION(error{ "Cannot fetch tuples from a statement that has not been executed" });
+		}
+
+		// A tuple is appended only when all of its fields converted, and the cursor moves past it only then.
+		// A conversion error thus leaves the batch with the complete tuples before it.
+		std::vector<column_field> row{};
+		row.reserve(batch.column_count());
+
+		auto rows = std::size_t{};
+		while (rows < batch_size)
+		{
+			if (this->exec_result_->current_row == this->exec_result_->rows)
+			{
+				if (!this->streaming_)
+				{
+					break;
+				}
+				this->query_results_->set_pgresult(this->next_streaming_result());
+				continue;
+			}
+
+			const auto res = this->exec_result_->pgresult.get();
+			if (batch.column_count() > static_cast<std::size_t>(this->api_->nfields(res)))
+			{
+				ZOO_THROW_EXCEPTION(error{ "The column batch has more columns than the result" });
+			}
+
+			const auto tuple = this->exec_result_->current_row;
+			row.clear();
+			for (auto field = std::size_t{}; field < batch.column_count(); ++field)
+			{
+				row.push_back(convert_field(*this->api_, res, tuple, static_cast<int>(field), batch.column(field).type()));
+			}
+			append_row(batch, row);
+
+			++this->exec_result_->current_row;
+			++rows;
+		}
+
+		return rows;
+	}
+
+	void set_fetch_mode(fetch_mode mode)
+	{
+		this->fetch_mode_ = mode;
+	}
+
+	const binding_plan* parameter_binding_plan() const
+	{
+		return &this->query_->plan();
+	}
+
 	std::size_t field_count()
 	{
 		if (this->query_results_)
@@ -231,9 +743,13 @@ public:
 	}
 };
 
-statement::statement(ipq_api* api, std::shared_ptr<PGconn> connection, std::string_view query, bool reuse_statement)
+statement::statement(ipq_api*                              api,
+                     std::shared_ptr<PGconn>               connection,
+                     std::string_view                      query,
+                     bool                                  reuse_statement,
+                     std::shared_ptr<statement_name_cache> cache)
     : ibackend_statement{}
-    , pimpl_{ std::make_unique<impl>(api, connection, query, reuse_statement) }
+    , pimpl_{ std::make_unique<impl>(api, connection, query, reuse_statement, std::move(cache)) }
 {
 }
 
@@ -253,11 +769,41 @@ void statement::execute(const std::map<std::string, parameter>& parameters, cons
 	this->pimpl_->execute(parameters, results);
 }
 
+void statement::execute_positional(const positional_parameters& parameters, const std::vector<result>& results)
+{
+	this->pimpl_->execute(parameters, results);
+}
+
+void statement::execute_positional(const positional_parameters& parameters, const std::map<std::string, result>& results)
+{
+	this->pimpl_->execute(parameters, results);
+}
+
+std::uint64_t statement::execute_batch(std::span<const std::map<std::string, parameter>> batch)
+{
+	return this->pimpl_->execute_batch(batch);
+}
+
+std::uint64_t statement::execute_batch_positional(std::span<const positional_parameters> batch)
+{
+	return this->pimpl_->execute_batch(batch);
+}
+
+const binding_plan* statement::parameter_binding_plan() const
+{
+	return this->pimpl_->parameter_binding_plan();
+}
+
 bool statement::fetch()
 {
 	return this->pimpl_->fetch();
 }
 
+std::size_t statement::fetch_columns(column_batch& batch, std::size_t batch_size)
+{
+	return this->pimpl_->fetch_columns(batch, batch_size);
+}
+
 std::size_t statement::field_count()
 {
 	return this->pimpl_->field_count();
@@ -273,6 +819,11 @@ std::uint64_t statement::affected_rows()
 	return this->pimpl_->affected_rows();
 }
 
+void statement::set_fetch_mode(fetch_mode mode)
+{
+	this->pimpl_->set_fetch_mode(mode);
+}
+
 /*static*/ void statement::execute(ipq_api* api, PGconn& connection, const std::string& query)
 {
 	std::shared_ptr<PGresult> result{ api->exec(&connection, query.c_str()), [api](PGresult* res) { api->clear(res); } };
@@ -11,6 +11,7 @@
 #include "zoo/squid/postgresql/detail/libpqfwd.h"
 #include "zoo/squid/postgresql/detail/ipqapifwd.h"
 #include "zoo/squid/core/ibackendstatement.h"
+#include "zoo/squid/core/statementcache.h"
 
 #include <memory>
 
@@ -18,13 +19,23 @@ namespace zoo {
 namespace squid {
 namespace postgresql {
 
+/// Cache of the names of idle server side prepared statements
+using statement_name_cache = statement_cache<std::string>;
+
 class ZOO_SQUID_POSTGRESQL_API statement final : public ibackend_statement
 {
 	class impl;
 	std::unique_ptr<impl> pimpl_;
 
 public:
-	statement(ipq_api* api, std::shared_ptr<PGconn> connection, std::string_view query, bool reuse_statement);
+	/// When @a reuse_statement is true and @a cache is given, a cached server side prepared statement
+	/// for the same query is reused and the statement is returned to @a cache when this object is destroyed,
+	/// instead of being prepared and deallocated every time.
+	statement(ipq_api*                              api,
+	          std::shared_ptr<PGconn>               connection,
+	          std::string_view                      query,
+	          bool                                  reuse_statement,
+	          std::shared_ptr<statement_name_cache> cache = {});
 	~statement() noexcept;
 
 	statement(statement&&);
@@ -35,14 +46,29 @@ public:
 
 	void execute(const std::map<std::string, parameter>& parameters, const std::vector<result>& results) override;
 	void execute(const std::map<std::string, parameter>& parameters, const std::map<std::string, result>& results) override;
+	void execute_positional(const positional_parameters& parameters, const std::vector<result>& results) override;
+	void execute_positional(const positional_parameters& parameters, const std::map<std::string, result>& results) override;
+
+	/// Executions are pipelined when libpq supports it, in chunks of 256 that each end with a pipeline sync.
+	/// Outside a transaction, every sync commits the executions of its chunk, so when an execution fails, the chunks
+	/// before it remain committed. Run the batch in a transaction to make it all or nothing.
+	std::uint64_t execute_batch(std::span<const std::map<std::string, parameter>> batch) override;
+	std::uint64_t execute_batch_positional(std::span<const positional_parameters> batch) override;
 
 	bool fetch() override;
+	/// Converts the text values of each column in one pass over the current PGresult.
+	/// In streaming mode, a batch can span several chunks.
+	std::size_t fetch_columns(column_batch& batch, std::size_t batch_size) override;
 
 	std::size_t field_count() override;
 	std::string field_name(std::size_t index) override;
 
 	std::uint64_t affected_rows() override;
 
+	void set_fetch_mode(fetch_mode mode) override;
+
+	const binding_plan* parameter_binding_plan() const override;
+
 	static void execute(ipq_api* api, PGconn& connection, const std::string& query);
 };
 
@@ -0,0 +1,416 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include <zoo/squid/postgresql/connection.h>
+#include <zoo/squid/postgresql/asyncpreparedstatement.h>
+#include <zoo/squid/postgresql/asynctransaction.h>
+#include <zoo/squid/postgresql/detail/pqapimock.h>
+
+#include <boost/asio/bind_cancellation_slot.hpp>
+#include <boost/asio/cancellation_signal.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/deferred.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+namespace {
+
+static constexpr auto g_connection_info = "the connection info";
+
+// A connected socket pair, with data pending on the socket that is handed to the async operations,
+// so that waiting for it to become readable completes immediately.
+class readable_socket final
+{
+	std::array<int, 2> fds_;
+
+public:
+	readable_socket()
+	    : fds_{ -1, -1 }
+	{
+		if (::socketpair(AF_UNIX, SOCK_STREAM, 0, this->fds_.data()) != 0 || ::write(this->fds_[1], "x", 1) != 1)
+		{
+			throw std::runtime_error{ "socketpair failed" };
+		}
+	}
+
+	~readable_socket()
+	{
+		::close(this->fds_[0]);
+		::close(this->fds_[1]);
+	}
+
+	readable_socket(const readable_socket&)            = delete;
+	readable_socket& operator=(const readable_socket&) = delete;
+
+	int fd() const
+	{
+		return this->fds_[0];
+	}
+};
+
+class AsyncTests : public testing::Test
+{
+protected:
+	pq_api_mock_nice api{};
+	readable_socket  socket{};
+
+	void SetUp() override
+	{
+		ON_CALL(this->api, connectdb(testing::_)).WillByDefault(testing::Return(pq_api_mock::test_connection));
+		ON_CALL(this->api, status(testing::_)).WillByDefault(testing::Return(CONNECTION_OK));
+		ON_CALL(this->api, socket(testing::_)).WillByDefault(testing::Return(this->socket.fd()));
+		ON_CALL(this->api, consumeInput(testing::_)).WillByDefault(testing::Return(1));
+		ON_CALL(this->api, sendQueryParams(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+		    .WillByDefault(testing::Return(1));
+		ON_CALL(this->api, sendPrepare(testing::_, testing::_, testing::_, testing::_, testing::_)).WillByDefault(testing::Return(1));
+		ON_CALL(this->api, sendQueryPrepared(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+		    .WillByDefault(testing::Return(1));
+	}
+};
+
+} // namespace
+
+TEST_F(AsyncTests, ExecCompletesWithTheLastResult)
+{
+	PGresult first{}, last{};
+
+	EXPECT_CALL(this->api, sendQueryParams(pq_api_mock::test_connection, testing::StrEq("SELECT 1; SELECT 2"), 0, testing::_, testing::_, testing::_, testing::_, 0))
+	    .Times(1);
+	EXPECT_CALL(this->api, getResult(pq_api_mock::test_connection))
+	    .WillOnce(testing::Return(&first))
+	    .WillOnce(testing::Return(&last))
+	    .WillOnce(testing::Return(nullptr));
+	EXPECT_CALL(this->api, resultStatus(testing::_)).WillRepeatedly(testing::Return(PGRES_TUPLES_OK));
+	EXPECT_CALL(this->api, ntuples(&first)).WillRepeatedly(testing::Return(1));
+	EXPECT_CALL(this->api, ntuples(&last)).WillRepeatedly(testing::Return(3));
+
+	boost::asio::io_context io{};
+	connection              conn{ this->api, g_connection_info };
+
+	std::optional<std::size_t> size{};
+	conn.exec(io, "SELECT 1; SELECT 2", {}, [&size](std::exception_ptr e, resultset result) {
+		EXPECT_FALSE(e);
+		size = result.size();
+	});
+
+	EXPECT_FALSE(size.has_value()); // never completes inline
+	io.run();
+	EXPECT_EQ(size, 3u);
+}
+
+TEST_F(AsyncTests, DeferredExecOwnsItsQuery)
+{
+	PGresult ok{};
+
+	EXPECT_CALL(this->api, sendQueryParams(pq_api_mock::test_connection, testing::StrEq("SELECT 1"), 0, testing::_, testing::_, testing::_, testing::_, 0))
+	    .Times(1);
+	EXPECT_CALL(this->api, getResult(pq_api_mock::test_connection)).WillOnce(testing::Return(&ok)).WillRepeatedly(testing::Return(nullptr));
+	EXPECT_CALL(this->api, resultStatus(&ok)).WillRepeatedly(testing::Return(PGRES_TUPLES_OK));
+
+	boost::asio::io_context io{};
+	connection              conn{ this->api, g_connection_info };
+
+	// The operation is initiated after the buffer of the query is gone
+	auto op = [&] {
+		auto query = std::string{ "SELECT 1" };
+		return conn.exec(io, query, {}, boost::asio::deferred);
+	}();
+
+	auto completed = false;
+	std::move(op)([&completed](std::exception_ptr e, resultset) {
+		EXPECT_FALSE(e);
+		completed = true;
+	});
+	io.run();
+	EXPECT_TRUE(completed);
+}
+
+TEST_F(AsyncTests, ExecCompletesWithAnException)
+{
+	PGresult failed{};
+
+	EXPECT_CALL(this->api, getResult(pq_api_mock::test_connection)).WillOnce(testing::Return(&failed)).WillOnce(testing::Return(nullptr));
+	EXPECT_CALL(this->api, resultStatus(&failed)).WillRepeatedly(testing::Return(PGRES_FATAL_ERROR));
+	EXPECT_CALL(this->api, resultErrorMessage(&failed)).WillRepeatedly(testing::Return("relation does not exist"));
+
+	boost::asio::io_context io{};
+	connection              conn{ this->api, g_connection_info };
+
+	std::optional<std::string> message{};
+	conn.exec(io, "SELECT * FROM nowhere", {}, [&message](std::exception_ptr e, resultset result) {
+		EXPECT_TRUE(result.empty());
+		try
+		{
+			std::rethrow_exception(e);
+		}
+		catch (const async_exception& ex)
+		{
+			message = ex.details().message;
+		}
+	});
+
+	io.run();
+	EXPECT_EQ(message, "relation does not exist");
+}
+
+TEST_F(AsyncTests, ExecIsCancelledOnTheServer)
+{
+	PGresult        cancelled{};
+	std::thread::id cancelled_on{};
+
+	EXPECT_CALL(this->api, getCancel(pq_api_mock::test_connection)).WillOnce(testing::Return(pq_api_mock::test_cancel));
+	EXPECT_CALL(this->api, cancel(pq_api_mock::test_cancel, testing::_, testing::_))
+	    .WillOnce(testing::Invoke([&cancelled_on](PGcancel*, char*, int) {
+		    cancelled_on = std::this_thread::get_id();
+		    return 1;
+	    }));
+	EXPECT_CALL(this->api, freeCancel(pq_api_mock::test_cancel)).Times(1);
+	EXPECT_CALL(this->api, getResult(pq_api_mock::test_connection)).WillOnce(testing::Return(&cancelled)).WillOnce(testing::Return(nullptr));
+	EXPECT_CALL(this->api, resultStatus(&cancelled)).WillRepeatedly(testing::Return(PGRES_FATAL_ERROR));
+	EXPECT_CALL(this->api, resultErrorMessage(&cancelled)).WillRepeatedly(testing::Return("canceling statement due to user request"));
+
+	boost::asio::io_context          io{};
+	boost::asio::cancellation_signal signal{};
+	connection                       conn{ this->api, g_connection_info };
+
+	std::exception_ptr error{};
+	conn.exec(io, "SELECT pg_sleep(60)", {}, boost::asio::bind_cancellation_slot(signal.slot(), [&error](std::exception_ptr e, resultset) {
+		          error = std::move(e);
+	          }));
+
+	signal.emit(boost::asio::cancellation_type::terminal);
+	io.run();
+	EXPECT_THROW(std::rethrow_exception(error), async_exception);
+
+	// The blocking PQcancel is not called on the thread that emits the slot, io.run() waits for it
+	EXPECT_NE(cancelled_on, std::thread::id{});
+	EXPECT_NE(cancelled_on, std::this_thread::get_id());
+
+	// The slot is cleared when the operation completes
+	signal.emit(boost::asio::cancellation_type::terminal);
+}
+
+TEST_F(AsyncTests, QueuedExecIsCancelledWithoutSendingIt)
+{
+	PGresult ok{};
+
+	EXPECT_CALL(this->api, sendQueryParams(pq_api_mock::test_connection, testing::StrEq("SELECT 1"), 0, testing::_, testing::_, testing::_, testing::_, 0));
+	EXPECT_CALL(this->api, sendQueryParams(testing::_, testing::StrEq("SELECT 2"), testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+	    .Times(0);
+	EXPECT_CALL(this->api, cancel(testing::_, testing::_, testing::_)).Times(0);
+	EXPECT_CALL(this->api, getResult(pq_api_mock::test_connection)).WillOnce(testing::Return(&ok)).WillRepeatedly(testing::Return(nullptr));
+	EXPECT_CALL(this->api, resultStatus(&ok)).WillRepeatedly(testing::Return(PGRES_TUPLES_OK));
+
+	boost::asio::io_context          io{};
+	boost::asio::cancellation_signal signal{};
+	connection                       conn{ this->api, g_connection_info };
+
+	std::exception_ptr error{};
+	conn.exec(io, "SELECT 1", {}, [](std::exception_ptr e, resultset) { EXPECT_FALSE(e); });
+	conn.exec(io, "SELECT 2", {}, boost::asio::bind_cancellation_slot(signal.slot(), [&error](std::exception_ptr e, resultset) {
+		          error = std::move(e);
+	          }));
+
+	// The second command waits for the first one, it is not sent when it is cancelled
+	signal.emit(boost::asio::cancellation_type::terminal);
+	io.run();
+	ASSERT_TRUE(error);
+	try
+	{
+		std::rethrow_exception(error);
+	}
+	catch (const async_exception& e)
+	{
+		EXPECT_EQ(e.details().ec, std::make_error_code(std::errc::operation_canceled));
+	}
+}
+
+TEST_F(AsyncTests, PrepareAndExecInCoroutine)
+{
+	PGresult prepared{}, executed{};
+
+	EXPECT_CALL(this->api, sendPrepare(pq_api_mock::test_connection, testing::_, testing::StrEq("SELECT $1"), 1, nullptr)).Times(1);
+	EXPECT_CALL(this->api, sendQueryPrepared(pq_api_mock::test_connection, testing::_, 1, testing::_, testing::_, testing::_, 0))
+	    .Times(2);
+	EXPECT_CALL(this->api, getResult(pq_api_mock::test_connection))
+	    .WillOnce(testing::Return(&prepared))
+	    .WillOnce(testing::Return(nullptr))
+	    .WillOnce(testing::Return(&executed))
+	    .WillOnce(testing::Return(nullptr))
+	    .WillOnce(testing::Return(&executed))
+	    .WillRepeatedly(testing::Return(nullptr));
+	EXPECT_CALL(this->api, resultStatus(&prepared)).WillRepeatedly(testing::Return(PGRES_COMMAND_OK));
+	EXPECT_CALL(this->api, resultStatus(&executed)).WillRepeatedly(testing::Return(PGRES_TUPLES_OK));
+	EXPECT_CALL(this->api, ntuples(&executed)).WillRepeatedly(testing::Return(1));
+
+	boost::asio::io_context io{};
+	connection              conn{ this->api, g_connection_info };
+
+	auto rows = std::size_t{};
+	boost::asio::co_spawn(
+	    io,
+	    [&]() -> boost::asio::awaitable<void> {
+		    auto statement = co_await conn.prepare(io, "SELECT :id", boost::asio::use_awaitable);
+
+		    // The parameters are copied when the operation is created, they need not outlive the returned awaitable
+		    const auto exec = [&statement](int id) { return statement->exec({ { "id", id } }, boost::asio::use_awaitable); };
+		    for (auto id = 1; id <= 2; ++id)
+		    {
+			    const auto result = co_await exec(id);
+			    rows += result.size();
+		    }
+	    },
+	    boost::asio::detached);
+
+	io.run();
+	EXPECT_EQ(rows, 2u);
+}
+
+TEST_F(AsyncTests, TransactionAcrossAwaits)
+{
+	PGresult ok{};
+
+	std::vector<std::string> commands{};
+	EXPECT_CALL(this->api, sendQueryParams(pq_api_mock::test_connection, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, 0))
+	    .WillRepeatedly(testing::DoAll(testing::WithArg<1>([&commands](const char* command) { commands.emplace_back(command); }),
+	                                   testing::Return(1)));
+	EXPECT_CALL(this->api, getResult(pq_api_mock::test_connection))
+	    .WillOnce(testing::Return(&ok))
+	    .WillOnce(testing::Return(nullptr))
+	    .WillOnce(testing::Return(&ok))
+	    .WillOnce(testing::Return(nullptr))
+	    .WillOnce(testing::Return(&ok))
+	    .WillRepeatedly(testing::Return(nullptr));
+	EXPECT_CALL(this->api, resultStatus(&ok)).WillRepeatedly(testing::Return(PGRES_COMMAND_OK));
+
+	boost::asio::io_context io{};
+	connection              conn{ this->api, g_connection_info };
+
+	boost::asio::co_spawn(
+	    io,
+	    [&]() -> boost::asio::awaitable<void> {
+		    async_transaction transaction{ conn, io };
+		    co_await transaction.begin(boost::asio::use_awaitable);
+		    co_await conn.exec(io, "DELETE FROM person", {}, boost::asio::use_awaitable);
+		    co_await transaction.commit(boost::asio::use_awaitable);
+	    },
+	    boost::asio::detached);
+
+	io.run();
+	EXPECT_EQ(commands, (std::vector<std::string>{ "BEGIN", "DELETE FROM person", "COMMIT" }));
+}
+
+TEST_F(AsyncTests, TransactionIsRolledBackWhenLeftUnfinished)
+{
+	PGresult ok{}, failed{};
+
+	std::vector<std::string> commands{};
+	EXPECT_CALL(this->api, sendQueryParams(pq_api_mock::test_connection, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, 0))
+	    .WillRepeatedly(testing::DoAll(testing::WithArg<1>([&commands](const char* command) { commands.emplace_back(command); }),
+	                                   testing::Return(1)));
+	EXPECT_CALL(this->api, getResult(pq_api_mock::test_connection))
+	    .WillOnce(testing::Return(&ok))
+	    .WillOnce(testing::Return(nullptr))
+	    .WillOnce(testing::Return(&failed))
+	    .WillOnce(testing::Return(nullptr))
+	    .WillOnce(testing::Return(&ok))
+	    .WillRepeatedly(testing::Return(nullptr));
+	EXPECT_CALL(this->api, resultStatus(&ok)).WillRepeatedly(testing::Return(PGRES_COMMAND_OK));
+	EXPECT_CALL(this->api, resultStatus(&failed)).WillRepeatedly(testing::Return(PGRES_FATAL_ERROR));
+
+	boost::asio::io_context io{};
+	connection              conn{ this->api, g_connection_info };
+
+	auto caught = false;
+	boost::asio::co_spawn(
+	    io,
+	    [&]() -> boost::asio::awaitable<void> {
+		    try
+		    {
+			    async_transaction transaction{ conn, io };
+			    co_await transaction.begin(boost::asio::use_awaitable);
+			    co_await conn.exec(io, "DELETE FROM person", {}, boost::asio::use_awaitable);
+			    co_await transaction.commit(boost::asio::use_awaitable);
+		    }
+		    catch (const async_exception&)
+		    {
+			    caught = true;
+		    }
+	    },
+	    boost::asio::detached);
+
+	io.run();
+	EXPECT_TRUE(caught);
+	EXPECT_EQ(commands, (std::vector<std::string>{ "BEGIN", "DELETE FROM person", "ROLLBACK" }));
+}
+
+TEST_F(AsyncTests, OperationsAfterAnUnfinishedTransactionWaitForTheRollback)
+{
+	PGresult ok{}, failed{};
+
+	// The commands that are sent, and "end" when all results of a command were received
+	std::vector<std::string> events{};
+	EXPECT_CALL(this->api, sendQueryParams(pq_api_mock::test_connection, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, 0))
+	    .WillRepeatedly(testing::DoAll(testing::WithArg<1>([&events](const char* command) { events.emplace_back(command); }),
+	                                   testing::Return(1)));
+	const auto results = std::vector<PGresult*>{ &ok, nullptr, &failed, nullptr, &ok, nullptr, &ok, nullptr };
+	auto       next    = results.begin();
+	EXPECT_CALL(this->api, getResult(pq_api_mock::test_connection)).WillRepeatedly([&]() -> PGresult* {
+		const auto result = next == results.end() ? nullptr : *next++;
+		if (!result)
+		{
+			events.emplace_back("end");
+		}
+		return result;
+	});
+	EXPECT_CALL(this->api, resultStatus(&ok)).WillRepeatedly(testing::Return(PGRES_COMMAND_OK));
+	EXPECT_CALL(this->api, resultStatus(&failed)).WillRepeatedly(testing::Return(PGRES_FATAL_ERROR));
+
+	boost::asio::io_context io{};
+	connection              conn{ this->api, g_connection_info };
+
+	boost::asio::co_spawn(
+	    io,
+	    [&]() -> boost::asio::awaitable<void> {
+		    try
+		    {
+			    async_transaction transaction{ conn, io };
+			    co_await transaction.begin(boost::asio::use_awaitable);
+			    co_await conn.exec(io, "DELETE FROM person", {}, boost::asio::use_awaitable);
+			    co_await transaction.commit(boost::asio::use_awaitable);
+		    }
+		    catch (const async_exception&)
+		    {
+		    }
+		    co_await conn.exec(io, "SELECT 1", {}, boost::asio::use_awaitable);
+	    },
+	    boost::asio::detached);
+
+	io.run();
+	EXPECT_EQ(events, (std::vector<std::string>{ "BEGIN", "end", "DELETE FROM person", "end", "ROLLBACK", "end", "SELECT 1", "end" }));
+}
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
@@ -9,6 +9,7 @@
 #include <zoo/squid/postgresql/backendconnection.h>
 #include <zoo/squid/postgresql/detail/pqapimock.h>
 #include <zoo/squid/postgresql/statement.h>
+#include <zoo/squid/postgresql/error.h>
 
 namespace zoo {
 namespace squid {
@@ -96,6 +97,47 @@ TEST(BackendConnectionTests, TestCreatePreparedStatement)
 	EXPECT_NE(stmt, nullptr);
 }
 
+TEST(BackendConnectionTests, TestCancel)
+{
+	auto api = pq_api_mock_nice{};
+
+	EXPECT_CALL(api, connectdb(testing::StrEq(g_connection_info))).WillOnce(testing::Return(pq_api_mock::test_connection));
+	EXPECT_CALL(api, status(pq_api_mock::test_connection)).WillOnce(testing::Return(CONNECTION_OK));
+	// The cancel handle is created once, by the thread that connects, and reused by every cancel
+	EXPECT_CALL(api, getCancel(pq_api_mock::test_connection)).WillOnce(testing::Return(pq_api_mock::test_cancel));
+	EXPECT_CALL(api, cancel(pq_api_mock::test_cancel, testing::_, testing::_)).WillOnce(testing::Return(1)).WillOnce(testing::Return(0));
+	EXPECT_CALL(api, freeCancel(pq_api_mock::test_cancel)).Times(1);
+
+	{
+		auto c = backend_connection{ &api, g_connection_info };
+		c.cancel();
+		EXPECT_THROW(c.cancel(), error);
+	}
+}
+
+TEST(BackendConnectionTests, TestCancelHandleIsRenewedOnReset)
+{
+	auto api = pq_api_mock_nice{};
+
+	PGcancel renewed{};
+	EXPECT_CALL(api, connectdb(testing::StrEq(g_connection_info))).WillOnce(testing::Return(pq_api_mock::test_connection));
+	EXPECT_CALL(api, status(pq_api_mock::test_connection))
+	    .WillOnce(testing::Return(CONNECTION_OK))
+	    .WillOnce(testing::Return(CONNECTION_BAD))
+	    .WillOnce(testing::Return(CONNECTION_OK));
+	EXPECT_CALL(api, reset(pq_api_mock::test_connection)).Times(1);
+	EXPECT_CALL(api, getCancel(pq_api_mock::test_connection)).WillOnce(testing::Return(pq_api_mock::test_cancel)).WillOnce(testing::Return(&renewed));
+	EXPECT_CALL(api, freeCancel(pq_api_mock::test_cancel)).Times(1);
+	EXPECT_CALL(api, cancel(&renewed, testing::_, testing::_)).WillOnce(testing::Return(1));
+	EXPECT_CALL(api, freeCancel(&renewed)).Times(1);
+
+	{
+		auto c = backend_connection{ &api, g_connection_info };
+		EXPECT_TRUE(c.is_valid());
+		c.cancel();
+	}
+}
+
 } // namespace postgresql
 } // namespace squid
 } // namespace zoo
@@ -0,0 +1,265 @@
+//
+// Copyright (C) 2022-2024 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include <zoo/squid/postgresql/copyin.h>
+#include <zoo/squid/postgresql/copyout.h>
+#include <zoo/squid/postgresql/error.h>
+#include <zoo/squid/postgresql/detail/pqapimock.h>
+
+#include <optional>
+#include <string>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+namespace {
+
+struct person final
+{
+	std::int32_t               id;
+	std::optional<std::string> name;
+
+	template<class Binder>
+	void bind(Binder& b)
+	{
+		b.bind("id", id);
+		b.bind("name", name);
+	}
+};
+
+std::shared_ptr<PGconn> test_connection()
+{
+	return std::shared_ptr<PGconn>{ pq_api_mock::test_connection, [](PGconn*) {} };
+}
+
+void expect_copy_in_started(pq_api_mock_nice& api)
+{
+	EXPECT_CALL(api, status(pq_api_mock::test_connection)).WillRepeatedly(testing::Return(CONNECTION_OK));
+	EXPECT_CALL(api, exec(pq_api_mock::test_connection, testing::StrEq("COPY \"person\" (\"id\", \"name\") FROM STDIN")))
+	    .WillOnce(testing::Return(pq_api_mock::test_result));
+}
+
+} // namespace
+
+TEST(CopyInTests, TestWriteRows)
+{
+	auto api  = pq_api_mock_nice{};
+	auto data = std::string{};
+
+	expect_copy_in_started(api);
+	EXPECT_CALL(api, resultStatus(pq_api_mock::test_result))
+	    .WillOnce(testing::Return(PGRES_COPY_IN))
+	    .WillOnce(testing::Return(PGRES_COMMAND_OK));
+	EXPECT_CALL(api, putCopyData(pq_api_mock::test_connection, testing::_, testing::_))
+	    .WillOnce(testing::Invoke([&data](PGconn*, const char* buffer, int nbytes) {
+		    data.append(buffer, static_cast<std::size_t>(nbytes));
+		    return 1;
+	    }));
+	EXPECT_CALL(api, putCopyEnd(pq_api_mock::test_connection, testing::IsNull())).WillOnce(testing::Return(1));
+	EXPECT_CALL(api, getResult(pq_api_mock::test_connection))
+	    .WillOnce(testing::Return(pq_api_mock::test_result))
+	    .WillOnce(testing::ReturnNull());
+	EXPECT_CALL(api, cmdTuples(pq_api_mock::test_result)).WillOnce(testing::Return(const_cast<char*>("2")));
+
+	copy_in copy{ &api, test_connection(), "person", { "id", "name" } };
+	copy.write(person{ 1, "foo\tbar" });
+	copy.write(person{ 2, std::nullopt });
+	EXPECT_EQ(copy.finish(), 2u);
+
+	EXPECT_EQ(data, "1\tfoo\\tbar\n2\t\\N\n");
+}
+
+TEST(CopyInTests, TestBufferIsFlushedWhenFull)
+{
+	auto api   = pq_api_mock_nice{};
+	auto calls = 0;
+
+	expect_copy_in_started(api);
+	EXPECT_CALL(api, resultStatus(pq_api_mock::test_result))
+	    .WillOnce(testing::Return(PGRES_COPY_IN))
+	    .WillOnce(testing::Return(PGRES_COMMAND_OK));
+	EXPECT_CALL(api, putCopyData(pq_api_mock::test_connection, testing::_, testing::_))
+	    .Times(3)
+	    .WillRepeatedly(testing::Invoke([&calls](PGconn*, const char*, int) {
+		    ++calls;
+		    return 1;
+	    }));
+	EXPECT_CALL(api, putCopyEnd(pq_api_mock::test_connection, testing::IsNull())).WillOnce(testing::Return(1));
+	EXPECT_CALL(api, getResult(pq_api_mock::test_connection))
+	    .WillOnce(testing::Return(pq_api_mock::test_result))
+	    .WillOnce(testing::ReturnNull());
+
+	copy_in copy{ &api, test_connection(), "person", { "id", "name" }, 1 };
+	for (auto id = 1; id <= 3; ++id)
+	{
+		copy.bind("id", id).bind("name", "x").write_row();
+	}
+	EXPECT_EQ(calls, 3);
+	copy.finish();
+}
+
+TEST(CopyInTests, TestUnboundColumnThrows)
+{
+	auto api = pq_api_mock_nice{};
+
+	expect_copy_in_started(api);
+	EXPECT_CALL(api, resultStatus(pq_api_mock::test_result)).WillOnce(testing::Return(PGRES_COPY_IN));
+
+	copy_in copy{ &api, test_connection(), "person", { "id", "name" } };
+	copy.bind("id", 1);
+	EXPECT_ANY_THROW(copy.write_row());
+}
+
+TEST(CopyInTests, TestUnboundColumnDoesNotWritePartOfTheRow)
+{
+	auto api  = pq_api_mock_nice{};
+	auto data = std::string{};
+
+	expect_copy_in_started(api);
+	EXPECT_CALL(api, resultStatus(pq_api_mock::test_result))
+	    .WillOnce(testing::Return(PGRES_COPY_IN))
+	    .WillOnce(testing::Return(PGRES_COMMAND_OK));
+	EXPECT_CALL(api, putCopyData(pq_api_mock::test_connection, testing::_, testing::_))
+	    .WillOnce(testing::Invoke([&data](PGconn*, const char* buffer, int nbytes) {
+		    data.append(buffer, static_cast<std::size_t>(nbytes));
+		    return 1;
+	    }));
+	EXPECT_CALL(api, putCopyEnd(pq_api_mock::test_connection, testing::IsNull())).WillOnce(testing::Return(1));
+	EXPECT_CALL(api, getResult(pq_api_mock::test_connection))
+	    .WillOnce(testing::Return(pq_api_mock::test_result))
+	    .WillOnce(testing::ReturnNull());
+
+	copy_in copy{ &api, test_connection(), "person", { "id", "name" } };
+	copy.bind("id", 1);
+	EXPECT_THROW(copy.write_row(), error);
+	copy.bind("id", 2).bind("name", "x").write_row();
+	copy.finish();
+
+	EXPECT_EQ(data, "2\tx\n");
+}
+
+TEST(CopyInTests, TestUnknownColumnThrows)
+{
+	auto api = pq_api_mock_nice{};
+
+	expect_copy_in_started(api);
+	EXPECT_CALL(api, resultStatus(pq_api_mock::test_result)).WillOnce(testing::Return(PGRES_COPY_IN));
+
+	copy_in copy{ &api, test_connection(), "person", { "id", "name" } };
+	EXPECT_THROW(copy.bind("age", 42), error);
+}
+
+TEST(CopyInTests, TestFailedEndAborts)
+{
+	auto api = pq_api_mock_nice{};
+
+	expect_copy_in_started(api);
+	EXPECT_CALL(api, resultStatus(pq_api_mock::test_result)).WillOnce(testing::Return(PGRES_COPY_IN));
+	{
+		testing::InSequence seq;
+		EXPECT_CALL(api, putCopyEnd(pq_api_mock::test_connection, testing::IsNull())).WillOnce(testing::Return(-1));
+		EXPECT_CALL(api, putCopyEnd(pq_api_mock::test_connection, testing::NotNull())).WillOnce(testing::Return(1));
+	}
+
+	copy_in copy{ &api, test_connection(), "person", { "id", "name" } };
+	EXPECT_THROW(copy.finish(), error);
+}
+
+TEST(CopyInTests, TestFailedCopyIsFinished)
+{
+	auto api = pq_api_mock_nice{};
+
+	expect_copy_in_started(api);
+	EXPECT_CALL(api, resultStatus(pq_api_mock::test_result))
+	    .WillOnce(testing::Return(PGRES_COPY_IN))
+	    .WillRepeatedly(testing::Return(PGRES_FATAL_ERROR));
+	EXPECT_CALL(api, putCopyEnd(pq_api_mock::test_connection, testing::IsNull())).WillOnce(testing::Return(1));
+	EXPECT_CALL(api, putCopyEnd(pq_api_mock::test_connection, testing::NotNull())).Times(0);
+	EXPECT_CALL(api, getResult(pq_api_mock::test_connection))
+	    .WillOnce(testing::Return(pq_api_mock::test_result))
+	    .WillOnce(testing::ReturnNull());
+
+	copy_in copy{ &api, test_connection(), "person", { "id", "name" } };
+	EXPECT_THROW(copy.finish(), error);
+	EXPECT_THROW(copy.write(person{ 1, "foo" }), error);
+}
+
+TEST(CopyInTests, TestNamesAreQuoted)
+{
+	auto api = pq_api_mock_nice{};
+
+	EXPECT_CALL(api, status(pq_api_mock::test_connection)).WillRepeatedly(testing::Return(CONNECTION_OK));
+	EXPECT_CALL(api, exec(pq_api_mock::test_connection, testing::StrEq("COPY \"my schema\".\"Person\" (\"id\", \"x\"\"y\") FROM STDIN")))
+	    .WillOnce(testing::Return(pq_api_mock::test_result));
+	EXPECT_CALL(api, resultStatus(pq_api_mock::test_result)).WillRepeatedly(testing::Return(PGRES_COPY_IN));
+
+	copy_in copy{ &api, test_connection(), "my schema.Person", { "id", "x\"y" } };
+}
+
+TEST(CopyInTests, TestDestroyWithoutFinishAborts)
+{
+	auto api = pq_api_mock_nice{};
+
+	expect_copy_in_started(api);
+	EXPECT_CALL(api, resultStatus(pq_api_mock::test_result))
+	    .WillOnce(testing::Return(PGRES_COPY_IN))
+	    .WillRepeatedly(testing::Return(PGRES_FATAL_ERROR));
+	EXPECT_CALL(api, putCopyData(testing::_, testing::_, testing::_)).Times(0);
+	EXPECT_CALL(api, putCopyEnd(pq_api_mock::test_connection, testing::NotNull())).WillOnce(testing::Return(1));
+	EXPECT_CALL(api, getResult(pq_api_mock::test_connection))
+	    .WillOnce(testing::Return(pq_api_mock::test_result))
+	    .WillOnce(testing::ReturnNull());
+
+	copy_in copy{ &api, test_connection(), "person", { "id", "name" } };
+	copy.write(person{ 1, "foo" });
+}
+
+TEST(CopyOutTests, TestFetchRows)
+{
+	auto api = pq_api_mock_nice{};
+
+	char row1[] = "1\tfoo\\tbar\n";
+	char row2[] = "2\t\\N\n";
+
+	EXPECT_CALL(api, status(pq_api_mock::test_connection)).WillRepeatedly(testing::Return(CONNECTION_OK));
+	EXPECT_CALL(api, exec(pq_api_mock::test_connection, testing::StrEq("COPY (SELECT id, name FROM person) TO STDOUT")))
+	    .WillOnce(testing::Return(pq_api_mock::test_result));
+	EXPECT_CALL(api, resultStatus(pq_api_mock::test_result))
+	    .WillOnce(testing::Return(PGRES_COPY_OUT))
+	    .WillOnce(testing::Return(PGRES_COMMAND_OK));
+	EXPECT_CALL(api, getCopyData(pq_api_mock::test_connection, testing::NotNull(), 0))
+	    .WillOnce(testing::DoAll(testing::SetArgPointee<1>(row1), testing::Return(static_cast<int>(sizeof(row1) - 1))))
+	    .WillOnce(testing::DoAll(testing::SetArgPointee<1>(row2), testing::Return(static_cast<int>(sizeof(row2) - 1))))
+	    .WillOnce(testing::Return(-1));
+	EXPECT_CALL(api, freemem(testing::_)).Times(2);
+	EXPECT_CALL(api, getResult(pq_api_mock::test_connection))
+	    .WillOnce(testing::Return(pq_api_mock::test_result))
+	    .WillOnce(testing::ReturnNull());
+
+	person   p{};
+	copy_out copy{ &api, test_connection(), "SELECT id, name FROM person" };
+	copy.bind_results(p.id, p.name);
+
+	ASSERT_TRUE(copy.fetch());
+	EXPECT_EQ(p.id, 1);
+	EXPECT_EQ(p.name, "foo\tbar");
+	EXPECT_EQ(copy.field_count(), 2u);
+
+	ASSERT_TRUE(copy.fetch());
+	EXPECT_EQ(p.id, 2);
+	EXPECT_EQ(p.name, std::nullopt);
+	EXPECT_EQ(copy.value(1), nullptr);
+
+	EXPECT_FALSE(copy.fetch());
+	EXPECT_FALSE(copy.fetch());
+}
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
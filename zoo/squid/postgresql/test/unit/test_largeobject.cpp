@@ -0,0 +1,117 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include <zoo/squid/postgresql/largeobject.h>
+#include <zoo/squid/postgresql/error.h>
+#include <zoo/squid/postgresql/detail/pqapimock.h>
+
+#include <libpq/libpq-fs.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+namespace {
+
+constexpr auto g_oid = large_object::oid_type{ 16400 };
+constexpr auto g_fd  = 3;
+
+std::shared_ptr<PGconn> test_connection()
+{
+	return std::shared_ptr<PGconn>{ pq_api_mock::test_connection, [](PGconn*) {} };
+}
+
+/// A large object in memory, behind the mocked lo_* functions
+class LargeObjectTests : public testing::Test
+{
+protected:
+	pq_api_mock_nice api{};
+	std::string      content{};
+	pg_int64         position{};
+
+	void SetUp() override
+	{
+		ON_CALL(this->api, lo_read(pq_api_mock::test_connection, g_fd, testing::_, testing::_)).WillByDefault([this](PGconn*, int, char* buf, size_t len) {
+			const auto n = std::min(len, this->content.size() - static_cast<std::size_t>(this->position));
+			std::memcpy(buf, this->content.data() + this->position, n);
+			this->position += static_cast<pg_int64>(n);
+			return static_cast<int>(n);
+		});
+		ON_CALL(this->api, lo_write(pq_api_mock::test_connection, g_fd, testing::_, testing::_))
+		    .WillByDefault([this](PGconn*, int, const char* buf, size_t len) {
+			    this->content.resize(std::max(this->content.size(), static_cast<std::size_t>(this->position) + len));
+			    this->content.replace(static_cast<std::size_t>(this->position), len, buf, len);
+			    this->position += static_cast<pg_int64>(len);
+			    return static_cast<int>(len);
+		    });
+		ON_CALL(this->api, lo_lseek64(pq_api_mock::test_connection, g_fd, testing::_, testing::_))
+		    .WillByDefault([this](PGconn*, int, pg_int64 offset, int whence) {
+			    this->position = offset + (whence == SEEK_CUR ? this->position : whence == SEEK_END ? static_cast<pg_int64>(this->content.size()) : 0);
+			    return this->position;
+		    });
+	}
+};
+
+} // namespace
+
+TEST_F(LargeObjectTests, TestWriteAndReadInChunks)
+{
+	EXPECT_CALL(this->api, lo_open(pq_api_mock::test_connection, g_oid, INV_READ | INV_WRITE)).WillOnce(testing::Return(g_fd));
+	EXPECT_CALL(this->api, lo_close(pq_api_mock::test_connection, g_fd)).WillOnce(testing::Return(0));
+
+	large_object lo{ &this->api, test_connection(), g_oid, true };
+	EXPECT_EQ(lo.write("hello ", 6), 6u);
+	EXPECT_EQ(lo.write("world", 5), 5u);
+	EXPECT_EQ(lo.size(), 11u);
+	EXPECT_EQ(this->position, 11); // size() does not move
+
+	lo.seek(0);
+	char buf[4]{};
+	std::string read{};
+	while (const auto n = lo.read(buf, sizeof(buf)))
+	{
+		read.append(buf, n);
+	}
+	EXPECT_EQ(read, "hello world");
+}
+
+TEST_F(LargeObjectTests, TestOpenReadOnly)
+{
+	EXPECT_CALL(this->api, lo_open(pq_api_mock::test_connection, g_oid, INV_READ)).WillOnce(testing::Return(g_fd));
+
+	large_object lo{ &this->api, test_connection(), g_oid, false };
+}
+
+TEST_F(LargeObjectTests, TestErrors)
+{
+	EXPECT_CALL(this->api, lo_open(pq_api_mock::test_connection, g_oid, testing::_)).WillOnce(testing::Return(-1)).WillOnce(testing::Return(g_fd));
+	EXPECT_THROW((large_object{ &this->api, test_connection(), g_oid, false }), error);
+
+	large_object lo{ &this->api, test_connection(), g_oid, false };
+	EXPECT_CALL(this->api, lo_read(pq_api_mock::test_connection, g_fd, testing::_, testing::_)).WillOnce(testing::Return(-1));
+	char buf[4]{};
+	EXPECT_THROW(lo.read(buf, sizeof(buf)), error);
+}
+
+TEST_F(LargeObjectTests, TestCreateAndUnlink)
+{
+	EXPECT_CALL(this->api, lo_create(pq_api_mock::test_connection, InvalidOid)).WillOnce(testing::Return(g_oid)).WillOnce(testing::Return(InvalidOid));
+	EXPECT_CALL(this->api, lo_unlink(pq_api_mock::test_connection, g_oid)).WillOnce(testing::Return(1));
+
+	EXPECT_EQ(large_object::create(&this->api, *pq_api_mock::test_connection), g_oid);
+	EXPECT_THROW(large_object::create(&this->api, *pq_api_mock::test_connection), error);
+	large_object::unlink(&this->api, *pq_api_mock::test_connection, g_oid);
+}
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
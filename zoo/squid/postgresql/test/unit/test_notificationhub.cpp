@@ -0,0 +1,219 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include <zoo/squid/postgresql/notificationhub.h>
+#include <zoo/squid/postgresql/error.h>
+#include <zoo/squid/postgresql/detail/pqapimock.h>
+
+#include <boost/asio/io_context.hpp>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+namespace {
+
+static constexpr auto g_connection_info = "the connection info";
+
+// A connected socket pair, with data pending on the socket that is handed to the hub,
+// so that waiting for it to become readable completes immediately.
+class readable_socket final
+{
+	std::array<int, 2> fds_;
+
+public:
+	readable_socket()
+	    : fds_{ -1, -1 }
+	{
+		if (::socketpair(AF_UNIX, SOCK_STREAM, 0, this->fds_.data()) != 0 || ::write(this->fds_[1], "x", 1) != 1)
+		{
+			throw std::runtime_error{ "socketpair failed" };
+		}
+	}
+
+	~readable_socket()
+	{
+		::close(this->fds_[0]);
+		::close(this->fds_[1]);
+	}
+
+	readable_socket(const readable_socket&)            = delete;
+	readable_socket& operator=(const readable_socket&) = delete;
+
+	int fd() const
+	{
+		return this->fds_[0];
+	}
+};
+
+class NotificationHubTests : public testing::Test
+{
+protected:
+	pq_api_mock_nice api{};
+	readable_socket  socket{};
+
+	void SetUp() override
+	{
+		ON_CALL(this->api, connectdb(testing::_)).WillByDefault(testing::Return(pq_api_mock::test_connection));
+		ON_CALL(this->api, status(testing::_)).WillByDefault(testing::Return(CONNECTION_OK));
+		ON_CALL(this->api, socket(testing::_)).WillByDefault(testing::Return(this->socket.fd()));
+		ON_CALL(this->api, consumeInput(testing::_)).WillByDefault(testing::Return(1));
+		ON_CALL(this->api, exec(testing::_, testing::_)).WillByDefault(testing::Return(pq_api_mock::test_result));
+		ON_CALL(this->api, resultStatus(pq_api_mock::test_result)).WillByDefault(testing::Return(PGRES_COMMAND_OK));
+	}
+
+	void expect_statement(const char* query)
+	{
+		EXPECT_CALL(this->api, exec(pq_api_mock::test_connection, testing::StrEq(query))).Times(1);
+	}
+};
+
+PGnotify make_notify(const char* channel, const char* payload, int pid)
+{
+	return PGnotify{ .relname = const_cast<char*>(channel), .be_pid = pid, .extra = const_cast<char*>(payload), .next = nullptr };
+}
+
+} // namespace
+
+TEST_F(NotificationHubTests, DeliversBatchesPerChannel)
+{
+	auto a1 = make_notify("a", "1", 10);
+	auto b1 = make_notify("b", "x", 11);
+	auto a2 = make_notify("a", "2", 10);
+
+	this->expect_statement("LISTEN \"a\"");
+	this->expect_statement("LISTEN \"b\"");
+	this->expect_statement("UNLISTEN \"a\"");
+	this->expect_statement("UNLISTEN \"b\"");
+	EXPECT_CALL(this->api, notifies(pq_api_mock::test_connection))
+	    .WillOnce(testing::ReturnNull()) // drained after each LISTEN
+	    .WillOnce(testing::ReturnNull())
+	    .WillOnce(testing::Return(&a1))
+	    .WillOnce(testing::Return(&b1))
+	    .WillOnce(testing::Return(&a2))
+	    .WillRepeatedly(testing::ReturnNull());
+	EXPECT_CALL(this->api, freemem(testing::_)).Times(3);
+
+	boost::asio::io_context io{};
+	notification_hub        hub{ io, connection{ this->api, g_connection_info } };
+
+	std::vector<std::vector<std::string>> a_batches{}, a_batches2{}, b_batches{};
+
+	const auto collect = [](std::vector<std::vector<std::string>>& batches) {
+		return [&batches](std::span<const notification> notifications) {
+			auto& batch = batches.emplace_back();
+			for (const auto& n : notifications)
+			{
+				batch.push_back(n.channel + ":" + n.payload + ":" + std::to_string(n.pid));
+			}
+		};
+	};
+
+	auto sa  = hub.subscribe("a", collect(a_batches));
+	auto sa2 = hub.subscribe("a", collect(a_batches2));
+	auto sb  = hub.subscribe("b", collect(b_batches));
+	EXPECT_EQ(hub.channel_count(), 2u);
+
+	for (auto i = 0; i < 10 && a_batches.empty(); ++i)
+	{
+		io.run_one();
+	}
+
+	ASSERT_EQ(a_batches.size(), 1u);
+	EXPECT_EQ(a_batches.front(), (std::vector<std::string>{ "a:1:10", "a:2:10" }));
+	EXPECT_EQ(a_batches2, a_batches);
+	ASSERT_EQ(b_batches.size(), 1u);
+	EXPECT_EQ(b_batches.front(), (std::vector<std::string>{ "b:x:11" }));
+}
+
+TEST_F(NotificationHubTests, UnlistensAfterTheLastSubscriber)
+{
+	this->expect_statement("LISTEN \"My \"\"Channel\"\"\"");
+	this->expect_statement("UNLISTEN \"My \"\"Channel\"\"\"");
+
+	boost::asio::io_context io{};
+	notification_hub        hub{ io, connection{ this->api, g_connection_info } };
+
+	const auto ignore = [](std::span<const notification>) {};
+
+	auto first  = hub.subscribe("My \"Channel\"", ignore);
+	auto second = hub.subscribe("My \"Channel\"", ignore);
+	EXPECT_EQ(hub.channel_count(), 1u);
+
+	first.reset();
+	EXPECT_FALSE(first);
+	EXPECT_EQ(hub.channel_count(), 1u);
+
+	auto moved = std::move(second);
+	EXPECT_FALSE(second);
+	EXPECT_TRUE(moved);
+	moved = notification_hub::subscription{};
+	EXPECT_EQ(hub.channel_count(), 0u);
+}
+
+TEST_F(NotificationHubTests, FailedListenIsNotCounted)
+{
+	PGresult failed{};
+	EXPECT_CALL(this->api, exec(pq_api_mock::test_connection, testing::StrEq("LISTEN \"a\""))).WillOnce(testing::Return(&failed));
+	EXPECT_CALL(this->api, resultStatus(&failed)).WillRepeatedly(testing::Return(PGRES_FATAL_ERROR));
+
+	boost::asio::io_context io{};
+	notification_hub        hub{ io, connection{ this->api, g_connection_info } };
+
+	EXPECT_THROW((void)hub.subscribe("a", [](std::span<const notification>) {}), error);
+	EXPECT_EQ(hub.channel_count(), 0u);
+}
+
+TEST_F(NotificationHubTests, FailedWaitStopsTheHubAndIsReported)
+{
+	EXPECT_CALL(this->api, consumeInput(pq_api_mock::test_connection)).WillOnce(testing::Return(0));
+	EXPECT_CALL(this->api, errorMessage(pq_api_mock::test_connection)).WillRepeatedly(testing::Return("server closed the connection"));
+
+	boost::asio::io_context io{};
+	std::exception_ptr      failure{};
+	notification_hub        hub{ io, connection{ this->api, g_connection_info }, [&failure](std::exception_ptr e) { failure = e; } };
+
+	auto delivered = 0;
+	auto s         = hub.subscribe("a", [&delivered](std::span<const notification>) { ++delivered; });
+
+	for (auto i = 0; i < 10 && !failure; ++i)
+	{
+		io.run_one();
+	}
+
+	ASSERT_TRUE(failure);
+	EXPECT_THROW(std::rethrow_exception(failure), error);
+	EXPECT_TRUE(hub.stopped());
+	EXPECT_EQ(delivered, 0);
+	EXPECT_THROW((void)hub.subscribe("b", [](std::span<const notification>) {}), error);
+}
+
+TEST_F(NotificationHubTests, DestroyedHubDoesNotWaitAgain)
+{
+	boost::asio::io_context io{};
+	{
+		notification_hub hub{ io, connection{ this->api, g_connection_info } };
+		EXPECT_FALSE(hub.stopped());
+	}
+
+	// The pending wait is aborted on the strand, after which the io_context runs out of work
+	io.run_for(std::chrono::seconds{ 5 });
+	EXPECT_TRUE(io.stopped());
+}
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
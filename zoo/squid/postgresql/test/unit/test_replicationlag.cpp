@@ -0,0 +1,41 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include <zoo/squid/postgresql/replicationlag.h>
+#include <zoo/squid/postgresql/connection.h>
+#include <zoo/squid/postgresql/detail/pqapimock.h>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+using namespace std::chrono_literals;
+
+TEST(ReplicationLagTests, TestReplicationLag)
+{
+	auto api = pq_api_mock_nice{};
+
+	EXPECT_CALL(api, connectdb(testing::_)).WillOnce(testing::Return(pq_api_mock::test_connection));
+	EXPECT_CALL(api, status(pq_api_mock::test_connection)).WillRepeatedly(testing::Return(CONNECTION_OK));
+	EXPECT_CALL(api,
+	            execParams(pq_api_mock::test_connection, testing::HasSubstr("pg_last_xact_replay_timestamp"), 0, nullptr, nullptr, nullptr, nullptr, 0))
+	    .WillOnce(testing::Return(pq_api_mock::test_result));
+	EXPECT_CALL(api, resultStatus(pq_api_mock::test_result)).WillRepeatedly(testing::Return(PGRES_TUPLES_OK));
+	EXPECT_CALL(api, ntuples(pq_api_mock::test_result)).WillRepeatedly(testing::Return(1));
+	EXPECT_CALL(api, nfields(pq_api_mock::test_result)).WillRepeatedly(testing::Return(1));
+	EXPECT_CALL(api, fname(pq_api_mock::test_result, 0)).WillRepeatedly(testing::Return("coalesce"));
+	EXPECT_CALL(api, getisnull(pq_api_mock::test_result, 0, 0)).WillRepeatedly(testing::Return(0));
+	EXPECT_CALL(api, getvalue(pq_api_mock::test_result, 0, 0)).WillRepeatedly(testing::Return("1.2345"));
+
+	auto c = connection{ api, "the connection info" };
+	EXPECT_EQ(replication_lag(c), 1235ms);
+}
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
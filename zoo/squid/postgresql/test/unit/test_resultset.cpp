@@ -0,0 +1,137 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include <zoo/squid/postgresql/resultset.h>
+#include <zoo/squid/postgresql/tuple.h>
+#include <zoo/squid/postgresql/detail/pqapimock.h>
+
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+static_assert(std::is_trivially_copyable_v<row>);
+static_assert(std::is_trivially_copyable_v<field>);
+static_assert(std::random_access_iterator<row_iterator>);
+static_assert(std::ranges::random_access_range<row_range>);
+
+namespace {
+
+// A result with the columns (id, name), where the name of the second row is null
+class ResultsetTests : public testing::Test
+{
+protected:
+	pq_api_mock_nice         api{};
+	PGresult                 pgresult{};
+	std::vector<std::string> ids{ "1", "2", "3" };
+	std::vector<const char*> names{ "foo", nullptr, "baz" };
+
+	void SetUp() override
+	{
+		ON_CALL(this->api, ntuples(&this->pgresult)).WillByDefault(testing::Return(3));
+		ON_CALL(this->api, nfields(&this->pgresult)).WillByDefault(testing::Return(2));
+		ON_CALL(this->api, fname(&this->pgresult, 0)).WillByDefault(testing::Return("id"));
+		ON_CALL(this->api, fname(&this->pgresult, 1)).WillByDefault(testing::Return("name"));
+		ON_CALL(this->api, getisnull(&this->pgresult, testing::_, 1)).WillByDefault([this](const PGresult*, int tup_num, int) {
+			return this->names.at(tup_num) == nullptr ? 1 : 0;
+		});
+		ON_CALL(this->api, getvalue(&this->pgresult, testing::_, 0)).WillByDefault([this](const PGresult*, int tup_num, int) {
+			return this->ids.at(tup_num).c_str();
+		});
+		ON_CALL(this->api, getvalue(&this->pgresult, testing::_, 1)).WillByDefault([this](const PGresult*, int tup_num, int) {
+			return this->names.at(tup_num);
+		});
+	}
+
+	resultset make_resultset()
+	{
+		return resultset{ &this->api, std::shared_ptr<PGresult>{ &this->pgresult, [](PGresult*) {} } };
+	}
+};
+
+} // namespace
+
+TEST_F(ResultsetTests, RowsByName)
+{
+	const auto result = this->make_resultset();
+
+	std::vector<std::string> values{};
+	for (const auto row : result.rows())
+	{
+		values.push_back(row["id"].to_string() + ":" + row["name"].to_optional_string().value_or("null"));
+	}
+
+	EXPECT_EQ(values, (std::vector<std::string>{ "1:foo", "2:null", "3:baz" }));
+}
+
+TEST_F(ResultsetTests, RowsByIndex)
+{
+	const auto result = this->make_resultset();
+	const auto name   = result.field_index("name");
+
+	EXPECT_EQ(result.field_count(), 2u);
+	EXPECT_EQ(name, 1u);
+	EXPECT_EQ(result.rows().size(), 3u);
+	EXPECT_EQ(result.rows().begin()[2][name].to_string_view(), "baz");
+	EXPECT_EQ(result.get_row(0)[name].name(), "name");
+	EXPECT_TRUE(result.get_row(1)[name].is_null());
+	EXPECT_EQ(result.get_row(2).index(), 2u);
+}
+
+TEST_F(ResultsetTests, FieldNamesAreResolvedOnce)
+{
+	EXPECT_CALL(this->api, fname(&this->pgresult, testing::_)).Times(2);
+
+	const auto result = this->make_resultset();
+	for (auto i = 0; i < 3; ++i)
+	{
+		for (const auto row : result.rows())
+		{
+			EXPECT_EQ(row.get_field("id").name(), "id");
+		}
+		for (const auto& tuple : result)
+		{
+			EXPECT_EQ(tuple.get_field("name").name(), "name");
+		}
+	}
+}
+
+TEST_F(ResultsetTests, LastOfDuplicateFieldNamesWins)
+{
+	ON_CALL(this->api, fname(&this->pgresult, 1)).WillByDefault(testing::Return("id"));
+
+	const auto result = this->make_resultset();
+
+	EXPECT_EQ(result.field_index("id"), 1u);
+	EXPECT_EQ(result.get_row(0)["id"].to_string(), "foo");
+	EXPECT_EQ(result.begin()->get_field("id").to_string(), "foo");
+}
+
+TEST_F(ResultsetTests, UnknownFieldsAndRows)
+{
+	const auto result = this->make_resultset();
+	const auto row    = result.get_row(0);
+
+	EXPECT_FALSE(row.find_field("nope").has_value());
+	EXPECT_EQ(row.find_field("id")->to_int(), 1);
+	EXPECT_THROW(row.get_field("nope"), std::out_of_range);
+	EXPECT_THROW(row.get_field(2), std::out_of_range);
+	EXPECT_THROW(result.field_index("nope"), std::out_of_range);
+	EXPECT_THROW(result.get_row(3), std::out_of_range);
+	EXPECT_TRUE(resultset{}.rows().empty());
+}
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,472 @@
+//
+// Copyright (C) 2022-2024 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include <zoo/squid/postgresql/statement.h>
+#include <zoo/squid/postgresql/error.h>
+#include <zoo/squid/postgresql/detail/pqapimock.h>
+
+#include <cmath>
+
+namespace zoo {
+namespace squid {
+namespace postgresql {
+
+namespace {
+
+PGresult g_row1;
+PGresult g_row2;
+PGresult g_final;
+
+std::shared_ptr<PGconn> test_connection()
+{
+	return std::shared_ptr<PGconn>{ pq_api_mock::test_connection, [](PGconn*) {} };
+}
+
+void expect_row_mode(pq_api_mock_nice& api)
+{
+#ifdef LIBPQ_HAS_CHUNK_MODE
+	EXPECT_CALL(api, setChunkedRowsMode(pq_api_mock::test_connection, testing::Gt(0))).WillOnce(testing::Return(1));
+#else
+	EXPECT_CALL(api, setSingleRowMode(pq_api_mock::test_connection)).WillOnce(testing::Return(1));
+#endif
+}
+
+void expect_streaming_results(pq_api_mock_nice& api)
+{
+	EXPECT_CALL(api, status(pq_api_mock::test_connection)).WillRepeatedly(testing::Return(CONNECTION_OK));
+	EXPECT_CALL(api, resultStatus(&g_row1)).WillRepeatedly(testing::Return(PGRES_SINGLE_TUPLE));
+	EXPECT_CALL(api, resultStatus(&g_row2)).WillRepeatedly(testing::Return(PGRES_SINGLE_TUPLE));
+	EXPECT_CALL(api, resultStatus(&g_final)).WillRepeatedly(testing::Return(PGRES_TUPLES_OK));
+	EXPECT_CALL(api, ntuples(&g_row1)).WillRepeatedly(testing::Return(1));
+	EXPECT_CALL(api, ntuples(&g_row2)).WillRepeatedly(testing::Return(1));
+	EXPECT_CALL(api, ntuples(&g_final)).WillRepeatedly(testing::Return(0));
+	EXPECT_CALL(api, nfields(testing::_)).WillRepeatedly(testing::Return(1));
+	EXPECT_CALL(api, fname(testing::_, 0)).WillRepeatedly(testing::Return("id"));
+	EXPECT_CALL(api, getisnull(testing::_, testing::_, testing::_)).WillRepeatedly(testing::Return(0));
+	EXPECT_CALL(api, getvalue(&g_row1, 0, 0)).WillRepeatedly(testing::Return("10"));
+	EXPECT_CALL(api, getvalue(&g_row2, 0, 0)).WillRepeatedly(testing::Return("20"));
+}
+
+} // namespace
+
+TEST(StatementTests, TestStreamingFetch)
+{
+	auto api = pq_api_mock_nice{};
+
+	expect_streaming_results(api);
+	EXPECT_CALL(api, sendQueryParams(pq_api_mock::test_connection, testing::StrEq("SELECT id FROM foo"), 0, nullptr, nullptr, nullptr, nullptr, 0))
+	    .WillOnce(testing::Return(1));
+	expect_row_mode(api);
+	EXPECT_CALL(api, getResult(pq_api_mock::test_connection))
+	    .WillOnce(testing::Return(&g_row1))
+	    .WillOnce(testing::Return(&g_row2))
+	    .WillOnce(testing::Return(&g_final))
+	    .WillOnce(testing::ReturnNull());
+	EXPECT_CALL(api, execParams(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_)).Times(0);
+
+	std::int32_t id{};
+	statement    st{ &api, test_connection(), "SELECT id FROM foo", false };
+	st.set_fetch_mode(fetch_mode::streaming);
+	st.execute({}, std::vector<result>{ result{ id } });
+
+	ASSERT_TRUE(st.fetch());
+	EXPECT_EQ(id, 10);
+	ASSERT_TRUE(st.fetch());
+	EXPECT_EQ(id, 20);
+	EXPECT_FALSE(st.fetch());
+	EXPECT_FALSE(st.fetch());
+	EXPECT_EQ(st.field_count(), 1u);
+}
+
+TEST(StatementTests, TestStreamingFetchColumns)
+{
+	auto api = pq_api_mock_nice{};
+
+	expect_streaming_results(api);
+	EXPECT_CALL(api, sendQueryParams(pq_api_mock::test_connection, testing::_, 0, nullptr, nullptr, nullptr, nullptr, 0))
+	    .WillOnce(testing::Return(1));
+	expect_row_mode(api);
+	EXPECT_CALL(api, getResult(pq_api_mock::test_connection))
+	    .WillOnce(testing::Return(&g_row1))
+	    .WillOnce(testing::Return(&g_row2))
+	    .WillOnce(testing::Return(&g_final))
+	    .WillOnce(testing::ReturnNull());
+
+	statement st{ &api, test_connection(), "SELECT id FROM foo", false };
+	st.set_fetch_mode(fetch_mode::streaming);
+	st.execute({}, std::vector<result>{});
+
+	// The batch spans both streamed chunks
+	column_batch batch{ column_type::int64 };
+	ASSERT_EQ(st.fetch_columns(batch, 10u), 2u);
+	EXPECT_EQ(batch.column(0).int64_values(), (std::vector<std::int64_t>{ 10, 20 }));
+	EXPECT_EQ(batch.column(0).nulls().null_count(), 0u);
+
+	batch.clear();
+	EXPECT_EQ(st.fetch_columns(batch, 10u), 0u);
+}
+
+TEST(StatementTests, TestFetchColumns)
+{
+	auto api = pq_api_mock_nice{};
+
+	EXPECT_CALL(api, status(pq_api_mock::test_connection)).WillRepeatedly(testing::Return(CONNECTION_OK));
+	EXPECT_CALL(api, execParams(pq_api_mock::test_connection, testing::_, 0, nullptr, nullptr, nullptr, nullptr, 0))
+	    .WillOnce(testing::Return(pq_api_mock::test_result));
+	EXPECT_CALL(api, resultStatus(pq_api_mock::test_result)).WillRepeatedly(testing::Return(PGRES_TUPLES_OK));
+	EXPECT_CALL(api, ntuples(pq_api_mock::test_result)).WillRepeatedly(testing::Return(3));
+	EXPECT_CALL(api, nfields(pq_api_mock::test_result)).WillRepeatedly(testing::Return(2));
+	EXPECT_CALL(api, getisnull(pq_api_mock::test_result, testing::_, testing::_)).WillRepeatedly(testing::Return(0));
+	EXPECT_CALL(api, getisnull(pq_api_mock::test_result, 1, 1)).WillRepeatedly(testing::Return(1));
+	EXPECT_CALL(api, getvalue(pq_api_mock::test_result, 0, 0)).WillRepeatedly(testing::Return("1.5"));
+	EXPECT_CALL(api, getvalue(pq_api_mock::test_result, 1, 0)).WillRepeatedly(testing::Return("-2"));
+	EXPECT_CALL(api, getvalue(pq_api_mock::test_result, 2, 0)).WillRepeatedly(testing::Return("NaN"));
+	EXPECT_CALL(api, getvalue(pq_api_mock::test_result, 0, 1)).WillRepeatedly(testing::Return("foo"));
+	EXPECT_CALL(api, getvalue(pq_api_mock::test_result, 2, 1)).WillRepeatedly(testing::Return("quux"));
+
+	statement st{ &api, test_connection(), "SELECT x, s FROM foo", false };
+	st.execute({}, std::vector<result>{});
+
+	column_batch batch{ column_type::float64, column_type::text };
+	ASSERT_EQ(st.fetch_columns(batch, 2u), 2u);
+	EXPECT_EQ(batch.column(0).float64_values(), (std::vector<double>{ 1.5, -2.0 }));
+	EXPECT_EQ(batch.column(1).text_values()[0], "foo");
+	EXPECT_TRUE(batch.column(1).nulls().is_null(1));
+
+	batch.clear();
+	ASSERT_EQ(st.fetch_columns(batch, 2u), 1u);
+	EXPECT_TRUE(std::isnan(batch.column(0).float64_values().at(0)));
+	EXPECT_EQ(batch.column(1).text_values()[0], "quux");
+
+	batch.clear();
+	EXPECT_EQ(st.fetch_columns(batch, 2u), 0u);
+
+	// Text that is not a number
+	statement st2{ &api, test_connection(), "SELECT x, s FROM foo", false };
+	EXPECT_CALL(api, execParams(pq_api_mock::test_connection, testing::_, 0, nullptr, nullptr, nullptr, nullptr, 0))
+	    .WillOnce(testing::Return(pq_api_mock::test_result));
+	st2.execute({}, std::vector<result>{});
+	column_batch wrong{ column_type::int64, column_type::int64 };
+	EXPECT_ANY_THROW(st2.fetch_columns(wrong, 2u));
+}
+
+TEST(StatementTests, TestFetchColumnsKeepsCompleteRowsOnConversionError)
+{
+	auto api = pq_api_mock_nice{};
+
+	EXPECT_CALL(api, status(pq_api_mock::test_connection)).WillRepeatedly(testing::Return(CONNECTION_OK));
+	EXPECT_CALL(api, execParams(pq_api_mock::test_connection, testing::_, 0, nullptr, nullptr, nullptr, nullptr, 0))
+	    .WillOnce(testing::Return(pq_api_mock::test_result));
+	EXPECT_CALL(api, resultStatus(pq_api_mock::test_result)).WillRepeatedly(testing::Return(PGRES_TUPLES_OK));
+	EXPECT_CALL(api, ntuples(pq_api_mock::test_result)).WillRepeatedly(testing::Return(2));
+	EXPECT_CALL(api, nfields(pq_api_mock::test_result)).WillRepeatedly(testing::Return(2));
+	EXPECT_CALL(api, getisnull(pq_api_mock::test_result, testing::_, testing::_)).WillRepeatedly(testing::Return(0));
+	EXPECT_CALL(api, getvalue(pq_api_mock::test_result, 0, 0)).WillRepeatedly(testing::Return("1"));
+	EXPECT_CALL(api, getvalue(pq_api_mock::test_result, 0, 1)).WillRepeatedly(testing::Return("10"));
+	EXPECT_CALL(api, getvalue(pq_api_mock::test_result, 1, 0)).WillRepeatedly(testing::Return("2"));
+	EXPECT_CALL(api, getvalue(pq_api_mock::test_result, 1, 1)).WillRepeatedly(testing::Return("x"));
+
+	statement st{ &api, test_connection(), "SELECT id, n FROM foo", false };
+	st.execute({}, std::vector<result>{});
+
+	// The second column of the second row is not a number
+	column_batch batch{ column_type::int64, column_type::int64 };
+	EXPECT_ANY_THROW(st.fetch_columns(batch, 3u));
+	EXPECT_EQ(batch.rows(), 1u);
+	EXPECT_EQ(batch.column(0).int64_values(), (std::vector<std::int64_t>{ 1 }));
+	EXPECT_EQ(batch.column(1).int64_values(), (std::vector<std::int64_t>{ 10 }));
+	EXPECT_EQ(batch.column(0).nulls().size(), 1u);
+	EXPECT_EQ(batch.column(1).nulls().size(), 1u);
+
+	// The failing row stays current and nothing of it is appended
+	EXPECT_ANY_THROW(st.fetch_columns(batch, 3u));
+	EXPECT_EQ(batch.rows(), 1u);
+	EXPECT_EQ(batch.column(0).int64_values(), (std::vector<std::int64_t>{ 1 }));
+	EXPECT_EQ(batch.column(1).int64_values(), (std::vector<std::int64_t>{ 10 }));
+	EXPECT_EQ(batch.column(0).nulls().size(), 1u);
+	EXPECT_EQ(batch.column(1).nulls().size(), 1u);
+}
+
+TEST(StatementTests, TestStreamingPendingResultsAreDiscardedOnDestruction)
+{
+	auto api = pq_api_mock_nice{};
+
+	expect_streaming_results(api);
+	EXPECT_CALL(api, sendQueryParams(pq_api_mock::test_connection, testing::_, 0, nullptr, nullptr, nullptr, nullptr, 0))
+	    .WillOnce(testing::Return(1));
+	expect_row_mode(api);
+	EXPECT_CALL(api, getResult(pq_api_mock::test_connection))
+	    .WillOnce(testing::Return(&g_row1))
+	    .WillOnce(testing::Return(&g_row2))
+	    .WillOnce(testing::Return(&g_final))
+	    .WillOnce(testing::ReturnNull());
+	EXPECT_CALL(api, clear(testing::_)).Times(testing::AnyNumber());
+	EXPECT_CALL(api, clear(&g_row2)).Times(1);
+	EXPECT_CALL(api, clear(&g_final)).Times(1);
+
+	std::int32_t id{};
+	{
+		statement st{ &api, test_connection(), "SELECT id FROM foo", false };
+		st.set_fetch_mode(fetch_mode::streaming);
+		st.execute({}, std::vector<result>{ result{ id } });
+		ASSERT_TRUE(st.fetch());
+		EXPECT_EQ(id, 10);
+	}
+}
+
+TEST(StatementTests, TestStreamingPreparedStatement)
+{
+	auto api = pq_api_mock_nice{};
+
+	expect_streaming_results(api);
+	EXPECT_CALL(api, prepare(pq_api_mock::test_connection, testing::_, testing::StrEq("SELECT id FROM foo WHERE id > $1"), 1, nullptr))
+	    .WillOnce(testing::Return(pq_api_mock::test_result));
+	EXPECT_CALL(api, resultStatus(pq_api_mock::test_result)).WillRepeatedly(testing::Return(PGRES_COMMAND_OK));
+	EXPECT_CALL(api, sendQueryPrepared(pq_api_mock::test_connection, testing::_, 1, testing::NotNull(), nullptr, nullptr, 0))
+	    .WillOnce(testing::Return(1));
+	expect_row_mode(api);
+	EXPECT_CALL(api, getResult(pq_api_mock::test_connection))
+	    .WillOnce(testing::Return(&g_row1))
+	    .WillOnce(testing::Return(&g_final))
+	    .WillOnce(testing::ReturnNull());
+	EXPECT_CALL(api, exec(pq_api_mock::test_connection, testing::StartsWith("DEALLOCATE "))).WillOnce(testing::ReturnNull());
+
+	std::int32_t                     id{};
+	std::map<std::string, parameter> params{ { "min", parameter{ 5, parameter::by_value{} } } };
+	statement                        st{ &api, test_connection(), "SELECT id FROM foo WHERE id > :min", true };
+	st.set_fetch_mode(fetch_mode::streaming);
+	st.execute(params, std::vector<result>{ result{ id } });
+
+	ASSERT_TRUE(st.fetch());
+	EXPECT_EQ(id, 10);
+	EXPECT_FALSE(st.fetch());
+}
+
+TEST(StatementTests, TestPreparedStatementCache)
+{
+	auto api   = pq_api_mock_nice{};
+	auto cache = std::make_shared<statement_name_cache>();
+
+	std::string prepared_name{};
+	EXPECT_CALL(api, status(pq_api_mock::test_connection)).WillRepeatedly(testing::Return(CONNECTION_OK));
+	EXPECT_CALL(api, prepare(pq_api_mock::test_connection, testing::_, testing::StrEq("SELECT id FROM foo WHERE id > $1"), 1, nullptr))
+	    .WillOnce(testing::DoAll(testing::SaveArg<1>(&prepared_name), testing::Return(pq_api_mock::test_result)));
+	EXPECT_CALL(api, resultStatus(pq_api_mock::test_result)).WillRepeatedly(testing::Return(PGRES_COMMAND_OK));
+	EXPECT_CALL(api, execPrepared(pq_api_mock::test_connection, testing::_, 1, testing::NotNull(), nullptr, nullptr, 0))
+	    .Times(2)
+	    .WillRepeatedly(testing::Return(pq_api_mock::test_result));
+	EXPECT_CALL(api, exec(pq_api_mock::test_connection, testing::StartsWith("DEALLOCATE "))).Times(0);
+
+	std::map<std::string, parameter> params{ { "min", parameter{ 5, parameter::by_value{} } } };
+	{
+		statement st{ &api, test_connection(), "SELECT id FROM foo WHERE id > :min", true, cache };
+		st.execute(params, std::vector<result>{});
+	}
+	EXPECT_EQ(cache->size(), 1u);
+	{
+		// Different whitespace, same normalized query
+		statement st{ &api, test_connection(), "SELECT id\n  FROM foo WHERE id > :min ", true, cache };
+		st.execute(params, std::vector<result>{});
+	}
+
+	const auto stats = cache->stats();
+	EXPECT_EQ(stats.hits, 1u);
+	EXPECT_EQ(stats.misses, 1u);
+	EXPECT_EQ(stats.size, 1u);
+	EXPECT_EQ(cache->acquire("SELECT id FROM foo WHERE id > :min").value_or(""), prepared_name);
+}
+
+TEST(StatementTests, TestPreparedStatementCacheEvictionDeallocates)
+{
+	auto api   = pq_api_mock_nice{};
+	auto cache = std::make_shared<statement_name_cache>(1, [&api](std::string& name) {
+		statement::execute(&api, *pq_api_mock::test_connection, "DEALLOCATE " + name);
+	});
+
+	EXPECT_CALL(api, status(pq_api_mock::test_connection)).WillRepeatedly(testing::Return(CONNECTION_OK));
+	EXPECT_CALL(api, prepare(pq_api_mock::test_connection, testing::_, testing::_, 0, nullptr))
+	    .Times(2)
+	    .WillRepeatedly(testing::Return(pq_api_mock::test_result));
+	EXPECT_CALL(api, resultStatus(pq_api_mock::test_result)).WillRepeatedly(testing::Return(PGRES_COMMAND_OK));
+	EXPECT_CALL(api, execPrepared(pq_api_mock::test_connection, testing::_, 0, testing::_, nullptr, nullptr, 0))
+	    .WillRepeatedly(testing::Return(pq_api_mock::test_result));
+	EXPECT_CALL(api, exec(pq_api_mock::test_connection, testing::StartsWith("DEALLOCATE "))).WillOnce(testing::Return(pq_api_mock::test_result));
+
+	{
+		statement st{ &api, test_connection(), "SELECT 1", true, cache };
+		st.execute({}, std::vector<result>{});
+	}
+	{
+		statement st{ &api, test_connection(), "SELECT 2", true, cache };
+		st.execute({}, std::vector<result>{});
+	}
+
+	EXPECT_EQ(cache->size(), 1u);
+	EXPECT_EQ(cache->stats().evictions, 1u);
+}
+
+TEST(StatementTests, TestCachedPreparedStatementIsPreparedAgainWhenGone)
+{
+	auto     api   = pq_api_mock_nice{};
+	auto     cache = std::make_shared<statement_name_cache>();
+	PGresult missing{};
+
+	cache->release("SELECT 1", "stale");
+
+	EXPECT_CALL(api, status(pq_api_mock::test_connection)).WillRepeatedly(testing::Return(CONNECTION_OK));
+	EXPECT_CALL(api, execPrepared(pq_api_mock::test_connection, testing::StrEq("stale"), 0, testing::_, nullptr, nullptr, 0))
+	    .WillOnce(testing::Return(&missing));
+	EXPECT_CALL(api, resultStatus(&missing)).WillRepeatedly(testing::Return(PGRES_FATAL_ERROR));
+	EXPECT_CALL(api, resultErrorField(&missing, PG_DIAG_SQLSTATE)).WillRepeatedly(testing::Return("26000"));
+	EXPECT_CALL(api, prepare(pq_api_mock::test_connection, testing::StrNe("stale"), testing::StrEq("SELECT 1"), 0, nullptr))
+	    .WillOnce(testing::Return(pq_api_mock::test_result));
+	EXPECT_CALL(api, resultStatus(pq_api_mock::test_result)).WillRepeatedly(testing::Return(PGRES_COMMAND_OK));
+	EXPECT_CALL(api, execPrepared(pq_api_mock::test_connection, testing::StrNe("stale"), 0, testing::_, nullptr, nullptr, 0))
+	    .WillOnce(testing::Return(pq_api_mock::test_result));
+
+	{
+		statement st{ &api, test_connection(), "SELECT 1", true, cache };
+		EXPECT_NO_THROW(st.execute({}, std::vector<result>{}));
+	}
+
+	EXPECT_EQ(cache->size(), 1u);
+	EXPECT_NE(cache->acquire("SELECT 1").value_or("stale"), "stale");
+}
+
+TEST(StatementTests, TestCachedPreparedStatementIsNotPreparedAgainInAnAbortedTransaction)
+{
+	auto     api   = pq_api_mock_nice{};
+	auto     cache = std::make_shared<statement_name_cache>();
+	PGresult missing{};
+
+	cache->release("SELECT 1", "stale");
+
+	EXPECT_CALL(api, status(pq_api_mock::test_connection)).WillRepeatedly(testing::Return(CONNECTION_OK));
+	EXPECT_CALL(api, transactionStatus(pq_api_mock::test_connection)).WillRepeatedly(testing::Return(PQTRANS_INERROR));
+	EXPECT_CALL(api, execPrepared(pq_api_mock::test_connection, testing::StrEq("stale"), 0, testing::_, nullptr, nullptr, 0))
+	    .WillOnce(testing::Return(&missing));
+	EXPECT_CALL(api, resultStatus(&missing)).WillRepeatedly(testing::Return(PGRES_FATAL_ERROR));
+	EXPECT_CALL(api, resultErrorField(&missing, PG_DIAG_SQLSTATE)).WillRepeatedly(testing::Return("26000"));
+	EXPECT_CALL(api, prepare(testing::_, testing::_, testing::_, testing::_, testing::_)).Times(0);
+
+	statement st{ &api, test_connection(), "SELECT 1", true, cache };
+	EXPECT_THROW(st.execute({}, std::vector<result>{}), error);
+}
+
+#ifdef LIBPQ_HAS_PIPELINING
+TEST(StatementTests, TestExecuteBatchIsPipelined)
+{
+	auto     api = pq_api_mock_nice{};
+	PGresult g_insert1{};
+	PGresult g_insert2{};
+	PGresult g_sync{};
+
+	EXPECT_CALL(api, status(pq_api_mock::test_connection)).WillRepeatedly(testing::Return(CONNECTION_OK));
+	EXPECT_CALL(api, resultStatus(&g_insert1)).WillRepeatedly(testing::Return(PGRES_COMMAND_OK));
+	EXPECT_CALL(api, resultStatus(&g_insert2)).WillRepeatedly(testing::Return(PGRES_COMMAND_OK));
+	EXPECT_CALL(api, resultStatus(&g_sync)).WillRepeatedly(testing::Return(PGRES_PIPELINE_SYNC));
+	EXPECT_CALL(api, cmdTuples(testing::_)).WillRepeatedly(testing::Return("1"));
+	{
+		auto seq = testing::Sequence{};
+		EXPECT_CALL(api, enterPipelineMode(pq_api_mock::test_connection)).InSequence(seq).WillOnce(testing::Return(1));
+		EXPECT_CALL(api, sendQueryParams(pq_api_mock::test_connection, testing::StrEq("INSERT INTO foo VALUES ($1)"), 1, nullptr, testing::NotNull(), nullptr, nullptr, 0))
+		    .Times(2)
+		    .InSequence(seq)
+		    .WillRepeatedly(testing::Return(1));
+		EXPECT_CALL(api, pipelineSync(pq_api_mock::test_connection)).InSequence(seq).WillOnce(testing::Return(1));
+		EXPECT_CALL(api, getResult(pq_api_mock::test_connection))
+		    .InSequence(seq)
+		    .WillOnce(testing::Return(&g_insert1))
+		    .WillOnce(testing::Return(nullptr))
+		    .WillOnce(testing::Return(&g_insert2))
+		    .WillOnce(testing::Return(nullptr))
+		    .WillOnce(testing::Return(&g_sync));
+		EXPECT_CALL(api, exitPipelineMode(pq_api_mock::test_connection)).InSequence(seq).WillOnce(testing::Return(1));
+	}
+
+	const auto batch = std::vector<std::map<std::string, parameter>>{
+		{ { "id", parameter_by_value{ 1 } } },
+		{ { "id", parameter_by_value{ 2 } } },
+	};
+
+	statement st{ &api, test_connection(), "INSERT INTO foo VALUES (:id)", false };
+	EXPECT_EQ(st.execute_batch(batch), 2u);
+}
+
+TEST(StatementTests, TestExecuteBatchReportsTheFirstError)
+{
+	auto     api = pq_api_mock_nice{};
+	PGresult g_failed{};
+	PGresult g_aborted{};
+	PGresult g_sync{};
+
+	EXPECT_CALL(api, status(pq_api_mock::test_connection)).WillRepeatedly(testing::Return(CONNECTION_OK));
+	EXPECT_CALL(api, resultStatus(&g_failed)).WillRepeatedly(testing::Return(PGRES_FATAL_ERROR));
+	EXPECT_CALL(api, resultStatus(&g_aborted)).WillRepeatedly(testing::Return(PGRES_PIPELINE_ABORTED));
+	EXPECT_CALL(api, resultStatus(&g_sync)).WillRepeatedly(testing::Return(PGRES_PIPELINE_SYNC));
+	EXPECT_CALL(api, enterPipelineMode(pq_api_mock::test_connection)).WillOnce(testing::Return(1));
+	EXPECT_CALL(api, sendQueryParams(pq_api_mock::test_connection, testing::_, 1, nullptr, testing::NotNull(), nullptr, nullptr, 0))
+	    .Times(2)
+	    .WillRepeatedly(testing::Return(1));
+	EXPECT_CALL(api, pipelineSync(pq_api_mock::test_connection)).WillOnce(testing::Return(1));
+	EXPECT_CALL(api, getResult(pq_api_mock::test_connection))
+	    .WillOnce(testing::Return(&g_failed))
+	    .WillOnce(testing::Return(nullptr))
+	    .WillOnce(testing::Return(&g_aborted))
+	    .WillOnce(testing::Return(nullptr))
+	    .WillOnce(testing::Return(&g_sync));
+	EXPECT_CALL(api, exitPipelineMode(pq_api_mock::test_connection)).WillOnce(testing::Return(1));
+
+	const auto batch = std::vector<std::map<std::string, parameter>>{
+		{ { "id", parameter_by_value{ 1 } } },
+		{ { "id", parameter_by_value{ 2 } } },
+	};
+
+	statement st{ &api, test_connection(), "INSERT INTO foo VALUES (:id)", false };
+	EXPECT_THROW(st.execute_batch(batch), error);
+}
+
+TEST(StatementTests, TestExecuteBatchReadsBackThePipelineBeforeLeavingIt)
+{
+	auto     api = pq_api_mock_nice{};
+	PGresult g_insert2{};
+	PGresult g_sync{};
+
+	EXPECT_CALL(api, status(pq_api_mock::test_connection)).WillRepeatedly(testing::Return(CONNECTION_OK));
+	EXPECT_CALL(api, resultStatus(&g_insert2)).WillRepeatedly(testing::Return(PGRES_COMMAND_OK));
+	EXPECT_CALL(api, resultStatus(&g_sync)).WillRepeatedly(testing::Return(PGRES_PIPELINE_SYNC));
+	{
+		auto seq = testing::Sequence{};
+		EXPECT_CALL(api, enterPipelineMode(pq_api_mock::test_connection)).InSequence(seq).WillOnce(testing::Return(1));
+		EXPECT_CALL(api, sendQueryParams(pq_api_mock::test_connection, testing::_, 1, nullptr, testing::NotNull(), nullptr, nullptr, 0))
+		    .Times(2)
+		    .InSequence(seq)
+		    .WillRepeatedly(testing::Return(1));
+		EXPECT_CALL(api, pipelineSync(pq_api_mock::test_connection)).InSequence(seq).WillOnce(testing::Return(1));
+		EXPECT_CALL(api, getResult(pq_api_mock::test_connection))
+		    .InSequence(seq)
+		    .WillOnce(testing::Return(nullptr))
+		    .WillOnce(testing::Return(&g_insert2))
+		    .WillOnce(testing::Return(nullptr))
+		    .WillOnce(testing::Return(&g_sync));
+		EXPECT_CALL(api, exitPipelineMode(pq_api_mock::test_connection)).InSequence(seq).WillOnce(testing::Return(1));
+	}
+
+	const auto batch = std::vector<std::map<std::string, parameter>>{
+		{ { "id", parameter_by_value{ 1 } } },
+		{ { "id", parameter_by_value{ 2 } } },
+	};
+
+	statement st{ &api, test_connection(), "INSERT INTO foo VALUES (:id)", false };
+	EXPECT_THROW(st.execute_batch(batch), error);
+}
+#endif
+
+} // namespace postgresql
+} // namespace squid
+} // namespace zoo
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include "zoo/squid/postgresql/config.h"
 #include "zoo/squid/postgresql/field.h"
 #include "zoo/squid/postgresql/resultsetdatafwd.h"
 
@@ -16,7 +17,7 @@ namespace zoo {
 namespace squid {
 namespace postgresql {
 
-class tuple final
+class ZOO_SQUID_POSTGRESQL_API tuple final
 {
 	const resultset_data* data_;
 	std::vector<field>    fields_;
@@ -21,17 +21,25 @@ namespace sqlite {
 
 namespace {
 
-sqlite3* connect_database(isqlite_api& api, std::string_view connection_info)
+sqlite3* connect_database(isqlite_api& api, std::string_view connection_info, const connection_options& options)
 {
-	sqlite3* handle{};
-	auto     err = api.open(std::string{ connection_info }.c_str(), &handle);
+	sqlite3*   handle{};
+	const auto filename = std::string{ connection_info };
+	const auto func     = options.read_only ? "sqlite3_open_v2" : "sqlite3_open";
+	auto       err      = options.read_only ? api.open_v2(filename.c_str(), &handle, SQLITE_OPEN_READONLY | SQLITE_OPEN_URI, nullptr)
+	                                        : api.open(filename.c_str(), &handle);
 	if (SQLITE_OK != err)
 	{
-		ZOO_THROW_EXCEPTION(error{ api, "sqlite3_open failed", err });
+		if (handle)
+		{
+			// Even when opening fails, a handle may be returned that must be closed
+			api.close(handle);
+		}
+		ZOO_THROW_EXCEPTION(error{ api, std::string{ func } + " failed", err });
 	}
 	else if (!handle)
 	{
-		ZOO_THROW_EXCEPTION(error{ "sqlite3_open did not set the connection handle" });
+		ZOO_THROW_EXCEPTION(error{ std::string{ func } + " did not set the connection handle" });
 	}
 	else
 	{
@@ -51,7 +59,7 @@ std::unique_ptr<ibackend_statement> backend_connection::create_statement(std::st
 
 std::unique_ptr<ibackend_statement> backend_connection::create_prepared_statement(std::string_view query)
 {
-	return std::make_unique<statement>(*this->api_, this->connection_, query, true);
+	return std::make_unique<statement>(*this->api_, this->connection_, query, true, this->statement_cache_);
 }
 
 void backend_connection::execute(const std::string& query)
@@ -59,10 +67,41 @@ void backend_connection::execute(const std::string& query)
 	statement::execute(*this->api_, *this->connection_, query);
 }
 
+statement_cache_stats backend_connection::prepared_statement_cache_stats() const
+{
+	return this->statement_cache_->stats();
+}
+
+void backend_connection::set_prepared_statement_cache_capacity(std::size_t capacity)
+{
+	this->statement_cache_->set_capacity(capacity);
+}
+
+bool backend_connection::is_valid()
+{
+	// There is no server connection that can break
+	return true;
+}
+
+void backend_connection::cancel()
+{
+	this->api_->interrupt(this->connection_.get());
+}
+
 backend_connection::backend_connection(isqlite_api& api, std::string_view connection_info)
+    : backend_connection{ api, connection_info, connection_options{} }
+{
+}
+
+backend_connection::backend_connection(isqlite_api& api, std::string_view connection_info, const connection_options& options)
     : api_{ &api }
-    , connection_{ connect_database(api, connection_info), [&api](sqlite3* db) { api.close(db); } }
+    , connection_{ connect_database(api, connection_info, options), [&api](sqlite3* db) { api.close(db); } }
+    , statement_cache_{ std::make_shared<statement_handle_cache>() }
 {
+	for (const auto& pragma : options.pragmas())
+	{
+		statement::execute(*this->api_, *this->connection_, pragma);
+	}
 }
 
 sqlite3& backend_connection::handle() const
@@ -70,6 +109,11 @@ sqlite3& backend_connection::handle() const
 	return *this->connection_;
 }
 
+isqlite_api& backend_connection::api() const
+{
+	return *this->api_;
+}
+
 } // namespace sqlite
 } // namespace squid
 } // namespace zoo
@@ -8,9 +8,11 @@
 #pragma once
 
 #include "zoo/squid/sqlite3/config.h"
+#include "zoo/squid/sqlite3/connectionoptions.h"
 #include "zoo/squid/sqlite3/detail/sqlite3fwd.h"
 #include "zoo/squid/sqlite3/detail/isqliteapifwd.h"
 #include "zoo/squid/core/ibackendconnection.h"
+#include "zoo/squid/core/statementcache.h"
 
 namespace zoo {
 namespace squid {
@@ -18,8 +20,9 @@ namespace sqlite {
 
 class ZOO_SQUID_SQLITE_API backend_connection final : public ibackend_connection
 {
-	isqlite_api*             api_;
-	std::shared_ptr<sqlite3> connection_;
+	isqlite_api*                                                    api_;
+	std::shared_ptr<sqlite3>                                        connection_;
+	std::shared_ptr<statement_cache<std::shared_ptr<sqlite3_stmt>>> statement_cache_; // idle prepared statements
 
 public:
 	/// @a connection_info must contain a path to a file
@@ -27,6 +30,10 @@ public:
 	/// Files that do not exist will be created.
 	explicit backend_connection(isqlite_api& api, std::string_view connection_info);
 
+	/// Open the database with @a options.
+	/// When @a options.read_only is set, @a connection_info may also be a "file:" URI.
+	explicit backend_connection(isqlite_api& api, std::string_view connection_info, const connection_options& options);
+
 	backend_connection(const backend_connection&)            = delete;
 	backend_connection(backend_connection&& src)             = default;
 	backend_connection& operator=(const backend_connection&) = delete;
@@ -36,7 +43,15 @@ public:
 	std::unique_ptr<ibackend_statement> create_prepared_statement(std::string_view query) override;
 	void                                execute(const std::string& query) override;
 
-	sqlite3& handle() const;
+	statement_cache_stats prepared_statement_cache_stats() const override;
+	void                  set_prepared_statement_cache_capacity(std::size_t capacity) override;
+	bool                  is_valid() override;
+
+	/// Cancel the executing statement with sqlite3_interrupt
+	void cancel() override;
+
+	sqlite3&     handle() const;
+	isqlite_api& api() const;
 };
 
 } // namespace sqlite
@@ -16,16 +16,27 @@ namespace sqlite {
 
 std::shared_ptr<ibackend_connection> backend_connection_factory::create_backend_connection(std::string_view connection_info) const
 {
-	return std::make_shared<backend_connection>(*this->api_, std::string{ connection_info });
+	return std::make_shared<backend_connection>(*this->api_, std::string{ connection_info }, this->options_);
 }
 
 backend_connection_factory::backend_connection_factory()
-    : api_{ &sqlite_api::API }
+    : backend_connection_factory{ sqlite_api::API, connection_options{} }
 {
 }
 
 backend_connection_factory::backend_connection_factory(isqlite_api& api)
+    : backend_connection_factory{ api, connection_options{} }
+{
+}
+
+backend_connection_factory::backend_connection_factory(const connection_options& options)
+    : backend_connection_factory{ sqlite_api::API, options }
+{
+}
+
+backend_connection_factory::backend_connection_factory(isqlite_api& api, const connection_options& options)
     : api_{ &api }
+    , options_{ options }
 {
 }
 
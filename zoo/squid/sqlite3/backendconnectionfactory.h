@@ -8,6 +8,7 @@
 #pragma once
 
 #include "zoo/squid/sqlite3/config.h"
+#include "zoo/squid/sqlite3/connectionoptions.h"
 #include "zoo/squid/sqlite3/detail/isqliteapifwd.h"
 #include "zoo/squid/core/ibackendconnectionfactory.h"
 
@@ -17,12 +18,19 @@ namespace sqlite {
 
 class ZOO_SQUID_SQLITE_API backend_connection_factory final : public ibackend_connection_factory
 {
-	isqlite_api* api_;
+	isqlite_api*       api_;
+	connection_options options_;
 
 public:
 	explicit backend_connection_factory();
 	explicit backend_connection_factory(isqlite_api& api);
 
+	/// Create connections that are opened with @a options.
+	/// A connection_pool created with a read-only factory lets many threads read concurrently,
+	/// while a single writer uses a separate connection (in WAL journal mode).
+	explicit backend_connection_factory(const connection_options& options);
+	explicit backend_connection_factory(isqlite_api& api, const connection_options& options);
+
 	backend_connection_factory(const backend_connection_factory&)            = delete;
 	backend_connection_factory(backend_connection_factory&& src)             = default;
 	backend_connection_factory& operator=(const backend_connection_factory&) = delete;
@@ -0,0 +1,139 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/sqlite3/blob.h"
+#include "zoo/squid/sqlite3/connection.h"
+#include "zoo/squid/sqlite3/backendconnection.h"
+#include "zoo/squid/sqlite3/error.h"
+
+#include "zoo/squid/sqlite3/detail/isqliteapi.h"
+
+#include "zoo/common/logging/logging.h"
+#include "zoo/common/misc/throw_exception.h"
+
+#include <sqlite3.h>
+
+#include <algorithm>
+
+namespace zoo {
+namespace squid {
+namespace sqlite {
+
+blob::blob(isqlite_api&     api,
+           sqlite3&         connection,
+           std::string_view table,
+           std::string_view column,
+           std::int64_t     row,
+           bool             writable,
+           std::string_view database)
+    : api_{ &api }
+    , connection_{ &connection }
+    , handle_{}
+    , size_{}
+    , offset_{}
+{
+	const auto ec = this->api_->blob_open(this->connection_,
+	                                      std::string{ database }.c_str(),
+	                                      std::string{ table }.c_str(),
+	                                      std::string{ column }.c_str(),
+	                                      row,
+	                                      writable ? 1 : 0,
+	                                      &this->handle_);
+	if (ec != SQLITE_OK)
+	{
+		if (this->handle_)
+		{
+			this->api_->blob_close(this->handle_);
+		}
+		ZOO_THROW_EXCEPTION(error{ *this->api_, "sqlite3_blob_open failed", *this->connection_ });
+	}
+
+	this->size_ = this->api_->blob_bytes(this->handle_);
+}
+
+blob::blob(const backend_connection& connection,
+           std::string_view          table,
+           std::string_view          column,
+           std::int64_t              row,
+           bool                      writable,
+           std::string_view          database)
+    : blob{ connection.api(), connection.handle(), table, column, row, writable, database }
+{
+}
+
+blob::blob(const connection& connection, std::string_view table, std::string_view column, std::int64_t row, bool writable, std::string_view database)
+    : blob{ connection.backend(), table, column, row, writable, database }
+{
+}
+
+blob::~blob() noexcept
+{
+	if (this->api_->blob_close(this->handle_) != SQLITE_OK)
+	{
+		ZOO_LOG(err, "sqlite3_blob_close failed: {}", this->api_->errmsg(this->connection_));
+	}
+}
+
+std::size_t blob::read(void* buf, std::size_t count)
+{
+	const auto n = static_cast<int>(std::min<std::size_t>(count, static_cast<std::size_t>(this->size_ - this->offset_)));
+	if (n == 0)
+	{
+		return 0u;
+	}
+
+	if (this->api_->blob_read(this->handle_, buf, n, this->offset_) != SQLITE_OK)
+	{
+		ZOO_THROW_EXCEPTION(error{ *this->api_, "sqlite3_blob_read failed", *this->connection_ });
+	}
+	this->offset_ += n;
+	return static_cast<std::size_t>(n);
+}
+
+std::size_t blob::write(const void* buf, std::size_t count)
+{
+	if (count > static_cast<std::size_t>(this->size_ - this->offset_))
+	{
+		ZOO_THROW_EXCEPTION(error{ "Cannot write past the end of a blob" });
+	}
+
+	const auto n = static_cast<int>(count);
+	if (this->api_->blob_write(this->handle_, buf, n, this->offset_) != SQLITE_OK)
+	{
+		ZOO_THROW_EXCEPTION(error{ *this->api_, "sqlite3_blob_write failed", *this->connection_ });
+	}
+	this->offset_ += n;
+	return count;
+}
+
+std::uint64_t blob::size()
+{
+	return static_cast<std::uint64_t>(this->size_);
+}
+
+void blob::seek(std::uint64_t offset)
+{
+	if (offset > static_cast<std::uint64_t>(this->size_))
+	{
+		ZOO_THROW_EXCEPTION(error{ "Cannot seek past the end of a blob" });
+	}
+	this->offset_ = static_cast<int>(offset);
+}
+
+void blob::reopen(std::int64_t row)
+{
+	if (this->api_->blob_reopen(this->handle_, row) != SQLITE_OK)
+	{
+		ZOO_THROW_EXCEPTION(error{ *this->api_, "sqlite3_blob_reopen failed", *this->connection_ });
+	}
+	this->size_   = this->api_->blob_bytes(this->handle_);
+	this->offset_ = 0;
+}
+
+} // namespace sqlite
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,76 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/sqlite3/config.h"
+#include "zoo/squid/sqlite3/backendconnectionfwd.h"
+#include "zoo/squid/sqlite3/detail/sqlite3fwd.h"
+#include "zoo/squid/sqlite3/detail/isqliteapifwd.h"
+#include "zoo/squid/core/iblob.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace zoo {
+namespace squid {
+namespace sqlite {
+
+class connection;
+
+/// Incremental access to a BLOB value with sqlite3_blob_open() and friends.
+/// A blob cannot change size. To write a value, first store a zeroblob(N) of the final size, e.g. with
+/// INSERT INTO attachment (data) VALUES (zeroblob(:size)), then open it for writing.
+/// The connection must outlive the blob.
+class ZOO_SQUID_SQLITE_API blob final : public iblob
+{
+	isqlite_api*  api_;
+	sqlite3*      connection_;
+	sqlite3_blob* handle_;
+	int           size_;
+	int           offset_;
+
+public:
+	/// Open the value of @a column in the row with rowid @a row of @a table, in the database @a database
+	blob(isqlite_api&     api,
+	     sqlite3&         connection,
+	     std::string_view table,
+	     std::string_view column,
+	     std::int64_t     row,
+	     bool             writable,
+	     std::string_view database = "main");
+	blob(const backend_connection& connection,
+	     std::string_view          table,
+	     std::string_view          column,
+	     std::int64_t              row,
+	     bool                      writable,
+	     std::string_view          database = "main");
+	blob(const connection& connection,
+	     std::string_view  table,
+	     std::string_view  column,
+	     std::int64_t      row,
+	     bool              writable,
+	     std::string_view  database = "main");
+
+	~blob() noexcept override;
+
+	blob(const blob&)            = delete;
+	blob& operator=(const blob&) = delete;
+
+	std::size_t   read(void* buf, std::size_t count) override;
+	std::size_t   write(const void* buf, std::size_t count) override;
+	std::uint64_t size() override;
+	void          seek(std::uint64_t offset) override;
+
+	/// Move to the value of the same column in the row with rowid @a row, which is faster than opening a new blob
+	void reopen(std::int64_t row);
+};
+
+} // namespace sqlite
+} // namespace squid
+} // namespace zoo
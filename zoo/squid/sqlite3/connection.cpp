@@ -21,7 +21,17 @@ connection::connection(std::string_view connection_info)
 }
 
 connection::connection(isqlite_api& api, std::string_view connection_info)
-    : squid::connection{ backend_connection_factory{ api }, connection_info }
+    : connection{ api, connection_info, connection_options{} }
+{
+}
+
+connection::connection(std::string_view connection_info, const connection_options& options)
+    : connection{ sqlite_api::API, connection_info, options }
+{
+}
+
+connection::connection(isqlite_api& api, std::string_view connection_info, const connection_options& options)
+    : squid::connection{ backend_connection_factory{ api, options }, connection_info }
     , backend_{ std::dynamic_pointer_cast<backend_connection>(this->squid::connection::backend()) }
 {
 }
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "zoo/squid/sqlite3/config.h"
+#include "zoo/squid/sqlite3/connectionoptions.h"
 #include "zoo/squid/sqlite3/backendconnectionfwd.h"
 #include "zoo/squid/sqlite3/detail/isqliteapifwd.h"
 #include "zoo/squid/core/connection.h"
@@ -23,6 +24,8 @@ class ZOO_SQUID_SQLITE_API connection final : public squid::connection
 public:
 	explicit connection(std::string_view connection_info);
 	explicit connection(isqlite_api& api, std::string_view connection_info);
+	explicit connection(std::string_view connection_info, const connection_options& options);
+	explicit connection(isqlite_api& api, std::string_view connection_info, const connection_options& options);
 
 	connection(const connection&)            = delete;
 	connection(connection&& src)             = default;
@@ -0,0 +1,84 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "zoo/squid/sqlite3/connectionoptions.h"
+#include "zoo/squid/sqlite3/error.h"
+
+#include "zoo/common/misc/throw_exception.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace zoo {
+namespace squid {
+namespace sqlite {
+
+namespace {
+
+// PRAGMA values cannot be bound as parameters, so they are pasted into the statement.
+// Only accept plain keywords (e.g. WAL, NORMAL, MEMORY) or numbers.
+const std::string& check_keyword(std::string_view pragma, const std::string& value)
+{
+	if (value.empty() || !std::all_of(value.begin(), value.end(), [](unsigned char c) { return std::isalnum(c) || c == '_'; }))
+	{
+		ZOO_THROW_EXCEPTION(error{ "Invalid value for PRAGMA " + std::string{ pragma } + ": '" + value + "'" });
+	}
+	return value;
+}
+
+} // namespace
+
+connection_options connection_options::tuned()
+{
+	using namespace std::chrono_literals;
+
+	connection_options options{};
+	options.journal_mode = "WAL";
+	options.synchronous  = "NORMAL";
+	options.mmap_size    = 256 * 1024 * 1024;
+	options.cache_size   = -64 * 1024;
+	options.temp_store   = "MEMORY";
+	options.busy_timeout = 5s;
+	return options;
+}
+
+std::vector<std::string> connection_options::pragmas() const
+{
+	std::vector<std::string> result{};
+
+	// The busy timeout goes first, so that the other statements wait for a lock too.
+	if (this->busy_timeout)
+	{
+		result.push_back("PRAGMA busy_timeout = " + std::to_string(this->busy_timeout->count()));
+	}
+	if (this->journal_mode && !this->read_only)
+	{
+		result.push_back("PRAGMA journal_mode = " + check_keyword("journal_mode", this->journal_mode.value()));
+	}
+	if (this->synchronous)
+	{
+		result.push_back("PRAGMA synchronous = " + check_keyword("synchronous", this->synchronous.value()));
+	}
+	if (this->mmap_size)
+	{
+		result.push_back("PRAGMA mmap_size = " + std::to_string(this->mmap_size.value()));
+	}
+	if (this->cache_size)
+	{
+		result.push_back("PRAGMA cache_size = " + std::to_string(this->cache_size.value()));
+	}
+	if (this->temp_store)
+	{
+		result.push_back("PRAGMA temp_store = " + check_keyword("temp_store", this->temp_store.value()));
+	}
+
+	return result;
+}
+
+} // namespace sqlite
+} // namespace squid
+} // namespace zoo
@@ -0,0 +1,46 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#include "zoo/squid/sqlite3/config.h"
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace zoo {
+namespace squid {
+namespace sqlite {
+
+/// Options that are applied to a database connection right after it is opened.
+/// Settings that are not set keep the SQLite defaults.
+struct ZOO_SQUID_SQLITE_API connection_options final
+{
+	bool                                     read_only{ false }; //!< Open with SQLITE_OPEN_READONLY, the database must exist
+	std::optional<std::string>               journal_mode{};     //!< PRAGMA journal_mode, e.g. "WAL". Not applied to read-only connections
+	std::optional<std::string>               synchronous{};      //!< PRAGMA synchronous, e.g. "NORMAL"
+	std::optional<std::int64_t>              mmap_size{};        //!< PRAGMA mmap_size, in bytes
+	std::optional<std::int64_t>              cache_size{};       //!< PRAGMA cache_size, in pages when positive, in KiB when negative
+	std::optional<std::string>               temp_store{};       //!< PRAGMA temp_store, e.g. "MEMORY"
+	std::optional<std::chrono::milliseconds> busy_timeout{};     //!< Retry with an increasing backoff for this long when the database is locked
+
+	/// Settings suited for concurrent readers and a single writer:
+	/// WAL journal, synchronous NORMAL, 256MiB memory mapped I/O, a 64MiB page cache,
+	/// temporary tables in memory and a busy timeout of 5 seconds.
+	static connection_options tuned();
+
+	/// Get the PRAGMA statements that apply these options, in the order they must be executed.
+	/// Throws if a textual setting is not a plain keyword.
+	std::vector<std::string> pragmas() const;
+};
+
+} // namespace sqlite
+} // namespace squid
+} // namespace zoo
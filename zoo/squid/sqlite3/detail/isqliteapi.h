@@ -27,8 +27,9 @@ public:
 	isqlite_api& operator=(isqlite_api&&)      = delete;
 	isqlite_api& operator=(const isqlite_api&) = delete;
 
-	virtual int open(const char* filename, sqlite3** ppDb) = 0;
-	virtual int close(sqlite3* db)                         = 0;
+	virtual int open(const char* filename, sqlite3** ppDb)                                 = 0;
+	virtual int open_v2(const char* filename, sqlite3** ppDb, int flags, const char* zVfs) = 0;
+	virtual int close(sqlite3* db)                                                         = 0;
 
 	virtual int64_t changes64(sqlite3* db) = 0;
 
@@ -36,6 +37,7 @@ public:
 	virtual int finalize(sqlite3_stmt* pStmt)                                                                    = 0;
 	virtual int step(sqlite3_stmt* pStmt)                                                                        = 0;
 	virtual int reset(sqlite3_stmt* pStmt)                                                                       = 0;
+	virtual int clear_bindings(sqlite3_stmt* pStmt)                                                              = 0;
 
 	virtual int bind_parameter_index(sqlite3_stmt* pStmt, const char* zName)                                        = 0;
 	virtual int bind_null(sqlite3_stmt* pStmt, int index)                                                           = 0;
@@ -56,6 +58,15 @@ public:
 	virtual const char* column_name(sqlite3_stmt* pStmt, int index) = 0;
 	virtual int         column_type(sqlite3_stmt* pStmt, int index) = 0;
 
+	virtual int blob_open(sqlite3* db, const char* zDb, const char* zTable, const char* zColumn, int64_t iRow, int flags, sqlite3_blob** ppBlob) = 0;
+	virtual int blob_reopen(sqlite3_blob* pBlob, int64_t iRow)                                                                            = 0;
+	virtual int blob_close(sqlite3_blob* pBlob)                                                                                           = 0;
+	virtual int blob_bytes(sqlite3_blob* pBlob)                                                                                           = 0;
+	virtual int blob_read(sqlite3_blob* pBlob, void* z, int n, int iOffset)                                                               = 0;
+	virtual int blob_write(sqlite3_blob* pBlob, const void* z, int n, int iOffset)                                                        = 0;
+
+	virtual void interrupt(sqlite3* db) = 0;
+
 	virtual int         errcode(sqlite3* db) = 0;
 	virtual const char* errstr(int ec)       = 0;
 	virtual const char* errmsg(sqlite3* db)  = 0;
@@ -27,7 +27,7 @@ namespace sqlite {
 
 namespace {
 
-void bind_parameter(isqlite_api& api, sqlite3& connection, sqlite3_stmt& statement, const std::string& name, const parameter& parameter)
+int find_parameter_index(isqlite_api& api, sqlite3_stmt& statement, const std::string& name)
 {
 	auto tmp_name        = ":" + name;
 	auto parameter_index = api.bind_parameter_index(&statement, tmp_name.c_str());
@@ -50,6 +50,12 @@ void bind_parameter(isqlite_api& api, sqlite3& connection, sqlite3_stmt& stateme
 		}
 	}
 	assert(parameter_index > 0);
+	return parameter_index;
+}
+
+void bind_parameter(isqlite_api& api, sqlite3& connection, sqlite3_stmt& statement, int parameter_index, const parameter& parameter)
+{
+	assert(parameter_index > 0);
 
 #define BIND0(f)                                                                                                                           \
 	do                                                                                                                                     \
@@ -152,7 +158,53 @@ query_parameters::bind(isqlite_api& api, sqlite3& connection, sqlite3_stmt& stat
 {
 	for (const auto& pair : parameters)
 	{
-		bind_parameter(api, connection, statement, pair.first, pair.second);
+		bind_parameter(api, connection, statement, find_parameter_index(api, statement, pair.first), pair.second);
+	}
+}
+
+/*static*/ void query_parameters::bind(isqlite_api&                            api,
+                                       sqlite3&                                connection,
+                                       sqlite3_stmt&                           statement,
+                                       const std::map<std::string, parameter>& parameters,
+                                       parameter_indexes&                      indexes)
+{
+	for (const auto& pair : parameters)
+	{
+		auto it = indexes.find(pair.first);
+		if (it == indexes.end())
+		{
+			it = indexes.emplace(pair.first, find_parameter_index(api, statement, pair.first)).first;
+		}
+		bind_parameter(api, connection, statement, it->second, pair.second);
+	}
+}
+
+/*static*/ void query_parameters::bind(isqlite_api&                 api,
+                                       sqlite3&                     connection,
+                                       sqlite3_stmt&                statement,
+                                       const binding_plan&          names,
+                                       const positional_parameters& parameters,
+                                       parameter_indexes&           indexes,
+                                       std::vector<int>&            positions)
+{
+	positions.resize(names.size());
+	for (std::size_t position = 0; position < parameters.size() && position < names.size(); ++position)
+	{
+		if (!parameters[position])
+		{
+			continue;
+		}
+		if (positions[position] == 0)
+		{
+			const auto& name = names.name(position);
+			auto        it   = indexes.find(name);
+			if (it == indexes.end())
+			{
+				it = indexes.emplace(name, find_parameter_index(api, statement, name)).first;
+			}
+			positions[position] = it->second;
+		}
+		bind_parameter(api, connection, statement, positions[position], parameters[position].value());
 	}
 }
 
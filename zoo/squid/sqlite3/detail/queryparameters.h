@@ -9,9 +9,11 @@
 
 #include "zoo/squid/sqlite3/detail/sqlite3fwd.h"
 #include "zoo/squid/core/parameter.h"
+#include "zoo/squid/core/bindingplan.h"
 
 #include <map>
 #include <string>
+#include <vector>
 
 namespace zoo {
 namespace squid {
@@ -22,9 +24,28 @@ class isqlite_api;
 class query_parameters final
 {
 public:
+	/// Parameter indexes by name, resolved once per query instead of for every execution
+	using parameter_indexes = std::map<std::string, int, std::less<>>;
+
 	query_parameters() = delete;
 
 	static void bind(isqlite_api& api, sqlite3& connection, sqlite3_stmt& statement, const std::map<std::string, parameter>& parameters);
+	static void bind(isqlite_api&                            api,
+	                 sqlite3&                                connection,
+	                 sqlite3_stmt&                           statement,
+	                 const std::map<std::string, parameter>& parameters,
+	                 parameter_indexes&                      indexes);
+
+	/// Bind @a parameters by their position in @a names, empty positions are not bound.
+	/// @a positions holds the parameter index of each of @a names, 0 until it is resolved through @a indexes, so that it
+	/// is resolved once for all the parameter sets of a batch.
+	static void bind(isqlite_api&                 api,
+	                 sqlite3&                     connection,
+	                 sqlite3_stmt&                statement,
+	                 const binding_plan&          names,
+	                 const positional_parameters& parameters,
+	                 parameter_indexes&           indexes,
+	                 std::vector<int>&            positions);
 };
 
 } // namespace sqlite
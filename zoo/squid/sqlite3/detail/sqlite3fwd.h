@@ -9,3 +9,4 @@
 
 struct sqlite3;
 struct sqlite3_stmt;
+struct sqlite3_blob;
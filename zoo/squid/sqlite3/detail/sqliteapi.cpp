@@ -28,6 +28,11 @@ int sqlite_api::open(const char* filename, sqlite3** ppDb)
 	return sqlite3_open(filename, ppDb);
 }
 
+int sqlite_api::open_v2(const char* filename, sqlite3** ppDb, int flags, const char* zVfs)
+{
+	return sqlite3_open_v2(filename, ppDb, flags, zVfs);
+}
+
 int sqlite_api::close(sqlite3* db)
 {
 	return sqlite3_close(db);
@@ -58,6 +63,11 @@ int sqlite_api::reset(sqlite3_stmt* pStmt)
 	return sqlite3_reset(pStmt);
 }
 
+int sqlite_api::clear_bindings(sqlite3_stmt* pStmt)
+{
+	return sqlite3_clear_bindings(pStmt);
+}
+
 int sqlite_api::bind_parameter_index(sqlite3_stmt* pStmt, const char* zName)
 {
 	return sqlite3_bind_parameter_index(pStmt, zName);
@@ -138,6 +148,41 @@ int sqlite_api::column_type(sqlite3_stmt* pStmt, int index)
 	return sqlite3_column_type(pStmt, index);
 }
 
+int sqlite_api::blob_open(sqlite3* db, const char* zDb, const char* zTable, const char* zColumn, int64_t iRow, int flags, sqlite3_blob** ppBlob)
+{
+	return sqlite3_blob_open(db, zDb, zTable, zColumn, static_cast<sqlite3_int64>(iRow), flags, ppBlob);
+}
+
+int sqlite_api::blob_reopen(sqlite3_blob* pBlob, int64_t iRow)
+{
+	return sqlite3_blob_reopen(pBlob, static_cast<sqlite3_int64>(iRow));
+}
+
+int sqlite_api::blob_close(sqlite3_blob* pBlob)
+{
+	return sqlite3_blob_close(pBlob);
+}
+
+int sqlite_api::blob_bytes(sqlite3_blob* pBlob)
+{
+	return sqlite3_blob_bytes(pBlob);
+}
+
+int sqlite_api::blob_read(sqlite3_blob* pBlob, void* z, int n, int iOffset)
+{
+	return sqlite3_blob_read(pBlob, z, n, iOffset);
+}
+
+int sqlite_api::blob_write(sqlite3_blob* pBlob, const void* z, int n, int iOffset)
+{
+	return sqlite3_blob_write(pBlob, z, n, iOffset);
+}
+
+void sqlite_api::interrupt(sqlite3* db)
+{
+	sqlite3_interrupt(db);
+}
+
 int sqlite_api::errcode(sqlite3* db)
 {
 	return sqlite3_errcode(db);
@@ -28,6 +28,7 @@ public:
 	sqlite_api& operator=(const sqlite_api&) = delete;
 
 	int open(const char* filename, sqlite3** ppDb) override;
+	int open_v2(const char* filename, sqlite3** ppDb, int flags, const char* zVfs) override;
 	int close(sqlite3* db) override;
 
 	int64_t changes64(sqlite3* db) override;
@@ -36,6 +37,7 @@ public:
 	int finalize(sqlite3_stmt* pStmt) override;
 	int step(sqlite3_stmt* pStmt) override;
 	int reset(sqlite3_stmt* pStmt) override;
+	int clear_bindings(sqlite3_stmt* pStmt) override;
 
 	int bind_parameter_index(sqlite3_stmt* pStmt, const char* zName) override;
 	int bind_null(sqlite3_stmt* pStmt, int index) override;
@@ -56,6 +58,15 @@ public:
 	const char* column_name(sqlite3_stmt* pStmt, int index) override;
 	int         column_type(sqlite3_stmt* pStmt, int index) override;
 
+	int blob_open(sqlite3* db, const char* zDb, const char* zTable, const char* zColumn, int64_t iRow, int flags, sqlite3_blob** ppBlob) override;
+	int blob_reopen(sqlite3_blob* pBlob, int64_t iRow) override;
+	int blob_close(sqlite3_blob* pBlob) override;
+	int blob_bytes(sqlite3_blob* pBlob) override;
+	int blob_read(sqlite3_blob* pBlob, void* z, int n, int iOffset) override;
+	int blob_write(sqlite3_blob* pBlob, const void* z, int n, int iOffset) override;
+
+	void interrupt(sqlite3* db) override;
+
 	int         errcode(sqlite3* db) override;
 	const char* errstr(int ec) override;
 	const char* errmsg(sqlite3* db) override;
@@ -15,11 +15,13 @@ namespace {
 
 sqlite3      g_connection;
 sqlite3_stmt g_statement;
+sqlite3_blob g_blob;
 
 } // namespace
 
 sqlite3*      sqlite_api_mock::test_connection = &g_connection;
 sqlite3_stmt* sqlite_api_mock::test_statement  = &g_statement;
+sqlite3_blob* sqlite_api_mock::test_blob       = &g_blob;
 
 std::shared_ptr<sqlite3>      sqlite_api_mock::test_connection_shared = std::make_shared<sqlite3>();
 std::shared_ptr<sqlite3_stmt> sqlite_api_mock::test_statement_shared  = std::make_shared<sqlite3_stmt>();
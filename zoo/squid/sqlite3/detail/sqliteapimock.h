@@ -20,6 +20,10 @@ struct sqlite3_stmt
 {
 };
 
+struct sqlite3_blob
+{
+};
+
 namespace zoo {
 namespace squid {
 namespace sqlite {
@@ -29,6 +33,7 @@ class sqlite_api_mock : public isqlite_api
 public:
 	static sqlite3*      test_connection;
 	static sqlite3_stmt* test_statement;
+	static sqlite3_blob* test_blob;
 
 	static std::shared_ptr<sqlite3>      test_connection_shared;
 	static std::shared_ptr<sqlite3_stmt> test_statement_shared;
@@ -43,6 +48,7 @@ public:
 	sqlite_api_mock& operator=(const sqlite_api_mock&) = delete;
 
 	MOCK_METHOD(int, open, (const char* filename, sqlite3** ppDb), (override));
+	MOCK_METHOD(int, open_v2, (const char* filename, sqlite3** ppDb, int flags, const char* zVfs), (override));
 
 	MOCK_METHOD(int, close, (sqlite3 * db), (override));
 
@@ -52,6 +58,7 @@ public:
 	MOCK_METHOD(int, finalize, (sqlite3_stmt * pStmt), (override));
 	MOCK_METHOD(int, step, (sqlite3_stmt * pStmt), (override));
 	MOCK_METHOD(int, reset, (sqlite3_stmt * pStmt), (override));
+	MOCK_METHOD(int, clear_bindings, (sqlite3_stmt * pStmt), (override));
 
 	MOCK_METHOD(int, bind_parameter_index, (sqlite3_stmt * pStmt, const char* zName), (override));
 	MOCK_METHOD(int, bind_null, (sqlite3_stmt * pStmt, int index), (override));
@@ -72,6 +79,17 @@ public:
 	MOCK_METHOD(const char*, column_name, (sqlite3_stmt * pStmt, int index), (override));
 	MOCK_METHOD(int, column_type, (sqlite3_stmt * pStmt, int index), (override));
 
+	MOCK_METHOD(int,
+	            blob_open,
+	            (sqlite3 * db, const char* zDb, const char* zTable, const char* zColumn, int64_t iRow, int flags, sqlite3_blob** ppBlob),
+	            (override));
+	MOCK_METHOD(int, blob_reopen, (sqlite3_blob * pBlob, int64_t iRow), (override));
+	MOCK_METHOD(int, blob_close, (sqlite3_blob * pBlob), (override));
+	MOCK_METHOD(int, blob_bytes, (sqlite3_blob * pBlob), (override));
+	MOCK_METHOD(int, blob_read, (sqlite3_blob * pBlob, void* z, int n, int iOffset), (override));
+	MOCK_METHOD(int, blob_write, (sqlite3_blob * pBlob, const void* z, int n, int iOffset), (override));
+	MOCK_METHOD(void, interrupt, (sqlite3 * db), (override));
+
 	MOCK_METHOD(int, errcode, (sqlite3 * db), (override));
 	MOCK_METHOD(const char*, errstr, (int ec), (override));
 	MOCK_METHOD(const char*, errmsg, (sqlite3 * db), (override));
@@ -111,15 +111,13 @@ TEST_F(QueryResultsTests, TestCtorVector)
 		auto seq = testing::Sequence{};
 
 		EXPECT_CALL(api, column_name(this->statement, testing::Eq(0))).WillOnce(testing::Return("x"));
-		EXPECT_CALL(api, column_type(this->statement, testing::Eq(0))).Times(1);
-
 		EXPECT_CALL(api, column_name(this->statement, testing::Eq(1))).WillOnce(testing::Return("x"));
-		EXPECT_CALL(api, column_type(this->statement, testing::Eq(1))).Times(1);
-
 		EXPECT_CALL(api, column_name(this->statement, testing::Eq(2))).WillOnce(testing::Return("x"));
-		EXPECT_CALL(api, column_type(this->statement, testing::Eq(2))).Times(1);
 	}
 
+	// The type of a column can differ per row, it is read by fetch()
+	EXPECT_CALL(api, column_type(this->statement, testing::_)).Times(0);
+
 	this->make_query_results(api, this->make_results_vector(n));
 }
 
@@ -136,12 +134,11 @@ TEST_F(QueryResultsTests, TestCtorMap)
 		EXPECT_CALL(api, column_name(this->statement, testing::Eq(0))).WillOnce(testing::Return("first"));
 		EXPECT_CALL(api, column_name(this->statement, testing::Eq(1))).WillOnce(testing::Return("second"));
 		EXPECT_CALL(api, column_name(this->statement, testing::Eq(2))).WillOnce(testing::Return("third"));
-
-		EXPECT_CALL(api, column_type(this->statement, testing::Eq(0))).Times(1);
-		EXPECT_CALL(api, column_type(this->statement, testing::Eq(1))).Times(1);
-		EXPECT_CALL(api, column_type(this->statement, testing::Eq(2))).Times(1);
 	}
 
+	// The type of a column can differ per row, it is read by fetch()
+	EXPECT_CALL(api, column_type(this->statement, testing::_)).Times(0);
+
 	auto dummy = int{};
 	this->bind_result("first", dummy).bind_result("second", dummy).bind_result("third", dummy);
 
@@ -12,10 +12,16 @@
 #include "zoo/squid/sqlite3/detail/queryparameters.h"
 #include "zoo/squid/sqlite3/detail/queryresults.h"
 
+#include "zoo/common/conversion/conversion.h"
 #include "zoo/common/logging/logging.h"
 #include "zoo/common/misc/throw_exception.h"
 
+#include <iomanip>
+#include <span>
 #include <sstream>
+#include <type_traits>
+#include <variant>
+#include <vector>
 #include <cassert>
 
 #include <sqlite3.h>
@@ -51,13 +57,16 @@ sqlite3_stmt* prepare_statement(isqlite_api& api, sqlite3& connection, std::stri
 
 class statement::impl final
 {
-	isqlite_api*                   api_;
-	std::shared_ptr<sqlite3>       connection_;
-	std::string                    query_;
-	bool                           reuse_statement_;
-	std::shared_ptr<sqlite3_stmt>  statement_;
-	int                            step_result_;
-	std::unique_ptr<query_results> query_results_;
+	isqlite_api*                            api_;
+	std::shared_ptr<sqlite3>                connection_;
+	std::string                             query_;
+	bool                                    reuse_statement_;
+	std::shared_ptr<statement_handle_cache> cache_;
+	std::string                             cache_key_;
+	std::shared_ptr<sqlite3_stmt>           statement_;
+	query_parameters::parameter_indexes     parameter_indexes_;
+	int                                     step_result_;
+	std::unique_ptr<query_results>          query_results_;
 
 	void step()
 	{
@@ -73,26 +82,48 @@ class statement::impl final
 	}
 
 public:
-	impl(isqlite_api& api, std::shared_ptr<sqlite3> connection, std::string_view query, bool reuse_statement)
+	impl(isqlite_api&                            api,
+	     std::shared_ptr<sqlite3>                connection,
+	     std::string_view                        query,
+	     bool                                    reuse_statement,
+	     std::shared_ptr<statement_handle_cache> cache)
 	    : api_{ &api }
 	    , connection_{ connection }
 	    , query_{ query }
 	    , reuse_statement_{ reuse_statement }
+	    , cache_{ reuse_statement ? std::move(cache) : nullptr }
+	    , cache_key_{ this->cache_ ? normalize_query(query) : std::string{} }
 	    , statement_{}
+	    , parameter_indexes_{}
 	    , step_result_{ -1 }
 	    , query_results_{}
 	{
 		assert(this->connection_);
 	}
 
-	template<typename ResultsContainer>
-	void execute(const std::map<std::string, parameter>& parameters, const ResultsContainer& results)
+	~impl() noexcept
 	{
-		assert(this->connection_);
-		assert(this->api_);
-
-		this->query_results_.reset();
+		if (this->cache_ && this->statement_)
+		{
+			try
+			{
+				// Reset the statement (which also releases its locks) and drop the bound references before
+				// handing it to the cache.
+				this->query_results_.reset();
+				this->api_->reset(this->statement_.get());
+				this->api_->clear_bindings(this->statement_.get());
+				this->cache_->release(std::move(this->cache_key_), std::move(this->statement_));
+			}
+			catch (...)
+			{
+				;
+			}
+		}
+	}
 
+	// Make sure there is a statement handle that is ready to be bound and stepped
+	void prepare()
+	{
 		if (this->statement_)
 		{
 			if (this->reuse_statement_)
@@ -108,19 +139,92 @@ public:
 			}
 		}
 
+		if (!this->statement_ && this->cache_)
+		{
+			if (auto cached = this->cache_->acquire(this->cache_key_))
+			{
+				this->statement_ = std::move(cached.value());
+			}
+		}
+
 		if (!this->statement_)
 		{
+			// The deleter must not refer to this object, the handle may outlive it in the statement cache.
 			this->statement_.reset(prepare_statement(*this->api_, *this->connection_, this->query_),
-			                       [this](sqlite3_stmt* pStmt) { this->api_->finalize(pStmt); });
+			                       [api = this->api_](sqlite3_stmt* pStmt) { api->finalize(pStmt); });
 		}
+	}
 
-		query_parameters::bind(*this->api_, *this->connection_, *this->statement_, parameters);
+	template<typename ResultsContainer>
+	void execute(const std::map<std::string, parameter>& parameters, const ResultsContainer& results)
+	{
+		assert(this->connection_);
+		assert(this->api_);
+
+		this->query_results_.reset();
+
+		this->prepare();
+
+		query_parameters::bind(*this->api_, *this->connection_, *this->statement_, parameters, this->parameter_indexes_);
 
 		this->step();
 
 		this->query_results_ = std::make_unique<query_results>(*this->api_, this->connection_, this->statement_, results);
 	}
 
+	std::uint64_t execute_batch(std::span<const std::map<std::string, parameter>> batch)
+	{
+		return this->execute_all(batch, [this](const std::map<std::string, parameter>& parameters) {
+			query_parameters::bind(*this->api_, *this->connection_, *this->statement_, parameters, this->parameter_indexes_);
+		});
+	}
+
+	std::uint64_t execute_batch_named(const binding_plan& names, std::span<const positional_parameters> batch)
+	{
+		auto positions = std::vector<int>{};
+		return this->execute_all(batch, [this, &names, &positions](const positional_parameters& parameters) {
+			query_parameters::bind(*this->api_, *this->connection_, *this->statement_, names, parameters, this->parameter_indexes_, positions);
+		});
+	}
+
+	// Execute once for each parameter set in @a batch, @a bind binds a set to statement_
+	template<typename Batch, typename Bind>
+	std::uint64_t execute_all(std::span<const Batch> batch, Bind&& bind)
+	{
+		assert(this->connection_);
+		assert(this->api_);
+
+		this->query_results_.reset();
+
+		// The statement is prepared once and reset between the executions, regardless of reuse_statement_.
+		auto rows = std::uint64_t{};
+		for (const auto& parameters : batch)
+		{
+			if (this->statement_)
+			{
+				if (SQLITE_OK != this->api_->reset(this->statement_.get()))
+				{
+					ZOO_THROW_EXCEPTION(error{ *this->api_, "sqlite3_reset failed", *this->connection_ });
+				}
+			}
+			else
+			{
+				this->prepare();
+			}
+
+			bind(parameters);
+
+			do
+			{
+				this->step();
+			} while (SQLITE_ROW == this->step_result_);
+
+			rows += static_cast<std::uint64_t>(this->api_->changes64(this->connection_.get()));
+		}
+
+		return rows;
+	}
+
 	bool fetch()
 	{
 		if (!this->statement_ || !this->query_results_)
@@ -141,6 +245,139 @@ public:
 		return true;
 	}
 
+	// The text of column @a column_index of the current row, valid until the next step
+	std::string_view column_text(int column_index)
+	{
+		auto& api  = *this->api_;
+		auto  stmt = this->statement_.get();
+
+		// sqlite3_column_text must be called before sqlite3_column_bytes
+		const auto ptr = api.column_text(stmt, column_index);
+		const auto len = api.column_bytes(stmt, column_index);
+		if (!ptr || len < 0)
+		{
+			ZOO_THROW_EXCEPTION(error{ api, "sqlite3_column_text failed", *this->connection_ });
+		}
+		return std::string_view{ reinterpret_cast<const char*>(ptr), static_cast<std::size_t>(len) };
+	}
+
+	std::size_t fetch_columns(column_batch& batch, std::size_t batch_size)
+	{
+		if (!this->statement_ || !this->query_results_)
+		{
+			ZOO_THROW_EXCEPTION(error{ "Cannot fetch rows from a statement that has not been executed" });
+		}
+
+		if (batch.column_count() > this->query_results_->field_count())
+		{
+			ZOO_THROW_EXCEPTION(error{ "The column batch has more columns than the result" });
+		}
+
+		auto& api  = *this->api_;
+		auto  stmt = this->statement_.get();
+
+		// Like the PostgreSQL backend, a text value is parsed into a numeric column and throws if it is not a number.
+		// A value that would lose information (a real or a blob into an int64 column, a blob into a float64 column) throws
+		// rather than being coerced by sqlite3_column_int64 or sqlite3_column_double.
+		const auto mismatch = [this](int sqlite_type, std::size_t index, std::string_view column_type_name) {
+			std::ostringstream msg;
+			msg << "Cannot fetch the " << (SQLITE_FLOAT == sqlite_type ? "real" : "blob") << " value of column "
+			    << std::quoted(this->query_results_->field_name(index)) << " into an " << column_type_name << " column";
+			ZOO_THROW_EXCEPTION(error{ msg.str() });
+		};
+
+		// A row is converted completely before it is appended, so that a conversion error leaves the batch with the rows
+		// that were fetched before, and with all columns of the same length
+		struct field final
+		{
+			std::variant<std::int64_t, double, std::string_view> value;
+			bool                                                 is_null;
+		};
+		std::vector<field> row{};
+		row.reserve(batch.column_count());
+
+		auto rows = std::size_t{};
+		while (rows < batch_size && SQLITE_ROW == this->step_result_)
+		{
+			row.clear();
+			for (auto index = std::size_t{}; index < batch.column_count(); ++index)
+			{
+				const auto column_index = static_cast<int>(index);
+				const auto sqlite_type  = api.column_type(stmt, column_index);
+				const auto is_null      = SQLITE_NULL == sqlite_type;
+				switch (batch.column(index).type())
+				{
+				case column_type::int64:
+					if (is_null)
+					{
+						row.push_back(field{ std::int64_t{}, true });
+					}
+					else if (SQLITE_INTEGER == sqlite_type)
+					{
+						row.push_back(field{ std::int64_t{ api.column_int64(stmt, column_index) }, false });
+					}
+					else if (SQLITE_TEXT == sqlite_type)
+					{
+						row.push_back(field{ conversion::string_to_number<std::int64_t>(this->column_text(column_index)), false });
+					}
+					else
+					{
+						mismatch(sqlite_type, index, "int64");
+					}
+					break;
+				case column_type::float64:
+					if (is_null)
+					{
+						row.push_back(field{ 0.0, true });
+					}
+					else if (SQLITE_INTEGER == sqlite_type || SQLITE_FLOAT == sqlite_type)
+					{
+						row.push_back(field{ api.column_double(stmt, column_index), false });
+					}
+					else if (SQLITE_TEXT == sqlite_type)
+					{
+						row.push_back(field{ conversion::string_to_number<double>(this->column_text(column_index)), false });
+					}
+					else
+					{
+						mismatch(sqlite_type, index, "float64");
+					}
+					break;
+				case column_type::text:
+					row.push_back(field{ is_null ? std::string_view{} : this->column_text(column_index), is_null });
+					break;
+				}
+			}
+
+			for (auto index = std::size_t{}; index < batch.column_count(); ++index)
+			{
+				auto& column = batch.column(index);
+				column.nulls().push_back(row[index].is_null);
+				std::visit(
+				    [&column](auto v) {
+					    if constexpr (std::is_same_v<decltype(v), std::int64_t>)
+					    {
+						    column.int64_values().push_back(v);
+					    }
+					    else if constexpr (std::is_same_v<decltype(v), double>)
+					    {
+						    column.float64_values().push_back(v);
+					    }
+					    else
+					    {
+						    column.text_values().push_back(v);
+					    }
+				    },
+				    row[index].value);
+			}
+			++rows;
+			batch.set_rows(batch.rows() + 1u);
+			this->step();
+		}
+
+		return rows;
+	}
+
 	std::size_t field_count()
 	{
 		if (this->query_results_)
@@ -179,9 +416,13 @@ public:
 	}
 };
 
-statement::statement(isqlite_api& api, std::shared_ptr<sqlite3> connection, std::string_view query, bool reuse_statement)
+statement::statement(isqlite_api&                            api,
+                     std::shared_ptr<sqlite3>                connection,
+                     std::string_view                        query,
+                     bool                                    reuse_statement,
+                     std::shared_ptr<statement_handle_cache> cache)
     : ibackend_statement{}
-    , pimpl_{ std::make_unique<impl>(api, connection, query, reuse_statement) }
+    , pimpl_{ std::make_unique<impl>(api, connection, query, reuse_statement, std::move(cache)) }
 {
 }
 
@@ -201,11 +442,26 @@ void statement::execute(const std::map<std::string, parameter>& parameters, cons
 	this->pimpl_->execute(parameters, results);
 }
 
+std::uint64_t statement::execute_batch(std::span<const std::map<std::string, parameter>> batch)
+{
+	return this->pimpl_->execute_batch(batch);
+}
+
+std::uint64_t statement::execute_batch_named(const binding_plan& names, std::span<const positional_parameters> batch)
+{
+	return this->pimpl_->execute_batch_named(names, batch);
+}
+
 bool statement::fetch()
 {
 	return this->pimpl_->fetch();
 }
 
+std::size_t statement::fetch_columns(column_batch& batch, std::size_t batch_size)
+{
+	return this->pimpl_->fetch_columns(batch, batch_size);
+}
+
 std::size_t statement::field_count()
 {
 	return this->pimpl_->field_count();
@@ -221,6 +477,11 @@ std::uint64_t statement::affected_rows()
 	return this->pimpl_->affected_rows();
 }
 
+void statement::set_fetch_mode(fetch_mode)
+{
+	// SQLite always steps through the result one row at a time, so both modes behave the same.
+}
+
 void statement::execute(isqlite_api& api, sqlite3& connection, std::string_view query)
 {
 	std::shared_ptr<sqlite3_stmt> statement{ prepare_statement(api, connection, query),
@@ -11,6 +11,7 @@
 #include "zoo/squid/sqlite3/detail/sqlite3fwd.h"
 #include "zoo/squid/sqlite3/detail/isqliteapifwd.h"
 #include "zoo/squid/core/ibackendstatement.h"
+#include "zoo/squid/core/statementcache.h"
 
 #include <memory>
 #include <string>
@@ -19,6 +20,9 @@ namespace zoo {
 namespace squid {
 namespace sqlite {
 
+/// Cache of idle prepared statement handles
+using statement_handle_cache = statement_cache<std::shared_ptr<sqlite3_stmt>>;
+
 class ZOO_SQUID_SQLITE_API statement final : public ibackend_statement
 {
 	class impl;
@@ -27,7 +31,13 @@ class ZOO_SQUID_SQLITE_API statement final : public ibackend_statement
 public:
 	~statement() noexcept;
 
-	statement(isqlite_api& api, std::shared_ptr<sqlite3> connection, std::string_view query, bool reuse_statement);
+	/// When @a reuse_statement is true and @a cache is given, a cached statement handle for the same query is reused
+	/// and the handle is returned to @a cache when this object is destroyed, instead of being finalized.
+	statement(isqlite_api&                            api,
+	          std::shared_ptr<sqlite3>                connection,
+	          std::string_view                        query,
+	          bool                                    reuse_statement,
+	          std::shared_ptr<statement_handle_cache> cache = {});
 
 	statement(statement&&);
 	statement& operator=(statement&&);
@@ -37,13 +47,23 @@ public:
 
 	void execute(const std::map<std::string, parameter>& parameters, const std::vector<result>& results) override;
 	void execute(const std::map<std::string, parameter>& parameters, const std::map<std::string, result>& results) override;
+	/// The statement is prepared once and reset between the executions
+	std::uint64_t execute_batch(std::span<const std::map<std::string, parameter>> batch) override;
+	/// Like execute_batch(), the index of each name is resolved once per batch
+	std::uint64_t execute_batch_named(const binding_plan& names, std::span<const positional_parameters> batch) override;
+
 	bool fetch() override;
+	/// Reads the columns straight from the statement handle, one sqlite3_step per row.
+	/// Text is parsed into numeric columns, a real into an int64 column or a blob into a numeric column throws.
+	std::size_t fetch_columns(column_batch& batch, std::size_t batch_size) override;
 
 	std::size_t field_count() override;
 	std::string field_name(std::size_t index) override;
 
 	std::uint64_t affected_rows() override;
 
+	void set_fetch_mode(fetch_mode mode) override;
+
 	static void execute(isqlite_api& api, sqlite3& connection, std::string_view query);
 };
 
@@ -7,8 +7,11 @@
 
 #include <gtest/gtest.h>
 #include <zoo/squid/sqlite3/backendconnection.h>
+#include <zoo/squid/core/ibackendstatement.h>
+#include <zoo/squid/sqlite3/error.h>
 #include <zoo/squid/sqlite3/detail/sqliteapimock.h>
 #include <sqlite3.h>
+#include <stdexcept>
 
 namespace zoo {
 namespace squid {
@@ -24,6 +27,11 @@ void set_connection_handle(const char*, sqlite3** db)
 	*db = sqlite_api_mock::test_connection;
 }
 
+void set_connection_handle_v2(const char*, sqlite3** db, int, const char*)
+{
+	*db = sqlite_api_mock::test_connection;
+}
+
 void set_statement_handle(sqlite3*, const char*, int, sqlite3_stmt** ppStmt, const char**)
 {
 	*ppStmt = sqlite_api_mock::test_statement;
@@ -66,6 +74,54 @@ TEST(BackendConnectionTests, TestOpenDoesNotSetHandle)
 	EXPECT_ANY_THROW((backend_connection{ api, g_connection_info }));
 }
 
+TEST(BackendConnectionTests, TestOpenReadOnly)
+{
+	auto api = sqlite_api_mock_nice{};
+
+	EXPECT_CALL(api, open(testing::_, testing::_)).Times(0);
+	EXPECT_CALL(api, open_v2(testing::StrEq(g_connection_info), testing::NotNull(), SQLITE_OPEN_READONLY | SQLITE_OPEN_URI, nullptr))
+	    .WillOnce(testing::DoAll(&set_connection_handle_v2, testing::Return(SQLITE_OK)));
+	EXPECT_CALL(api, close(sqlite_api_mock::test_connection)).Times(1);
+
+	auto options      = connection_options{};
+	options.read_only = true;
+
+	auto c = backend_connection{ api, g_connection_info, options };
+	EXPECT_EQ(&c.handle(), sqlite_api_mock::test_connection);
+}
+
+TEST(BackendConnectionTests, TestOpenReadOnlyReturnsErrorAndHandle)
+{
+	auto api = sqlite_api_mock_nice{};
+
+	EXPECT_CALL(api, open_v2(testing::StrEq(g_connection_info), testing::NotNull(), testing::_, nullptr))
+	    .WillOnce(testing::DoAll(&set_connection_handle_v2, testing::Return(SQLITE_CANTOPEN)));
+	EXPECT_CALL(api, close(sqlite_api_mock::test_connection)).Times(1);
+
+	auto options      = connection_options{};
+	options.read_only = true;
+
+	EXPECT_ANY_THROW((backend_connection{ api, g_connection_info, options }));
+}
+
+TEST(BackendConnectionTests, TestOptionsAreAppliedAfterOpen)
+{
+	auto api = sqlite_api_mock_nice{};
+
+	EXPECT_CALL(api, open(testing::StrEq(g_connection_info), testing::NotNull()))
+	    .WillOnce(testing::DoAll(&set_connection_handle, testing::Return(SQLITE_OK)));
+
+	std::vector<std::string> statements{};
+	EXPECT_CALL(api, prepare_v2(sqlite_api_mock::test_connection, testing::_, testing::_, testing::NotNull(), nullptr))
+	    .WillRepeatedly(testing::DoAll(testing::WithArg<1>([&statements](const char* sql) { statements.emplace_back(sql); }),
+	                                   &set_statement_handle,
+	                                   testing::Return(SQLITE_OK)));
+	EXPECT_CALL(api, step(sqlite_api_mock::test_statement)).WillRepeatedly(testing::Return(SQLITE_ROW));
+
+	auto c = backend_connection{ api, g_connection_info, connection_options::tuned() };
+	EXPECT_EQ(statements, connection_options::tuned().pragmas());
+}
+
 TEST(BackendConnectionTests, TestExecuteQuery)
 {
 	auto&& test_with_step_result = [](int step_result) {
@@ -100,6 +156,316 @@ TEST(BackendConnectionTests, TestExecuteQuery)
 	EXPECT_ANY_THROW(test_with_step_result(SQLITE_ERROR));
 }
 
+TEST(BackendConnectionTests, TestPreparedStatementCache)
+{
+	auto api = sqlite_api_mock_nice{};
+
+	EXPECT_CALL(api, open(testing::StrEq(g_connection_info), testing::NotNull()))
+	    .WillOnce(testing::DoAll(&set_connection_handle, testing::Return(SQLITE_OK)));
+	EXPECT_CALL(api, prepare_v2(sqlite_api_mock::test_connection, testing::StrEq(g_query), testing::_, testing::NotNull(), nullptr))
+	    .WillOnce(testing::DoAll(&set_statement_handle, testing::Return(SQLITE_OK)));
+	EXPECT_CALL(api, step(sqlite_api_mock::test_statement)).WillRepeatedly(testing::Return(SQLITE_DONE));
+	EXPECT_CALL(api, reset(sqlite_api_mock::test_statement)).Times(2);
+	EXPECT_CALL(api, clear_bindings(sqlite_api_mock::test_statement)).Times(2);
+
+	{
+		auto seq = testing::Sequence{};
+		EXPECT_CALL(api, finalize(sqlite_api_mock::test_statement)).Times(1).InSequence(seq);
+		EXPECT_CALL(api, close(sqlite_api_mock::test_connection)).Times(1).InSequence(seq);
+	}
+
+	{
+		auto c = backend_connection{ api, g_connection_info };
+
+		c.create_prepared_statement(g_query)->execute({}, std::vector<result>{});
+		c.create_prepared_statement(g_query)->execute({}, std::vector<result>{});
+
+		const auto stats = c.prepared_statement_cache_stats();
+		EXPECT_EQ(stats.hits, 1u);
+		EXPECT_EQ(stats.misses, 1u);
+		EXPECT_EQ(stats.size, 1u);
+	}
+}
+
+TEST(BackendConnectionTests, TestPreparedStatementCacheDisabled)
+{
+	auto api = sqlite_api_mock_nice{};
+
+	EXPECT_CALL(api, open(testing::StrEq(g_connection_info), testing::NotNull()))
+	    .WillOnce(testing::DoAll(&set_connection_handle, testing::Return(SQLITE_OK)));
+	EXPECT_CALL(api, prepare_v2(sqlite_api_mock::test_connection, testing::StrEq(g_query), testing::_, testing::NotNull(), nullptr))
+	    .Times(2)
+	    .WillRepeatedly(testing::DoAll(&set_statement_handle, testing::Return(SQLITE_OK)));
+	EXPECT_CALL(api, step(sqlite_api_mock::test_statement)).WillRepeatedly(testing::Return(SQLITE_DONE));
+	EXPECT_CALL(api, finalize(sqlite_api_mock::test_statement)).Times(2);
+
+	auto c = backend_connection{ api, g_connection_info };
+	c.set_prepared_statement_cache_capacity(0);
+
+	c.create_prepared_statement(g_query)->execute({}, std::vector<result>{});
+	c.create_prepared_statement(g_query)->execute({}, std::vector<result>{});
+
+	EXPECT_EQ(c.prepared_statement_cache_stats().size, 0u);
+}
+
+TEST(BackendConnectionTests, TestExecuteBatch)
+{
+	auto api = sqlite_api_mock_nice{};
+
+	EXPECT_CALL(api, open(testing::StrEq(g_connection_info), testing::NotNull()))
+	    .WillOnce(testing::DoAll(&set_connection_handle, testing::Return(SQLITE_OK)));
+	EXPECT_CALL(api, prepare_v2(sqlite_api_mock::test_connection, testing::StrEq("insert into bar values (:x)"), testing::_, testing::NotNull(), nullptr))
+	    .WillOnce(testing::DoAll(&set_statement_handle, testing::Return(SQLITE_OK)));
+	EXPECT_CALL(api, bind_parameter_index(sqlite_api_mock::test_statement, testing::StrEq(":x"))).WillOnce(testing::Return(1));
+	EXPECT_CALL(api, bind_int(sqlite_api_mock::test_statement, 1, 1)).WillOnce(testing::Return(SQLITE_OK));
+	EXPECT_CALL(api, bind_int(sqlite_api_mock::test_statement, 1, 2)).WillOnce(testing::Return(SQLITE_OK));
+	EXPECT_CALL(api, bind_int(sqlite_api_mock::test_statement, 1, 3)).WillOnce(testing::Return(SQLITE_OK));
+	EXPECT_CALL(api, step(sqlite_api_mock::test_statement)).Times(3).WillRepeatedly(testing::Return(SQLITE_DONE));
+	EXPECT_CALL(api, reset(sqlite_api_mock::test_statement)).Times(2).WillRepeatedly(testing::Return(SQLITE_OK));
+	EXPECT_CALL(api, changes64(sqlite_api_mock::test_connection)).Times(3).WillRepeatedly(testing::Return(1));
+	EXPECT_CALL(api, finalize(sqlite_api_mock::test_statement)).Times(1);
+
+	auto c = backend_connection{ api, g_connection_info };
+
+	const auto batch = std::vector<std::map<std::string, parameter>>{
+		{ { "x", parameter_by_value{ 1 } } },
+		{ { "x", parameter_by_value{ 2 } } },
+		{ { "x", parameter_by_value{ 3 } } },
+	};
+
+	EXPECT_EQ(c.create_statement("insert into bar values (:x)")->execute_batch(batch), 3u);
+}
+
+TEST(BackendConnectionTests, TestExecuteBatchNamed)
+{
+	auto api = sqlite_api_mock_nice{};
+
+	EXPECT_CALL(api, open(testing::StrEq(g_connection_info), testing::NotNull()))
+	    .WillOnce(testing::DoAll(&set_connection_handle, testing::Return(SQLITE_OK)));
+	EXPECT_CALL(api, prepare_v2(sqlite_api_mock::test_connection, testing::StrEq("insert into bar values (:x, :y)"), testing::_, testing::NotNull(), nullptr))
+	    .WillOnce(testing::DoAll(&set_statement_handle, testing::Return(SQLITE_OK)));
+	// Every name is resolved once for the whole batch
+	EXPECT_CALL(api, bind_parameter_index(sqlite_api_mock::test_statement, testing::StrEq(":x"))).WillOnce(testing::Return(1));
+	EXPECT_CALL(api, bind_parameter_index(sqlite_api_mock::test_statement, testing::StrEq(":y"))).WillOnce(testing::Return(2));
+	EXPECT_CALL(api, bind_int(sqlite_api_mock::test_statement, 1, 1)).WillOnce(testing::Return(SQLITE_OK));
+	EXPECT_CALL(api, bind_int(sqlite_api_mock::test_statement, 1, 2)).WillOnce(testing::Return(SQLITE_OK));
+	EXPECT_CALL(api, bind_int(sqlite_api_mock::test_statement, 2, 3)).WillOnce(testing::Return(SQLITE_OK));
+	EXPECT_CALL(api, step(sqlite_api_mock::test_statement)).Times(2).WillRepeatedly(testing::Return(SQLITE_DONE));
+	EXPECT_CALL(api, reset(sqlite_api_mock::test_statement)).Times(1).WillRepeatedly(testing::Return(SQLITE_OK));
+	EXPECT_CALL(api, changes64(sqlite_api_mock::test_connection)).Times(2).WillRepeatedly(testing::Return(1));
+	EXPECT_CALL(api, finalize(sqlite_api_mock::test_statement)).Times(1);
+
+	auto c = backend_connection{ api, g_connection_info };
+
+	const auto names = binding_plan{ { "x", "y" } };
+	const auto batch = std::vector<positional_parameters>{
+		{ parameter{ parameter_by_value{ 1 } }, std::nullopt },
+		{ parameter{ parameter_by_value{ 2 } }, parameter{ parameter_by_value{ 3 } } },
+	};
+
+	EXPECT_EQ(c.create_statement("insert into bar values (:x, :y)")->execute_batch_named(names, batch), 2u);
+}
+
+TEST(BackendConnectionTests, TestFetchColumns)
+{
+	auto api = sqlite_api_mock_nice{};
+
+	static constexpr unsigned char text_a[]   = "a";
+	static constexpr unsigned char text_bcd[] = "bcd";
+
+	EXPECT_CALL(api, open(testing::StrEq(g_connection_info), testing::NotNull()))
+	    .WillOnce(testing::DoAll(&set_connection_handle, testing::Return(SQLITE_OK)));
+	EXPECT_CALL(api, prepare_v2(sqlite_api_mock::test_connection, testing::StrEq(g_query), testing::_, testing::NotNull(), nullptr))
+	    .WillOnce(testing::DoAll(&set_statement_handle, testing::Return(SQLITE_OK)));
+	EXPECT_CALL(api, step(sqlite_api_mock::test_statement))
+	    .WillOnce(testing::Return(SQLITE_ROW))
+	    .WillOnce(testing::Return(SQLITE_ROW))
+	    .WillOnce(testing::Return(SQLITE_ROW))
+	    .WillOnce(testing::Return(SQLITE_DONE));
+	EXPECT_CALL(api, column_count(sqlite_api_mock::test_statement)).WillRepeatedly(testing::Return(2));
+	EXPECT_CALL(api, column_type(sqlite_api_mock::test_statement, 0)).WillRepeatedly(testing::Return(SQLITE_INTEGER));
+	EXPECT_CALL(api, column_type(sqlite_api_mock::test_statement, 1))
+	    .WillOnce(testing::Return(SQLITE_TEXT))
+	    .WillOnce(testing::Return(SQLITE_NULL))
+	    .WillOnce(testing::Return(SQLITE_TEXT));
+	EXPECT_CALL(api, column_int64(sqlite_api_mock::test_statement, 0))
+	    .WillOnce(testing::Return(1))
+	    .WillOnce(testing::Return(2))
+	    .WillOnce(testing::Return(3));
+	EXPECT_CALL(api, column_text(sqlite_api_mock::test_statement, 1)).WillOnce(testing::Return(text_a)).WillOnce(testing::Return(text_bcd));
+	EXPECT_CALL(api, column_bytes(sqlite_api_mock::test_statement, 1)).WillOnce(testing::Return(1)).WillOnce(testing::Return(3));
+	EXPECT_CALL(api, finalize(sqlite_api_mock::test_statement)).Times(1);
+
+	auto c  = backend_connection{ api, g_connection_info };
+	auto st = c.create_statement(g_query);
+	st->execute({}, std::vector<result>{});
+
+	column_batch batch{ column_type::int64, column_type::text };
+	ASSERT_EQ(st->fetch_columns(batch, 2u), 2u);
+	EXPECT_EQ(batch.column(0).int64_values(), (std::vector<std::int64_t>{ 1, 2 }));
+	EXPECT_EQ(batch.column(1).text_values()[0], "a");
+	EXPECT_TRUE(batch.column(1).nulls().is_null(1));
+	EXPECT_EQ(batch.column(1).text_values()[1], "");
+
+	batch.clear();
+	ASSERT_EQ(st->fetch_columns(batch, 2u), 1u);
+	EXPECT_EQ(batch.column(0).int64_values(), (std::vector<std::int64_t>{ 3 }));
+	EXPECT_EQ(batch.column(1).text_values()[0], "bcd");
+	EXPECT_EQ(batch.column(1).nulls().null_count(), 0u);
+
+	batch.clear();
+	EXPECT_EQ(st->fetch_columns(batch, 2u), 0u);
+
+	column_batch too_wide{ column_type::int64, column_type::int64, column_type::int64 };
+	EXPECT_THROW(st->fetch_columns(too_wide, 1u), error);
+}
+
+TEST(BackendConnectionTests, TestFetchColumnsConvertsLikePostgresql)
+{
+	auto api = sqlite_api_mock_nice{};
+
+	static constexpr unsigned char text_42[] = "42";
+	static constexpr unsigned char text_4x[] = "4x";
+
+	EXPECT_CALL(api, open(testing::StrEq(g_connection_info), testing::NotNull()))
+	    .WillOnce(testing::DoAll(&set_connection_handle, testing::Return(SQLITE_OK)));
+	EXPECT_CALL(api, prepare_v2(sqlite_api_mock::test_connection, testing::StrEq(g_query), testing::_, testing::NotNull(), nullptr))
+	    .WillOnce(testing::DoAll(&set_statement_handle, testing::Return(SQLITE_OK)));
+	EXPECT_CALL(api, step(sqlite_api_mock::test_statement)).WillOnce(testing::Return(SQLITE_ROW)).WillOnce(testing::Return(SQLITE_ROW));
+	EXPECT_CALL(api, column_count(sqlite_api_mock::test_statement)).WillRepeatedly(testing::Return(2));
+	EXPECT_CALL(api, column_name(sqlite_api_mock::test_statement, 0)).WillRepeatedly(testing::Return("foo"));
+	EXPECT_CALL(api, column_name(sqlite_api_mock::test_statement, 1)).WillRepeatedly(testing::Return("bar"));
+	EXPECT_CALL(api, column_type(sqlite_api_mock::test_statement, 0))
+	    .WillOnce(testing::Return(SQLITE_TEXT))
+	    .WillOnce(testing::Return(SQLITE_FLOAT))
+	    .WillOnce(testing::Return(SQLITE_TEXT));
+	EXPECT_CALL(api, column_type(sqlite_api_mock::test_statement, 1)).WillOnce(testing::Return(SQLITE_INTEGER));
+	EXPECT_CALL(api, column_text(sqlite_api_mock::test_statement, 0)).WillOnce(testing::Return(text_42)).WillOnce(testing::Return(text_4x));
+	EXPECT_CALL(api, column_bytes(sqlite_api_mock::test_statement, 0)).WillOnce(testing::Return(2)).WillOnce(testing::Return(2));
+	EXPECT_CALL(api, column_double(sqlite_api_mock::test_statement, 1)).WillOnce(testing::Return(7.0));
+	EXPECT_CALL(api, column_int64(testing::_, testing::_)).Times(0);
+	EXPECT_CALL(api, finalize(sqlite_api_mock::test_statement)).Times(1);
+
+	auto c  = backend_connection{ api, g_connection_info };
+	auto st = c.create_statement(g_query);
+	st->execute({}, std::vector<result>{});
+
+	column_batch batch{ column_type::int64, column_type::float64 };
+	ASSERT_EQ(st->fetch_columns(batch, 1u), 1u);
+	EXPECT_EQ(batch.column(0).int64_values(), (std::vector<std::int64_t>{ 42 }));
+	EXPECT_EQ(batch.column(1).float64_values(), (std::vector<double>{ 7.0 }));
+
+	// A real is not coerced into an int64 column, and text that is not a number is not parsed partially
+	batch.clear();
+	EXPECT_THROW(st->fetch_columns(batch, 1u), error);
+	batch.clear();
+	EXPECT_THROW(st->fetch_columns(batch, 1u), std::invalid_argument);
+}
+
+TEST(BackendConnectionTests, TestFetchColumnsKeepsCompleteRowsOnConversionError)
+{
+	auto api = sqlite_api_mock_nice{};
+
+	static constexpr unsigned char text_1x[] = "1x";
+
+	EXPECT_CALL(api, open(testing::StrEq(g_connection_info), testing::NotNull()))
+	    .WillOnce(testing::DoAll(&set_connection_handle, testing::Return(SQLITE_OK)));
+	EXPECT_CALL(api, prepare_v2(sqlite_api_mock::test_connection, testing::StrEq(g_query), testing::_, testing::NotNull(), nullptr))
+	    .Times(2)
+	    .WillRepeatedly(testing::DoAll(&set_statement_handle, testing::Return(SQLITE_OK)));
+	EXPECT_CALL(api, step(sqlite_api_mock::test_statement))
+	    .WillOnce(testing::Return(SQLITE_ROW))
+	    .WillOnce(testing::Return(SQLITE_ROW))
+	    .WillOnce(testing::Return(SQLITE_ROW))
+	    .WillOnce(testing::Return(SQLITE_DONE));
+	EXPECT_CALL(api, column_count(sqlite_api_mock::test_statement)).WillRepeatedly(testing::Return(2));
+	EXPECT_CALL(api, column_name(sqlite_api_mock::test_statement, 0)).WillRepeatedly(testing::Return("foo"));
+	EXPECT_CALL(api, column_name(sqlite_api_mock::test_statement, 1)).WillRepeatedly(testing::Return("bar"));
+	EXPECT_CALL(api, column_type(sqlite_api_mock::test_statement, 0)).WillRepeatedly(testing::Return(SQLITE_INTEGER));
+	EXPECT_CALL(api, column_type(sqlite_api_mock::test_statement, 1))
+	    .WillOnce(testing::Return(SQLITE_INTEGER))
+	    .WillOnce(testing::Return(SQLITE_TEXT))
+	    .WillOnce(testing::Return(SQLITE_INTEGER));
+	EXPECT_CALL(api, column_int64(sqlite_api_mock::test_statement, 0))
+	    .WillOnce(testing::Return(1))
+	    .WillOnce(testing::Return(2))
+	    .WillOnce(testing::Return(3));
+	EXPECT_CALL(api, column_int64(sqlite_api_mock::test_statement, 1)).WillOnce(testing::Return(10)).WillOnce(testing::Return(30));
+	EXPECT_CALL(api, column_text(sqlite_api_mock::test_statement, 1)).WillOnce(testing::Return(text_1x));
+	EXPECT_CALL(api, column_bytes(sqlite_api_mock::test_statement, 1)).WillOnce(testing::Return(2));
+	EXPECT_CALL(api, finalize(sqlite_api_mock::test_statement)).Times(2);
+
+	auto c  = backend_connection{ api, g_connection_info };
+	auto st = c.create_statement(g_query);
+	st->execute({}, std::vector<result>{});
+
+	// The second row fails on its last column, the batch keeps the first row in every column
+	column_batch batch{ column_type::int64, column_type::int64 };
+	EXPECT_THROW(st->fetch_columns(batch, 3u), std::invalid_argument);
+	EXPECT_EQ(batch.rows(), 1u);
+	EXPECT_EQ(batch.column(0).int64_values(), (std::vector<std::int64_t>{ 1 }));
+	EXPECT_EQ(batch.column(1).int64_values(), (std::vector<std::int64_t>{ 10 }));
+	EXPECT_EQ(batch.column(0).nulls().size(), 1u);
+	EXPECT_EQ(batch.column(1).nulls().size(), 1u);
+
+	st->execute({}, std::vector<result>{});
+	batch.clear();
+	ASSERT_EQ(st->fetch_columns(batch, 3u), 1u);
+	EXPECT_EQ(batch.column(0).int64_values(), (std::vector<std::int64_t>{ 3 }));
+	EXPECT_EQ(batch.column(1).int64_values(), (std::vector<std::int64_t>{ 30 }));
+	EXPECT_EQ(batch.column(1).nulls().null_count(), 0u);
+}
+
+TEST(BackendConnectionTests, TestFetchNullInLaterRow)
+{
+	auto api = sqlite_api_mock_nice{};
+
+	static constexpr unsigned char text_a[] = "a";
+
+	EXPECT_CALL(api, open(testing::StrEq(g_connection_info), testing::NotNull()))
+	    .WillOnce(testing::DoAll(&set_connection_handle, testing::Return(SQLITE_OK)));
+	EXPECT_CALL(api, prepare_v2(sqlite_api_mock::test_connection, testing::StrEq(g_query), testing::_, testing::NotNull(), nullptr))
+	    .WillOnce(testing::DoAll(&set_statement_handle, testing::Return(SQLITE_OK)));
+	EXPECT_CALL(api, step(sqlite_api_mock::test_statement))
+	    .WillOnce(testing::Return(SQLITE_ROW))
+	    .WillOnce(testing::Return(SQLITE_ROW))
+	    .WillOnce(testing::Return(SQLITE_DONE));
+	EXPECT_CALL(api, column_count(sqlite_api_mock::test_statement)).WillRepeatedly(testing::Return(1));
+	EXPECT_CALL(api, column_name(sqlite_api_mock::test_statement, 0)).WillRepeatedly(testing::Return("foo"));
+	EXPECT_CALL(api, column_type(sqlite_api_mock::test_statement, 0))
+	    .WillOnce(testing::Return(SQLITE_TEXT))
+	    .WillRepeatedly(testing::Return(SQLITE_NULL));
+	EXPECT_CALL(api, column_text(sqlite_api_mock::test_statement, 0)).WillOnce(testing::Return(text_a));
+	EXPECT_CALL(api, column_bytes(sqlite_api_mock::test_statement, 0)).WillOnce(testing::Return(1));
+	EXPECT_CALL(api, finalize(sqlite_api_mock::test_statement)).Times(1);
+
+	auto c  = backend_connection{ api, g_connection_info };
+	auto st = c.create_statement(g_query);
+
+	std::optional<std::string> foo{};
+	std::vector<result>        results{};
+	results.push_back(result{ foo });
+	st->execute({}, results);
+
+	ASSERT_TRUE(st->fetch());
+	EXPECT_EQ(foo, "a");
+	ASSERT_TRUE(st->fetch());
+	EXPECT_FALSE(foo.has_value());
+	EXPECT_FALSE(st->fetch());
+}
+
+TEST(BackendConnectionTests, TestCancel)
+{
+	auto api = sqlite_api_mock_nice{};
+
+	EXPECT_CALL(api, open(testing::StrEq(g_connection_info), testing::NotNull()))
+	    .WillOnce(testing::DoAll(&set_connection_handle, testing::Return(SQLITE_OK)));
+	EXPECT_CALL(api, interrupt(sqlite_api_mock::test_connection)).Times(1);
+
+	auto c = backend_connection{ api, g_connection_info };
+	c.cancel();
+}
+
 } // namespace sqlite
 } // namespace squid
 } // namespace zoo
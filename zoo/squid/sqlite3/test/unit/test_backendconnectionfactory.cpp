@@ -24,6 +24,11 @@ void set_connection_handle(const char*, sqlite3** db)
 	*db = sqlite_api_mock::test_connection;
 }
 
+void set_connection_handle_v2(const char*, sqlite3** db, int, const char*)
+{
+	*db = sqlite_api_mock::test_connection;
+}
+
 } // namespace
 
 TEST(BackendConnectionFactoryTests, TestCreateBackendConnection)
@@ -42,6 +47,22 @@ TEST(BackendConnectionFactoryTests, TestCreateBackendConnection)
 	EXPECT_EQ(&conn->handle(), sqlite_api_mock::test_connection);
 }
 
+TEST(BackendConnectionFactoryTests, TestCreateReadOnlyBackendConnection)
+{
+	auto api = sqlite_api_mock_nice{};
+
+	EXPECT_CALL(api, open_v2(testing::StrEq(g_connection_info), testing::NotNull(), SQLITE_OPEN_READONLY | SQLITE_OPEN_URI, nullptr))
+	    .WillOnce(testing::DoAll(&set_connection_handle_v2, testing::Return(SQLITE_OK)));
+
+	EXPECT_CALL(api, close(sqlite_api_mock::test_connection)).Times(1);
+
+	auto options      = connection_options{};
+	options.read_only = true;
+
+	const auto factory = backend_connection_factory{ api, options };
+	EXPECT_NE(std::dynamic_pointer_cast<backend_connection>(factory.create_backend_connection(g_connection_info)), nullptr);
+}
+
 } // namespace sqlite
 } // namespace squid
 } // namespace zoo
@@ -0,0 +1,132 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include <zoo/squid/sqlite3/blob.h>
+#include <zoo/squid/sqlite3/error.h>
+#include <zoo/squid/sqlite3/detail/sqliteapimock.h>
+#include <sqlite3.h>
+
+#include <cstring>
+#include <string>
+
+namespace zoo {
+namespace squid {
+namespace sqlite {
+
+namespace {
+
+constexpr std::string_view g_content = "0123456789";
+
+void set_blob_handle(sqlite3*, const char*, const char*, const char*, int64_t, int, sqlite3_blob** ppBlob)
+{
+	*ppBlob = sqlite_api_mock::test_blob;
+}
+
+// Collects what is written to it
+struct string_sink final
+{
+	std::string data{};
+
+	std::size_t write(const void* buf, std::size_t count)
+	{
+		this->data.append(static_cast<const char*>(buf), count);
+		return count;
+	}
+};
+
+class BlobTests : public testing::Test
+{
+protected:
+	sqlite_api_mock_nice api{};
+
+	void SetUp() override
+	{
+		ON_CALL(this->api, blob_bytes(sqlite_api_mock::test_blob)).WillByDefault(testing::Return(static_cast<int>(g_content.size())));
+		ON_CALL(this->api, blob_read(sqlite_api_mock::test_blob, testing::_, testing::_, testing::_))
+		    .WillByDefault([](sqlite3_blob*, void* z, int n, int offset) {
+			    std::memcpy(z, g_content.data() + offset, static_cast<std::size_t>(n));
+			    return SQLITE_OK;
+		    });
+	}
+
+	void expect_open(bool writable)
+	{
+		EXPECT_CALL(this->api,
+		            blob_open(sqlite_api_mock::test_connection,
+		                      testing::StrEq("main"),
+		                      testing::StrEq("attachment"),
+		                      testing::StrEq("data"),
+		                      42,
+		                      writable ? 1 : 0,
+		                      testing::NotNull()))
+		    .WillOnce(testing::DoAll(&set_blob_handle, testing::Return(SQLITE_OK)));
+		EXPECT_CALL(this->api, blob_close(sqlite_api_mock::test_blob)).WillOnce(testing::Return(SQLITE_OK));
+	}
+};
+
+} // namespace
+
+TEST_F(BlobTests, TestReadInChunks)
+{
+	this->expect_open(false);
+
+	blob b{ this->api, *sqlite_api_mock::test_connection, "attachment", "data", 42, false };
+	EXPECT_EQ(b.size(), g_content.size());
+
+	char buf[4]{};
+	EXPECT_EQ(b.read(buf, sizeof(buf)), 4u);
+	EXPECT_EQ(std::string_view(buf, 4), "0123");
+
+	string_sink sink{};
+	EXPECT_EQ(copy_stream(b, sink, 4u), 6u);
+	EXPECT_EQ(sink.data, "456789");
+	EXPECT_EQ(b.read(buf, sizeof(buf)), 0u);
+
+	b.seek(8);
+	EXPECT_EQ(b.read(buf, sizeof(buf)), 2u);
+	EXPECT_THROW(b.seek(11), error);
+}
+
+TEST_F(BlobTests, TestWrite)
+{
+	this->expect_open(true);
+	EXPECT_CALL(this->api, blob_write(sqlite_api_mock::test_blob, testing::_, 6, 0)).WillOnce(testing::Return(SQLITE_OK));
+	EXPECT_CALL(this->api, blob_write(sqlite_api_mock::test_blob, testing::_, 4, 6)).WillOnce(testing::Return(SQLITE_OK));
+
+	blob b{ this->api, *sqlite_api_mock::test_connection, "attachment", "data", 42, true };
+	EXPECT_EQ(b.write("abcdef", 6), 6u);
+	EXPECT_EQ(b.write("ghij", 4), 4u);
+	EXPECT_THROW(b.write("k", 1), error); // a blob cannot grow
+}
+
+TEST_F(BlobTests, TestReopen)
+{
+	this->expect_open(false);
+	EXPECT_CALL(this->api, blob_reopen(sqlite_api_mock::test_blob, 43)).WillOnce(testing::Return(SQLITE_OK));
+
+	blob b{ this->api, *sqlite_api_mock::test_connection, "attachment", "data", 42, false };
+	b.seek(5);
+	b.reopen(43);
+
+	char buf[4]{};
+	EXPECT_EQ(b.read(buf, sizeof(buf)), 4u);
+	EXPECT_EQ(std::string_view(buf, 4), "0123");
+}
+
+TEST_F(BlobTests, TestOpenFails)
+{
+	EXPECT_CALL(this->api, blob_open(testing::_, testing::_, testing::_, testing::_, testing::_, testing::_, testing::_))
+	    .WillOnce(testing::Return(SQLITE_ERROR));
+	EXPECT_CALL(this->api, blob_close(testing::_)).Times(0);
+
+	EXPECT_THROW((blob{ this->api, *sqlite_api_mock::test_connection, "attachment", "data", 42, false }), error);
+}
+
+} // namespace sqlite
+} // namespace squid
+} // namespace zoo
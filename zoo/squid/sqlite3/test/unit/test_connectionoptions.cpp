@@ -0,0 +1,51 @@
+//
+// Copyright (C) 2022-2025 Patrick Rotsaert
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <gtest/gtest.h>
+#include <zoo/squid/sqlite3/connectionoptions.h>
+
+namespace zoo {
+namespace squid {
+namespace sqlite {
+
+TEST(ConnectionOptionsTests, DefaultOptionsHaveNoPragmas)
+{
+	EXPECT_TRUE(connection_options{}.pragmas().empty());
+}
+
+TEST(ConnectionOptionsTests, TunedPragmas)
+{
+	EXPECT_EQ(connection_options::tuned().pragmas(),
+	          (std::vector<std::string>{ "PRAGMA busy_timeout = 5000",
+	                                     "PRAGMA journal_mode = WAL",
+	                                     "PRAGMA synchronous = NORMAL",
+	                                     "PRAGMA mmap_size = 268435456",
+	                                     "PRAGMA cache_size = -65536",
+	                                     "PRAGMA temp_store = MEMORY" }));
+}
+
+TEST(ConnectionOptionsTests, ReadOnlyDoesNotSetJournalMode)
+{
+	auto options         = connection_options{};
+	options.read_only    = true;
+	options.journal_mode = "WAL";
+	options.synchronous  = "OFF";
+
+	EXPECT_EQ(options.pragmas(), (std::vector<std::string>{ "PRAGMA synchronous = OFF" }));
+}
+
+TEST(ConnectionOptionsTests, InvalidKeywordThrows)
+{
+	auto options         = connection_options{};
+	options.journal_mode = "WAL; DROP TABLE person";
+
+	EXPECT_ANY_THROW(options.pragmas());
+}
+
+} // namespace sqlite
+} // namespace squid
+} // namespace zoo